@@ -0,0 +1,180 @@
+/******************************************************************************
+File      : BoxCoxBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Regression check of the Box-Cox lambda search (StatsClass::CalcBestBoxCox()).
+Fixed datasets of measured and simulated values are run through two paths:
+
+   memory : BoxCoxObjFunc(), as CalcBestBoxCox() now does
+   file   : BoxCoxModel(), as the former nested Ostrich run did, i.e. lambda
+            is substituted into BoxCoxIn.txt with 16 digits, the data are
+            written with %E, and the objective is read back from
+            BoxCoxOut.txt
+
+Both objectives are minimized with the same OptSearchClass::Minimize()
+settings as CalcBestBoxCox() (bounds -3 and +3, start 1, Brent with 1E-6
+tolerance, convergence 1E-10, at most 200 iterations). The data have at most
+7 significant digits, so that the file path reads back the same values and
+the two paths differ only by the precision of BoxCoxOut.txt. For each dataset
+the benchmark reports:
+
+   lambda_mem, lambda_file : optimal lambda of each path
+   npp_mem, npp_file       : NPP correlation at each optimum (in memory)
+   max_rel_diff            : largest relative difference between the two
+                             objectives, over lambda = -3, -2.75, ..., 3
+   ok                      : 1 if the two paths match, 0 otherwise
+
+The paths match if max_rel_diff <= 1E-6 (BoxCoxOut.txt holds 7 significant
+digits), their NPP agree to within 1E-6 with npp_mem no smaller than
+npp_file, and the optimal lambdas agree to within 2E-3 (the optimum of the
+weighted dataset is flat enough for the rounding of BoxCoxOut.txt to move it
+by 1.9E-3).
+
+Usage:
+   BoxCoxBench
+
+Files BoxCoxIn.txt and BoxCoxOut.txt are written to, and then removed from,
+the current directory. The exit status is 1 if any dataset is not ok.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "BoxCoxModel.h"
+#include "OptSearchClass.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#define BENCH_NUM_OBS (15)
+
+//measured values
+static double gMeas[BENCH_NUM_OBS] =
+{
+   1.2, 2.5, 3.1, 4.8, 5.0, 6.7, 7.3, 8.9, 10.4, 12.0, 13.6, 15.1, 17.9, 20.2, 24.5
+};
+
+//simulated values (multiplicative errors)
+static double gSim[BENCH_NUM_OBS] =
+{
+   1.31, 2.38, 3.35, 4.52, 5.41, 6.22, 7.95, 8.41, 11.2, 11.3, 14.8, 14.2, 19.6, 18.7, 27.1
+};
+
+//weights of the second dataset
+static double gWgt[BENCH_NUM_OBS] =
+{
+   1.0, 1.0, 1.0, 1.0, 1.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.25, 0.25, 0.25, 0.25, 0.25
+};
+
+/******************************************************************************
+FileObjFunc()
+
+BoxCoxModel() objective, going through BoxCoxIn.txt and BoxCoxOut.txt.
+******************************************************************************/
+double FileObjFunc(double lambda, void * pData)
+{
+   BoxCoxDataStruct * pBox = (BoxCoxDataStruct *)pData;
+   FILE * pFile;
+   double f = 0.00;
+   int i;
+
+   pFile = fopen(BOX_IN_FILE, "w");
+   if(pFile == NULL) return 0.00;
+   fprintf(pFile, "LAMBDA=%.16E\nNUM_DATA_POINTS=%d\n", lambda, pBox->n);
+   for(i = 0; i < pBox->n; i++)
+   {
+      fprintf(pFile, "%E\t%E\t%E\n", pBox->x[i], pBox->y[i], pBox->w[i]);
+   }
+   fclose(pFile);
+
+   BoxCoxModel();
+
+   pFile = fopen(BOX_OUT_FILE, "r");
+   if(pFile == NULL) return 0.00;
+   if(fscanf(pFile, "ObjFunc=%lf", &f) != 1) f = 0.00;
+   fclose(pFile);
+   return f;
+} /* end FileObjFunc() */
+
+/******************************************************************************
+Search()
+
+Minimize an objective as CalcBestBoxCox() does, returns the optimal lambda.
+******************************************************************************/
+double Search(OptSearchFunc pFunc, BoxCoxDataStruct * pBox)
+{
+   OptSearchClass * pSearch;
+   double lambda, fx;
+
+   pSearch = new OptSearchClass(pFunc, pBox, -3.00, 3.00, BRENT_SEARCH, 1E-6);
+   lambda = pSearch->Minimize(1.00, &fx, 1E-10, 200);
+   delete pSearch;
+   return lambda;
+} /* end Search() */
+
+/******************************************************************************
+BenchData()
+
+Returns true if the two paths match for the given dataset.
+******************************************************************************/
+bool BenchData(const char * name, double * w)
+{
+   BoxCoxDataStruct box;
+   double r[BENCH_NUM_OBS];
+   double lmem, lfile, fmem, ffile, nmem, nfile, diff, maxDiff;
+   int i;
+   bool ok;
+
+   box.x = gMeas;
+   box.y = gSim;
+   box.w = w;
+   box.r = r;
+   box.n = BENCH_NUM_OBS;
+
+   maxDiff = 0.00;
+   for(i = -12; i <= 12; i++)
+   {
+      fmem = BoxCoxObjFunc(0.25*(double)i, &box);
+      ffile = FileObjFunc(0.25*(double)i, &box);
+      diff = fabs(fmem - ffile)/fabs(fmem);
+      if(diff > maxDiff) maxDiff = diff;
+   }
+
+   lmem = Search(BoxCoxObjFunc, &box);
+   lfile = Search(FileObjFunc, &box);
+   nmem = -BoxCoxObjFunc(lmem, &box);
+   nfile = -BoxCoxObjFunc(lfile, &box);
+
+   ok = (maxDiff <= 1E-6) && (fabs(nmem - nfile) <= 1E-6) && (nmem >= nfile - 1E-12) &&
+        (fabs(lmem - lfile) <= 2E-3);
+   printf("%-10s %12.6lf %12.6lf %14.10lf %14.10lf %12.3E %3d\n",
+          name, lmem, lfile, nmem, nfile, maxDiff, ok ? 1 : 0);
+   fflush(stdout);
+   return ok;
+} /* end BenchData() */
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   double ones[BENCH_NUM_OBS];
+   bool ok;
+   int i;
+
+   for(i = 0; i < BENCH_NUM_OBS; i++) ones[i] = 1.00;
+
+   printf("%-10s %12s %12s %14s %14s %12s %3s\n",
+          "data", "lambda_mem", "lambda_file", "npp_mem", "npp_file", "max_rel_diff", "ok");
+   ok = BenchData("unweighted", ones);
+   ok = BenchData("weighted", gWgt) && ok;
+
+   remove(BOX_IN_FILE);
+   remove(BOX_OUT_FILE);
+   return (ok ? 0 : 1);
+} /* end main() */
@@ -0,0 +1,344 @@
+/******************************************************************************
+File      : MopsocdBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark of the MOPSOCD archive. A synthetic stream of candidate solutions is
+offered to archives of increasing capacity, as MOPSOCD::update_archive() does:
+a candidate that is not dominated removes the members it dominates and, if the
+archive is full, replaces a random member of the most crowded tenth. For each
+candidate a global best is also drawn from the least crowded tenth, as in
+MOPSOCD::compute_velocity(). The candidates lie near a linear Pareto front (a
+simplex) at a distance that shrinks as the stream goes on, so that most of them
+are non-dominated when offered and the archive fills up and stays full. For
+each capacity the benchmark reports:
+
+   sec        : time to offer the whole stream to a MOPSOCD_Archive
+   legacy_sec : the same, as previously done, i.e. pairwise dominance checks
+                against the whole archive and crowding distances recomputed
+                by sorting the archive for every replacement and for every
+                generation (PopSize = 20 candidates); sorting is done with
+                std::sort, which is faster than the former hand-written
+                quicksorts, so this is a lower bound (only for capacities up to
+                legacyMaxLen)
+   us_insert  : sec per candidate, in microseconds
+   size       : final number of archive members (MOPSOCD_Archive)
+   lsize      : final number of archive members (legacy)
+   ok         : 1 if the members of the final archive are mutually
+                non-dominated and their crowding distances match a
+                recomputation from scratch, 0 otherwise
+
+Usage:
+   MopsocdBench [nobj] [maxLen] [legacyMaxLen] [numCandidates] [seed]
+
+Output is one whitespace-delimited record per capacity, preceded by a header
+line.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "MOPSOCD_Archive.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#define BENCH_POP_SIZE (20)
+
+/******************************************************************************
+RandomInt()
+
+Uniform random integer in [lwr, upr].
+******************************************************************************/
+int RandomInt(int lwr, int upr)
+{
+   int r = lwr + (int)(UniformRandom() * (double)(upr - lwr + 1));
+   return (r > upr) ? upr : r;
+} /* end RandomInt() */
+
+/******************************************************************************
+MakeStream()
+
+Candidate solutions: a random point of the simplex, pushed away from it by a
+random distance that shrinks along the stream.
+******************************************************************************/
+double * MakeStream(int n, int nobj)
+{
+   double * pF = new double[n*nobj];
+   double sum, off;
+   int i, k;
+
+   for(i = 0; i < n; i++)
+   {
+      sum = 0.00;
+      for(k = 0; k < nobj; k++)
+      {
+         pF[i*nobj + k] = -log(1.00 - UniformRandom() + 1E-12);
+         sum += pF[i*nobj + k];
+      }
+      off = 0.10 * (1.00 - 0.01*(double)i/(double)n);
+      for(k = 0; k < nobj; k++)
+      {
+         pF[i*nobj + k] = pF[i*nobj + k]/sum + off*(1.00 + 1E-4*UniformRandom());
+      }
+   }
+   return pF;
+} /* end MakeStream() */
+
+/******************************************************************************
+class LegacyArchive
+
+MOPSOCD::check_nondom(), crowding() and update_archive(), as previously done.
+******************************************************************************/
+class LegacyArchive
+{
+   public:
+      LegacyArchive(int capacity, int nobj)
+      {
+         m_Capacity = capacity;
+         m_NumFun = nobj;
+         m_Size = 0;
+         m_Fit.resize(capacity*nobj);
+         m_Crowd.resize(capacity);
+         m_Idx.resize(capacity);
+      }
+      int GetSize(void){ return m_Size; }
+
+      //pairwise scan, deleted members are replaced by the last one
+      bool CheckNondom(double * F)
+      {
+         int h, j, sum;
+         h = 0;
+         while(h < m_Size)
+         {
+            sum = 0;
+            for(j = 0; j < m_NumFun; j++)
+            {
+               if(m_Fit[h*m_NumFun + j] < F[j]) sum++;
+            }
+            if(sum == m_NumFun) return false;
+            else if(sum == 0)
+            {
+               for(j = 0; j < m_NumFun; j++) m_Fit[h*m_NumFun + j] = m_Fit[(m_Size - 1)*m_NumFun + j];
+               m_Size--;
+            }
+            else h++;
+         }
+         return true;
+      }
+
+      //sort by each objective, accumulate distances, then sort by distance
+      void Crowding(void)
+      {
+         int i, f, mx;
+         for(i = 0; i < m_Size; i++){ m_Crowd[i] = 0.00; m_Idx[i] = i;}
+         if(m_Size < 3) return;
+         for(f = 0; f < m_NumFun; f++)
+         {
+            std::sort(m_Idx.begin(), m_Idx.begin() + m_Size, [&](int a, int b)
+               { return m_Fit[a*m_NumFun + f] < m_Fit[b*m_NumFun + f]; });
+            mx = m_Idx[1];
+            for(i = 1; i < m_Size - 1; i++)
+            {
+               m_Crowd[m_Idx[i]] += m_Fit[m_Idx[i + 1]*m_NumFun + f] - m_Fit[m_Idx[i - 1]*m_NumFun + f];
+               if(m_Crowd[mx] < m_Crowd[m_Idx[i]]) mx = m_Idx[i];
+            }
+            m_Crowd[m_Idx[0]] += m_Crowd[mx];
+            m_Crowd[m_Idx[m_Size - 1]] += m_Crowd[mx];
+         }
+         std::sort(m_Idx.begin(), m_Idx.begin() + m_Size, [&](int a, int b)
+            { return m_Crowd[a] > m_Crowd[b]; });
+      }
+
+      void Offer(double * F)
+      {
+         int i, j;
+         if(CheckNondom(F) == false) return;
+         if(m_Size < m_Capacity) i = m_Size++;
+         else
+         {
+            Crowding();
+            i = m_Idx[RandomInt((int)((m_Size - 1)*0.90), m_Size - 1)];
+         }
+         for(j = 0; j < m_NumFun; j++) m_Fit[i*m_NumFun + j] = F[j];
+      }
+
+      int GetBest(void)
+      {
+         return m_Idx[RandomInt(0, (int)((m_Size - 1)*0.10))];
+      }
+
+   private:
+      int m_Capacity;
+      int m_NumFun;
+      int m_Size;
+      std::vector<double> m_Fit;
+      std::vector<double> m_Crowd;
+      std::vector<int> m_Idx;
+}; /* end class LegacyArchive */
+
+/******************************************************************************
+Offer()
+
+Offer a candidate to the archive, as MOPSOCD::update_archive() does.
+******************************************************************************/
+void Offer(MOPSOCD_Archive * pArch, double * X, double * F)
+{
+   int n;
+
+   if(pArch->IsDominated(F) == true) return;
+   pArch->RemoveDominated(F);
+   n = pArch->GetSize();
+   if(n >= pArch->GetCapacity())
+   {
+      pArch->Remove(pArch->GetRanked(RandomInt((int)((n - 1)*0.90), n - 1)));
+   }
+   pArch->Insert(X, F);
+} /* end Offer() */
+
+/******************************************************************************
+CheckArchive()
+
+True if the members of the archive are mutually non-dominated and their
+crowding distances match a recomputation from scratch.
+******************************************************************************/
+bool CheckArchive(MOPSOCD_Archive * pArch, int nobj)
+{
+   std::vector<int> idx;
+   std::vector<double> cd;
+   double * Fi, * Fj;
+   int i, j, k, f, n, better, worse;
+
+   n = pArch->GetSize();
+   for(i = 0; i < n; i++)
+   {
+      Fi = pArch->GetFit(i);
+      for(j = i + 1; j < n; j++)
+      {
+         Fj = pArch->GetFit(j);
+         better = worse = 0;
+         for(k = 0; k < nobj; k++)
+         {
+            if(Fi[k] < Fj[k]) better++;
+            else if(Fi[k] > Fj[k]) worse++;
+         }
+         if((better == 0) || (worse == 0)) return false;
+      }
+   }
+
+   cd.assign(n, 0.00);
+   idx.resize(n);
+   for(f = 0; f < nobj; f++)
+   {
+      for(i = 0; i < n; i++) idx[i] = i;
+      std::sort(idx.begin(), idx.end(), [&](int a, int b)
+         { return pArch->GetFit(a)[f] < pArch->GetFit(b)[f]; });
+      for(i = 0; i < n; i++)
+      {
+         if((i == 0) || (i == n - 1)) cd[idx[i]] += HUGE_VAL;
+         else cd[idx[i]] += pArch->GetFit(idx[i + 1])[f] - pArch->GetFit(idx[i - 1])[f];
+      }
+   }
+   for(i = 0; i < n; i++)
+   {
+      if(isinf(cd[i]) != isinf(pArch->GetCrowding(i))) return false;
+      if(!isinf(cd[i]) && (fabs(cd[i] - pArch->GetCrowding(i)) > 1E-9)) return false;
+   }
+   for(i = 1; i < n; i++)
+   {
+      if(pArch->GetCrowding(pArch->GetRanked(i)) > pArch->GetCrowding(pArch->GetRanked(i - 1))) return false;
+   }
+   return true;
+} /* end CheckArchive() */
+
+/******************************************************************************
+BenchSize()
+******************************************************************************/
+void BenchSize(double * pStream, int n, int nobj, int maxLen, int legacyMaxLen)
+{
+   MOPSOCD_Archive * pArch;
+   LegacyArchive * pLegacy;
+   double X = 0.50;
+   double start, sec, legacy, sink;
+   int i, lsize;
+   bool ok;
+
+   sink = 0.00;
+   pArch = new MOPSOCD_Archive(maxLen, 1, nobj);
+   start = GetElapsedTics();
+   for(i = 0; i < n; i++)
+   {
+      Offer(pArch, &X, &(pStream[i*nobj]));
+      sink += pArch->GetVar(pArch->GetRanked(RandomInt(0, (int)((pArch->GetSize() - 1)*0.10))))[0];
+   }
+   sec = GetElapsedTics() - start;
+   ok = CheckArchive(pArch, nobj);
+
+   legacy = -1.00;
+   lsize = -1;
+   if(maxLen <= legacyMaxLen)
+   {
+      pLegacy = new LegacyArchive(maxLen, nobj);
+      start = GetElapsedTics();
+      for(i = 0; i < n; i++)
+      {
+         if((i % BENCH_POP_SIZE) == 0) pLegacy->Crowding();
+         pLegacy->Offer(&(pStream[i*nobj]));
+         sink += (double)pLegacy->GetBest();
+      }
+      legacy = GetElapsedTics() - start;
+      lsize = pLegacy->GetSize();
+      delete pLegacy;
+   }
+
+   printf("%5d %7d %8d %12.6lf %12.6lf %10.3lf %7d %7d %3d\n",
+          nobj, maxLen, n, sec, legacy, 1E6*sec/(double)n, pArch->GetSize(), lsize, ok ? 1 : 0);
+   fflush(stdout);
+   if(sink < 0.00) printf("\n");
+
+   delete pArch;
+} /* end BenchSize() */
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   int nobj = 2;
+   int maxLen = 16000;
+   int legacyMaxLen = 4000;
+   int n = 100000;
+   unsigned int seed = 12345;
+   int len;
+   double * pStream;
+
+   if(argc > 1) nobj = atoi(argv[1]);
+   if(argc > 2) maxLen = atoi(argv[2]);
+   if(argc > 3) legacyMaxLen = atoi(argv[3]);
+   if(argc > 4) n = atoi(argv[4]);
+   if(argc > 5) seed = (unsigned int)atoi(argv[5]);
+   if((nobj < 2) || (maxLen < 1) || (n < 1))
+   {
+      fprintf(stderr, "need at least two objectives, and one member and candidate\n");
+      return 1;
+   }
+
+   ResetRandomSeed(seed);
+   pStream = MakeStream(n, nobj);
+
+   printf("%5s %7s %8s %12s %12s %10s %7s %7s %3s\n",
+          "nobj", "maxlen", "cands", "sec", "legacy_sec", "us_insert", "size", "lsize", "ok");
+   for(len = 125; len <= maxLen; len *= 2)
+   {
+      BenchSize(pStream, n, nobj, len, legacyMaxLen);
+   }
+
+   delete [] pStream;
+   return 0;
+} /* end main() */
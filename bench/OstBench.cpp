@@ -0,0 +1,404 @@
+/******************************************************************************
+File      : OstBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark suite driver. Runs a fixed set of algorithm/model combinations with
+fixed random seeds, using the synthetic internal models of an Ostrich
+executable that was compiled with OSTRICH_BENCH (OstrichBench, built by the
+BENCH make target). Each case is run in its own subdirectory of the work
+directory, with evaluation profiling enabled.
+
+Usage:
+   OstBench [ostrich] [budget] [workdir] [dim] [case]
+
+   ostrich : path to the OstrichBench executable (default ./OstrichBench)
+   budget  : approximate number of model evaluations per case (default 1000)
+   workdir : directory for the runs (default OstBenchRuns)
+   dim     : number of decision variables (default 10)
+   case    : only run cases whose name contains this string (default all)
+
+Output is CSV on stdout, one record per case:
+   case, program, model, dim, nobj, status  : case description, exit status
+   evals, wall_sec, evals_per_sec           : overall throughput
+   startup_sec, run_sec                     : Ostrich start-up and algorithm
+   subst_sec ... write_sec                  : total time of each evaluation
+                                              phase (see Profiler.h)
+   overhead_sec                             : run time outside of evaluations
+   peak_rss_kB                              : peak resident set size, as
+                                              sampled with GetMemUsage()
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added Powell cases, with and without concurrent line searches
+10-19-26    lsm   added PAES cases
+10-19-26    lsm   added MOPSOCD cases, synchronous and asynchronous
+10-19-26    lsm   added DDSAU cases, with and without asynchronous searches
+10-19-26    lsm   added Grid cases: mini-grids, streaming, and streaming with 
+                  refinement
+10-19-26    lsm   added a VARS case (native STAR-VARS engine)
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+  #include <direct.h>
+  #define BENCH_MKDIR(d) _mkdir(d)
+  #define BENCH_CHDIR(d) _chdir(d)
+  #define BENCH_GETCWD(b, n) _getcwd(b, n)
+#else
+  #include <unistd.h>
+  #define BENCH_MKDIR(d) mkdir(d, 0755)
+  #define BENCH_CHDIR(d) chdir(d)
+  #define BENCH_GETCWD(b, n) getcwd(b, n)
+#endif
+
+#define BENCH_STR_SZ (4096)
+#define BENCH_SEED   (20261019)
+
+//phases reported by the evaluation profiler, in output order
+#define NUM_PHASES (8)
+static const char * gPhases[NUM_PHASES] =
+{
+   "Evaluate", "SubIntoFile", "Model", "ReadResponse", "ExtractVals",
+   "CalcObjFunc", "PreserveModel", "Write"
+};
+
+/******************************************************************************
+A benchmark case: algorithm, model and (for multi-objective problems) the
+number of objectives.
+******************************************************************************/
+typedef struct BENCH_CASE_STRUCT
+{
+   const char * name;
+   const char * program;
+   const char * model;
+   int nobj;
+   bool bRegression;
+}BenchCase;
+
+static BenchCase gCases[] =
+{
+   {"dds_rosenbrock",    "DDS",                      "Rosenbrock()", 1, false},
+   {"dds_griewank",      "DDS",                      "Griewank()",   1, false},
+   {"dds_sleep",         "DDS",                      "Sleep()",      1, false},
+   {"dds_bigoutput",     "DDS",                      "BigOutput()",  1, false},
+   {"pso_rosenbrock",    "ParticleSwarm",            "Rosenbrock()", 1, false},
+   {"pso_griewank",      "ParticleSwarm",            "Griewank()",   1, false},
+   {"sceua_rosenbrock",  "ShuffledComplexEvolution", "Rosenbrock()", 1, false},
+   {"sceua_griewank",    "ShuffledComplexEvolution", "Griewank()",   1, false},
+   {"glue_griewank",     "GLUE",                     "Griewank()",   1, false},
+   {"ddsau_griewank",    "DDSAU",                    "Griewank()",   1, false},
+   {"ddsau_async_griewank", "DDSAU",                 "Griewank()",   1, false},
+   {"grid_griewank",     "GridAlgorithm",            "Griewank()",   1, false},
+   {"grid_async_griewank", "GridAlgorithm",          "Griewank()",   1, false},
+   {"grid_refine_griewank", "GridAlgorithm",         "Griewank()",   1, false},
+   {"vars_rosenbrock",   "VARS",                     "Rosenbrock()", 1, false},
+   {"levmar_rosenbrock", "Levenberg-Marquardt",      "Rosenbrock()", 1, true},
+   {"powell_rosenbrock", "Powell",                   "Rosenbrock()", 1, false},
+   {"powell_griewank",   "Powell",                   "Griewank()",   1, false},
+   {"powell_par_rosenbrock", "Powell",               "Rosenbrock()", 1, false},
+   {"powell_par_griewank",   "Powell",               "Griewank()",   1, false},
+   {"nsgaii_zdt1",       "NSGAII",                   "ZDT()",        2, false},
+   {"nsgaii_dtlz2",      "NSGAII",                   "DTLZ()",       3, false},
+   {"padds_zdt1",        "PADDS",                    "ZDT()",        2, false},
+   {"padds_dtlz2",       "PADDS",                    "DTLZ()",       3, false},
+   {"paes_zdt1",         "PAES",                     "ZDT()",        2, false},
+   {"paes_dtlz2",        "PAES",                     "DTLZ()",       3, false},
+   {"mopsocd_zdt1",      "MOPSOCD",                  "ZDT()",        2, false},
+   {"mopsocd_dtlz2",     "MOPSOCD",                  "DTLZ()",       3, false},
+   {"mopsocd_async_zdt1",  "MOPSOCD",                "ZDT()",        2, false},
+   {"mopsocd_async_dtlz2", "MOPSOCD",                "DTLZ()",       3, false}
+};
+
+/******************************************************************************
+WriteAlgorithm()
+
+Algorithm section of the input file, sized to the evaluation budget.
+******************************************************************************/
+void WriteAlgorithm(FILE * pFile, BenchCase * pCase, int budget, int dim)
+{
+   int gens, i;
+
+   if(strcmp(pCase->program, "DDS") == 0)
+   {
+      fprintf(pFile, "BeginDDSAlg\nPerturbationValue 0.2\nMaxIterations %d\nUseInitialParamValues\nEndDDSAlg\n", budget);
+   }
+   else if(strcmp(pCase->program, "ParticleSwarm") == 0)
+   {
+      gens = budget / 20;
+      if(gens < 1) gens = 1;
+      fprintf(pFile, "BeginParticleSwarm\nSwarmSize 20\nNumGenerations %d\nEndParticleSwarm\n", gens);
+   }
+   else if(strcmp(pCase->program, "ShuffledComplexEvolution") == 0)
+   {
+      fprintf(pFile, "BeginSCEUA\nBudget %d\nEndSCEUA\n", budget);
+   }
+   else if(strcmp(pCase->program, "GLUE") == 0)
+   {
+      fprintf(pFile, "BeginGLUE\nSamplesPerIter 100\nNumBehavioral 50\nMaxSamples %d\nThreshold 10\nEndGLUE\n", budget);
+   }
+   else if(strcmp(pCase->program, "DDSAU") == 0)
+   {
+      //ten searches of budget/20 to 3*budget/20 evaluations
+      gens = budget / 20;
+      if(gens < 6) gens = 6;
+      fprintf(pFile, "Begin_DDSAU_Alg\nPerturbationValue 0.2\nNumSearches 10\nMinItersPerSearch %d\n"
+              "MaxItersPerSearch %d\nThreshold 10\nAsynchronous %s\nEnd_DDSAU_Alg\n", gens, 3*gens,
+              (strstr(pCase->name, "_async_") != NULL) ? "yes" : "no");
+   }
+   else if(strcmp(pCase->program, "GridAlgorithm") == 0)
+   {
+      //largest grid within the budget; the refined case starts from a grid 
+      //four times coarser, and its finest spacing matches the full grid
+      gens = (int)floor(pow((double)budget, 1.00/(double)dim) + 1E-9);
+      if(gens < 2) gens = 2;
+      if(strstr(pCase->name, "_refine_") != NULL) gens = (gens - 1)/4 + 1;
+      if(gens < 2) gens = 2;
+      fprintf(pFile, "BeginGridAlg\nDimensions");
+      for(i = 0; i < dim; i++) fprintf(pFile, " %d", gens);
+      fprintf(pFile, "\nEvalsPerIter 100\n");
+      if(strstr(pCase->name, "_async_") != NULL) fprintf(pFile, "Asynchronous yes\n");
+      if(strstr(pCase->name, "_refine_") != NULL) fprintf(pFile, "RefineLevels 2\nRefineCells 5\n");
+      fprintf(pFile, "EndGridAlg\n");
+   }
+   else if(strcmp(pCase->program, "VARS") == 0)
+   {
+      //a star takes about 1 + 10*dim evaluations (delta h = 0.1)
+      gens = budget / (1 + 10*dim);
+      if(gens < 2) gens = 2;
+      fprintf(pFile, "BeginVARS\nNumStars %d\nDeltaH 0.1\nNumBootstrap 100\nConfidenceLevel 0.90\nEndVARS\n", gens);
+   }
+   else if(strcmp(pCase->program, "Levenberg-Marquardt") == 0)
+   {
+      fprintf(pFile, "BeginLevMar\nMaxIterations 50\nEndLevMar\n");
+   }
+   else if(strcmp(pCase->program, "Powell") == 0)
+   {
+      //"_par_" cases search the directions concurrently
+      fprintf(pFile, "BeginPowellAlg\nMaxIterations 50\nParallelDirections %s\nEndPowellAlg\n",
+              (strstr(pCase->name, "_par_") != NULL) ? "yes" : "no");
+   }
+   else if(strcmp(pCase->program, "NSGAII") == 0)
+   {
+      gens = budget / 20;
+      if(gens < 1) gens = 1;
+      fprintf(pFile, "BeginNSGAII\nPopulationSize 20\nNumGenerations %d\nEndNSGAII\n", gens);
+   }
+   else if(strcmp(pCase->program, "PADDS") == 0)
+   {
+      fprintf(pFile, "BeginPADDS\nMaxIterations %d\nPerturbationValue 0.2\nSelectionMetric ExactHyperVolumeContribution\nEndPADDS\n", budget);
+   }
+   else if(strcmp(pCase->program, "PAES") == 0)
+   {
+      fprintf(pFile, "BeginPAES\nNumberOfIterations %d\nEndPAES\n", budget);
+   }
+   else if(strcmp(pCase->program, "MOPSOCD") == 0)
+   {
+      //initial population plus one per generation
+      gens = budget / 20 - 1;
+      if(gens < 1) gens = 1;
+      fprintf(pFile, "BeginMOPSOCD\nPopSize 20\nMaxGen %d\nAsynchronous %s\nEndMOPSOCD\n", gens,
+              (strstr(pCase->name, "_async_") != NULL) ? "yes" : "no");
+   }
+} /* end WriteAlgorithm() */
+
+/******************************************************************************
+WriteInputFiles()
+
+Write ostIn.txt and the template of the benchmark model input file into the
+current directory.
+******************************************************************************/
+bool WriteInputFiles(BenchCase * pCase, int budget, int dim)
+{
+   FILE * pFile;
+   int i;
+   double lwr, upr, init;
+   bool bUnit;
+
+   pFile = fopen("BenchIn.tpl", "w");
+   if(pFile == NULL) return false;
+   if(strcmp(pCase->model, "DTLZ()") == 0) fprintf(pFile, "BenchVariant 2\nBenchNumObj %d\n", pCase->nobj);
+   if(strcmp(pCase->model, "Sleep()") == 0) fprintf(pFile, "BenchLatencyMs 2\n");
+   if(strcmp(pCase->model, "BigOutput()") == 0) fprintf(pFile, "BenchOutputLines 20000\n");
+   for(i = 0; i < dim; i++) fprintf(pFile, "x _X%03d_\n", i + 1);
+   fclose(pFile);
+
+   pFile = fopen("ostIn.txt", "w");
+   if(pFile == NULL) return false;
+
+   fprintf(pFile, "ProgramType %s\n", pCase->program);
+   fprintf(pFile, "ObjectiveFunction %s\n", (pCase->bRegression == true) ? "WSSE" : "GCOP");
+   fprintf(pFile, "ModelExecutable %s\n", pCase->model);
+   fprintf(pFile, "RandomSeed %d\n", BENCH_SEED);
+   fprintf(pFile, "ProfileEvaluations yes\nProfileTraceLimit 0\nProfileSummaryInterval 1E30\n\n");
+
+   fprintf(pFile, "BeginFilePairs\nBenchIn.tpl ; BenchIn.txt\nEndFilePairs\n\n");
+
+   bUnit = ((strcmp(pCase->model, "ZDT()") == 0) || (strcmp(pCase->model, "DTLZ()") == 0));
+   fprintf(pFile, "BeginParams\n");
+   for(i = 0; i < dim; i++)
+   {
+      if(bUnit == true){ lwr = 0.00; upr = 1.00; init = 0.25;}
+      else if(strcmp(pCase->model, "Griewank()") == 0){ lwr = -600.00; upr = 600.00; init = 300.00;}
+      else if(strcmp(pCase->model, "Rosenbrock()") == 0){ lwr = -2.00; upr = 2.00; init = ((i % 2) == 0) ? -1.20 : 1.00;}
+      else { lwr = -5.00; upr = 5.00; init = 2.50;}
+      fprintf(pFile, "_X%03d_ %E %E %E none none none\n", i + 1, init, lwr, upr);
+   }
+   fprintf(pFile, "EndParams\n\n");
+
+   if(pCase->bRegression == true)
+   {
+      //residuals of the Rosenbrock function, WSSE equals the function value
+      fprintf(pFile, "BeginObservations\n");
+      for(i = 0; i < 2*(dim - 1); i++)
+      {
+         fprintf(pFile, "R%d 0 1 BenchOut.txt ; R%d 0 2 ' ' no\n", i + 1, i + 1);
+      }
+      fprintf(pFile, "EndObservations\n");
+   }
+   else
+   {
+      fprintf(pFile, "BeginResponseVars\n");
+      for(i = 0; i < pCase->nobj; i++)
+      {
+         fprintf(pFile, "F%d BenchOut.txt ; F%d 0 2 ' ' yes\n", i + 1, i + 1);
+      }
+      fprintf(pFile, "EndResponseVars\n\nBeginGCOP\n");
+      for(i = 0; i < pCase->nobj; i++) fprintf(pFile, "CostFunction F%d\n", i + 1);
+      fprintf(pFile, "PenaltyFunction APM\nEndGCOP\n\nBeginConstraints\nEndConstraints\n");
+   }
+   fprintf(pFile, "\n");
+   WriteAlgorithm(pFile, pCase, budget, dim);
+   fclose(pFile);
+   return true;
+} /* end WriteInputFiles() */
+
+/******************************************************************************
+ReadValue()
+
+Value of a "name value" entry of a report file, or -1 if not found.
+******************************************************************************/
+double ReadValue(const char * pFileName, const char * pName, int col)
+{
+   FILE * pFile;
+   char line[BENCH_STR_SZ];
+   char tok[3][BENCH_STR_SZ];
+   double val = -1.00;
+   int n;
+
+   pFile = fopen(pFileName, "r");
+   if(pFile == NULL) return val;
+   while(fgets(line, BENCH_STR_SZ, pFile) != NULL)
+   {
+      n = sscanf(line, "%s %s %s", tok[0], tok[1], tok[2]);
+      if((n > col) && (strcmp(tok[0], pName) == 0))
+      {
+         val = atof(tok[col]);
+         break;
+      }
+   }
+   fclose(pFile);
+   return val;
+} /* end ReadValue() */
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   char exe[BENCH_STR_SZ];
+   char cwd[BENCH_STR_SZ];
+   char cmd[BENCH_STR_SZ];
+   const char * pWorkDir = "OstBenchRuns";
+   const char * pFilter = NULL;
+   int budget = 1000;
+   int dim = 10;
+   int i, j, status, caseBudget, numCases;
+   double wall, evals, run, phase[NUM_PHASES];
+   std::chrono::steady_clock::time_point t0;
+   std::chrono::duration<double> dt;
+
+   strcpy(exe, "./OstrichBench");
+   if(argc > 1) strcpy(exe, argv[1]);
+   if(argc > 2) budget = atoi(argv[2]);
+   if(argc > 3) pWorkDir = argv[3];
+   if(argc > 4) dim = atoi(argv[4]);
+   if(argc > 5) pFilter = argv[5];
+   if(dim < 3)
+   {
+      fprintf(stderr, "dimension must be at least 3\n");
+      return 1;
+   }
+
+   //runs are made in subdirectories, so use an absolute executable path
+   if(BENCH_GETCWD(cwd, BENCH_STR_SZ) == NULL) return 1;
+   if((exe[0] != '/') && (exe[0] != '\\') && (exe[1] != ':'))
+   {
+      sprintf(cmd, "%s/%s", cwd, exe);
+      strcpy(exe, cmd);
+   }
+   BENCH_MKDIR(pWorkDir);
+
+   printf("case,program,model,dim,nobj,status,evals,wall_sec,evals_per_sec,startup_sec,run_sec");
+   for(j = 1; j < NUM_PHASES; j++) printf(",%s_sec", gPhases[j]);
+   printf(",overhead_sec,peak_rss_kB\n");
+   fflush(stdout);
+
+   numCases = (int)(sizeof(gCases) / sizeof(BenchCase));
+   for(i = 0; i < numCases; i++)
+   {
+      if((pFilter != NULL) && (strstr(gCases[i].name, pFilter) == NULL)) continue;
+
+      //slow models get a smaller budget
+      caseBudget = budget;
+      if((strcmp(gCases[i].model, "Sleep()") == 0) || (strcmp(gCases[i].model, "BigOutput()") == 0))
+      {
+         caseBudget = (budget < 200) ? budget : 200;
+      }
+
+      sprintf(cmd, "%s/%s", pWorkDir, gCases[i].name);
+      BENCH_MKDIR(cmd);
+      if(BENCH_CHDIR(cmd) != 0)
+      {
+         fprintf(stderr, "couldn't enter %s\n", cmd);
+         return 1;
+      }
+      remove("OstBench0.txt");
+      remove("OstProfile0.txt");
+      if(WriteInputFiles(&(gCases[i]), caseBudget, dim) == false)
+      {
+         fprintf(stderr, "couldn't write input files for %s\n", gCases[i].name);
+         return 1;
+      }
+
+      sprintf(cmd, "\"%s\" > OstBenchLog.txt 2>&1", exe);
+      t0 = std::chrono::steady_clock::now();
+      status = system(cmd);
+      dt = std::chrono::steady_clock::now() - t0;
+      wall = dt.count();
+
+      evals = ReadValue("OstBench0.txt", "NumEvaluations", 1);
+      run = ReadValue("OstBench0.txt", "RunSec", 1);
+      for(j = 0; j < NUM_PHASES; j++)
+      {
+         phase[j] = ReadValue("OstProfile0.txt", gPhases[j], 2);
+         if(phase[j] < 0.00) phase[j] = 0.00;
+      }
+
+      printf("%s,%s,%s,%d,%d,%d,%.0lf,%.6lf,%.3lf,%.6lf,%.6lf",
+             gCases[i].name, gCases[i].program, gCases[i].model, dim, gCases[i].nobj,
+             status, evals, wall, (evals > 0.00) ? evals/wall : 0.00,
+             ReadValue("OstBench0.txt", "StartupSec", 1), run);
+      for(j = 1; j < NUM_PHASES; j++) printf(",%.6lf", phase[j]);
+      printf(",%.6lf,%.0lf\n", run - phase[0], ReadValue("OstBench0.txt", "PeakRSS_kB", 1));
+      fflush(stdout);
+
+      BENCH_CHDIR(cwd);
+   }/* end for() */
+   return 0;
+} /* end main() */
@@ -0,0 +1,306 @@
+/******************************************************************************
+File      : OstTasker.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Local stand-in for a SuperMUSE tasker, for testing the task queue protocol
+(see SuperMUSE.h) without a cluster. Tasks are taken from the task queue
+directory and run on the local host, several at a time:
+
+   (1) Ostrich writes 'Task<N>.task' to the queue directory. The file holds
+       the command line of the task.
+   (2) The tasker claims the task by renaming it to 'Task<N>.run' (so that
+       several taskers may serve the same queue) and runs the command with
+       the shell, in the server directory.
+   (3) When the command exits, the tasker creates the completion marker
+       'Task<N>.done' (or 'Task<N>.fail' for a non-zero exit status) in the
+       server directory and removes 'Task<N>.run'.
+
+The queue directory is watched with inotify and child processes are reaped
+as soon as they exit, so that the tasker itself adds little latency.
+
+Usage:
+   OstTasker <queue> [workers] [server]
+
+   queue   : the task queue directory (TaskQueue of the SuperMUSE section)
+   workers : maximum number of tasks run at the same time (default 4)
+   server  : directory in which tasks are run and markers are created
+             (default: the current directory)
+
+The tasker runs until it receives SIGINT or SIGTERM, or until a file named
+'OstTasker.stop' is created in the queue directory.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+int main(int argc, char * argv[])
+{
+   fprintf(stderr, "OstTasker is not available on Windows\n");
+   return 1;
+}
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef __linux__
+  #include <sys/inotify.h>
+#endif
+
+#define TASKER_STR_SZ   (4096)
+#define TASKER_MAX_WORK (1024)
+#define TASKER_STOP     "OstTasker.stop"
+
+//a task that is running
+typedef struct TASKER_JOB_STRUCT
+{
+   pid_t pid;
+   int id;
+}TaskerJob;
+
+static TaskerJob gJobs[TASKER_MAX_WORK];
+static int gNumJobs = 0;
+static int gWakeup[2] = {-1, -1};
+static volatile sig_atomic_t gQuit = 0;
+
+/******************************************************************************
+TaskerSignal()
+
+SIGCHLD wakes up the main loop, SIGINT and SIGTERM end it.
+******************************************************************************/
+static void TaskerSignal(int sig)
+{
+   int err = errno;
+   char c = 0;
+
+   if(sig != SIGCHLD) gQuit = 1;
+   if(write(gWakeup[1], &c, 1) < 0){}
+   errno = err;
+} /* end TaskerSignal() */
+
+/******************************************************************************
+TaskerMarker()
+
+Create the completion marker of a task.
+******************************************************************************/
+static void TaskerMarker(const char * server, int id, bool bOk)
+{
+   char name[TASKER_STR_SZ];
+   FILE * pFile;
+
+   snprintf(name, TASKER_STR_SZ, "%s/Task%d.%s", server, id, bOk ? "done" : "fail");
+   pFile = fopen(name, "w");
+   if(pFile == NULL)
+   {
+      fprintf(stderr, "OstTasker: couldn't create %s\n", name);
+      return;
+   }
+   fclose(pFile);
+} /* end TaskerMarker() */
+
+/******************************************************************************
+TaskerReap()
+
+Collect the tasks that have exited and report their completion.
+******************************************************************************/
+static void TaskerReap(const char * queue, const char * server)
+{
+   char name[TASKER_STR_SZ];
+   pid_t pid;
+   int status, i;
+
+   while((pid = waitpid(-1, &status, WNOHANG)) > 0)
+   {
+      for(i = 0; i < gNumJobs; i++)
+      {
+         if(gJobs[i].pid != pid) continue;
+
+         snprintf(name, TASKER_STR_SZ, "%s/Task%d.run", queue, gJobs[i].id);
+         remove(name);
+         TaskerMarker(server, gJobs[i].id, WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+         gJobs[i] = gJobs[--gNumJobs];
+         break;
+      }
+   }/* end while() */
+} /* end TaskerReap() */
+
+/******************************************************************************
+TaskerNextTask()
+
+Id of the queued task with the lowest id, or -1 if the queue is empty.
+******************************************************************************/
+static int TaskerNextTask(const char * queue)
+{
+   DIR * pDir;
+   struct dirent * pEnt;
+   char ext[TASKER_STR_SZ];
+   int id, best;
+
+   best = -1;
+   pDir = opendir(queue);
+   if(pDir == NULL) return -1;
+   while((pEnt = readdir(pDir)) != NULL)
+   {
+      if(sscanf(pEnt->d_name, "Task%d.%s", &id, ext) != 2) continue;
+      if(strcmp(ext, "task") != 0) continue;
+      if((best < 0) || (id < best)) best = id;
+   }
+   closedir(pDir);
+   return best;
+} /* end TaskerNextTask() */
+
+/******************************************************************************
+TaskerStart()
+
+Claim a queued task and start it. Returns false if the task was claimed by
+another tasker (or could not be read).
+******************************************************************************/
+static bool TaskerStart(const char * queue, const char * server, int id)
+{
+   char task[TASKER_STR_SZ];
+   char run[TASKER_STR_SZ];
+   char cmd[TASKER_STR_SZ];
+   FILE * pFile;
+   pid_t pid;
+
+   snprintf(task, TASKER_STR_SZ, "%s/Task%d.task", queue, id);
+   snprintf(run, TASKER_STR_SZ, "%s/Task%d.run", queue, id);
+   if(rename(task, run) != 0) return false;
+
+   pFile = fopen(run, "r");
+   if((pFile == NULL) || (fgets(cmd, TASKER_STR_SZ, pFile) == NULL))
+   {
+      if(pFile != NULL) fclose(pFile);
+      remove(run);
+      TaskerMarker(server, id, false);
+      return false;
+   }
+   fclose(pFile);
+
+   pid = fork();
+   if(pid < 0)
+   {
+      fprintf(stderr, "OstTasker: couldn't fork task %d\n", id);
+      remove(run);
+      TaskerMarker(server, id, false);
+      return false;
+   }
+   if(pid == 0)
+   {
+      signal(SIGCHLD, SIG_DFL);
+      signal(SIGINT, SIG_DFL);
+      signal(SIGTERM, SIG_DFL);
+      if(chdir(server) != 0) _exit(126);
+      execl("/bin/sh", "sh", "-c", cmd, (char *)NULL);
+      _exit(127);
+   }
+
+   gJobs[gNumJobs].pid = pid;
+   gJobs[gNumJobs].id = id;
+   gNumJobs++;
+   return true;
+} /* end TaskerStart() */
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   struct pollfd fds[2];
+   struct sigaction act;
+   struct stat info;
+   char server[TASKER_STR_SZ];
+   char stop[TASKER_STR_SZ];
+   char buf[4096];
+   const char * queue;
+   int workers, nfds, id;
+
+   if(argc < 2)
+   {
+      fprintf(stderr, "usage: OstTasker <queue> [workers] [server]\n");
+      return 1;
+   }
+   queue = argv[1];
+   workers = (argc > 2) ? atoi(argv[2]) : 4;
+   if(workers < 1) workers = 1;
+   if(workers > TASKER_MAX_WORK) workers = TASKER_MAX_WORK;
+   if(argc > 3) strncpy(server, argv[3], TASKER_STR_SZ - 1);
+   else if(getcwd(server, TASKER_STR_SZ) == NULL) strcpy(server, ".");
+   server[TASKER_STR_SZ - 1] = '\0';
+   snprintf(stop, TASKER_STR_SZ, "%s/%s", queue, TASKER_STOP);
+
+   if(pipe(gWakeup) != 0)
+   {
+      fprintf(stderr, "OstTasker: couldn't create pipe\n");
+      return 1;
+   }
+   fcntl(gWakeup[0], F_SETFL, O_NONBLOCK);
+   fcntl(gWakeup[1], F_SETFL, O_NONBLOCK);
+
+   memset(&act, 0, sizeof(act));
+   act.sa_handler = TaskerSignal;
+   sigemptyset(&act.sa_mask);
+   act.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+   sigaction(SIGCHLD, &act, NULL);
+   sigaction(SIGINT, &act, NULL);
+   sigaction(SIGTERM, &act, NULL);
+
+   fds[0].fd = gWakeup[0];
+   fds[0].events = POLLIN;
+   nfds = 1;
+#ifdef __linux__
+   fds[1].fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   fds[1].events = POLLIN;
+   if(fds[1].fd >= 0)
+   {
+      if(inotify_add_watch(fds[1].fd, queue, IN_CREATE | IN_MOVED_TO) >= 0) nfds = 2;
+   }
+#endif
+
+   printf("OstTasker: serving %s with %d workers in %s\n", queue, workers, server);
+   fflush(stdout);
+
+   while(gQuit == 0)
+   {
+      TaskerReap(queue, server);
+      if(stat(stop, &info) == 0) break;
+
+      //start as many tasks as there are free workers
+      while(gNumJobs < workers)
+      {
+         id = TaskerNextTask(queue);
+         if(id < 0) break;
+         TaskerStart(queue, server, id);
+      }
+
+      //without inotify, rescan the queue periodically
+      fds[0].revents = 0;
+      fds[1].revents = 0;
+      poll(fds, nfds, (nfds == 2) ? 1000 : 10);
+      while(read(gWakeup[0], buf, sizeof(buf)) > 0){}
+      if(nfds == 2){ while(read(fds[1].fd, buf, sizeof(buf)) > 0){}}
+   }/* end while() */
+
+   //let running tasks finish
+   while(gNumJobs > 0)
+   {
+      poll(fds, 1, 100);
+      while(read(gWakeup[0], buf, sizeof(buf)) > 0){}
+      TaskerReap(queue, server);
+   }
+   remove(stop);
+   return 0;
+} /* end main() */
+
+#endif /* _WIN32 */
@@ -0,0 +1,346 @@
+/******************************************************************************
+File      : PaesBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark of the PAES archive. A synthetic stream of candidate solutions is
+offered to archives of increasing maximum length. The candidates lie near a
+linear Pareto front (a simplex) at a distance that shrinks as the stream goes
+on, so that most of them are non-dominated when offered and the archive fills
+up and stays full. For each maximum archive length the benchmark reports:
+
+   sec        : time to offer the whole stream to a PAES_Archive
+   legacy_sec : the same, as previously done, i.e. a linear scan of the
+                archive with shifting deletions, and the adaptive grid
+                recomputed for every candidate (only for lengths up to
+                legacyMaxLen)
+   us_insert  : sec per candidate, in microseconds
+   size       : final number of archive members (PAES_Archive)
+   lsize      : final number of archive members (legacy)
+   rebounds   : number of times the limits of the adaptive grid changed
+   ok         : 1 if the members of the final archive are mutually
+                non-dominated, 0 otherwise
+
+Usage:
+   PaesBench [nobj] [maxLen] [legacyMaxLen] [numCandidates] [depth] [seed]
+
+Output is one whitespace-delimited record per maximum archive length,
+preceded by a header line.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "PAES_Genetics.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+/******************************************************************************
+class BenchProblem
+
+A problem with a single real variable, candidates are given their fitness
+directly.
+******************************************************************************/
+class BenchProblem : public PAES_MultiobjectiveProblem
+{
+   public:
+      BenchProblem(int nobj)
+      {
+         strcpy(m_problemName, "PaesBench");
+         m_numberOfVariables = 1;
+         m_numberOfFunctions = nobj;
+         m_numberOfConstraints = 0;
+         m_variable = new PAES_VariableType[1];
+         m_variable[0] = PAES_REAL;
+         m_lowerLimit = new double[1];
+         m_upperLimit = new double[1];
+         m_lowerLimit[0] = 0.00;
+         m_upperLimit[0] = 1.00;
+         m_precision = NULL;
+         m_bitsPerVariable = NULL;
+         m_numberOfBits = 0;
+         m_cout = stdout;
+      }
+      ~BenchProblem(void)
+      {
+         delete [] m_variable;
+         delete [] m_lowerLimit;
+         delete [] m_upperLimit;
+      }
+      void evaluate(PAES_Individual * individual, double * X, int np, double * F, int nf){ return; }
+}; /* end class BenchProblem */
+
+/******************************************************************************
+MakeStream()
+
+Candidate solutions: a random point of the simplex, pushed away from it by a
+random distance that shrinks along the stream.
+******************************************************************************/
+PAES_Individual ** MakeStream(int n, int nobj, BenchProblem * pProb, PAES_Random * pRand)
+{
+   PAES_Individual ** pStream = new PAES_Individual *[n];
+   double * F = new double[nobj];
+   double X = 0.50;
+   double sum, off;
+   int i, k;
+
+   for(i = 0; i < n; i++)
+   {
+      sum = 0.00;
+      for(k = 0; k < nobj; k++)
+      {
+         F[k] = -log(1.00 - UniformRandom() + 1E-12);
+         sum += F[k];
+      }
+      off = 0.10 * (1.00 - 0.01*(double)i/(double)n);
+      for(k = 0; k < nobj; k++)
+      {
+         F[k] = F[k]/sum + off*(1.00 + 1E-4*UniformRandom());
+      }
+      pStream[i] = new PAES_Individual(&X, F, pProb, pRand, stdout);
+   }
+   delete [] F;
+   return pStream;
+} /* end MakeStream() */
+
+/******************************************************************************
+LegacyFindLocation()
+
+PAES_AdaptiveGrid::findLocation(), as previously done.
+******************************************************************************/
+int LegacyFindLocation(PAES_Individual * pInd, int nobj, int depth, double * pLower,
+                       double * pDivSize, int * pIncr, double * pTmpDiv)
+{
+   int i, j, location, counter;
+
+   location = 0;
+   counter  = 1;
+   for (i = 0; i < nobj; i++)
+   {
+      pIncr[i] = counter;
+      counter *= 2;
+      pTmpDiv[i] = pDivSize[i];
+   }
+   for (i = 1; i <= depth; i++)
+   {
+      for (j = 0; j < nobj; j++)
+      {
+         if (pInd->m_fitness[j] < (pTmpDiv[j]/2 + pLower[j])) location = pIncr[j];
+         else pLower[j] += pTmpDiv[j] / 2.0;
+      }
+      for (j = 0; j < nobj; j++)
+      {
+         pIncr[j] *= nobj * 2;
+         pTmpDiv[j] /= 2.0;
+      }
+   }
+   return location;
+} /* end LegacyFindLocation() */
+
+/******************************************************************************
+LegacyRun()
+
+Offer the stream to an archive, as previously done (see PAES::testAndUpdate()
+and PAES::archiveSolution()). Returns the final archive length.
+******************************************************************************/
+int LegacyRun(PAES_Individual ** pStream, int n, int nobj, int depth, int maxLen,
+              BenchProblem * pProb, PAES_Random * pRand)
+{
+   PAES_Population * pArch;
+   PAES_Individual * pSol;
+   double * pLower, * pUpper, * pDivSize, * pTmpDiv;
+   int * pIncr, * pCube;
+   int i, j, k, s, gridSize, location, mostCrowded, result, size;
+   bool finish, store;
+
+   pArch = new PAES_Population(0, maxLen, pRand, pProb, stdout);
+   gridSize = (int)floor(pow(2.0, (double)depth * (double)nobj));
+   pCube = new int[gridSize];
+   pLower = new double[nobj];
+   pUpper = new double[nobj];
+   pDivSize = new double[nobj];
+   pTmpDiv = new double[nobj];
+   pIncr = new int[nobj];
+
+   for(s = 0; s < n; s++)
+   {
+      pSol = new PAES_Individual(pStream[s]);
+
+      //updateGridLocations()
+      for(k = 0; k < nobj; k++)
+      {
+         pLower[k] = pUpper[k] = pSol->m_fitness[k];
+         for(j = 0; j < pArch->getPopulationSize(); j++)
+         {
+            if(pArch->getIth(j)->m_fitness[k] < pLower[k]) pLower[k] = pArch->getIth(j)->m_fitness[k];
+            if(pArch->getIth(j)->m_fitness[k] > pUpper[k]) pUpper[k] = pArch->getIth(j)->m_fitness[k];
+         }
+         pDivSize[k] = pUpper[k] - pLower[k];
+      }
+      for(i = 0; i < gridSize; i++) pCube[i] = 0;
+      mostCrowded = 0;
+      location = LegacyFindLocation(pSol, nobj, depth, pLower, pDivSize, pIncr, pTmpDiv);
+      pSol->m_gridLocation = location;
+      pCube[location]++;
+      for(i = 0; i < pArch->getPopulationSize(); i++)
+      {
+         location = LegacyFindLocation(pArch->getIth(i), nobj, depth, pLower, pDivSize, pIncr, pTmpDiv);
+         pArch->getIth(i)->m_gridLocation = location;
+         pCube[location]++;
+         if(pCube[location] > pCube[mostCrowded]) mostCrowded = location;
+      }
+
+      //archiveSolution()
+      finish = false;
+      store = true;
+      if(pArch->getPopulationSize() == 0)
+      {
+         pArch->addIndividual(pSol);
+         continue;
+      }
+      for(i = 0; (i < pArch->getPopulationSize()) && !finish; i++)
+      {
+         if(pSol->identicalFitness(pArch->getIth(i))){ finish = true; store = false;}
+         else
+         {
+            result = pSol->dominanceTest(pArch->getIth(i));
+            if(result == -1){ finish = true; store = false;}
+            else if(result == 1) pArch->deleteIth(i);
+         }
+      }
+      if(!store){ delete pSol; continue;}
+      if(pArch->getPopulationSize() < maxLen){ pArch->addIndividual(pSol); continue;}
+      if((int)pSol->m_gridLocation == mostCrowded){ delete pSol; continue;}
+      for(i = 0; i < pArch->getPopulationSize(); i++)
+      {
+         if((int)pArch->getIth(i)->m_gridLocation == mostCrowded)
+         {
+            pArch->deleteIth(i);
+            pArch->addIndividual(pSol);
+            break;
+         }
+      }
+      if(i == pArch->getPopulationSize()) delete pSol;
+   }
+
+   size = pArch->getPopulationSize();
+   for(i = 0; i < size; i++) delete pArch->getIth(i);
+   delete pArch;
+   delete [] pCube;
+   delete [] pLower;
+   delete [] pUpper;
+   delete [] pDivSize;
+   delete [] pTmpDiv;
+   delete [] pIncr;
+   return size;
+} /* end LegacyRun() */
+
+/******************************************************************************
+CheckArchive()
+
+True if the members of the archive are mutually non-dominated.
+******************************************************************************/
+bool CheckArchive(PAES_Population * pArch)
+{
+   int i, j;
+   for(i = 0; i < pArch->getPopulationSize(); i++)
+   {
+      for(j = i + 1; j < pArch->getPopulationSize(); j++)
+      {
+         if(pArch->getIth(i)->identicalFitness(pArch->getIth(j))) return false;
+         if(pArch->getIth(i)->dominanceTest(pArch->getIth(j)) != 0) return false;
+      }
+   }
+   return true;
+} /* end CheckArchive() */
+
+/******************************************************************************
+BenchSize()
+******************************************************************************/
+void BenchSize(PAES_Individual ** pStream, int n, int nobj, int depth, int maxLen,
+               int legacyMaxLen, BenchProblem * pProb, PAES_Random * pRand)
+{
+   PAES_Archive * pArch;
+   PAES_Individual ** pCopies;
+   double start, sec, legacy;
+   int i, lsize;
+   bool ok;
+
+   //copies are made ahead of time, the archive takes ownership
+   pCopies = new PAES_Individual *[n];
+   for(i = 0; i < n; i++) pCopies[i] = new PAES_Individual(pStream[i]);
+
+   pArch = new PAES_Archive(maxLen, depth, pRand, pProb, stdout);
+   start = GetElapsedTics();
+   for(i = 0; i < n; i++) pArch->archiveSolution(pCopies[i]);
+   sec = GetElapsedTics() - start;
+   ok = CheckArchive(pArch);
+
+   legacy = -1.00;
+   lsize = -1;
+   if(maxLen <= legacyMaxLen)
+   {
+      start = GetElapsedTics();
+      lsize = LegacyRun(pStream, n, nobj, depth, maxLen, pProb, pRand);
+      legacy = GetElapsedTics() - start;
+   }
+
+   printf("%5d %7d %8d %12.6lf %12.6lf %10.3lf %7d %7d %8d %3d\n",
+          nobj, maxLen, n, sec, legacy, 1E6*sec/(double)n, pArch->getPopulationSize(),
+          lsize, pArch->getNumberOfRebounds(), ok ? 1 : 0);
+   fflush(stdout);
+
+   delete pArch;
+   delete [] pCopies;
+} /* end BenchSize() */
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   int nobj = 2;
+   int maxLen = 8000;
+   int legacyMaxLen = 8000;
+   int n = 50000;
+   int depth = 4;
+   unsigned int seed = 12345;
+   int len, i;
+   BenchProblem * pProb;
+   PAES_Random rand;
+   PAES_Individual ** pStream;
+
+   if(argc > 1) nobj = atoi(argv[1]);
+   if(argc > 2) maxLen = atoi(argv[2]);
+   if(argc > 3) legacyMaxLen = atoi(argv[3]);
+   if(argc > 4) n = atoi(argv[4]);
+   if(argc > 5) depth = atoi(argv[5]);
+   if(argc > 6) seed = (unsigned int)atoi(argv[6]);
+   if((nobj < 2) || (maxLen < 1) || (n < 1))
+   {
+      fprintf(stderr, "need at least two objectives, and one member and candidate\n");
+      return 1;
+   }
+
+   ResetRandomSeed(seed);
+   pProb = new BenchProblem(nobj);
+   pStream = MakeStream(n, nobj, pProb, &rand);
+
+   printf("%5s %7s %8s %12s %12s %10s %7s %7s %8s %3s\n",
+          "nobj", "maxlen", "cands", "sec", "legacy_sec", "us_insert", "size", "lsize",
+          "rebounds", "ok");
+   for(len = 125; len <= maxLen; len *= 2)
+   {
+      BenchSize(pStream, n, nobj, depth, len, legacyMaxLen, pProb, &rand);
+   }
+
+   for(i = 0; i < n; i++) delete pStream[i];
+   delete [] pStream;
+   delete pProb;
+   return 0;
+} /* end main() */
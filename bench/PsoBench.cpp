@@ -0,0 +1,234 @@
+/******************************************************************************
+File      : PsoBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark of the particle swarm update. For each swarm size and number of
+parameters the benchmark times one generation of particle movement using:
+
+   aos    : the former per-particle storage (an array of particle structures,
+            each with its own position, velocity and best vectors) and the
+            former element-by-element update, including the packing and
+            unpacking of positions that preceded each broadcast.
+   kernel : the contiguous swarm matrices and update of SwarmKernel, whose
+            position matrix is broadcast in place.
+
+Particles are placed in the unit hypercube and the best particle is chosen
+at random. Reported times are per generation, averaged over the repetitions.
+
+Usage:
+   PsoBench [maxSwarm] [reps] [seed]
+
+Output is one whitespace-delimited record per method, swarm size and number
+of parameters, preceded by a header line.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "SwarmKernel.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#define PSO_CONSTRICT (1.00)
+#define PSO_INERTIA   (1.20)
+#define PSO_C1        (2.00)
+#define PSO_C2        (2.00)
+
+/******************************************************************************
+struct OldParticle
+
+Storage of a particle prior to the swarm kernel.
+******************************************************************************/
+typedef struct OLD_PARTICLE_STRUCT
+{
+   double * x;
+   double * v;
+   double * b;
+}OldParticle;
+
+/******************************************************************************
+MoveOld()
+
+Former update of the swarm, one element at a time, followed by the packing
+and unpacking of positions for a broadcast. Returns the time spent packing.
+******************************************************************************/
+double MoveOld(OldParticle * pSwarm, int np, int nd, int g, int best, double * pBuf)
+{
+   int i, j;
+   double x, pl, pg, r1, r2, v, vmin, sgn, upr, lwr;
+   double dx_min, dx_frac, start;
+
+   for(i = 0; i < np; i++)
+   {
+      for(j = 0; j < nd; j++)
+      {
+         x = pSwarm[i].x[j];
+         pl = pSwarm[i].b[j];
+         pg = pSwarm[best].b[j];
+         r1 = (double)MyRand() / (double)MY_RAND_MAX;
+         r2 = (double)MyRand() / (double)MY_RAND_MAX;
+         v = pSwarm[i].v[j];
+         v = PSO_CONSTRICT*((PSO_INERTIA*v) + PSO_C1*r1*(pl-x) + PSO_C2*r2*(pg-x));
+         vmin = (0.01*fabs(x))/(g+1);
+         if(fabs(v) < vmin)
+         {
+            sgn = (double)MyRand() / (double)MY_RAND_MAX;
+            if(sgn >= 0.50) v = +((1.00+r1)*vmin);
+            else            v = -((1.00+r2)*vmin);
+         }
+         pSwarm[i].v[j] = v;
+         pSwarm[i].x[j] = x + v;
+      }
+      dx_min = 1.00;
+      lwr = 0.00;
+      upr = 1.00;
+      for(j = 0; j < nd; j++)
+      {
+         v = pSwarm[i].v[j];
+         x = pSwarm[i].x[j] - v;
+         if(pSwarm[i].x[j] > upr)
+         {
+            dx_frac = fabs((0.5*(upr-x))/v);
+            if(dx_frac < dx_min) dx_min = dx_frac;
+         }
+         if(pSwarm[i].x[j] < lwr)
+         {
+            dx_frac = fabs((0.5*(lwr-x))/v);
+            if(dx_frac < dx_min) dx_min = dx_frac;
+         }
+      }
+      for(j = 0; j < nd; j++)
+      {
+         v = pSwarm[i].v[j];
+         x = pSwarm[i].x[j] - v;
+         pSwarm[i].v[j] *= dx_min;
+         pSwarm[i].x[j] = x + (v*dx_min);
+      }
+   }
+
+   start = GetElapsedTics();
+   for(j = 0; j < nd; j++)
+   {
+      for(i = 0; i < np; i++) pBuf[nd*i + j] = pSwarm[i].x[j];
+   }
+   for(j = 0; j < nd; j++)
+   {
+      for(i = 0; i < np; i++) pSwarm[i].x[j] = pBuf[nd*i + j];
+   }
+   return GetElapsedTics() - start;
+}
+
+/******************************************************************************
+Report()
+******************************************************************************/
+void Report(const char * pName, int np, int nd, int reps, double sec, double pack)
+{
+   printf("%-8s %6d %6d %12.6E %12.6E %14.1lf\n", pName, np, nd,
+          sec/reps, pack/reps, (double)reps*np*nd/sec);
+   fflush(stdout);
+}
+
+/******************************************************************************
+BenchOld()
+******************************************************************************/
+void BenchOld(int np, int nd, int reps)
+{
+   OldParticle * pSwarm = new OldParticle[np];
+   double * pBuf = new double[(size_t)np*nd];
+   double start, sec, pack;
+   int i, j, g;
+
+   for(i = 0; i < np; i++)
+   {
+      pSwarm[i].x = new double[nd];
+      pSwarm[i].v = new double[nd];
+      pSwarm[i].b = new double[nd];
+      for(j = 0; j < nd; j++)
+      {
+         pSwarm[i].x[j] = pSwarm[i].b[j] = UniformRandom();
+         pSwarm[i].v[j] = 0.00;
+      }
+   }
+
+   pack = 0.00;
+   start = GetElapsedTics();
+   for(g = 0; g < reps; g++)
+   {
+      pack += MoveOld(pSwarm, np, nd, g, MyRand() % np, pBuf);
+   }
+   sec = GetElapsedTics() - start;
+   Report("aos", np, nd, reps, sec, pack);
+
+   for(i = 0; i < np; i++)
+   {
+      delete [] pSwarm[i].x;
+      delete [] pSwarm[i].v;
+      delete [] pSwarm[i].b;
+   }
+   delete [] pSwarm;
+   delete [] pBuf;
+}
+
+/******************************************************************************
+BenchKernel()
+******************************************************************************/
+void BenchKernel(int np, int nd, int reps)
+{
+   SwarmKernel * pSwarm = new SwarmKernel(np, nd, 0);
+   double start, sec;
+   int i, j, g;
+
+   for(j = 0; j < nd; j++) pSwarm->SetBounds(j, 0.00, 1.00, true);
+   for(i = 0; i < np; i++)
+   {
+      for(j = 0; j < nd; j++) pSwarm->GetX(i)[j] = UniformRandom();
+   }
+   pSwarm->InitBest();
+
+   start = GetElapsedTics();
+   for(g = 0; g < reps; g++)
+   {
+      pSwarm->Move(g, MyRand() % np, PSO_CONSTRICT, PSO_INERTIA, PSO_C1, PSO_C2);
+   }
+   sec = GetElapsedTics() - start;
+   Report("kernel", np, nd, reps, sec, 0.00);
+
+   delete pSwarm;
+}
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   int maxSwarm = 10000;
+   int reps = 20;
+   unsigned int seed = 12345;
+   int np, k;
+   int dims[] = {10, 30, 100};
+
+   if(argc > 1) maxSwarm = atoi(argv[1]);
+   if(argc > 2) reps = atoi(argv[2]);
+   if(argc > 3) seed = (unsigned int)atoi(argv[3]);
+   if(reps < 1) reps = 1;
+
+   ResetRandomSeed(seed);
+
+   printf("%-8s %6s %6s %12s %12s %14s\n",
+          "method", "swarm", "dim", "gen_sec", "pack_sec", "elems_per_sec");
+   for(np = 100; np <= maxSwarm; np *= 10)
+   {
+      for(k = 0; k < 3; k++)
+      {
+         BenchOld(np, dims[k], reps);
+         BenchKernel(np, dims[k], reps);
+      }
+   }
+   return 0;
+} /* end main() */
@@ -0,0 +1,334 @@
+/******************************************************************************
+File      : QmcBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark of the sample generators that are available for initializing
+populations: pseudo-random, Latin hypercube, maximin Latin hypercube, and the
+scrambled Halton and Sobol sequences. For each generator and sample size the
+benchmark reports the generation time and several measures of space-filling
+quality:
+
+   ks   : largest one-dimensional Kolmogorov-Smirnov distance, over all
+          dimensions (smaller is better).
+   chi2 : chi-square statistic of two-dimensional projections onto a 64x64
+          grid, for each pair of consecutive dimensions, divided by its
+          degrees of freedom and averaged over the pairs. Independent uniform
+          samples give values near 1, smaller is better.
+   dmin : smallest inter-point distance in the unit hypercube (larger is
+          better). Only computed for small sample sizes.
+
+The ks and chi2 measures are accumulated as points are generated, so the
+benchmark runs in O(n*d) memory for the sequences.
+
+Usage:
+   QmcBench [dim] [maxN] [lhsMaxN] [maximinMaxN] [maximinIters] [seed]
+
+Output is one whitespace-delimited record per generator and sample size,
+preceded by a header line.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "QuasiRandom.h"
+#include "LatinHypercube.h"
+#include "MaximinLatinHypercube.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#define KS_BINS   (65536)
+#define GRID_SIZE (64)
+#define BLOCK_SIZE (1024)
+#define DMIN_MAX_N (10000)
+
+/******************************************************************************
+class QualityStats
+
+Streaming accumulator for the space-filling quality measures.
+******************************************************************************/
+class QualityStats
+{
+   public:
+      QualityStats(int dim, long long n);
+      ~QualityStats(void);
+      void Add(double * pX);
+      double GetKS(void);
+      double GetChi2(void);
+      double GetMinDist(void);
+
+   private:
+      int * m_pHist;
+      int * m_pGrid;
+      double * m_pKeep;
+      long long m_Num;
+      long long m_Count;
+      int m_Dim;
+}; /* end class QualityStats */
+
+QualityStats::QualityStats(int dim, long long n)
+{
+   m_Dim = dim;
+   m_Num = n;
+   m_Count = 0;
+   m_pHist = new int[(size_t)dim*KS_BINS];
+   m_pGrid = new int[(size_t)(dim - 1)*GRID_SIZE*GRID_SIZE];
+   memset(m_pHist, 0, sizeof(int)*(size_t)dim*KS_BINS);
+   memset(m_pGrid, 0, sizeof(int)*(size_t)(dim - 1)*GRID_SIZE*GRID_SIZE);
+   m_pKeep = NULL;
+   if(n <= DMIN_MAX_N) m_pKeep = new double[(size_t)n*dim];
+}
+
+QualityStats::~QualityStats(void)
+{
+   delete [] m_pHist;
+   delete [] m_pGrid;
+   delete [] m_pKeep;
+}
+
+void QualityStats::Add(double * pX)
+{
+   int j, b, g1, g2;
+
+   for(j = 0; j < m_Dim; j++)
+   {
+      b = (int)(pX[j]*KS_BINS);
+      if(b >= KS_BINS) b = KS_BINS - 1;
+      m_pHist[j*KS_BINS + b]++;
+   }
+   for(j = 0; j < m_Dim - 1; j++)
+   {
+      g1 = (int)(pX[j]*GRID_SIZE);
+      g2 = (int)(pX[j+1]*GRID_SIZE);
+      if(g1 >= GRID_SIZE) g1 = GRID_SIZE - 1;
+      if(g2 >= GRID_SIZE) g2 = GRID_SIZE - 1;
+      m_pGrid[(j*GRID_SIZE + g1)*GRID_SIZE + g2]++;
+   }
+   if(m_pKeep != NULL)
+   {
+      memcpy(&(m_pKeep[m_Count*m_Dim]), pX, sizeof(double)*m_Dim);
+   }
+   m_Count++;
+}
+
+double QualityStats::GetKS(void)
+{
+   int j, b;
+   long long cum;
+   double d, dmax;
+
+   dmax = 0.00;
+   for(j = 0; j < m_Dim; j++)
+   {
+      cum = 0;
+      for(b = 0; b < KS_BINS; b++)
+      {
+         cum += m_pHist[j*KS_BINS + b];
+         d = fabs((double)cum/(double)m_Count - (double)(b + 1)/(double)KS_BINS);
+         if(d > dmax) dmax = d;
+      }
+   }
+   return dmax;
+}
+
+double QualityStats::GetChi2(void)
+{
+   int j, c, ncells;
+   double e, d, sum, total;
+
+   ncells = GRID_SIZE*GRID_SIZE;
+   e = (double)m_Count / (double)ncells;
+   total = 0.00;
+   for(j = 0; j < m_Dim - 1; j++)
+   {
+      sum = 0.00;
+      for(c = 0; c < ncells; c++)
+      {
+         d = (double)m_pGrid[j*ncells + c] - e;
+         sum += d*d/e;
+      }
+      total += sum / (double)(ncells - 1);
+   }
+   return total / (double)(m_Dim - 1);
+}
+
+double QualityStats::GetMinDist(void)
+{
+   long long a, b;
+   int k;
+   double d, sum, dmin;
+
+   if(m_pKeep == NULL) return -1.00;
+   dmin = NEARLY_HUGE;
+   for(a = 0; a < m_Count; a++)
+   {
+      for(b = a + 1; b < m_Count; b++)
+      {
+         sum = 0.00;
+         for(k = 0; k < m_Dim; k++)
+         {
+            d = m_pKeep[a*m_Dim + k] - m_pKeep[b*m_Dim + k];
+            sum += d*d;
+            if(sum >= dmin) break;
+         }
+         if(sum < dmin) dmin = sum;
+      }
+   }
+   return sqrt(dmin);
+}
+
+/******************************************************************************
+Report()
+******************************************************************************/
+void Report(const char * pName, int dim, long long n, double sec, QualityStats * pStats)
+{
+   printf("%-12s %6d %9lld %12.6lf %14.1lf %12.6E %12.6E %12.6E\n",
+          pName, dim, n, sec, (double)n/sec, pStats->GetKS(), pStats->GetChi2(),
+          pStats->GetMinDist());
+   fflush(stdout);
+}
+
+/******************************************************************************
+BenchSequence()
+
+Time generation of n points of a random or quasi-random sequence, in blocks,
+and accumulate quality statistics outside of the timed region.
+******************************************************************************/
+void BenchSequence(const char * pName, int dim, long long n, QuasiRandom * pQmc)
+{
+   double * pBlock = new double[(size_t)BLOCK_SIZE*dim];
+   QualityStats stats(dim, n);
+   double start, sec;
+   long long i, base;
+   int k, j, m;
+
+   sec = 0.00;
+   for(base = 0; base < n; base += BLOCK_SIZE)
+   {
+      m = (int)(((n - base) < BLOCK_SIZE) ? (n - base) : BLOCK_SIZE);
+      start = GetElapsedTics();
+      for(k = 0; k < m; k++)
+      {
+         i = base + k;
+         if(pQmc != NULL)
+         {
+            pQmc->GetPoint(i, &(pBlock[k*dim]));
+         }
+         else
+         {
+            for(j = 0; j < dim; j++) pBlock[k*dim + j] = UniformRandom();
+         }
+      }
+      sec += GetElapsedTics() - start;
+      for(k = 0; k < m; k++) stats.Add(&(pBlock[k*dim]));
+   }
+   Report(pName, dim, n, sec, &stats);
+   delete [] pBlock;
+}
+
+/******************************************************************************
+BenchLHS()
+******************************************************************************/
+void BenchLHS(int dim, long long n)
+{
+   LatinHypercube * pLHS;
+   QualityStats stats(dim, n);
+   double * pAll = new double[(size_t)n*dim];
+   double start, sec;
+   long long i;
+   int j;
+
+   start = GetElapsedTics();
+   pLHS = new LatinHypercube(dim, (int)n);
+   for(j = 0; j < dim; j++) pLHS->InitRow(j, 0.00, 1.00);
+   for(i = 0; i < n; i++)
+   {
+      for(j = 0; j < dim; j++) pAll[i*dim + j] = pLHS->SampleRow(j);
+   }
+   sec = GetElapsedTics() - start;
+   delete pLHS;
+
+   for(i = 0; i < n; i++) stats.Add(&(pAll[i*dim]));
+   Report("lhs", dim, n, sec, &stats);
+   delete [] pAll;
+}
+
+/******************************************************************************
+BenchMaximinLHS()
+******************************************************************************/
+void BenchMaximinLHS(int dim, long long n, int iters)
+{
+   MaximinLatinHypercube * pLHS;
+   QualityStats stats(dim, n);
+   double * pX = new double[dim];
+   double start, sec;
+   long long i;
+
+   start = GetElapsedTics();
+   pLHS = new MaximinLatinHypercube(dim, (int)n);
+   pLHS->Generate(iters);
+   sec = GetElapsedTics() - start;
+
+   for(i = 0; i < n; i++)
+   {
+      pLHS->GetPoint((int)i, pX);
+      stats.Add(pX);
+   }
+   Report("maximinlhs", dim, n, sec, &stats);
+   fprintf(stderr, "maximinlhs n=%lld : %d of %d swaps accepted\n", n, pLHS->GetNumAccepted(), iters);
+   delete pLHS;
+   delete [] pX;
+}
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   int dim = 50;
+   long long maxN = 1000000;
+   long long lhsMaxN = 10000; //LatinHypercube::SampleRow() is O(n)
+   long long maximinMaxN = 10000;
+   int maximinIters = 1000;
+   unsigned int seed = 12345;
+   long long n;
+   QuasiRandom * pQmc;
+
+   if(argc > 1) dim = atoi(argv[1]);
+   if(argc > 2) maxN = atoll(argv[2]);
+   if(argc > 3) lhsMaxN = atoll(argv[3]);
+   if(argc > 4) maximinMaxN = atoll(argv[4]);
+   if(argc > 5) maximinIters = atoi(argv[5]);
+   if(argc > 6) seed = (unsigned int)atoi(argv[6]);
+   if(dim < 2)
+   {
+      fprintf(stderr, "dimension must be at least 2\n");
+      return 1;
+   }
+
+   ResetRandomSeed(seed);
+
+   printf("%-12s %6s %9s %12s %14s %12s %12s %12s\n",
+          "method", "dim", "n", "gen_sec", "points_per_sec", "ks", "chi2", "dmin");
+   for(n = 10000; n <= maxN; n *= 10)
+   {
+      BenchSequence("random", dim, n, NULL);
+
+      pQmc = new QuasiRandom(dim, QMC_HALTON, true);
+      BenchSequence("halton", dim, n, pQmc);
+      delete pQmc;
+
+      pQmc = new QuasiRandom(dim, QMC_SOBOL, true);
+      BenchSequence("sobol", dim, n, pQmc);
+      delete pQmc;
+
+      if(n <= lhsMaxN) BenchLHS(dim, n);
+      if(n <= maximinMaxN) BenchMaximinLHS(dim, n, maximinIters);
+   }
+   return 0;
+} /* end main() */
@@ -0,0 +1,290 @@
+/******************************************************************************
+File      : RbfBench.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Benchmark of the MQ-RBF Interpolator. For each number of known points (m) the
+benchmark reports:
+
+   fit_sec     : full fit (SetBasis() and Interpolate())
+   legacy_sec  : full fit as previously done, i.e. the interpolation matrix is
+                 built as a double ** and inverted with MatInv() (only for m up
+                 to legacyMaxM)
+   add_sec     : average time of AddBasis() (incremental)
+   repl_sec    : average time of ReplaceBasis() (incremental)
+   query_sec   : batched Evaluate() of the query points
+   lquery_sec  : the same queries, evaluated as previously done (one loop over
+                 the known points per query, with the points stored by point)
+   err         : largest difference between the known values and the
+                 interpolation at the known points, after the incremental
+                 updates, relative to the range of the known values
+
+The known values are samples of a smooth test function of points drawn
+uniformly from the unit hypercube.
+
+Usage:
+   RbfBench [dim] [maxM] [legacyMaxM] [numQueries] [numUpdates] [seed]
+
+Output is one whitespace-delimited record per number of known points,
+preceded by a header line.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Interpolator.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+//timings are the best of this many repetitions
+#define BENCH_REPS (3)
+
+/******************************************************************************
+TestFunc()
+******************************************************************************/
+double TestFunc(double * pX, int dim)
+{
+   double f = 0.00;
+   int k;
+   for(k = 0; k < dim; k++) f += sin(3.00*pX[k]) + pX[k]*pX[(k + 1) % dim];
+   return f;
+}
+
+/******************************************************************************
+MakePoints()
+
+Allocate n points of dimension dim, drawn from the unit hypercube.
+******************************************************************************/
+MyPoint * MakePoints(int n, int dim, double * pStore)
+{
+   MyPoint * pPts = new MyPoint[n];
+   int i, k;
+   for(i = 0; i < n; i++)
+   {
+      pPts[i].ndim = dim;
+      pPts[i].v = &(pStore[(size_t)i*dim]);
+      for(k = 0; k < dim; k++) pPts[i].v[k] = UniformRandom();
+      pPts[i].F = TestFunc(pPts[i].v, dim);
+   }
+   return pPts;
+}
+
+/******************************************************************************
+LegacyFit()
+
+Fit as previously done, returns the coefficients in pCoeffs.
+******************************************************************************/
+void LegacyFit(MyPoint * pPts, int m, double * pCoeffs)
+{
+   double ** A = new double *[m];
+   double ** Ainv = new double *[m];
+   double * b = new double[m];
+   double avg, dij, t;
+   int i, j, k;
+
+   avg = 0.00;
+   for(i = 0; i < m; i++) avg += pPts[i].F;
+   avg /= (double)m;
+   for(i = 0; i < m; i++)
+   {
+      A[i] = new double[m];
+      Ainv[i] = new double[m];
+      b[i] = pPts[i].F - avg;
+      for(j = 0; j < m; j++)
+      {
+         dij = 0.00;
+         for(k = 0; k < pPts[i].ndim; k++)
+         {
+            t = pPts[i].v[k] - pPts[j].v[k];
+            dij += t*t;
+         }
+         A[i][j] = sqrt(dij);
+         Ainv[i][j] = 0.00;
+      }
+   }
+   MatInv(A, Ainv, m);
+   VectMult(Ainv, b, pCoeffs, m, m);
+
+   for(i = 0; i < m; i++){ delete [] A[i]; delete [] Ainv[i];}
+   delete [] A;
+   delete [] Ainv;
+   delete [] b;
+   MatInv(NULL, NULL, 0);
+}
+
+/******************************************************************************
+LegacyEvaluate()
+
+Evaluate as previously done.
+******************************************************************************/
+double LegacyEvaluate(MyPoint * pPts, int m, double * pCoeffs, double avg, MyPoint * pQ)
+{
+   double sum, di, t;
+   int i, j;
+
+   sum = 0.00;
+   for(i = 0; i < m; i++)
+   {
+      di = 0.00;
+      for(j = 0; j < pQ->ndim; j++)
+      {
+         t = pQ->v[j] - pPts[i].v[j];
+         di += t*t;
+      }
+      sum += pCoeffs[i]*sqrt(di);
+   }
+   return sum + avg;
+}
+
+/******************************************************************************
+BenchSize()
+******************************************************************************/
+void BenchSize(int dim, int m, int legacyMaxM, int nq, int nu)
+{
+   double * pStore, * pQStore, * pCoeffs;
+   MyPoint * pPts, * pNew, * pQ;
+   Interpolator * pInt;
+   double start, sec, fit, legacy, add, repl, query, lquery, err, fmin, fmax, avg, sum;
+   int i, r, nb;
+
+   if(nu > m/2) nu = m/2;
+   if(nu < 1) nu = 1;
+   nb = m - nu;
+
+   pStore = new double[(size_t)(m + nu)*dim];
+   pPts = MakePoints(m + nu, dim, pStore);
+   pNew = &(pPts[m]);
+   pQStore = new double[(size_t)nq*dim];
+   pQ = MakePoints(nq, dim, pQStore);
+   pCoeffs = new double[m];
+
+   pInt = new Interpolator(m);
+
+   //full fit and batched queries
+   fit = query = legacy = lquery = NEARLY_HUGE;
+   for(r = 0; r < BENCH_REPS; r++)
+   {
+      start = GetElapsedTics();
+      pInt->SetBasis(pPts, m);
+      pInt->Interpolate(false);
+      sec = GetElapsedTics() - start;
+      if(sec < fit) fit = sec;
+
+      start = GetElapsedTics();
+      pInt->Evaluate(pQ, nq);
+      sec = GetElapsedTics() - start;
+      if(sec < query) query = sec;
+   }
+
+   //legacy fit and queries
+   if(m <= legacyMaxM)
+   {
+      avg = 0.00;
+      for(i = 0; i < m; i++) avg += pPts[i].F;
+      avg /= (double)m;
+      for(r = 0; r < BENCH_REPS; r++)
+      {
+         start = GetElapsedTics();
+         LegacyFit(pPts, m, pCoeffs);
+         sec = GetElapsedTics() - start;
+         if(sec < legacy) legacy = sec;
+
+         start = GetElapsedTics();
+         sum = 0.00;
+         for(i = 0; i < nq; i++) sum += LegacyEvaluate(pPts, m, pCoeffs, avg, &(pQ[i]));
+         sec = GetElapsedTics() - start;
+         if(sec < lquery) lquery = sec;
+         if(sum == 0.00) fprintf(stderr, " ");
+      }
+   }
+   else
+   {
+      legacy = lquery = -1.00;
+   }
+
+   //incremental: fit all but nu points, then add them
+   pInt->SetBasis(pPts, nb);
+   pInt->Interpolate(false);
+   start = GetElapsedTics();
+   for(i = nb; i < m; i++) pInt->AddBasis(&(pPts[i]));
+   add = (GetElapsedTics() - start)/(double)nu;
+
+   //replace nu of the points
+   start = GetElapsedTics();
+   for(i = 0; i < nu; i++) pInt->ReplaceBasis((i*7919) % m, &(pNew[i]));
+   repl = (GetElapsedTics() - start)/(double)nu;
+   for(i = 0; i < nu; i++)
+   {
+      pPts[(i*7919) % m].F = pNew[i].F;
+      memcpy(pPts[(i*7919) % m].v, pNew[i].v, dim*sizeof(double));
+   }
+
+   //accuracy at the known points
+   fmin = fmax = pPts[0].F;
+   for(i = 1; i < m; i++)
+   {
+      if(pPts[i].F < fmin) fmin = pPts[i].F;
+      if(pPts[i].F > fmax) fmax = pPts[i].F;
+   }
+   err = 0.00;
+   for(i = 0; i < m; i++)
+   {
+      sum = pPts[i].F;
+      pInt->Evaluate(&(pPts[i]));
+      if(fabs(pPts[i].F - sum) > err) err = fabs(pPts[i].F - sum);
+   }
+   err /= (fmax - fmin);
+
+   printf("%6d %6d %8d %12.6lf %12.6lf %12.6E %12.6E %12.6lf %12.6lf %12.6E %3d\n",
+          dim, m, nq, fit, legacy, add, repl, query, lquery, err, pInt->GetNumRefits());
+   fflush(stdout);
+
+   delete pInt;
+   delete [] pPts;
+   delete [] pStore;
+   delete [] pQ;
+   delete [] pQStore;
+   delete [] pCoeffs;
+}
+
+/******************************************************************************
+main()
+******************************************************************************/
+int main(int argc, char * argv[])
+{
+   int dim = 5;
+   int maxM = 4000;
+   int legacyMaxM = 2000;
+   int nq = 10000;
+   int nu = 50;
+   unsigned int seed = 12345;
+   int m;
+
+   if(argc > 1) dim = atoi(argv[1]);
+   if(argc > 2) maxM = atoi(argv[2]);
+   if(argc > 3) legacyMaxM = atoi(argv[3]);
+   if(argc > 4) nq = atoi(argv[4]);
+   if(argc > 5) nu = atoi(argv[5]);
+   if(argc > 6) seed = (unsigned int)atoi(argv[6]);
+   if((dim < 1) || (maxM < 2))
+   {
+      fprintf(stderr, "need at least one dimension and two points\n");
+      return 1;
+   }
+
+   ResetRandomSeed(seed);
+
+   printf("%6s %6s %8s %12s %12s %12s %12s %12s %12s %12s %3s\n",
+          "dim", "m", "queries", "fit_sec", "legacy_sec", "add_sec", "repl_sec",
+          "query_sec", "lquery_sec", "err", "fits");
+   for(m = 250; m <= maxM; m *= 2)
+   {
+      BenchSize(dim, m, legacyMaxM, nq, nu);
+   }
+   return 0;
+} /* end main() */
@@ -8,6 +8,8 @@ MPI code in environments that don't have MPI libraries.
 
 Version History
 10-24-13    lsm   added copyright information and initial comments.
+10-19-26    lsm   added MPI_Iprobe(), MPI_Isend() and MPI_Request_free().
+10-19-26    lsm   added MPI_Comm_dup() and MPI_Probe().
 ******************************************************************************/
 #include "mpi.h"
 #include <stdio.h>
@@ -552,6 +554,18 @@ int MPI_Comm_rank(MPI_Comm comm, int * rank)
    return MPI_SUCCESS;
 }/* end MPI_Comm_rank() */
 
+/********************************************************************
+MPI_Comm_dup()
+
+Duplicate a communicator. Messages are only exchanged via blocking
+point-to-point calls, so the duplicate is the same communicator.
+********************************************************************/
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm * newcomm)
+{
+   *newcomm = comm;
+   return MPI_SUCCESS;
+}/* end MPI_Comm_dup() */
+
 /********************************************************************
 MPI_Allgather()
 
@@ -1460,6 +1474,104 @@ int MPI_Send(void * buf, int count, MPI_Datatype datatype, int dest, int tag,
    return MPI_SUCCESS;
 }/* end MPI_Send() */
 
+/********************************************************************
+MPI_Iprobe()
+
+Non-blocking messages are not supported, never reports a message.
+********************************************************************/
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int * flag, 
+               MPI_Status * status)
+{
+   *flag = 0;
+   return MPI_SUCCESS;
+}/* end MPI_Iprobe() */
+
+/********************************************************************
+MPI_Probe()
+
+Wait for a message from a specific source, without receiving it.
+********************************************************************/
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status * status)
+{
+   unsigned int msgid;
+   int i, nTags;
+   int * tagList = NULL;
+   char RecvFileName[FMPI_MAX_FNAME_SIZE];
+   unsigned int howLong = 0;
+
+   if(source == MPI_ANY_SOURCE)
+   {
+      printf("MPI_Probe() : MPI_ANY_SOURCE is not supported\n");
+      MPI_Abort(comm, MPI_ERROR);
+   }
+
+   while(howLong < FMPI_BARRIER_TIMEOUT_MS)
+   {
+      FMPI_CheckForAbort();
+
+      msgid = FMPI_gMsgIds[source][FMPI_gMpiRank];
+      if(tag != MPI_ANY_TAG)
+      {
+         sprintf(RecvFileName, "runFileMPI.Send.%d.%d.%d.%d.%d", source, FMPI_gMpiRank, tag, comm, msgid);
+         if(FMPI_FileExists(RecvFileName) == 1)
+         {
+            status->MPI_SOURCE = source;
+            status->MPI_TAG = tag;
+            return MPI_SUCCESS;
+         }
+      }
+      else
+      {
+         nTags = FMPI_CountSendTags();
+         if(nTags > 0)
+         {
+            tagList = (int *)(malloc(nTags*sizeof(int)));
+            nTags = FMPI_GetSendTagList(tagList, nTags);
+            for(i = 0; i < nTags; i++)
+            {
+               sprintf(RecvFileName, "runFileMPI.Send.%d.%d.%d.%d.%d", source, FMPI_gMpiRank, tagList[i], comm, msgid);
+               if(FMPI_FileExists(RecvFileName) == 1)
+               {
+                  status->MPI_SOURCE = source;
+                  status->MPI_TAG = tagList[i];
+                  free(tagList);
+                  return MPI_SUCCESS;
+               }
+            }/* end for(each tag) */
+            free(tagList);
+         }/* end if(nTags > 0) */
+      }
+
+      FMPI_Sleep(FMPI_BARRIER_POLL_INTERVAL_MS);
+      howLong += FMPI_BARRIER_POLL_INTERVAL_MS;
+   }/* end while(waiting for message) */
+
+   printf("MPI_Probe() : Rank # %d timed out waiting for message!\n", FMPI_gMpiRank);
+   MPI_Abort(comm, MPI_ERROR);
+   return MPI_ERROR;
+}/* end MPI_Probe() */
+
+/********************************************************************
+MPI_Isend()
+
+Non-blocking messages are not supported, the message is dropped.
+********************************************************************/
+int MPI_Isend(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
+              MPI_Comm comm, MPI_Request * request)
+{
+   *request = 0;
+   return MPI_SUCCESS;
+}/* end MPI_Isend() */
+
+/********************************************************************
+MPI_Request_free()
+********************************************************************/
+int MPI_Request_free(MPI_Request * request)
+{
+   *request = 0;
+   return MPI_SUCCESS;
+}/* end MPI_Request_free() */
+
 /********************************************************************
 MPI_Finalize()
 
@@ -8,6 +8,10 @@ MPI code in environments that don't have MPI libraries.
 
 Version History
 10-24-13    lsm   added copyright information and initial comments.
+10-19-26    lsm   added MPI_Iprobe(), MPI_Isend() and MPI_Request_free(). Only
+                  blocking point-to-point messages are supported, so these
+                  never report or deliver a message.
+10-19-26    lsm   added MPI_Comm_dup() and MPI_Probe().
 ******************************************************************************/
 #ifndef MPI_INCLUDED
 #define MPI_INCLUDED
@@ -21,6 +25,7 @@ extern "C"
  typedef int MPI_Comm;
  typedef int MPI_Datatype;
  typedef int MPI_Op;
+ typedef int MPI_Request;
 
  typedef struct MPI_STATUS 
  {
@@ -48,6 +53,7 @@ extern "C"
 
  int MPI_Comm_size(MPI_Comm comm, int * size);
  int MPI_Comm_rank(MPI_Comm comm, int * rank);
+ int MPI_Comm_dup(MPI_Comm comm, MPI_Comm * newcomm);
 
  int MPI_Get_processor_name( char *name, int *resultlen );
 
@@ -92,6 +98,16 @@ int MPI_Recv(void * buf, int count, MPI_Datatype datatype, int source,
 int MPI_Send(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
 	          MPI_Comm comm);
 
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int * flag, 
+               MPI_Status * status);
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status * status);
+
+int MPI_Isend(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
+	           MPI_Comm comm, MPI_Request * request);
+
+int MPI_Request_free(MPI_Request * request);
+
 double MPI_Wtime(void);
 
 int MPI_Finalize(void);
@@ -9,6 +9,8 @@ the MPI libraries.
 Version History
 11-18-02    lsm   added copyright information and initial comments.
 08-20-03    lsm   created version history field and updated comments.
+10-19-26    lsm   added MPI_Iprobe(), MPI_Isend() and MPI_Request_free().
+10-19-26    lsm   added MPI_Comm_dup() and MPI_Probe().
 ******************************************************************************/
 #include "mpi.h"
 #include <stdlib.h>
@@ -35,6 +37,12 @@ int MPI_Comm_rank(MPI_Comm comm, int * rank)
    return 0;
 }
 
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm * newcomm)
+{
+   *newcomm = comm;
+   return 0;
+}
+
 int MPI_Allgatherv (void *sendbuf, int sendcount, MPI_Datatype sendtype, 
                      void *recvbuf, int *recvcounts, int *displs, 
                      MPI_Datatype recvtype, MPI_Comm comm )
@@ -91,6 +99,33 @@ int MPI_Send(void * buf, int count, MPI_Datatype datatype, int dest, int tag,
 	 return 0;
 }
 
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int * flag, 
+               MPI_Status * status)
+{
+	 *flag = 0;
+	 return 0;
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status * status)
+{
+	 status->MPI_SOURCE = source;
+	 status->MPI_TAG = tag;
+	 return 0;
+}
+
+int MPI_Isend(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
+              MPI_Comm comm, MPI_Request * request)
+{
+	 *request = 0;
+	 return 0;
+}
+
+int MPI_Request_free(MPI_Request * request)
+{
+	 *request = 0;
+	 return 0;
+}
+
 int MPI_Finalize(void)
 {
 	return 0;
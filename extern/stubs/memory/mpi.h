@@ -9,6 +9,8 @@ the MPI libraries.
 Version History
 11-18-02    lsm   added copyright information and initial comments.
 08-20-03    lsm   created version history field and updated comments.
+10-19-26    lsm   added MPI_Iprobe(), MPI_Isend() and MPI_Request_free().
+10-19-26    lsm   added MPI_Comm_dup() and MPI_Probe().
 ******************************************************************************/
 #ifndef USE_MPI_STUB
 #include <mpi.h>
@@ -25,6 +27,7 @@ extern "C"
  typedef int MPI_Comm;
  typedef int MPI_Datatype;
  typedef int MPI_Op;
+ typedef int MPI_Request;
 
  typedef struct MPI_STATUS 
  {
@@ -33,6 +36,8 @@ extern "C"
  }MPI_Status;
 
  #define MPI_SUM 0
+ #define MPI_MIN 0
+ #define MPI_MAX 0
  #define MPI_DOUBLE 0 
  #define MPI_INTEGER 0
  #define MPI_INT 0
@@ -46,6 +51,7 @@ extern "C"
 
  int MPI_Comm_size(MPI_Comm comm, int * size);
  int MPI_Comm_rank(MPI_Comm comm, int * rank);
+ int MPI_Comm_dup(MPI_Comm comm, MPI_Comm * newcomm);
 
  int MPI_Gatherv(void *sendbuf, int sendcnt, MPI_Datatype sendtype, 
                 void *recvbuf, int *recvcnts, int *displs, 
@@ -76,6 +82,16 @@ int MPI_Gather(void *sendbuf, int sendcnt, MPI_Datatype sendtype,
  int MPI_Send(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
 	           MPI_Comm comm);
 
+ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int * flag, 
+                MPI_Status * status);
+
+ int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status * status);
+
+ int MPI_Isend(void * buf, int count, MPI_Datatype datatype, int dest, int tag, 
+	            MPI_Comm comm, MPI_Request * request);
+
+ int MPI_Request_free(MPI_Request * request);
+
  int MPI_Finalize(void);
 #ifdef __cplusplus
 }
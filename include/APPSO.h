@@ -10,6 +10,7 @@ of the PDDS algorithm.
 
 Version History
 12-30-14    lsm   added copyright information and initial comments.
+10-19-26    lsm   Swarm is stored as contiguous matrices (SwarmKernel).
 ******************************************************************************/
 
 #ifndef APPSO_H
@@ -23,6 +24,7 @@ Version History
 //forward declarations
 class ModelABC;
 class StatsClass;
+class SwarmKernel;
 
 /******************************************************************************
 class APPSO
@@ -47,7 +49,7 @@ class APPSO : public AlgorithmABC
       void MakeParameterCorrections(double * x, double * xb, int n, double a);
 
       ModelABC * m_pModel;
-      ParticleStruct * m_pSwarm;
+      SwarmKernel * m_pSwarm;
       StatsClass * m_pStats;
       int m_SwarmSize;
       int m_MaxGens;
@@ -68,8 +70,6 @@ class APPSO : public AlgorithmABC
       double ** m_pInit;
 
       //metrics
-      int m_NumUprViols;
-      int m_NumLwrViols;
       double * m_Fmedian;
 }; /* end class ParticleSwarm */
 
@@ -0,0 +1,52 @@
+/******************************************************************************
+File     : BenchModels.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Synthetic internal models used by the benchmark suite (see bench/OstBench.cpp).
+They are registered with the internal model dispatch of the Model class when
+Ostrich is compiled with OSTRICH_BENCH defined (the BENCH make target):
+
+   Rosenbrock() : extended Rosenbrock function, also reports its residuals
+                  (R1, R2, ...) so that it can be used for regression
+   Griewank()   : Griewank function
+   ZDT()        : ZDT1, ZDT2 or ZDT3 bi-objective test problems
+   DTLZ()       : DTLZ1 or DTLZ2 scalable multi-objective test problems
+   Sleep()      : sphere function after a configurable delay, emulates the
+                  latency of an external model
+   BigOutput()  : sphere function, reported at the end of a large output file
+
+Each model reads BENCH_IN_FILE, which contains one "name value" pair per line.
+Names beginning with "Bench" are settings:
+   BenchVariant      <problem variant, default 1>
+   BenchNumObj       <number of objectives for DTLZ(), default 3>
+   BenchLatencyMs    <delay of Sleep(), default 10>
+   BenchOutputLines  <filler lines written by BigOutput(), default 100000>
+All other values are decision variables, in order of appearance. The objective
+values are written to BENCH_OUT_FILE as "F1 value", "F2 value", ...
+
+Version History
+10-19-26    lsm   Created
+******************************************************************************/
+#ifndef BENCH_MODELS_H
+#define BENCH_MODELS_H
+
+#define BENCH_IN_FILE   "BenchIn.txt"
+#define BENCH_OUT_FILE  "BenchOut.txt"
+
+//peak memory is sampled once per this many evaluations
+#define BENCH_MEM_SAMPLE (64)
+
+extern "C" {
+int RosenbrockModel(void);
+int GriewankModel(void);
+int ZDTModel(void);
+int DTLZModel(void);
+int SleepModel(void);
+int BigOutputModel(void);
+
+void BenchSampleMemory(void);
+void BenchWriteReport(double startup, double run);
+}
+
+#endif /* BENCH_MODELS_H */
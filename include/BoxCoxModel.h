@@ -7,8 +7,12 @@ Computes an objective function value for a given BoxCox transformation. The obj.
 function value measures the degree to which the transformation incurs normality
 on the transformed and weighted residuals.
 
+BoxCoxModel() is the file-based model (the "BoxCox()" model executable), while
+BoxCoxObjFunc() computes the same objective function in memory.
+
 Version History
 01-09-13    lsm   Created
+10-19-26    lsm   Added BoxCoxObjFunc()
 ******************************************************************************/
 #ifndef BOX_COX_MODEL_H
 #define BOX_COX_MODEL_H
@@ -16,8 +20,19 @@ Version History
 #define BOX_IN_FILE   "BoxCoxIn.txt"
 #define BOX_OUT_FILE  "BoxCoxOut.txt"
 
+/* measured and simulated values, weights and scratch residuals (all n x 1) */
+typedef struct BOX_COX_DATA_STRUCT
+{
+   double * x;
+   double * y;
+   double * w;
+   double * r;
+   int n;
+}BoxCoxDataStruct;
+
 extern "C" {
 int BoxCoxModel(void);
 }
+double BoxCoxObjFunc(double lambda, void * pData);
 
 #endif /* BOX_COX_MODEL_H */
@@ -0,0 +1,109 @@
+/******************************************************************************
+File     : Checkpoint.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+The Checkpoint class saves the complete state of an algorithm in a binary file
+(OstCheckpoint<rank>.bin), so that an interrupted run can be resumed exactly
+where the last checkpoint was taken. Unlike a warm start, which only recovers
+the best parameter set, a resumed run continues with the same population,
+random number sequence and model counter and produces the same results as an
+uninterrupted run.
+
+A checkpoint holds, in order:
+   - a header (magic string, format version, byte-order mark, algorithm name);
+   - the state of the random number generator (see GetRandomState());
+   - the length of each output file (OstOutput, OstModel and any files added
+     by the algorithm), which are truncated to that length on resume so that
+     records written after the checkpoint are not duplicated;
+   - the state of the model (see Model::WriteCheckpoint());
+   - the state of the algorithm, as a sequence of typed records;
+   - a checksum of all of the above.
+
+Checkpoints are written to a temporary file which then replaces the previous
+checkpoint, so an interruption while writing leaves the previous checkpoint
+intact. Settings, in the main section of the input file:
+
+   CheckpointEvals       <write a checkpoint every n model evaluations>
+   CheckpointMinutes     <write a checkpoint every n minutes>
+   ResumeFromCheckpoint  yes | no   (default no)
+
+Checkpoints are only supported in serial runs, and by the DDS, PSO, GA, BGA and
+SCEUA programs. Other settings are reported as errors (see CheckSettings()) 
+and ignored.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added CheckSettings()
+******************************************************************************/
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "MyHeaderInc.h"
+
+#include <string>
+#include <vector>
+
+//forward declarations
+class ModelABC;
+
+#define CKPT_VERSION (1)
+#define CKPT_MAGIC   "OSTCKPT"
+
+/******************************************************************************
+class Checkpoint
+******************************************************************************/
+class Checkpoint
+{
+   public:
+      Checkpoint(ModelABC * pModel, IroncladString pAlgName);
+      static void CheckSettings(ProgramType program);
+      ~Checkpoint(void){ DBG_PRINT("Checkpoint::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      void AddFile(IroncladString pName);
+      bool IsEnabled(void){ return m_bEnabled;}
+      bool IsDue(void);
+      bool Resume(void);
+      void Begin(void);
+      void End(void);
+      void WriteMetrics(FILE * pFile);
+
+      void WriteInt(int val){ WriteInts(&val, 1);}
+      void WriteDouble(double val){ WriteDoubles(&val, 1);}
+      void WriteInts(int * pVals, int n);
+      void WriteDoubles(double * pVals, int n);
+      int ReadInt(void){ int val; ReadInts(&val, 1); return val;}
+      double ReadDouble(void){ double val; ReadDoubles(&val, 1); return val;}
+      void ReadInts(int * pVals, int n);
+      void ReadDoubles(double * pVals, int n);
+
+   private:
+      static void ReadSettings(int * pEvals, double * pMinutes, bool * pResume);
+      void Put(const void * pData, size_t size);
+      void Get(void * pData, size_t size);
+      void PutRecord(char type, const void * pData, int n, size_t size);
+      void GetRecord(char type, void * pData, int n, size_t size);
+      unsigned int CalcChecksum(const char * pData, size_t size);
+      void Corrupt(IroncladString pWhat);
+
+      ModelABC * m_pModel;
+      std::string m_AlgName;
+      std::string m_FileName;
+      std::vector<std::string> m_Files;
+      std::vector<char> m_Buf; //contents of the checkpoint being written or read
+      size_t m_Pos;            //read position in m_Buf
+
+      bool m_bEnabled;
+      bool m_bResume;
+      int m_EvalInterval;
+      double m_MinInterval;
+      int m_LastCount;
+      double m_LastTime;
+
+      //metrics
+      int m_NumWritten;
+      double m_WriteTime;
+}; /* end class Checkpoint */
+
+#endif /* CHECKPOINT_H */
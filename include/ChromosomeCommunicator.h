@@ -15,6 +15,12 @@ Version History
 08-17-04    lsm   RAM fragmentation fixes
 03-21-05    lsm   Added support for user-defined seeding of initial population
 01-01-07    lsm   Algorithms now use an abstract model base class (ModelABC).
+10-19-26    lsm   Added access to the model's parameter initializer.
+10-19-26    lsm   Fitness evaluation and parameter corrections work on the 
+                  decoded genes of a chromosome, which the ChromosomePool 
+                  stores as a row of its genome matrix.
+10-19-26    lsm   Added access to the model's surrogate engine.
+10-19-26    lsm   Added WriteCheckpoint() and ReadCheckpoint().
 ******************************************************************************/
 #ifndef CHROMOSOME_COMMUNICATOR_H
 #define CHROMOSOME_COMMUNICATOR_H
@@ -26,6 +32,9 @@ class ModelABC;
 class Chromosome;
 class ParameterGroup;
 class ModelBackup;
+class ParamInitializerABC;
+class SurrogateEngine;
+class Checkpoint;
 
 /******************************************************************************
 class ChromosomeCommunicator
@@ -37,11 +46,16 @@ class ChromosomeCommunicator
    public:
       virtual ~ChromosomeCommunicator(void) { DBG_PRINT("ChromosomeCommunicator::DTOR"); }
       virtual void Destroy(void) = 0;
-      virtual void EvalFitness(Chromosome * pChromo)=0;
+      virtual double EvalFitness(double * pGenes)=0;
       virtual Chromosome * CreateProto(double rate)=0;
       virtual ParameterGroup * ConvertChromosome(Chromosome * pChromo) = 0;
       virtual ParameterGroup * GetParamGroupPtr(void) = 0;
-      virtual void MakeParameterCorrections(Chromosome * pChromo) = 0;
+      virtual ParamInitializerABC * GetParamInitializerPtr(void) = 0;
+      virtual SurrogateEngine * GetSurrogateEnginePtr(void) = 0;
+      virtual ParameterGroup * ConvertGenes(double * pGenes) = 0;
+      virtual void MakeParameterCorrections(double * pGenes) = 0;
+      virtual void WriteCheckpoint(Checkpoint * pCkpt) = 0;
+      virtual void ReadCheckpoint(Checkpoint * pCkpt) = 0;
 }; /* end class ChromosomeCommunicator */
 
 /******************************************************************************
@@ -61,16 +75,22 @@ class ModelChromoComm : public ChromosomeCommunicator
       void Destroy(void);
       ~ModelChromoComm(void){ DBG_PRINT("ModelChromoComm::DTOR"); Destroy(); }
       ModelChromoComm(ModelABC * pModel);
-      void EvalFitness(Chromosome * pChromo);
+      double EvalFitness(double * pGenes);
       Chromosome * CreateProto(double rate);
       ParameterGroup * ConvertChromosome(Chromosome * pChromo);
 	  ParameterGroup * GetParamGroupPtr(void);
+      ParamInitializerABC * GetParamInitializerPtr(void);
+      SurrogateEngine * GetSurrogateEnginePtr(void);
       void SetMaxEvals(int maxEvals){ m_MaxEvals = maxEvals;}
-      void MakeParameterCorrections(Chromosome * pChromo);
+      ParameterGroup * ConvertGenes(double * pGenes);
+      void MakeParameterCorrections(double * pGenes);
+      void WriteCheckpoint(Checkpoint * pCkpt);
+      void ReadCheckpoint(Checkpoint * pCkpt);
 
    private :
       ModelABC * m_pModel; 
       double * m_xb; //best parameter set
+      double m_BudgetFrac; //fraction of elapsed budget, for parameter corrections
       int m_MaxEvals;        
 }; /* end class ModelChromoComm */
 
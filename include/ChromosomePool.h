@@ -8,6 +8,23 @@ variables). The Genetic Algorithm uses ChromosomePools to store the population
 of solutions for a given generation along with the mating pool from which the 
 next generation of solutions will be produced.
 
+The population is stored as a flat population x gene matrix, one row per 
+chromosome: real-coded genes as doubles, binary-coded genes as bit strings 
+(one int per gene, as in BinaryEncodedGene). The GA operators work directly on
+the rows, and the next generation is built in a second matrix that is swapped
+with the current one. Chromosome objects are only used for the prototype 
+(which holds the bounds and rates of the genes) and to hand out the best
+chromosome of the pool.
+
+Real-coded crossover is either the fitness-weighted blend of the Gene classes
+(default) or simulated binary crossover:
+   CrossoverMethod  blend | sbx
+   SBXIndex         <distribution index of SBX, default 15>
+
+If the model has a surrogate engine (see SurrogateEngine.h), each real-coded
+offspring is the most promising of several candidate offspring, which are
+produced by repeating the crossover and mutation of its parent.
+
 Version History
 03-09-03    lsm   added copyright information and initial comments.
 08-20-03    lsm   created version history field and updated comments.
@@ -19,6 +36,10 @@ Version History
 01-01-07    lsm   Algorithms now use an abstract model base class (ModelABC).
 07-18-07    lsm   Added SuperMUSE support
 01-13-15    lsm   Added support for asynchrounous parallel
+10-19-26    lsm   Population is stored as a flat genome matrix, with double
+                  buffering instead of a scratch pool. Added SBX crossover.
+10-19-26    lsm   Added surrogate pre-screening of offspring.
+10-19-26    lsm   Added WriteCheckpoint() and ReadCheckpoint().
 ******************************************************************************/
 #ifndef CHROMOSOME_POOL_H
 #define CHROMOSOME_POOL_H
@@ -31,10 +52,14 @@ class Chromosome;
 class ModelABC;
 class QuadTree;
 class ParameterGroup;
+class Checkpoint;
 
 #define PARALLEL_TYPE_SYNCH  (0)
 #define PARALLEL_TYPE_ASYNCH (1)
 
+#define GA_XOVER_BLEND (0)
+#define GA_XOVER_SBX   (1)
+
 /******************************************************************************
 class ChromosomePool
 
@@ -58,32 +83,71 @@ class ChromosomePool
       void Initialize(int * budget);
       void CreateComm(ModelABC * pModel);      
       ParameterGroup * ConvertChromosome(Chromosome * pChromo);
+      ParameterGroup * ConvertChromosome(int i);
       int GetNumGens(void){return m_NumGenerations;}
       double GetStopVal(void){return m_StopVal;}
       void WriteMetrics(FILE * pFile);
       void SetChromosome(int i, double * vals);
+      void WriteCheckpoint(Checkpoint * pCkpt);
+      void ReadCheckpoint(Checkpoint * pCkpt);
 
    private:
       void TourneySelection(int nCombatants);
       void Crossover(void);
       void Mutate(void);
+      void MutateRow(int i, int * pCount);
+      bool ScreenOffspring(void);
       void CreatePrototype(void);
       void EvalFitParallel(void);
       void EvalFitSuperMUSE(void);
       void BcastPopulation(void);
       void FreezeGenes(int numFreeze);        
+      void AddInitializerSets(void);
       void EvalFitnessAsynch(int rank, int nprocs);
+      void AllocGenome(void);
+      void CrossoverReal(int i, double * pMate, double F2);
+      void CrossoverBinary(int i, int * pMate);
+      void CopyToNxtGen(int dst, int src);
+      void SwapGenerations(void);
+      int GetBestIdx(void);
+      double * GetGenes(int i);
+      void SetGenes(int i, double * pVals);
 
       QuadTree * m_pTrees;
       int m_TreeSize;
       /*--------------------------------------
-      Two pools, one for current generation 
-      and a scratch pool for creating the next 
-      generation
+      Two genome matrices (m_PoolSize x 
+      m_NumGenes), one for the current 
+      generation and one for creating the next 
+      generation. Only one of the real-coded 
+      and binary-coded matrices is used.
       ---------------------------------------*/
-      Chromosome **  m_pPool;
-      Chromosome **  m_pScratch;
+      double * m_pGenes;
+      double * m_pNxtGenes;
+      int * m_pCodes;
+      int * m_pNxtCodes;
+      double * m_pFitness;
+      double * m_pNxtFitness;
       int m_PoolSize;
+      int m_NumGenes;
+      bool m_bBinary;
+
+      //coding of each gene, taken from the prototype
+      double * m_pLwr;
+      double * m_pUpr;
+      int * m_pOffset;
+      int * m_pRange;
+      int * m_pNumBits;
+      double m_MutRate;
+      double m_XoverRate;
+      int m_XoverType;
+      double m_SbxIndex;
+
+      double * m_pRow;      //decoded genes of a chromosome
+      double * m_pCandGenes; //candidate offspring (surrogate pre-screening)
+      int * m_pCandMuts;     //mutations of each candidate offspring
+      int * m_pRank;        //chromosomes sorted by fitness (elitism)
+      Chromosome * m_pBest; //copy of the best chromosome
       int m_NumInit;
       double ** m_pInit;
 
@@ -10,6 +10,13 @@ and will be processed if ProgramType is set to 
 
 Version History
 11-15-15    lsm   created file
+10-19-26    lsm   searches can start from the parameter sets of the model's
+                  parameter initializer (e.g. 'ParamInitializer sobol').
+10-19-26    lsm   added asynchronous searches ('Asynchronous yes'): every
+                  evaluation of every search is a task in a shared work queue
+10-19-26    lsm   asynchronous searches have their own random number streams
+                  and step ahead of their pending results once every search
+                  has started.
 ******************************************************************************/
 #ifndef DDSAU_ALGORITHM_H
 #define DDSAU_ALGORITHM_H
@@ -23,6 +30,31 @@ Version History
 class StatsClass;
 class ModelABC;
 class ParameterABC;
+class DDSAlgorithm;
+
+/******************************************************************************
+struct DDSAU_Search
+
+State of a DDS search of the asynchronous mode. The first numInit evaluations
+sample the starting point and may be evaluated concurrently; each later one
+perturbs the best point found so far. A step waits for the previous result 
+until every search has started, then idle processors are given steps that 
+perturb the current best point while earlier steps are still being evaluated.
+Each search draws from its own random number stream, seeded as in the serial 
+mode (see GetRandomState()).
+******************************************************************************/
+typedef struct DDSAU_SEARCH_STRUCT
+{
+   int budget; //number of evaluations
+   int numInit; //number of initial samples
+   int numSent; //evaluations handed out
+   int numDone; //evaluations returned
+   double fbest; //best objective function value
+   double * pBest; //best parameter set
+   unsigned int seed; //state of the random number stream
+   unsigned long long calls;
+   unsigned int index;
+}DDSAU_Search;
 
 /******************************************************************************
 class DDSAU
@@ -44,12 +76,23 @@ class DDSAU : public AlgorithmABC
    private:
       void OptimizeSerial(void);
       void OptimizeParallel(void);
+      void OptimizeAsync(void);
+      void WorkAsync(void);
+      void StartSearch(int i);
+      bool NextTask(int i, DDSAlgorithm * pDDS, double * x, bool bAhead);
+      void ProcessResult(int i, double * x, double fx);
+      void FinishSearch(int i, FILE * pStdOut);
+      void SelectBehavioral(int i, const char * pFileName);
+      void UseStream(int i);
 
       ModelABC   *m_pModel;             //Pointer to model being optimized
 		StatsClass *m_pStats;             //Pointer to statistics
      
       char ** m_pBehavioral;
       double * m_fBehavioral;
+
+      double ** m_pInitSets; //starting points for the searches
+      int m_NumInitSets;
  
 		double m_r_val; //perturbation number 0<r<1
       int m_nsols; //number of searches
@@ -58,9 +101,12 @@ class DDSAU : public AlgorithmABC
 		int m_MaxIter; //maximum number of iterations per search
       int m_CurIter;
       bool m_bParallel; //true == perform searches in parallel
+      bool m_bAsync; //true == evaluations of all searches share the processors
       double m_fmax; //fitness threshold
       bool m_bRandomize; //true == randomize the behavioral solutions
       bool m_bReviseAU; // true -- revise previous search
+      DDSAU_Search * m_pSearches; //[m_nsols]; asynchronous mode only
+      int m_Stream; //search whose random number stream is in use, -1 if none
 
 		double PerturbParam(double * best_value, ParameterABC * pParam);  
       void MakeParameterCorrections(double * x, double * xb, int n, double a);
@@ -20,6 +20,10 @@ Ostrich updates required in following files:
 
 Version History
 03-01-06    jrc   created file
+10-19-26    lsm   added GenerateNeighbor(), for surrogate pre-screening
+10-19-26    lsm   added checkpoint/restart (see Checkpoint.h)
+10-19-26    lsm   GenerateNeighbor() and MakeParameterCorrections() are public,
+                  for the asynchronous searches of DDSAU
 ******************************************************************************/
 #ifndef DDS_ALGORITHM_H
 #define DDS_ALGORITHM_H
@@ -33,6 +37,7 @@ Version History
 class StatsClass;
 class ModelABC;
 class ParameterABC;
+class Checkpoint;
 
 /******************************************************************************
 class DDSAlgorithm
@@ -52,13 +57,17 @@ class DDSAlgorithm : public AlgorithmABC
       void SetPerturbationValue(double val) { m_r_val = val; }
       void ResetUserSeed(int seed);
       void SetNoUserInit(void){ m_UserSuppliedInit = false; }
+      void SetUserInit(double * pInit);
       void SetBudget(int budget){ m_MaxIter = budget; }
 
       int  GetCurrentIteration(void) { return m_CurIter; }
+      void MakeParameterCorrections(double * x, double * xb, int n, double a);
+      void GenerateNeighbor(double * x, double * xb, int n, double Pn);
 
    private:
       ModelABC   *m_pModel;             //Pointer to model being optimized
 		StatsClass *m_pStats;             //Pointer to statistics
+      Checkpoint *m_pCkpt;              //checkpoint/restart of the search
 
 		double m_r_val;							//perturbation number 0<r<1
 		int m_MaxIter;						//maximum number of iterations                                                                                            
@@ -68,7 +77,6 @@ class DDSAlgorithm : public AlgorithmABC
 																				//if false, random parameter set chosen		
 
 			double PerturbParam(const double &best_value, ParameterABC * pParam);  
-         void MakeParameterCorrections(double * x, double * xb, int n, double a);
 
 }; /* end class DDSAlgorithm */
 
@@ -36,6 +36,8 @@ Version History
                      ERR_INS_OBS  --> insensitive observation
                      ERR_CONTINUE --> the error message is a continutation of a previous msg
 07-13-07    lsm   Added SuperMUSE error code (ERR_SMUSE).
+10-19-26    lsm   MEM_CHECK() tests the pointer inline.
+10-19-26    lsm   Added IsQuitAll().
 ******************************************************************************/
 #ifndef MY_EXCEPTION_H
 #define MY_EXCEPTION_H
@@ -109,6 +111,7 @@ extern "C"
 {
    double TelescopicCorrection(double xmin, double xmax, double xbest, double a, double xnew);
    bool IsQuit(void);
+   bool IsQuitAll(void);
    void InitErrors(void);
    void ReportErrors(void);   
    ErrorCodeType GetErrorCode(void);
@@ -130,7 +133,7 @@ extern "C"
    IroncladString GetParameterName(int idx);
    IroncladString GetParameterValStr(int idx, double val);
    FilePair * GetFilePairs(void);
-   #define MEM_CHECK(a) MemCheck((void *)(a), __LINE__, __FILE__);
+   #define MEM_CHECK(a) MemCheckInline((void *)(a), __LINE__, __FILE__);
 
    void MemCheck(void * pMem, int line, const char * file);
    double RunModel(void);
@@ -143,6 +146,18 @@ extern "C"
 
    void SetTrialNumber(int trial_number);
    int GetTrialNumber(void);
+
+   void SetModelLogging(bool bLog);
+   bool GetModelLogging(void);
+}
+
+/* 
+MEM_CHECK() tests the pointer inline and only calls MemCheck() (which logs 
+the error and exits) if the allocation failed.
+*/
+inline void MemCheckInline(void * pMem, int line, const char * file)
+{
+   if(pMem == NULL) MemCheck(pMem, line, file);
 }
 
 #endif /* MY_EXCEPTION_H */
@@ -7,6 +7,7 @@ Generalized Likelihood Uncertainty Engine - GLUE
 
 Version History
 06-23-10    lsm   added copyright information and initial comments.
+10-19-26    lsm   added streaming mode
 ******************************************************************************/
 
 #ifndef GLUE_H
@@ -20,6 +21,14 @@ Version History
 //forward declarations
 class ModelABC;
 class ParameterABC;
+class QuasiRandom;
+
+/* layout of the per-variable running statistics used in streaming mode */
+#define GLUE_STAT_SUM   (0) /* sum of shifted values */
+#define GLUE_STAT_SUMSQ (1) /* sum of squared shifted values */
+#define GLUE_STAT_MIN   (2)
+#define GLUE_STAT_MAX   (3)
+#define GLUE_NUM_STATS  (4)
 
 /******************************************************************************
 class GLUE
@@ -42,6 +51,12 @@ class GLUE : public AlgorithmABC
       void EvaluateSamples(void);
       //void BcastSamples(void);
       void EvalSamplesParallel(void);
+      void OptimizeStreaming(void);
+      void InitStreamStats(void);
+      void AccumulateBehavioral(long long idx, double fx, Ironclad1DArray pX);
+      void MergeStreamStats(void);
+      void WriteStreamMetrics(FILE * pFile);
+      double GetHistogramQuantile(int prm, double q);
 
       ModelABC * m_pModel;
       SampleStruct * m_pSamples;
@@ -63,6 +78,24 @@ class GLUE : public AlgorithmABC
       double * m_pMyBuf;
       //double * m_pTmpBuf;
       double * m_pBigBuf;
+
+      //streaming mode
+      bool m_bStreaming;
+      int m_NumBins;
+      QuasiRandom * m_pQmc;
+      FILE * m_pBinFile;
+      long long m_BestIdx;
+      double m_BestF;
+      double m_NumEvaluated;
+      double m_NumStats; //number of behavioral samples in running statistics
+      double * m_pPrmShift;
+      double * m_pPrmStats; //GLUE_NUM_STATS entries per parameter
+      double * m_pPrmHist; //m_NumBins entries per parameter
+      double * m_pObsShift;
+      double * m_pObsStats; //GLUE_NUM_STATS entries per observation
+      double * m_pLwr;
+      double * m_pUpr;
+      int m_NumObs;
 }; /* end class GLUE */
 
 extern "C" {
@@ -16,6 +16,7 @@ Version History
 08-17-04    lsm   RAM fragmentation fixes, metrics collection and reporting
                   Added support for user-requested program termination
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC).
+10-19-26    lsm   Added checkpoint/restart (see Checkpoint.h).
 ******************************************************************************/
 
 #ifndef GENETIC_ALGORITHM_H
@@ -30,6 +31,7 @@ Version History
 class StatsClass;
 class ModelABC;
 class ChromosomePool;
+class Checkpoint;
 
 /******************************************************************************
 class GeneticAlgorithm
@@ -51,6 +53,7 @@ class GeneticAlgorithm : public AlgorithmABC
       ModelABC * m_pModel;
       ChromosomePool * m_pPopulation;
       StatsClass * m_pStats;
+      Checkpoint * m_pCkpt;
       double m_StopVal; //convergence criteria
       double m_CurStop; //current convergence val (compared against m_StopVal)
       int m_MaxGens;
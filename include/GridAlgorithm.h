@@ -10,11 +10,21 @@ Version History
 01-25-05    lsm   created
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC).
 017-18-07   lsm   Added SuperMUSE support
+10-19-26    lsm   Added a streaming engine ('Asynchronous yes'): points are
+                  generated by index and handed out through a work queue, and
+                  the median is a running estimate. It can also refine the
+                  grid around the best cells ('RefineLevels n').
 ******************************************************************************/
 #ifndef GRID_ALG_H
 #define GRID_ALG_H
 
+#include <queue>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "MyHeaderInc.h"
+#include "StatUtility.h"
 
 //parent class
 #include "AlgorithmABC.h"
@@ -23,6 +33,16 @@ Version History
 class StatsClass;
 class ModelABC;
 
+/* ----------------------------------------------------------------------------
+Points of a refined grid lie on a lattice that is 2^(refinement levels) times 
+finer than the coarse grid. A point is identified by its lattice coordinates, 
+in mixed radix (the last parameter varies fastest).
+---------------------------------------------------------------------------- */
+typedef unsigned long long GridKey;
+
+//objective function value and point of a cell (a max-heap keeps the best cells)
+typedef std::pair<double, GridKey> GridCell;
+
 /******************************************************************************
 class GridAlgorithm
 
@@ -47,6 +67,14 @@ class GridAlgorithm : public AlgorithmABC
       void EvalGridSuperMUSE(void);
       double GetGridVal(int i, int j);
 
+      //streaming engine
+      void OptimizeStream(void);
+      void WorkStream(void);
+      void StartLevel(void);
+      bool NextPoint(double * p, GridKey * pKey);
+      void ProcessResult(double * p, GridKey key, double f);
+      void ReportBatch(StatusStruct * pStatus);
+
       ModelABC * m_pModel;
       StatsClass * m_pStats;
       GridStruct * m_pMini;
@@ -61,6 +89,25 @@ class GridAlgorithm : public AlgorithmABC
       int m_MiniSize;      
       double * m_pBest;
 
+      //streaming engine (see OptimizeStream())
+      bool m_bAsync; //true == use the streaming engine
+      int m_NumLevels; //refinement levels
+      int m_NumCells; //best cells refined at each level
+      int m_Level; //current level, 0 is the coarse grid
+      long long m_Next; //next point of the current level
+      long long m_Stencil; //points around a refined cell, including itself (3^n)
+      int m_Scale; //lattice points per coarse grid step (2^m_NumLevels)
+      int * m_pLattice; //lattice points along each parameter
+      int * m_pCoord; //scratch lattice coordinates
+      double * m_pStart; //replaces the first grid point (warm start), or NULL
+      int m_NumEvals; //evaluations so far
+      int m_NumRefined; //evaluations of refinement levels
+      int m_NumBatch; //results waiting to be reported
+      QuantileStruct m_Median; //running median of the objective function
+      std::unordered_set<GridKey> m_Visited; //points evaluated or handed out
+      std::priority_queue<GridCell> m_Cells; //best cells so far
+      std::vector<GridKey> m_Centers; //cells refined at the current level
+
       //buffers used in MPI-parallel communication
       double * m_pBuf;
       double * m_pMyBuf;
@@ -3,17 +3,33 @@ File      : Interpolator.h
 Author    : L. Shawn Matott and James Craig
 Copyright : 2004, L. Shawn Matott and James Craig
 
-A class that uses radial basis function to interpolates the value at a given 
+A class that uses radial basis function to interpolates the value at a given
 point, based on known values at a finite set of points.
 
+The interpolator keeps its own copy of the known points, stored by dimension
+(one contiguous row of coordinates per dimension), so that the distances from
+a query point to all known points are computed in a few passes that the
+compiler can vectorize. It also keeps the inverse of the interpolation matrix:
+Interpolate() computes it from scratch, while AddBasis() and ReplaceBasis()
+update it (and the coefficients) in O(m^2) operations, by bordering and by a
+pair of Sherman-Morrison updates respectively. The inverse is recomputed from
+scratch once the number of updates reaches the number of points at the last
+full computation, or if an update is ill-conditioned.
+
 Version History
 05-25-04    lsm   created
+10-19-26    lsm   contiguous storage of known points, incremental updates
+                  (AddBasis() and ReplaceBasis()) and batched Evaluate()
 ******************************************************************************/
 #ifndef INTERPOLATOR_H
 #define INTERPOLATOR_H
 
 #include "MyHeaderInc.h"
 
+//batched Evaluate(): queries and known points processed at a time
+#define INTERP_QUERY_BLOCK (4)
+#define INTERP_BASIS_BLOCK (256)
+
 /******************************************************************************
 class Interpolator
 ******************************************************************************/
@@ -23,23 +39,47 @@ class Interpolator
       Interpolator(int nmax);
       ~Interpolator(void){ DBG_PRINT("Interpolator::DTOR"); Destroy(); }
       void SetBasis(MyPoint * vals, int n);
+      bool AddBasis(MyPoint * pt);
+      bool ReplaceBasis(int i, MyPoint * pt);
       double Evaluate(MyPoint * point);
+      void Evaluate(MyPoint * points, int n);
       double Interpolate(bool debug);
+      int GetOrder(void){ return m_Order;}
+      int GetNumRefits(void){ return m_NumRefits;}
       void Destroy(void);
 
-   private:      
-      MyPoint * m_pBasis; //known values
-      double ** m_A; //lhs matrix (A)
-      double ** m_Ainv; //inverse of A
-      double *  m_b; //rhs vector (b)
+   private:
+      void Allocate(int ndim);
+      void StorePoint(int i, MyPoint * pt);
+      void Distances(double * v, double * d2);
+      bool Invert(void);
+      void CalcCoeffs(void);
+
+      double * m_pX; //known points, by dimension (m_NumDims rows of m_LdX)
+      int m_LdX; //m_MaxOrder, rounded up to whole blocks of known points
+      double * m_pF; //known values
+      double * m_pAinv; //inverse of A (m_MaxOrder x m_MaxOrder, row-major)
+      int * m_pPiv; //pivots of the inversion
+      int m_NumDims; //dimension of the known points
       int m_Order; //number of known values and coeffs.
       int m_MaxOrder;//maximum number of known values used by the interpolator
       double * m_pCoeffs; //coefficients
       double * m_pRadius; //radii of MQ-RBF expansion
       double m_AvgVal; //average z value form list of known values
-}; /* end class Interpolator */
-
-#endif /* INTERPOLATOR_H */
+      bool m_bValid; //m_pAinv holds the inverse for the current points
 
+      //incremental updates since the last full inversion, and size at that time
+      int m_NumUpdates;
+      int m_RefitOrder;
+      int m_NumRefits;
 
+      //scratch
+      double * m_pD2;
+      double * m_pU;
+      double * m_pW;
+      double * m_pP;
+      double * m_pV;
+      double * m_pQ; //batch of queries
+}; /* end class Interpolator */
 
+#endif /* INTERPOLATOR_H */
@@ -35,6 +35,9 @@ software/hardware arising from the use of these codes.
 
 Version History
 12-28-17    lsm   added copyright information and initial comments.
+10-19-26    lsm   added asynchronous master-worker mode (Asynchronous yes|no).
+10-19-26    lsm   archive kept in a MOPSOCD_Archive, with incremental crowding
+                  distances and dominance checks on ordered indices.
 ******************************************************************************/
 
 #ifndef MOPSOCD_H
@@ -46,8 +49,9 @@ Version History
 #include <math.h>
 #include <time.h>
 #include "MOPSOCD_RandomLib.h" 
+#include "MOPSOCD_Archive.h"
 
-#define MOPSOCD_OPTIMIZATION_TYPE (0) /* optimization type, 0 for min, 1 for max */
+#define MOPSOCD_OPTIMIZATION_TYPE (0) /* optimization type, 0 for min, 1 for max (archive minimizes) */
 #define MOPSOCD_VERBOSE (0)           /* verbosity level 0,1 */
 #define MOPSOCD_PRINT_EVERY (10)      /* how frequently should output be generated */
 
@@ -83,23 +87,30 @@ private:
    void initialize_vel(void);
    void evaluate(void);
    void evaluate_parallel(int myrank, int nprocs);
+   void optimize_sync(int myrank, int nprocs, FILE * outfile, FILE * plotfile,
+                      clock_t startTime, StatusStruct * pStatus);
+   void optimize_async(int myrank, int nprocs, FILE * outfile, FILE * plotfile,
+                       clock_t startTime, StatusStruct * pStatus);
+   void work_async(void);
+   void process_result(int i, int numDone);
+   void report_progress(int g, double clocktime, FILE * outfile, FILE * plotfile, StatusStruct * pStatus);
    void broadcast_population(int myrank, int nprocs);
    void gather_results(int myrank, int nprocs);
    void store_pbests(void);
-   void insert_nondom(void);
-   void delete_particle(unsigned int k);
+   void store_pbest(int i);
    unsigned int check_constraints(double * consVar);
-   void crowding(void);
-   void qsortFitness(unsigned int f, unsigned int begin, unsigned int lastPart);
-   void qsortCrowd(unsigned int begin, unsigned int lastPart);
-   void compute_distance(unsigned int f);
    void mutate(unsigned int t);
    void get_ranges(double *minvalue, double *maxvalue);
    void maintain_particles(void);
+   void maintain_particle(int i);
+   void mutate_particle(int i, unsigned int t, double * minvalue, double * maxvalue);
    void compute_velocity(void);
+   void compute_velocity(int i);
    void update_archive(void);
+   void update_archive(int k);
    unsigned int check_nondom(unsigned int i);
    void update_pbests(void);
+   void update_pbest(int i);
    void save_results(char * archiveName);
 
    ModelABC * m_pModel;
@@ -115,16 +126,23 @@ private:
    int m_NumVar;      /* number of variables                   */ 
    double m_PI;
 
-   double ** m_ArchiveVar; /* [m_ArchiveSize][m_NumVar]; variable values of particles in the archive  */
-   double ** m_ArchiveFit; /* [m_ArchiveSize][m_NumFun]; fitness values of particles in the archive   */
+   MOPSOCD_Archive * m_pArchive; /* nondominated particles, ranked by crowding distance */
    double ** m_PopVar;     /* [m_PopSize][m_NumVar]; variable values of particles in the population   */
    double ** m_PopFit;     /* [m_PopSize][m_NumFun]; fitness values of particles in the population    */
    double ** m_PbestsVar;  /* [m_PopSize][m_NumVar]; personal bests of particles in the population    */
    double ** m_PbestsFit;  /* [m_popsize][m_NumFun]; personal bests of particles in the population    */
    double ** m_Velocity;   /* [m_popsize][m_NumVar]; velocity of particles in the population          */
-   double *  m_CrowdDist;  /* [m_ArchiveSize];		  crowding distance values of particles in archive */
    double m_ProbMut;       /* probability of mutation                          */
-   int m_NumNonDom;        /* number of non-dominated solutions in the archive */
+
+   /* asynchronous mode: each returned evaluation updates the archive and the
+      particle is moved and re-dispatched right away (no generation barrier) */
+   bool m_bAsync;
+   int * m_pQueue;   /* [m_PopSize]; particles waiting to be evaluated (ring buffer) */
+   bool * m_pEvaled; /* [m_PopSize]; particle has been evaluated at least once */
+   double * m_pAsyncF; /* [m_NumFun]; result of a worker */
+
+   double * m_pMinValue; /* [m_NumVar]; scratch, lower ranges of the archive */
+   double * m_pMaxValue; /* [m_NumVar]; scratch, upper ranges of the archive */
 }; /* end class MOPSOCD */
 
 extern "C" {
@@ -0,0 +1,142 @@
+/******************************************************************************
+File      : MOPSOCD_Archive.h
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Archive of non-dominated solutions for MOPSOCD, ranked by crowding distance.
+
+Members are stored in slots 0..GetSize()-1; removing a member moves the last
+one into its slot, so nothing is shifted. For each objective the archive keeps
+an ordered index of the members, which gives the neighbours of a member in
+O(log n). The crowding distance of a member is the sum, over objectives, of
+the distance between its two neighbours (or infinity at either end of an
+objective), and inserting or removing a member only updates the terms of its
+neighbours. A further ordered index ranks the members by crowding distance.
+
+With two objectives, members sorted by the first objective are sorted in
+reverse by the second, so both the member that could dominate a candidate and
+the run of members the candidate dominates are found by a binary search in the
+first ordered index. With more objectives, members are kept in a k-d tree
+whose nodes bound their members by a box (smallest and largest value of each
+objective); a dominance check only descends into the nodes whose box can hold
+a member that dominates (is dominated by) the candidate. New members go into a
+small buffer that is scanned linearly, and removed members are left as holes
+in the tree; the tree is rebuilt once the buffer exceeds about sqrt(n) members
+or the holes outnumber the members.
+
+A candidate is rejected if some member is at least as good in every objective;
+otherwise the members it is at least as good as are removed.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#ifndef MOPSOCD_ARCHIVE_H
+#define MOPSOCD_ARCHIVE_H
+
+#include <set>
+#include <vector>
+#include <utility>
+
+#include "MyHeaderInc.h"
+
+//a member of an ordered index: value (objective or crowding distance) and slot
+typedef std::pair<double, int> MOPSOCD_Key;
+
+/******************************************************************************
+struct MOPSOCD_CrowdOrder
+
+Largest crowding distance first, ties broken by slot.
+******************************************************************************/
+struct MOPSOCD_CrowdOrder
+{
+   bool operator()(const MOPSOCD_Key & a, const MOPSOCD_Key & b) const
+   {
+      if(a.first != b.first) return (a.first > b.first);
+      return (a.second < b.second);
+   }
+}; /* end struct MOPSOCD_CrowdOrder */
+
+typedef std::set<MOPSOCD_Key> MOPSOCD_ObjIndex;
+typedef std::set<MOPSOCD_Key, MOPSOCD_CrowdOrder> MOPSOCD_CrowdIndex;
+
+//maximum number of members in a leaf of the k-d tree
+#define MOPSOCD_KD_LEAF (16)
+
+/******************************************************************************
+struct MOPSOCD_KdNode
+
+A node of the k-d tree: range of positions in the tree order, children (-1 for
+a leaf), parent and number of members not yet removed.
+******************************************************************************/
+typedef struct MOPSOCD_KD_NODE_STRUCT
+{
+   int lo, hi;
+   int left, right, parent;
+   int live;
+}MOPSOCD_KdNode;
+
+/******************************************************************************
+class MOPSOCD_Archive
+
+Objectives are minimized.
+******************************************************************************/
+class MOPSOCD_Archive
+{
+   public:
+      MOPSOCD_Archive(int capacity, int numVar, int numFun);
+      ~MOPSOCD_Archive(void){ DBG_PRINT("MOPSOCD_Archive::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      bool IsDominated(double * F);
+      int RemoveDominated(double * F);
+      void Insert(double * X, double * F);
+      void Remove(int i);
+      int GetRanked(int r);
+
+      int GetSize(void){ return m_Size; }
+      int GetCapacity(void){ return m_Capacity; }
+      double * GetVar(int i){ return &(m_pVar[i*m_NumVar]); }
+      double * GetFit(int i){ return &(m_pFit[i*m_NumFun]); }
+      double GetCrowding(int i){ return m_pCrowd[i]; }
+
+   private:
+      bool Covers(double * Fa, double * Fb);
+      void UpdateTerm(int f, MOPSOCD_ObjIndex::iterator it);
+      void UpdateCrowding(int i);
+      void MoveSlot(int from, int to);
+
+      //k-d tree (more than two objectives)
+      void KdRebuild(void);
+      int KdBuild(int lo, int hi, int parent);
+      void KdRemove(int i);
+      bool KdIsDominated(double * F);
+      void KdDominated(double * F);
+
+      int m_Capacity; //maximum number of members
+      int m_NumVar;
+      int m_NumFun;
+      int m_Size; //number of members
+
+      double * m_pVar; //[m_Capacity*m_NumVar]; variable values of members
+      double * m_pFit; //[m_Capacity*m_NumFun]; objective values of members
+      double * m_pTerm; //[m_Capacity*m_NumFun]; crowding distance, by objective
+      double * m_pCrowd; //[m_Capacity]; crowding distance
+
+      MOPSOCD_ObjIndex * m_pOrder; //[m_NumFun]; members by objective value
+      MOPSOCD_CrowdIndex m_Crowd; //members by crowding distance
+
+      std::vector<MOPSOCD_KdNode> m_KdNode; //nodes, the root first
+      std::vector<double> m_KdBox; //box of each node (smallest, then largest values)
+      std::vector<int> m_KdSlot; //members in tree order, -1 once removed
+      std::vector<int> m_KdLeaf; //leaf of each position in tree order
+      std::vector<int> m_Recent; //members added since the tree was built
+      int * m_pKdPos; //[m_Capacity]; position of each member in tree order, or -1-(index in m_Recent)
+      int m_KdHoles; //removed members still in the tree
+
+      //scratch
+      std::vector<int> m_Touched; //members whose crowding distance changed
+      std::vector<int> m_Doomed; //members dominated by a candidate
+      std::vector<int> m_Stack; //nodes to visit
+}; /* end class MOPSOCD_Archive */
+
+#endif /* MOPSOCD_ARCHIVE_H */
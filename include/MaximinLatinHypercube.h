@@ -0,0 +1,58 @@
+/******************************************************************************
+File      : MaximinLatinHypercube.h
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Encapsulates a space-filling Latin hypercube design. A random Latin hypercube
+is improved by swapping the levels of two points in one dimension, which
+keeps the Latin property, and accepting swaps that increase the smallest
+inter-point distance (maximin criterion).
+
+Each trial swap involves the point that currently has the closest neighbor.
+Only distances to the two swapped points change, and each of those changes
+by a single coordinate term, so a trial costs O(n*d) and the nearest-neighbor
+table is updated incrementally instead of being rebuilt. Building the initial
+table costs O(n^2*d), so the optimizer is intended for designs of up to a few
+tens of thousands of points (e.g. initial populations).
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#ifndef MAXIMIN_LATIN_HYPERCUBE_H
+#define MAXIMIN_LATIN_HYPERCUBE_H
+
+#include "MyHeaderInc.h"
+
+/******************************************************************************
+class MaximinLatinHypercube
+******************************************************************************/
+class MaximinLatinHypercube
+{
+   public:
+      MaximinLatinHypercube(int dim, int num);
+      ~MaximinLatinHypercube(void){ DBG_PRINT("MaximinLatinHypercube::DTOR"); Destroy(); }
+      void Destroy(void);
+      void Generate(int maxIters);
+      void GetPoint(int idx, double * pUnit);
+      void GetScaledPoint(int idx, Ironclad1DArray pLwr, Ironclad1DArray pUpr, double * pX);
+      double GetMinDistance(void);
+      int GetNumAccepted(void){ return m_NumAccepted;}
+
+   private:
+      double Dist2(int a, int b);
+      void FindNearest(int a);
+      int FindCritical(void);
+      bool TrySwap(int a, int b, int k);
+
+      int * m_pLevels;  //num x dim matrix of levels, stored by point
+      double * m_pJitter; //num x dim matrix of offsets within each level
+      double * m_pNnDist; //squared distance to the nearest neighbor
+      int * m_pNnIdx;     //index of the nearest neighbor
+      double * m_pRowA;   //scratch: squared distances to trial point a
+      double * m_pRowB;   //scratch: squared distances to trial point b
+      int m_Dim;
+      int m_Num;
+      int m_NumAccepted;
+}; /* end class MaximinLatinHypercube */
+
+#endif /* MAXIMIN_LATIN_HYPERCUBE_H */
@@ -5,13 +5,22 @@ Copyright: 2013, L. Shawn Matott
 
 Track memory usage of sub-routines.
 
+GetNumAllocs() returns the number of heap allocations (calls to operator new)
+made by the calling thread so far. The profiler uses it to report the number
+of allocations per model evaluation (see Profiler.h). Counting replaces the
+global operator new and delete, so it is only compiled in if OSTRICH_COUNT_ALLOCS
+is defined (e.g. -DOSTRICH_COUNT_ALLOCS); otherwise GetNumAllocs() returns -1.
+
 Version History
 01-29-13    lsm   added copyright information and initial comments.
+10-19-26    lsm   added GetNumAllocs()
+10-19-26    lsm   allocations are only counted if OSTRICH_COUNT_ALLOCS is defined
 ******************************************************************************/
 #ifndef MEMORY_TRACKER_H
 #define MEMORY_TRACKER_H
 
 void LogMemUsage(char * file, const char * tag);
 double GetMemUsage(void);
+long long GetNumAllocs(void);
 
 #endif /* MEMORY_TRACKER_H */
\ No newline at end of file
@@ -20,6 +20,13 @@ Version History
 01-01-07    lsm   Added a ModelABC and created two Model sub-classes: a standard
                   Model class and the SurrogateModel class.
 07-16-07    lsm   Added support for the EPA SuperMUSE cluster
+10-19-26    lsm   Internal models are dispatched by RunInternalModel(), which is
+                  also used by the multi-objective Execute().
+10-19-26    lsm   Added ModelArchiver for built-in model output preservation.
+10-19-26    lsm   Added in-process SurrogateEngine, fed by complex model runs.
+10-19-26    lsm   Added WriteCheckpoint() and ReadCheckpoint()
+10-19-26    lsm   Model subdirectories are populated by WorkerProvisioner.
+10-19-26    lsm   CheckCache() reuses its line buffer.
 ******************************************************************************/
 #ifndef MODEL_H
 #define MODEL_H
@@ -37,15 +44,26 @@ class DecisionModule;
 class SuperMUSE;
 class FilePair;
 class FileList;
+class ModelArchiver;
+class WorkerProvisioner;
 class DatabaseABC;
 class SurrogateParameterGroup;
 class ParameterCorrection;
 class ParamInitializerABC;
+class SurrogateEngine;
 
 extern "C" {
    double ExtractBoxCoxValue(void);
 }
 
+//objective function categories passed to PreserveModel()
+extern IroncladString ObjFuncBest;
+extern IroncladString ObjFuncBehavioral;
+extern IroncladString ObjFuncNonBehavioral;
+extern IroncladString ObjFuncDominated;
+extern IroncladString ObjFuncNonDominated;
+extern IroncladString ObjFuncOther;
+
 /******************************************************************************
 class Model
 
@@ -62,6 +80,7 @@ class Model : public ModelABC
      ParameterGroup   *  GetParamGroupPtr(void);     
      ObjectiveFunction * GetObjFuncPtr(void);
      ParamInitializerABC * GetParamInitializerPtr(void);
+     SurrogateEngine * GetSurrogateEnginePtr(void) { return m_pSurrogate;}
      double GetObjFuncVal(void) { return m_CurObjFuncVal;}
      void SetObjFuncVal(double curVal) { m_CurObjFuncVal = curVal;}
      int GetCounter(void);
@@ -86,6 +105,8 @@ class Model : public ModelABC
      void SaveBest(int id);
      void PreserveModel(int rank, int trial, int counter, IroncladString ofcat);
      TelescopeType GetTelescopingStrategy(void){ return m_Telescope;}
+     void WriteCheckpoint(Checkpoint * pCkpt);
+     void ReadCheckpoint(Checkpoint * pCkpt);
    private:
       ObjFuncType         m_ObjFuncId;
       ObservationGroup  * m_pObsGroup;
@@ -94,18 +115,23 @@ class Model : public ModelABC
       DecisionModule    * m_pDecision;
       ParameterCorrection * m_pParameterCorrection;
       ParamInitializerABC * m_pParamInitializer;
+      SurrogateEngine * m_pSurrogate;
       TelescopeType m_Telescope; //telescoping bounds strategy
 
       DatabaseABC * m_DbaseList;
       FilePair * m_FileList;
       int m_Counter;
       int m_NumCacheHits;
+      char * m_pCacheLine; //line buffer of CheckCache()
+      int m_CacheLineSize;
       int m_Precision;
       StringType  m_ExecCmd;
       StringType  m_SaveCmd;
       StringType  m_PreserveCmd;
       char m_DirPrefix[DEF_STR_SZ];
       FileList *  m_pFileCleanupList;
+      ModelArchiver * m_pArchiver;
+      WorkerProvisioner * m_pProvisioner;
       bool m_InternalModel;
       bool m_bCheckGlobalSens;
       bool m_bUseSurrogates;
@@ -124,6 +150,7 @@ class Model : public ModelABC
       void AddFilePair(FilePair * pFilePair);
       void AddDatabase(DatabaseABC * pDbase);
       double DisklessExecute(void);
+      void RunInternalModel(void);
       IroncladString GetObjFuncCategory(double * pF, int nObj);
 
 protected: //can be called by DecisionModule
@@ -151,6 +178,7 @@ class SurrogateModel : public ModelABC
      ParameterGroup   *  GetParamGroupPtr(void) { return NULL;}
      ObjectiveFunction * GetObjFuncPtr(void);
      ParamInitializerABC * GetParamInitializerPtr(void) { return NULL;}
+     SurrogateEngine * GetSurrogateEnginePtr(void) { return NULL;}
      double GetObjFuncVal(void) { return m_CurObjFuncVal;}
      void SetObjFuncVal(double curVal) { m_CurObjFuncVal = curVal;}
      int                 GetCounter(void);
@@ -171,6 +199,8 @@ class SurrogateModel : public ModelABC
      void SaveBest(int id){ return;}
      TelescopeType GetTelescopingStrategy(void){ return TSCOPE_NONE;}
      void PerformParameterCorrections(void){ return;}
+     void WriteCheckpoint(Checkpoint * pCkpt){ return;}
+     void ReadCheckpoint(Checkpoint * pCkpt){ return;}
 
    private:
       ObjFuncType         m_ObjFuncId;
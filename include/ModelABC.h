@@ -7,6 +7,8 @@ Abstract Base Class for models
 
 Version History
 04-04-06    lsm   added copyright information and initial comments.
+10-19-26    lsm   added GetSurrogateEnginePtr()
+10-19-26    lsm   added WriteCheckpoint() and ReadCheckpoint()
 ******************************************************************************/
 #ifndef MODEL_ABC_H
 #define MODEL_ABC_H
@@ -18,6 +20,8 @@ class ObservationGroup;
 class ObjectiveFunction;
 class ParameterGroup;
 class ParamInitializerABC;
+class SurrogateEngine;
+class Checkpoint;
 
 /******************************************************************************
 class ModelABC
@@ -33,6 +37,7 @@ class ModelABC
       virtual ParameterGroup *  GetParamGroupPtr(void) = 0;
       virtual ObjectiveFunction * GetObjFuncPtr(void) = 0;
       virtual ParamInitializerABC * GetParamInitializerPtr(void) = 0;
+      virtual SurrogateEngine * GetSurrogateEnginePtr(void) = 0;
       virtual double GetObjFuncVal(void) = 0;
       virtual void SetObjFuncVal(double curVal) = 0;
       virtual int GetCounter(void) = 0;
@@ -49,6 +54,8 @@ class ModelABC
       virtual TelescopeType GetTelescopingStrategy(void) = 0;
       virtual void PerformParameterCorrections(void) = 0;
       virtual bool CheckWarmStart(void) = 0;
+      virtual void WriteCheckpoint(Checkpoint * pCkpt) = 0;
+      virtual void ReadCheckpoint(Checkpoint * pCkpt) = 0;
 }; /* end class ModelABC */
 
 #endif /* MODEL_ABC_H */
@@ -0,0 +1,145 @@
+/******************************************************************************
+File     : ModelArchiver.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+The ModelArchiver class implements the built-in model output preservation
+option ('PreserveModelOutput yes'). After each evaluation the worker directory
+is archived in archive/<prefix><rank>/run_<N>, excluding the files of the
+cleanup list (executables and extra input files).
+
+Instead of copying the whole worker directory synchronously, each evaluation
+only takes a snapshot of the files that changed since the previous run (by
+size, inode, and modification and status change times). A file modified 
+less than ARCHIVE_TICK_NS before its last snapshot is always considered 
+changed, since it may have been rewritten within the same timestamp tick 
+(the 'racy' case of git's index). The snapshot is a reflink (copy-on-write clone)
+where the filesystem supports it, and a plain copy otherwise. The snapshots
+are handed to a background thread through a bounded queue, which:
+   - hashes each file and stores it once as a content-addressed blob in
+     archive/blobs/, so that identical outputs of different runs (and of
+     different processors) are stored only once;
+   - optionally compresses new blobs with an external codec;
+   - hardlinks the blobs into the run directory, together with the blobs of
+     unchanged files, and writes a manifest (OstArchive.txt) of the run.
+
+Uncompressed blobs are compared byte-by-byte before a duplicate is discarded.
+Compressed blobs are matched by their 128-bit content hash and size alone.
+
+Optional settings, in the main section of the input file:
+   ArchiveQueueSize   <max. runs waiting to be archived, default 4>
+   ArchiveCompression none | gzip | zstd | lz4   (default none)
+   ArchiveKeep        all | best                 (default all)
+
+With 'ArchiveKeep best' only runs in the best, behavioral or non-dominated
+objective function category are archived in full, all other runs only get a
+manifest, without taking a snapshot.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#ifndef MODEL_ARCHIVER_H
+#define MODEL_ARCHIVER_H
+
+#include "MyHeaderInc.h"
+#ifdef GCC5X
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class FileList;
+
+#define ARCHIVE_DEF_QUEUE_SIZE (4)
+#define ARCHIVE_MANIFEST "OstArchive.txt"
+
+//coarsest timestamp granularity allowed for (nanoseconds)
+#define ARCHIVE_TICK_NS (1000000000LL)
+
+typedef enum ARCHIVE_CODEC_TYPE
+{
+   ARCHIVE_CODEC_NONE = 0,
+   ARCHIVE_CODEC_GZIP = 1,
+   ARCHIVE_CODEC_ZSTD = 2,
+   ARCHIVE_CODEC_LZ4  = 3
+}ArchiveCodecType;
+
+//a file of an archived run
+typedef struct ARCHIVE_FILE_STRUCT
+{
+   std::string rel;    //path relative to the worker directory
+   std::string staged; //snapshot waiting to be stored, if any
+   std::string blob;   //blob holding the contents, once stored
+   long long size;
+   long long inode;
+   long long mtime;    //nanoseconds
+   long long ctime;    //nanoseconds
+   long long taken;    //time of the snapshot (nanoseconds)
+}ArchiveFile;
+
+//an archived run
+typedef struct ARCHIVE_JOB_STRUCT
+{
+   fs::path runDir;
+   std::string category;
+   bool bFull;
+   std::vector<ArchiveFile> files;
+}ArchiveJob;
+
+/******************************************************************************
+class ModelArchiver
+******************************************************************************/
+class ModelArchiver
+{
+   public:
+      ModelArchiver(IroncladString pFileName, FileList * pExclude);
+      ~ModelArchiver(void){ DBG_PRINT("ModelArchiver::DTOR"); Destroy(); }
+      void Destroy(void);
+      void Archive(IroncladString pWorker, int counter, IroncladString ofcat);
+      void Flush(void);
+
+   private:
+      void Worker(void);
+      void Store(ArchiveJob * pJob);
+      void StoreBlob(ArchiveFile * pFile);
+      void WriteManifest(ArchiveJob * pJob);
+      void ReportError(void);
+      void SetError(std::string msg);
+      bool Compress(std::string & path);
+
+      fs::path m_Root;
+      fs::path m_Blobs;
+      fs::path m_Staging;
+      std::set<std::string> m_Exclude;
+      std::string m_Ext;
+      ArchiveCodecType m_Codec;
+      int m_QueueSize;
+      bool m_bKeepAll;
+      bool m_bStarted;
+      bool m_bDone;
+      int m_NumBusy;
+      long m_NumStaged;
+
+      //latest stored state of each file, for detecting unchanged files
+      std::map<std::string, ArchiveFile> m_Known;
+
+      std::deque<ArchiveJob *> m_Queue;
+      std::mutex m_Mutex;
+      std::condition_variable m_NotEmpty;
+      std::condition_variable m_NotFull;
+      std::thread m_Thread;
+      std::string m_Error;
+}; /* end class ModelArchiver */
+
+#endif /* MODEL_ARCHIVER_H */
@@ -11,11 +11,20 @@ move.  Additionally, the backup class is useful for finite difference
 computations, which must perterb model parameters without adversely affecting 
 the overall optimization process.
 
+A snapshot is held in a single contiguous buffer, laid out as:
+
+   [objective function | parameters | observations | predictions]
+
+Store() fills the buffer from the Model and SemiRestore() writes it back. The
+buffer can also be sent or received directly (see GetBuffer()), so that a
+trial point evaluated elsewhere can carry its results back as a snapshot.
+
 Version History
 03-09-03    lsm   added copyright information and initial comments.
 08-20-03    lsm   created version history field and updated comments.
 08-13-04    lsm   distinguished between semi and full restore functionality.
 01-01-07    lsm   ModelBackup now uses an abstract model base class (ModelABC).
+10-19-26    lsm   snapshots are stored in one contiguous buffer, added GetBuffer().
 ******************************************************************************/
 #ifndef MODEL_BACKUP_H
 #define MODEL_BACKUP_H
@@ -41,27 +50,31 @@ class ModelBackup
       void FullRestore(void);
       void SetResponseVarGroup(ResponseVarGroup * pRV);
 
+      double * GetBuffer(void){ return m_pVals;}
+      int GetBufferSize(void){ return m_Size;}
+      double GetObjFuncVal(void){ return m_pVals[0];}
+
       double GetParam(int i){ return m_pParams[i];} //parameters
       double GetObs(int i, bool bTransformed, bool bWeighted); //observations
       double GetPred(int i){ return m_pPred[i];} //predictions
 
    private:
-      void StoreParamVals(void);
-      void StoreObsVals(void);
-      void RestoreParamVals(void);
-      void RestoreObsVals(void);
+      void Allocate(void);
       void StorePredictedVals(void);
       void RestorePredictedVals(void);
 
       ModelABC * m_pModel;
+      ResponseVarGroup * m_pRV;
+
+      //snapshot buffer, and views of its parameter, observation and prediction parts
+      double * m_pVals;
+      int m_Size;
       double * m_pParams;
       int m_NumParams;
       double * m_pObs;
       int m_NumObs;
-      ResponseVarGroup * m_pRV;
       double * m_pPred;
       int m_NumPred;
-      double m_ObjFuncVal;
 }; /* end class ModelBackup */
 
 #endif /* MODEL_BACKUP_H */
@@ -5,15 +5,33 @@ Copyright: 2013, L. Shawn Matott
 
 Macros to aid in debugging.
 
+DBG_PRINT() is enabled if DBG_LEVEL >= 1 and NEW_PRINT() if DBG_LEVEL >= 2
+(e.g. -DDBG_LEVEL=2). Otherwise they are empty inline functions, which the
+compiler removes from the hot path.
+
 Version History
 01-29-2013  lsm   created
 10-16-2014  lsm   Replaced with function calls.
+10-19-2026  lsm   Disabled hooks are empty inline functions.
 ******************************************************************************/
 #ifndef MY_DEBUG_H
 #define MY_DEBUG_H
 
+#ifndef DBG_LEVEL
+#define DBG_LEVEL (0)
+#endif
+
+#if DBG_LEVEL >= 1
 void DBG_PRINT(const char *a);
+#else
+inline void DBG_PRINT(const char *a){ (void)a;}
+#endif
+
+#if DBG_LEVEL >= 2
 void NEW_PRINT(const char *a, int b);
+#else
+inline void NEW_PRINT(const char *a, int b){ (void)a; (void)b;}
+#endif
 
 #endif /* MY_DEBUG_H */
 
@@ -257,19 +257,6 @@ typedef struct ARCHIVE_STRUCT
    struct ARCHIVE_STRUCT * pNext;
 }ArchiveStruct;
 
-/* define a structure to encapsulate each particle. */
-typedef struct PSO_PARTICLE_STRUCT
-{
-	double * x; //current parameters
-	double * v; //'velocity' (upgrade vector)
-	double * b; //locally best parameters
-	double fx;  //objective function value
-	double * cx;  //constraint values
-	double fb;  //local best obj. func.
-	double * cb;  //local best constraints
-	int n;      //number of parameters
-}ParticleStruct;
-
 /* define enum and struct for meta-parameters */
 typedef enum PARAMETER_TYPE
 {
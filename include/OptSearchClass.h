@@ -6,11 +6,34 @@ Copyright: 2003, L. Shawn Matott
 The OptSearchClass is used to perform one-dimensional searches for the optimum
 step size of a given search direction.
 
+The search normally operates on the parameters of a Model. Alternatively, it
+can minimize a function of a single bounded variable (see the second CTOR and
+Minimize()), in which case it runs entirely in memory and reports no progress.
+
+The parallel search evaluates a batch of step sizes at a time, spread over the
+processors (or evaluated in turn by a single processor). A first batch spans
+[-1, +1]; batches are then placed beyond the best end point until a minimum is
+bracketed, and finally over a grid of the bracket (plus the vertex of the
+parabola through the best point and its neighbours), which is narrowed around
+the best point each round. While no step improves on the current point, the 
+batches instead close in on it geometrically from both sides. Settings, in the
+Begin1dSearch section:
+
+   1dSearchMethod     Parallel
+   1dSearchPoints     <points per batch, default: number of processors (min. 4)>
+   1dSearchMaxRounds  <max. refinement rounds, default 2>
+
+Algorithms that run several searches at once, one per processor, make the
+search local to the processor with SetLocal().
+
 Version History
 08-25-03    lsm   created file
 08-18-04    lsm   Added metrics collection and reporting, memory fragmentation
                   fixes, Golden Section search modifications
 01-01-07    lsm   OptSearchClass now uses abstract model base class (ModelABC).
+10-19-26    lsm   added minimization of a function of a single variable.
+10-19-26    lsm   added parallel search.
+10-19-26    lsm   added SetLocal().
 ******************************************************************************/
 #ifndef OPT_SEARCH_CLASS_H
 #define OPT_SEARCH_CLASS_H
@@ -34,6 +57,16 @@ typedef struct MIN_PT_STRUCT
 /* User can choose from these 1-D search methods */
 #define GSECT_SEARCH (0)
 #define BRENT_SEARCH (1)
+#define PARA_SEARCH  (2)
+
+/* parallel search: min. points per batch, max. number of bracketing (and of 
+extra refinement) rounds, contraction towards the current point */
+#define PARA_MIN_POINTS  (4)
+#define PARA_MAX_BRACKET (10)
+#define PARA_SHRINK      (0.25)
+
+/* function of a single variable, minimized by OptSearchClass::Minimize() */
+typedef double (*OptSearchFunc)(double x, void * pData);
 
 /******************************************************************************
 class OptSearchClass
@@ -43,21 +76,38 @@ class OptSearchClass
 {      
    public:     
       OptSearchClass(ModelABC * pModel);
+      OptSearchClass(OptSearchFunc pFunc, void * pData, double lwr, double upr,
+                     int searchType, double convVal);
       ~OptSearchClass(void){ DBG_PRINT("OptSearchClass::DTOR"); Destroy(); }
       void Destroy(void);
       double CalcStepSize(Unchangeable1DArray pDir, double * fmin, double * xmin);
+      double Minimize(double x0, double * fx, double convVal, int maxIter);
+      void SetLocal(bool bLocal){ m_bLocal = bLocal;}
       void WriteMetrics(FILE * pFile);
 
    private:
       MinPtStruct * GoldSect(MinBracketStruct * pBrack, double * minf, double * minp);
       MinPtStruct * Brent(MinBracketStruct * pBrack, double * minf, double * minp);
+      MinPtStruct * ParaSearch(double * minf, double * minp);
+      void EvalBatch(int num, double * minf, double * minp);
+      void AlphaPoint(double alpha);
       MinBracketStruct * BracketMinimum(double a, double b, double * fmin, double * xmin);
       double CalcF(double alpha,double * fmin, double * xmin);
       void InitFromFile(IroncladString pFileName);
       double LimitStepSize(double alpha, double * pDir);
+      void Allocate(void);
+      void WriteProgress(int count, int max);
 
       ModelABC * m_pModel;
 
+      //function of a single variable (used if there is no model), its bounds and current point
+      OptSearchFunc m_pFunc;
+      void * m_pFuncData;
+      double m_Lwr;
+      double m_Upr;
+      double m_X;
+      double m_Fx;
+
       //frequently used data structs
       double           * m_pStepPoint; //CalcStepSize() point
       double           * m_pAlphaPoint; //CalcF() points
@@ -74,10 +124,24 @@ class OptSearchClass
       //type of 1-D search
       int m_SearchType;
 
+      //parallel search: batch size, max. refinement rounds, batch and evaluated points
+      int m_NumPts;
+      int m_MaxRounds;
+      double * m_pBatchX;
+      double * m_pBatchF;
+      double * m_pBatchBuf;
+      double * m_pPtsX;
+      double * m_pPtsF;
+      int m_MaxPts;
+      int m_NumEvalPts;
+      bool m_bLocal; //search is run by this processor alone
+
       //metrics
       int m_BoundMinCount;
       int m_GoldSectCount;
       int m_BrentCount;
+      int m_ParaCount;
+      int m_ParaRounds;
 }; /* end class OptSearchClass */
 
 #endif /* OPT_SEARCH_CLASS_H */
@@ -9,6 +9,7 @@ implementation of Mohammadamin Jahanpour (mjahanpo@uwaterloo.ca).
 
 Version History
 05-07-15    lsm   created file
+10-19-26    lsm   added scratch buffers of HV()
 ******************************************************************************/
 #ifndef PADDS_ALGORITHM_H
 #define PADDS_ALGORITHM_H
@@ -89,6 +90,12 @@ class PADDS : public AlgorithmABC
       int m_dimension;
       double m_dSqrtDataNumber;
       double m_volume;    
+
+      //scratch buffers of HV()
+      double ** m_pHVPoints;
+      int m_HVSize;
+      double * m_pHVRegion;
+      int m_HVRegionSize;
 }; /* end class PADDS */
 
 extern "C" {
@@ -8,6 +8,7 @@ PAES - Pareto archived evolution strategy
 
 Version History
 12-29-17    lsm   created file
+10-19-26    lsm   archive is a PAES_Archive (indexed, with a hashed adaptive grid)
 ******************************************************************************/
 #ifndef PAES_ALGORITHM_H
 #define PAES_ALGORITHM_H
@@ -51,10 +52,7 @@ class PAES : public AlgorithmABC
 
       PAES_Individual * m_currentSolution;
       PAES_Individual * m_mutantSolution;
-      PAES_Population * m_archiveOfSolutions;
-  
-      PAES_AdaptiveGrid * m_adaptiveGrid;
-      int m_numberOfGridDivisions;
+      PAES_Archive * m_archiveOfSolutions;
 
       int m_printFrequency;
 
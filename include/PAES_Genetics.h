@@ -8,13 +8,21 @@ PAES - Pareto archived evolution strategy
 
 Version History
 12-29-17    lsm   created file
+10-19-26    lsm   hashed adaptive grid and indexed archive (PAES_Archive)
 ******************************************************************************/
 #ifndef PAES_GENETICS_H
 #define PAES_GENETICS_H
 
+#include <vector>
+#include <set>
+#include <unordered_map>
+
 #include "PAES_Helpers.h"
 #include "PAES_ObjFunc.h"
 
+//location (hypercube) of an individual in the adaptive grid
+typedef unsigned long long PAES_GridKey;
+
 /******************************************************************************
 class PAES_Gene
  
@@ -188,7 +196,9 @@ class PAES_Individual
       double * m_fitness; // Array of fitness values
       FILE * m_cout;
   
-      int m_gridLocation; // Necessary if an adaptive grid is used
+      PAES_GridKey m_gridLocation; // Necessary if an adaptive grid is used
+      int m_gridSlot; // Position in the member list of its hypercube
+      int m_archiveSlot; // Position in the archive
   
       // Constructors
       PAES_Individual(PAES_MultiobjectiveProblem * problem, PAES_Random * random, FILE * pFile);
@@ -261,40 +271,130 @@ class PAES_Population
       void printGenotype(char * fileName);
 }; /* end class PAES_Population */
 
+/******************************************************************************
+struct PAES_GridCell
+
+An occupied hypercube of the adaptive grid.
+******************************************************************************/
+struct PAES_GridCell
+{
+   PAES_GridKey m_location;
+   int m_slot; // Position in the list of hypercubes with as many members
+   std::vector<int> m_division; // Division of each objective
+   std::vector<PAES_Individual *> m_members;
+}; /* end struct PAES_GridCell */
+
 /******************************************************************************
 class PAES_AdaptiveGrid
+
+Each objective range is bisected depth times, and only the occupied hypercubes
+are stored, hashed by location. Each hypercube lists its members, and the
+hypercubes are also listed by number of members so that the most crowded one
+is known at all times. Comparing divisions also rules out whole hypercubes
+from dominance tests (see findComparable()). Members are added and removed 
+one at a time; the grid limits are recomputed (and every member relocated) 
+only when an individual falls outside of them.
 ******************************************************************************/
 class PAES_AdaptiveGrid 
 {
    public:
-      int    * m_hypercube; // Hypercube division for keeping diversity
-      double * m_divisionSize; // Division sizes of the adaptive grid
-      double * m_gridLimits; // Limits of the adaptive grid
-      long     m_currentGridSize; // Current size of the adaptive grid
-      int      m_mostCrowdedHypercube;
-
       int m_numberOfFunctions; // 
       int m_depth; // 
+      int m_numberOfDivisions; // Divisions of each objective (2^depth)
     
-      double * m_upperBestFitness;
+      double * m_upperBestFitness; // Limits of the adaptive grid
       double * m_lowerBestFitness;
+      double * m_divisionSize; // Division sizes of the adaptive grid
   
       // Constructor
-      PAES_AdaptiveGrid(void);
       PAES_AdaptiveGrid(int depth, int numberOfFunctions);
   
       // Destructor
       ~PAES_AdaptiveGrid(void);
   
       // Methods
-      void updateGridLocations(PAES_Population * population, PAES_Individual * individual);
-      int  findLocation(PAES_Individual * individual);
+      bool contains(PAES_Individual * individual) const;
+      void rebound(PAES_Population * population, PAES_Individual * individual);
+      PAES_GridKey findLocation(PAES_Individual * individual) const;
+      void findComparable(PAES_Individual * individual, std::vector<PAES_Individual *> * pBetter,
+                          std::vector<PAES_Individual *> * pWorse);
+      void addMember(PAES_Individual * individual);
+      void removeMember(PAES_Individual * individual);
+      int  getCount(PAES_GridKey location) const;
+      int  getMostCrowdedCount(void) const { return m_mostCrowdedCount; }
+      PAES_Individual * getMostCrowdedMember(void) const;
+      int  getNumberOfRebounds(void) const { return m_numberOfRebounds; }
   
    private:
-      // These variables are used in findLocation(). They are defined here for 
-      // efficiency purposes
-      int    * m_increment;
-      double * m_tmpDivisionSize;
+      int  findDivision(double fitness, int i) const;
+      void clear(void);
+      void moveCell(PAES_GridCell * cell, int count);
+
+      int * m_division; // Divisions of the individual in findComparable()
+
+      bool m_bounded; // Limits have been set
+      bool m_exactLocation; // Location holds the division of every objective
+
+      std::unordered_map<PAES_GridKey, PAES_GridCell *> m_hypercube; // Occupied hypercubes
+      std::vector< std::vector<PAES_GridCell *> > m_crowding; // Hypercubes, by number of members
+      int m_mostCrowdedCount;
+      int m_numberOfRebounds;
 }; /* end class PAES_AdaptiveGrid */
 
+/******************************************************************************
+struct PAES_FirstObjectiveOrder
+
+Orders the archive by first objective, the pointers break ties. Also compares
+against a plain value of the first objective, for searches.
+******************************************************************************/
+struct PAES_FirstObjectiveOrder
+{
+   typedef void is_transparent;
+   bool operator()(const PAES_Individual * a, const PAES_Individual * b) const;
+   bool operator()(const PAES_Individual * a, double b) const;
+   bool operator()(double a, const PAES_Individual * b) const;
+}; /* end struct PAES_FirstObjectiveOrder */
+
+/******************************************************************************
+class PAES_Archive
+
+Bounded archive of non-dominated solutions, with an adaptive grid for crowding.
+
+Dominance tests are prefiltered. With two objectives the members are kept 
+ordered by first objective, and so by decreasing second objective: a single 
+member decides whether a solution is dominated, and the members it dominates 
+are contiguous. With more objectives every occupied hypercube is visited, but 
+only the members of those that are comparable to the hypercube of the 
+solution are tested. Members are removed by moving the last member into 
+their slot.
+******************************************************************************/
+class PAES_Archive : public PAES_Population
+{
+   public:
+      // Constructor
+      PAES_Archive(int maximumArchiveLength, int depth, PAES_Random * random,
+                   PAES_MultiobjectiveProblem * problem, FILE * pFile);
+
+      // Destructor
+      ~PAES_Archive(void);
+
+      // Methods
+      int  compareToArchive(PAES_Individual * solution);
+      bool archiveSolution(PAES_Individual * solution);
+      int  getCrowding(PAES_Individual * individual) const;
+      int  getNumberOfRebounds(void) const { return m_adaptiveGrid->getNumberOfRebounds(); }
+
+   private:
+      void findComparable(PAES_Individual * solution);
+      bool isDominated(PAES_Individual * solution, bool identical);
+      void insert(PAES_Individual * solution);
+      void remove(PAES_Individual * member);
+
+      PAES_AdaptiveGrid * m_adaptiveGrid;
+      bool m_bOrdered; // Members are ordered (two objectives)
+      std::set<PAES_Individual *, PAES_FirstObjectiveOrder> m_ordered;
+      std::vector<PAES_Individual *> m_better; // Members that may dominate the solution
+      std::vector<PAES_Individual *> m_worse; // Members the solution may dominate
+}; /* end class PAES_Archive */
+
 #endif /* PAES_GENETICS_H */
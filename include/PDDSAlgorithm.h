@@ -8,6 +8,7 @@ ported from an earlier fortran implementation.
 
 Version History
 12-23-14    lsm   created file
+10-19-26    lsm   candidates can be evaluated asynchronously on SuperMUSE
 ******************************************************************************/
 #ifndef PDDS_ALGORITHM_H
 #define PDDS_ALGORITHM_H
@@ -39,6 +40,7 @@ class PDDSAlgorithm : public AlgorithmABC
       void SetPerturbationValue(double val) { m_r_val = val; }
       void ResetUserSeed(int seed);
       void SetNoUserInit(void){ m_UserSuppliedInit = false; }
+      void SetUserInit(double * pInit);
       void SetBudget(int budget){ m_MaxIter = budget; }
 
       int  GetCurrentIteration(void) { return m_CurIter; }
@@ -51,6 +53,7 @@ class PDDSAlgorithm : public AlgorithmABC
       double obj_func(int nopt, double * x_values);
       int max_int(int a, int b);
       void MakeParameterCorrections(double * x, double * xb, int n, double a);
+      int RecvSuperMUSE(double ** pX, int * pTask, int nslaves);
 
       ModelABC   *m_pModel; //Pointer to model being optimized
       StatsClass *m_pStats; //Pointer to statistics
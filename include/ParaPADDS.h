@@ -9,6 +9,7 @@ implementation of Mohammadamin Jahanpour (mjahanpo@uwaterloo.ca).
 
 Version History
 05-08-15    lsm   created file
+10-19-26    lsm   added scratch buffers of HV()
 ******************************************************************************/
 #ifndef PARA_PADDS_ALGORITHM_H
 #define PARA_PADDS_ALGORITHM_H
@@ -92,6 +93,12 @@ class ParaPADDS : public AlgorithmABC
       int m_dimension;
       double m_dSqrtDataNumber;
       double m_volume;    
+
+      //scratch buffers of HV()
+      double ** m_pHVPoints;
+      int m_HVSize;
+      double * m_pHVRegion;
+      int m_HVRegionSize;
 }; /* end class ParaPADDS */
 
 extern "C" {
@@ -8,6 +8,8 @@ initial parameter values.
 
 Version History
 02-27-2022   lsm   added copyright information and initial comments.
+10-19-2026   lsm   added QuasiRandomParamInitializer
+10-19-2026   lsm   removed the unused type argument of Write()
 ******************************************************************************/
 #ifndef PARAM_INITIALIZER_ABC_H
 #define PARAM_INITIALIZER_ABC_H
@@ -17,6 +19,8 @@ Version History
 //forward decs
 class ParameterGroup;
 class ParameterABC;
+class QuasiRandom;
+class MaximinLatinHypercube;
 
 #define PMAP_EXPLICIT (0)
 #define PMAP_IMPLICIT (1)
@@ -30,7 +34,7 @@ class ParamInitializerABC
     	virtual ~ParamInitializerABC(void){ DBG_PRINT("ParamInitializerABC::DTOR"); }
 		virtual void Destroy(void)=0;
 		virtual void GetParameterSets(double ** pVals, int start)=0;
-		virtual void Write(FILE * pFile, int type)=0; 
+		virtual void Write(FILE * pFile)=0; 
 		virtual int GetNumParameterSets(void)=0;
 }; /* end class ParamInitializerABC */
 
@@ -48,7 +52,7 @@ class HamedParamInitializer : public ParamInitializerABC
 	HamedParamInitializer(ParameterGroup * pParamGroup, FILE * pInFile);
 	void GetParameterSets(double ** pVals, int start);
 	int GetNumParameterSets(void){ return m_NumSets; }
-	void Write(FILE * pFile, int type);
+	void Write(FILE * pFile);
 
 private:
     void GetSample(double * stest,  int sindex);
@@ -102,7 +106,7 @@ class KMeansParamInitializer : public ParamInitializerABC
 	void Destroy(void);
 	KMeansParamInitializer(ParameterGroup * pParamGroup, FILE * pInFIle);
 	void GetParameterSets(double ** pVals, int start);
-	void Write(FILE * pFile, int type);
+	void Write(FILE * pFile);
 	int GetNumParameterSets(void){ return m_NumSets; }
 
 private:
@@ -137,6 +141,35 @@ private:
 	FILE * m_pLog;
 }; /* end class KMeansParamInitializer */
 
+/******************************************************************************
+class QuasiRandomParamInitializer
+
+Initialize sets of parameter values using a space-filling design: a scrambled
+Sobol or Halton sequence, or a maximin Latin hypercube. The design is built
+once, in the unit hypercube, and shared by all processors.
+******************************************************************************/
+class QuasiRandomParamInitializer : public ParamInitializerABC
+{
+    public:
+	~QuasiRandomParamInitializer(void){ DBG_PRINT("QuasiRandomParamInitializer::DTOR"); Destroy(); }
+	void Destroy(void);
+	QuasiRandomParamInitializer(ParameterGroup * pParamGroup, FILE * pInFile, IroncladString pType);
+	void GetParameterSets(double ** pVals, int start);
+	int GetNumParameterSets(void){ return m_NumSets; }
+	void Write(FILE * pFile);
+
+private:
+	ParameterGroup * m_pParams;
+	double * m_pDesign; /* m_NumSets x m_NumParams, unit hypercube */
+	char m_Type[DEF_STR_SZ];
+	bool m_bScramble;
+	int m_MaximinIters;
+	int m_NumSets;
+	int m_NumParams;
+	double m_MinDist;
+	double m_Time;
+}; /* end class QuasiRandomParamInitializer */
+
 #endif /* PARAM_INITIALIZER_ABC_H */
 
 
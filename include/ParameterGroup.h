@@ -17,6 +17,7 @@ Version History
 01-01-07    lsm   Added ExcludeParam() subroutine to support the "hold" 
                   parameters functionality.
 07-18-07    lsm   Added support for SuperMUSE
+10-19-26    lsm   SubIntoFile() reuses a scratch buffer for geometry parameters
 ******************************************************************************/
 
 #ifndef PARAMETER_GROUP_H
@@ -86,6 +87,8 @@ class ParameterGroup
       char ** m_ParamNameList; //list of parameter names
       int m_NumTied;
       int m_NumGeom;
+      char * m_pGeomStr; //scratch buffer of SubIntoFile()
+      int m_GeomStrSize;
 	  int m_NumSpecial;
       int m_NumExcl;
       void InitFromFile(IroncladString pParamFileName);
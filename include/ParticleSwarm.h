@@ -20,6 +20,8 @@ Version History
 12-02-04    lsm   Added support for the seeding of particle swarm
 04-14-05    lsm   Added support for linearly reducing the inertia weight to zero.
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC).
+10-19-26    lsm   Swarm is stored as contiguous matrices (SwarmKernel).
+10-19-26    lsm   Added checkpoint/restart (see Checkpoint.h).
 ******************************************************************************/
 
 #ifndef PARTICLE_SWARM_H
@@ -32,6 +34,8 @@ Version History
 class ModelABC;
 class StatsClass;
 class QuadTree;
+class SwarmKernel;
+class Checkpoint;
 
 /******************************************************************************
 class ParticleSwarm
@@ -59,8 +63,9 @@ class ParticleSwarm : public AlgorithmABC
      void MakeParameterCorrections(double * x, double * xb, int n, double a);
 
       ModelABC * m_pModel;
-      ParticleStruct * m_pSwarm;
+      SwarmKernel * m_pSwarm;
       StatsClass * m_pStats;
+      Checkpoint * m_pCkpt;
       QuadTree * m_pTrees;
       int m_TreeSize;
       int m_SwarmSize;
@@ -77,9 +82,9 @@ class ParticleSwarm : public AlgorithmABC
       int m_CurGen;
       double m_StopVal;  //convergence criteria
       double m_CurStop; //current convergence val (compared against m_StopVal)
+      double m_BudgetFrac; //fraction of elapsed budget, for parameter corrections
 
       //buffers used in MPI-parallel communication
-      double * m_pBuf;
       double * m_pMyBuf;
       double * m_pTmpBuf;
       double * m_pBigBuf;
@@ -89,8 +94,6 @@ class ParticleSwarm : public AlgorithmABC
       double ** m_pInit;
 
       //metrics
-      int m_NumUprViols;
-      int m_NumLwrViols;
       double * m_Fmedian;
 }; /* end class ParticleSwarm */
 
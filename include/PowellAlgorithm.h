@@ -11,7 +11,7 @@ Version History
 08-17-04    lsm   RAM fragmentation fixes, metrics collection and reporting
                   Added support for user-requested program termination
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC
-
+10-19-26    lsm   added concurrent line searches (ParallelDirections)
 ******************************************************************************/
 #ifndef POWELL_ALGORITHM_H
 #define POWELL_ALGORITHM_H
@@ -23,12 +23,20 @@ Version History
 class ModelABC;
 class StatsClass;
 class OptSearchClass;
+class ModelBackup;
 
 /******************************************************************************
 class PowellAlgorithm
 
 Powell's method is a zero-order optimization algorithm, which utilizes the
 concept of conjugate directions to determine the optimial search direction.
+
+Optionally, the line searches along the directions of the set are performed
+concurrently, each from the same point, spread over the processors (see
+ConcurrentSearch()). The steps are then combined Jacobi-style. Setting, in the
+BeginPowellAlg section:
+
+   ParallelDirections   yes | no   (default no)
 ******************************************************************************/
 class PowellAlgorithm : public AlgorithmABC
 {
@@ -43,6 +51,8 @@ class PowellAlgorithm : public AlgorithmABC
       int  GetCurrentIteration(void) { return m_CurIter; }
 
    private:
+      double ConcurrentSearch(double * X, double Fcur, double * upr, double * lwr);
+
       //max. # of iterations, where one 1D search is counted as an iteration
       int m_MaxIter; 
 
@@ -58,12 +68,24 @@ class PowellAlgorithm : public AlgorithmABC
       StatsClass * m_pStats; //calibration statistics
       OptSearchClass * m_pSearch; //1-dimensional search
 
+      //concurrent line searches: base and best points, steps and their obj. function values
+      bool m_bConcurrent;
+      ModelBackup * m_pBase;
+      ModelBackup * m_pBest;
+      double * m_pSteps;
+      double * m_pAllSteps;
+      double * m_pStepF;
+      double * m_pAllStepF;
+      double * m_pDir;
+      double * m_pTrial;
+
       //metrics
       int m_AlgCount;
       int m_NumRestarts;
       int m_NumUprViols;
       int m_NumLwrViols;
       int m_CurIter;
+      int m_NumJacobi;
 
 }; /* end class PowellAlgorithm */
 
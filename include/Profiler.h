@@ -0,0 +1,92 @@
+/******************************************************************************
+File     : Profiler.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Lightweight timing of the phases of a model evaluation (parameter
+substitution, model execution, response extraction, objective function
+calculation, output) and of algorithm evaluation loops.
+
+Profiling is enabled by adding the following to the main section of the
+input file:
+   ProfileEvaluations     yes
+   ProfileSummaryInterval <seconds between summaries, default 60>
+   ProfileTraceLimit      <max. number of trace events, default 100000>
+
+Each processor then writes:
+   OstTrace<rank>.json   : Chrome trace (load with chrome://tracing or
+                           https://ui.perfetto.dev), one event per timed phase
+   OstProfile<rank>.txt  : per-phase summary (count, total, mean, min, max,
+                           approximate percentiles) and a log2 histogram of
+                           durations, rewritten periodically and at the end
+
+When profiling is disabled, ProfilerStart() and ProfilerStop() only test a
+flag, so the instrumentation can stay in the hot path.
+
+Phases timed with a ProfileScope (e.g. entire model evaluations) also count
+the heap allocations made by the scope. The summary reports their total,
+mean and maximum, as well as the number of allocation-free scopes, which
+should grow with every evaluation once the scratch buffers have reached their
+steady-state size. Allocations are only counted in builds compiled with
+-DOSTRICH_COUNT_ALLOCS (see MemoryTracker.h).
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added heap allocation counts of ProfileScope phases
+10-19-26    lsm   allocation counts require -DOSTRICH_COUNT_ALLOCS
+******************************************************************************/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "MyHeaderInc.h"
+#include "MemoryTracker.h"
+
+//phases of a model evaluation
+#define PROF_EVAL       (0) //entire model evaluation
+#define PROF_SUBST      (1) //substitution into template files and databases
+#define PROF_MODEL      (2) //model execution (system() call or internal model)
+#define PROF_READ       (3) //DatabaseABC::ReadResponse()
+#define PROF_EXTRACT    (4) //ObservationGroup::ExtractVals()
+#define PROF_OBJFUNC    (5) //objective function calculation
+#define PROF_PRESERVE   (6) //preservation of model output
+#define PROF_WRITE      (7) //Model::Write()
+#define PROF_ALG_EVAL   (8) //evaluation of a population/batch by an algorithm
+#define PROF_NUM_PHASES (9)
+
+//log2 histogram of durations, in microseconds
+#define PROF_NUM_BINS (40)
+
+extern "C" {
+void ProfilerInit(IroncladString pFileName);
+void ProfilerFinalize(void);
+bool ProfilerIsEnabled(void);
+double ProfilerStart(void);
+void ProfilerStop(int phase, double start);
+void ProfilerCountAllocs(int phase, long long numAllocs);
+void ProfilerWriteSummary(void);
+}
+
+/******************************************************************************
+class ProfileScope
+
+Times the enclosing scope (e.g. an entire function with several returns) and
+counts its heap allocations, if they are counted (GetNumAllocs() >= 0).
+******************************************************************************/
+class ProfileScope
+{
+   public:
+      ProfileScope(int phase){ m_Phase = phase; m_Allocs = GetNumAllocs(); m_Start = ProfilerStart();}
+      ~ProfileScope(void)
+      { 
+         long long numAllocs = GetNumAllocs() - m_Allocs;
+         ProfilerStop(m_Phase, m_Start);
+         if(m_Allocs >= 0) ProfilerCountAllocs(m_Phase, numAllocs);
+      }
+
+   private:
+      int m_Phase;
+      long long m_Allocs;
+      double m_Start;
+}; /* end class ProfileScope */
+
+#endif /* PROFILER_H */
@@ -0,0 +1,75 @@
+/******************************************************************************
+File      : QuasiRandom.h
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Encapsulates an index-addressable low-discrepancy (quasi-random) sequence.
+Any point of the sequence can be generated directly from its index, so that
+samples can be produced lazily and independently on each processor without
+having to store or broadcast the full sample matrix.
+
+Two sequences are supported:
+   Halton : radical inverse in the first dim prime bases, randomized using a
+            Cranley-Patterson rotation (a random shift modulo 1).
+   Sobol  : base-2 digital sequence, randomized using a random digital shift
+            (bitwise XOR), which preserves the net structure of the sequence.
+
+Sobol direction numbers are built from primitive polynomials over GF(2) that
+are enumerated at construction time, so there is no limit on the number of
+dimensions. The initial direction numbers are drawn from a fixed generator
+that does not depend on the RandomSeed (i.e. the unscrambled sequence is
+always the same). Scrambling shifts are drawn from MyRand() so that the
+randomized sequence is fully determined by the RandomSeed.
+
+Generating point i costs O(dim * log(i)), so n points cost O(n log n).
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added Sobol sequence with digital shift scrambling
+******************************************************************************/
+#ifndef QUASI_RANDOM_H
+#define QUASI_RANDOM_H
+
+#include "MyHeaderInc.h"
+
+#define QMC_HALTON (0)
+#define QMC_SOBOL  (1)
+
+//number of bits in the Sobol direction numbers
+#define QMC_SOBOL_BITS (32)
+
+/******************************************************************************
+class QuasiRandom
+
+Halton or Sobol sequence with optional scrambling.
+******************************************************************************/
+class QuasiRandom
+{
+   public:
+      QuasiRandom(int dim, bool bScramble);
+      QuasiRandom(int dim, int type, bool bScramble);
+      ~QuasiRandom(void){ DBG_PRINT("QuasiRandom::DTOR"); Destroy(); }
+      void Destroy(void);
+      void GetPoint(long long idx, double * pUnit);
+      void GetScaledPoint(long long idx, Ironclad1DArray pLwr, Ironclad1DArray pUpr, double * pX);
+      void BcastScramble(void);
+      int GetDim(void){ return m_Dim;}
+      int GetType(void){ return m_Type;}
+
+   private:
+      void Init(int dim, int type, bool bScramble);
+      void InitHalton(bool bScramble);
+      void InitSobol(bool bScramble);
+      bool IsPrimitive(unsigned int poly, int degree);
+      double RadicalInverse(long long idx, int base);
+
+      int * m_pBases;
+      double * m_pShift;
+      unsigned int * m_pDirs;  //dim x QMC_SOBOL_BITS direction numbers
+      unsigned int * m_pXor;   //digital shift, one per dimension
+      bool m_bScramble;
+      int m_Dim;
+      int m_Type;
+}; /* end class QuasiRandom */
+
+#endif /* QUASI_RANDOM_H */
@@ -0,0 +1,149 @@
+/******************************************************************************
+File     : ReplicaExchange.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+The ReplicaExchange class supports the parallel tempering (replica exchange)
+mode of the simulated annealing algorithms (SAAlgorithm and VandSA). Several
+replicas of the annealing chain are run at fixed temperatures of a geometric
+ladder, ranging from the final (coldest) to the initial (hottest) temperature
+of the annealing schedule. Periodically, neighbouring replicas attempt to swap
+their states, and a swap between replicas i and j is accepted with probability:
+
+   min(1, exp((1/Ti - 1/Tj)*(Ei - Ej)))
+
+so that good states migrate towards the cold end of the ladder while the hot
+replicas keep exploring the parameter space.
+
+Replicas are numbered globally, from coldest (0) to hottest (R-1), and are
+split into blocks of equal size over the processors; processor p owns replicas
+p*L ... (p+1)*L-1, where L is the number of local replicas. Local replicas are
+run round-robin by the owning processor, and swaps between neighbouring
+replicas owned by different processors are negotiated with a few small
+point-to-point messages. Even and odd pairs of neighbours alternate between
+exchange attempts.
+
+Each replica holds a parameter set, its objective function value and an
+optional block of auxiliary data (e.g. a step distribution matrix) that stays
+with the replica's temperature and is never exchanged.
+
+The annealing algorithms derive from TemperingABC, which reads the tempering
+keywords of the algorithm section:
+
+   ParallelTempering <yes|no, default no>
+   NumReplicas       <number of replicas, default one per cpu (4 if serial)>
+   ExchangeInterval  <outer iterations between exchange attempts, default 1>
+
+and runs the replicas (OptimizeTempering()), using a few hooks to melt, move
+and equilibrate the annealing chain of the algorithm.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added TemperingABC, shared by SAAlgorithm and VandSA
+******************************************************************************/
+#ifndef REPLICA_EXCHANGE_H
+#define REPLICA_EXCHANGE_H
+
+#include "MyHeaderInc.h"
+
+// parent class
+#include "AlgorithmABC.h"
+
+// forward decs
+class ModelABC;
+
+//MPI tag of replica exchange messages
+#define REPX_MPI_TAG (401)
+
+/******************************************************************************
+class ReplicaExchange
+******************************************************************************/
+class ReplicaExchange
+{
+   public :
+      ReplicaExchange(int numParams, int numReplicas, int auxSize);
+      ~ReplicaExchange(void){ DBG_PRINT("ReplicaExchange::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      void SetLadder(double tcold, double thot);
+      void Store(int i, double * pParams, double f);
+      void Exchange(void);
+      double GetBest(double * pParams);
+      double GatherBest(double * pParams);
+
+      int GetNumLocal(void){ return m_NumLocal;}
+      int GetNumReplicas(void){ return m_NumLocal*m_NumProcs;}
+      int GetGlobalIdx(int i){ return m_Rank*m_NumLocal + i;}
+      double GetTemp(int i){ return m_pTemp[i];}
+      double * GetParams(int i){ return m_pParams[i];}
+      double GetObjFuncVal(int i){ return m_pF[i];}
+      double * GetAux(int i){ return m_pAux[i];}
+      int GetNumAttempts(void){ return m_NumAttempts;}
+      int GetNumSwaps(void){ return m_NumSwaps;}
+
+   private:
+      double LadderTemp(int g);
+      bool AcceptSwap(double Tcold, double Thot, double Fcold, double Fhot);
+      void SwapLocal(int i);
+      void SwapWithLower(void);
+      void SwapWithUpper(void);
+
+      int m_Rank;
+      int m_NumProcs;
+      int m_NumParams;
+      int m_NumLocal;
+      int m_AuxSize;
+      int m_Phase;
+      double m_Tcold;
+      double m_Thot;
+      double * m_pTemp;
+      double ** m_pParams;
+      double * m_pF;
+      double ** m_pAux;
+      double * m_pBest;
+      double m_Fbest;
+      double * m_pMsg;
+
+      //metrics
+      int m_NumAttempts;
+      int m_NumSwaps;
+}; /* end class ReplicaExchange */
+
+/******************************************************************************
+class TemperingABC
+
+Base class of the annealing algorithms that support parallel tempering.
+******************************************************************************/
+class TemperingABC : public AlgorithmABC
+{
+   public:
+      TemperingABC(void);
+      virtual ~TemperingABC(void){ DBG_PRINT("TemperingABC::DTOR"); }
+
+   protected:
+      void ReadTemperingToken(char * line);
+      void OptimizeTempering(ModelABC * pModel, IroncladString pAlgStr, int auxSize,
+                             int maxIters, double stopVal);
+      void WriteTemperingMetrics(FILE * pFile);
+
+      //execute the model, melt and return the melted state and temperature range
+      virtual double MeltReplica(double * pX, double * pTcold, double * pThot)=0;
+      //random move away from pX0, result is stored in pX
+      virtual double MoveReplica(double * pX0, double * pX)=0;
+      //initial auxiliary data of a replica
+      virtual void InitReplicaAux(double * pAux)=0;
+      //advance the chain of a replica (pX, f and pAux) at temperature T
+      virtual double EquilibrateReplica(double T, double * pX, double f, double * pAux)=0;
+      virtual double GetConvergenceVal(void)=0;
+      //state of the coldest replica after an outer iteration
+      virtual void EndTemperingIter(int iter, double Tcold, double stop)=0;
+      //make pX the final result of the algorithm
+      virtual void RestoreReplica(double * pX)=0;
+
+      bool m_bTempering;
+      int m_NumReplicas;  //0 --> default (one per cpu, or 4 if serial)
+      int m_XchgInterval; //outer iterations between exchange attempts
+      ReplicaExchange * m_pReplicas;
+}; /* end class TemperingABC */
+
+#endif /* REPLICA_EXCHANGE_H */
@@ -20,6 +20,8 @@ Version History
 10-21-05    lsm   Switched to homegrown implementation that is easier to study
                   than the Vanderbilt and Louie implementation
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC).
+10-19-26    lsm   Added parallel tempering (replica exchange) mode.
+10-19-26    lsm   Parallel tempering is shared with VandSA (TemperingABC).
 ******************************************************************************/
 #ifndef SA_ALGORITHM_H
 #define SA_ALGORITHM_H
@@ -27,7 +29,7 @@ Version History
 #include "MyHeaderInc.h"
 
 // parent class
-#include "AlgorithmABC.h"
+#include "ReplicaExchange.h"
 
 // forward decs
 class ModelABC;
@@ -39,7 +41,7 @@ class StatsClass;
 class SAAlgorithm
 
 ******************************************************************************/
-class SAAlgorithm : public AlgorithmABC
+class SAAlgorithm : public TemperingABC
 {
    public:
       SAAlgorithm(ModelABC * pModel);
@@ -57,6 +59,15 @@ class SAAlgorithm : public AlgorithmABC
       void OptimizeSerial(void);
       void OptimizeParallel(int rank, int nprocs);
 
+      //parallel tempering hooks (see TemperingABC)
+      double MeltReplica(double * pX, double * pTcold, double * pThot);
+      double MoveReplica(double * pX0, double * pX);
+      void InitReplicaAux(double * pAux){ return;}
+      double EquilibrateReplica(double T, double * pX, double f, double * pAux);
+      double GetConvergenceVal(void){ return m_CurStop;}
+      void EndTemperingIter(int iter, double Tcold, double stop);
+      void RestoreReplica(double * pX);
+
       double InitMaster(int nprocs);
       void InitSlave(int rank, int nprocs);
 
@@ -119,6 +119,7 @@ UPPER      double * Upper bounds of the parameters to be optimized.
 
 Version History
 10-31-09    lsm   Created
+10-19-26    lsm   Added checkpoint/restart (see Checkpoint.h).
 ******************************************************************************/
 #ifndef SCEUA_H
 #define SCEUA_H
@@ -129,6 +130,7 @@ Version History
 // forward declarations
 class ModelABC;
 class StatsClass;
+class Checkpoint;
 
 /******************************************************************************
 class SCEUA
@@ -194,6 +196,8 @@ class SCEUA : public AlgorithmABC
       bool m_bUseInitPt;
       ModelABC * m_pModel;
       StatsClass * m_pStats;
+      Checkpoint * m_pCkpt;
+      bool m_bResume; //true if resuming from a checkpoint
 }; /* end class SCEUA */
 
 extern "C" {
@@ -8,6 +8,7 @@ An implementation of a sampling algorithm. Loosely based on Big Bang-Big Crunch
 
 Version History
 11-21-07    lsm   created 
+10-19-26    lsm   only the best parameter set is kept in memory
 ******************************************************************************/
 #ifndef SAMPLING_ALGORITHM_H
 #define SAMPLING_ALGORITHM_H
@@ -42,7 +43,7 @@ class SamplingAlgorithm : public AlgorithmABC
    private:
       void UserDefinedEvaluations(void);
       void GenerateInitialSamples(int num);
-      ParameterList * InsertParamSet(double F);      
+      void InsertParamSet(double F);
 
       /* ---------------------------------------
       if true, initialize using LHS sample. 
@@ -63,9 +64,9 @@ class SamplingAlgorithm : public AlgorithmABC
 
       int m_NumParams;
 
-      ParameterList * m_pAll; //list of all parameter sets
       MyPoint * m_pSamples;   //list of new samples to be evaluated
-      MyPoint * m_pBest;      //pointer to best overall parameter configuration
+      MyPoint * m_pBest;      //best overall parameter configuration
+      double *  m_pTmp;       //scratch copy of the most recent parameter set
 
       ModelABC * m_pModel;
       StatsClass * m_pStats; //calibration statistics
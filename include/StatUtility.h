@@ -10,6 +10,7 @@ Version History
 08-20-03    lsm   created version history field and updated comments.
 03-05-04    lsm   replaced magic # with NEARLY_ZERO
 01-01-07    lsm   Added Durbin-Watson and runs tests.
+10-19-26    lsm   Added a running quantile estimate (P-square algorithm).
 ******************************************************************************/
 #ifndef STAT_UTILITY_H
 #define STAT_UTILITY_H
@@ -21,6 +22,26 @@ Version History
 #define CENTRAL_TEND_MEDIAN (1)
 #define CENTRAL_TEND_PCTILE (2)
 
+/* ----------------------------------------------------------------------------
+Running estimate of a quantile, updated one observation at a time in constant 
+time and memory (P-square algorithm of Jain and Chlamtac, 1985). Five markers 
+track the minimum, the p/2, p and (1+p)/2 quantiles and the maximum; the first 
+five observations are kept as is.
+---------------------------------------------------------------------------- */
+typedef struct QUANTILE_STRUCT
+{
+   double p;     //quantile, 0 < p < 1
+   int count;    //number of observations
+   double q[5];  //marker heights
+   double n[5];  //marker positions
+   double np[5]; //desired marker positions
+   double dn[5]; //increments of the desired marker positions
+}QuantileStruct;
+
+void InitQuantile(QuantileStruct * pQ, double p);
+void UpdateQuantile(QuantileStruct * pQ, double x);
+double GetQuantile(QuantileStruct * pQ);
+
 double GammaLn(double val);
 double CalcMean(Ironclad1DArray  v, int size);
 double CalcMedian(Unmoveable1DArray v, int size);
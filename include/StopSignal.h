@@ -0,0 +1,50 @@
+/******************************************************************************
+File     : StopSignal.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Detection of user requests for early termination, without opening the stop
+file (OstQuit.txt) on every check. A stop is requested by any of:
+   - creating the stop file in the run directory. On Linux this is detected
+     immediately via inotify. Since inotify does not see files created by
+     other hosts of a network filesystem, the file is also checked with stat()
+     at most once every STOP_POLL_SEC seconds (on all platforms).
+   - sending SIGTERM, SIGINT, SIGUSR1 or SIGUSR2. A second signal terminates
+     the program immediately.
+   - a stop message from another processor. The processor that first detects
+     a stop request forwards it to all others, so that every processor sees
+     it at its next check. Stop messages are sent on a duplicate of
+     MPI_COMM_WORLD, so they can't be received as algorithm messages.
+
+A stop request also cancels model runs that are in progress: RunModelCommand()
+executes the model in its own process group and kills that group when a stop
+is requested.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   stop messages use their own communicator
+******************************************************************************/
+#ifndef STOP_SIGNAL_H
+#define STOP_SIGNAL_H
+
+#include "MyHeaderInc.h"
+
+//minimum time between stat() checks of the stop file
+#define STOP_POLL_SEC (1.00)
+
+//MPI tag of the stop message sent between processors
+#define STOP_MPI_TAG (31337)
+
+//return value of RunModelCommand() when the run is cancelled
+#define MODEL_CANCELLED (-999)
+
+//seconds between SIGTERM and SIGKILL when cancelling a model run
+#define STOP_KILL_GRACE_SEC (2.00)
+
+extern "C" {
+void StopSignalInit(IroncladString pStopFile);
+bool StopRequested(void);
+int RunModelCommand(IroncladString pCmd);
+}
+
+#endif /* STOP_SIGNAL_H */
@@ -82,8 +82,32 @@ are as follows:
     (8) ArgumentsFile -  The file that "Tasker Client" should read to determine
         parameter values for a given model evaluation.
 
+    (9) TaskQueue - Optional. A directory that serves as a task queue, in place
+        of the task file. Each task is written to it as soon as it is created,
+        as a file named 'Task<N>.task' that contains the task's command line.
+        This allows tasks to be submitted one at a time, so that asynchronous 
+        algorithms (e.g. PDDS) can keep the cluster busy. bench/OstTasker.cpp 
+        is a local stand-in tasker for this protocol, for testing.
+
+   (10) MaxTasksInFlight - The number of tasks that asynchronous algorithms 
+        keep queued or running at any time (requires TaskQueue, default 4).
+
+Per-task completion markers
+When task 'N' completes and its output files have been copied to the 'TaskN'
+folder, the client-side script (or the tasker) should create an empty file 
+named 'TaskN.done' ('TaskN.fail' if the task failed) in the directory under 
+which Ostrich is running. Ostrich watches for these markers (with inotify, 
+where available) and gathers the result of each task as soon as its marker 
+appears, in completion order. With the task queue, the directory is also 
+read every SMUSE_SCAN_SEC seconds, to catch markers created by other hosts. 
+Markers are optional with the task file: they are only seen through inotify, 
+and otherwise all tasks complete when the success file appears.
+
 Version History
 07-13-07    lsm   added copyright information and initial comments.
+10-19-26    lsm   added per-task completion markers, the task queue directory
+                  and asynchronous task submission (SubmitTask() and 
+                  WaitForNextTask()).
 ******************************************************************************/
 #ifndef SUPER_MUSE_H
 #define SUPER_MUSE_H
@@ -94,6 +118,20 @@ Version History
 class ModelABC;
 class ParameterGroup;
 
+//return values of WaitForNextTask()
+#define SMUSE_JOB_DONE   (-1) //no tasks left
+#define SMUSE_JOB_FAILED (-2) //error, time out or user abort
+
+//states of a task
+#define SMUSE_TASK_NONE    (0)
+#define SMUSE_TASK_PENDING (1)
+#define SMUSE_TASK_DONE    (2)
+
+//interval (sec.) of the scans of the server directory, for when inotify is 
+//not available or can't see files created by other hosts of a network 
+//filesystem
+#define SMUSE_SCAN_SEC (0.25)
+
 typedef struct ENV_VAR_LIST
 {
   char pVar[1000];
@@ -117,6 +155,10 @@ class SuperMUSE
       void FinishTaskFile(void);
       bool WaitForTasker(void);
       double GatherResult(int taskid);
+      int SubmitTask(ParameterGroup * pGroup);
+      int WaitForNextTask(void);
+      bool IsTaskQueue(void){ return (m_QueueDir[0] != (char)NULL);}
+      int GetMaxTasksInFlight(void){ return m_MaxInFlight;}
       void WriteSetup(FILE * pFile);     
       void EnvVarCleanup(void);
 
@@ -127,6 +169,26 @@ class SuperMUSE
       void ReplaceEnvVars(char * pTarget);      
       EnvVarList * m_pEnvVars;
 
+      //per-task completion tracking
+      void AddTask(int taskid);
+      void MarkTask(int taskid, bool bFailed);
+      void ScanMarkers(void);
+      void ReadWatch(void);
+      void WaitForEvent(double maxWait);
+      void EndJob(void);
+      int * m_pTaskState;
+      int * m_pDone; //completed tasks, in order of completion
+      int m_TaskCapacity;
+      int m_DoneHead;
+      int m_DoneTail;
+      int m_NumPending;
+      int m_WatchFd;
+      bool m_bFailed;
+      double m_LastScan;
+      double m_LastProgress;
+      char m_QueueDir[1000];
+      int m_MaxInFlight;
+
       char m_Server[1000];
       char m_TaskFile[1000];
       char m_TempFile[1000];
@@ -0,0 +1,145 @@
+/******************************************************************************
+File     : SurrogateEngine.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+In-process surrogate (response surface) of the objective function, used to
+pre-screen candidate parameter sets so that only the most promising candidate
+is evaluated with the (expensive) complex model. Two types of surrogate are
+supported:
+
+   rbf : cubic radial basis function interpolant with a linear tail. The
+         inverse of the interpolation matrix is updated with the bordering
+         method as points arrive. Candidates are ranked by a weighted score
+         of their predicted value and their distance from the evaluated
+         points (Regis and Shoemaker, 2007), cycling through a few weights.
+
+   gp  : Gaussian process with a squared-exponential kernel. The Cholesky
+         factor of the covariance matrix is extended by one row as points
+         arrive and is recomputed (with CholeskyDecomp()) when the number of
+         points has doubled, at which time the length scale is re-selected by
+         maximizing the marginal likelihood. Candidates are ranked by their
+         expected improvement.
+
+Every complex model run (including those selected by the DecisionModule of the
+surrogate-based approach) is added to the surrogate. Parameters are scaled to
+the unit hypercube. Users select the engine in the main configuration section
+and may configure it in an optional section:
+
+   SurrogateEngine   rbf | gp
+
+   BeginSurrogateEngine
+   NumCandidates   <candidates screened per model run, default 500>
+   MinPoints       <model runs needed before screening, default 2(n+1)>
+   EndSurrogateEngine
+
+In parallel, each processor adds its own model runs, and Synchronize() shares
+them with the other processors. Runs are only kept for sharing once the
+algorithm has called EnableSync(), so algorithms that never synchronize don't
+accumulate them.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added WriteCheckpoint() and ReadCheckpoint()
+10-19-26    lsm   added EnableSync(), model runs are only kept if enabled
+******************************************************************************/
+#ifndef SURROGATE_ENGINE_H
+#define SURROGATE_ENGINE_H
+
+#include "MyHeaderInc.h"
+
+//forward declarations
+class ParameterGroup;
+class Checkpoint;
+
+#define SRG_ENGINE_RBF (0)
+#define SRG_ENGINE_GP  (1)
+
+/******************************************************************************
+class SurrogateEngine
+******************************************************************************/
+class SurrogateEngine
+{
+   public:
+      SurrogateEngine(ParameterGroup * pGroup, FILE * pInFile, IroncladString pType);
+      ~SurrogateEngine(void){ DBG_PRINT("SurrogateEngine::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      void AddModelRun(double f);
+      void AddPoint(double * pX, double f);
+      void Synchronize(void);
+      void EnableSync(void){ m_bSync = true;}
+      bool IsReady(void){ return (m_NumFit > 0);}
+      int GetNumCandidates(void){ return m_NumCands;}
+      double Predict(double * pX, double * pSigma);
+      int Screen(double * pCands, int nCands);
+      void WriteMetrics(FILE * pFile);
+      void WriteCheckpoint(Checkpoint * pCkpt);
+      void ReadCheckpoint(Checkpoint * pCkpt);
+
+   private:
+      void Normalize(double * pX, double * pU);
+      void Insert(double f);
+      double Kernel(double * pU, double * pV);
+      double MinDist(double * pU);
+      double PredictScaled(double * pU, double * pSigma);
+      void Grow(void);
+      void Refit(void);
+      bool RefitGP(void);
+      bool RefitRBF(void);
+      bool AppendGP(void);
+      bool AppendRBF(void);
+      void Solve(void);
+      double LogLikelihoodGP(double ** pL, int n);
+
+      int m_Type;
+      int m_NumParams;
+      int m_NumCands;
+      int m_MinPts;
+      ParameterGroup * m_pGroup;
+
+      //scaling of parameters to the unit hypercube
+      double * m_pLwr;
+      double * m_pRange;
+
+      //points (m_MaxPts x m_NumParams, scaled) and objective function values
+      int m_MaxPts;
+      int m_NumPts;
+      int m_NumFit; //number of points included in the surrogate
+      int m_LastRefit;
+      double * m_pU;
+      double * m_pF;
+      double m_Fmin;
+
+      //gp: Cholesky factor (row i holds i+1 entries) and weights
+      double ** m_pL;
+      double * m_pAlpha;
+      double m_Length;
+      double m_Mean;
+      double m_Scale;
+
+      //rbf: inverse of the interpolation matrix and coefficients
+      double ** m_pMinv;
+      int m_MinvSize;
+      double * m_pCoef;
+
+      //scratch
+      double * m_pWork;
+      double * m_pWork2;
+      double * m_pX;
+
+      //local model runs not yet shared with other processors
+      bool m_bSync;
+      double * m_pPending;
+      int m_NumPending;
+      int m_MaxPending;
+
+      //metrics
+      int m_NumRejected;
+      int m_NumRefits;
+      int m_NumScreens;
+      double m_NumScreened;
+      int m_Cycle;
+}; /* end class SurrogateEngine */
+
+#endif /* SURROGATE_ENGINE_H */
@@ -0,0 +1,109 @@
+/******************************************************************************
+File     : SwarmKernel.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Storage and update kernel of a particle swarm, shared by the synchronous
+(ParticleSwarm) and asynchronous (APPSO) PSO algorithms.
+
+The swarm is stored as contiguous particle x parameter matrices (positions,
+velocities and local best positions, one row per particle), along with
+vectors of objective function values and particle x constraint matrices of
+the special parameter constraints. Since the position matrix is contiguous,
+it can be broadcast or sent directly, without packing.
+
+Move() updates all velocities and positions. The random weights of a particle
+are drawn in bulk before its update, and the update itself is written as a
+few branch-free passes over the rows, so that the compiler can vectorize it.
+Parameter bounds and types are cached by the kernel (see SetBounds()).
+
+If a surrogate engine is attached (see SetScreen()) and ready, Move() draws
+several candidate moves for each particle and keeps the one that the engine
+considers most promising.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added surrogate pre-screening of particle moves
+10-19-26    lsm   added WriteCheckpoint() and ReadCheckpoint()
+******************************************************************************/
+#ifndef SWARM_KERNEL_H
+#define SWARM_KERNEL_H
+
+#include "MyHeaderInc.h"
+
+//forward declarations
+class SurrogateEngine;
+class Checkpoint;
+
+/******************************************************************************
+class SwarmKernel
+******************************************************************************/
+class SwarmKernel
+{
+   public:
+      SwarmKernel(int numParticles, int numParams, int numSpecial);
+      ~SwarmKernel(void){ DBG_PRINT("SwarmKernel::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      void SetBounds(int j, double lwr, double upr, bool bReal);
+      void SetScreen(SurrogateEngine * pSrg);
+      void Move(int gen, int bestIdx, double constrict, double inertia, double c1, double c2);
+      void InitBest(void);
+      void UpdateBest(int * pBestIdx, double * pBest);
+      void WriteCheckpoint(Checkpoint * pCkpt);
+      void ReadCheckpoint(Checkpoint * pCkpt);
+
+      int GetNumParticles(void){ return m_NumParticles;}
+      int GetNumParams(void){ return m_NumParams;}
+      double * GetPositions(void){ return m_pX;}
+      double * GetObjFuncs(void){ return m_pFx;}
+      double * GetX(int i){ return &(m_pX[(size_t)i*m_NumParams]);}
+      double * GetV(int i){ return &(m_pV[(size_t)i*m_NumParams]);}
+      double * GetB(int i){ return &(m_pB[(size_t)i*m_NumParams]);}
+      double * GetCx(int i){ return &(m_pCx[(size_t)i*m_NumSpecial]);}
+      double * GetCb(int i){ return &(m_pCb[(size_t)i*m_NumSpecial]);}
+      double GetFx(int i){ return m_pFx[i];}
+      double GetFb(int i){ return m_pFb[i];}
+      void SetFx(int i, double f){ m_pFx[i] = f;}
+      void SetFb(int i, double f){ m_pFb[i] = f;}
+      int GetNumUprViols(void){ return m_NumUprViols;}
+      int GetNumLwrViols(void){ return m_NumLwrViols;}
+
+   private:
+      void MoveParticle(double * x, double * v, double * b, double * g, double scale,
+                        double constrict, double inertia, double c1, double c2,
+                        int * pNumUpr, int * pNumLwr);
+
+      int m_NumParticles;
+      int m_NumParams;
+      int m_NumSpecial;
+
+      double * m_pX;  //positions
+      double * m_pV;  //velocities
+      double * m_pB;  //local best positions
+      double * m_pFx; //objective function values
+      double * m_pFb; //local best objective function values
+      double * m_pCx; //constraint values
+      double * m_pCb; //local best constraint values
+
+      //cached parameter bounds and types (1.00 for real-valued parameters)
+      double * m_pLwr;
+      double * m_pUpr;
+      double * m_pReal;
+
+      //random weights (r1, r2) and minimum perturbations of a particle
+      double * m_pRand;
+
+      //surrogate pre-screening: candidate positions, velocities and violations
+      SurrogateEngine * m_pSrg;
+      int m_NumCands;
+      double * m_pCandX;
+      double * m_pCandV;
+      int * m_pCandViols;
+
+      //metrics
+      int m_NumUprViols;
+      int m_NumLwrViols;
+}; /* end class SwarmKernel */
+
+#endif /* SWARM_KERNEL_H */
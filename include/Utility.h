@@ -18,6 +18,8 @@ Version History
 01-01-07    lsm   Added support for temporary input files which store
                   copies of the surrogate sections of the input file.
 03-03-07    jrc   Added UniformRandom(), GaussRandom(), and iMax()
+10-19-26    lsm   Added GetRandomState() and SetRandomState()
+10-19-26    lsm   Added RecvWorkMsg()
 ******************************************************************************/
 #ifndef UTILITY_H
 #define UTILITY_H
@@ -43,6 +45,9 @@ unsigned int GetElapsedTime(void);
 double GetElapsedTics(void);
 unsigned int GetRandomSeed(void);
 void ResetRandomSeed(unsigned int seed);
+void GetRandomState(unsigned int * pSeed, unsigned long long * pCalls, unsigned int * pIndex);
+void SetRandomState(unsigned int seed, unsigned long long calls, unsigned int index);
+int RecvWorkMsg(double * pBuf, int count);
 unsigned int ReadRandomSeed(void);
 void RestoreRandomSeed(void);
 int SampleWithReplacement(int opFlag, int range);
@@ -9,6 +9,10 @@ Interface class for the VARS plugin, which must be licensed separately.
  
 Version History
 06-18-18    lsm   created file
+10-19-26    lsm   Added a native STAR-VARS engine (BeginVARS ... EndVARS): star
+                  points are handed out through a work queue, variograms are
+                  accumulated as results arrive, and bootstrap replicates are
+                  spread over the processors.
 ******************************************************************************/
 #ifndef VARS_ALGORITHM_H
 #define VARS_ALGORITHM_H
@@ -18,6 +22,9 @@ Version History
 #include "ModelABC.h"
 #include "AlgorithmABC.h"
 
+//indices of each parameter: IVARS10, IVARS30, IVARS50 and VARS-TO
+#define VARS_NUM_IDX (4)
+
 /******************************************************************************
 class VARS
 ******************************************************************************/
@@ -40,11 +47,61 @@ class VARS : public AlgorithmABC
       int LoadPlugin(char * filename);
       int BoxCoxProgram(void);
 
+      // native engine
+      void OptimizeNative(void);
+      void WorkNative(void);
+      void InitStars(void);
+      bool NextPoint(double * x, int * pStar, int * pDim, int * pPos);
+      void AddResult(int s, int i, int k, double f);
+      void ComputeIndices(int * pStars, double * pOut, double * pGamma);
+      void Bootstrap(void);
+      void WriteResults(void);
+
       // member variables
       ModelABC * m_pModel;
       char * m_PluginFile;
       char * m_Subroutine;
       int m_CurIter;
+
+      /* ---------------------------------------------------------------
+      Native engine. Parameters are scaled to [0,1]. Along dimension (i), 
+      the cross-section of star (s) holds the points spaced m_DeltaH apart 
+      that line up with the star center; slot (k) of a section lies at 
+      m_pOrigin[s*n+i] + k*m_DeltaH, the center is at slot m_pMid[s*n+i].
+      --------------------------------------------------------------- */
+      bool m_bNative;
+      int m_NumParams;
+      int m_NumStars;
+      double m_DeltaH;
+      int m_NumLags; //largest lag, in multiples of m_DeltaH
+      int m_NumBoot; //bootstrap replicates
+      double m_ConfLvl; //confidence level of bootstrap intervals
+      double * m_pLwr;
+      double * m_pUpr;
+      double * m_pCenter; //[stars*n] star centers
+      double * m_pOrigin; //[stars*n] first slot of each section
+      int * m_pLen; //[stars*n] slots of each section
+      int * m_pMid; //[stars*n] slot of the center
+      int * m_pLeft; //[stars] points of each star not yet evaluated
+      double * m_pY; //[stars*n*(lags+1)] results, by slot
+      bool * m_pHave; //[stars*n*(lags+1)] true once a slot has a result
+      double * m_pSum; //[stars*n*(lags+1)] sum of squared differences, by lag
+      double * m_pCnt; //[stars*n*(lags+1)] pairs, by lag
+      double * m_pSecN; //[stars*n] running mean and variance of each section
+      double * m_pSecMean;
+      double * m_pSecM2;
+      double * m_pStarN; //[stars] running mean and variance of each star
+      double * m_pStarMean;
+      double * m_pStarM2;
+      double * m_pIdx; //[n*VARS_NUM_IDX] sensitivity indices
+      double * m_pGamma; //[n*(lags+1)] variograms
+      double * m_pBoot; //[boot*n*VARS_NUM_IDX] bootstrap replicates of indices
+      double * m_pBest; //[n+1] best point
+      int m_NextStar; //next point to hand out
+      int m_NextDim;
+      int m_NextPos;
+      int m_NumEvals;
+      int m_StarsDone;
 }; /* end class PAES */
 
 extern "C" {
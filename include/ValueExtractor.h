@@ -12,6 +12,7 @@ Version History
 03-05-04    lsm   added PSO, fixed filename parse error in obs. parse
                   added support for alternative tokens
 08-11-04    lsm   made into a linked list to reduce file I/O
+10-19-26    lsm   extraction uses a scratch buffer sized when the file is read
 ******************************************************************************/
 #ifndef VALUE_EXTRACTOR_H
 #define VALUE_EXTRACTOR_H
@@ -45,6 +46,10 @@ class ValueExtractor
 
       StringType m_DataStr;
       int m_DataSize;
+
+      //scratch buffer of ExtractValue(), at least as large as a line of the file
+      StringType m_Msg;
+      int m_MsgSize;
       bool m_bQuitOnError;
       double m_ErrorVal;
 
@@ -11,12 +11,14 @@ Version History
                   Continuous Variables". Journal of Computational Physics. 
                   vol. 56, pg. 259-271.
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC).
+10-19-26    lsm   Added parallel tempering (replica exchange) mode.
+10-19-26    lsm   Parallel tempering is shared with SAAlgorithm (TemperingABC).
 ******************************************************************************/
 #ifndef VAND_SA_H
 #define VAND_SA_H
 
 // parent class
-#include "AlgorithmABC.h"
+#include "ReplicaExchange.h"
 
 // forward decs
 class ModelABC;
@@ -28,7 +30,7 @@ class StatsClass;
 class VandSA
 
 ******************************************************************************/
-class VandSA : public AlgorithmABC
+class VandSA : public TemperingABC
 {
    public:
       VandSA(ModelABC * pModel);
@@ -45,6 +47,15 @@ class VandSA : public AlgorithmABC
       void OptimizeSerial(void);
       void OptimizeParallel(int rank, int nprocs);
 
+      //parallel tempering hooks (see TemperingABC)
+      double MeltReplica(double * pX, double * pTcold, double * pThot);
+      double MoveReplica(double * pX0, double * pX);
+      void InitReplicaAux(double * pAux);
+      double EquilibrateReplica(double T, double * pX, double f, double * pAux);
+      double GetConvergenceVal(void){ return m_CurStop;}
+      void EndTemperingIter(int iter, double Tcold, double stop);
+      void RestoreReplica(double * pX);
+
       double InitMaster(int nprocs);
       void InitSlave(int rank, int nprocs);
 
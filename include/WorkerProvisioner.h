@@ -0,0 +1,115 @@
+/******************************************************************************
+File     : WorkerProvisioner.h
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+The WorkerProvisioner class populates the model subdirectory of a processor
+(ModelSubdir) with the model executable, the extra files and the extra
+folders of the input file. Files are registered while the input file is
+parsed (see AddFile() and AddPath()) and are placed all at once by
+Provision(), in-process and without a shell.
+
+Files are placed by a few threads, in one of the following ways:
+
+   clone : (default) reflink (copy-on-write clone) of the source file where
+           the filesystem supports it, a plain copy otherwise.
+   link  : the first processor stages a clone or copy of the files in a
+           staging directory, which the other processors wait for. Every
+           processor then hardlinks the staged files into its own
+           subdirectory, so that the files are written only once no matter
+           how many processors are used. The staging directory is removed
+           afterwards. Since the workers share the staged files, the model
+           must not modify them in place (replacing them is fine). A file
+           that can't be linked is cloned or copied instead.
+   copy  : plain copy of the source file.
+
+Settings, in the main section of the input file:
+
+   WorkerProvisioning   clone | link | copy   (default clone)
+
+The time taken (the maximum over all processors) is reported at startup and
+with the metrics of the model. Other processors report their own time. If any
+processor fails to place its files, all processors report an error and exit.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   processors exit together on errors (see CheckError())
+******************************************************************************/
+#ifndef WORKER_PROVISIONER_H
+#define WORKER_PROVISIONER_H
+
+#include "MyHeaderInc.h"
+#ifdef GCC5X
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+#define PROVISION_CLONE (0)
+#define PROVISION_LINK  (1)
+#define PROVISION_COPY  (2)
+
+//files placed by each thread, and max. number of threads
+#define PROVISION_FILES_PER_THREAD (16)
+#define PROVISION_MAX_THREADS      (4)
+
+/******************************************************************************
+class WorkerProvisioner
+******************************************************************************/
+class WorkerProvisioner
+{
+   public:
+      WorkerProvisioner(IroncladString pFileName, IroncladString pPrefix);
+      ~WorkerProvisioner(void){ DBG_PRINT("WorkerProvisioner::DTOR"); Destroy(); }
+      void Destroy(void);
+
+      void AddFile(IroncladString pName);
+      void AddPath(IroncladString pName);
+      void Provision(void);
+      void WriteMetrics(FILE * pFile);
+
+   private:
+      //a file to be placed: source, and path relative to the destination
+      struct ProvisionItem
+      {
+         fs::path src;
+         fs::path rel;
+      };
+
+      void Expand(std::vector<ProvisionItem> * pFiles, std::vector<fs::path> * pDirs);
+      void PlaceAll(const std::vector<ProvisionItem> & files, const fs::path & from,
+                    const fs::path & to, bool bLink);
+      void Worker(const std::vector<ProvisionItem> * pFiles, const fs::path * pFrom,
+                  const fs::path * pTo, bool bLink);
+      void Place(const fs::path & src, const fs::path & dst, bool bLink);
+      bool Clone(const fs::path & src, const fs::path & dst);
+      void CheckError(void);
+
+      int m_Mode;
+      int m_Rank;
+      int m_NumProcs;
+      fs::path m_WorkDir;
+      fs::path m_StageDir;
+      std::vector<ProvisionItem> m_Items;
+
+      //shared by the threads of Provision()
+      std::atomic<size_t> m_Next;
+      std::mutex m_Mutex;
+      std::string m_Error;
+
+      //metrics
+      int m_NumFiles;
+      std::atomic<int> m_NumLinked;
+      std::atomic<int> m_NumCloned;
+      std::atomic<int> m_NumCopied;
+      double m_Time;
+}; /* end class WorkerProvisioner */
+
+#endif /* WORKER_PROVISIONER_H */
@@ -66,6 +66,7 @@ void WriteMelt(int count, int max, char c);
 #define WRITE_JAC   (-14)
 #define WRITE_SCE   (-15)
 #define WRITE_GLUE  (-16)
+#define WRITE_PARA  (-17)
 
 void Write1dSearch(int count, int max);
 void WriteInnerEval(int count, int max, char c);
@@ -10,6 +10,10 @@ of the PDDS algorithm.
 
 Version History
 12-30-14    lsm   added copyright information and initial comments.
+10-19-26    lsm   Swarm is stored as contiguous matrices (SwarmKernel).
+10-19-26    lsm   Particle moves are pre-screened with the surrogate engine, if
+                  any, and model runs are shared with all processors.
+10-19-26    lsm   Model runs are only kept for sharing while APPSO runs.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -23,6 +27,8 @@ Version History
 #include "ParameterABC.h"
 #include "LatinHypercube.h"
 #include "StatsClass.h"
+#include "SwarmKernel.h"
+#include "SurrogateEngine.h"
 
 #include "Exception.h"
 #include "WriteUtility.h"
@@ -46,8 +52,8 @@ void APPSO::WarmStart(void)
 
    for(i = 0; i < np; i++)
    {
-      m_pSwarm[0].x[i] = pbest[i];
-      m_pSwarm[0].b[i] = pbest[i];
+      m_pSwarm->GetX(0)[i] = pbest[i];
+      m_pSwarm->GetB(0)[i] = pbest[i];
    }
    ((Model *)m_pModel)->SetCounter(newcount);
    delete [] pbest;
@@ -69,8 +75,6 @@ APPSO::APPSO(ModelABC * pModel)
    m_Fmedian = NULL;
    m_SwarmSize = 0;
    m_BestIdx = 0;
-   m_NumUprViols = 0;
-   m_NumLwrViols = 0;
    m_NumInit = 0;
    m_id = 0;
 
@@ -85,18 +89,8 @@ Free up memory used by the PSO and it's member variables.
 void APPSO::Destroy(void)
 {
    int i;
-   if(m_id == 0)
-   {
-      for(i = 0; i < m_SwarmSize; i++)
-      {
-         delete [] m_pSwarm[i].v;
-         delete [] m_pSwarm[i].x;
-         delete [] m_pSwarm[i].b;
-         delete [] m_pSwarm[i].cb;
-         delete [] m_pSwarm[i].cx;
-      }
-   }
-   delete [] m_pSwarm;
+
+   delete m_pSwarm;
 
    for(i = 0; i < m_NumInit; i++)
    {
@@ -122,9 +116,8 @@ parameter is used in the termination criteria of the PSO algorithm.
 double APPSO::CalcPSOMedian(void)
 {
    double med;
-   int i;
     
-   for(i = 0; i < m_SwarmSize; i++) { m_Fmedian[i] = m_pSwarm[i].fx; }
+   memcpy(m_Fmedian, m_pSwarm->GetObjFuncs(), sizeof(double)*m_SwarmSize);
    med = CalcMedian(m_Fmedian, m_SwarmSize);
 
    return med;
@@ -178,10 +171,11 @@ void APPSO::Optimize(void)
    int num, g;
    int id;
    int i, j, nprocs, nSpecial;
-   double upr, lwr, r, range, sgn;
-   double avg, x, pl, pg, r1, r2, v, vmin, median;
+   double upr, lwr, r, range;
+   double median;
    double rval, init; //initial inertia
    ParameterGroup * pGroup;
+   ParameterABC * pParam;
 
    InitFromFile(GetInFileName());
 
@@ -200,6 +194,12 @@ void APPSO::Optimize(void)
    num = pGroup->GetNumParams();
    nSpecial = pGroup->GetNumSpecialParams();
 
+   //model runs are shared with the surrogate engine of each processor
+   if(m_pModel->GetSurrogateEnginePtr() != NULL)
+   {
+      m_pModel->GetSurrogateEnginePtr()->EnableSync();
+   }
+
    m_Assignments = new int[nprocs];
 
    /* ===============================================================================
@@ -211,41 +211,25 @@ void APPSO::Optimize(void)
       //write banner
       WriteBanner(m_pModel, "gen   best value     ", "Convergence Value");
 
-      NEW_PRINT("ParticleStruct", m_SwarmSize);
-      m_pSwarm = new ParticleStruct[m_SwarmSize];
+      NEW_PRINT("SwarmKernel", 1);
+      m_pSwarm = new SwarmKernel(m_SwarmSize, num, nSpecial);
       MEM_CHECK(m_pSwarm);
 
       NEW_PRINT("double", m_SwarmSize);
       m_Fmedian = new double[m_SwarmSize];
       MEM_CHECK(m_Fmedian);
 
-      for(i = 0; i < m_SwarmSize; i++)
+      for(j = 0; j < num; j++)
       {
-         NEW_PRINT("double", num);
-         m_pSwarm[i].x = new double[num];
-
-         NEW_PRINT("double", num);
-         m_pSwarm[i].v = new double[num];
-
-         NEW_PRINT("double", num);
-         m_pSwarm[i].b = new double[num];
-
-         NEW_PRINT("double", nSpecial);
-         m_pSwarm[i].cb = new double[nSpecial];
-
-         NEW_PRINT("double", nSpecial);
-         m_pSwarm[i].cx = new double[nSpecial];
-
-         m_pSwarm[i].n = num;      
+         pParam = pGroup->GetParamPtr(j);
+         m_pSwarm->SetBounds(j, pParam->GetLwrBnd(), pParam->GetUprBnd(),
+                             (strcmp(pParam->GetType(), "real") == 0));
       }/* end for() */
-      MEM_CHECK(m_pSwarm[i-1].b);
+      m_pSwarm->SetScreen(m_pModel->GetSurrogateEnginePtr());
 
-      //random swarm initialization
+      //random swarm initialization (initial velocity is 0.00)
       for(i = 0; i < m_SwarmSize; i++) //for each particle
       {
-         //initial velocity is 0.00
-         for(j = 0; j < num; j++){ m_pSwarm[i].v[j] = 0.00;}
-
          for(j = 0; j < num; j++) //for each parameter
          {
             //generate a random between lower and upper bound
@@ -254,19 +238,16 @@ void APPSO::Optimize(void)
             range = upr - lwr;
             r = (double)MyRand() / (double)MY_RAND_MAX;
             rval = (r * range) + lwr;
-            m_pSwarm[i].x[j] = rval;
-            m_pSwarm[i].b[j] = rval;         
+            m_pSwarm->GetX(i)[j] = rval;
+            m_pSwarm->GetB(i)[j] = rval;
          }/* end for() */
       }/* end for() */
 
       //seed swarm with pre-specified values
       for(i = 0; (i < m_NumInit) && (i < m_SwarmSize); i++)
       {
-         for(j = 0; j < num; j++)
-         {         
-            m_pSwarm[i].x[j] = m_pInit[i][j];
-            m_pSwarm[i].b[j] = m_pInit[i][j];
-         }/* end for() */
+         memcpy(m_pSwarm->GetX(i), m_pInit[i], sizeof(double)*num);
+         memcpy(m_pSwarm->GetB(i), m_pInit[i], sizeof(double)*num);
       }/* end for() */
 
       //read in best result from previous run, if desired
@@ -277,8 +258,8 @@ void APPSO::Optimize(void)
       // extract initial values, if desired
       if(pGroup->CheckExtraction() == true)
       {
-         pGroup->ReadParams(m_pSwarm[0].x);
-         pGroup->ReadParams(m_pSwarm[0].b);      
+         pGroup->ReadParams(m_pSwarm->GetX(0));
+         pGroup->ReadParams(m_pSwarm->GetB(0));
       }
    }/* end if(master) */
    /* ===============================================================================
@@ -286,27 +267,9 @@ void APPSO::Optimize(void)
    =============================================================================== */
    else
    {
-      NEW_PRINT("ParticleStruct", 1);
-      m_pSwarm = new ParticleStruct;
+      NEW_PRINT("SwarmKernel", 1);
+      m_pSwarm = new SwarmKernel(1, num, nSpecial);
       MEM_CHECK(m_pSwarm);
-
-      NEW_PRINT("double", num);
-      m_pSwarm->x = new double[num];
-
-      NEW_PRINT("double", num);
-      m_pSwarm->v = new double[num];
-
-      NEW_PRINT("double", num);
-      m_pSwarm->b = new double[num];
-
-      NEW_PRINT("double", nSpecial);
-      m_pSwarm->cb = new double[nSpecial];
-
-      NEW_PRINT("double", nSpecial);
-      m_pSwarm->cx = new double[nSpecial];
-
-      m_pSwarm->n = num;      
-      MEM_CHECK(m_pSwarm->b);
    }/* end else() */
 
    //evaluate swarm, asynchronously and in parallel
@@ -318,19 +281,8 @@ void APPSO::Optimize(void)
       m_pModel->Bookkeep(false);
 
       //assign initial best positions
-      for(i = 0; i < m_SwarmSize; i++)
-      {
-	      m_pSwarm[i].fb = m_pSwarm[i].fx;
-         for(int iSpecial = 0; iSpecial < nSpecial; iSpecial++)
-         {
-	         m_pSwarm[i].cb[iSpecial] = m_pSwarm[i].cx[iSpecial];
-         }
-         //sync best with current, in case parameter corrections were made
-         for(j = 0; j < num; j++)
-         {
-            m_pSwarm[i].b[j] =  m_pSwarm[i].x[j];
-         }
-      }
+      //sync best with current, in case parameter corrections were made
+      m_pSwarm->InitBest();
 
       /* --------------------------------------------
       enable special parameters now that local best 
@@ -338,24 +290,14 @@ void APPSO::Optimize(void)
       -------------------------------------------- */
       pGroup->EnableSpecialParams();
 
-      //determine the best particle and average value
+      //determine the best particle
       m_BestIdx = 0;
-      avg = 0.00;
-      m_Best = m_pSwarm[0].fb;
-      for(i = 0; i < m_SwarmSize; i++)
-      {
-         avg += m_pSwarm[i].fx;
-         if(m_Best > m_pSwarm[i].fx)
-         {
-            m_Best = m_pSwarm[i].fx;
-            m_BestIdx = i;
-         }/* end if() */
-      }/* end if() */
-      avg /= m_SwarmSize;
+      m_Best = m_pSwarm->GetFb(0);
+      m_pSwarm->UpdateBest(&m_BestIdx, &m_Best);
       median = CalcPSOMedian();
 
       //write initial config.
-      pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
+      pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
       WriteRecord(m_pModel, 0, m_Best, median);
       pStatus.curIter = 0;
       pStatus.maxIter = m_MaxGens;
@@ -371,85 +313,11 @@ void APPSO::Optimize(void)
       pStatus.curIter = m_CurGen = g+1;
       if(IsQuit() == true){ break;}
 
+      //update velocities and parameters
       if(id == 0)
       {
-         //update velocities, parameters and objective functions
-         for(i = 0; i < m_SwarmSize; i++) //for each particle
-         {
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               //intermediary variables
-               x = m_pSwarm[i].x[j];
-               pl = m_pSwarm[i].b[j];
-               pg = m_pSwarm[m_BestIdx].b[j];
-
-               //random weights
-               r1 = (double)MyRand() / (double)MY_RAND_MAX;
-               r2 = (double)MyRand() / (double)MY_RAND_MAX;
-
-               //revised velocity
-               v = m_pSwarm[i].v[j];
-               v = m_Constrict*((m_Inertia*v) + m_c1*r1*(pl-x) + m_c2*r2*(pg-x));
-
-   			   //assign minimum perturbation to prevent stagnation
-	   		   if(strcmp(pGroup->GetParamPtr(j)->GetType(), "real") == 0)
-		   		 vmin = (0.01*fabs(x))/(g+1); 
-			      else
-				    vmin = 0.50;
-
-               if(fabs(v) < vmin)
-               {
-                  //adjust randomized minimum velocity
-                  sgn = (double)MyRand() / (double)MY_RAND_MAX; //random direction
-                  if(sgn >= 0.50) v = +((1.00+r1)*vmin);
-                  else            v = -((1.00+r2)*vmin);
-               }
-               m_pSwarm[i].v[j] = v;
-            
-               //revised position
-               m_pSwarm[i].x[j] = x + v;
-            }/* end for() */
-
-            /*-----------------------------------------------------------
-            Constrain revised position to stay within parameter limits
-            but be sure to preserve angle (i.e. direction of movement)
-            -----------------------------------------------------------*/
-            double dx_min, dx_old, dx_new, dx_frac;
-            dx_min = 1.00;
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
-               upr = pGroup->GetParamPtr(j)->GetUprBnd();
-
-               v = m_pSwarm[i].v[j];
-               x = m_pSwarm[i].x[j] - v; //original position
-               //compute fractional move, store most restrictive fraction
-               if(m_pSwarm[i].x[j] > upr)
-               {
-                  dx_old = v;
-                  dx_new = 0.5*(upr-x);
-                  dx_frac = fabs(dx_new/dx_old); //relative change
-                  if(dx_frac < dx_min) dx_min = dx_frac;
-                  m_NumUprViols++;
-               }
-               if(m_pSwarm[i].x[j] < lwr)
-               {
-                  dx_old = v;
-                  dx_new = 0.5*(lwr-x);
-                  dx_frac = fabs(dx_new/dx_old); //relative change
-                  if(dx_frac < dx_min) dx_min = dx_frac;
-                  m_NumLwrViols++;
-               }
-            }/* end for() */
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               v = m_pSwarm[i].v[j];
-               x = m_pSwarm[i].x[j] - v; //original position      
-               m_pSwarm[i].v[j] *= dx_min; //revised velocity
-               m_pSwarm[i].x[j] = x + (v*dx_min); //revised position
-            }
-         }/* end for() */
-      } /* end if(master) */
+         m_pSwarm->Move(g, m_BestIdx, m_Constrict, m_Inertia, m_c1, m_c2);
+      }
 
       //evaluate swarm, possibly in parallel
       EvaluateSwarm(id, nprocs, g+1);
@@ -464,33 +332,12 @@ void APPSO::Optimize(void)
          }
          m_Inertia *= (1.00 - m_RedRate);
   
-         //revise avg, and local and global best
-         avg = 0.00;
-         for(i = 0; i < m_SwarmSize; i++)
-         {
-            avg += m_pSwarm[i].fx;
-            //revise local best
-            if(m_pSwarm[i].fx < m_pSwarm[i].fb)
-            {
-               for(j = 0; j < num; j++){ m_pSwarm[i].b[j] = m_pSwarm[i].x[j];}
-               m_pSwarm[i].fb = m_pSwarm[i].fx;
-               for(int iSpecial = 0; iSpecial < nSpecial; iSpecial++)
-               {
-			         m_pSwarm[i].cb[iSpecial] = m_pSwarm[i].cx[iSpecial];
-               }
-            }/* end if() */
-            //revise global best
-            if(m_Best > m_pSwarm[i].fx)
-            {
-               m_Best = m_pSwarm[i].fx;
-               m_BestIdx = i;
-            }/* end if() */
-         }/* end for() */
+         //revise local and global best
+         m_pSwarm->UpdateBest(&m_BestIdx, &m_Best);
 
-         avg /= m_SwarmSize;
          median = CalcPSOMedian();
 
-         pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
+         pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
 
          if(id == 0){ WriteRecord(m_pModel, (g+1), m_Best, median);}
          pStatus.pct = ((float)100.00*(float)(g+1))/(float)m_MaxGens;
@@ -510,7 +357,7 @@ void APPSO::Optimize(void)
    if(id == 0)
    { 
       //place model at optimal prameter set
-      pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
+      pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
       m_pModel->Execute();
 
       WriteOptimal(m_pModel, m_Best);
@@ -545,8 +392,11 @@ void APPSO::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Initialization Method   : Random\n");
 
    //fprintf(pFile, "Total Evals             : %d\n", m_pModel->GetCounter());      
-   fprintf(pFile, "Upper Violations        : %d\n", m_NumUprViols);
-   fprintf(pFile, "Lower Violations        : %d\n", m_NumLwrViols);
+   if(m_pSwarm != NULL)
+   {
+      fprintf(pFile, "Upper Violations        : %d\n", m_pSwarm->GetNumUprViols());
+      fprintf(pFile, "Lower Violations        : %d\n", m_pSwarm->GetNumLwrViols());
+   }
 
    m_pModel->WriteMetrics(pFile);
 }/* end WriteMetrics() */
@@ -562,6 +412,7 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
    static double a = 0.00;
    int i, ii, signal, num, sid, num_recv, nstops, nSpecial, nslaves, nxtsid;
    double * f;
+   double fb;
    bool bDone = false;
    ParameterGroup * pGroup =  m_pModel->GetParamGroupPtr();
    bool bSynch = SynchReceives();
@@ -583,7 +434,7 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
       //adjust parameters using meta heuristics and expert judgement
       for(i = 0; i < m_SwarmSize; i++) 
       { 
-         MakeParameterCorrections(m_pSwarm[i].x, m_pSwarm[m_BestIdx].b, num, a);
+         MakeParameterCorrections(m_pSwarm->GetX(i), m_pSwarm->GetB(m_BestIdx), num, a);
          a += 1.00/(double)(m_SwarmSize*(m_MaxGens+1));
       }
 
@@ -596,9 +447,10 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
             // send work to slave
             signal = APPSO_DO_WORK;
             MPI_Send(&signal,1,MPI_INT,i,MPI_REQUEST_TAG,MPI_COMM_WORLD); 
-            MPI_Send(&(m_pSwarm[i-1].x[0]), num, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
-            MPI_Send(&(m_pSwarm[i-1].fb), 1, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
-            MPI_Send(&(m_pSwarm[i-1].cb[0]), nSpecial, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
+            fb = m_pSwarm->GetFb(i-1);
+            MPI_Send(m_pSwarm->GetX(i-1), num, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
+            MPI_Send(&fb, 1, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
+            MPI_Send(m_pSwarm->GetCb(i-1), nSpecial, MPI_DOUBLE, i, MPI_DATA_TAG, MPI_COMM_WORLD);
          }
          else
          {
@@ -636,11 +488,8 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
 
          WriteInnerEval(num_recv, m_SwarmSize, '.');
          ii = m_Assignments[sid];
-         m_pSwarm[ii].fx = f[0];
-         for(int iSpecial = 0; iSpecial < nSpecial; iSpecial++)
-         {
-   	      m_pSwarm[ii].cx[iSpecial] = f[1+iSpecial];
-         }
+         m_pSwarm->SetFx(ii, f[0]);
+         memcpy(m_pSwarm->GetCx(ii), &(f[1]), sizeof(double)*nSpecial);
 
          //assign more work
          if(i <= m_SwarmSize)
@@ -649,9 +498,10 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
             // send work to slave
             signal = APPSO_DO_WORK;
             MPI_Send(&signal,1,MPI_INT,sid,MPI_REQUEST_TAG,MPI_COMM_WORLD); 
-            MPI_Send(&(m_pSwarm[i-1].x[0]), num, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
-            MPI_Send(&(m_pSwarm[i-1].fb), 1, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
-            MPI_Send(&(m_pSwarm[i-1].cb[0]), nSpecial, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
+            fb = m_pSwarm->GetFb(i-1);
+            MPI_Send(m_pSwarm->GetX(i-1), num, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
+            MPI_Send(&fb, 1, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
+            MPI_Send(m_pSwarm->GetCb(i-1), nSpecial, MPI_DOUBLE, sid, MPI_DATA_TAG, MPI_COMM_WORLD);
             i++;
          }
          else // send stop work message to the slave
@@ -672,16 +522,17 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
          if(signal == APPSO_DO_WORK)
          {
             num_recv++;
-            MPI_Recv(&(m_pSwarm->x[0]), num, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
-            MPI_Recv(&(m_pSwarm->fb), 1, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
-            MPI_Recv(&(m_pSwarm->cb[0]), nSpecial, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
+            MPI_Recv(m_pSwarm->GetX(0), num, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
+            MPI_Recv(&fb, 1, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
+            MPI_Recv(m_pSwarm->GetCb(0), nSpecial, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
+            m_pSwarm->SetFb(0, fb);
             if(num_recv == 1)
             {
                pGroup->EnableSpecialParams();
             }
-            m_pModel->GetParamGroupPtr()->WriteParams(m_pSwarm->x);
+            m_pModel->GetParamGroupPtr()->WriteParams(m_pSwarm->GetX(0));
             //let special parameters know about local best
-	         pGroup->ConfigureSpecialParams(m_pSwarm->fb, m_pSwarm->cb);
+	         pGroup->ConfigureSpecialParams(m_pSwarm->GetFb(0), m_pSwarm->GetCb(0));
             f[0] = m_pModel->Execute();
             pGroup->GetSpecialConstraints(&(f[1]));
 
@@ -697,6 +548,12 @@ void APPSO::EvaluateSwarm(int id, int nprocs, int gen)
    //synch up processors
    MPI_Barrier(MPI_COMM_WORLD);
 
+   //share model runs with the surrogate engine of each processor
+   if(m_pModel->GetSurrogateEnginePtr() != NULL)
+   {
+      m_pModel->GetSurrogateEnginePtr()->Synchronize();
+   }
+
    delete [] f;
  } /* end EvaluateSwarm() */
 
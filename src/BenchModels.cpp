@@ -0,0 +1,367 @@
+/******************************************************************************
+File     : BenchModels.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Synthetic internal models used by the benchmark suite. See BenchModels.h for
+the list of models and the format of the input and output files.
+
+Version History
+10-19-26    lsm   Created
+******************************************************************************/
+#include <mpi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <thread>
+
+#include "BenchModels.h"
+
+#include "MemoryTracker.h"
+#include "Exception.h"
+#include "Utility.h"
+
+#ifndef M_PI
+  #define M_PI 3.14159265358979323846
+#endif
+
+//settings and decision variables of the current evaluation
+typedef struct BENCH_INPUT_STRUCT
+{
+   int variant;
+   int numObj;
+   int latencyMs;
+   int outputLines;
+   int numVars;
+   double * pX;
+}BenchInput;
+
+static long gBenchEvals = 0;
+static double gBenchModelSec = 0.00;
+static double gBenchPeakRSS = 0.00;
+
+/******************************************************************************
+BenchSampleMemory()
+
+Update the peak resident set size of the process.
+******************************************************************************/
+void BenchSampleMemory(void)
+{
+   double rss = GetMemUsage();
+   if(rss > gBenchPeakRSS) gBenchPeakRSS = rss;
+} /* end BenchSampleMemory() */
+
+/******************************************************************************
+BenchReadInput()
+
+Read settings and decision variables. Returns false if the input file could
+not be opened.
+******************************************************************************/
+static bool BenchReadInput(BenchInput * pIn)
+{
+   FILE * pFile;
+   char line[DEF_STR_SZ];
+   char name[DEF_STR_SZ];
+   double val;
+   int n;
+
+   pIn->variant = 1;
+   pIn->numObj = 3;
+   pIn->latencyMs = 10;
+   pIn->outputLines = 100000;
+   pIn->numVars = 0;
+   pIn->pX = NULL;
+
+   pFile = fopen(BENCH_IN_FILE, "r");
+   if(pFile == NULL)
+   {
+      LogError(ERR_FILE_IO, "Benchmark model : couldn't open input file");
+      return false;
+   }
+
+   //first pass counts the decision variables
+   n = 0;
+   while(fgets(line, DEF_STR_SZ, pFile) != NULL)
+   {
+      if(sscanf(line, "%s %lf", name, &val) != 2) continue;
+      if(strncmp(name, "Bench", 5) != 0) n++;
+   }
+   rewind(pFile);
+
+   NEW_PRINT("double", n + 1);
+   pIn->pX = new double[n + 1];
+   MEM_CHECK(pIn->pX);
+
+   while(fgets(line, DEF_STR_SZ, pFile) != NULL)
+   {
+      if(sscanf(line, "%s %lf", name, &val) != 2) continue;
+      if(strcmp(name, "BenchVariant") == 0) pIn->variant = (int)val;
+      else if(strcmp(name, "BenchNumObj") == 0) pIn->numObj = (int)val;
+      else if(strcmp(name, "BenchLatencyMs") == 0) pIn->latencyMs = (int)val;
+      else if(strcmp(name, "BenchOutputLines") == 0) pIn->outputLines = (int)val;
+      else if(strncmp(name, "Bench", 5) == 0) continue;
+      else if(pIn->numVars < n) pIn->pX[pIn->numVars++] = val;
+   }
+   fclose(pFile);
+   return true;
+} /* end BenchReadInput() */
+
+/******************************************************************************
+BenchBegin()
+
+Common start of each model: read the input and open the output file.
+******************************************************************************/
+static FILE * BenchBegin(BenchInput * pIn, double * pStart)
+{
+   FILE * pOut;
+
+   *pStart = GetElapsedTics();
+   if((gBenchEvals % BENCH_MEM_SAMPLE) == 0) BenchSampleMemory();
+   gBenchEvals++;
+
+   if(BenchReadInput(pIn) == false) return NULL;
+
+   pOut = fopen(BENCH_OUT_FILE, "w");
+   if(pOut == NULL)
+   {
+      LogError(ERR_FILE_IO, "Benchmark model : couldn't open output file");
+      delete [] pIn->pX;
+      return NULL;
+   }
+   return pOut;
+} /* end BenchBegin() */
+
+/******************************************************************************
+BenchEnd()
+
+Common end of each model.
+******************************************************************************/
+static int BenchEnd(BenchInput * pIn, FILE * pOut, double start)
+{
+   fclose(pOut);
+   delete [] pIn->pX;
+   gBenchModelSec += GetElapsedTics() - start;
+   return 0;
+} /* end BenchEnd() */
+
+/******************************************************************************
+RosenbrockModel()
+
+f(x) = sum{100*(x[i+1] - x[i]^2)^2 + (1 - x[i])^2}. The 2*(n-1) residuals are
+reported as well, so that the sum of squared residuals equals f(x).
+******************************************************************************/
+int RosenbrockModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, f, r1, r2;
+   int i;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   f = 0.00;
+   for(i = 0; i < in.numVars - 1; i++)
+   {
+      r1 = 10.00*(in.pX[i+1] - in.pX[i]*in.pX[i]);
+      r2 = 1.00 - in.pX[i];
+      f += r1*r1 + r2*r2;
+   }
+   fprintf(pOut, "F1 %.15E\n", f);
+   for(i = 0; i < in.numVars - 1; i++)
+   {
+      r1 = 10.00*(in.pX[i+1] - in.pX[i]*in.pX[i]);
+      r2 = 1.00 - in.pX[i];
+      fprintf(pOut, "R%d %.15E\n", 2*i + 1, r1);
+      fprintf(pOut, "R%d %.15E\n", 2*i + 2, r2);
+   }
+   return BenchEnd(&in, pOut, start);
+} /* end RosenbrockModel() */
+
+/******************************************************************************
+GriewankModel()
+
+f(x) = 1 + sum{x[i]^2}/4000 - prod{cos(x[i]/sqrt(i))}
+******************************************************************************/
+int GriewankModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, sum, prod;
+   int i;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   sum = 0.00;
+   prod = 1.00;
+   for(i = 0; i < in.numVars; i++)
+   {
+      sum += in.pX[i]*in.pX[i];
+      prod *= cos(in.pX[i] / sqrt((double)(i + 1)));
+   }
+   fprintf(pOut, "F1 %.15E\n", 1.00 + sum/4000.00 - prod);
+   return BenchEnd(&in, pOut, start);
+} /* end GriewankModel() */
+
+/******************************************************************************
+ZDTModel()
+
+ZDT1 (convex), ZDT2 (concave) or ZDT3 (disconnected) front, x in [0,1].
+******************************************************************************/
+int ZDTModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, f1, g, h;
+   int i;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   f1 = (in.numVars > 0) ? in.pX[0] : 0.00;
+   g = 0.00;
+   for(i = 1; i < in.numVars; i++) g += in.pX[i];
+   if(in.numVars > 1) g = 1.00 + 9.00*g/(double)(in.numVars - 1);
+   else g = 1.00;
+
+   if(in.variant == 2) h = 1.00 - (f1/g)*(f1/g);
+   else if(in.variant == 3) h = 1.00 - sqrt(f1/g) - (f1/g)*sin(10.00*M_PI*f1);
+   else h = 1.00 - sqrt(f1/g);
+
+   fprintf(pOut, "F1 %.15E\n", f1);
+   fprintf(pOut, "F2 %.15E\n", g*h);
+   return BenchEnd(&in, pOut, start);
+} /* end ZDTModel() */
+
+/******************************************************************************
+DTLZModel()
+
+DTLZ1 (linear front) or DTLZ2 (spherical front) with M objectives, x in [0,1].
+The last n - M + 1 variables are the distance variables.
+******************************************************************************/
+int DTLZModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, g, f, d;
+   int i, j, M, k;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   M = in.numObj;
+   if(M < 2) M = 2;
+   if(M > in.numVars) M = in.numVars;
+   k = in.numVars - M + 1;
+
+   g = 0.00;
+   for(i = in.numVars - k; i < in.numVars; i++)
+   {
+      d = in.pX[i] - 0.50;
+      if(in.variant == 1) g += d*d - cos(20.00*M_PI*d);
+      else g += d*d;
+   }
+   if(in.variant == 1) g = 100.00*((double)k + g);
+
+   for(j = 0; j < M; j++)
+   {
+      if(in.variant == 1)
+      {
+         f = 0.50*(1.00 + g);
+         for(i = 0; i < M - 1 - j; i++) f *= in.pX[i];
+         if(j > 0) f *= (1.00 - in.pX[M - 1 - j]);
+      }
+      else
+      {
+         f = 1.00 + g;
+         for(i = 0; i < M - 1 - j; i++) f *= cos(0.50*M_PI*in.pX[i]);
+         if(j > 0) f *= sin(0.50*M_PI*in.pX[M - 1 - j]);
+      }
+      fprintf(pOut, "F%d %.15E\n", j + 1, f);
+   }/* end for() */
+   return BenchEnd(&in, pOut, start);
+} /* end DTLZModel() */
+
+/******************************************************************************
+SleepModel()
+
+Sphere function, computed after a delay of BenchLatencyMs milliseconds.
+******************************************************************************/
+int SleepModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, f;
+   int i;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   if(in.latencyMs > 0)
+   {
+      std::this_thread::sleep_for(std::chrono::milliseconds(in.latencyMs));
+   }
+   f = 0.00;
+   for(i = 0; i < in.numVars; i++) f += in.pX[i]*in.pX[i];
+   fprintf(pOut, "F1 %.15E\n", f);
+   return BenchEnd(&in, pOut, start);
+} /* end SleepModel() */
+
+/******************************************************************************
+BigOutputModel()
+
+Sphere function, written after BenchOutputLines lines of filler so that
+response extraction has to scan a large file.
+******************************************************************************/
+int BigOutputModel(void)
+{
+   BenchInput in;
+   FILE * pOut;
+   double start, f;
+   int i;
+
+   pOut = BenchBegin(&in, &start);
+   if(pOut == NULL) return -1;
+
+   f = 0.00;
+   for(i = 0; i < in.numVars; i++) f += in.pX[i]*in.pX[i];
+   for(i = 0; i < in.outputLines; i++)
+   {
+      fprintf(pOut, "row %d %.6E %.6E %.6E\n", i, f*i, f + i, (double)i);
+   }
+   fprintf(pOut, "F1 %.15E\n", f);
+   return BenchEnd(&in, pOut, start);
+} /* end BigOutputModel() */
+
+/******************************************************************************
+BenchWriteReport()
+
+Write the benchmark measurements of this processor to OstBench<rank>.txt, one
+"name value" pair per line.
+******************************************************************************/
+void BenchWriteReport(double startup, double run)
+{
+   FILE * pFile;
+   char name[DEF_STR_SZ];
+   int rank;
+
+   BenchSampleMemory();
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   sprintf(name, "OstBench%d.txt", rank);
+   pFile = fopen(name, "w");
+   if(pFile == NULL)
+   {
+      LogError(ERR_FILE_IO, "Couldn't open benchmark report file");
+      return;
+   }
+   fprintf(pFile, "NumEvaluations %ld\n", gBenchEvals);
+   fprintf(pFile, "StartupSec %.6lf\n", startup);
+   fprintf(pFile, "RunSec %.6lf\n", run);
+   fprintf(pFile, "BenchModelSec %.6lf\n", gBenchModelSec);
+   fprintf(pFile, "PeakRSS_kB %.0lf\n", gBenchPeakRSS/1000.00);
+   fclose(pFile);
+} /* end BenchWriteReport() */
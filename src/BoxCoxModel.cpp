@@ -9,6 +9,7 @@ on the transformed and weighted residuals.
 
 Version History
 01-09-13    lsm   Created
+10-19-26    lsm   Added BoxCoxObjFunc()
 ******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
@@ -72,6 +73,24 @@ int BoxCoxModel(void)
    return (0);
 } /* end BoxCoxModel() */
 
+/******************************************************************************
+BoxCoxObjFunc()
+
+Computes the objective function of BoxCoxModel() in memory, for the Box-Cox 
+parameter lambda and the data pointed to by pData (a BoxCoxDataStruct).
+******************************************************************************/
+double BoxCoxObjFunc(double lambda, void * pData)
+{
+   BoxCoxDataStruct * pBox = (BoxCoxDataStruct *)pData;
+
+   for(int i = 0; i < pBox->n; i++)
+   {
+      pBox->r[i]=BoxCoxVal(pBox->x[i],pBox->w[i],lambda)-BoxCoxVal(pBox->y[i],pBox->w[i],lambda);
+   }/* end for() */
+
+   return -BoxCoxNPP(pBox->r, pBox->n);
+} /* end BoxCoxObjFunc() */
+
 
 /******************************************************************************
 BoxCoxVal()
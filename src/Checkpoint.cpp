@@ -0,0 +1,491 @@
+/******************************************************************************
+File     : Checkpoint.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Binary checkpoint/restart of the state of an algorithm. See Checkpoint.h for
+details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   settings are reported as errors for unsupported algorithms
+                  and parallel runs (see CheckSettings()).
+10-19-26    lsm   the temporary file is synced to disk before it is renamed
+******************************************************************************/
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef GCC5X
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+#include "Checkpoint.h"
+#include "ModelABC.h"
+
+#include "Utility.h"
+#include "Exception.h"
+
+//byte-order mark, a checkpoint is not portable between architectures
+#define CKPT_BOM (0x01020304)
+
+/******************************************************************************
+ReadSettings()
+
+Read the checkpoint settings from the input file.
+******************************************************************************/
+void Checkpoint::ReadSettings(int * pEvals, double * pMinutes, bool * pResume)
+{
+   IroncladString pFileName = GetInFileName();
+   char tmp[DEF_STR_SZ], tmp2[DEF_STR_SZ];
+   char * line;
+   FILE * pFile;
+
+   *pEvals = 0;
+   *pMinutes = 0.00;
+   *pResume = false;
+
+   pFile = fopen(pFileName, "r");
+   if(pFile == NULL)
+   {
+      FileOpenFailure("Checkpoint::ReadSettings", pFileName);
+   }
+   if(CheckToken(pFile, "CheckpointEvals", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      sscanf(line, "%s %d", tmp, pEvals);
+   }
+   rewind(pFile);
+   if(CheckToken(pFile, "CheckpointMinutes", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      sscanf(line, "%s %lf", tmp, pMinutes);
+   }
+   rewind(pFile);
+   if(CheckToken(pFile, "ResumeFromCheckpoint", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      strcpy(tmp2, "no");
+      sscanf(line, "%s %s", tmp, tmp2);
+      MyStrLwr(tmp2);
+      *pResume = (strcmp(tmp2, "yes") == 0);
+   }
+   fclose(pFile);
+} /* end ReadSettings() */
+
+/******************************************************************************
+CheckSettings()
+
+Report checkpoint settings that will be ignored, because the program doesn't
+support checkpoints or the run is parallel.
+******************************************************************************/
+void Checkpoint::CheckSettings(ProgramType program)
+{
+   int evals, nprocs;
+   double minutes;
+   bool bResume;
+
+   ReadSettings(&evals, &minutes, &bResume);
+   if((evals <= 0) && (minutes <= 0.00) && (bResume == false))
+   {
+      return;
+   }
+
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   if(nprocs > 1)
+   {
+      LogError(ERR_BAD_ARGS, "Checkpoints are only supported in serial runs, ignoring checkpoint settings");
+      return;
+   }
+
+   switch(program)
+   {
+      case(DDS_PROGRAM) :
+      case(PSO_PROGRAM) :
+      case(GA_PROGRAM) :
+      case(BGA_PROGRAM) :
+      case(SCEUA_PROGRAM) :
+      {
+         break;
+      }
+      default :
+      {
+         LogError(ERR_BAD_ARGS, "Checkpoints are only supported by DDS, PSO, GA, BGA and SCEUA, ignoring checkpoint settings");
+         break;
+      }
+   }/* end switch() */
+} /* end CheckSettings() */
+
+/******************************************************************************
+CTOR
+
+Read the checkpoint settings from the input file.
+******************************************************************************/
+Checkpoint::Checkpoint(ModelABC * pModel, IroncladString pAlgName)
+{
+   int id, nprocs;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   m_pModel = pModel;
+   m_AlgName = pAlgName;
+   m_FileName = "OstCheckpoint" + std::to_string(id) + ".bin";
+   m_Files.push_back("OstOutput" + std::to_string(id) + ".txt");
+   m_Files.push_back("OstModel" + std::to_string(id) + ".txt");
+   m_Pos = 0;
+   m_bEnabled = false;
+   m_bResume = false;
+   m_EvalInterval = 0;
+   m_MinInterval = 0.00;
+   m_LastCount = 0;
+   m_LastTime = GetElapsedTics();
+   m_NumWritten = 0;
+   m_WriteTime = 0.00;
+
+   ReadSettings(&m_EvalInterval, &m_MinInterval, &m_bResume);
+
+   //parallel runs have been reported by CheckSettings()
+   m_bEnabled = ((m_EvalInterval > 0) || (m_MinInterval > 0.00));
+   if(nprocs > 1)
+   {
+      m_bEnabled = false;
+      m_bResume = false;
+   }
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+******************************************************************************/
+void Checkpoint::Destroy(void)
+{
+   m_Buf.clear();
+   m_Files.clear();
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+AddFile()
+
+Add an output file of the algorithm, which is truncated to its length at the
+time of the checkpoint when the run is resumed.
+******************************************************************************/
+void Checkpoint::AddFile(IroncladString pName)
+{
+   m_Files.push_back(pName);
+} /* end AddFile() */
+
+/******************************************************************************
+IsDue()
+
+Returns true if a checkpoint should be written, given the number of model
+evaluations and the time elapsed since the last checkpoint.
+******************************************************************************/
+bool Checkpoint::IsDue(void)
+{
+   if(m_bEnabled == false) return false;
+   if((m_EvalInterval > 0) && ((m_pModel->GetCounter() - m_LastCount) >= m_EvalInterval))
+   {
+      return true;
+   }
+   if((m_MinInterval > 0.00) && ((GetElapsedTics() - m_LastTime) >= 60.00*m_MinInterval))
+   {
+      return true;
+   }
+   return false;
+} /* end IsDue() */
+
+/******************************************************************************
+Put()
+
+Append raw bytes to the checkpoint.
+******************************************************************************/
+void Checkpoint::Put(const void * pData, size_t size)
+{
+   const char * pBytes = (const char *)pData;
+   m_Buf.insert(m_Buf.end(), pBytes, pBytes + size);
+} /* end Put() */
+
+/******************************************************************************
+Get()
+
+Extract raw bytes from the checkpoint.
+******************************************************************************/
+void Checkpoint::Get(void * pData, size_t size)
+{
+   if((m_Pos + size) > m_Buf.size()) Corrupt("unexpected end of file");
+   memcpy(pData, &(m_Buf[m_Pos]), size);
+   m_Pos += size;
+} /* end Get() */
+
+/******************************************************************************
+PutRecord()
+
+Append a typed record (type, count and values) to the checkpoint.
+******************************************************************************/
+void Checkpoint::PutRecord(char type, const void * pData, int n, size_t size)
+{
+   Put(&type, sizeof(char));
+   Put(&n, sizeof(int));
+   Put(pData, size*n);
+} /* end PutRecord() */
+
+/******************************************************************************
+GetRecord()
+
+Extract a typed record from the checkpoint. The type and count must match
+those of the record that was written.
+******************************************************************************/
+void Checkpoint::GetRecord(char type, void * pData, int n, size_t size)
+{
+   char t;
+   int num;
+
+   Get(&t, sizeof(char));
+   Get(&num, sizeof(int));
+   if((t != type) || (num != n)) Corrupt("record does not match the algorithm state");
+   Get(pData, size*n);
+} /* end GetRecord() */
+
+void Checkpoint::WriteInts(int * pVals, int n){ PutRecord('i', pVals, n, sizeof(int));}
+void Checkpoint::WriteDoubles(double * pVals, int n){ PutRecord('d', pVals, n, sizeof(double));}
+void Checkpoint::ReadInts(int * pVals, int n){ GetRecord('i', pVals, n, sizeof(int));}
+void Checkpoint::ReadDoubles(double * pVals, int n){ GetRecord('d', pVals, n, sizeof(double));}
+
+/******************************************************************************
+CalcChecksum()
+
+32-bit FNV-1a hash of the given bytes.
+******************************************************************************/
+unsigned int Checkpoint::CalcChecksum(const char * pData, size_t size)
+{
+   unsigned int h = 2166136261u;
+   size_t i;
+
+   for(i = 0; i < size; i++)
+   {
+      h ^= (unsigned char)pData[i];
+      h *= 16777619u;
+   }
+   return h;
+} /* end CalcChecksum() */
+
+/******************************************************************************
+Corrupt()
+
+Report an unusable checkpoint and exit.
+******************************************************************************/
+void Checkpoint::Corrupt(IroncladString pWhat)
+{
+   char msg[DEF_STR_SZ];
+   snprintf(msg, DEF_STR_SZ, "Unable to resume from %s: %s", m_FileName.c_str(), pWhat);
+   LogError(ERR_FILE_IO, msg);
+   ExitProgram(1);
+} /* end Corrupt() */
+
+/******************************************************************************
+Begin()
+
+Start a checkpoint: write the header, the state of the random number generator,
+the length of the output files and the state of the model. The algorithm then
+writes its state, followed by a call to End().
+******************************************************************************/
+void Checkpoint::Begin(void)
+{
+   unsigned int seed, index;
+   unsigned long long calls;
+   int i, n, bom, ver;
+   double len;
+
+   m_WriteTime = GetElapsedTics();
+   m_Buf.clear();
+
+   Put(CKPT_MAGIC, strlen(CKPT_MAGIC));
+   ver = CKPT_VERSION;
+   bom = CKPT_BOM;
+   Put(&ver, sizeof(int));
+   Put(&bom, sizeof(int));
+   n = (int)m_AlgName.size();
+   Put(&n, sizeof(int));
+   Put(m_AlgName.data(), n);
+
+   GetRandomState(&seed, &calls, &index);
+   Put(&seed, sizeof(unsigned int));
+   Put(&calls, sizeof(unsigned long long));
+   Put(&index, sizeof(unsigned int));
+
+   n = (int)m_Files.size();
+   WriteInt(n);
+   for(i = 0; i < n; i++)
+   {
+      len = fs::exists(m_Files[i]) ? (double)fs::file_size(m_Files[i]) : 0.00;
+      WriteDouble(len);
+   }
+
+   m_pModel->WriteCheckpoint(this);
+} /* end Begin() */
+
+/******************************************************************************
+End()
+
+Finish a checkpoint: append the checksum, write the checkpoint to a temporary
+file and replace the previous checkpoint with it.
+******************************************************************************/
+void Checkpoint::End(void)
+{
+   unsigned int sum;
+   std::string tmpName;
+   FILE * pFile;
+   size_t size;
+   int synced;
+#ifdef GCC5X
+   boost::system::error_code ec;
+#else
+   std::error_code ec;
+#endif
+
+   sum = CalcChecksum(m_Buf.data(), m_Buf.size());
+   Put(&sum, sizeof(unsigned int));
+
+   tmpName = m_FileName + ".tmp";
+   pFile = fopen(tmpName.c_str(), "wb");
+   if(pFile == NULL)
+   {
+      LogError(ERR_FILE_IO, "Unable to write checkpoint");
+      return;
+   }
+   size = fwrite(m_Buf.data(), 1, m_Buf.size(), pFile);
+
+   //contents must be on disk before the rename, or a crash could leave a
+   //truncated checkpoint under the final name
+   synced = fflush(pFile);
+#ifdef _WIN32
+   if(synced == 0) synced = _commit(_fileno(pFile));
+#else
+   if(synced == 0) synced = fsync(fileno(pFile));
+#endif
+   fclose(pFile);
+   if((size != m_Buf.size()) || (synced != 0))
+   {
+      LogError(ERR_FILE_IO, "Unable to write checkpoint");
+      remove(tmpName.c_str());
+      return;
+   }
+   fs::rename(tmpName, m_FileName, ec);
+   if(ec)
+   {
+      LogError(ERR_FILE_IO, "Unable to replace checkpoint");
+      return;
+   }
+
+   m_Buf.clear();
+   m_NumWritten++;
+   m_LastCount = m_pModel->GetCounter();
+   m_LastTime = GetElapsedTics();
+   m_WriteTime = m_LastTime - m_WriteTime;
+} /* end End() */
+
+/******************************************************************************
+Resume()
+
+If requested, read the checkpoint and restore the state of the random number
+generator, the output files and the model. Returns true if the algorithm must
+then read its state (in the order in which it was written), or false if the
+run is not being resumed.
+******************************************************************************/
+bool Checkpoint::Resume(void)
+{
+   unsigned int seed, index, sum;
+   unsigned long long calls;
+   int i, n, bom, ver;
+   double len;
+   char magic[DEF_STR_SZ];
+   std::string name;
+   FILE * pFile;
+   long size;
+
+   if(m_bResume == false) return false;
+   m_bResume = false;
+
+   pFile = fopen(m_FileName.c_str(), "rb");
+   if(pFile == NULL)
+   {
+      LogError(ERR_FILE_IO, "No checkpoint found, starting a new run");
+      return false;
+   }
+   fseek(pFile, 0, SEEK_END);
+   size = ftell(pFile);
+   rewind(pFile);
+   m_Buf.resize(size);
+   if(fread(m_Buf.data(), 1, size, pFile) != (size_t)size)
+   {
+      fclose(pFile);
+      Corrupt("read error");
+   }
+   fclose(pFile);
+
+   //validate
+   if(m_Buf.size() < sizeof(unsigned int)) Corrupt("file is truncated");
+   memcpy(&sum, &(m_Buf[m_Buf.size() - sizeof(unsigned int)]), sizeof(unsigned int));
+   m_Buf.resize(m_Buf.size() - sizeof(unsigned int));
+   if(CalcChecksum(m_Buf.data(), m_Buf.size()) != sum) Corrupt("checksum mismatch");
+
+   m_Pos = 0;
+   n = (int)strlen(CKPT_MAGIC);
+   Get(magic, n);
+   magic[n] = NULLSTR;
+   if(strcmp(magic, CKPT_MAGIC) != 0) Corrupt("not a checkpoint file");
+   Get(&ver, sizeof(int));
+   Get(&bom, sizeof(int));
+   if(ver != CKPT_VERSION) Corrupt("unsupported checkpoint version");
+   if(bom != CKPT_BOM) Corrupt("checkpoint was written on a different architecture");
+   Get(&n, sizeof(int));
+   if((n < 0) || ((size_t)n > (m_Buf.size() - m_Pos))) Corrupt("bad algorithm name");
+   name.assign(&(m_Buf[m_Pos]), n);
+   m_Pos += n;
+   if(name != m_AlgName) Corrupt("checkpoint was written by a different algorithm");
+
+   //restore random number generator
+   Get(&seed, sizeof(unsigned int));
+   Get(&calls, sizeof(unsigned long long));
+   Get(&index, sizeof(unsigned int));
+   SetRandomState(seed, calls, index);
+
+   //discard output written after the checkpoint
+   n = ReadInt();
+   if(n != (int)m_Files.size()) Corrupt("list of output files does not match");
+   for(i = 0; i < n; i++)
+   {
+      len = ReadDouble();
+      if(fs::exists(m_Files[i]) && ((double)fs::file_size(m_Files[i]) > len))
+      {
+         fs::resize_file(m_Files[i], (uintmax_t)len);
+      }
+   }
+
+   m_pModel->ReadCheckpoint(this);
+
+   m_LastCount = m_pModel->GetCounter();
+   m_LastTime = GetElapsedTics();
+   return true;
+} /* end Resume() */
+
+/******************************************************************************
+WriteMetrics()
+******************************************************************************/
+void Checkpoint::WriteMetrics(FILE * pFile)
+{
+   if(m_bEnabled == false) return;
+   fprintf(pFile, "Checkpoints Written     : %d\n", m_NumWritten);
+   fprintf(pFile, "Checkpoint File         : %s\n", m_FileName.c_str());
+} /* end WriteMetrics() */
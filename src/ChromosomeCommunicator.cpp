@@ -16,6 +16,11 @@ Version History
 08-17-04    lsm   RAM fragmentation fixes
 10-19-04    lsm   Added support for binary coded GA
 01-01-07    lsm   Algorithm uses abstract model base class (ModelABC).
+10-19-26    lsm   Added access to the model's parameter initializer.
+10-19-26    lsm   Fitness evaluation and parameter corrections work on the 
+                  decoded genes of a chromosome.
+10-19-26    lsm   Added access to the model's surrogate engine.
+10-19-26    lsm   Added WriteCheckpoint() and ReadCheckpoint().
 ******************************************************************************/
 #include <stdio.h>
 #include <math.h>
@@ -24,6 +29,7 @@ Version History
 #include "Chromosome.h"
 #include "ModelABC.h"
 #include "ModelBackup.h"
+#include "Checkpoint.h"
 #include "Gene.h"
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
@@ -39,6 +45,22 @@ ParameterGroup * ModelChromoComm::GetParamGroupPtr(void)
 	return  m_pModel->GetParamGroupPtr(); 
 }/* end GetParamGroupPtr() */
 
+/******************************************************************************
+GetParamInitializerPtr()
+******************************************************************************/
+ParamInitializerABC * ModelChromoComm::GetParamInitializerPtr(void)
+{
+	return  m_pModel->GetParamInitializerPtr(); 
+}/* end GetParamInitializerPtr() */
+
+/******************************************************************************
+GetSurrogateEnginePtr()
+******************************************************************************/
+SurrogateEngine * ModelChromoComm::GetSurrogateEnginePtr(void)
+{
+	return  m_pModel->GetSurrogateEnginePtr(); 
+}/* end GetSurrogateEnginePtr() */
+
 /******************************************************************************
 CTOR
 
@@ -48,6 +70,7 @@ ModelChromoComm::ModelChromoComm(ModelABC * pModel)
 {
    m_pModel = pModel;
    m_xb = NULL;
+   m_BudgetFrac = 0.00;
    IncCtorCount();
 }/* end CTOR */
 
@@ -63,20 +86,17 @@ void ModelChromoComm::Destroy(void)
 /******************************************************************************
 EvalFitness()
 
-Evaluates the fitness of a chromosme and stores the result in the chromosomes
-fitness variable.
+Evaluates the fitness of a chromosome, given its decoded genes (one per 
+parameter), and returns the result.
 ******************************************************************************/
-void ModelChromoComm::EvalFitness(Chromosome * pChromo)
+double ModelChromoComm::EvalFitness(double * pGenes)
 {   
    static double fbest = HUGE_VAL;
-   double fitness, val;
-   Gene * pGene;
+   double fitness;
    ParameterGroup * pParamGroup;
-   ParameterABC * pParam;
-   int i, numGenes, numParams;
+   int i, numParams;
 
    pParamGroup = m_pModel->GetParamGroupPtr();
-   numGenes = pChromo->GetNumGenes();
    numParams = pParamGroup->GetNumParams();
 
   if(m_xb == NULL)
@@ -85,19 +105,9 @@ void ModelChromoComm::EvalFitness(Chromosome * pChromo)
      pParamGroup->ReadParams(m_xb);
   }
 
-   //sanity check (should have same number of genes as parameters)
-   if(numParams != numGenes)
-   {
-      LogError(ERR_MISMATCH, "Number of genes != Number of parameters");
-      ExitProgram(1);
-   }/* end if() */
-
-   for(i = 0; i < numGenes; i++)
+   for(i = 0; i < numParams; i++)
    {      
-      pGene = pChromo->GetGenePtr(i);
-      pParam = pParamGroup->GetParamPtr(i);
-      val = pGene->GetValue();
-      pParam->SetEstVal(val);      
+      pParamGroup->GetParamPtr(i)->SetEstVal(pGenes[i]);      
    }/* end for() */
 
    fitness = -1.00 * m_pModel->Execute();
@@ -107,25 +117,22 @@ void ModelChromoComm::EvalFitness(Chromosome * pChromo)
       fbest = -fitness;
       pParamGroup->ReadParams(m_xb);
    }
-   pChromo->SetFitness(fitness);
+   return fitness;
 } /* end EvalFitness() */
 
 /******************************************************************************
 MakeParameterCorrections()
 
-Corrects the genes in a chromosme according to expert rules.
+Corrects the decoded genes of a chromosme according to expert rules.
 ******************************************************************************/
-void ModelChromoComm::MakeParameterCorrections(Chromosome * pChromo)
+void ModelChromoComm::MakeParameterCorrections(double * pGenes)
 {   
-   static double a = 0.00;
-   double val, lwr, upr;
-   Gene * pGene;
+   double lwr, upr;
    ParameterGroup * pParamGroup;
    ParameterABC * pParam;
-   int i, numGenes, numParams;
+   int i, numParams;
 
    pParamGroup = m_pModel->GetParamGroupPtr();
-   numGenes = pChromo->GetNumGenes();
    numParams = pParamGroup->GetNumParams();
 
   if(m_xb == NULL)
@@ -134,38 +141,61 @@ void ModelChromoComm::MakeParameterCorrections(Chromosome * pChromo)
      pParamGroup->ReadParams(m_xb);
   }
 
-   //sanity check (should have same number of genes as parameters)
-   if(numParams != numGenes)
-   {
-      LogError(ERR_MISMATCH, "Number of genes != Number of parameters");
-      ExitProgram(1);
-   }/* end if() */
-
-   for(i = 0; i < numGenes; i++)
+   for(i = 0; i < numParams; i++)
    {      
-      pGene = pChromo->GetGenePtr(i);
       pParam = pParamGroup->GetParamPtr(i);
       lwr=pParam->GetLwrBnd();
       upr=pParam->GetUprBnd();
-      val = pGene->GetValue();
-      val = TelescopicCorrection(lwr, upr, m_xb[i], a, val);
-      pGene->SetValue(val);
-      pParam->SetEstVal(val);      
+      pGenes[i] = TelescopicCorrection(lwr, upr, m_xb[i], m_BudgetFrac, pGenes[i]);
+      pParam->SetEstVal(pGenes[i]);      
    }/* end for() */
 
    //inerface with expert judgement module
    m_pModel->PerformParameterCorrections();
-   for(i = 0; i < numGenes; i++)
+   for(i = 0; i < numParams; i++)
    {
-      pGene = pChromo->GetGenePtr(i);
-      pParam = pParamGroup->GetParamPtr(i);
-      val = pParam->GetEstVal();
-      pGene->SetValue(val);
+      pGenes[i] = pParamGroup->GetParamPtr(i)->GetEstVal();
    }/* end for() */
 
-   a += 1.00/(double)m_MaxEvals;
+   m_BudgetFrac += 1.00/(double)m_MaxEvals;
 } /* end MakeParameterCorrections() */
 
+/******************************************************************************
+WriteCheckpoint()
+
+Save the state of the parameter corrections.
+******************************************************************************/
+void ModelChromoComm::WriteCheckpoint(Checkpoint * pCkpt)
+{
+   int n = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   pCkpt->WriteDouble(m_BudgetFrac);
+   pCkpt->WriteInt((m_xb != NULL) ? 1 : 0);
+   if(m_xb != NULL) pCkpt->WriteDoubles(m_xb, n);
+} /* end WriteCheckpoint() */
+
+/******************************************************************************
+ReadCheckpoint()
+
+Restore the state of the parameter corrections.
+******************************************************************************/
+void ModelChromoComm::ReadCheckpoint(Checkpoint * pCkpt)
+{
+   int n = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   m_BudgetFrac = pCkpt->ReadDouble();
+   if(pCkpt->ReadInt() == 1)
+   {
+      if(m_xb == NULL)
+      {
+         NEW_PRINT("double", n);
+         m_xb = new double[n];
+         MEM_CHECK(m_xb);
+      }
+      pCkpt->ReadDoubles(m_xb, n);
+   }
+} /* end ReadCheckpoint() */
+
 /******************************************************************************
 CreateProto()
 
@@ -253,4 +283,23 @@ ParameterGroup * ModelChromoComm::ConvertChromosome(Chromosome * pChromo)
    return pGroup;
 }/* end ConvertChromosome() */
 
+/******************************************************************************
+ConvertGenes()
+
+Uses the supplied decoded genes to return the resulting parameter group.
+******************************************************************************/
+ParameterGroup * ModelChromoComm::ConvertGenes(double * pGenes)
+{
+   ParameterGroup * pGroup;
+   int i;
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   for(i = 0; i < pGroup->GetNumParams(); i++)
+   {
+      pGroup->GetParamPtr(i)->SetEstVal(pGenes[i]);
+   }/* end for() */
+
+   return pGroup;
+}/* end ConvertGenes() */
+
 
@@ -25,12 +25,25 @@ Version History
                      InitPopulationMethod LHS
 07-16-07    lsm   Aglorithm now supports SuperMUSE
 01-13-15    lsm   Added support for asynchrounous parallel
+10-19-26    lsm   Initial population can be seeded by the model's parameter
+                  initializer (e.g. 'ParamInitializer sobol').
+10-19-26    lsm   Population evaluation is timed by the evaluation profiler.
+10-19-26    lsm   Population is stored as a flat genome matrix (real-coded or
+                  binary-coded) and the GA operators work on its rows, with
+                  double buffering instead of copying back a scratch pool. 
+                  Elites are found with a partial sort. Added SBX crossover.
+10-19-26    lsm   Real-coded offspring are pre-screened with the surrogate 
+                  engine, if any, and parallel model runs are shared with all
+                  processors.
+10-19-26    lsm   Added WriteCheckpoint() and ReadCheckpoint().
+10-19-26    lsm   Model runs are only kept for sharing if the pool evaluates them.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <algorithm>
 
 #include "ChromosomePool.h"
 #include "Chromosome.h"
@@ -40,7 +53,11 @@ Version History
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
 #include "LatinHypercube.h"
+#include "ParamInitializerABC.h"
 #include "SuperMUSE.h"
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
+#include "Profiler.h"
 
 #include "Exception.h"
 #include "WriteUtility.h"
@@ -59,8 +76,28 @@ chromosome.
 ******************************************************************************/
 ChromosomePool::ChromosomePool(void)
 {
-   m_pPool     = NULL;
-   m_pScratch  = NULL;
+   m_pGenes = NULL;
+   m_pNxtGenes = NULL;
+   m_pCodes = NULL;
+   m_pNxtCodes = NULL;
+   m_pFitness = NULL;
+   m_pNxtFitness = NULL;
+   m_pLwr = NULL;
+   m_pUpr = NULL;
+   m_pOffset = NULL;
+   m_pRange = NULL;
+   m_pNumBits = NULL;
+   m_pRow = NULL;
+   m_pCandGenes = NULL;
+   m_pCandMuts = NULL;
+   m_pRank = NULL;
+   m_pBest = NULL;
+   m_NumGenes = 0;
+   m_bBinary = false;
+   m_MutRate = 0.05;
+   m_XoverRate = 0.5;
+   m_XoverType = GA_XOVER_BLEND;
+   m_SbxIndex = 15.00;
    m_Fmedian = NULL;
    m_Proto = NULL;
    m_pInit = NULL;
@@ -78,7 +115,6 @@ ChromosomePool::ChromosomePool(void)
    m_pMyBuf  = NULL;
    m_pTmpBuf = NULL;
    m_pBigBuf = NULL;
-   m_pBuf    = NULL;
 
    m_pMutCount = NULL;
 
@@ -94,14 +130,22 @@ void ChromosomePool::Destroy(void)
 {
    int i;
 
-   for(i = 0; i < m_PoolSize; i++) 
-   {
-      if(m_pPool != NULL) 
-         delete m_pPool[i];
-      if(m_pScratch != NULL)  
-         delete m_pScratch[i];
-   }
-   delete [] m_pPool;
+   delete [] m_pGenes;
+   delete [] m_pNxtGenes;
+   delete [] m_pCodes;
+   delete [] m_pNxtCodes;
+   delete [] m_pFitness;
+   delete [] m_pNxtFitness;
+   delete [] m_pLwr;
+   delete [] m_pUpr;
+   delete [] m_pOffset;
+   delete [] m_pRange;
+   delete [] m_pNumBits;
+   delete [] m_pRow;
+   delete [] m_pCandGenes;
+   delete [] m_pCandMuts;
+   delete [] m_pRank;
+   delete m_pBest;
    delete [] m_pTrees;
 
    for(i = 0; i < m_NumInit; i++) 
@@ -115,13 +159,194 @@ void ChromosomePool::Destroy(void)
    delete [] m_pBigBuf;
    delete [] m_pTmpBuf;
    delete [] m_pMyBuf; 
-   delete [] m_pBuf;  
    delete [] m_pMutCount;
    delete [] m_Fmedian;
    delete [] m_pAssignments;
    IncDtorCount();
 }/* end Destroy() */
 
+/******************************************************************************
+GenomeBitMask()
+
+Mask that keeps the lowest 'nbits' bits of a binary-coded gene (same as
+BinaryEncodedGene::CalcBitMask()).
+******************************************************************************/
+static int GenomeBitMask(int nbits)
+{
+   if(nbits >= 32) return ~0;
+   return (int)((1u << nbits) - 1u);
+}/* end GenomeBitMask() */
+
+/******************************************************************************
+AllocGenome()
+
+Allocate the genome matrices and take the coding of each gene (bounds, bits
+and rates) from the prototype chromosome.
+******************************************************************************/
+void ChromosomePool::AllocGenome(void)
+{
+   BinaryEncodedGene * pBinary;
+   Gene * pGene;
+   int i, j, size;
+
+   m_NumGenes = m_Proto->GetNumGenes();
+   size = m_PoolSize*m_NumGenes;
+   pBinary = dynamic_cast<BinaryEncodedGene *>(m_Proto->GetGenePtr(0));
+   m_bBinary = (pBinary != NULL);
+
+   NEW_PRINT("double", m_NumGenes);
+   m_pLwr = new double[m_NumGenes];
+   MEM_CHECK(m_pLwr);
+   NEW_PRINT("double", m_NumGenes);
+   m_pUpr = new double[m_NumGenes];
+   MEM_CHECK(m_pUpr);
+   NEW_PRINT("int", m_NumGenes);
+   m_pOffset = new int[m_NumGenes];
+   MEM_CHECK(m_pOffset);
+   NEW_PRINT("int", m_NumGenes);
+   m_pRange = new int[m_NumGenes];
+   MEM_CHECK(m_pRange);
+   NEW_PRINT("int", m_NumGenes);
+   m_pNumBits = new int[m_NumGenes];
+   MEM_CHECK(m_pNumBits);
+   NEW_PRINT("double", m_NumGenes);
+   m_pRow = new double[m_NumGenes];
+   MEM_CHECK(m_pRow);
+
+   for(j = 0; j < m_NumGenes; j++)
+   {
+      pGene = m_Proto->GetGenePtr(j);
+      m_pLwr[j] = pGene->GetLwr();
+      m_pUpr[j] = pGene->GetUpr();
+      m_pOffset[j] = (int)m_pLwr[j];
+      m_pRange[j] = (int)(m_pUpr[j] - m_pLwr[j]);
+      //bits required to represent the full range
+      for(i = 0; i <= 32; i++)
+      {
+         if((int)(pow((double)2,i)) > m_pRange[j]) break;
+      }
+      m_pNumBits[j] = i;
+   }/* end for() */
+   m_MutRate = m_Proto->GetGenePtr(0)->GetMutationRate();
+   m_XoverRate = m_Proto->GetGenePtr(0)->GetCrossoverRate();
+
+   if(m_bBinary == true)
+   {
+      NEW_PRINT("int", size);
+      m_pCodes = new int[size];
+      MEM_CHECK(m_pCodes);
+      NEW_PRINT("int", size);
+      m_pNxtCodes = new int[size];
+      MEM_CHECK(m_pNxtCodes);
+   }
+   else
+   {
+      NEW_PRINT("double", size);
+      m_pGenes = new double[size];
+      MEM_CHECK(m_pGenes);
+      NEW_PRINT("double", size);
+      m_pNxtGenes = new double[size];
+      MEM_CHECK(m_pNxtGenes);
+   }
+
+   NEW_PRINT("double", m_PoolSize);
+   m_pFitness = new double[m_PoolSize];
+   MEM_CHECK(m_pFitness);
+   NEW_PRINT("double", m_PoolSize);
+   m_pNxtFitness = new double[m_PoolSize];
+   MEM_CHECK(m_pNxtFitness);
+   NEW_PRINT("int", m_PoolSize);
+   m_pRank = new int[m_PoolSize];
+   MEM_CHECK(m_pRank);
+   for(i = 0; i < m_PoolSize; i++){ m_pFitness[i] = m_pNxtFitness[i] = 0.00;}
+
+   m_pBest = m_Proto->CreateChromo(m_pLwr);
+}/* end AllocGenome() */
+
+/******************************************************************************
+GetGenes()
+
+Retrieve the (decoded) genes of the ith chromosome. For real-coded genes this
+is the row of the genome matrix itself, binary-coded genes are decoded into a
+buffer that is overwritten by the next call.
+******************************************************************************/
+double * ChromosomePool::GetGenes(int i)
+{
+   int j;
+   int * pCode;
+
+   if(m_bBinary == false) return &(m_pGenes[i*m_NumGenes]);
+
+   pCode = &(m_pCodes[i*m_NumGenes]);
+   for(j = 0; j < m_NumGenes; j++)
+   {
+      m_pRow[j] = (double)(pCode[j] + m_pOffset[j]);
+   }
+   return m_pRow;
+}/* end GetGenes() */
+
+/******************************************************************************
+SetGenes()
+
+Assign (and encode) the genes of the ith chromosome.
+******************************************************************************/
+void ChromosomePool::SetGenes(int i, double * pVals)
+{
+   int j;
+   double * pX;
+   int * pCode;
+
+   if(m_bBinary == false)
+   {
+      pX = &(m_pGenes[i*m_NumGenes]);
+      if(pX == pVals) return;
+      for(j = 0; j < m_NumGenes; j++){ pX[j] = pVals[j];}
+      return;
+   }
+
+   pCode = &(m_pCodes[i*m_NumGenes]);
+   for(j = 0; j < m_NumGenes; j++)
+   {
+      pCode[j] = ((int)(pVals[j] - m_pOffset[j])) & GenomeBitMask(m_pNumBits[j]);
+   }
+}/* end SetGenes() */
+
+/******************************************************************************
+CopyToNxtGen()
+
+Copy the src-th chromosome of the current generation into the dst-th row of
+the next generation.
+******************************************************************************/
+void ChromosomePool::CopyToNxtGen(int dst, int src)
+{
+   if(m_bBinary == true)
+   {
+      memcpy(&(m_pNxtCodes[dst*m_NumGenes]), &(m_pCodes[src*m_NumGenes]),
+             m_NumGenes*sizeof(int));
+   }
+   else
+   {
+      memcpy(&(m_pNxtGenes[dst*m_NumGenes]), &(m_pGenes[src*m_NumGenes]),
+             m_NumGenes*sizeof(double));
+   }
+   m_pNxtFitness[dst] = m_pFitness[src];
+}/* end CopyToNxtGen() */
+
+/******************************************************************************
+SwapGenerations()
+
+Make the next generation the current one.
+******************************************************************************/
+void ChromosomePool::SwapGenerations(void)
+{
+   double * pTmp;
+   int * pTmpCodes;
+
+   pTmp = m_pGenes; m_pGenes = m_pNxtGenes; m_pNxtGenes = pTmp;
+   pTmpCodes = m_pCodes; m_pCodes = m_pNxtCodes; m_pNxtCodes = pTmpCodes;
+   pTmp = m_pFitness; m_pFitness = m_pNxtFitness; m_pNxtFitness = pTmp;
+}/* end SwapGenerations() */
+
 /******************************************************************************
 TourneySelection()
 
@@ -140,79 +365,47 @@ void ChromosomePool::TourneySelection(int nCombatants)
    int i, j; 
    int r1;
    int r2;
-   Chromosome * pPlay1; //player one of tournament
-   Chromosome * pPlay2; //player two of tournament
-   Chromosome * pMax;   //chromosome with max. fitness
-   double fit1;
-   double fit2;
-   double maxFit;
-   double lastMax;
+   int nElite;
+   double * pFit = m_pFitness;
 
    /*-------------------------------------------
    Reserve the top m_NumSurvivors chromosomes. 
+   Only the elites need to be sorted.
    --------------------------------------------*/
-   lastMax = NEARLY_HUGE;
-   pMax = NULL;
-   for(i = 0; i < m_NumSurvivors; i++)
+   nElite = m_NumSurvivors;
+   if(nElite > m_PoolSize) nElite = m_PoolSize;
+   for(i = 0; i < m_PoolSize; i++){ m_pRank[i] = i;}
+   std::partial_sort(m_pRank, m_pRank + nElite, m_pRank + m_PoolSize,
+      [pFit](int a, int b){ return ((pFit[a] > pFit[b]) || ((pFit[a] == pFit[b]) && (a < b)));});
+
+   //propagate elites to next generation
+   for(i = 0; i < nElite; i++)
    {
-      maxFit = -NEARLY_HUGE;
-
-      for(j = 0; j < m_PoolSize; j++)
-      {
-         pPlay1 = m_pPool[j];
-         fit1 = pPlay1->GetFitness();
-
-         if((fit1 > maxFit) && (fit1 <= lastMax) && (pMax != pPlay1))
-         {
-            pMax = pPlay1;
-            maxFit = fit1;
-         }/* end if() */
-      }/* end for() */      
-
-      //propagate nth max. to next generation
-      lastMax = maxFit;
-      m_pScratch[i]->Copy(pMax);
-      //printf("Max. #%d = %E\n", i, lastMax);
+      CopyToNxtGen(i, m_pRank[i]);
    }/* end for() */
 
    /*-------------------------------------------
    Use n-member tourney to select the remaining 
    chromosomes.
    --------------------------------------------*/
-   for(i = m_NumSurvivors; i < m_PoolSize;i++)
+   for(i = nElite; i < m_PoolSize; i++)
    {
       // pick random chromosomes 
       r1 = MyRand() % m_PoolSize;
-      pPlay1 = m_pPool[r1];
-      fit1 = pPlay1->GetFitness();
 
       for(j = 0; j < (nCombatants - 1); j++)
       {
          r2 = MyRand() % m_PoolSize;
-         pPlay2 = m_pPool[r2];
-
-         //evaluate their fitness
-         fit2 = pPlay2->GetFitness();
 
          //the better one gets to go to the nextGeneration
-         if (fit2>fit1)
-         {
-            pPlay1 = pPlay2;
-            fit1 = fit2;
-         }
+         if(pFit[r2] > pFit[r1]) r1 = r2;
       }
    
-      m_pScratch[i]->Copy(pPlay1); 
+      CopyToNxtGen(i, r1);
    } /* end for() */
 
-   /*------------------------------
-   copy the latest generation from
-   scratch into the chromsome pool.
-   -------------------------------*/
-   for(i = 0; i < m_PoolSize; i++) 
-   {       
-      m_pPool[i]->Copy(m_pScratch[i]);
-   }/* end for() */
+   //the next generation becomes the current one
+   SwapGenerations();
 } /* end TourneySelection() */
 
 /******************************************************************************
@@ -223,34 +416,150 @@ population, except those that are in the top <m_NumSurvivors>.
 ******************************************************************************/  
 void ChromosomePool::Crossover(void)
 {   
-   int i;
-   Chromosome * pFirst;
-   Chromosome * pMom;
-   Chromosome * pPop;
+   int i, n;
+
+   if(m_NumSurvivors >= m_PoolSize) return;
+   n = m_NumGenes;
 
-   //save first for later
-   pMom   = m_pPool[m_NumSurvivors];
-   m_pScratch[0]->Copy(pMom);
-   pFirst = m_pScratch[0];
+   /*--------------------------------------------
+   Save first for later, the next generation
+   matrix is unused until the next selection.
+   --------------------------------------------*/
+   CopyToNxtGen(0, m_NumSurvivors);
 
    //crossover everyone with their neighbor
    for(i = m_NumSurvivors; i < (m_PoolSize - 1); i++)
    {
-      pMom = m_pPool[i];
-      pPop = m_pPool[i+1];
-      pMom->Crossover(pPop);  
+      if(m_bBinary == true) CrossoverBinary(i, &(m_pCodes[(i+1)*n]));
+      else                  CrossoverReal(i, &(m_pGenes[(i+1)*n]), m_pFitness[i+1]);
    }/* end for() */
 
    //crossover last and first
-   pMom = m_pPool[m_PoolSize - 1];
-   pMom->Crossover(pFirst);
+   i = m_PoolSize - 1;
+   if(m_bBinary == true) CrossoverBinary(i, m_pNxtCodes);
+   else                  CrossoverReal(i, m_pNxtGenes, m_pNxtFitness[0]);
 }/* end Crossover() */
 
+/******************************************************************************
+CrossoverReal()
+
+Crosses over the genes of the ith (real-coded) chromosome with the genes of
+its mate, whose fitness is F2. The crossed-over genes replace those of the ith
+chromosome. Each gene is crossed over with probability m_XoverRate, using
+either:
+   - the convex arithmetic crossover of RealEncodedGene::Crossover(), which
+     weighs the parents by their fitness and adds a normally distributed
+     epsilon; or
+   - simulated binary crossover (SBX), bounded by the limits of the gene.
+******************************************************************************/
+void ChromosomePool::CrossoverReal(int i, double * pMate, double F2)
+{
+   double r, s, w1, w2, p, sd;
+   double x1, y1, y2, beta, alpha, betaq, eta;
+   double childVal;
+   double * pX;
+   double F1;
+   int j;
+
+   pX = &(m_pGenes[i*m_NumGenes]);
+   F1 = m_pFitness[i];
+
+   //determine weights, based on fitness values
+   p = 1.00-(MyMin(fabs(F1),fabs(F2))/MyMax(fabs(F1),fabs(F2)));
+   if(CheckOverflow(p)) p = 0.00;
+   if(F1 > F2)
+   {
+      w1=MyMin(0.5+0.5*p,1.00);
+      w2=1.00-w1;
+   }
+   else
+   {
+      w2=MyMin(0.5+0.5*p,1.00);
+      w1=1.00-w2;
+   }
+   // standard deviation of the epsilon perturbation, estimated
+   // by the fitness value
+   sd = sqrt(fabs(MyMax(F1,F2))/(double)m_NumGenes);
+   eta = m_SbxIndex;
+
+   for(j = 0; j < m_NumGenes; j++)
+   {
+      r = (double)MyRand() / (double)MY_RAND_MAX;
+      if(r >= m_XoverRate) continue;
+
+      if(m_XoverType == GA_XOVER_SBX)
+      {
+         x1 = pX[j];
+         y1 = MyMin(x1, pMate[j]);
+         y2 = MyMax(x1, pMate[j]);
+         if((y2 - y1) <= 1.00E-14) continue;
+
+         //spread towards the bound that is nearest to the parent
+         if(x1 <= pMate[j]) beta = 1.00 + 2.00*(y1 - m_pLwr[j])/(y2 - y1);
+         else               beta = 1.00 + 2.00*(m_pUpr[j] - y2)/(y2 - y1);
+         alpha = 2.00 - pow(beta, -(eta + 1.00));
+
+         r = (double)MyRand() / (double)MY_RAND_MAX;
+         if(r <= (1.00/alpha)) betaq = pow(r*alpha, 1.00/(eta + 1.00));
+         else                  betaq = pow(1.00/(2.00 - r*alpha), 1.00/(eta + 1.00));
+
+         if(x1 <= pMate[j]) childVal = 0.5*((y1 + y2) - betaq*(y2 - y1));
+         else               childVal = 0.5*((y1 + y2) + betaq*(y2 - y1));
+
+         if(childVal > m_pUpr[j]) childVal = m_pUpr[j];
+         if(childVal < m_pLwr[j]) childVal = m_pLwr[j];
+      }
+      else
+      {
+         childVal = (pX[j] * w1) + (pMate[j] * w2);
+         r = (double)MyRand() / (double)MY_RAND_MAX; //unused, kept for the random sequence
+         s = (double)MyRand() / (double)MY_RAND_MAX; //0 to 1
+
+         // epsilon perturbation using normal distribution
+         // centered on childVal
+         childVal = MyGaussRand(childVal, sd);
+
+         //enforce parameter limits
+         if(childVal > m_pUpr[j]) childVal = pX[j] + (m_pUpr[j]-pX[j])*s;
+         if(childVal < m_pLwr[j]) childVal = pX[j] - (pX[j]-m_pLwr[j])*s;
+      }
+      pX[j] = childVal;
+   }/* end for() */
+}/* end CrossoverReal() */
+
+/******************************************************************************
+CrossoverBinary()
+
+Crosses over the genes of the ith (binary-coded) chromosome with the genes of
+its mate, using the bit-flipping technique of BinaryEncodedGene::Crossover().
+All bits following a randomly generated bit position are interchanged.
+******************************************************************************/
+void ChromosomePool::CrossoverBinary(int i, int * pMate)
+{
+   int * pCode;
+   int j, r, mask;
+   double rd;
+
+   pCode = &(m_pCodes[i*m_NumGenes]);
+   for(j = 0; j < m_NumGenes; j++)
+   {
+      rd = (double)MyRand() / (double)MY_RAND_MAX;
+      if((rd >= m_XoverRate) || (m_pNumBits[j] == 0)) continue;
+
+      r = (MyRand() % m_pNumBits[j])+1;
+      mask = GenomeBitMask(r);
+      pCode[j] = (pCode[j] & ~mask) | (pMate[j] & mask);
+      if(pCode[j] > m_pRange[j]) pCode[j] = m_pRange[j];
+   }/* end for() */
+}/* end CrossoverBinary() */
+
 /******************************************************************************
 Mutate()
 
 Mutates individual chromsomes of the population according to a  
-pre-established mutation rate.
+pre-established mutation rate. A mutated real-coded gene is assigned a random
+value between its bounds, a mutated binary-coded gene has a random number of
+its lowest bits replaced by random bits.
 ******************************************************************************/  
 void ChromosomePool::Mutate(void)
 {        
@@ -258,10 +567,124 @@ void ChromosomePool::Mutate(void)
 
    for(i = m_NumSurvivors; i < m_PoolSize; i++) 
    { 
-      m_pPool[i]->Mutate(m_pMutCount); 
-   }
+      MutateRow(i, m_pMutCount);
+   }/* end for() */
 }/* end Mutate() */
 
+/******************************************************************************
+MutateRow()
+
+Mutates the ith chromosome of the population (see Mutate()). The number of
+mutations of each gene is added to pCount.
+******************************************************************************/  
+void ChromosomePool::MutateRow(int i, int * pCount)
+{        
+   int j, r, mask, code;
+   double p;
+   double * pX;
+   int * pCode;
+
+   if(m_bBinary == true)
+   {
+      pCode = &(m_pCodes[i*m_NumGenes]);
+      for(j = 0; j < m_NumGenes; j++)
+      {
+         p = (double)MyRand() / (double)MY_RAND_MAX;
+         if((p >= m_MutRate) || (m_pNumBits[j] == 0)) continue;
+
+         code = MyRand() % (m_pRange[j]+1);
+         r = (MyRand() % m_pNumBits[j])+1;
+         mask = GenomeBitMask(r);
+         pCode[j] = (pCode[j] & ~mask) | (code & mask);
+         if(pCode[j] > m_pRange[j]) pCode[j] = m_pRange[j];
+         pCount[j]++;
+      }/* end for() */
+   }
+   else
+   {
+      pX = &(m_pGenes[i*m_NumGenes]);
+      for(j = 0; j < m_NumGenes; j++)
+      {
+         p = (double)MyRand() / (double)MY_RAND_MAX;
+         if(p >= m_MutRate) continue;
+
+         p = (double)MyRand() / (double)MY_RAND_MAX;
+         pX[j] = (p * (m_pUpr[j] - m_pLwr[j])) + m_pLwr[j];
+         pCount[j]++;
+      }/* end for() */
+   }
+}/* end MutateRow() */
+
+/******************************************************************************
+ScreenOffspring()
+
+Performs crossover and mutation of real-coded chromosomes with surrogate
+pre-screening. The crossover (with the same mate as in Crossover()) and 
+mutation of each parent are repeated to produce several candidate offspring,
+and the candidate that the surrogate engine considers most promising replaces
+the parent. Returns false, without changing the population, if the surrogate
+engine is not available.
+******************************************************************************/  
+bool ChromosomePool::ScreenOffspring(void)
+{
+   SurrogateEngine * pSrg;
+   double * pX, * pMate, F2;
+   int i, j, k, n, nc;
+
+   pSrg = m_pComm->GetSurrogateEnginePtr();
+   if((pSrg == NULL) || (pSrg->IsReady() == false) || (m_bBinary == true))
+   {
+      return false;
+   }
+   if(m_NumSurvivors >= m_PoolSize) return true;
+
+   n = m_NumGenes;
+   nc = pSrg->GetNumCandidates();
+   if(m_pCandGenes == NULL)
+   {
+      NEW_PRINT("double", nc*n);
+      m_pCandGenes = new double[nc*n];
+      MEM_CHECK(m_pCandGenes);
+      NEW_PRINT("int", nc*n);
+      m_pCandMuts = new int[nc*n];
+      MEM_CHECK(m_pCandMuts);
+   }
+
+   //save first, the last chromosome is crossed over with it
+   CopyToNxtGen(0, m_NumSurvivors);
+
+   for(i = m_NumSurvivors; i < m_PoolSize; i++)
+   {
+      if(i < (m_PoolSize - 1))
+      {
+         pMate = &(m_pGenes[(i+1)*n]);
+         F2 = m_pFitness[i+1];
+      }
+      else
+      {
+         pMate = m_pNxtGenes;
+         F2 = m_pNxtFitness[0];
+      }
+
+      //the row buffer holds the parent while candidates are produced
+      pX = &(m_pGenes[i*n]);
+      memcpy(m_pRow, pX, sizeof(double)*n);
+      for(k = 0; k < nc; k++)
+      {
+         memcpy(pX, m_pRow, sizeof(double)*n);
+         for(j = 0; j < n; j++){ m_pCandMuts[k*n + j] = 0;}
+         CrossoverReal(i, pMate, F2);
+         MutateRow(i, &(m_pCandMuts[k*n]));
+         memcpy(&(m_pCandGenes[k*n]), pX, sizeof(double)*n);
+      }/* end for() */
+
+      k = pSrg->Screen(m_pCandGenes, nc);
+      memcpy(pX, &(m_pCandGenes[k*n]), sizeof(double)*n);
+      for(j = 0; j < n; j++){ m_pMutCount[j] += m_pCandMuts[k*n + j];}
+   }/* end for() */
+   return true;
+}/* end ScreenOffspring() */
+
 /******************************************************************************
 CreateNxtGen()
 
@@ -272,6 +695,7 @@ void  ChromosomePool::CreateNxtGen(void)
 {
   m_Generation++;
   TourneySelection(2);
+  if(ScreenOffspring() == true) return;
   Crossover();
   Mutate();
 }/* end CreateNxtGen() */
@@ -284,20 +708,20 @@ crossover, and mutation. Adapts the GA operators as optimization proceeds.
 ******************************************************************************/
 void  ChromosomePool::CreateNxtGen(double pct)
 {
-  int np = m_pComm->GetParamGroupPtr()->GetNumParams();
   int ng = m_NumGenerations;
   int nCombatants = (int)(0.5+(2.00+pct*0.5*(ng-2.00)));
   m_Generation++;
   TourneySelection(nCombatants);
-  Crossover();  
   //adjust mutation rate
-  for(int i = 0; i < m_PoolSize; i++) 
-  { 
-     m_pPool[i]->SetMutationRate(0.15*(1.00-pct)); 
+  m_MutRate = 0.15*(1.00-pct);
+  if(ScreenOffspring() == false)
+  {
+     Crossover();  
+     Mutate();
   }
-  Mutate();
   //freeze a certain number of genes at their optimal values
   //more are more are frozen as the optimization proceeds
+  //int np = m_pComm->GetParamGroupPtr()->GetNumParams();
   //int nFreeze = (int)(pct*(double)np);
   //FreezeGenes(nFreeze);
 }/* end CreateNxtGen() */
@@ -310,7 +734,8 @@ are at the current global optimal.
 ******************************************************************************/
 void ChromosomePool::FreezeGenes(int numFreeze)
 {
-   int np = m_pComm->GetParamGroupPtr()->GetNumParams();
+   int np = m_NumGenes;
+   int best = GetBestIdx();
 
    for(int i = m_NumSurvivors; i < m_PoolSize; i++)
    {
@@ -318,7 +743,8 @@ void ChromosomePool::FreezeGenes(int numFreeze)
       for(int j = 0; j < numFreeze; j++)
       {
          int k = SampleWithReplacement(1, np);
-         m_pPool[i]->GetGenePtr(k)->SetValue(GetBestFit()->GetGenePtr(k)->GetValue());
+         if(m_bBinary == true) m_pCodes[i*np + k] = m_pCodes[best*np + k];
+         else                  m_pGenes[i*np + k] = m_pGenes[best*np + k];
       }
    }
 }/* FreezeGenes() */
@@ -336,7 +762,7 @@ double ChromosomePool::CalcAvgFitness(void)
     
    sum = 0.00;
 
-   for(i = 0; i < m_PoolSize; i++) { sum += m_pPool[i]->GetFitness(); }  
+   for(i = 0; i < m_PoolSize; i++) { sum += m_pFitness[i]; }
   
    avg = sum / (double)m_PoolSize;
 
@@ -354,38 +780,58 @@ double ChromosomePool::CalcMedianFitness(void)
    double med;
    int i;
     
-   for(i = 0; i < m_PoolSize; i++) { m_Fmedian[i] = m_pPool[i]->GetFitness(); }  
+   for(i = 0; i < m_PoolSize; i++) { m_Fmedian[i] = m_pFitness[i]; }
    med = CalcMedian(m_Fmedian, m_PoolSize);
 
    return med;
 } /* end CalcMedianFitness() */
 
 /******************************************************************************
-GetBestFit()
+GetBestIdx()
 
-Retrieves the chromosome that has the best fitness value.
+Retrieves the index of the chromosome that has the best fitness value.
 ******************************************************************************/
-Chromosome * ChromosomePool::GetBestFit(void)
+int ChromosomePool::GetBestIdx(void)
 {
    double bestFitVal;
-   double tmp;
    int bestFitIdx;
    int i;
    
    bestFitIdx = 0;
-   bestFitVal = m_pPool[0]->GetFitness();   
+   bestFitVal = m_pFitness[0];
    
    for(i = 0; i < m_PoolSize; i++)
    {
-      tmp = m_pPool[i]->GetFitness();  
-      if(tmp > bestFitVal)
+      if(m_pFitness[i] > bestFitVal)
       {
-         bestFitVal = tmp;
+         bestFitVal = m_pFitness[i];
          bestFitIdx = i;
       }/* end if() */
    }/* end for() */
     
-   return (m_pPool[bestFitIdx]);   
+   return bestFitIdx;
+}/* end GetBestIdx() */
+
+/******************************************************************************
+GetBestFit()
+
+Retrieves the chromosome that has the best fitness value. The chromosome is a
+copy, which is only valid until the next call.
+******************************************************************************/
+Chromosome * ChromosomePool::GetBestFit(void)
+{
+   double * pVals;
+   int i, best;
+
+   best = GetBestIdx();
+   pVals = GetGenes(best);
+   for(i = 0; i < m_NumGenes; i++)
+   {
+      m_pBest->GetGenePtr(i)->SetValue(pVals[i]);
+   }
+   m_pBest->SetFitness(m_pFitness[best]);
+
+   return m_pBest;
 }/* end GetBestFit() */
 
 /******************************************************************************
@@ -396,6 +842,8 @@ Evaluates the fitness of each chromosome in the pool.
 void ChromosomePool::EvalFitness(void)
 {   
    int i, n, id;   
+   double * pVals;
+   ProfileScope algScope(PROF_ALG_EVAL);
 
    MPI_Comm_size(MPI_COMM_WORLD, &n);
    MPI_Comm_rank(MPI_COMM_WORLD, &id);
@@ -408,8 +856,10 @@ void ChromosomePool::EvalFitness(void)
          for(i = 0; i < m_PoolSize; i++) 
          { 
             WriteInnerEval(i+1, m_PoolSize, '.');
-            m_pComm->MakeParameterCorrections(m_pPool[i]); 
-            m_pComm->EvalFitness(m_pPool[i]); 
+            pVals = GetGenes(i);
+            m_pComm->MakeParameterCorrections(pVals);
+            SetGenes(i, pVals);
+            m_pFitness[i] = m_pComm->EvalFitness(GetGenes(i));
          }
          WriteInnerEval(WRITE_ENDED, m_PoolSize, '.');
       }
@@ -426,7 +876,9 @@ void ChromosomePool::EvalFitness(void)
          {
             for(i = 0; i < m_PoolSize; i++) 
             { 
-               m_pComm->MakeParameterCorrections(m_pPool[i]); 
+               pVals = GetGenes(i);
+               m_pComm->MakeParameterCorrections(pVals);
+               SetGenes(i, pVals);
             }
          }
          BcastPopulation();
@@ -436,6 +888,12 @@ void ChromosomePool::EvalFitness(void)
       {
          EvalFitnessAsynch(id, n);
       }/* end else() */
+
+      //share model runs with the surrogate engine of each processor
+      if(m_pComm->GetSurrogateEnginePtr() != NULL)
+      {
+         m_pComm->GetSurrogateEnginePtr()->Synchronize();
+      }
    }/* end else() */
 } /* end EvalFitness() */
 
@@ -448,7 +906,8 @@ available slave.
 void ChromosomePool::EvalFitnessAsynch(int rank, int nprocs)
 {
    static double fbest = HUGE_VAL;
-   int i, j;
+   int i;
+   double * pVals;
    MPI_Status mpi_status;
    int ii, signal, num, sid, num_recv, nstops;
    double f;
@@ -480,7 +939,9 @@ void ChromosomePool::EvalFitnessAsynch(int rank, int nprocs)
       //adjust parameter values using rules engine
       for(i = 0; i < m_PoolSize; i++) 
       { 
-         m_pComm->MakeParameterCorrections(m_pPool[i]); 
+         pVals = GetGenes(i);
+         m_pComm->MakeParameterCorrections(pVals); 
+         SetGenes(i, pVals);
       }
 
       /*------------------------------------------------
@@ -498,10 +959,7 @@ void ChromosomePool::EvalFitnessAsynch(int rank, int nprocs)
             m_pAssignments[i] = i-1;
 
             //fill data message
-            for(j = 0; j < num; j++)
-            {
-               m_pMyBuf[j] = m_pPool[i-1]->GetGenePtr(j)->GetValue();
-            }/* end for() */
+            memcpy(m_pMyBuf, GetGenes(i-1), num*sizeof(double));
 
             // send work to slave
             signal = APGA_DO_WORK;
@@ -528,7 +986,7 @@ void ChromosomePool::EvalFitnessAsynch(int rank, int nprocs)
          sid = mpi_status.MPI_SOURCE;
          WriteInnerEval(num_recv, m_PoolSize, '.');
          ii = m_pAssignments[sid];
-         m_pPool[ii]->SetFitness(-f);
+         m_pFitness[ii] = -f;
 
          if(f < fbest)
          {
@@ -542,10 +1000,7 @@ void ChromosomePool::EvalFitnessAsynch(int rank, int nprocs)
             m_pAssignments[sid] = i-1;
 
             //fill data message
-            for(j = 0; j < num; j++)
-            {
-               m_pMyBuf[j] = m_pPool[i-1]->GetGenePtr(j)->GetValue();
-            }/* end for() */
+            memcpy(m_pMyBuf, GetGenes(i-1), num*sizeof(double));
 
             // send work to slave
             signal = APGA_DO_WORK;
@@ -594,52 +1049,22 @@ When in parallel, only the master computes the random processes of tourney
 selection, crossover and mutation. All the other processors just compute the
 fitness functions. The BcastPopulation() routine is called upon to broadcast 
 the current population members from the master processor to all of the slave 
-processors.
+processors. The genome matrix is already flat, so it is broadcast in place.
 ******************************************************************************/
 void ChromosomePool::BcastPopulation(void)
 {   
-   int num_vars, pop_size, buf_size;
-   int i, j, num_procs, id, idx;
-
-   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
-   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   int buf_size;
 
-   //size the flattened variable matrix
-   pop_size = m_PoolSize;
-   num_vars = m_pPool[0]->GetNumGenes();
+   buf_size = m_PoolSize*m_NumGenes;
 
-   buf_size = pop_size*num_vars;
-   if(m_pBuf == NULL)
+   if(m_bBinary == true)
    {
-      NEW_PRINT("double", buf_size);
-      m_pBuf = new double[buf_size];   
-      MEM_CHECK(m_pBuf);
+      MPI_Bcast(m_pCodes, buf_size, MPI_INT, 0, MPI_COMM_WORLD);
    }
-
-   for(i = 0; i < buf_size; i++){ m_pBuf[i] = 999.99;}
-
-   //fill up the flattened matrix
-   for(i = 0; i < num_vars; i++)
+   else
    {
-      for(j = 0; j < pop_size; j++)
-      {
-         idx = (num_vars)*j + i;
-         m_pBuf[idx] = m_pPool[j]->GetGenePtr(i)->GetValue();
-      }/* end for() */
-   }/* end for() */
-
-   //broadcast the flattened matrix
-   MPI_Bcast(m_pBuf, buf_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-   //use the flattened matrix to fill gene pool
-   for(i = 0; i < num_vars; i++)
-   {
-      for(j = 0; j < pop_size; j++)
-      {
-         idx = (num_vars)*j + i;
-         m_pPool[j]->GetGenePtr(i)->SetValue(m_pBuf[idx]);
-      }/* end for() */
-   }/* end for() */
+      MPI_Bcast(m_pGenes, buf_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   }
 }/* end BcastPopulation() */
 
 /******************************************************************************
@@ -676,8 +1101,8 @@ void ChromosomePool::EvalFitParallel(void)
    { 
       if((i % num_procs) == id)
       { 
-         m_pComm->EvalFitness(m_pPool[i]);         
-         m_pMyBuf[j] = m_pPool[i]->GetFitness();
+         m_pFitness[i] = m_pComm->EvalFitness(GetGenes(i));
+         m_pMyBuf[j] = m_pFitness[i];
          m_pTmpBuf[j] = m_pMyBuf[j];
          j++;
       }/* end if() */
@@ -704,7 +1129,7 @@ void ChromosomePool::EvalFitParallel(void)
    //stuff results into population
    for(i = 0; i < m_PoolSize; i++)
    {
-      m_pPool[i]->SetFitness(m_pBigBuf[i]);
+      m_pFitness[i] = m_pBigBuf[i];
    }/* end for() */
 }/* end EvalFitParallel() */
 
@@ -718,7 +1143,6 @@ SuperMUSE clients on a first-come-first-served basis.
 void ChromosomePool::EvalFitSuperMUSE(void)
 {  
    double val;
-   bool bOk; 
    int pop_size;   
    int i;
    ParameterGroup * pGroup;
@@ -739,7 +1163,7 @@ void ChromosomePool::EvalFitSuperMUSE(void)
    for(i = 0; i < pop_size; i++)
    {
       //stuff the parameter group with values
-      pGroup = ConvertChromosome(m_pPool[i]);
+      pGroup = ConvertChromosome(i);
          
       //pass group to supermuse
       pSMUSE->WriteTask(pGroup);
@@ -748,31 +1172,30 @@ void ChromosomePool::EvalFitSuperMUSE(void)
    //Finish task file (this will cause RepeatTasker to begin processing the job)
    pSMUSE->FinishTaskFile();
 
-   //wait for SuperMUSE to report back (via the success or error files)
-   bOk = pSMUSE->WaitForTasker();
+   /* ----------------------------------------------------------------
+   Gather each result as soon as its task completes, in order of 
+   completion, instead of waiting for the whole job.
+   ---------------------------------------------------------------- */
+   while((i = pSMUSE->WaitForNextTask()) >= 0)
+   {
+      /* -----------------------------------------------
+      Stuff the parameter group with ith population
+      member. This ensures that each objective function 
+      gets associated with the correct parameter values.
+      ------------------------------------------------ */
+      pGroup = ConvertChromosome(i);
+
+      //stuff i-th result into chromosome pool
+      val = pSMUSE->GatherResult(i);
+      m_pFitness[i] = -val;
+   }/* end while() */
 
-   if(bOk == false) //SuperMUSE failed
+   if(i == SMUSE_JOB_FAILED) //SuperMUSE failed
    {
       LogError(ERR_SMUSE, "Reverting to serial execution.");
       DisableSuperMUSE();
       EvalFitness();
    }
-   else //SuperMUSE was successful
-   {
-      for(i = 0; i < pop_size; i++)
-      {
-         /* -----------------------------------------------
-         Stuff the parameter group with ith population
-         member. This ensures that each objective function 
-         gets associated with the correct parameter values.
-         ------------------------------------------------ */
-         pGroup = ConvertChromosome(m_pPool[i]);
-
-         //stuff i-th result into chromosome pool
-         val = pSMUSE->GatherResult(i);
-         m_pPool[i]->SetFitness(-val);
-      }/* end for() */
-   }/* end else() */
 }/* end EvalFitSuperMUSE() */
 
 /******************************************************************************
@@ -785,7 +1208,7 @@ void ChromosomePool::Initialize(void)
 {   
    FILE * pFile;
    int popSize, num;
-   double rate, lwr, upr;
+   double rate, lwr, upr, r;
    double * pVals;
    char * pTok;
    LatinHypercube * pLHS = NULL;
@@ -864,6 +1287,17 @@ void ChromosomePool::Initialize(void)
             {
                sscanf(line, "%s %lf", tmp, &m_StopVal);
             }
+            else if(strstr(line, "CrossoverMethod") != NULL)
+            {
+               sscanf(line, "%s %s", tmp, tmp2);
+               MyStrLwr(tmp2);
+               if(strcmp(tmp2, "sbx") == 0) {m_XoverType = GA_XOVER_SBX;}
+               else {m_XoverType = GA_XOVER_BLEND;}
+            }
+            else if(strstr(line, "SBXIndex") != NULL)
+            {
+               sscanf(line, "%s %lf", tmp, &m_SbxIndex);
+            }
             line = GetNxtDataLine(pFile, name);
          }/* end while() */
       }/* end if() */
@@ -929,6 +1363,8 @@ void ChromosomePool::Initialize(void)
 
       fclose(pFile);
    }/* end if() */   
+
+   AddInitializerSets();
    
    //check population and mutation rate
    if(popSize <= 0)
@@ -946,6 +1382,11 @@ void ChromosomePool::Initialize(void)
       LogError(ERR_FILE_IO, "Invalid number of generations");
       ExitProgram(1);
    }
+   if(m_SbxIndex < 0.00)
+   {
+      LogError(ERR_FILE_IO, "Invalid SBX distribution index");
+      ExitProgram(1);
+   }
    
    m_Generation = 0;
    m_Proto = m_pComm->CreateProto(rate);
@@ -957,13 +1398,7 @@ void ChromosomePool::Initialize(void)
    for(i = 0; i < m_Proto->GetNumGenes(); i++){ m_pMutCount[i] = 0;}
    
    m_PoolSize = popSize;
-   NEW_PRINT("Chromosome *", m_PoolSize);
-   m_pPool = new Chromosome * [m_PoolSize];   
-   MEM_CHECK(m_pPool);
-
-   NEW_PRINT("Chromosome *", m_PoolSize);
-   m_pScratch = new Chromosome * [m_PoolSize];   
-   MEM_CHECK(m_pScratch);
+   AllocGenome();
 
    NEW_PRINT("double", m_PoolSize);
    m_Fmedian = new double [m_PoolSize];   
@@ -995,8 +1430,15 @@ void ChromosomePool::Initialize(void)
    {
       if(m_InitType == RANDOM_INIT)
       {
-         m_pPool[i]    = m_Proto->CreateRandomChromo();
-         m_pScratch[i] = m_Proto->CreateRandomChromo();
+         for(j = 0; j < m_NumGenes; j++)
+         {
+            r = (double)MyRand() / (double)MY_RAND_MAX;
+            m_pRow[j] = (r * (m_pUpr[j] - m_pLwr[j])) + m_pLwr[j];
+         }
+         SetGenes(i, m_pRow);
+         //the scratch chromosome used to get its own random genes, keep 
+         //drawing them so that the random number sequence is unchanged
+         for(j = 0; j < m_NumGenes; j++){ MyRand();}
       } /* end if() */
       else if(m_InitType == QUAD_TREE_INIT)
       {
@@ -1024,25 +1466,20 @@ void ChromosomePool::Initialize(void)
             pVals = GetTreeCombo(lvl, idx, m_pTrees, m_TreeSize);
          }
          idx++;
-         m_pPool[i]    = m_Proto->CreateChromo(pVals);
-         m_pScratch[i] = m_Proto->CreateChromo(pVals);
+         SetGenes(i, pVals);
          delete [] pVals;
       }/* end else if(QUAD_TREE_INIT) */
       else if(m_InitType == LHS_INIT)
       {
          for(j = 0; j < m_Proto->GetNumGenes(); j++){ pVals[j] = pLHS->SampleRow(j);}
-         m_pPool[i]    = m_Proto->CreateChromo(pVals);
-         m_pScratch[i] = m_Proto->CreateChromo(pVals);
+         SetGenes(i, pVals);
       }/* end else() */
    }/* end for() */
 
    //seed initial population
-   for(i = 0; i < m_NumInit; i++)
+   for(i = 0; (i < m_NumInit) && (i < m_PoolSize); i++)
    {
-      delete m_pPool[i];
-      m_pPool[i] = m_Proto->CreateChromo(m_pInit[i]);
-      delete m_pScratch[i];
-      m_pScratch[i] = m_Proto->CreateChromo(m_pInit[i]);
+      SetGenes(i, m_pInit[i]);
    }
 
    if(m_InitType == LHS_INIT)
@@ -1054,6 +1491,41 @@ void ChromosomePool::Initialize(void)
    ((ModelChromoComm *)(m_pComm))->SetMaxEvals((m_NumGenerations+1)*m_PoolSize);
 } /* end Initialize() */
 
+/******************************************************************************
+AddInitializerSets()
+
+Append the parameter sets of the model's parameter initializer, if any, to the
+user-specified initial parameter sets.
+******************************************************************************/
+void ChromosomePool::AddInitializerSets(void)
+{
+   ParamInitializerABC * pInit;
+   double ** pAll;
+   int i, num, numSets;
+
+   pInit = m_pComm->GetParamInitializerPtr();
+   if(pInit == NULL) return;
+
+   numSets = pInit->GetNumParameterSets();
+   num = m_pComm->GetParamGroupPtr()->GetNumParams();
+
+   NEW_PRINT("double *", m_NumInit + numSets);
+   pAll = new double * [m_NumInit + numSets];
+   MEM_CHECK(pAll);
+   for(i = 0; i < m_NumInit; i++){ pAll[i] = m_pInit[i];}
+   for(i = m_NumInit; i < m_NumInit + numSets; i++)
+   {
+      NEW_PRINT("double", num);
+      pAll[i] = new double[num];
+      MEM_CHECK(pAll[i]);
+   }
+   delete [] m_pInit;
+   m_pInit = pAll;
+
+   pInit->GetParameterSets(m_pInit, m_NumInit);
+   m_NumInit += numSets;
+} /* end AddInitializerSets() */
+
 /******************************************************************************
 SetChromosome()
 
@@ -1061,10 +1533,7 @@ Replace the ith chromosome with the given vector.
 ******************************************************************************/
 void ChromosomePool::SetChromosome(int i, double * vals)
 {
-   delete m_pPool[i];
-   m_pPool[i] = m_Proto->CreateChromo(vals);
-   delete m_pScratch[i];
-   m_pScratch[i] = m_Proto->CreateChromo(vals);   
+   SetGenes(i, vals);
 }/* end SetChromosome() */
 
 /******************************************************************************
@@ -1180,6 +1649,8 @@ void ChromosomePool::Initialize(int * budget)
       fclose(pFile);
    }/* end if() */   
 
+   AddInitializerSets();
+
    /* -------------------------------------------------------------------
    Adjust population size and max. gens to reflect user-defined budget
    ------------------------------------------------------------------- */
@@ -1212,13 +1683,7 @@ void ChromosomePool::Initialize(int * budget)
    for(i = 0; i < m_Proto->GetNumGenes(); i++){ m_pMutCount[i] = 0;}
    
    m_PoolSize = popSize;
-   NEW_PRINT("Chromosome *", m_PoolSize);
-   m_pPool = new Chromosome * [m_PoolSize];   
-   MEM_CHECK(m_pPool);
-
-   NEW_PRINT("Chromosome *", m_PoolSize);
-   m_pScratch = new Chromosome * [m_PoolSize];   
-   MEM_CHECK(m_pScratch);
+   AllocGenome();
 
    NEW_PRINT("double", m_PoolSize);
    m_Fmedian = new double [m_PoolSize];   
@@ -1243,17 +1708,13 @@ void ChromosomePool::Initialize(int * budget)
    for(i = 0; i < m_PoolSize; i++)
    {
       for(j = 0; j < m_Proto->GetNumGenes(); j++){ pVals[j] = pLHS->SampleRow(j);}
-      m_pPool[i]    = m_Proto->CreateChromo(pVals);
-      m_pScratch[i] = m_Proto->CreateChromo(pVals);
+      SetGenes(i, pVals);
    }/* end for() */
 
    //seed initial population
-   for(i = 0; i < m_NumInit; i++)
+   for(i = 0; (i < m_NumInit) && (i < m_PoolSize); i++)
    {
-      delete m_pPool[i];
-      m_pPool[i] = m_Proto->CreateChromo(m_pInit[i]);
-      delete m_pScratch[i];
-      m_pScratch[i] = m_Proto->CreateChromo(m_pInit[i]);
+      SetGenes(i, m_pInit[i]);
    }
    delete pLHS;
    delete [] pVals;
@@ -1262,13 +1723,19 @@ void ChromosomePool::Initialize(int * budget)
 /******************************************************************************
 CreateComm()
 
-Creates a model-chromosome communicator.
+Creates a model-chromosome communicator. Model runs are shared with the
+surrogate engine of each processor (see EvalFitness()).
 ******************************************************************************/
 void ChromosomePool::CreateComm(ModelABC * pModel)
 {
    NEW_PRINT("ModelChromoComm", 1);
    m_pComm  = new ModelChromoComm(pModel);   
    MEM_CHECK(m_pComm);
+
+   if(m_pComm->GetSurrogateEnginePtr() != NULL)
+   {
+      m_pComm->GetSurrogateEnginePtr()->EnableSync();
+   }
 } /* end CreateComm() */
 
 /******************************************************************************
@@ -1282,6 +1749,16 @@ ParameterGroup * ChromosomePool::ConvertChromosome(Chromosome * pChromo)
    return(m_pComm->ConvertChromosome(pChromo));
 }/* end ConvertChromosome() */
 
+/******************************************************************************
+ConvertChromosome()
+
+Convert the ith chromosome of the pool into it's equivalent parameter group.
+******************************************************************************/
+ParameterGroup * ChromosomePool::ConvertChromosome(int i)
+{
+   return(m_pComm->ConvertGenes(GetGenes(i)));
+}/* end ConvertChromosome() */
+
 /******************************************************************************
 WriteMetrics()
 
@@ -1308,3 +1785,40 @@ void ChromosomePool::WriteMetrics(FILE * pFile)
       pGroup->GetParamPtr(i)->GetName(), m_pMutCount[i]);
    }/* end for() */   
 }/* end WriteMetrics() */
+
+/******************************************************************************
+WriteCheckpoint()
+
+Save the current generation (genome matrix and fitness), the adapted GA 
+operators and the mutation counts.
+******************************************************************************/
+void ChromosomePool::WriteCheckpoint(Checkpoint * pCkpt)
+{
+   int n = m_PoolSize*m_NumGenes;
+
+   pCkpt->WriteInt(m_Generation);
+   pCkpt->WriteDouble(m_MutRate);
+   if(m_bBinary == true) pCkpt->WriteInts(m_pCodes, n);
+   else                  pCkpt->WriteDoubles(m_pGenes, n);
+   pCkpt->WriteDoubles(m_pFitness, m_PoolSize);
+   pCkpt->WriteInts(m_pMutCount, m_NumGenes);
+   m_pComm->WriteCheckpoint(pCkpt);
+}/* end WriteCheckpoint() */
+
+/******************************************************************************
+ReadCheckpoint()
+
+Restore the state saved by WriteCheckpoint().
+******************************************************************************/
+void ChromosomePool::ReadCheckpoint(Checkpoint * pCkpt)
+{
+   int n = m_PoolSize*m_NumGenes;
+
+   m_Generation = pCkpt->ReadInt();
+   m_MutRate = pCkpt->ReadDouble();
+   if(m_bBinary == true) pCkpt->ReadInts(m_pCodes, n);
+   else                  pCkpt->ReadDoubles(m_pGenes, n);
+   pCkpt->ReadDoubles(m_pFitness, m_PoolSize);
+   pCkpt->ReadInts(m_pMutCount, m_NumGenes);
+   m_pComm->ReadCheckpoint(pCkpt);
+}/* end ReadCheckpoint() */
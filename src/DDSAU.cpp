@@ -8,6 +8,7 @@
 #include "Model.h"
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
+#include "ParamInitializerABC.h"
 #include "StatsClass.h"
 
 #include "Utility.h"
@@ -26,6 +27,7 @@ DDSAU::DDSAU(ModelABC *pModel)
    char begin_token[DEF_STR_SZ];
    char end_token[DEF_STR_SZ];
    int itmp;
+   ParamInitializerABC * pInitializer;
 	
 	RegisterAlgPtr(this);
 
@@ -39,6 +41,7 @@ DDSAU::DDSAU(ModelABC *pModel)
    m_MinIter = 30;
 	m_MaxIter = 70;
    m_bParallel = false;
+   m_bAsync = false;
    m_fmax = 1000.00;
    m_bRandomize = false;
    m_bReviseAU = false;
@@ -94,6 +97,15 @@ DDSAU::DDSAU(ModelABC *pModel)
                m_bParallel = true;
             }
          }
+         else if(strstr(line, "Asynchronous") != NULL)
+         {
+            sscanf(line, "%s %s", tmp, yesno);
+            MyStrLwr(yesno);
+            if(strcmp(yesno, "yes") == 0)
+            {
+               m_bAsync = true;
+            }
+         }
          else if(strstr(line, "Randomize") != NULL)
          {
             sscanf(line, "%s %s", tmp, yesno);
@@ -145,6 +157,27 @@ DDSAU::DDSAU(ModelABC *pModel)
 
   m_pBehavioral = NULL;
   m_fBehavioral = NULL;
+  m_pSearches = NULL;
+  m_Stream = -1;
+
+  //starting points from the parameter initializer, if any
+  m_pInitSets = NULL;
+  m_NumInitSets = 0;
+  pInitializer = m_pModel->GetParamInitializerPtr();
+  if(pInitializer != NULL)
+  {
+     m_NumInitSets = pInitializer->GetNumParameterSets();
+     NEW_PRINT("double *", m_NumInitSets);
+     m_pInitSets = new double * [m_NumInitSets];
+     MEM_CHECK(m_pInitSets);
+     for(itmp = 0; itmp < m_NumInitSets; itmp++)
+     {
+        NEW_PRINT("double", m_pModel->GetParamGroupPtr()->GetNumParams());
+        m_pInitSets[itmp] = new double[m_pModel->GetParamGroupPtr()->GetNumParams()];
+        MEM_CHECK(m_pInitSets[itmp]);
+     }
+     pInitializer->GetParameterSets(m_pInitSets, 0);
+  }
  
   IncCtorCount();
 }
@@ -167,6 +200,19 @@ void   DDSAU::Destroy()
    }
    delete [] m_pBehavioral;
    delete [] m_fBehavioral;
+   for(i = 0; i < m_NumInitSets; i++)
+   {
+      delete [] m_pInitSets[i];
+   }
+   delete [] m_pInitSets;
+   if(m_pSearches != NULL)
+   {
+      for(i = 0; i < m_nsols; i++)
+      {
+         delete [] m_pSearches[i].pBest;
+      }
+   }
+   delete [] m_pSearches;
 
   IncDtorCount();
 }
@@ -176,7 +222,11 @@ Optimize
 **********************************************************************/
 void   DDSAU::Optimize() 
 {
-   if(m_bParallel == false)
+   if(m_bAsync == true)
+   {
+      OptimizeAsync();
+   }
+   else if(m_bParallel == false)
    {
       OptimizeSerial();
    }
@@ -191,19 +241,10 @@ OptimizeSerial()
 **********************************************************************/
 void   DDSAU::OptimizeSerial() 
 {
-   FILE * pOut, * pStdOut;
+   FILE * pStdOut;
    DDSAlgorithm * pDDS;
    char outFileName[DEF_STR_SZ];
-   int i, j, p, budget, nfx;
-   char * line;
-   int max_line_size;
-   char * tmpStr;
-   char * bestLine;
-   int nBehavioral;
-   int whichBehavioral;
-   double fbest = 0.00;
-   double fx;
-   int iter;
+   int i, p, budget;
    bool bOutFileExists;
    FILE * pTestFile;
 
@@ -231,7 +272,14 @@ void   DDSAU::OptimizeSerial()
       ---------------------------- */
       pDDS->SetPerturbationValue(m_r_val);
       pDDS->ResetUserSeed(1+GetRandomSeed());  //pass along a new random seed
-      pDDS->SetNoUserInit();  //disable user init
+      if(i < m_NumInitSets)
+      {
+         pDDS->SetUserInit(m_pInitSets[i]); //space-filling starting point
+      }
+      else
+      {
+         pDDS->SetNoUserInit();  //disable user init
+      }
       if(m_MinIter == m_MaxIter)
       {
          budget = m_MaxIter;
@@ -290,30 +338,112 @@ void   DDSAU::OptimizeSerial()
       /* ----------------------------
       Post-process DDS search
       ---------------------------- */
-      max_line_size = GetMaxLineSizeInFile((char *)"OstModel0.txt");
-      // space for lines of OstModel0.txt
-      line = new char[max_line_size+1];
-      line[0] = NULLSTR;
-      tmpStr = new char[max_line_size+1];
-      tmpStr[0] = NULLSTR;
-      bestLine = new char[max_line_size+1];
-      bestLine[0] = NULLSTR;
-      //space for behavioral solutions
-      if (m_pBehavioral == NULL)
-      {
-         m_pBehavioral = new char *[m_nsols];
-         m_fBehavioral = new double[m_nsols];
-         for (j = 0; j < m_nsols; j++)
-         {
-            m_pBehavioral[j] = new char[max_line_size+1];
-            strcpy(m_pBehavioral[j], "unknown");
-            m_fBehavioral[j] = NEARLY_HUGE;
-         }
+      SelectBehavioral(i, "OstModel0.txt");
+
+      /* -----------------------------------------------------------
+      Results for each search will be stored in output files named 
+      OstModel[N]_DDS[M].txt and OstOutput[N]_DDS[M].txt, where [N] 
+      is the processor number and [M] is the DDS search number.
+      ----------------------------------------------------------- */
+      sprintf(outFileName, "OstModel0_DDS%d.txt", i);
+      rename("OstModel0.txt", outFileName);
+      sprintf(outFileName, "OstOutput0_DDS%d.txt", i);
+      rename("OstOutput0.txt", outFileName);
+
+      fprintf(pStdOut, "%-4d  %s", i, m_pBehavioral[i]);
+
+      ((Model *)m_pModel)->SetCounter(0);
+   }/* end for() */		
+
+   WriteMetrics(pStdOut);
+
+   fclose(pStdOut);
+   pDDS->Destroy();  
+}/* end OptimizeSerial() */
+
+/**********************************************************************
+SelectBehavioral()
+
+Pick the result of the i-th search from the record of its evaluations
+(a file in the format of OstModel0.txt): the best solution or, if
+randomizing, a behavioral one at random.
+**********************************************************************/
+void DDSAU::SelectBehavioral(int i, const char * pFileName)
+{
+   FILE * pOut;
+   int j, nfx;
+   char * line;
+   int max_line_size;
+   char * tmpStr;
+   char * bestLine;
+   int nBehavioral;
+   int whichBehavioral;
+   double fbest = 0.00;
+   double fx;
+   int iter;
+
+   max_line_size = GetMaxLineSizeInFile((char *)pFileName);
+   // space for lines of the model file
+   line = new char[max_line_size+1];
+   line[0] = NULLSTR;
+   tmpStr = new char[max_line_size+1];
+   tmpStr[0] = NULLSTR;
+   bestLine = new char[max_line_size+1];
+   bestLine[0] = NULLSTR;
+   //space for behavioral solutions
+   if (m_pBehavioral == NULL)
+   {
+      m_pBehavioral = new char *[m_nsols];
+      m_fBehavioral = new double[m_nsols];
+      for (j = 0; j < m_nsols; j++)
+      {
+         m_pBehavioral[j] = new char[max_line_size+1];
+         strcpy(m_pBehavioral[j], "unknown");
+         m_fBehavioral[j] = NEARLY_HUGE;
+      }
+   }/* end if() */
+   //lines of a search can be longer than those of the first one
+   delete [] m_pBehavioral[i];
+   m_pBehavioral[i] = new char[max_line_size+1];
+   strcpy(m_pBehavioral[i], "unknown");
+   pOut = fopen(pFileName, "r");
+   nfx = 0;
+   nBehavioral = 0;
+   
+   fgets(line, max_line_size, pOut); //skip header
+   while(!feof(pOut))
+   {
+      fgets(line, max_line_size, pOut);
+      //is it a behavioral soloution?
+      sscanf(line, "%d %lf %s", &iter, &fx, tmpStr);
+      //count number of behavioral samples
+      if(fx <= m_fmax)
+      {
+         nBehavioral++; 
       }/* end if() */
-      pOut = fopen("OstModel0.txt", "r");
-      nfx = 0;
+      //track best solution
+      if((nfx == 0) || (fx < fbest))
+      {
+         fbest = fx;
+         strcpy(bestLine, line);
+      }
+      nfx++;
+   }/* end while() */
+   fclose(pOut);
+
+   //use the best solution
+   if((m_bRandomize == false) || (nBehavioral == 0))
+   {
+      strncpy(m_pBehavioral[i], bestLine, max_line_size);
+      m_fBehavioral[i] = fbest;
+   }
+   //randomly select a behavioral solution
+   else
+   {
+      whichBehavioral = 1 + (MyRand() % nBehavioral);
+
+      pOut = fopen(pFileName, "r");
       nBehavioral = 0;
-      
       fgets(line, max_line_size, pOut); //skip header
       while(!feof(pOut))
       {
@@ -325,79 +455,482 @@ void   DDSAU::OptimizeSerial()
          {
             nBehavioral++; 
          }/* end if() */
-         //track best solution
-         if((nfx == 0) || (fx < fbest))
+         if(nBehavioral == whichBehavioral)
          {
-            fbest = fx;
-            strcpy(bestLine, line);
-         }
-         nfx++;
+            strcpy(m_pBehavioral[i], line);
+            m_fBehavioral[i] = fx;
+            break;
+         }/* end if() */
       }/* end while() */
-      fclose(pOut);
+      fclose(pOut);         
+   }/* end else() */
 
-      //use the best solution
-      if((m_bRandomize == false) || (nBehavioral == 0))
-      {
-         strncpy(m_pBehavioral[i], bestLine, max_line_size);
-         m_fBehavioral[i] = fbest;
-      }
-      //randomly select a behavioral solution
-      else
-      {
-         whichBehavioral = 1 + (MyRand() % nBehavioral);
+   if(m_fBehavioral[i] <= m_fmax)
+   {
+      m_nbhvr++;
+   }/* end if() */
 
-         pOut = fopen("OstModel0.txt", "r");
-         nBehavioral = 0;
-         fgets(line, max_line_size, pOut); //skip header
-         while(!feof(pOut))
+   delete [] line;
+   delete [] tmpStr;
+   delete [] bestLine;
+}/* end SelectBehavioral() */
+
+/**********************************************************************
+OptimizeAsync()
+
+Every evaluation of every search is a task in a shared work queue. An
+idle processor is given the next evaluation of the oldest search that
+has one ready (any of its initial samples, or the next DDS step once
+the previous result is back) and otherwise starts the next search. Once
+every search has started, an idle processor is given a DDS step of the
+oldest unfinished search that perturbs its current best solution ahead
+of the results still being evaluated, so that the processors stay busy
+until all searches have spent their budgets. With several processors 
+the master (rank 0) hands out the tasks and collects the results from 
+any worker; otherwise tasks are evaluated in-process, and no search 
+ever steps ahead. Searches are reported in order as they finish. Steps
+taken ahead are less effective, as in parallel DDS, so that the searches
+lose ground when the processors outnumber them.
+
+Each search has the budget, starting points, perturbations, acceptance
+rule and random number seed of a DDS search of the serial mode, with one
+processor it evaluates the same parameter sets. The best solution is 
+not re-evaluated at the end of a search. Its evaluations are recorded 
+in OstModel0_DDS[M].txt; previous results are not reused.
+**********************************************************************/
+void   DDSAU::OptimizeAsync() 
+{
+   MPI_Status mpi_status;
+   FILE * pStdOut;
+   DDSAlgorithm * pDDS;
+   ParameterGroup * pGroup;
+   double * pX; //parameters and search of the task of each processor
+   double fx;
+   int * pAssigned; //search of the task of each processor, -1 if idle
+   int i, p, w, np, rank, nprocs, first, numStarted, numBusy;
+   unsigned int seed;
+   bool bQuit;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &(rank));
+   MPI_Comm_size(MPI_COMM_WORLD, &(nprocs));
+
+   if(rank != 0)
+   {
+      WorkAsync();
+      return;
+   }
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   np = pGroup->GetNumParams();
+
+   //write setup
+   pStdOut = fopen("OstOutputDDSAU.txt", "w");
+   fprintf(pStdOut, "Asynchronous DDS for Approximation of Uncertainty (DDSAU)\n");   
+   //write banner
+   fprintf(pStdOut, "Iter  Run   obj.function  ");
+   for(p = 0; p < np; p++)
+   {
+      fprintf(pStdOut, "%-12s  ", pGroup->GetParamPtr(p)->GetName());
+   }
+   fprintf(pStdOut, "\n");
+
+   //neighbors and parameter corrections are those of DDS
+   pDDS = new DDSAlgorithm(m_pModel);
+   pDDS->SetPerturbationValue(m_r_val);
+
+   NEW_PRINT("DDSAU_Search", m_nsols);
+   m_pSearches = new DDSAU_Search[m_nsols];
+   MEM_CHECK(m_pSearches);
+   //the serial mode reseeds each search with the next seed
+   seed = GetRandomSeed();
+   for(i = 0; i < m_nsols; i++)
+   {
+      m_pSearches[i].budget = 0;
+      m_pSearches[i].numInit = 0;
+      m_pSearches[i].numSent = 0;
+      m_pSearches[i].numDone = 0;
+      m_pSearches[i].fbest = NEARLY_HUGE;
+      m_pSearches[i].pBest = NULL;
+      m_pSearches[i].seed = seed + 1 + i;
+      m_pSearches[i].calls = 0;
+      m_pSearches[i].index = seed + 1 + i;
+   }
+   m_Stream = -1;
+
+   NEW_PRINT("double", nprocs*(np+1));
+   pX = new double[nprocs*(np+1)];
+   MEM_CHECK(pX);
+   NEW_PRINT("int", nprocs);
+   pAssigned = new int[nprocs];
+   MEM_CHECK(pAssigned);
+   for(w = 0; w < nprocs; w++)
+   {
+      pAssigned[w] = -1;
+   }
+
+   first = 0; //oldest search that has not finished
+   numStarted = 0;
+   numBusy = 0;
+   bQuit = false;
+   while(true)
+   {
+      //hand out tasks to the idle processors (the master, if alone)
+      for(w = (nprocs == 1) ? 0 : 1; (w < nprocs) && (bQuit == false); w++)
+      {
+         if(pAssigned[w] != -1)
          {
-            fgets(line, max_line_size, pOut);
-            //is it a behavioral soloution?
-            sscanf(line, "%d %lf %s", &iter, &fx, tmpStr);
-            //count number of behavioral samples
-            if(fx <= m_fmax)
-            {
-               nBehavioral++; 
-            }/* end if() */
-            if(nBehavioral == whichBehavioral)
+            continue;
+         }
+         for(i = first; i < numStarted; i++)
+         {
+            if(NextTask(i, pDDS, &(pX[w*(np+1)]), false) == true)
             {
-               strcpy(m_pBehavioral[i], line);
-               m_fBehavioral[i] = fx;
                break;
-            }/* end if() */
-         }/* end while() */
-         fclose(pOut);         
-      }/* end else() */
+            }
+         }/* end for() */
+         if((i == numStarted) && (numStarted < m_nsols))
+         {
+            StartSearch(numStarted);
+            numStarted++;
+            NextTask(i, pDDS, &(pX[w*(np+1)]), false);
+         }
+         //every search has started, step ahead of the pending results
+         if(i == numStarted)
+         {
+            for(i = first; i < numStarted; i++)
+            {
+               if(NextTask(i, pDDS, &(pX[w*(np+1)]), true) == true)
+               {
+                  break;
+               }
+            }/* end for() */
+         }
+         //nothing to hand out until a result comes back
+         if(i == numStarted)
+         {
+            break;
+         }
 
-      if(m_fBehavioral[i] <= m_fmax)
+         pAssigned[w] = i;
+         numBusy++;
+         pX[w*(np+1) + np] = (double)i;
+         if(nprocs > 1)
+         {
+            MPI_Send(&(pX[w*(np+1)]), np+1, MPI_DOUBLE, w, MPI_DATA_TAG, MPI_COMM_WORLD);
+         }
+      }/* end for() */
+
+      //done once nothing is being evaluated
+      if(numBusy == 0)
       {
-         m_nbhvr++;
-      }/* end if() */
+         break;
+      }
 
-      /* -----------------------------------------------------------
-      Results for each search will be stored in output files named 
-      OstModel[N]_DDS[M].txt and OstOutput[N]_DDS[M].txt, where [N] 
-      is the processor number and [M] is the DDS search number.
-      ----------------------------------------------------------- */
-      sprintf(outFileName, "OstModel0_DDS%d.txt", i);
-      rename("OstModel0.txt", outFileName);
-      sprintf(outFileName, "OstOutput0_DDS%d.txt", i);
-      rename("OstOutput0.txt", outFileName);
+      //first result to come back
+      if(nprocs == 1)
+      {
+         w = 0;
+         SetTrialNumber(pAssigned[w]); //used by PreserveModelOutput
+         pGroup->WriteParams(pX);
+         fx = m_pModel->Execute();
+      }
+      else
+      {
+         MPI_Recv(&fx, 1, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_RESULTS_TAG, MPI_COMM_WORLD, &mpi_status);
+         w = mpi_status.MPI_SOURCE;
+      }
+      i = pAssigned[w];
+      pAssigned[w] = -1;
+      numBusy--;
+      ProcessResult(i, &(pX[w*(np+1)]), fx);
 
-      fprintf(pStdOut, "%-4d  %s", i, m_pBehavioral[i]);
+      //report finished searches, in order
+      while((first < numStarted) && (m_pSearches[first].numDone == m_pSearches[first].budget))
+      {
+         FinishSearch(first, pStdOut);
+         first++;
+      }
 
-      ((Model *)m_pModel)->SetCounter(0);
+      if(IsQuit() == true)
+      {
+         bQuit = true;
+      }
+   }/* end while() */
 
-      delete [] line;
-      delete [] tmpStr;
-      delete [] bestLine;
-   }/* end for() */		
+   //searches cut short by a quit request
+   for(i = first; i < numStarted; i++)
+   {
+      if(m_pSearches[i].numDone > 0)
+      {
+         FinishSearch(i, pStdOut);
+      }
+   }
+
+   //release the workers
+   for(w = 1; w < nprocs; w++)
+   {
+      MPI_Send(pX, 1, MPI_DOUBLE, w, MPI_QUIT_TAG, MPI_COMM_WORLD);
+   }
 
    WriteMetrics(pStdOut);
 
    fclose(pStdOut);
    pDDS->Destroy();  
-}/* end OptimizeSerial() */
+   delete [] pX;
+   delete [] pAssigned;
+}/* end OptimizeAsync() */
+
+/**********************************************************************
+WorkAsync()
+
+Worker side of the asynchronous mode: evaluate the parameter sets sent
+by the master until told to quit.
+**********************************************************************/
+void   DDSAU::WorkAsync() 
+{
+   ParameterGroup * pGroup;
+   double * pX;
+   double fx;
+   int np;
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   np = pGroup->GetNumParams();
+   NEW_PRINT("double", np+1);
+   pX = new double[np+1];
+   MEM_CHECK(pX);
+
+   while(true)
+   {
+      if(RecvWorkMsg(pX, np+1) == MPI_QUIT_TAG)
+      {
+         break;
+      }
+
+      SetTrialNumber((int)(pX[np])); //used by PreserveModelOutput
+      pGroup->WriteParams(pX);
+      fx = m_pModel->Execute();
+
+      MPI_Send(&fx, 1, MPI_DOUBLE, 0, MPI_RESULTS_TAG, MPI_COMM_WORLD);
+   }/* end while() */
+
+   delete [] pX;
+}/* end WorkAsync() */
+
+/**********************************************************************
+StartSearch()
+
+Asynchronous mode: budget and number of initial samples of the i-th
+search, as in the serial mode and DDSAlgorithm::Optimize().
+**********************************************************************/
+void   DDSAU::StartSearch(int i) 
+{
+   DDSAU_Search * pS;
+   char outFileName[DEF_STR_SZ];
+   int np;
+
+   pS = &(m_pSearches[i]);
+   np = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   UseStream(i);
+   if(m_MinIter == m_MaxIter)
+   {
+      pS->budget = m_MaxIter;
+   }
+   else
+   {
+      pS->budget = m_MinIter + (MyRand() % ((m_MaxIter - m_MinIter) + 1));
+   }
+
+   //one starting point, or random sampling
+   if(i < m_NumInitSets)
+   {
+      pS->numInit = 1;
+   }
+   else
+   {
+      pS->numInit = iMax(5, (int)(0.005*(double)(pS->budget)));
+      if(pS->numInit >= pS->budget)
+      {
+         pS->numInit = 1;
+      }
+   }
+   if(pS->budget - pS->numInit <= 0)
+   {
+      LogError(ERR_FILE_IO,"DDSAU: # of Initialization samples >= Max # func evaluations");
+      ExitProgram(1);
+   }
+
+   NEW_PRINT("double", np);
+   pS->pBest = new double[np];
+   MEM_CHECK(pS->pBest);
+
+   //output of a previous serial search would be stale
+   sprintf(outFileName, "OstOutput0_DDS%d.txt", i);
+   remove(outFileName);
+}/* end StartSearch() */
+
+/**********************************************************************
+NextTask()
+
+Asynchronous mode: the next parameter set (x) of the i-th search, or
+false if it has none until a result comes back (or it is done). If 
+bAhead is true, a DDS step may perturb the best solution while earlier 
+steps are still being evaluated.
+**********************************************************************/
+bool   DDSAU::NextTask(int i, DDSAlgorithm * pDDS, double * x, bool bAhead) 
+{
+   DDSAU_Search * pS;
+   ParameterGroup * pGroup;
+   ParameterABC * pParam;
+   double * xb;
+   double Pn;
+   int k, np, step;
+
+   pS = &(m_pSearches[i]);
+   pGroup = m_pModel->GetParamGroupPtr();
+   np = pGroup->GetNumParams();
+
+   if(pS->numSent == pS->budget)
+   {
+      return false;
+   }
+   //a DDS step perturbs the best solution, once all initial samples are in
+   if((pS->numSent >= pS->numInit) && 
+      ((pS->numDone < pS->numInit) || ((bAhead == false) && (pS->numDone < pS->numSent))))
+   {
+      return false;
+   }
+
+   UseStream(i);
+
+   //initial samples are independent of each other
+   if(pS->numSent < pS->numInit)
+   {
+      if(i < m_NumInitSets)
+      {
+         for(k = 0; k < np; k++)
+         {
+            x[k] = m_pInitSets[i][k];
+         }
+      }
+      else
+      {
+         for(k = 0; k < np; k++)
+         {
+            pParam = pGroup->GetParamPtr(k);
+            x[k] = UniformRandom()*(pParam->GetUprBnd() - pParam->GetLwrBnd()) + pParam->GetLwrBnd();
+         }
+      }
+      xb = (pS->numDone > 0) ? pS->pBest : x;
+   }
+   else
+   {
+      step = pS->numSent - pS->numInit + 1;
+      Pn = 1.0 - log((double)step)/log((double)(pS->budget - pS->numInit));
+      pDDS->GenerateNeighbor(x, pS->pBest, np, Pn);
+      xb = pS->pBest;
+   }
+
+   pDDS->MakeParameterCorrections(x, xb, np, (double)(pS->numSent)/(double)(pS->budget));
+   pS->numSent++;
+   return true;
+}/* end NextTask() */
+
+/**********************************************************************
+ProcessResult()
+
+Asynchronous mode: the i-th search evaluated x to fx. Keep x if it is
+at least as good as the best solution, and record the evaluation in
+OstModel0_DDS[i].txt.
+**********************************************************************/
+void   DDSAU::ProcessResult(int i, double * x, double fx) 
+{
+   DDSAU_Search * pS;
+   ParameterGroup * pGroup;
+   char outFileName[DEF_STR_SZ];
+   FILE * pFile;
+   int np;
+
+   pS = &(m_pSearches[i]);
+   pGroup = m_pModel->GetParamGroupPtr();
+   np = pGroup->GetNumParams();
+
+   pS->numDone++;
+   if((pS->numDone == 1) || (fx <= pS->fbest))
+   {
+      pS->fbest = fx;
+      memcpy(pS->pBest, x, sizeof(double)*np);
+   }
+
+   sprintf(outFileName, "OstModel0_DDS%d.txt", i);
+   if(pS->numDone == 1)
+   {
+      pFile = fopen(outFileName, "w");
+      if(pFile == NULL)
+      {
+         FileOpenFailure("DDSAU::ProcessResult", outFileName);
+      }
+      fprintf(pFile,"Run   obj.function   ");
+      pGroup->Write(pFile, WRITE_BNR);
+      fprintf(pFile,"\n");
+   }
+   else
+   {
+      pFile = fopen(outFileName, "a");
+      if(pFile == NULL)
+      {
+         FileOpenFailure("DDSAU::ProcessResult", outFileName);
+      }
+   }
+   pGroup->WriteParams(x);
+   fprintf(pFile, "%-4d  ", pS->numDone);
+   WritePreciseNumber(pFile, fx);
+   fprintf(pFile, "  ");
+   pGroup->Write(pFile, WRITE_SCI);
+   fprintf(pFile, "\n");
+   fclose(pFile);
+}/* end ProcessResult() */
+
+/**********************************************************************
+FinishSearch()
+
+Asynchronous mode: select the result of the i-th search and report it.
+**********************************************************************/
+void   DDSAU::FinishSearch(int i, FILE * pStdOut) 
+{
+   char outFileName[DEF_STR_SZ];
+
+   UseStream(i);
+   sprintf(outFileName, "OstModel0_DDS%d.txt", i);
+   SelectBehavioral(i, outFileName);
+   fprintf(pStdOut, "%-4d  %s", i, m_pBehavioral[i]);
+}/* end FinishSearch() */
+
+/**********************************************************************
+UseStream()
+
+Asynchronous mode: switch to the random number stream of the i-th 
+search, saving that of the current search. The state of rand() can't 
+be saved, so a switch replays the calls made by the search so far 
+(see SetRandomState()).
+**********************************************************************/
+void   DDSAU::UseStream(int i) 
+{
+   DDSAU_Search * pS;
+
+   if(m_Stream == i)
+   {
+      return;
+   }
+   if(m_Stream != -1)
+   {
+      pS = &(m_pSearches[m_Stream]);
+      GetRandomState(&(pS->seed), &(pS->calls), &(pS->index));
+   }
+   pS = &(m_pSearches[i]);
+   SetRandomState(pS->seed, pS->calls, pS->index);
+   m_Stream = i;
+}/* end UseStream() */
 
 
 /**********************************************************************
@@ -451,7 +984,14 @@ void   DDSAU::OptimizeParallel()
       ---------------------------- */
       pDDS->SetPerturbationValue(m_r_val);
       pDDS->ResetUserSeed(nprocs+GetRandomSeed());  //pass along a new random seed
-      pDDS->SetNoUserInit();  //disable user init
+      if(i < m_NumInitSets)
+      {
+         pDDS->SetUserInit(m_pInitSets[i]); //space-filling starting point
+      }
+      else
+      {
+         pDDS->SetNoUserInit();  //disable user init
+      }
       if(m_MinIter == m_MaxIter)
       {
          budget = m_MaxIter;
@@ -720,6 +1260,14 @@ void DDSAU::WriteMetrics(FILE * pFile)
    {
       fprintf(pFile, "Randomize samples?       : no\n");
    }
+   if(m_bAsync == true)
+   {
+      fprintf(pFile, "Asynchronous searches?   : yes\n");
+   }
+   else
+   {
+      fprintf(pFile, "Asynchronous searches?   : no\n");
+   }
    if(m_bReviseAU == true)
    {
       fprintf(pFile, "Revise Previous DDS AU?  : yes\n");
@@ -736,7 +1284,7 @@ void DDSAU::WriteMetrics(FILE * pFile)
       fprintf(pFile, "%12s  ", m_pModel->GetParamGroupPtr()->GetParamPtr(p)->GetName());
    }
    fprintf(pFile, "\n");
-   for(i = 0; i < m_nsols; i++)
+   for(i = 0; (m_fBehavioral != NULL) && (i < m_nsols); i++)
    {
       if(m_fBehavioral[i] <= m_fmax)
       {
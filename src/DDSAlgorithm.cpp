@@ -7,6 +7,8 @@ An implementation of the DDS algorithm.
 
 Version History
 09-09-09    lsm   Created
+10-19-26    lsm   Neighbors are pre-screened with the surrogate engine, if any.
+10-19-26    lsm   The main loop can be checkpointed and resumed (see Checkpoint.h).
 ******************************************************************************/
 #include <math.h>
 #include <string.h>
@@ -15,6 +17,8 @@ Version History
 #include "Model.h"
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
 #include "StatsClass.h"
 
 #include "Utility.h"
@@ -52,6 +56,7 @@ DDSAlgorithm::DDSAlgorithm(ModelABC *pModel)
 
 	m_pModel = pModel;
   m_pStats = NULL;
+  m_pCkpt = NULL;
 	
 	//init. everything to reasonable defaults
    m_r_val = 0.2;
@@ -147,6 +152,7 @@ Destroy
 void   DDSAlgorithm::Destroy()
 {
   delete m_pStats;
+  delete m_pCkpt;
   IncDtorCount();
 }/* end Destroy() */
 
@@ -160,6 +166,17 @@ void DDSAlgorithm::ResetUserSeed(int seed)
    ResetRandomSeed(seed);
 }/* end ResetUserSeed() */
 
+/**********************************************************************
+SetUserInit()
+
+Start the search from the given parameter set instead of a random one.
+**********************************************************************/
+void DDSAlgorithm::SetUserInit(double * pInit)
+{
+   m_pModel->GetParamGroupPtr()->WriteParams(pInit);
+   m_UserSuppliedInit = true;
+}/* end SetUserInit() */
+
 /**********************************************************************
 Optimize
 **********************************************************************/
@@ -170,12 +187,14 @@ void   DDSAlgorithm::Optimize()
 	//------------------------------------------------------------
 	double	Ftest,Fbest, * Cbest;
 	double  Pn,convergence;
-	int     dv,dvn_count;			//index, counter for how many dec vars vary in neighbourhood
 	int     iters_remaining,InitFunctEvals;
 	int	  i,j, k;							//counter variables
-	int     NumParams;
+	int     NumParams, iStart;
 	double *BestParams,*TestParams;
-   bool bBanner, bWarmStart;
+   double *pCands;
+   int nCands;
+   bool bBanner, bWarmStart, bResume;
+   SurrogateEngine * pSrg;
    double a = 0.00; //the fraction of elapsed budget
    FILE * pPnFile;
 
@@ -193,15 +212,41 @@ void   DDSAlgorithm::Optimize()
 	TestParams		=new double [NumParams];
 	MEM_CHECK(TestParams);
 
+   //candidate neighbors, if pre-screened by the surrogate engine
+   pSrg = m_pModel->GetSurrogateEnginePtr();
+   pCands = NULL;
+   nCands = 0;
+   if(pSrg != NULL)
+   {
+      nCands = pSrg->GetNumCandidates();
+      NEW_PRINT("double", nCands*NumParams);
+      pCands = new double[nCands*NumParams];
+      MEM_CHECK(pCands);
+   }
+
 	for (k=0; k<NumParams;k++)
 	{
 		BestParams[k]=TestParams[k]=pParamGroup->GetParamPtr(k)->GetEstVal();		
 	}
 
-   //write setup
-   WriteSetup(m_pModel, "Dynamically Dimensioned Search Algorithm (DDS)");   
-   //write banner
-   WriteBanner(m_pModel, "trial    best fitness   ", " trials remaining");
+   //checkpoints are only taken when DDS is the top-level algorithm
+   bResume = false;
+   if(GetProgramType() == DDS_PROGRAM)
+   {
+      NEW_PRINT("Checkpoint", 1);
+      m_pCkpt = new Checkpoint(m_pModel, "DDS");
+      MEM_CHECK(m_pCkpt);
+      m_pCkpt->AddFile("OstDDSPn.txt");
+      bResume = m_pCkpt->Resume();
+   }
+
+   if(bResume == false)
+   {
+      //write setup
+      WriteSetup(m_pModel, "Dynamically Dimensioned Search Algorithm (DDS)");   
+      //write banner
+      WriteBanner(m_pModel, "trial    best fitness   ", " trials remaining");
+   }
 	pStatus.maxIter =m_MaxIter;
 
 	//------------------------------------------------------------
@@ -255,7 +300,7 @@ void   DDSAlgorithm::Optimize()
 	//       m_MaxIter limit is to read in the initial solution matrix from an input file
    j = 0;
    m_CurIter = 0;
-	for(i=1;i<=InitFunctEvals;i++)
+	for(i=1;(i<=InitFunctEvals) && (bResume == false);i++)
 	{
 		pStatus.curIter = i;      
 
@@ -322,11 +367,28 @@ void   DDSAlgorithm::Optimize()
 	//				MAIN DDS LOOP
 	//------------------------------------------------------------
 
-   pPnFile = fopen("OstDDSPn.txt", "w");
-   fprintf(pPnFile, "EVAL  Pn\n");
-   fclose(pPnFile);
+   if(bResume == true)
+   {
+      iStart = m_pCkpt->ReadInt();
+      j = m_pCkpt->ReadInt();
+      bBanner = (m_pCkpt->ReadInt() == 1);
+      m_CurIter = m_pCkpt->ReadInt();
+      a = m_pCkpt->ReadDouble();
+      Fbest = m_pCkpt->ReadDouble();
+      m_pCkpt->ReadDoubles(BestParams, NumParams);
+      m_pCkpt->ReadDoubles(Cbest, nSpecial);
+      pParamGroup->EnableSpecialParams();
+      pParamGroup->ConfigureSpecialParams(Fbest, Cbest);
+   }
+   else
+   {
+      iStart = 1;
+      pPnFile = fopen("OstDDSPn.txt", "w");
+      fprintf(pPnFile, "EVAL  Pn\n");
+      fclose(pPnFile);
+   }
 
-	for(i=1;i<=iters_remaining;i++) 
+	for(i=iStart;i<=iters_remaining;i++) 
 	{
 		pStatus.curIter = i+InitFunctEvals;      
 
@@ -338,26 +400,19 @@ void   DDSAlgorithm::Optimize()
       fprintf(pPnFile, "%04d  %E\n", i, Pn);
       fclose(pPnFile);
 
-		dvn_count=0; 
-
-		// define TestParams initially as best current solution
-		for (k=0;k<NumParams;k++)
-      {
-			TestParams[k]=BestParams[k];
-		}
-
-		for(k=0;k<NumParams;k++)// randomly select DVs in neighbourhood to perturb 
-		{	 
-			if (UniformRandom()<Pn)
-         { 
-            dvn_count=dvn_count+1;
-				TestParams[k]=PerturbParam(BestParams[k],pParamGroup->GetParamPtr(k));
+		// generate a neighbour, or the most promising of several neighbours
+		if((pSrg != NULL) && (pSrg->IsReady() == true))
+		{
+			for(k=0;k<nCands;k++)
+			{
+				GenerateNeighbor(&(pCands[k*NumParams]), BestParams, NumParams, Pn);
 			}
+			k = pSrg->Screen(pCands, nCands);
+			memcpy(TestParams, &(pCands[k*NumParams]), sizeof(double)*NumParams);
 		}
-		if (dvn_count==0)			  // if no DVs selected at random, select ONE
-		{ 
-				dv=(int)(ceil((double)(NumParams)*UniformRandom()))-1; // index for one DV 
-				TestParams[dv]=PerturbParam(BestParams[dv],pParamGroup->GetParamPtr(dv));
+		else
+		{
+			GenerateNeighbor(TestParams, BestParams, NumParams, Pn);
 		}
 		
 		// Evaluate obj function for current set of DVs
@@ -406,6 +461,19 @@ void   DDSAlgorithm::Optimize()
          WriteInnerEval(WRITE_ENDED, 0, '.');
          pParamGroup->WriteParams(BestParams);
 		   WriteRecord(m_pModel, i+InitFunctEvals, Fbest, convergence);
+      }
+      else if((m_pCkpt != NULL) && (m_pCkpt->IsDue() == true))
+      {
+         m_pCkpt->Begin();
+         m_pCkpt->WriteInt(i+1);
+         m_pCkpt->WriteInt(j);
+         m_pCkpt->WriteInt((bBanner == true) ? 1 : 0);
+         m_pCkpt->WriteInt(m_CurIter);
+         m_pCkpt->WriteDouble(a);
+         m_pCkpt->WriteDouble(Fbest);
+         m_pCkpt->WriteDoubles(BestParams, NumParams);
+         m_pCkpt->WriteDoubles(Cbest, nSpecial);
+         m_pCkpt->End();
       }
 	}/* end for(i=1;i<=iters_remaining;i++)  (main DDS loop)*/
 
@@ -422,8 +490,43 @@ void   DDSAlgorithm::Optimize()
 	delete [] BestParams;
 	delete [] TestParams;
    delete [] Cbest;
+   delete [] pCands;
 }
 
+/*************************************************************************************
+GenerateNeighbor()
+
+Perturb the current best solution (xb), selecting each DV with probability Pn, or a
+single DV if none was selected at random.
+*************************************************************************************/
+void DDSAlgorithm::GenerateNeighbor(double * x, double * xb, int n, double Pn)
+{
+   ParameterGroup * pParamGroup = m_pModel->GetParamGroupPtr(); 
+   int k, dv, dvn_count;
+
+   dvn_count=0; 
+
+   // define x initially as best current solution
+   for (k=0;k<n;k++)
+   {
+      x[k]=xb[k];
+   }
+
+   for(k=0;k<n;k++)// randomly select DVs in neighbourhood to perturb 
+   {	 
+      if (UniformRandom()<Pn)
+      { 
+         dvn_count=dvn_count+1;
+         x[k]=PerturbParam(xb[k],pParamGroup->GetParamPtr(k));
+      }
+   }
+   if (dvn_count==0)			  // if no DVs selected at random, select ONE
+   { 
+      dv=(int)(ceil((double)(n)*UniformRandom()))-1; // index for one DV 
+      x[dv]=PerturbParam(xb[dv],pParamGroup->GetParamPtr(dv));
+   }
+}/* end GenerateNeighbor() */
+
 /*************************************************************************************
 MakeParameerCorrections()
 *************************************************************************************/
@@ -555,6 +658,7 @@ void DDSAlgorithm::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Max Generations         : %d\n", m_MaxIter);
    fprintf(pFile, "Actual Generations      : %d\n", m_MaxIter);
    fprintf(pFile, "Peterbation Value       : %lf\n", m_r_val);
+   if(m_pCkpt != NULL) m_pCkpt->WriteMetrics(pFile);
    m_pModel->WriteMetrics(pFile);
    fprintf(pFile, "Algorithm successfully converged on a solution, however more runs may be needed\n");
 }/* end WriteMetrics() */
@@ -21,6 +21,10 @@ Version History
                      ERR_INS_OBS  --> insensitive observation
                      ERR_CONTINUE --> the error message is a continutation of a previous msg
 07-13-07    lsm   Added SuperMUSE error code (ERR_SMUSE) and SuperMUSE cleanup.
+10-19-26    lsm   Evaluation profiler is finalized on exit.
+10-19-26    lsm   IsQuit() uses the stop-signal subsystem (see StopSignal.h)
+10-19-26    lsm   Added IsQuitAll(), on which all processors agree
+                  instead of opening the stop file on every call.
 ******************************************************************************/
 #include <mpi.h>
 #include <stdio.h>
@@ -38,6 +42,8 @@ Version History
 
 #include "Exception.h"
 #include "SuperMuseUtility.h"
+#include "Profiler.h"
+#include "StopSignal.h"
 #include "Utility.h"
 #include "IsoParse.h"
 
@@ -120,6 +126,9 @@ double gObjFuncThreshold = HUGE_VAL;
 //trial number (used by PreserveModelOutput)
 int gTrialNumber = 0;
 
+//if false, model evaluations are not logged to OstModel*.txt (streaming GLUE)
+bool gModelLogging = true;
+
 void SetObjFuncThreshold(double threshold)
 {
    gObjFuncThreshold = threshold;
@@ -140,6 +149,16 @@ int GetTrialNumber(void)
    return(gTrialNumber);
 }
 
+void SetModelLogging(bool bLog)
+{
+   gModelLogging = bLog;
+}
+
+bool GetModelLogging(void)
+{
+   return(gModelLogging);
+}
+
 //clean up error list
 void DestroyErrorList(ErrorMsg * pMsg);
 
@@ -371,6 +390,8 @@ void InitErrors(void)
 
    remove(gStopFile);
    remove(m_ErrorFile);
+
+   StopSignalInit(gStopFile);
 }/* end InitErrors() */
 
 /******************************************************************************
@@ -556,6 +577,9 @@ void ExitProgram(int code)
 {   
    ReportErrors();
 
+   //flush timing summary and close trace, including on abnormal exit
+   ProfilerFinalize();
+
    if(code != 0)
    {
       delete m_pAlgReg;
@@ -609,19 +633,19 @@ void MemCheck(void * pMem, int line, const char * file)
 /******************************************************************************
 IsQuit()
 
-Checks to see if the user has requested early termination of the program.
+Checks to see if the user has requested early termination of the program,
+via the stop file, a signal or a stop message from another processor.
 ******************************************************************************/
 bool IsQuit(void)
 {
    static bool isLogged = false;
-   FILE * pFile;
-   pFile = fopen(gStopFile, "r");
-   if(pFile != NULL)
+
+   StopSignalInit(gStopFile);
+   if(StopRequested() == true)
    { 
-      fclose(pFile);
       if(isLogged == false)
       {
-         LogError(ERR_ABORT, "stop file detected, aborting program");
+         LogError(ERR_ABORT, "stop requested, aborting program");
          isLogged = true;
       }
       return true;
@@ -630,3 +654,29 @@ bool IsQuit(void)
    return false;
 }/* end IsQuit() */
 
+/******************************************************************************
+IsQuitAll()
+
+Collective version of IsQuit(), for algorithms whose processors work in lock
+step: must be called by all processors, and returns true on all of them if any
+processor has seen a stop request. A stop request reaches the processors at 
+different times, so breaking out on IsQuit() alone could leave the others 
+waiting in the next collective call.
+******************************************************************************/
+bool IsQuitAll(void)
+{
+   int nprocs, quit, any;
+
+   quit = (IsQuit() == true) ? 1 : 0;
+
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   if(nprocs > 1)
+   {
+      any = quit;
+      MPI_Allreduce(&quit, &any, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+      quit = any;
+   }
+
+   return (quit != 0);
+}/* end IsQuitAll() */
+
@@ -15,6 +15,7 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel.
+10-19-26    lsm   processors agree on early termination (IsQuitAll())
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -254,7 +255,7 @@ void FletchReevesAlgorithm::Optimize(void)
    
    for(its = its; its < m_MaxIter; its++)
    {
-      if(IsQuit() == true){ break;}
+      if(IsQuitAll() == true){ break;}
 
       pStatus.curIter = m_CurIter = iter = its + 1;
 
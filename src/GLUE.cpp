@@ -7,6 +7,12 @@ Generalized Likelihood Uncertainty Engine - GLUE
 
 Version History
 06-23-10    lsm   added copyright information and initial comments.
+10-19-26    lsm   added streaming mode. Samples are generated lazily from a
+                  scrambled Halton sequence and only the behavioral samples
+                  are retained, as running statistics and in a compact binary
+                  file. To select this option, users enter the following line
+                  in the GLUE configuration section:
+                     StreamingMode   yes
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -18,6 +24,9 @@ Version History
 #include "Model.h"
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
+#include "ObservationGroup.h"
+#include "Observation.h"
+#include "QuasiRandom.h"
 
 #include "Exception.h"
 #include "WriteUtility.h"
@@ -59,6 +68,24 @@ GLUE::GLUE(ModelABC * pModel)
    m_iCounts = NULL;
    m_iDispls = NULL;
 
+   //streaming mode
+   m_bStreaming = false;
+   m_NumBins = 20;
+   m_pQmc = NULL;
+   m_pBinFile = NULL;
+   m_BestIdx = -1;
+   m_BestF = HUGE_VAL;
+   m_NumEvaluated = 0.00;
+   m_NumStats = 0.00;
+   m_pPrmShift = NULL;
+   m_pPrmStats = NULL;
+   m_pPrmHist = NULL;
+   m_pObsShift = NULL;
+   m_pObsStats = NULL;
+   m_pLwr = NULL;
+   m_pUpr = NULL;
+   m_NumObs = 0;
+
    IncCtorCount();
 }/* end CTOR() */
 
@@ -70,17 +97,25 @@ Free up memory used by the GLUE and it's member variables.
 void GLUE::Destroy(void)
 {
    int i;
-   for(i = 0; i < m_NumDesired; i++)
+   if(m_pBehavioral != NULL)
    {
-      delete [] m_pBehavioral[i].x;
+      for(i = 0; i < m_NumDesired; i++)
+      {
+         delete [] m_pBehavioral[i].x;
+      }
+      delete [] m_pBehavioral;
+      m_pBehavioral = NULL;
    }
-   delete [] m_pBehavioral;
 
-   for(i = 0; i < m_SamplesPerIter; i++)
+   if(m_pSamples != NULL)
    {
-      delete [] m_pSamples[i].x;
+      for(i = 0; i < m_SamplesPerIter; i++)
+      {
+         delete [] m_pSamples[i].x;
+      }
+      delete [] m_pSamples;
+      m_pSamples = NULL;
    }
-   delete [] m_pSamples;
    
    m_MaxSamples = 0;
    m_NumDesired = 0;
@@ -95,6 +130,18 @@ void GLUE::Destroy(void)
    delete [] m_iCounts;
    delete [] m_iDispls;
 
+   if(m_pBinFile != NULL) fclose(m_pBinFile);
+   m_pBinFile = NULL;
+   delete m_pQmc;
+   m_pQmc = NULL;
+   delete [] m_pPrmShift;
+   delete [] m_pPrmStats;
+   delete [] m_pPrmHist;
+   delete [] m_pObsShift;
+   delete [] m_pObsStats;
+   delete [] m_pLwr;
+   delete [] m_pUpr;
+
    IncDtorCount();
 }/* end Destroy() */
 
@@ -128,6 +175,15 @@ void GLUE::Optimize(void)
 
    InitFromFile(GetInFileName());
 
+   if(m_bStreaming == true)
+   {
+      OptimizeStreaming();
+      oTime = (GetElapsedTics() - oStart);
+      MPI_Comm_rank(MPI_COMM_WORLD, &id);
+      if(id == 0){ WriteAlgMetrics(this);}
+      return;
+   }
+
    maxGens = 1+(int)(m_MaxSamples/(long long)m_SamplesPerIter);
 
    mpi_timer_start = GetElapsedTics();
@@ -327,6 +383,13 @@ void GLUE::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Secs not accounted for  : %lf\n\n", oTime - eTotal - gTotal - uTotal - iTime);
    fprintf(pFile, "Serial Count            : %d\n\n", gSerialCount);
 
+   if(m_bStreaming == true)
+   {
+      WriteStreamMetrics(pFile);
+      m_pModel->WriteMetrics(pFile);
+      return;
+   }
+
    fprintf(pFile,"Sample  obj.function  ");
    pGroup->Write(pFile, WRITE_BNR);
    fprintf(pFile,"\n");
@@ -525,6 +588,496 @@ void GLUE::EvalSamplesParallel(void)
    }/* end for() */
 }/* end EvalSamplesParallel() */
 
+/******************************************************************************
+OptimizeStreaming()
+
+Minimize the objective function using GLUE in streaming mode. Samples are 
+generated lazily, by index, from a scrambled Halton sequence. Each processor 
+generates and evaluates its own share of every chunk of samples, so the sample 
+matrix is never stored or broadcast. Behavioral samples are reduced into 
+running statistics and appended to a compact binary file (one file per 
+processor); all other samples are discarded.
+******************************************************************************/
+void GLUE::OptimizeStreaming(void)
+{
+   double sStart, tStart, tEnd, gStart;
+   int num, id, i, j, g, nprocs, maxGens;
+   long long idx, numSamples;
+   double fx, myFound, allFound;
+   double myBest[2];
+   double * pBest;
+   double * pX;
+   char fname[DEF_STR_SZ];
+   int version, ival;
+   bool bLogging;
+   StatusStruct pStatus;
+   ParameterGroup * pGroup;
+
+   sStart = GetElapsedTics();
+
+   //don't fill up OstModel*.txt with (mostly non-behavioral) samples
+   bLogging = GetModelLogging();
+   SetModelLogging(false);
+
+   maxGens = 1+(int)(m_MaxSamples/(long long)m_SamplesPerIter);
+
+   mpi_timer_start = GetElapsedTics();
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   double divisor = (double) m_SamplesPerIter / (double)nprocs;
+   m_iStart=(int)(ceil(divisor*(double)id));
+   m_iEnd=(int)(ceil(divisor*(double)(id+1)));
+   if(m_iEnd > m_SamplesPerIter) m_iEnd = m_SamplesPerIter;
+   mpi_timer_end = GetElapsedTics();
+   mpi_timer_count += (mpi_timer_end - mpi_timer_start);
+
+   if(id == 0)
+   {
+      WriteSetup(m_pModel, "Generalized Likelihood Uncertainty Engine");
+      //write banner
+      WriteBanner(m_pModel, "gen   best value     ", "Num Found");
+   }/* end if() */
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   num = pGroup->GetNumParams();
+
+   //every processor generates the same sequence
+   NEW_PRINT("QuasiRandom", 1);
+   m_pQmc = new QuasiRandom(num, true);
+   MEM_CHECK(m_pQmc);
+   mpi_timer_start = GetElapsedTics();
+   m_pQmc->BcastScramble();
+   mpi_timer_end = GetElapsedTics();
+   mpi_timer_count += (mpi_timer_end - mpi_timer_start);
+
+   InitStreamStats();
+
+   NEW_PRINT("double", num);
+   pX = new double[num];
+   MEM_CHECK(pX);
+
+   NEW_PRINT("double", 2*nprocs);
+   pBest = new double[2*nprocs];
+   MEM_CHECK(pBest);
+
+   //binary file of behavioral samples: header followed by (index, F(x), x) records
+   sprintf(fname, "OstGlueBehavioral%d.bin", id);
+   m_pBinFile = fopen(fname, "wb");
+   if(m_pBinFile == NULL)
+   {
+      FileOpenFailure("GLUE::OptimizeStreaming()", fname);
+   }
+   version = 1;
+   ival = num;
+   fwrite("OSTGLUE", sizeof(char), 8, m_pBinFile);
+   fwrite(&version, sizeof(int), 1, m_pBinFile);
+   fwrite(&ival, sizeof(int), 1, m_pBinFile);
+
+   iTime = GetElapsedTics() - sStart;
+
+   pStatus.curIter = 0;
+   pStatus.pct = 0.00;
+   for(g = 0; g < maxGens; g++)
+   {
+      pStatus.curIter = g+1;
+      if(IsQuit() == true){ break;}
+      if(m_NumFound >= m_NumDesired){ pStatus.pct = 100.00; break;}
+      numSamples = (long long)g*(long long)m_SamplesPerIter;
+      if(numSamples >= m_MaxSamples){ pStatus.pct = 100.00; break;} 
+
+      //generate and evaluate this processors share of the chunk
+      tStart = GetElapsedTics();
+      for(i = m_iStart; i < m_iEnd; i++)
+      {
+         idx = numSamples + (long long)i;
+         if(idx >= m_MaxSamples) break;
+
+         gStart = GetElapsedTics();
+         m_pQmc->GetScaledPoint(idx, m_pLwr, m_pUpr, pX);
+         gTotal += (GetElapsedTics() - gStart);
+
+         pGroup->WriteParams(pX);
+         fx = m_pModel->Execute();
+         m_NumEvaluated += 1.00;
+
+         if(fx < m_BestF){ m_BestF = fx; m_BestIdx = idx;}
+         if(fx < m_Threshold){ AccumulateBehavioral(idx, fx, pX);}
+      }/* end for() */
+      tEnd = GetElapsedTics();
+      eTotal += (tEnd - tStart);
+
+      //only a count and the best sample of each processor are communicated
+      tStart = mpi_timer_start = GetElapsedTics();
+      //stubbed MPI collectives don't copy, so pre-load the receive buffers
+      allFound = myFound = m_NumStats;
+      MPI_Allreduce(&myFound, &allFound, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      m_NumFound = (int)allFound;
+
+      myBest[0] = m_BestF;
+      myBest[1] = (double)m_BestIdx;
+      pBest[0] = myBest[0];
+      pBest[1] = myBest[1];
+      MPI_Gather(myBest, 2, MPI_DOUBLE, pBest, 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      tEnd = mpi_timer_end = GetElapsedTics();
+      mpi_timer_count += (mpi_timer_end - mpi_timer_start);
+
+      if(id == 0)
+      {
+         for(j = 0; j < nprocs; j++)
+         {
+            if(pBest[2*j] < m_BestF)
+            {
+               m_BestF = pBest[2*j];
+               m_BestIdx = (long long)pBest[2*j+1];
+            }
+         }/* end for() */
+         m_pQmc->GetScaledPoint(m_BestIdx, m_pLwr, m_pUpr, pX);
+         pGroup->WriteParams(pX);
+      }/* end if() */
+      uTotal += (GetElapsedTics() - tStart);
+
+      pStatus.pct = ((float)100.00*(float)(g+1))/(float)maxGens;
+      pStatus.numRuns = m_pModel->GetCounter();
+      if(id == 0){ WriteStatus(&pStatus); }
+      if(id == 0){ WriteRecord(m_pModel, (g+1), m_BestF, m_NumFound);}
+   }/* end for() */
+
+   fclose(m_pBinFile);
+   m_pBinFile = NULL;
+
+   //end of the streaming pass, the optimal run is logged as usual
+   SetModelLogging(bLogging);
+
+   MergeStreamStats();
+
+   if(id == 0)
+   { 
+      //place model at optimal prameter set
+      if(m_BestIdx >= 0)
+      {
+         m_pQmc->GetScaledPoint(m_BestIdx, m_pLwr, m_pUpr, pX);
+         pGroup->WriteParams(pX);
+      }
+      m_pModel->Execute();
+
+      WriteOptimal(m_pModel, m_BestF);
+      pStatus.numRuns = m_pModel->GetCounter();
+      WriteStatus(&pStatus);
+   }
+
+   delete [] pX;
+   delete [] pBest;
+} /* end OptimizeStreaming() */
+
+/******************************************************************************
+InitStreamStats()
+
+Allocate and initialize the running statistics of the behavioral samples.
+Sums are accumulated relative to a fixed shift (the midpoint of the parameter
+range or the measured value of the observation) to limit round-off error.
+******************************************************************************/
+void GLUE::InitStreamStats(void)
+{
+   int i, j, num;
+   ParameterGroup * pGroup;
+   ObservationGroup * pObsGroup;
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   num = pGroup->GetNumParams();
+   pObsGroup = m_pModel->GetObsGroupPtr();
+   m_NumObs = 0;
+   if(pObsGroup != NULL) m_NumObs = pObsGroup->GetNumObs();
+
+   NEW_PRINT("double", num);
+   m_pLwr = new double[num];
+   MEM_CHECK(m_pLwr);
+
+   NEW_PRINT("double", num);
+   m_pUpr = new double[num];
+   MEM_CHECK(m_pUpr);
+
+   NEW_PRINT("double", num);
+   m_pPrmShift = new double[num];
+   MEM_CHECK(m_pPrmShift);
+
+   NEW_PRINT("double", num*GLUE_NUM_STATS);
+   m_pPrmStats = new double[num*GLUE_NUM_STATS];
+   MEM_CHECK(m_pPrmStats);
+
+   NEW_PRINT("double", num*m_NumBins);
+   m_pPrmHist = new double[num*m_NumBins];
+   MEM_CHECK(m_pPrmHist);
+
+   for(j = 0; j < num; j++)
+   {
+      m_pLwr[j] = pGroup->GetParamPtr(j)->GetLwrBnd();
+      m_pUpr[j] = pGroup->GetParamPtr(j)->GetUprBnd();
+      m_pPrmShift[j] = 0.5*(m_pLwr[j] + m_pUpr[j]);
+      m_pPrmStats[j*GLUE_NUM_STATS + GLUE_STAT_SUM] = 0.00;
+      m_pPrmStats[j*GLUE_NUM_STATS + GLUE_STAT_SUMSQ] = 0.00;
+      m_pPrmStats[j*GLUE_NUM_STATS + GLUE_STAT_MIN] = HUGE_VAL;
+      m_pPrmStats[j*GLUE_NUM_STATS + GLUE_STAT_MAX] = -HUGE_VAL;
+      for(i = 0; i < m_NumBins; i++) m_pPrmHist[j*m_NumBins + i] = 0.00;
+   }/* end for() */
+
+   if(m_NumObs > 0)
+   {
+      NEW_PRINT("double", m_NumObs);
+      m_pObsShift = new double[m_NumObs];
+      MEM_CHECK(m_pObsShift);
+
+      NEW_PRINT("double", m_NumObs*GLUE_NUM_STATS);
+      m_pObsStats = new double[m_NumObs*GLUE_NUM_STATS];
+      MEM_CHECK(m_pObsStats);
+
+      for(i = 0; i < m_NumObs; i++)
+      {
+         m_pObsShift[i] = pObsGroup->GetObsPtr(i)->GetMeasuredVal(false, false);
+         m_pObsStats[i*GLUE_NUM_STATS + GLUE_STAT_SUM] = 0.00;
+         m_pObsStats[i*GLUE_NUM_STATS + GLUE_STAT_SUMSQ] = 0.00;
+         m_pObsStats[i*GLUE_NUM_STATS + GLUE_STAT_MIN] = HUGE_VAL;
+         m_pObsStats[i*GLUE_NUM_STATS + GLUE_STAT_MAX] = -HUGE_VAL;
+      }/* end for() */
+   }/* end if() */
+   m_NumStats = 0.00;
+} /* end InitStreamStats() */
+
+/******************************************************************************
+AccumulateBehavioral()
+
+Fold a behavioral sample into the running statistics and append it to the 
+binary file of behavioral samples. The model must still hold the output of
+the sample, since the computed observations are used for prediction bounds.
+******************************************************************************/
+void GLUE::AccumulateBehavioral(long long idx, double fx, Ironclad1DArray pX)
+{
+   int i, j, bin, num;
+   double d, v;
+   double * pStat;
+   ObservationGroup * pObsGroup;
+
+   num = m_pQmc->GetDim();
+
+   m_NumStats += 1.00;
+   for(j = 0; j < num; j++)
+   {
+      pStat = &(m_pPrmStats[j*GLUE_NUM_STATS]);
+      d = pX[j] - m_pPrmShift[j];
+      pStat[GLUE_STAT_SUM] += d;
+      pStat[GLUE_STAT_SUMSQ] += d*d;
+      if(pX[j] < pStat[GLUE_STAT_MIN]) pStat[GLUE_STAT_MIN] = pX[j];
+      if(pX[j] > pStat[GLUE_STAT_MAX]) pStat[GLUE_STAT_MAX] = pX[j];
+
+      bin = 0;
+      if(m_pUpr[j] > m_pLwr[j])
+      {
+         bin = (int)((double)m_NumBins*(pX[j] - m_pLwr[j])/(m_pUpr[j] - m_pLwr[j]));
+      }
+      if(bin < 0) bin = 0;
+      if(bin >= m_NumBins) bin = m_NumBins - 1;
+      m_pPrmHist[j*m_NumBins + bin] += 1.00;
+   }/* end for() */
+
+   pObsGroup = m_pModel->GetObsGroupPtr();
+   for(i = 0; i < m_NumObs; i++)
+   {
+      pStat = &(m_pObsStats[i*GLUE_NUM_STATS]);
+      v = pObsGroup->GetObsPtr(i)->GetComputedVal(false, false);
+      d = v - m_pObsShift[i];
+      pStat[GLUE_STAT_SUM] += d;
+      pStat[GLUE_STAT_SUMSQ] += d*d;
+      if(v < pStat[GLUE_STAT_MIN]) pStat[GLUE_STAT_MIN] = v;
+      if(v > pStat[GLUE_STAT_MAX]) pStat[GLUE_STAT_MAX] = v;
+   }/* end for() */
+
+   if(m_pBinFile != NULL)
+   {
+      fwrite(&idx, sizeof(long long), 1, m_pBinFile);
+      fwrite(&fx, sizeof(double), 1, m_pBinFile);
+      fwrite(pX, sizeof(double), num, m_pBinFile);
+   }
+} /* end AccumulateBehavioral() */
+
+/******************************************************************************
+MergeStreamStats()
+
+Combine the running statistics of all processors at the master processor. All 
+of the statistics are packed into a single buffer so that only one gather is 
+needed.
+******************************************************************************/
+void GLUE::MergeStreamStats(void)
+{
+   int i, j, k, p, num, nprocs, id, size;
+   double * pMine, * pAll, * pTheirs;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   num = m_pQmc->GetDim();
+   size = 2 + num*GLUE_NUM_STATS + num*m_NumBins + m_NumObs*GLUE_NUM_STATS;
+
+   NEW_PRINT("double", size);
+   pMine = new double[size];
+   MEM_CHECK(pMine);
+   pAll = NULL;
+   if(id == 0)
+   {
+      NEW_PRINT("double", size*nprocs);
+      pAll = new double[size*nprocs];
+      MEM_CHECK(pAll);
+   }
+
+   k = 0;
+   pMine[k++] = m_NumEvaluated;
+   pMine[k++] = m_NumStats;
+   for(j = 0; j < num*GLUE_NUM_STATS; j++) pMine[k++] = m_pPrmStats[j];
+   for(j = 0; j < num*m_NumBins; j++) pMine[k++] = m_pPrmHist[j];
+   for(j = 0; j < m_NumObs*GLUE_NUM_STATS; j++) pMine[k++] = m_pObsStats[j];
+
+   mpi_timer_start = GetElapsedTics();
+   MPI_Gather(pMine, size, MPI_DOUBLE, pAll, size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   mpi_timer_end = GetElapsedTics();
+   mpi_timer_count += (mpi_timer_end - mpi_timer_start);
+
+   if(id == 0)
+   {
+      for(p = 1; p < nprocs; p++)
+      {
+         pTheirs = &(pAll[p*size]);
+         k = 0;
+         m_NumEvaluated += pTheirs[k++];
+         m_NumStats += pTheirs[k++];
+         for(j = 0; j < num; j++)
+         {
+            i = j*GLUE_NUM_STATS;
+            m_pPrmStats[i + GLUE_STAT_SUM] += pTheirs[k + i + GLUE_STAT_SUM];
+            m_pPrmStats[i + GLUE_STAT_SUMSQ] += pTheirs[k + i + GLUE_STAT_SUMSQ];
+            m_pPrmStats[i + GLUE_STAT_MIN] = MyMin(m_pPrmStats[i + GLUE_STAT_MIN], pTheirs[k + i + GLUE_STAT_MIN]);
+            m_pPrmStats[i + GLUE_STAT_MAX] = MyMax(m_pPrmStats[i + GLUE_STAT_MAX], pTheirs[k + i + GLUE_STAT_MAX]);
+         }
+         k += num*GLUE_NUM_STATS;
+         for(j = 0; j < num*m_NumBins; j++) m_pPrmHist[j] += pTheirs[k++];
+         for(j = 0; j < m_NumObs; j++)
+         {
+            i = j*GLUE_NUM_STATS;
+            m_pObsStats[i + GLUE_STAT_SUM] += pTheirs[k + i + GLUE_STAT_SUM];
+            m_pObsStats[i + GLUE_STAT_SUMSQ] += pTheirs[k + i + GLUE_STAT_SUMSQ];
+            m_pObsStats[i + GLUE_STAT_MIN] = MyMin(m_pObsStats[i + GLUE_STAT_MIN], pTheirs[k + i + GLUE_STAT_MIN]);
+            m_pObsStats[i + GLUE_STAT_MAX] = MyMax(m_pObsStats[i + GLUE_STAT_MAX], pTheirs[k + i + GLUE_STAT_MAX]);
+         }
+      }/* end for() */
+      m_NumFound = (int)m_NumStats;
+   }/* end if() */
+
+   delete [] pMine;
+   delete [] pAll;
+} /* end MergeStreamStats() */
+
+/******************************************************************************
+GetHistogramQuantile()
+
+Estimate a quantile of the behavioral distribution of the given parameter by
+linear interpolation within the parameter histogram.
+******************************************************************************/
+double GLUE::GetHistogramQuantile(int prm, double q)
+{
+   int i;
+   double target, cum, cnt, w;
+   double * pHist = &(m_pPrmHist[prm*m_NumBins]);
+
+   if(m_NumStats <= 0.00) return 0.00;
+
+   w = (m_pUpr[prm] - m_pLwr[prm]) / (double)m_NumBins;
+   target = q*m_NumStats;
+   cum = 0.00;
+   for(i = 0; i < m_NumBins; i++)
+   {
+      cnt = pHist[i];
+      if((cnt > 0.00) && ((cum + cnt) >= target))
+      {
+         return m_pLwr[prm] + w*((double)i + (target - cum)/cnt);
+      }
+      cum += cnt;
+   }
+   return m_pUpr[prm];
+} /* end GetHistogramQuantile() */
+
+/******************************************************************************
+WriteStreamMetrics()
+
+Write out the running statistics of the behavioral samples.
+******************************************************************************/
+void GLUE::WriteStreamMetrics(FILE * pFile)
+{
+   int i, j, num;
+   double n, mean, var;
+   double * pStat;
+   ParameterGroup * pGroup;
+   ObservationGroup * pObsGroup;
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   pObsGroup = m_pModel->GetObsGroupPtr();
+   num = m_pQmc->GetDim();
+   n = m_NumStats;
+
+   fprintf(pFile, "Streaming Mode          : yes (scrambled Halton sequence)\n");
+   fprintf(pFile, "Samples Evaluated       : %.0lf\n", m_NumEvaluated);
+   fprintf(pFile, "Behavioral Samples      : %.0lf\n", n);
+   fprintf(pFile, "Behavioral Sample Files : OstGlueBehavioral*.bin\n");
+   fprintf(pFile, "Best Sample Index       : %lld\n\n", m_BestIdx);
+
+   if(n <= 0.00)
+   {
+      fprintf(pFile, "No behavioral samples were found\n\n");
+      return;
+   }
+
+   fprintf(pFile, "Behavioral Parameter Statistics\n");
+   fprintf(pFile, "Parameter     Mean           Std. Dev.      Minimum        Maximum        ");
+   fprintf(pFile, "5%% Quantile    Median         95%% Quantile\n");
+   for(j = 0; j < num; j++)
+   {
+      pStat = &(m_pPrmStats[j*GLUE_NUM_STATS]);
+      mean = pStat[GLUE_STAT_SUM]/n;
+      var = 0.00;
+      if(n > 1.00) var = (pStat[GLUE_STAT_SUMSQ] - n*mean*mean)/(n - 1.00);
+      if(var < 0.00) var = 0.00;
+      fprintf(pFile, "%-12s  %+E  %+E  %+E  %+E  %+E  %+E  %+E\n", 
+              pGroup->GetParamPtr(j)->GetName(), mean + m_pPrmShift[j], sqrt(var),
+              pStat[GLUE_STAT_MIN], pStat[GLUE_STAT_MAX], GetHistogramQuantile(j, 0.05),
+              GetHistogramQuantile(j, 0.50), GetHistogramQuantile(j, 0.95));
+   }/* end for() */
+
+   if(m_NumObs > 0)
+   {
+      fprintf(pFile, "\nBehavioral Prediction Bounds\n");
+      fprintf(pFile, "Observation   Mean           Std. Dev.      Lower Bound    Upper Bound\n");
+      for(i = 0; i < m_NumObs; i++)
+      {
+         pStat = &(m_pObsStats[i*GLUE_NUM_STATS]);
+         mean = pStat[GLUE_STAT_SUM]/n;
+         var = 0.00;
+         if(n > 1.00) var = (pStat[GLUE_STAT_SUMSQ] - n*mean*mean)/(n - 1.00);
+         if(var < 0.00) var = 0.00;
+         fprintf(pFile, "%-12s  %+E  %+E  %+E  %+E\n", pObsGroup->GetObsPtr(i)->GetName(),
+                 mean + m_pObsShift[i], sqrt(var), pStat[GLUE_STAT_MIN], pStat[GLUE_STAT_MAX]);
+      }/* end for() */
+   }/* end if() */
+
+   fprintf(pFile, "\nBehavioral Parameter Histograms (%d bins, lower bound to upper bound)\n", m_NumBins);
+   for(j = 0; j < num; j++)
+   {
+      fprintf(pFile, "%-12s ", pGroup->GetParamPtr(j)->GetName());
+      for(i = 0; i < m_NumBins; i++)
+      {
+         fprintf(pFile, " %.0lf", m_pPrmHist[j*m_NumBins + i]);
+      }
+      fprintf(pFile, "\n");
+   }/* end for() */
+   fprintf(pFile, "\n");
+} /* end WriteStreamMetrics() */
+
 /******************************************************************************
 InitFromFile()
 
@@ -535,6 +1088,7 @@ void GLUE::InitFromFile(IroncladString pFileName)
    FILE * pFile;
    char * line;
    char tmp[DEF_STR_SZ];
+   char yesno[DEF_STR_SZ];
 
    m_MaxSamples = 100;
    m_NumDesired = 10;
@@ -592,6 +1146,21 @@ void GLUE::InitFromFile(IroncladString pFileName)
          {
             sscanf(line, "%s %lf", tmp, &m_Threshold); 
          }/*end else if() */         
+         else if(strstr(line, "StreamingMode") != NULL)
+         {
+            sscanf(line, "%s %s", tmp, yesno); 
+            MyStrLwr(yesno);
+            if(strncmp(yesno, "yes", 3) == 0) m_bStreaming = true;
+         }/*end else if() */         
+         else if(strstr(line, "HistogramBins") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumBins); 
+            if(m_NumBins < 1)
+            {
+               LogError(ERR_FILE_IO, "Invalid GLUE setting. Defaulting to 20.");
+               m_NumBins = 20;
+            }
+         }/*end else if() */         
          else
          {
             sprintf(tmp, "Unknown token: %s", line);
@@ -21,6 +21,7 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel.
+10-19-26    lsm   The main loop can be checkpointed and resumed (see Checkpoint.h).
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -33,6 +34,7 @@ Version History
 #include "Chromosome.h"
 #include "ChromosomePool.h"
 #include "StatsClass.h"
+#include "Checkpoint.h"
 
 #include "Exception.h"
 #include "Utility.h"
@@ -70,6 +72,7 @@ GeneticAlgorithm::GeneticAlgorithm(ModelABC * pModel)
    MEM_CHECK(m_pPopulation);
    
    m_pStats = NULL;
+   m_pCkpt = NULL;
    IncCtorCount();
 }/* end CTOR() */
 
@@ -82,6 +85,7 @@ void GeneticAlgorithm::Destroy(void)
 {
    delete m_pPopulation;
    delete m_pStats;
+   delete m_pCkpt;
    IncDtorCount();
 }/* end Destroy() */
 
@@ -131,7 +135,8 @@ void GeneticAlgorithm::Optimize(void)
 {
    StatusStruct pStatus;
    int maxGens;
-   int i, id;
+   int i, id, iStart;
+   bool bResume;
    double medFitness;
    //double avgFitness;
    Chromosome * pBest;
@@ -159,7 +164,23 @@ void GeneticAlgorithm::Optimize(void)
    maxGens = m_pPopulation->GetNumGens();
    m_StopVal = m_pPopulation->GetStopVal();  
 
-   if(id == 0)
+   //checkpoints are only taken when the GA is the top-level algorithm
+   bResume = false;
+   iStart = 0;
+   if((GetProgramType() == GA_PROGRAM) || (GetProgramType() == BGA_PROGRAM))
+   {
+      NEW_PRINT("Checkpoint", 1);
+      m_pCkpt = new Checkpoint(m_pModel, "GA");
+      MEM_CHECK(m_pCkpt);
+      bResume = m_pCkpt->Resume();
+      if(bResume == true)
+      {
+         iStart = m_pCkpt->ReadInt();
+         m_pPopulation->ReadCheckpoint(m_pCkpt);
+      }
+   }
+
+   if((id == 0) && (bResume == false))
    {
       //write setup
       WriteSetup(m_pModel, "Real-coded Genetic Algorithm (RGA)");   
@@ -168,7 +189,7 @@ void GeneticAlgorithm::Optimize(void)
    }/* end if() */
 
    pStatus.maxIter = m_MaxGens = maxGens;
-   for(i = 0; i <= maxGens; i++)
+   for(i = iStart; i <= maxGens; i++)
    {
       pStatus.curIter = m_CurGen = i;      
       if(IsQuit() == true){ break;}
@@ -208,6 +229,14 @@ void GeneticAlgorithm::Optimize(void)
 
       //perform intermediate bookkeeping
       m_pModel->Bookkeep(false);
+
+      if((m_pCkpt != NULL) && (m_pCkpt->IsDue() == true))
+      {
+         m_pCkpt->Begin();
+         m_pCkpt->WriteInt(i+1);
+         m_pPopulation->WriteCheckpoint(m_pCkpt);
+         m_pCkpt->End();
+      }
    }/* end for() */
 
    m_pModel->Execute();
@@ -239,6 +268,7 @@ void GeneticAlgorithm::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Max Generations         : %d\n", m_MaxGens);
    fprintf(pFile, "Actual Generations      : %d\n", m_CurGen);
    m_pPopulation->WriteMetrics(pFile);
+   if(m_pCkpt != NULL) m_pCkpt->WriteMetrics(pFile);
    //fprintf(pFile, "Total Evals             : %d\n", m_pModel->GetCounter());
    m_pModel->WriteMetrics(pFile);
    if(m_CurStop <= m_StopVal)
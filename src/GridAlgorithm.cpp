@@ -12,8 +12,11 @@ Version History
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel.
 07-18-07    lsm   Added support for SuperMUSE
+10-19-26    lsm   Added a streaming engine, with optional refinement around the
+                  best cells (see OptimizeStream())
 ******************************************************************************/
 #include <mpi.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -66,6 +69,21 @@ GridAlgorithm::GridAlgorithm(ModelABC * pModel)
    m_MiniSize = 0;
    m_pBest = NULL;
 
+   //streaming engine
+   m_bAsync = false;
+   m_NumLevels = 0;
+   m_NumCells = 10;
+   m_Level = 0;
+   m_Next = 0;
+   m_Stencil = 1;
+   m_Scale = 1;
+   m_pLattice = NULL;
+   m_pCoord = NULL;
+   m_pStart = NULL;
+   m_NumEvals = 0;
+   m_NumRefined = 0;
+   m_NumBatch = 0;
+
    //MPI-parallel communication arrays
    m_pMyBuf  = NULL;
    m_pTmpBuf = NULL;
@@ -103,6 +121,10 @@ void GridAlgorithm::Destroy(void)
    m_MiniSize = 0;   
    delete [] m_pBest;
 
+   delete [] m_pLattice;
+   delete [] m_pCoord;
+   delete [] m_pStart;
+
    delete [] m_pMyBuf;
    delete [] m_pTmpBuf;
    delete [] m_pBigBuf;
@@ -164,6 +186,12 @@ void GridAlgorithm::Optimize(void)
    
    InitFromFile(GetInFileName());
 
+   if(m_bAsync == true)
+   {
+      OptimizeStream();
+      return;
+   }
+
    MPI_Comm_rank(MPI_COMM_WORLD, &id);
 
    //initialize the mini-grid
@@ -291,11 +319,25 @@ void GridAlgorithm::WriteMetrics(FILE * pFile)
    fprintf(pFile, "\n");
 
    fprintf(pFile, "Mini Grid Size          : %d\n", m_MiniSize);
+   if(m_bAsync == true)
+   {
+      fprintf(pFile, "Streaming Engine        : yes\n");
+      fprintf(pFile, "Refinement Levels       : %d\n", m_NumLevels);
+      if(m_NumLevels > 0)
+      {
+         fprintf(pFile, "Refined Cells per Level : %d\n", m_NumCells);
+         fprintf(pFile, "Refinement Evals        : %d\n", m_NumRefined);
+      }
+   }
    
    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
    //fprintf(pFile, "Total Evals             : ");
    
-   if(num_procs > 1)
+   if((num_procs > 1) && (m_bAsync == true))
+   { 
+      fprintf(pFile, "Total Evals             : %d\n", m_NumEvals);
+   }
+   else if(num_procs > 1)
    { 
       fprintf(pFile, "Total Evals             : %d\n", m_GridSize - m_NumLeft);
    }
@@ -480,7 +522,6 @@ evaluations to SuperMUSE clients on a first-come-first-served basis.
 void GridAlgorithm::EvalGridSuperMUSE(void)
 {  
    double val;
-   bool bOk; 
    int i;
    ParameterGroup * pGroup;
    SuperMUSE * pSMUSE = GetSuperMusePtr();
@@ -508,31 +549,30 @@ void GridAlgorithm::EvalGridSuperMUSE(void)
    //Finish task file (this will cause RepeatTasker to begin processing the job)
    pSMUSE->FinishTaskFile();
 
-   //wait for SuperMUSE to report back (via the success or error files)
-   bOk = pSMUSE->WaitForTasker();
+   /* ----------------------------------------------------------------
+   Gather each result as soon as its task completes, in order of 
+   completion, instead of waiting for the whole job.
+   ---------------------------------------------------------------- */
+   while((i = pSMUSE->WaitForNextTask()) >= 0)
+   {
+      /* -----------------------------------------------
+      Stuff the parameter group with ith grid
+      member. This ensures that each objective function 
+      gets associated with the correct parameter values.
+      ------------------------------------------------ */
+      pGroup->WriteParams(m_pMini->p[i]);
+
+      //stuff i-th result into chromosome pool
+      val = pSMUSE->GatherResult(i);
+      m_pMini->f[i] = val;
+   }/* end while() */
 
-   if(bOk == false) //SuperMUSE failed
+   if(i == SMUSE_JOB_FAILED) //SuperMUSE failed
    {
       LogError(ERR_SMUSE, "Reverting to serial execution.");
       DisableSuperMUSE();
       EvaluateGrid();
    }
-   else //SuperMUSE was successful
-   {
-      for(i = 0; i < m_MiniSize; i++)
-      {
-         /* -----------------------------------------------
-         Stuff the parameter group with ith grid
-         member. This ensures that each objective function 
-         gets associated with the correct parameter values.
-         ------------------------------------------------ */
-         pGroup->WriteParams(m_pMini->p[i]);
-
-         //stuff i-th result into chromosome pool
-         val = pSMUSE->GatherResult(i);
-         m_pMini->f[i] = val;
-      }/* end for() */
-   }/* end else() */
 }/* end EvalGridSuperMUSE() */
 
 /******************************************************************************
@@ -553,6 +593,8 @@ void GridAlgorithm::InitFromFile(IroncladString pFileName)
    char * pTok;
    char * line;   
    char tmp[DEF_STR_SZ];
+   char yesno[DEF_STR_SZ];
+   GridKey size;
    
    num = m_pModel->GetParamGroupPtr()->GetNumParams();
 
@@ -621,6 +663,20 @@ void GridAlgorithm::InitFromFile(IroncladString pFileName)
          {
             sscanf(line, "%s %d", tmp, &m_MiniSize);            
          }
+         else if(strstr(line, "Asynchronous") != NULL)
+         {
+            sscanf(line, "%s %s", tmp, yesno);
+            MyStrLwr(yesno);
+            m_bAsync = (strcmp(yesno, "yes") == 0);
+         }
+         else if(strstr(line, "RefineLevels") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumLevels);
+         }
+         else if(strstr(line, "RefineCells") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumCells);
+         }
          else
          {
             sprintf(tmp, "Unknown token: %s", line);
@@ -683,8 +739,401 @@ void GridAlgorithm::InitFromFile(IroncladString pFileName)
    
    m_Rval[num-1] = m_pDims[num-1];
    for(i = num-2; i >= 0; i--) { m_Rval[i] = m_Rval[i+1]*m_pDims[i];}
+
+   /* ---------------------------------------------------------------
+   Lattice of the streaming engine. Refinement uses the streaming 
+   engine, each level halves the grid spacing around the best cells.
+   --------------------------------------------------------------- */
+   if(m_NumLevels < 0) m_NumLevels = 0;
+   if(m_NumCells < 1) m_NumCells = 1;
+   if(m_NumLevels > 0) m_bAsync = true;
+   if(m_NumLevels > 20)
+   {
+      sprintf(tmp, "Too many refinement levels (%d)", m_NumLevels);
+      LogError(ERR_FILE_IO, tmp);
+      ExitProgram(1);
+   }
+   m_Scale = 1 << m_NumLevels;
+
+   NEW_PRINT("int", num);
+   m_pLattice = new int[num];
+   MEM_CHECK(m_pLattice);
+   NEW_PRINT("int", num);
+   m_pCoord = new int[num];
+   MEM_CHECK(m_pCoord);
+
+   size = 1;
+   m_Stencil = 1;
+   for(i = 0; i < num; i++)
+   {
+      if((m_pDims[i] - 1) > ((INT_MAX - 1) / m_Scale))
+      {
+         LogError(ERR_FILE_IO, "Refined grid is too fine");
+         ExitProgram(1);
+      }
+      m_pLattice[i] = (m_pDims[i] - 1)*m_Scale + 1;
+      if(m_NumLevels > 0)
+      {
+         if(size > (ULLONG_MAX / (GridKey)m_pLattice[i]))
+         {
+            LogError(ERR_FILE_IO, "Refined grid is too fine");
+            ExitProgram(1);
+         }
+         size *= (GridKey)m_pLattice[i];
+         if(m_Stencil > (INT_MAX / 3))
+         {
+            LogError(ERR_FILE_IO, "Too many parameters for grid refinement");
+            ExitProgram(1);
+         }
+         m_Stencil *= 3;
+      }
+   }/* end for() */
 } /* end InitFromFile() */
 
+/******************************************************************************
+OptimizeStream()
+
+Minimize the objective function using the streaming engine. Rather than 
+evaluating the grid one mini-grid at a time, grid points are generated by index
+and handed out to processors as soon as they are idle (the master processor 
+only hands out points when running in serial). Results are reported in batches
+of EvalsPerIter points, the median is a running estimate.
+
+With refinement, the grid is then refined RefineLevels times. At each level, 
+the RefineCells best points found so far are taken as the centers of a 3^n 
+stencil whose spacing is half that of the previous level; points that were 
+already evaluated are skipped. Levels are separated by a barrier, since the 
+centers of a level are only known once the previous level is done.
+******************************************************************************/
+void GridAlgorithm::OptimizeStream(void)
+{
+   StatusStruct pStatus;
+   MPI_Status mpi_status;
+   int num, id, nprocs, w, numBusy, j;
+   double f;
+   double * pX;
+   GridKey * pKey;
+   bool * pBusy;
+   bool bQuit;
+   long long total;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   num = m_pMini->nprm;
+
+   //first grid point is replaced by warm start or extracted parameters
+   if(m_pModel->CheckWarmStart() == true)
+   {
+      WarmStart();
+   }
+   if((m_pModel->CheckWarmStart() == true) || 
+      (m_pModel->GetParamGroupPtr()->CheckExtraction() == true))
+   {
+      NEW_PRINT("double", num);
+      m_pStart = new double[num];
+      MEM_CHECK(m_pStart);
+      for(j = 0; j < num; j++) {m_pStart[j] = m_pModel->GetParamGroupPtr()->GetParamPtr(j)->GetEstVal(); }
+   }
+
+   m_Level = 0;
+   m_Next = 0;
+   m_NumEvals = 0;
+   m_NumRefined = 0;
+   m_NumBatch = 0;
+   InitQuantile(&m_Median, 0.50);
+
+   //one iteration per batch, an upper bound when refining
+   total = (long long)m_GridSize + (long long)m_NumLevels*(long long)m_NumCells*(m_Stencil - 1);
+   total = (total + m_MiniSize - 1) / m_MiniSize;
+   m_NumIters = (total > INT_MAX) ? INT_MAX : (int)total;
+
+   if(id != 0)
+   {
+      WorkStream();
+   }
+   else
+   {
+      WriteSetup(m_pModel, "Grid Algorithm (Exhaustive Search)");
+      //write banner
+      WriteBanner(m_pModel, "iter   best value     ", "Median Value");
+
+      NEW_PRINT("double", nprocs*num);
+      pX = new double[nprocs*num];
+      MEM_CHECK(pX);
+      NEW_PRINT("GridKey", nprocs);
+      pKey = new GridKey[nprocs];
+      MEM_CHECK(pKey);
+      NEW_PRINT("bool", nprocs);
+      pBusy = new bool[nprocs];
+      MEM_CHECK(pBusy);
+      for(w = 0; w < nprocs; w++) pBusy[w] = false;
+
+      pStatus.maxIter = m_NumIters;
+      pStatus.curIter = 0;
+      numBusy = 0;
+      bQuit = false;
+      while(true)
+      {
+         //hand out points to idle processors
+         for(w = ((nprocs == 1) ? 0 : 1); (w < nprocs) && (bQuit == false); w++)
+         {
+            if(pBusy[w] == true) continue;
+            if(NextPoint(&(pX[w*num]), &(pKey[w])) == false) break;
+            pBusy[w] = true;
+            numBusy++;
+            if(nprocs > 1)
+            {
+               MPI_Send(&(pX[w*num]), num, MPI_DOUBLE, w, MPI_DATA_TAG, MPI_COMM_WORLD);
+            }
+         }/* end for() */
+
+         //level is done
+         if(numBusy == 0)
+         {
+            if((bQuit == true) || (m_Level >= m_NumLevels)) break;
+            StartLevel();
+            continue;
+         }
+
+         //wait for a result
+         if(nprocs == 1)
+         {
+            w = 0;
+            m_pModel->GetParamGroupPtr()->WriteParams(pX);
+            f = m_pModel->Execute();
+         }
+         else
+         {
+            MPI_Recv(&f, 1, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_RESULTS_TAG, MPI_COMM_WORLD, &mpi_status);
+            w = mpi_status.MPI_SOURCE;
+         }
+         pBusy[w] = false;
+         numBusy--;
+
+         ProcessResult(&(pX[w*num]), pKey[w], f);
+         if(m_NumBatch >= m_MiniSize)
+         {
+            ReportBatch(&pStatus);
+            if(IsQuit() == true){ bQuit = true;}
+         }
+      }/* end while() */
+
+      if(m_NumBatch > 0) ReportBatch(&pStatus);
+
+      //release workers
+      for(w = 1; w < nprocs; w++)
+      {
+         MPI_Send(&f, 1, MPI_DOUBLE, w, MPI_QUIT_TAG, MPI_COMM_WORLD);
+      }
+
+      delete [] pX;
+      delete [] pKey;
+      delete [] pBusy;
+   }/* end else() */
+
+   MPI_Bcast(m_pBest, num+1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+   //place model at optimal prameter set
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pBest);
+   m_pModel->Execute();
+
+   //perform final bookkeeping
+   m_pModel->Bookkeep(true);
+
+   if(id == 0)
+   { 
+      WriteOptimal(m_pModel, m_pBest[num]);
+      pStatus.numRuns = m_NumEvals;
+      WriteStatus(&pStatus);
+      //write algorithm metrics      
+      WriteAlgMetrics(this);
+   }
+} /* end OptimizeStream() */
+
+/******************************************************************************
+WorkStream()
+
+Evaluate points sent by the master processor until told to quit.
+******************************************************************************/
+void GridAlgorithm::WorkStream(void)
+{
+   int num;
+   double f;
+   double * pX;
+
+   num = m_pMini->nprm;
+   NEW_PRINT("double", num);
+   pX = new double[num];
+   MEM_CHECK(pX);
+
+   while(true)
+   {
+      if(RecvWorkMsg(pX, num) == MPI_QUIT_TAG) break;
+
+      m_pModel->GetParamGroupPtr()->WriteParams(pX);
+      f = m_pModel->Execute();
+      MPI_Send(&f, 1, MPI_DOUBLE, 0, MPI_RESULTS_TAG, MPI_COMM_WORLD);
+   }/* end while() */
+
+   delete [] pX;
+} /* end WorkStream() */
+
+/******************************************************************************
+StartLevel()
+
+Start the next refinement level, centered on the best cells found so far.
+******************************************************************************/
+void GridAlgorithm::StartLevel(void)
+{
+   std::priority_queue<GridCell> cells = m_Cells;
+
+   m_Level++;
+   m_Next = 0;
+   m_Centers.clear();
+   while(cells.empty() == false)
+   {
+      m_Centers.push_back(cells.top().second);
+      cells.pop();
+   }
+} /* end StartLevel() */
+
+/******************************************************************************
+NextPoint()
+
+Generate the next point of the current level. Returns false once the level
+is exhausted.
+******************************************************************************/
+bool GridAlgorithm::NextPoint(double * p, GridKey * pKey)
+{
+   int i, j, num, step;
+   long long c, o;
+   GridKey key;
+   bool bOk;
+
+   num = m_pMini->nprm;
+   i = -1;
+   while(true)
+   {
+      if(m_Level == 0) //coarse grid, same ordering as GetGridVal()
+      {
+         if(m_Next >= m_GridSize) return false;
+         i = (int)m_Next++;
+         for(j = 0; j < num; j++)
+         {
+            if(j == (num - 1)) m_pCoord[j] = (i % m_Rval[j]);
+            else               m_pCoord[j] = (i % m_Rval[j])/m_Rval[j+1];
+            m_pCoord[j] *= m_Scale;
+         }
+      }
+      else //stencil around a cell
+      {
+         c = m_Next / m_Stencil;
+         o = m_Next % m_Stencil;
+         if(c >= (long long)m_Centers.size()) return false;
+         m_Next++;
+         if(o == (m_Stencil / 2)) continue; //the cell itself
+
+         key = m_Centers[c];
+         for(j = num - 1; j >= 0; j--)
+         {
+            m_pCoord[j] = (int)(key % (GridKey)m_pLattice[j]);
+            key /= (GridKey)m_pLattice[j];
+         }
+         step = m_Scale >> m_Level;
+         bOk = true;
+         for(j = num - 1; j >= 0; j--)
+         {
+            m_pCoord[j] += ((int)(o % 3) - 1)*step;
+            o /= 3;
+            if((m_pCoord[j] < 0) || (m_pCoord[j] >= m_pLattice[j])){ bOk = false; break;}
+         }
+         if(bOk == false) continue;
+      }/* end else() */
+
+      key = 0;
+      for(j = 0; j < num; j++) key = key*(GridKey)m_pLattice[j] + (GridKey)m_pCoord[j];
+      if((m_NumLevels > 0) && (m_Visited.insert(key).second == false)) continue;
+
+      for(j = 0; j < num; j++)
+      {
+         p[j] = m_Lwr[j] + m_pMini->dp[j]*(double)m_pCoord[j]/(double)m_Scale;
+      }
+      if((i == 0) && (m_pStart != NULL))
+      {
+         for(j = 0; j < num; j++) p[j] = m_pStart[j];
+      }
+      *pKey = key;
+      return true;
+   }/* end while() */
+} /* end NextPoint() */
+
+/******************************************************************************
+ProcessResult()
+
+Account for the objective function value (f) of point (p).
+******************************************************************************/
+void GridAlgorithm::ProcessResult(double * p, GridKey key, double f)
+{
+   int j, num;
+
+   num = m_pMini->nprm;
+   m_NumEvals++;
+   if(m_Level > 0) m_NumRefined++;
+
+   //revise global best
+   if(m_pBest[num] > f)
+   {
+      for(j = 0; j < num; j++) m_pBest[j] = p[j];
+      m_pBest[num] = f;
+   }
+
+   UpdateQuantile(&m_Median, f);
+
+   //keep the best cells
+   if(m_NumLevels > 0)
+   {
+      if((int)m_Cells.size() < m_NumCells){ m_Cells.push(GridCell(f, key));}
+      else if(f < m_Cells.top().first)
+      {
+         m_Cells.pop();
+         m_Cells.push(GridCell(f, key));
+      }
+   }/* end if() */
+
+   //add to the batch
+   if(m_NumBatch == 0) WriteInnerEval(WRITE_GRID, m_MiniSize, '.');
+   for(j = 0; j < num; j++) m_pMini->p[m_NumBatch][j] = p[j];
+   m_pMini->f[m_NumBatch] = f;
+   m_NumBatch++;
+   WriteInnerEval(m_NumBatch, m_MiniSize, '.');
+} /* end ProcessResult() */
+
+/******************************************************************************
+ReportBatch()
+
+Write out the results of the current batch.
+******************************************************************************/
+void GridAlgorithm::ReportBatch(StatusStruct * pStatus)
+{
+   int num = m_pMini->nprm;
+
+   WriteInnerEval(WRITE_ENDED, m_MiniSize, '.');
+   WriteGrid(m_pMini, m_NumBatch);
+   m_NumBatch = 0;
+
+   m_CurIter++;
+   if(m_CurIter > m_NumIters) m_NumIters = m_CurIter;
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pBest);
+   WriteRecord(m_pModel, m_CurIter, m_pBest[num], GetQuantile(&m_Median));
+
+   pStatus->curIter = m_CurIter;
+   pStatus->maxIter = m_NumIters;
+   pStatus->pct = ((float)100.00*(float)m_CurIter)/(float)m_NumIters;
+   pStatus->numRuns = m_NumEvals;
+   WriteStatus(pStatus);
+} /* end ReportBatch() */
+
 /******************************************************************************
 GetGridVal()
 
@@ -3,11 +3,13 @@ File      : Interpolator.h
 Author    : L. Shawn Matott and James Craig
 Copyright : 2004, L. Shawn Matott and James Craig
 
-A class that uses radial basis function to interpolates the value at a given 
+A class that uses radial basis function to interpolates the value at a given
 point, based on known values at a finite set of points.
 
 Version History
 05-25-04    lsm   created
+10-19-26    lsm   contiguous storage of known points, incremental updates
+                  (AddBasis() and ReplaceBasis()) and batched Evaluate()
 ******************************************************************************/
 #include <math.h>
 #include <string.h>
@@ -23,23 +25,211 @@ CTOR
 Interpolator::Interpolator(int nmax)
 {
    int i;
+
    m_MaxOrder = nmax;
+   m_LdX = ((nmax + INTERP_BASIS_BLOCK - 1)/INTERP_BASIS_BLOCK)*INTERP_BASIS_BLOCK;
+   m_Order = 0;
+   m_NumDims = 0;
+   m_AvgVal = 0.00;
+   m_bValid = false;
+   m_NumUpdates = 0;
+   m_RefitOrder = 0;
+   m_NumRefits = 0;
+   m_pX = NULL;
+   m_pV = NULL;
+   m_pQ = NULL;
 
    //allocate memory
-   m_b = new double[nmax];
-   m_A = new double*[nmax];
-   m_Ainv = new double*[nmax];
-   for(i = 0; i < nmax; i++)
-   {
-      m_A[i] = new double[nmax];
-      m_Ainv[i] = new double[nmax];
-   }
-   MEM_CHECK(m_Ainv[i-1]);
-   m_pCoeffs = new double[nmax];
-   m_pRadius = new double[nmax];
+   NEW_PRINT("double", (size_t)nmax*nmax);
+   m_pAinv = new double[(size_t)nmax*nmax];
+   MEM_CHECK(m_pAinv);
+   NEW_PRINT("int", nmax);
+   m_pPiv = new int[nmax];
+   MEM_CHECK(m_pPiv);
+   NEW_PRINT("double", nmax);
+   m_pF = new double[nmax];
+   MEM_CHECK(m_pF);
+   NEW_PRINT("double", m_LdX);
+   m_pCoeffs = new double[m_LdX];
+   MEM_CHECK(m_pCoeffs);
+   NEW_PRINT("double", m_LdX);
+   m_pRadius = new double[m_LdX];
    MEM_CHECK(m_pRadius);
+   for(i = 0; i < m_LdX; i++){ m_pCoeffs[i] = m_pRadius[i] = 0.00;}
+   NEW_PRINT("double", nmax);
+   m_pD2 = new double[nmax];
+   MEM_CHECK(m_pD2);
+   NEW_PRINT("double", nmax);
+   m_pU = new double[nmax];
+   MEM_CHECK(m_pU);
+   NEW_PRINT("double", nmax);
+   m_pW = new double[nmax];
+   MEM_CHECK(m_pW);
+   NEW_PRINT("double", nmax);
+   m_pP = new double[nmax];
+   MEM_CHECK(m_pP);
+
+   IncCtorCount();
 } /* end CTOR() */
 
+/******************************************************************************
+Allocate()
+
+Size the storage of the known points for points of dimension ndim.
+******************************************************************************/
+void Interpolator::Allocate(int ndim)
+{
+   size_t i;
+
+   if((m_pX != NULL) && (ndim == m_NumDims)){ return;}
+
+   delete [] m_pX;
+   delete [] m_pV;
+   delete [] m_pQ;
+   m_NumDims = ndim;
+   NEW_PRINT("double", (size_t)ndim*m_LdX);
+   m_pX = new double[(size_t)ndim*m_LdX];
+   MEM_CHECK(m_pX);
+   for(i = 0; i < (size_t)ndim*m_LdX; i++){ m_pX[i] = 0.00;}
+   NEW_PRINT("double", ndim);
+   m_pV = new double[ndim];
+   MEM_CHECK(m_pV);
+   NEW_PRINT("double", INTERP_QUERY_BLOCK*ndim);
+   m_pQ = new double[INTERP_QUERY_BLOCK*ndim];
+   MEM_CHECK(m_pQ);
+}/* end Allocate() */
+
+/******************************************************************************
+StorePoint()
+
+Store pt as the ith known point.
+******************************************************************************/
+void Interpolator::StorePoint(int i, MyPoint * pt)
+{
+   int k;
+   for(k = 0; k < m_NumDims; k++){ m_pX[(size_t)k*m_LdX + i] = pt->v[k];}
+   m_pF[i] = pt->F;
+}/* end StorePoint() */
+
+/******************************************************************************
+Distances()
+
+Compute the squared distances (d2) from the point v to each of the known
+points, one dimension at a time.
+******************************************************************************/
+void Interpolator::Distances(double * v, double * d2)
+{
+   int i, k, m;
+   double vk, t;
+   double * xk;
+
+   m = m_Order;
+   for(i = 0; i < m; i++){ d2[i] = 0.00;}
+   for(k = 0; k < m_NumDims; k++)
+   {
+      vk = v[k];
+      xk = &(m_pX[(size_t)k*m_LdX]);
+      for(i = 0; i < m; i++)
+      {
+         t = vk - xk[i];
+         d2[i] += t*t;
+      }
+   }/* end for() */
+}/* end Distances() */
+
+/******************************************************************************
+Invert()
+
+Invert, in place, the interpolation matrix stored in m_pAinv using gauss-jordan
+elimination with partial pivoting.
+
+Returns true if successful, false otherwise.
+******************************************************************************/
+bool Interpolator::Invert(void)
+{
+   int i, j, k, p, m;
+   size_t ld;
+   double max, val, sf;
+   double * ai, * ak;
+
+   m = m_Order;
+   ld = (size_t)m_MaxOrder;
+   for(k = 0; k < m; k++)
+   {
+      //determine pivot row
+      p = k;
+      max = fabs(m_pAinv[k*ld + k]);
+      for(i = k + 1; i < m; i++)
+      {
+         val = fabs(m_pAinv[i*ld + k]);
+         if(val > max){ max = val; p = i;}
+      }
+      if(max <= NEARLY_ZERO)
+      {
+         LogError(ERR_SING_MAT, "Interpolator::Invert(): pivot too small");
+         return false;
+      }
+      m_pPiv[k] = p;
+
+      //swap rows
+      ak = &(m_pAinv[k*ld]);
+      if(p != k)
+      {
+         ai = &(m_pAinv[p*ld]);
+         for(j = 0; j < m; j++){ val = ak[j]; ak[j] = ai[j]; ai[j] = val;}
+      }
+
+      //scale pivot row and eliminate column k from the other rows
+      sf = 1.00 / ak[k];
+      ak[k] = 1.00;
+      for(j = 0; j < m; j++){ ak[j] *= sf;}
+      for(i = 0; i < m; i++)
+      {
+         if(i == k){ continue;}
+         ai = &(m_pAinv[i*ld]);
+         sf = ai[k];
+         ai[k] = 0.00;
+         for(j = 0; j < m; j++){ ai[j] -= sf*ak[j];}
+      }
+   }/* end for() */
+
+   //undo the row swaps by swapping columns, in reverse order
+   for(k = m - 1; k >= 0; k--)
+   {
+      p = m_pPiv[k];
+      if(p == k){ continue;}
+      for(i = 0; i < m; i++)
+      {
+         ai = &(m_pAinv[i*ld]);
+         val = ai[k]; ai[k] = ai[p]; ai[p] = val;
+      }
+   }/* end for() */
+
+   return true;
+}/* end Invert() */
+
+/******************************************************************************
+CalcCoeffs()
+
+Compute the coefficients from the inverse of A and the known values.
+******************************************************************************/
+void Interpolator::CalcCoeffs(void)
+{
+   int i, j, m;
+   double sum;
+   double * ai;
+
+   m = m_Order;
+   for(j = 0; j < m; j++){ m_pD2[j] = m_pF[j] - m_AvgVal;}
+   for(i = 0; i < m; i++)
+   {
+      ai = &(m_pAinv[(size_t)i*m_MaxOrder]);
+      sum = 0.00;
+      for(j = 0; j < m; j++){ sum += ai[j]*m_pD2[j];}
+      m_pCoeffs[i] = sum;
+   }
+}/* end CalcCoeffs() */
+
 /******************************************************************************
 Interpolate()
 
@@ -47,55 +237,220 @@ Compute the MQ-RBF (multiquadric radial basis function) coefficients.
 ******************************************************************************/
 double Interpolator::Interpolate(bool bDebug)
 {
-   double * vi, * vj, rj, dij, gij;
-   int i, j, k, ndim;
-   bool test;
+   double * ai;
+   int i, j, k, m;
 
    /*------------------------------------------
-   Set up system of linear equations (Ax = b) 
-   and solve.   
+   Set up system of linear equations (Ax = b)
+   and solve.
    ------------------------------------------*/
+   m_bValid = false;
+   m = m_Order;
+   if(m == 0){ return 0.00;}
 
-   //assign A and b
-   ndim = m_pBasis[0].ndim;
-   for(i = 0; i < m_Order; i++)
+   //assign A, one row at a time
+   for(i = 0; i < m; i++)
    {
-      vi = m_pBasis[i].v;
-
-      m_b[i] = m_pBasis[i].F - m_AvgVal;
-      for(j = 0; j < m_Order; j++)
-      {
-         vj = m_pBasis[j].v;
-         rj = m_pRadius[j];
-         dij = 0.00;
-         for(k = 0; k < ndim; k++)
-         {
-            dij += ((vi[k] - vj[k])*(vi[k] - vj[k]));
-         }
-         gij = sqrt(dij + (rj*rj));
-
-         m_A[i][j] = gij;
-         m_Ainv[i][j] = 0.00;         
-      }/* end for() */
+      for(k = 0; k < m_NumDims; k++){ m_pV[k] = m_pX[(size_t)k*m_LdX + i];}
+      ai = &(m_pAinv[(size_t)i*m_MaxOrder]);
+      Distances(m_pV, ai);
+      for(j = 0; j < m; j++){ ai[j] = sqrt(ai[j] + m_pRadius[j]*m_pRadius[j]);}
    }/* end for() */
 
    //invert A
    if(bDebug == true) fprintf(stdout, "Inverting matrix\n");
-   test = MatInv(m_A, m_Ainv, m_Order);
-
-   if(test == false)
+   if(Invert() == false)
    {
       printf("unable to interpolate.\n");
       return 0.00;
    }
+   m_bValid = true;
+   m_NumUpdates = 0;
+   m_RefitOrder = m;
+   m_NumRefits++;
 
    //pre-multiply b by Ainv and assign result to coeff. array
    if(bDebug == true) fprintf(stdout, "Computing coefficients\n");
-   VectMult(m_Ainv, m_b, m_pCoeffs, m_Order, m_Order);   
-         
+   CalcCoeffs();
+
    return 0.00;
 } /* end Interpolate() */
 
+/******************************************************************************
+AddBasis()
+
+Add pt to the set of known points and update the coefficients. The inverse of
+A is extended by one row and column (bordering), unless it must be recomputed.
+
+Returns false if the interpolator is already at its maximum number of points.
+******************************************************************************/
+bool Interpolator::AddBasis(MyPoint * pt)
+{
+   int i, j, m;
+   size_t ld;
+   double s, r, pi;
+   double * ai, * am;
+
+   m = m_Order;
+   if(m >= m_MaxOrder){ return false;}
+   if(m == 0){ Allocate(pt->ndim);}
+
+   m_AvgVal = (m_AvgVal*m + pt->F)/(double)(m + 1);
+   m_pRadius[m] = 0.00;
+   m_pCoeffs[m] = 0.00;
+
+   //a single point is interpolated by the average
+   if((m == 0) || (m_bValid == false) || (m_NumUpdates >= m_RefitOrder))
+   {
+      StorePoint(m, pt);
+      m_Order++;
+      if(m_Order > 1){ Interpolate(false);}
+      return true;
+   }
+
+   //new column (u) and row (w) of A, and new diagonal element (r)
+   ld = (size_t)m_MaxOrder;
+   r = m_pRadius[m];
+   Distances(pt->v, m_pD2);
+   for(j = 0; j < m; j++)
+   {
+      m_pU[j] = sqrt(m_pD2[j] + r*r);
+      m_pW[j] = sqrt(m_pD2[j] + m_pRadius[j]*m_pRadius[j]);
+   }
+
+   //p = Ainv*u, q = w'*Ainv and the schur complement s = r - w'*p
+   s = fabs(r);
+   for(j = 0; j < m; j++){ m_pD2[j] = 0.00;}
+   for(i = 0; i < m; i++)
+   {
+      ai = &(m_pAinv[i*ld]);
+      pi = 0.00;
+      for(j = 0; j < m; j++){ pi += ai[j]*m_pU[j];}
+      m_pP[i] = pi;
+      s -= m_pW[i]*pi;
+      for(j = 0; j < m; j++){ m_pD2[j] += m_pW[i]*ai[j];}
+   }/* end for() */
+
+   StorePoint(m, pt);
+   m_Order++;
+   if(fabs(s) <= NEARLY_ZERO)
+   {
+      Interpolate(false);
+      return true;
+   }
+
+   //border the inverse
+   s = 1.00 / s;
+   am = &(m_pAinv[m*ld]);
+   for(i = 0; i < m; i++)
+   {
+      ai = &(m_pAinv[i*ld]);
+      pi = m_pP[i]*s;
+      for(j = 0; j < m; j++){ ai[j] += pi*m_pD2[j];}
+      ai[m] = -pi;
+   }
+   for(j = 0; j < m; j++){ am[j] = -m_pD2[j]*s;}
+   am[m] = s;
+
+   m_NumUpdates++;
+   CalcCoeffs();
+   return true;
+}/* end AddBasis() */
+
+/******************************************************************************
+ReplaceBasis()
+
+Replace the ith known point with pt and update the coefficients. Since this
+changes the ith row and column of A, the inverse of A is updated with two
+rank-one (Sherman-Morrison) updates, unless it must be recomputed.
+
+Returns false if there is no ith known point.
+******************************************************************************/
+bool Interpolator::ReplaceBasis(int i, MyPoint * pt)
+{
+   int j, l, m;
+   size_t ld;
+   double d, sf, rj, ri;
+   double * al, * a;
+
+   m = m_Order;
+   if((i < 0) || (i >= m)){ return false;}
+
+   m_AvgVal += (pt->F - m_pF[i])/(double)m;
+
+   if((m == 1) || (m_bValid == false) || (m_NumUpdates >= m_RefitOrder))
+   {
+      StorePoint(i, pt);
+      if(m > 1){ Interpolate(false);}
+      return true;
+   }
+
+   //changes to column i (u) and row i (w) of A, the diagonal is unchanged
+   ld = (size_t)m_MaxOrder;
+   ri = m_pRadius[i];
+   for(l = 0; l < m_NumDims; l++){ m_pV[l] = m_pX[(size_t)l*m_LdX + i];}
+   Distances(m_pV, m_pD2);
+   Distances(pt->v, m_pW);
+   for(j = 0; j < m; j++)
+   {
+      rj = m_pRadius[j];
+      m_pU[j] = sqrt(m_pW[j] + ri*ri) - sqrt(m_pD2[j] + ri*ri);
+      m_pW[j] = sqrt(m_pW[j] + rj*rj) - sqrt(m_pD2[j] + rj*rj);
+   }
+   m_pU[i] = 0.00;
+   m_pW[i] = 0.00;
+   StorePoint(i, pt);
+
+   //column update: Ainv -= (Ainv*u)(row i of Ainv)/(1 + (Ainv*u)[i])
+   for(l = 0; l < m; l++)
+   {
+      al = &(m_pAinv[l*ld]);
+      d = 0.00;
+      for(j = 0; j < m; j++){ d += al[j]*m_pU[j];}
+      m_pP[l] = d;
+   }
+   d = 1.00 + m_pP[i];
+   if(fabs(d) <= NEARLY_ZERO)
+   {
+      Interpolate(false);
+      return true;
+   }
+   a = &(m_pAinv[i*ld]);
+   for(j = 0; j < m; j++){ m_pD2[j] = a[j];}
+   for(l = 0; l < m; l++)
+   {
+      al = &(m_pAinv[l*ld]);
+      sf = m_pP[l]/d;
+      for(j = 0; j < m; j++){ al[j] -= sf*m_pD2[j];}
+   }
+
+   //row update: Ainv -= (column i of Ainv)(w'*Ainv)/(1 + (w'*Ainv)[i])
+   for(j = 0; j < m; j++){ m_pP[j] = 0.00;}
+   for(l = 0; l < m; l++)
+   {
+      al = &(m_pAinv[l*ld]);
+      sf = m_pW[l];
+      if(sf == 0.00){ continue;}
+      for(j = 0; j < m; j++){ m_pP[j] += sf*al[j];}
+   }
+   d = 1.00 + m_pP[i];
+   if(fabs(d) <= NEARLY_ZERO)
+   {
+      Interpolate(false);
+      return true;
+   }
+   for(l = 0; l < m; l++)
+   {
+      al = &(m_pAinv[l*ld]);
+      sf = al[i]/d;
+      for(j = 0; j < m; j++){ al[j] -= sf*m_pP[j];}
+   }
+
+   m_NumUpdates++;
+   CalcCoeffs();
+   return true;
+}/* end ReplaceBasis() */
+
 /******************************************************************************
 Evaluate()
 
@@ -103,26 +458,17 @@ Evualute z = f(x1,x2,x3,...,xn) using the MQ-RBF interpolation.
 ******************************************************************************/
 double Interpolator::Evaluate(MyPoint * point)
 {
-   int i, j, ndim;
-   double sum, ai, gi, di, ri;
-   double * v, *vi;
+   int i, m;
+   double sum, ri;
+
+   m = m_Order;
+   Distances(point->v, m_pD2);
 
    sum = 0.00;
-   v = point->v;
-   ndim = point->ndim;
-   for(i = 0; i < m_Order; i++)
+   for(i = 0; i < m; i++)
    {
-      ai = m_pCoeffs[i];
       ri = m_pRadius[i];
-      vi = m_pBasis[i].v;
-      di = 0.00;
-      for(j = 0; j < ndim; j++)
-      {
-         di += ((v[j] - vi[j])*(v[j] - vi[j]));
-      }
-      gi = sqrt(di + (ri*ri));
-
-      sum += (ai * gi);
+      sum += m_pCoeffs[i]*sqrt(m_pD2[i] + ri*ri);
    }/* end for() */
 
    sum += m_AvgVal;
@@ -132,6 +478,75 @@ double Interpolator::Evaluate(MyPoint * point)
    return sum;
 } /* end Evaluate() */
 
+/******************************************************************************
+Evaluate()
+
+Evaluate the MQ-RBF interpolation at each of n points, storing the results in
+the F member of the points.
+******************************************************************************/
+void Interpolator::Evaluate(MyPoint * points, int n)
+{
+   int i, j, k, q, nq, i0, m;
+   double t, r2, v0, v1, v2, v3, s0, s1, s2, s3;
+   double * xk, * pC;
+   //squared distances of the queries to a block of known points
+   double b0[INTERP_BASIS_BLOCK], b1[INTERP_BASIS_BLOCK];
+   double b2[INTERP_BASIS_BLOCK], b3[INTERP_BASIS_BLOCK];
+
+   //known points are padded to whole blocks, with zero coefficients
+   m = m_Order;
+
+   //queries are evaluated four at a time, the last one is repeated as needed
+   for(q = 0; q < n; q += INTERP_QUERY_BLOCK)
+   {
+      nq = n - q;
+      if(nq > INTERP_QUERY_BLOCK){ nq = INTERP_QUERY_BLOCK;}
+      for(j = 0; j < INTERP_QUERY_BLOCK; j++)
+      {
+         i = q + ((j < nq) ? j : (nq - 1));
+         for(k = 0; k < m_NumDims; k++){ m_pQ[j*m_NumDims + k] = points[i].v[k];}
+      }
+
+      s0 = s1 = s2 = s3 = 0.00;
+      for(i0 = 0; i0 < m; i0 += INTERP_BASIS_BLOCK)
+      {
+         //squared distances to a block of known points
+         for(i = 0; i < INTERP_BASIS_BLOCK; i++){ b0[i] = b1[i] = b2[i] = b3[i] = 0.00;}
+         for(k = 0; k < m_NumDims; k++)
+         {
+            xk = &(m_pX[(size_t)k*m_LdX + i0]);
+            v0 = m_pQ[k];
+            v1 = m_pQ[m_NumDims + k];
+            v2 = m_pQ[2*m_NumDims + k];
+            v3 = m_pQ[3*m_NumDims + k];
+            for(i = 0; i < INTERP_BASIS_BLOCK; i++)
+            {
+               t = v0 - xk[i]; b0[i] += t*t;
+               t = v1 - xk[i]; b1[i] += t*t;
+               t = v2 - xk[i]; b2[i] += t*t;
+               t = v3 - xk[i]; b3[i] += t*t;
+            }
+         }/* end for() */
+
+         //basis functions
+         pC = &(m_pCoeffs[i0]);
+         for(i = 0; i < INTERP_BASIS_BLOCK; i++)
+         {
+            r2 = m_pRadius[i0 + i]*m_pRadius[i0 + i];
+            s0 += pC[i]*sqrt(b0[i] + r2);
+            s1 += pC[i]*sqrt(b1[i] + r2);
+            s2 += pC[i]*sqrt(b2[i] + r2);
+            s3 += pC[i]*sqrt(b3[i] + r2);
+         }
+      }/* end for() */
+
+      points[q].F = s0 + m_AvgVal;
+      if(nq > 1){ points[q + 1].F = s1 + m_AvgVal;}
+      if(nq > 2){ points[q + 2].F = s2 + m_AvgVal;}
+      if(nq > 3){ points[q + 3].F = s3 + m_AvgVal;}
+   }/* end for() */
+} /* end Evaluate() */
+
 /******************************************************************************
 Destroy
 
@@ -139,43 +554,53 @@ Destructor.
 ******************************************************************************/
 void Interpolator::Destroy(void)
 {
-   int i;
    delete [] m_pCoeffs;
    delete [] m_pRadius;
 
    /*------------------------------------------
    Free up matrices and vectors
-   ------------------------------------------*/   
-   delete [] m_b;
-   for(i = 0; i < m_MaxOrder; i++)
-   {
-      delete [] m_A[i];
-      delete [] m_Ainv[i];
-   }
-   delete [] m_A;
-   delete [] m_Ainv;
+   ------------------------------------------*/
+   delete [] m_pAinv;
+   delete [] m_pPiv;
+   delete [] m_pF;
+   delete [] m_pX;
+   delete [] m_pD2;
+   delete [] m_pU;
+   delete [] m_pW;
+   delete [] m_pP;
+   delete [] m_pV;
+   delete [] m_pQ;
+
+   IncDtorCount();
 } /* end DTOR */
 
 /******************************************************************************
 SetBasis()
 
-Assign a new set of known points to interpolate from.
+Assign a new set of known points to interpolate from. The coefficients are
+computed by Interpolate().
 ******************************************************************************/
 void Interpolator::SetBasis(MyPoint * vals, int n)
 {
    int i;
-   m_pBasis = vals;
-   m_Order = n;
    if(n > m_MaxOrder) n = m_MaxOrder;
+   m_Order = n;
+   m_bValid = false;
+   if(n <= 0){ m_Order = 0; return;}
+   Allocate(vals[0].ndim);
 
-   //compute average F value
+   //store points and compute average F value
    m_AvgVal = 0.00;
-   for(i = 0; i < n; i++){ m_AvgVal += vals[i].F;}
+   for(i = 0; i < n; i++)
+   {
+      StorePoint(i, &(vals[i]));
+      m_AvgVal += vals[i].F;
+   }
    m_AvgVal /= (double)n;
 
    //zero coeffs.
-   for(i = 0; i < n; i++){ m_pCoeffs[i] = 0.00;}
+   for(i = 0; i < m_LdX; i++){ m_pCoeffs[i] = 0.00;}
 
    //zero radii
-   for(i = 0; i < n; i++){ m_pRadius[i] = 0.00;}
+   for(i = 0; i < m_LdX; i++){ m_pRadius[i] = 0.00;}
 }/* end SetBasis() */
@@ -28,6 +28,8 @@ Version History
                   for the detection of temporarily insensitive parameters and
                   observations; when detected such insensitive terms are "held",
                   i.e. removed from consideration during the given iteration.
+10-19-26    lsm   AdjustLambda() no longer restores snapshots that the model 
+                  already holds.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -468,13 +470,16 @@ void LevenbergAlgorithm::AdjustLambda(void)
    m_pInitBkup->SemiRestore();
    phiInc = TryLambda(lamInc); //increased lambda trial
    m_pIncBkup->Store();
-   m_pInitBkup->SemiRestore();
 
    iter = 3;
 
-   //check to see if none of the lambda adjustments were effective
+   /* 
+   The model is restored from one of the snapshots below, so it only needs to be 
+   restored to the initial snapshot if none of the lambda adjustments were effective.
+   */
    if((m_Phi < phiConst) && (m_Phi < phiDec) && (m_Phi < phiInc))
    {
+      m_pInitBkup->SemiRestore();
       m_Lambda /= m_LamSF;
       WriteInnerEval(WRITE_ENDED, m_MaxLambdas, 'n');
       return;
@@ -496,8 +501,7 @@ void LevenbergAlgorithm::AdjustLambda(void)
          if((m_PhiRatio < m_RatioConv) || 
             ((m_PhiRelRed < m_RelRedConv) && (m_PhiRelRed > 0.00)))
          {
-            //update phi, lambda
-			m_pDecBkup->SemiRestore();
+            //update phi, lambda (the model already holds the m_pDecBkup snapshot)
             m_Phi = phiDec;
             m_Lambda = lamDec;
             WriteInnerEval(WRITE_ENDED, m_MaxLambdas, 'c');
@@ -537,8 +541,7 @@ void LevenbergAlgorithm::AdjustLambda(void)
          if((m_PhiRatio < m_RatioConv) || 
             ((m_PhiRelRed < m_RelRedConv) && (m_PhiRelRed > 0.00)))
          {
-            //update phi, lambda            
-			m_pIncBkup->SemiRestore();
+            //update phi, lambda (the model already holds the m_pIncBkup snapshot)
             m_Phi = phiInc;
             m_Lambda = lamInc;
             WriteInnerEval(WRITE_ENDED, m_MaxLambdas, 'c');
@@ -35,6 +35,9 @@ software/hardware arising from the use of these codes.
 
 Version History
 12-28-17    lsm   added copyright information and initial comments.
+10-19-26    lsm   added asynchronous master-worker mode (Asynchronous yes|no).
+10-19-26    lsm   archive kept in a MOPSOCD_Archive, with incremental crowding
+                  distances and dominance checks on ordered indices.
 ******************************************************************************/
 
 #include <mpi.h>
@@ -69,7 +72,6 @@ MOPSOCD::MOPSOCD(ModelABC * pModel)
    m_NonDomListSize = 0;
    m_DomListSize = 0;
 
-   m_NumNonDom = 0;
    m_PopSize = 0;
    m_MaxGen = 0;
    m_CurIter = 0;
@@ -78,14 +80,26 @@ MOPSOCD::MOPSOCD(ModelABC * pModel)
    m_PI = 4.0*atan(1.0);
    m_ProbMut = 0.5;
 
-   m_ArchiveVar = NULL;
-   m_ArchiveFit = NULL;
    m_PopVar = NULL;
    m_PopFit = NULL;
    m_PbestsVar = NULL;
    m_PbestsFit = NULL;
    m_Velocity = NULL;
-   m_CrowdDist = NULL;
+   m_pArchive = NULL;
+
+   m_bAsync = false;
+   m_pQueue = NULL;
+   m_pEvaled = NULL;
+   m_pAsyncF = NULL;
+
+   //scratch space for the ranges of the archive, used by mutation
+   NEW_PRINT("double", m_NumVar);
+   m_pMinValue = new double[m_NumVar];
+   MEM_CHECK(m_pMinValue);
+
+   NEW_PRINT("double", m_NumVar);
+   m_pMaxValue = new double[m_NumVar];
+   MEM_CHECK(m_pMaxValue);
 
    IncCtorCount();
 }/* end CTOR() */
@@ -119,14 +133,6 @@ void MOPSOCD::Destroy(void)
       delete pDel;
    }
 
-   for (i = 0; i < m_ArchiveSize; i++)
-   {
-      delete [] m_ArchiveVar[i];
-      delete [] m_ArchiveFit[i];
-   }
-   delete[] m_ArchiveVar;
-   delete[] m_ArchiveFit;
-
    for (i = 0; i < m_PopSize; i++)
    {
       delete[] m_PopVar[i];
@@ -149,7 +155,13 @@ void MOPSOCD::Destroy(void)
    }
    delete[] m_Velocity;
 
-   delete [] m_CrowdDist;
+   delete m_pArchive;
+
+   delete [] m_pQueue;
+   delete [] m_pEvaled;
+   delete [] m_pAsyncF;
+   delete [] m_pMinValue;
+   delete [] m_pMaxValue;
 
    IncDtorCount();
 }/* end Destroy() */
@@ -172,20 +184,17 @@ Search for the pareto front using MOPSOCD.
 void MOPSOCD::Optimize(void)
 {
    char archiveName[20];
-   int i, j, g, myrank, nprocs;
+   int myrank, nprocs;
    clock_t  startTime, endTime;
-   double duration, clocktime;
+   double duration;
    FILE *outfile, *plotfile;
 
    StatusStruct pStatus;
-   ParameterGroup * pGroup;
    outfile = NULL;
    plotfile = NULL;
 
    InitFromFile(GetInFileName());
 
-   pGroup = m_pModel->GetParamGroupPtr();
-
    /* get rank and num procs */
    MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
@@ -208,7 +217,8 @@ void MOPSOCD::Optimize(void)
    startTime = clock();
 
    /* Initialize generation counter */
-   m_CurIter = g = 0;
+   m_CurIter = 0;
+   pStatus.curIter = 0;
 
    /* Initialize population with random values */
    initialize_pop();
@@ -216,6 +226,64 @@ void MOPSOCD::Optimize(void)
    /* Initialize velocity */
    initialize_vel();
 
+   if(m_bAsync == true)
+   {
+      optimize_async(myrank, nprocs, outfile, plotfile, startTime, &pStatus);
+   }
+   else
+   {
+      optimize_sync(myrank, nprocs, outfile, plotfile, startTime, &pStatus);
+   }
+
+   /* collect the evaluations of all processors (the master of the 
+      asynchronous mode doesn't execute the model itself) */
+   m_pModel->Bookkeep(true);
+
+   /* workers of the asynchronous mode have nothing to report */
+   if((m_bAsync == true) && (myrank != 0))
+   {
+      return;
+   }
+
+   /* Write results to file */
+   if(myrank == 0)
+   {
+      save_results(archiveName);
+   }
+
+   /* Compute time duration */
+   endTime = clock();
+   duration = (endTime - startTime) / (double)CLOCKS_PER_SEC;
+   if (myrank == 0)
+   {
+      fprintf(stdout, "%lf sec\n", duration);
+   
+      fclose(outfile);
+      fclose(plotfile);
+
+      WriteMultiObjOptimal(m_pModel, m_pNonDomList, m_pDomList);
+      pStatus.numRuns = m_pModel->GetCounter();
+      WriteStatus(&pStatus);
+      //write algorithm metrics
+      WriteAlgMetrics(this);
+   }
+} /* end Optimize() */
+
+/******************************************************************************
+optimize_sync()
+
+The generational MOPSOCD loop. Each generation the whole population is
+evaluated (striped across processors if there are several) before the archive
+and the personal bests are updated.
+******************************************************************************/
+void MOPSOCD::optimize_sync(int myrank, int nprocs, FILE * outfile, FILE * plotfile,
+                            clock_t startTime, StatusStruct * pStatus)
+{
+   int g;
+   double clocktime;
+
+   g = 0;
+
    //Update run record to indicate onset of PSO sampling 
    if(myrank == 0)
    {
@@ -235,18 +303,14 @@ void MOPSOCD::Optimize(void)
    if(myrank == 0)
    {
       /* update OSTRICH run record and status file */
-      WriteInnerEval(WRITE_ENDED, 0, '.');
-      pStatus.pct = ((float)100.00*(float)(g)) / (float)m_MaxGen;
-      pStatus.numRuns = (g + 1)*m_PopSize;
-      WriteMultiObjRecord(m_pModel, g, m_pNonDomList, pStatus.pct);
-      WriteStatus(&pStatus);
+      report_progress(g, 0.00, outfile, plotfile, pStatus);
    }
 
    /* Store initial personal bests (both variable and fitness values) of particles */
    store_pbests();
 
    /* Insert nondominated particles in population into the archive */
-   insert_nondom();
+   update_archive();
 
    /******* MAIN OPTIMIZATION LOOP *********/
    g = 1;
@@ -254,38 +318,10 @@ void MOPSOCD::Optimize(void)
    {
       clocktime = (clock() - startTime) / (double)CLOCKS_PER_SEC;
 
-      pStatus.curIter = m_CurIter = g;
+      pStatus->curIter = m_CurIter = g;
 
       if (IsQuit() == true){ break; }
 
-      /* report progress to stdout */
-      if ((MOPSOCD_VERBOSE > 0) && (((g % MOPSOCD_PRINT_EVERY) == 0) || (g == m_MaxGen)))
-      { 
-         if(myrank == 0)
-         {
-            fprintf(stdout, "Generation: %d      Time: %.2f sec\n", g, clocktime);
-            fflush(stdout);
-         }
-      }
-
-      /* report progress to out file */
-      if ((g % MOPSOCD_PRINT_EVERY) == 0 || g == m_MaxGen)
-      {
-         if(myrank == 0)
-         {
-            fprintf(outfile, "Generation: %d     Time: %.2f sec\n", g, clocktime);
-         }
-      }
-
-      /* ------------------------------------------------------------
-         Compute crowding distance of each particle in the archive. 
-         Must be at least 3 particles in the archive.
-      ------------------------------------------------------------ */
-      if (m_NumNonDom > 2)
-      {
-         crowding();
-      }
-
       /* Compute new velocity of each particle in the population */
       compute_velocity();
 
@@ -320,87 +356,320 @@ void MOPSOCD::Optimize(void)
       /* Update personal bests of particles in the population */
       update_pbests();
 
-      /* write out best so far */
-      if (((g % MOPSOCD_PRINT_EVERY) == 0) || (g == m_MaxGen))
+      /* report progress, write out best so far and update OSTRICH run record */
+      if(myrank == 0)
+      {
+         report_progress(g, clocktime, outfile, plotfile, pStatus);
+      }
+
+      /* Increment generation counter */
+      g++;
+   }/* end while() */
+} /* end optimize_sync() */
+
+/******************************************************************************
+optimize_async()
+
+Asynchronous master-worker variant of the MOPSOCD loop. Particles wait in a
+queue to be evaluated. Each returned evaluation immediately updates the
+archive and the personal best of its particle, which is then moved and put
+back in the queue, so that no processor waits for the slowest particle of a
+generation. With several processors the master (rank 0) dispatches particles
+to the workers; otherwise particles are evaluated in-process, in queue order.
+The budget is that of the synchronous mode, m_PopSize*(m_MaxGen+1) evaluations,
+and progress is reported every m_PopSize evaluations.
+******************************************************************************/
+void MOPSOCD::optimize_async(int myrank, int nprocs, FILE * outfile, FILE * plotfile,
+                             clock_t startTime, StatusStruct * pStatus)
+{
+   MPI_Status mpi_status;
+   ParameterGroup * pGroup;
+   double clocktime;
+   int * pAssigned; /* particle being evaluated by each worker, -1 if idle */
+   int i, k, w, g, head, numQueued, numEvals, numSent, numDone;
+   bool bQuit;
+
+   if(myrank != 0)
+   {
+      work_async();
+      return;
+   }
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   numEvals = m_PopSize * (m_MaxGen + 1);
+
+   pAssigned = new int[nprocs];
+   for(w = 0; w < nprocs; w++)
+   {
+      pAssigned[w] = -1;
+   }
+
+   /* initially, every particle waits for evaluation */
+   for(i = 0; i < m_PopSize; i++)
+   {
+      m_pQueue[i] = i;
+      m_pEvaled[i] = false;
+   }
+   head = 0;
+   numQueued = m_PopSize;
+
+   //Update run record to indicate onset of PSO sampling 
+   WriteInnerEval(WRITE_PSO, m_PopSize, '.');
+
+   numSent = numDone = 0;
+   bQuit = false;
+   while(true)
+   {
+      if(nprocs == 1)
       {
-         if(myrank == 0)
+         /* local evaluator: next particle in the queue */
+         if((bQuit == true) || (numSent == numEvals))
          {
-            fprintf(outfile, "Size of Pareto Set: %d\n\n", m_NumNonDom);
-            for (i = 0; i < m_NumNonDom; i++)
-            {
-               fprintf(outfile, "Parameter Values:\n");
-               for (j = 0; j < m_NumVar; j++)
-               {
-                  fprintf(outfile, "   %E\n", m_ArchiveVar[i][j]);
-               }
-
-               fprintf(outfile, "Obj. Function Values:\n");
-               for (j = 0; j < m_NumFun; j++)
-               {
-                  fprintf(outfile, "   %E\n", m_ArchiveFit[i][j]);
-               }
-               fprintf(outfile, "\n");
-            }/* end for() */
+            break;
+         }
+         k = m_pQueue[head];
+         head = (head + 1) % m_PopSize;
+         numQueued--;
+         numSent++;
 
-            fflush(outfile);
-         }/* end if() */
+         pGroup->WriteParams(m_PopVar[k]);
+         m_pModel->Execute(m_PopFit[k], m_NumFun);
       }/* end if() */
-
-      /* write out GNU plot file */
-      if(g == m_MaxGen) 
+      else
       {
-         if(myrank == 0)
+         /* keep the workers busy */
+         for(w = 1; (w < nprocs) && (numQueued > 0) && (numSent < numEvals) && (bQuit == false); w++)
          {
-            fprintf(plotfile, "# GNU Plot\n");
-            for (i = 0; i < m_NumNonDom; i++) 
+            if(pAssigned[w] == -1)
             {
-               for (j = 0; j < m_NumFun; j++)
-               {
-                  fprintf(plotfile, "%.4f ", m_ArchiveFit[i][j]);
-               }
-               fprintf(plotfile, "\n");
+               k = m_pQueue[head];
+               head = (head + 1) % m_PopSize;
+               numQueued--;
+               numSent++;
+
+               pAssigned[w] = k;
+               MPI_Send(m_PopVar[k], m_NumVar, MPI_DOUBLE, w, MPI_DATA_TAG, MPI_COMM_WORLD);
             }
-            fflush(plotfile);
-         }/* end if() */
+         }/* end for() */
+
+         /* done once nothing is being evaluated */
+         if(numDone == numSent)
+         {
+            break;
+         }
+
+         /* first result to come back */
+         MPI_Recv(m_pAsyncF, m_NumFun, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_RESULTS_TAG, MPI_COMM_WORLD, &mpi_status);
+         w = mpi_status.MPI_SOURCE;
+         k = pAssigned[w];
+         pAssigned[w] = -1;
+         for(i = 0; i < m_NumFun; i++)
+         {
+            m_PopFit[k][i] = m_pAsyncF[i];
+         }
+      }/* end else() */
+
+      numDone++;
+
+      /* update archive and personal best, move the particle and queue it */
+      process_result(k, numDone);
+      m_pQueue[(head + numQueued) % m_PopSize] = k;
+      numQueued++;
+
+      /* a generation is m_PopSize evaluations */
+      if((numDone % m_PopSize) == 0)
+      {
+         g = (numDone / m_PopSize) - 1;
+         pStatus->curIter = m_CurIter = g;
+         clocktime = (clock() - startTime) / (double)CLOCKS_PER_SEC;
+         report_progress(g, clocktime, outfile, plotfile, pStatus);
+
+         if(IsQuit() == true)
+         {
+            bQuit = true;
+         }
+         else if(numDone < numEvals)
+         {
+            WriteInnerEval(WRITE_PSO, m_PopSize, '.');
+         }
       }/* end if() */
+   }/* end while() */
 
-      /* update OSTRICH run record and status file */
-      if(myrank == 0)
+   /* release the workers */
+   for(w = 1; w < nprocs; w++)
+   {
+      MPI_Send(m_pAsyncF, 1, MPI_DOUBLE, w, MPI_QUIT_TAG, MPI_COMM_WORLD);
+   }
+
+   delete [] pAssigned;
+} /* end optimize_async() */
+
+/******************************************************************************
+work_async()
+
+Worker side of the asynchronous mode: evaluate the particles sent by the
+master until told to quit.
+******************************************************************************/
+void MOPSOCD::work_async(void)
+{
+   ParameterGroup * pGroup;
+   double * X;
+
+   pGroup = m_pModel->GetParamGroupPtr();
+   X = new double[m_NumVar];
+
+   while(true)
+   {
+      if(RecvWorkMsg(X, m_NumVar) == MPI_QUIT_TAG)
       {
-         WriteInnerEval(WRITE_ENDED, 0, '.');     
-         pStatus.pct = ((float)100.00*(float)(g)) / (float)m_MaxGen;
-         pStatus.numRuns = (g + 1)*m_PopSize;
-         WriteMultiObjRecord(m_pModel, g, m_pNonDomList, pStatus.pct);
-         WriteStatus(&pStatus);
+         break;
       }
 
-      /* Increment generation counter */
-      g++;
+      pGroup->WriteParams(X);
+      m_pModel->Execute(m_pAsyncF, m_NumFun);
+
+      MPI_Send(m_pAsyncF, m_NumFun, MPI_DOUBLE, 0, MPI_RESULTS_TAG, MPI_COMM_WORLD);
    }/* end while() */
 
-   /* Write results to file */
-   if(myrank == 0)
+   delete [] X;
+} /* end work_async() */
+
+/******************************************************************************
+process_result()
+
+Asynchronous mode: the i-th particle has just been evaluated (the numDone-th
+evaluation overall). Record the evaluation, insert the particle into the
+archive if it is nondominated, update its personal best and move it to its
+next position. The generation used for mutation is the one the next position
+belongs to in the synchronous mode.
+******************************************************************************/
+void MOPSOCD::process_result(int i, int numDone)
+{
+   int j, g, result;
+   double * F, * X;
+
+   /* the copies are kept by the lists of dominated and non-dominated solutions */
+   NEW_PRINT("double", m_NumVar);
+   X = new double[m_NumVar];
+   MEM_CHECK(X);
+
+   NEW_PRINT("double", m_NumFun);
+   F = new double[m_NumFun];
+   MEM_CHECK(F);
+
+   for(j = 0; j < m_NumVar; j++)
    {
-      save_results(archiveName);
+      X[j] = m_PopVar[i][j];
+   }
+   for(j = 0; j < m_NumFun; j++)
+   {
+      F[j] = m_PopFit[i][j];
    }
 
-   /* Compute time duration */
-   endTime = clock();
-   duration = (endTime - startTime) / (double)CLOCKS_PER_SEC;
-   if (myrank == 0)
+   result = UpdateLists(X, m_NumVar, F, m_NumFun);
+   if (result == ARCHIVE_NON_DOM)
    {
-      fprintf(stdout, "%lf sec\n", duration);
-   
-      fclose(outfile);
-      fclose(plotfile);
+      WriteInnerEval(((numDone - 1) % m_PopSize) + 1, m_PopSize, '+');
+   }/* end if() */
+   else
+   {
+      WriteInnerEval(((numDone - 1) % m_PopSize) + 1, m_PopSize, '-');
+   }/* end else() */
 
-      WriteMultiObjOptimal(m_pModel, m_pNonDomList, m_pDomList);
-      pStatus.numRuns = m_pModel->GetCounter();
-      WriteStatus(&pStatus);
-      //write algorithm metrics
-      WriteAlgMetrics(this);
+   /* Insert particle into archive, if nondominated */
+   update_archive(i);
+
+   /* Store or update personal best of the particle */
+   if(m_pEvaled[i] == false)
+   {
+      store_pbest(i);
+      m_pEvaled[i] = true;
    }
-} /* end Optimize() */
+   else
+   {
+      update_pbest(i);
+   }
+
+   /* Move the particle */
+   compute_velocity(i);
+   maintain_particle(i);
+
+   g = (numDone + m_PopSize - 1) / m_PopSize;
+   if (g < (m_MaxGen * m_ProbMut))
+   {
+      get_ranges(m_pMinValue, m_pMaxValue);
+      mutate_particle(i, g, m_pMinValue, m_pMaxValue);
+   }
+} /* end process_result() */
+
+/******************************************************************************
+report_progress()
+
+Report progress of the g-th generation (g = 0 is the initial population):
+progress and best so far in the output file, the GNU plot file after the last
+generation, and the OSTRICH run record and status file.
+******************************************************************************/
+void MOPSOCD::report_progress(int g, double clocktime, FILE * outfile, FILE * plotfile,
+                              StatusStruct * pStatus)
+{
+   int i, j;
+
+   if(g > 0)
+   {
+      /* report progress to stdout */
+      if ((MOPSOCD_VERBOSE > 0) && (((g % MOPSOCD_PRINT_EVERY) == 0) || (g == m_MaxGen)))
+      { 
+         fprintf(stdout, "Generation: %d      Time: %.2f sec\n", g, clocktime);
+         fflush(stdout);
+      }
+
+      /* report progress and write out best so far */
+      if (((g % MOPSOCD_PRINT_EVERY) == 0) || (g == m_MaxGen))
+      {
+         fprintf(outfile, "Generation: %d     Time: %.2f sec\n", g, clocktime);
+         fprintf(outfile, "Size of Pareto Set: %d\n\n", m_pArchive->GetSize());
+         for (i = 0; i < m_pArchive->GetSize(); i++)
+         {
+            fprintf(outfile, "Parameter Values:\n");
+            for (j = 0; j < m_NumVar; j++)
+            {
+               fprintf(outfile, "   %E\n", m_pArchive->GetVar(i)[j]);
+            }
+
+            fprintf(outfile, "Obj. Function Values:\n");
+            for (j = 0; j < m_NumFun; j++)
+            {
+               fprintf(outfile, "   %E\n", m_pArchive->GetFit(i)[j]);
+            }
+            fprintf(outfile, "\n");
+         }/* end for() */
+
+         fflush(outfile);
+      }/* end if() */
+
+      /* write out GNU plot file */
+      if(g == m_MaxGen) 
+      {
+         fprintf(plotfile, "# GNU Plot\n");
+         for (i = 0; i < m_pArchive->GetSize(); i++) 
+         {
+            for (j = 0; j < m_NumFun; j++)
+            {
+               fprintf(plotfile, "%.4f ", m_pArchive->GetFit(i)[j]);
+            }
+            fprintf(plotfile, "\n");
+         }
+         fflush(plotfile);
+      }/* end if() */
+   }/* end if() */
+
+   /* update OSTRICH run record and status file */
+   WriteInnerEval(WRITE_ENDED, 0, '.');     
+   pStatus->pct = ((float)100.00*(float)(g)) / (float)m_MaxGen;
+   pStatus->numRuns = (g + 1)*m_PopSize;
+   WriteMultiObjRecord(m_pModel, g, m_pNonDomList, pStatus->pct);
+   WriteStatus(pStatus);
+} /* end report_progress() */
 
 /******************************************************************************
 WriteMetrics()
@@ -414,7 +683,8 @@ void MOPSOCD::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Max Generations         : %d\n", m_MaxGen);
    fprintf(pFile, "Population Size         : %d\n", m_PopSize);
    fprintf(pFile, "Mutation Rate           : %0.2f\n", m_ProbMut);
-   fprintf(pFile, "Archived Solutions      : %d\n", m_NumNonDom);
+   fprintf(pFile, "Asynchronous            : %s\n", (m_bAsync == true) ? "yes" : "no");
+   fprintf(pFile, "Archived Solutions      : %d\n", m_pArchive->GetSize());
    fprintf(pFile, "Non-Dominated Solutions : %d\n", m_NonDomListSize);
    fprintf(pFile, "Dominated Solutions     : %d\n", m_DomListSize);
 
@@ -431,6 +701,7 @@ void MOPSOCD::InitFromFile(IroncladString pFileName)
    FILE * pFile;
    char * line;
    char tmp[DEF_STR_SZ];
+   char yesno[DEF_STR_SZ];
    int i;
 
    m_PopSize = 20;
@@ -473,6 +744,19 @@ void MOPSOCD::InitFromFile(IroncladString pFileName)
          {
             sscanf(line, "%s %lf", tmp, &m_ProbMut);
          }
+         else if (strstr(line, "Asynchronous") != NULL)
+         {
+            sscanf(line, "%s %s", tmp, yesno);
+            MyStrLwr(yesno);
+            if (strcmp(yesno, "yes") == 0)
+            {
+               m_bAsync = true;
+            }
+            else
+            {
+               m_bAsync = false;
+            }
+         }
          else
          {
             sprintf(tmp, "Unknown token: %s", line);
@@ -483,19 +767,7 @@ void MOPSOCD::InitFromFile(IroncladString pFileName)
    }/* end if() */
 
    // allocate memory
-   m_ArchiveVar = new double*[m_ArchiveSize];
-   for(i = 0; i < m_ArchiveSize; i++)
-   {
-      m_ArchiveVar[i] = new double[m_NumVar];
-   }
-
-   m_ArchiveFit = new double*[m_ArchiveSize];
-   for (i = 0; i < m_ArchiveSize; i++)
-   {
-      m_ArchiveFit[i] = new double[m_NumFun];
-   }
-
-   m_CrowdDist = new double [m_ArchiveSize];
+   m_pArchive = new MOPSOCD_Archive(m_ArchiveSize, m_NumVar, m_NumFun);
 
    m_PopVar = new double*[m_PopSize];
    for (i = 0; i < m_PopSize; i++)
@@ -527,6 +799,10 @@ void MOPSOCD::InitFromFile(IroncladString pFileName)
       m_Velocity[i] = new double[m_NumVar];
    }
 
+   m_pQueue = new int[m_PopSize];
+   m_pEvaled = new bool[m_PopSize];
+   m_pAsyncF = new double[m_NumFun];
+
    fclose(pFile);
 } /* end InitFromFile() */
 
@@ -925,205 +1201,35 @@ Store personal bests (both variable and fitness values) of particles.
 ******************************************************************************/
 void MOPSOCD::store_pbests(void) 
 {
-   int i, j;
+   int i;
 
-   /* Store variable values of personal bests */
    for (i = 0; i < m_PopSize; i++)
    {
-      for (j = 0; j < m_NumVar; j++)
-      {
-         m_PbestsVar[i][j] = m_PopVar[i][j];
-      }
+      store_pbest(i);
    }
-
-   /* Store fitness values of personal bests */
-   for (i = 0; i < m_PopSize; i++)
-   {
-      for (j = 0; j < m_NumFun; j++)
-      {
-         m_PbestsFit[i][j] = m_PopFit[i][j];
-      }
-   }
-}/* end store_pbests() */
+}/* end store_pbests() */
 
 /******************************************************************************
-insert_nondom()
+store_pbest()
 
-Insert nondominated particles in population into the archive.
+Store personal best (both variable and fitness values) of the i-th particle.
 ******************************************************************************/
-void MOPSOCD::insert_nondom()
-{
-   int i, j, k, total, insertFlag, bottom;
-   double * archiveCons, *popCons;
-
-   archiveCons = new double[m_NumVar];
-   popCons = new double[m_NumVar];
-
-   for (i = 0; i< m_PopSize; i++)
-   {
-      insertFlag = 1;
-
-      /* if archive is empty */
-      if (m_NumNonDom == 0)
-      { 
-
-         /* Insert particle in pop into archive */
-         for (j = 0; j < m_NumVar; j++)
-         {
-            m_ArchiveVar[m_NumNonDom][j] = m_PopVar[i][j];
-         }
-
-         for (j = 0; j < m_NumFun; j++)
-         {
-            m_ArchiveFit[m_NumNonDom][j] = m_PopFit[i][j];
-         }
-
-         m_NumNonDom += 1;
-      }/* end if() */
-      /* if archive is not empty */
-      else
-      { 
-         insertFlag = 1;
-
-         /*for each particle in archive	*/
-         for (k = 0; k < m_NumNonDom; k++)
-         {
-            /* First, check for feasibility */
-            for (j = 0; j < m_NumVar; j++)
-            {
-               popCons[j] = m_PopVar[i][j];
-               archiveCons[j] = m_ArchiveVar[k][j];
-            }
-
-            /* If both particles are infeasible */
-            if ((check_constraints(archiveCons) > 0) && (check_constraints(popCons) > 0))
-            {
-               delete_particle(k);           /* Delete particle in archive           */
-               insertFlag = 0;		/* Do not insert particle in pop        */
-               break;
-            }
-            /* If particle in pop is infeasible */
-            else if (check_constraints(popCons) > 0)
-            { 
-               insertFlag = 0;			   /* Do not insert particle in pop    */
-               break;
-            }
-            /* If particle in archive is infeasible */
-            else if (check_constraints(archiveCons) > 0)
-            { 
-               delete_particle(k); /* Delete particle in archive */
-
-               if ((m_NumNonDom != 0) || (k != (m_NumNonDom - 1)))
-               {
-                  k--;
-               }
-
-               continue;
-            }/* end else if() */
-
-            /* Second, check for domination */
-            total = 0;
-
-            /* If both are feasible, check for nondomination */
-            for (j = 0; j < m_NumFun; j++)
-            {
-               if (((m_PopFit[i][j] < m_ArchiveFit[k][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 0))
-                  || (m_PopFit[i][j] > m_ArchiveFit[k][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 1))
-               {
-                  total += 1;
-               }
-            }
-
-            /* If particle in pop dominates     */
-            if (total == m_NumFun)   
-            {
-               delete_particle(k); /* Delete particle in archive       */
-            }
-            /* If particle in archive dominates */
-            else if (total == 0)
-            {  
-               insertFlag = 0;     /* Do not insert particle in pop    */
-               break;
-            }
-         } /* end for() --- Finished comparing one particle in pop with particles in archive */
-      }/* end else() */
-
-      /* Insert particle in pop if it is feasible and nondominated */
-      if (insertFlag == 1)
-      {
-         /* If memory is not yet full, insert particle */
-         if (m_NumNonDom < m_ArchiveSize)
-         {
-            for (j = 0; j < m_NumVar; j++)
-            {
-               m_ArchiveVar[m_NumNonDom][j] = m_PopVar[i][j];
-            }
-            for (j = 0; j < m_NumFun; j++)
-            {
-               m_ArchiveFit[m_NumNonDom][j] = m_PopFit[i][j];
-            }
-            m_NumNonDom += 1;
-         }/* end if() */
-         /* If memory is full, select particle to replace */
-         else
-         {      
-            /* Compute crowding distance values of particles in archive*/
-            crowding();
-
-            bottom = (unsigned int)((m_NumNonDom - 1) * 0.90);
-
-            /* Randomly select which particle from the most areas to replace */
-            k = MOPSOCD_RandomInt(bottom, m_NumNonDom - 1);
-
-            /* Insert new particle into archive */
-            for (j = 0; j < m_NumVar; j++)
-            {
-               m_ArchiveVar[k][j] = m_PopVar[i][j];
-            }
-
-            for (j = 0; j < m_NumFun; j++)
-            {
-               m_ArchiveFit[k][j] = m_PopFit[i][j];
-            }
-         }/* else() */
-      }/* end if() */
-   } /* end for() --- Finished comparing particles in pop with particles in archive */
-
-   delete [] archiveCons;
-   delete [] popCons;
-
-}/* end insert_nondom() */
-
-/******************************************************************************
-delete_particle()
-
-Delete particle in archive.
-******************************************************************************/
-void MOPSOCD::delete_particle(unsigned int k)
+void MOPSOCD::store_pbest(int i) 
 {
    int j;
 
-   /* if infeasible particle is the last in archive or only one particle in archive */
-   if ((m_NumNonDom == 1) || (k == (m_NumNonDom - 1))) 
+   /* Store variable values of personal best */
+   for (j = 0; j < m_NumVar; j++)
    {
-      m_NumNonDom -= 1;
+      m_PbestsVar[i][j] = m_PopVar[i][j];
    }
-   /* move last particle in archive in place of infeasible particle	*/
-   else 
-   {       
-      for (j = 0; j < m_NumVar; j++)
-      {
-         m_ArchiveVar[k][j] = m_ArchiveVar[m_NumNonDom - 1][j];
-      }
-
-      for (j = 0; j < m_NumFun; j++)
-      {
-         m_ArchiveFit[k][j] = m_ArchiveFit[m_NumNonDom - 1][j];
-      }
 
-      m_NumNonDom -= 1;
+   /* Store fitness values of personal best */
+   for (j = 0; j < m_NumFun; j++)
+   {
+      m_PbestsFit[i][j] = m_PopFit[i][j];
    }
-}/* end delete_particle() */
+}/* end store_pbest() */
 
 /******************************************************************************
 check_constraints()
@@ -1136,496 +1242,181 @@ unsigned int MOPSOCD::check_constraints(double *consVar)
 }/* end check_constraints() */
 
 /******************************************************************************
-crodwing()
+compute_velocity()
 
-Computes crowding distance values of particles in archive
+Compute new velocity of each particle in the population
 ******************************************************************************/
-void MOPSOCD::crowding(void)
+void MOPSOCD::compute_velocity(void) 
 {
-   int i, f, begin;
-
-   /* initialize crowding distance values */
-   for (i = 0; i <= m_NumNonDom; i++)
-   {
-      m_CrowdDist[i] = 0;
-   }
+   int i;
 
-   for (f = 0; f < m_NumFun; f++)
+   for (i = 0; i < m_PopSize; i++) 
    {
-      begin = 0;
-      /* Sort fitness values */
-      qsortFitness(f, begin, m_NumNonDom);
-
-      /* Compute crowding distance */
-      compute_distance(f);
+      compute_velocity(i);
    }
-
-   /* Sort crowding distance values */
-   begin = 0;
-   qsortCrowd(begin, m_NumNonDom);
-}/* end crodwing() */
+}/* end compute_velocity() */
 
 /******************************************************************************
-qsortFitness()
+compute_velocity()
 
-Sort fitness values of particles in archive
+Compute new velocity and position of the i-th particle in the population. The
+global best is drawn from the least crowded tenth of the archive.
 ******************************************************************************/
-void MOPSOCD::qsortFitness(unsigned int f, unsigned int begin, unsigned int lastPart)
+void MOPSOCD::compute_velocity(int i) 
 {
-   unsigned int left = begin + 1;
-   unsigned int right = lastPart;
-   double pivot = m_ArchiveFit[begin][f];
-
-   int k;
-   double *tempF, * tempP, temp;
-
-   tempF = new double[m_NumFun];
-   tempP = new double[m_NumVar];
-
-   while (left < right)
-   {
-      if (m_ArchiveFit[left][f] <= pivot) 
-      {
-         left++;
-      }
-      else 
-      {
-         right--;
-
-         /* swap */
-         /* Exchange fitness positions of two particles in the archiveFit */
-         for (k = 0; k < m_NumFun; k++)
-         {
-            tempF[k] = m_ArchiveFit[left][k];
-            m_ArchiveFit[left][k] = m_ArchiveFit[right][k];
-         }
-
-         for (k = 0; k < m_NumFun; k++)
-         {
-            m_ArchiveFit[right][k] = tempF[k];
-         }
-
-         /* Also exchange particle positions in archiveVar */
-         for (k = 0; k < m_NumVar; k++)
-         {
-            tempP[k] = m_ArchiveVar[left][k];
-            m_ArchiveVar[left][k] = m_ArchiveVar[right][k];
-         }
-
-         for (k = 0; k < m_NumVar; k++)
-         {
-            m_ArchiveVar[right][k] = tempP[k];
-         }
-
-         /* Also exchange their crowding distance */
-         temp = m_CrowdDist[left];
-         m_CrowdDist[left] = m_CrowdDist[right];
-         m_CrowdDist[right] = temp;
-      }
-   }
-
-   left--;
-
-   /* Exchange fitness positions of two particles in the array archiveFit */
-   for (k = 0; k < m_NumFun; k++)
-   {
-      tempF[k] = m_ArchiveFit[begin][k];
-      m_ArchiveFit[begin][k] = m_ArchiveFit[left][k];
-   }
-
-   for (k = 0; k < m_NumFun; k++)
-   {
-      m_ArchiveFit[left][k] = tempF[k];
-   }
-
-   /* Also exchange particle positions in archiveVar */
-   for (k = 0; k < m_NumVar; k++)
-   {
-      tempP[k] = m_ArchiveVar[begin][k];
-      m_ArchiveVar[begin][k] = m_ArchiveVar[left][k];
-   }
+   unsigned int top;
+   int j;
+   double * gBest;
 
-   for (k = 0; k < m_NumVar; k++)
-   {
-      m_ArchiveVar[left][k] = tempP[k];
-   }
+   top = (unsigned int)((m_pArchive->GetSize() - 1) * 0.10);
 
-   /* Also exchange their crowding distance */
-   temp = m_CrowdDist[begin];
-   m_CrowdDist[begin] = m_CrowdDist[left];
-   m_CrowdDist[left] = temp;
+   gBest = m_pArchive->GetVar(m_pArchive->GetRanked(MOPSOCD_RandomInt(0, top)));
 
-   if ((left - begin) > 1)
+   for (j = 0; j < m_NumVar; j++)
    {
-      qsortFitness(f, begin, left);
-   }
+      m_Velocity[i][j] = 0.4 * m_Velocity[i][j] + /* W  * Vi */
+                         1.0 * MOPSOCD_RandomDouble(0.0, 1.0) * (m_PbestsVar[i][j] - m_PopVar[i][j]) +     /* C1  * RandomDouble(0.0, 1.0) * (pBest - Xi) */
+                         1.0 * MOPSOCD_RandomDouble(0.0, 1.0) * (gBest[j] - m_PopVar[i][j]);               /* C2  * RandomDouble(0.0, 1.0) * (gBest - Xi) */          
+   }/* end for() */
 
-   if ((lastPart - right) > 1)
+   /* Calculate new position of particle */
+   for (j = 0; j < m_NumVar; j++)
    {
-      qsortFitness(f, right, lastPart);
+      m_PopVar[i][j] = m_PopVar[i][j] + m_Velocity[i][j];
    }
-}/* end qsortFitness() */
+}/* end compute_velocity() */
 
 /******************************************************************************
-compute_distance()
+mutate()
 
-Compute the crowding distance of each particle in noDomF
+Mutation of particles adapted from MOPSO
 ******************************************************************************/
-void MOPSOCD::compute_distance(unsigned int f)
+void MOPSOCD::mutate(unsigned int t)
 {
-   int i, max;
-
-   max = 1;
-   for (i = 1; i < m_NumNonDom - 1; i++)
-   {
-      m_CrowdDist[i] = m_CrowdDist[i] + (m_ArchiveFit[i + 1][f] - m_ArchiveFit[i - 1][f]);
-
-      if (m_CrowdDist[max] < m_CrowdDist[i])
-      {
-         max = i;
-      }
-   }
+   int i;
 
-   /* give maximum crowding distance value to the boundary points so that they are always selected */
-   m_CrowdDist[0] = m_CrowdDist[0] + m_CrowdDist[max];
-   m_CrowdDist[m_NumNonDom - 1] = m_CrowdDist[m_NumNonDom - 1] + m_CrowdDist[max];
+   get_ranges(m_pMinValue, m_pMaxValue);
 
-}/* end compute_distance() */
+   for (i = 0; i < m_PopSize; i++)
+   {
+      mutate_particle(i, t, m_pMinValue, m_pMaxValue);
+   }/* end for() */
+}/* end mutate() */
 
 /******************************************************************************
-qsortCrowd()
+mutate_particle()
 
-Sort crowding distance values.
+Mutation of the i-th particle, given the range values of variables.
 ******************************************************************************/
-void MOPSOCD::qsortCrowd(unsigned int begin, unsigned int lastPart)
+void MOPSOCD::mutate_particle(int i, unsigned int t, double * minvalue, double * maxvalue)
 {
-   unsigned int left = begin + 1;
-   unsigned int right = lastPart;
-   double pivot = m_CrowdDist[begin];
+   int dimension = 0;
+   double minvaluetemp, maxvaluetemp, range;
+   double valtemp = 0;
 
-   int k;
-   double temp;
-   double * tempP, * tempF;
+   if (MOPSOCD_flip(pow(1.0 - (double)t / (m_MaxGen * m_ProbMut), 1.5)))
+   {
+      dimension = MOPSOCD_RandomInt(0, m_NumVar - 1);
 
-   tempP = new double[m_NumVar];
-   tempF = new double[m_NumFun];
+      range = (maxvalue[dimension] - minvalue[dimension]) * pow(1.0 - (double)t / (m_MaxGen * m_ProbMut), 1.5) / 2;
 
-   while (left < right)
-   {
+      valtemp = MOPSOCD_RandomDouble(range, -range);
 
-      if (m_CrowdDist[left] >= pivot) 
+      if ((m_PopVar[i][dimension] - range) < minvalue[dimension])
       {
-         left++;
+         minvaluetemp = minvalue[dimension];
       }
       else
       {
-         right--;
-
-         /* exchange their crowding distance values */
-         temp = m_CrowdDist[left];
-         m_CrowdDist[left] = m_CrowdDist[right];
-         m_CrowdDist[right] = temp;
-
-         /* Exchange fitness positions of two particles in the array archiveFit */
-         for (k = 0; k < m_NumFun; k++)
-         {
-            tempF[k] = m_ArchiveFit[left][k];
-            m_ArchiveFit[left][k] = m_ArchiveFit[right][k];
-         }
-
-         for (k = 0; k < m_NumFun; k++)
-         {
-            m_ArchiveFit[right][k] = tempF[k];
-         }
-
-         /* Also exchange particle positions in archiveVar */
-         for (k = 0; k < m_NumVar; k++)
-         {
-            tempP[k] = m_ArchiveVar[left][k];
-            m_ArchiveVar[left][k] = m_ArchiveVar[right][k];
-         }
-
-         for (k = 0; k < m_NumVar; k++)
-         {
-            m_ArchiveVar[right][k] = tempP[k];
-         }
-      }/* end else() */
-   }/* end while() */
-
-   left--;
-
-   /* Exchange fitness positions of two particles in the array archiveVar */
-   for (k = 0; k < m_NumFun; k++)
-   {
-      tempF[k] = m_ArchiveFit[begin][k];
-      m_ArchiveFit[begin][k] = m_ArchiveFit[left][k];
-   }
-
-   for (k = 0; k < m_NumFun; k++)
-   {
-      m_ArchiveFit[left][k] = tempF[k];
-   }
-
-   /* Also exchange particle positions in archiveVar */
-   for (k = 0; k < m_NumVar; k++)
-   {
-      tempP[k] = m_ArchiveVar[begin][k];
-      m_ArchiveVar[begin][k] = m_ArchiveVar[left][k];
-   }
-
-   for (k = 0; k < m_NumVar; k++)
-   {
-      m_ArchiveVar[left][k] = tempP[k];
-   }
-
-   /* Also exchange their crowding distance */
-   temp = m_CrowdDist[begin];
-   m_CrowdDist[begin] = m_CrowdDist[left];
-   m_CrowdDist[left] = temp;
-
-   if (left - begin > 1)
-   {
-      qsortCrowd(begin, left);
-   }
-
-   if (lastPart - right > 1)
-   {
-      qsortCrowd(right, lastPart);
-   }
-
-   delete [] tempP;
-   delete [] tempF;
-}/* end qsortCrowd() */
-
-/******************************************************************************
-compute_velocity()
-
-Compute new velocity of each particle in the population
-******************************************************************************/
-void MOPSOCD::compute_velocity(void) 
-{
-   unsigned int top, gBest;
-   int i, j;
-
-   top = (unsigned int)((m_NumNonDom - 1) * 0.10);
-
-   for (i = 0; i < m_PopSize; i++) 
-   {
-      gBest = MOPSOCD_RandomInt(0, top);
+         minvaluetemp = m_PopVar[i][dimension] - range;
+      }
 
-      for (j = 0; j < m_NumVar; j++)
+      if (m_PopVar[i][dimension] + range > maxvalue[dimension])
       {
-         m_Velocity[i][j] = 0.4 * m_Velocity[i][j] + /* W  * Vi */
-                            1.0 * MOPSOCD_RandomDouble(0.0, 1.0) * (m_PbestsVar[i][j] - m_PopVar[i][j]) +     /* C1  * RandomDouble(0.0, 1.0) * (pBest - Xi) */
-                            1.0 * MOPSOCD_RandomDouble(0.0, 1.0) * (m_ArchiveVar[gBest][j] - m_PopVar[i][j]); /* C2  * RandomDouble(0.0, 1.0) * (gBest - Xi) */          
-      }/* end for() */
-   }/* end for() */
-
-   /* Calculate new positions of particles */
-   for (i = 0; i < m_PopSize; i++)
-   {
-      for (j = 0; j < m_NumVar; j++)
+         maxvaluetemp = maxvalue[dimension];
+      }
+      else
       {
-         m_PopVar[i][j] = m_PopVar[i][j] + m_Velocity[i][j];
+         maxvaluetemp = m_PopVar[i][dimension] + range;
       }
-   }
-}/* end compute_velocity() */
+
+      m_PopVar[i][dimension] = MOPSOCD_RandomDouble(minvaluetemp, maxvaluetemp);
+   }/* end if() */
+}/* end mutate_particle() */
 
 /******************************************************************************
-mutate()
+update_archive()
 
-Mutation of particles adapted from MOPSO
+Insert new nondominated particles in pop into archive.
 ******************************************************************************/
-void MOPSOCD::mutate(unsigned int t)
+void MOPSOCD::update_archive(void)
 {
-   int i;
-   int dimension = 0;
-   double * minvalue, * maxvalue;
-   double minvaluetemp, maxvaluetemp, range;
-   double valtemp = 0;
-
-   minvalue = new double[m_NumVar];
-   maxvalue = new double[m_NumVar];
-
-   get_ranges(minvalue, maxvalue);
+   int k;
 
-   for (i = 0; i < m_PopSize; i++)
+   /* for each particle in the population */
+   for (k = 0; k < m_PopSize; k++) 
    {
-      if (MOPSOCD_flip(pow(1.0 - (double)t / (m_MaxGen * m_ProbMut), 1.5)))
-      {
-         dimension = MOPSOCD_RandomInt(0, m_NumVar - 1);
-
-         range = (maxvalue[dimension] - minvalue[dimension]) * pow(1.0 - (double)t / (m_MaxGen * m_ProbMut), 1.5) / 2;
-
-         valtemp = MOPSOCD_RandomDouble(range, -range);
-
-         if ((m_PopVar[i][dimension] - range) < minvalue[dimension])
-         {
-            minvaluetemp = minvalue[dimension];
-         }
-         else
-         {
-            minvaluetemp = m_PopVar[i][dimension] - range;
-         }
-
-         if (m_PopVar[i][dimension] + range > maxvalue[dimension])
-         {
-            maxvaluetemp = maxvalue[dimension];
-         }
-         else
-         {
-            maxvaluetemp = m_PopVar[i][dimension] + range;
-         }
-
-         m_PopVar[i][dimension] = MOPSOCD_RandomDouble(minvaluetemp, maxvaluetemp);
-      }/* end if() */
+      update_archive(k);
    }/* end for() */
-
-   delete [] minvalue;
-   delete [] maxvalue;
-}/* end mutate() */
+}/* end update_archive() */
 
 /******************************************************************************
 update_archive()
 
-Insert new nondominated particles in pop into archive.
+Insert the k-th particle in pop into archive, if it is nondominated. If the
+archive is full, a randomly selected particle among the most crowded tenth is
+replaced.
 ******************************************************************************/
-void MOPSOCD::update_archive(void)
+void MOPSOCD::update_archive(int k)
 {
-   int i, j, k;
    unsigned int bottom;
+   int i;
 
-   /* for each particle in the population */
-   for (k = 0; k < m_PopSize; k++) 
+   /* if particle in pop is nondominated */
+   if (check_nondom(k) == 1) 
    {
-      /* if particle in pop is nondominated */
-      if (check_nondom(k) == 1) 
+      /* if memory is full, select particle to replace */
+      if (m_pArchive->GetSize() >= m_ArchiveSize) 
       {
-         /* if memory is not yet full, insert particle */
-         if (m_NumNonDom < m_ArchiveSize) 
-         {
-            i = m_NumNonDom;
-
-            for (j = 0; j < m_NumVar; j++)
-            {
-               m_ArchiveVar[i][j] = m_PopVar[k][j];
-            }
-
-            for (j = 0; j < m_NumFun; j++)
-            {
-               m_ArchiveFit[i][j] = m_PopFit[k][j];
-            }
-
-            m_NumNonDom += 1;
-         }
-         else /* if memory is full, select particle to replace */
-         {      
-            /* Crowding distance computation and sorting */
-            crowding();
-            bottom = (unsigned int)((m_NumNonDom - 1)*.90);
-            i = MOPSOCD_RandomInt(bottom, m_NumNonDom - 1);
-
-            /* insert new particle to noDom */
-            for (j = 0; j < m_NumVar; j++)
-            {
-               m_ArchiveVar[i][j] = m_PopVar[k][j];
-            }
+         bottom = (unsigned int)((m_pArchive->GetSize() - 1)*.90);
+         i = MOPSOCD_RandomInt(bottom, m_pArchive->GetSize() - 1);
+         m_pArchive->Remove(m_pArchive->GetRanked(i));
+      }
 
-            for (j = 0; j < m_NumFun; j++)
-            {
-               m_ArchiveFit[i][j] = m_PopFit[k][j];
-            }
-         }/* end else() */
-      }/* end if() */
-   }/* end for() */
+      m_pArchive->Insert(m_PopVar[k], m_PopFit[k]);
+   }/* end if() */
 }/* end update_archive() */
 
 /******************************************************************************
 check_nondom()
 
-Check for feasibility and nondomination of particles in pop and archive
+Check for feasibility and nondomination of the i-th particle in pop against
+the archive, and delete the particles in archive that it dominates. Returns 1
+if the particle belongs in the archive.
 ******************************************************************************/
 unsigned int MOPSOCD::check_nondom(unsigned int i)
 {
-   unsigned int sum;
-   int h = 0;
-   int j;
-   double * archiveCons, * popCons;
-
-   archiveCons = new double[m_NumVar];
-   popCons = new double[m_NumVar];
-
-   do 
+   /* an infeasible particle only goes into an empty archive... */
+   if (check_constraints(m_PopVar[i]) > 0)
    {
-      sum = 0;
-      for (j = 0; j < m_NumVar; j++)
-      {
-         archiveCons[j] = m_ArchiveVar[h][j];
-         popCons[j] = m_PopVar[i][j];
-      }
-
-      /* if particle in archive has lesser contraint violations */
-      if (check_constraints(archiveCons) < check_constraints(popCons))
-      {
-         delete [] archiveCons;
-         delete [] popCons;
-         return 0;
-      }
-
-      /* if particle in archive has more contraint violations, delete it */
-      if (check_constraints(archiveCons) > check_constraints(popCons))
-      {
-         for (j = 0; j < m_NumVar; j++)
-         {
-            m_ArchiveVar[h][j] = m_ArchiveVar[m_NumNonDom - 1][j];
-         }
-
-         for (j = 0; j < m_NumFun; j++)
-         {
-            m_ArchiveFit[h][j] = m_ArchiveFit[m_NumNonDom - 1][j];
-         }
-
-         m_NumNonDom -= 1;
-      }
-      else
-      {
-         for (j = 0; j < m_NumFun; j++)
-         {
-            if (((m_ArchiveFit[h][j] < m_PopFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 0)) ||
-                ((m_ArchiveFit[h][j] > m_PopFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 1)))
-            {
-               sum += 1;
-            }/* end if() */
-         }/* end for() */
+      return ((m_pArchive->GetSize() == 0) ? 1 : 0);
+   }
 
-         if (sum == m_NumFun)	/* If particle in archive dominates */
-         {
-            delete[] archiveCons;
-            delete[] popCons;
-            return 0;
-         }
-         else if (sum == 0) /* If particle in archive is dominated, delete it */
-         {	
-            for (j = 0; j < m_NumVar; j++)
-            {
-               m_ArchiveVar[h][j] = m_ArchiveVar[m_NumNonDom - 1][j];
-            }
+   /* ...and is replaced by the first feasible one */
+   if ((m_pArchive->GetSize() == 1) && (check_constraints(m_pArchive->GetVar(0)) > 0))
+   {
+      m_pArchive->Remove(0);
+      return 1;
+   }
 
-            for (j = 0; j < m_NumFun; j++)
-            {
-               m_ArchiveFit[h][j] = m_ArchiveFit[m_NumNonDom - 1][j];
-            }
-            m_NumNonDom -= 1;
-         }
-         else 
-         {
-            h += 1;
-         }
-      }/* end else() */
-   } while (h < m_NumNonDom);
+   /* if a particle in archive dominates */
+   if (m_pArchive->IsDominated(m_PopFit[i]) == true)
+   {
+      return 0;
+   }
 
-   delete[] archiveCons;
-   delete[] popCons;
+   /* delete particles in archive that are dominated */
+   m_pArchive->RemoveDominated(m_PopFit[i]);
    return 1;
 }/* end check_nondom() */
 
@@ -1652,40 +1443,52 @@ Maintain particles in the population within the search space
 ******************************************************************************/
 void MOPSOCD::maintain_particles(void)
 {
-   int i, j;
-   double minvalue, maxvalue;
+   int i;
 
    for (i = 0; i < m_PopSize; i++) 
    {
-      for (j = 0; j < m_NumVar; j++) 
-      {
-         minvalue = m_pModel->GetParamGroupPtr()->GetParamPtr(j)->GetLwrBnd();
-         maxvalue = m_pModel->GetParamGroupPtr()->GetParamPtr(j)->GetUprBnd();
+      maintain_particle(i);
+   }/* end for() */
+}/* maintain_particles() */
 
-         /* If particle goes beyond minimum range value */
-         if (m_PopVar[i][j] < minvalue)
-         {
+/******************************************************************************
+maintain_particle()
+
+Maintain the i-th particle in the population within the search space
+******************************************************************************/
+void MOPSOCD::maintain_particle(int i)
+{
+   int j;
+   double minvalue, maxvalue;
+
+   for (j = 0; j < m_NumVar; j++) 
+   {
+      minvalue = m_pModel->GetParamGroupPtr()->GetParamPtr(j)->GetLwrBnd();
+      maxvalue = m_pModel->GetParamGroupPtr()->GetParamPtr(j)->GetUprBnd();
 
-            /* Set it to minimum range value */
-            m_PopVar[i][j] = minvalue;
+      /* If particle goes beyond minimum range value */
+      if (m_PopVar[i][j] < minvalue)
+      {
 
-            /* Change to opposite direction */
-            m_Velocity[i][j] = -m_Velocity[i][j];
+         /* Set it to minimum range value */
+         m_PopVar[i][j] = minvalue;
 
-         }
+         /* Change to opposite direction */
+         m_Velocity[i][j] = -m_Velocity[i][j];
 
-         /* If particle goes beyond maximum range value */
-         if (m_PopVar[i][j] > maxvalue)
-         {
-            /* Set it to maximum range value */
-            m_PopVar[i][j] = maxvalue;
+      }
 
-            /* Change to opposite direction */
-            m_Velocity[i][j] = -m_Velocity[i][j];
-         }
-      }/* end for() */
+      /* If particle goes beyond maximum range value */
+      if (m_PopVar[i][j] > maxvalue)
+      {
+         /* Set it to maximum range value */
+         m_PopVar[i][j] = maxvalue;
+
+         /* Change to opposite direction */
+         m_Velocity[i][j] = -m_Velocity[i][j];
+      }
    }/* end for() */
-}/* maintain_particles() */
+}/* maintain_particle() */
 
 /******************************************************************************
 update_pbests()
@@ -1694,51 +1497,63 @@ Update personal bests of particles in the population
 ******************************************************************************/
 void MOPSOCD::update_pbests(void) 
 {
-   unsigned int sum, better;
-   int i, j;
+   int i;
 
    for (i = 0; i < m_PopSize; i++) 
    {
-      sum = 0;
+      update_pbest(i);
+   }/* end for() */
+}/* end update_pbests() */
 
-      for (j = 0; j < m_NumFun; j++)
+/******************************************************************************
+update_pbest()
+
+Update personal best of the i-th particle in the population
+******************************************************************************/
+void MOPSOCD::update_pbest(int i) 
+{
+   unsigned int sum, better;
+   int j;
+
+   sum = 0;
+
+   for (j = 0; j < m_NumFun; j++)
+   {
+      if (((m_PopFit[i][j] < m_PbestsFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 0)) ||
+          ((m_PopFit[i][j] > m_PbestsFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 1)))
       {
-         if (((m_PopFit[i][j] < m_PbestsFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 0)) ||
-             ((m_PopFit[i][j] > m_PbestsFit[i][j]) && (MOPSOCD_OPTIMIZATION_TYPE == 1)))
-         {
-            sum += 1;
-         }
+         sum += 1;
       }
+   }
 
-      if (sum == m_NumFun) 
+   if (sum == m_NumFun) 
+   {
+      better = 0;
+   }
+   else 
+   {
+      if (sum == 0)
       {
-         better = 0;
+         better = 1;
       }
-      else 
+      else
       {
-         if (sum == 0)
-         {
-            better = 1;
-         }
-         else
-         {
-            better = MOPSOCD_RandomInt(0, 1);
-         }
+         better = MOPSOCD_RandomInt(0, 1);
       }
+   }
 
-      if (better == 0)
+   if (better == 0)
+   {
+      for (j = 0; j < m_NumFun; j++)
       {
-         for (j = 0; j < m_NumFun; j++)
-         {
-            m_PbestsFit[i][j] = m_PopFit[i][j];
-         }
-         for (j = 0; j < m_NumVar; j++)
-         {
-            m_PbestsVar[i][j] = m_PopVar[i][j];
-         }
+         m_PbestsFit[i][j] = m_PopFit[i][j];
       }
-   }/* end for() */
-}/* end update_pbests() */
+      for (j = 0; j < m_NumVar; j++)
+      {
+         m_PbestsVar[i][j] = m_PopVar[i][j];
+      }
+   }
+}/* end update_pbest() */
 
 /******************************************************************************
 save_results()
@@ -1753,11 +1568,11 @@ void MOPSOCD::save_results(char *archiveName)
    /* Open file for writing */
    fp = fopen(archiveName, "w");
 
-   for (i = 0; i < m_NumNonDom; i++) 
+   for (i = 0; i < m_pArchive->GetSize(); i++) 
    {
       for (j = 0; j < m_NumFun; j++)
       {
-         fprintf(fp, "%.6f ", m_ArchiveFit[i][j]);
+         fprintf(fp, "%.6f ", m_pArchive->GetFit(i)[j]);
       }
       fprintf(fp, "\n");
    }
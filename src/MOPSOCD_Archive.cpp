@@ -0,0 +1,585 @@
+/******************************************************************************
+File      : MOPSOCD_Archive.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Archive of non-dominated solutions for MOPSOCD, ranked by crowding distance.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include "MOPSOCD_Archive.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+/******************************************************************************
+CTOR
+
+Allocates storage for the given maximum number of members.
+******************************************************************************/
+MOPSOCD_Archive::MOPSOCD_Archive(int capacity, int numVar, int numFun)
+{
+   m_Capacity = capacity;
+   m_NumVar = numVar;
+   m_NumFun = numFun;
+   m_Size = 0;
+
+   m_pVar = new double[m_Capacity*m_NumVar];
+   m_pFit = new double[m_Capacity*m_NumFun];
+   m_pTerm = new double[m_Capacity*m_NumFun];
+   m_pCrowd = new double[m_Capacity];
+   m_pOrder = new MOPSOCD_ObjIndex[m_NumFun];
+   m_pKdPos = new int[m_Capacity];
+   m_KdHoles = 0;
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Free up memory used by the archive.
+******************************************************************************/
+void MOPSOCD_Archive::Destroy(void)
+{
+   delete [] m_pVar;
+   delete [] m_pFit;
+   delete [] m_pTerm;
+   delete [] m_pCrowd;
+   delete [] m_pOrder;
+   delete [] m_pKdPos;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+Covers()
+
+True if Fa is no larger than Fb in every objective.
+******************************************************************************/
+bool MOPSOCD_Archive::Covers(double * Fa, double * Fb)
+{
+   int j;
+
+   for(j = 0; j < m_NumFun; j++)
+   {
+      if(Fa[j] > Fb[j]) return false;
+   }
+   return true;
+} /* end Covers() */
+
+/******************************************************************************
+IsDominated()
+
+True if some member is at least as good as F in every objective.
+******************************************************************************/
+bool MOPSOCD_Archive::IsDominated(double * F)
+{
+   MOPSOCD_ObjIndex::iterator it;
+
+   if(m_Size == 0) return false;
+
+   //two objectives: last member whose first objective is no larger has the smallest second one
+   if(m_NumFun == 2)
+   {
+      it = m_pOrder[0].upper_bound(MOPSOCD_Key(F[0], INT_MAX));
+      if(it == m_pOrder[0].begin()) return false;
+      it--;
+      return (GetFit(it->second)[1] <= F[1]);
+   }
+
+   return KdIsDominated(F);
+} /* end IsDominated() */
+
+/******************************************************************************
+RemoveDominated()
+
+Remove the members that F is at least as good as in every objective, and
+return how many were removed. F must not be dominated (see IsDominated()).
+******************************************************************************/
+int MOPSOCD_Archive::RemoveDominated(double * F)
+{
+   MOPSOCD_ObjIndex::iterator it;
+   int i;
+
+   m_Doomed.clear();
+   if(m_Size == 0) return 0;
+
+   if(m_NumFun == 2)
+   {
+      //run of members whose first objective is no smaller, while the second is no smaller
+      for(it = m_pOrder[0].lower_bound(MOPSOCD_Key(F[0], INT_MIN)); it != m_pOrder[0].end(); it++)
+      {
+         if(GetFit(it->second)[1] < F[1]) break;
+         m_Doomed.push_back(it->second);
+      }
+   }/* end if() */
+   else
+   {
+      KdDominated(F);
+   }
+
+   //remove from the highest slot down, so that no doomed member gets moved
+   std::sort(m_Doomed.begin(), m_Doomed.end(), std::greater<int>());
+   for(i = 0; i < (int)m_Doomed.size(); i++)
+   {
+      Remove(m_Doomed[i]);
+   }
+   return (int)m_Doomed.size();
+} /* end RemoveDominated() */
+
+/******************************************************************************
+UpdateTerm()
+
+Crowding distance term of the member at the given position of the order of
+objective f: distance between its neighbours, infinite at either end.
+******************************************************************************/
+void MOPSOCD_Archive::UpdateTerm(int f, MOPSOCD_ObjIndex::iterator it)
+{
+   MOPSOCD_ObjIndex::iterator next;
+   double term;
+
+   next = std::next(it);
+   if((it == m_pOrder[f].begin()) || (next == m_pOrder[f].end()))
+   {
+      term = HUGE_VAL;
+   }
+   else
+   {
+      term = next->first - std::prev(it)->first;
+   }
+   m_pTerm[it->second*m_NumFun + f] = term;
+} /* end UpdateTerm() */
+
+/******************************************************************************
+UpdateCrowding()
+
+Recompute the crowding distance of the i-th member from its terms, and its
+rank.
+******************************************************************************/
+void MOPSOCD_Archive::UpdateCrowding(int i)
+{
+   double sum;
+   int f;
+
+   //no-op for a new member (see Insert())
+   m_Crowd.erase(MOPSOCD_Key(m_pCrowd[i], i));
+
+   sum = 0.00;
+   for(f = 0; f < m_NumFun; f++)
+   {
+      sum += m_pTerm[i*m_NumFun + f];
+   }
+   m_pCrowd[i] = sum;
+   m_Crowd.insert(MOPSOCD_Key(sum, i));
+} /* end UpdateCrowding() */
+
+/******************************************************************************
+Insert()
+
+Add a member. The archive must not be full.
+******************************************************************************/
+void MOPSOCD_Archive::Insert(double * X, double * F)
+{
+   MOPSOCD_ObjIndex::iterator it, nbr;
+   int i, f, k;
+
+   if(m_Size >= m_Capacity)
+   {
+      LogError(ERR_ARR_BNDS, "MOPSOCD_Archive::Insert(): archive is full");
+      ExitProgram(1);
+   }
+
+   i = m_Size;
+   m_Size++;
+   memcpy(GetVar(i), X, sizeof(double)*m_NumVar);
+   memcpy(GetFit(i), F, sizeof(double)*m_NumFun);
+   m_pCrowd[i] = -1.00; //not ranked yet, any number will do
+
+   //terms of the new member and of its neighbours
+   m_Touched.clear();
+   for(f = 0; f < m_NumFun; f++)
+   {
+      it = m_pOrder[f].insert(MOPSOCD_Key(F[f], i)).first;
+      UpdateTerm(f, it);
+      if(it != m_pOrder[f].begin())
+      {
+         nbr = std::prev(it);
+         UpdateTerm(f, nbr);
+         m_Touched.push_back(nbr->second);
+      }
+      nbr = std::next(it);
+      if(nbr != m_pOrder[f].end())
+      {
+         UpdateTerm(f, nbr);
+         m_Touched.push_back(nbr->second);
+      }
+   }/* end for() */
+
+   UpdateCrowding(i);
+   for(k = 0; k < (int)m_Touched.size(); k++)
+   {
+      UpdateCrowding(m_Touched[k]);
+   }
+
+   //new members wait in the buffer of the k-d tree
+   if(m_NumFun > 2)
+   {
+      m_pKdPos[i] = -1 - (int)m_Recent.size();
+      m_Recent.push_back(i);
+      if((double)m_Recent.size() > MyMax(2.00*MOPSOCD_KD_LEAF, sqrt((double)m_Size)))
+      {
+         KdRebuild();
+      }
+   }
+} /* end Insert() */
+
+/******************************************************************************
+Remove()
+
+Remove the i-th member. The last member takes its slot.
+******************************************************************************/
+void MOPSOCD_Archive::Remove(int i)
+{
+   MOPSOCD_ObjIndex::iterator it, prev, next;
+   double * F;
+   int f, k;
+   bool bPrev;
+
+   F = GetFit(i);
+
+   //terms of the neighbours
+   m_Touched.clear();
+   for(f = 0; f < m_NumFun; f++)
+   {
+      it = m_pOrder[f].find(MOPSOCD_Key(F[f], i));
+      bPrev = (it != m_pOrder[f].begin());
+      if(bPrev == true)
+      {
+         prev = std::prev(it);
+      }
+      next = m_pOrder[f].erase(it);
+
+      if(bPrev == true)
+      {
+         UpdateTerm(f, prev);
+         m_Touched.push_back(prev->second);
+      }
+      if(next != m_pOrder[f].end())
+      {
+         UpdateTerm(f, next);
+         m_Touched.push_back(next->second);
+      }
+   }/* end for() */
+
+   m_Crowd.erase(MOPSOCD_Key(m_pCrowd[i], i));
+   for(k = 0; k < (int)m_Touched.size(); k++)
+   {
+      UpdateCrowding(m_Touched[k]);
+   }
+
+   if(m_NumFun > 2)
+   {
+      KdRemove(i);
+   }
+
+   if(i != (m_Size - 1))
+   {
+      MoveSlot(m_Size - 1, i);
+   }
+   m_Size--;
+
+   if((m_NumFun > 2) && (m_KdHoles > m_Size))
+   {
+      KdRebuild();
+   }
+} /* end Remove() */
+
+/******************************************************************************
+MoveSlot()
+
+Move a member to an unused slot.
+******************************************************************************/
+void MOPSOCD_Archive::MoveSlot(int from, int to)
+{
+   MOPSOCD_ObjIndex::iterator it;
+   MOPSOCD_CrowdIndex::iterator ic;
+   double * F;
+   int f, pos;
+
+   F = GetFit(from);
+   for(f = 0; f < m_NumFun; f++)
+   {
+      it = m_pOrder[f].erase(m_pOrder[f].find(MOPSOCD_Key(F[f], from)));
+      m_pOrder[f].insert(it, MOPSOCD_Key(F[f], to));
+   }
+   ic = m_Crowd.erase(m_Crowd.find(MOPSOCD_Key(m_pCrowd[from], from)));
+   m_Crowd.insert(ic, MOPSOCD_Key(m_pCrowd[from], to));
+
+   if(m_NumFun > 2)
+   {
+      pos = m_pKdPos[from];
+      if(pos >= 0) m_KdSlot[pos] = to;
+      else m_Recent[-1 - pos] = to;
+      m_pKdPos[to] = pos;
+   }
+
+   memcpy(GetVar(to), GetVar(from), sizeof(double)*m_NumVar);
+   memcpy(GetFit(to), GetFit(from), sizeof(double)*m_NumFun);
+   memcpy(&(m_pTerm[to*m_NumFun]), &(m_pTerm[from*m_NumFun]), sizeof(double)*m_NumFun);
+   m_pCrowd[to] = m_pCrowd[from];
+} /* end MoveSlot() */
+
+/******************************************************************************
+GetRanked()
+
+Slot of the member with the r-th largest crowding distance (r = 0 is the least
+crowded). Walks from whichever end of the ranking is nearer.
+******************************************************************************/
+int MOPSOCD_Archive::GetRanked(int r)
+{
+   MOPSOCD_CrowdIndex::iterator ic;
+   int k;
+
+   if(r < (m_Size / 2))
+   {
+      ic = m_Crowd.begin();
+      for(k = 0; k < r; k++) ic++;
+   }
+   else
+   {
+      ic = m_Crowd.end();
+      for(k = m_Size; k > r; k--) ic--;
+   }
+   return ic->second;
+} /* end GetRanked() */
+
+/******************************************************************************
+KdRebuild()
+
+Rebuild the k-d tree over all members, emptying the buffer.
+******************************************************************************/
+void MOPSOCD_Archive::KdRebuild(void)
+{
+   int i;
+
+   m_KdNode.clear();
+   m_KdBox.clear();
+   m_Recent.clear();
+   m_KdHoles = 0;
+
+   m_KdSlot.resize(m_Size);
+   m_KdLeaf.resize(m_Size);
+   for(i = 0; i < m_Size; i++)
+   {
+      m_KdSlot[i] = i;
+   }
+   if(m_Size > 0)
+   {
+      KdBuild(0, m_Size, -1);
+   }
+   for(i = 0; i < m_Size; i++)
+   {
+      m_pKdPos[m_KdSlot[i]] = i;
+   }
+} /* end KdRebuild() */
+
+/******************************************************************************
+KdBuild()
+
+Build the subtree over positions lo..hi-1 of the tree order, splitting at the
+median of the objective along which its box is widest. Returns the node.
+******************************************************************************/
+int MOPSOCD_Archive::KdBuild(int lo, int hi, int parent)
+{
+   MOPSOCD_KdNode node;
+   double * F, * lwr, * upr;
+   int k, p, f, split, mid, left, right;
+
+   k = (int)m_KdNode.size();
+   node.lo = lo;
+   node.hi = hi;
+   node.left = node.right = -1;
+   node.parent = parent;
+   node.live = hi - lo;
+   m_KdNode.push_back(node);
+   m_KdBox.resize(m_KdBox.size() + 2*m_NumFun);
+
+   lwr = &(m_KdBox[2*k*m_NumFun]);
+   upr = lwr + m_NumFun;
+   for(f = 0; f < m_NumFun; f++)
+   {
+      lwr[f] = HUGE_VAL;
+      upr[f] = -HUGE_VAL;
+   }
+   for(p = lo; p < hi; p++)
+   {
+      F = GetFit(m_KdSlot[p]);
+      for(f = 0; f < m_NumFun; f++)
+      {
+         if(F[f] < lwr[f]) lwr[f] = F[f];
+         if(F[f] > upr[f]) upr[f] = F[f];
+      }
+   }
+
+   if((hi - lo) <= MOPSOCD_KD_LEAF)
+   {
+      for(p = lo; p < hi; p++)
+      {
+         m_KdLeaf[p] = k;
+      }
+      return k;
+   }
+
+   split = 0;
+   for(f = 1; f < m_NumFun; f++)
+   {
+      if((upr[f] - lwr[f]) > (upr[split] - lwr[split])) split = f;
+   }
+   mid = (lo + hi) / 2;
+   std::nth_element(m_KdSlot.begin() + lo, m_KdSlot.begin() + mid, m_KdSlot.begin() + hi,
+      [this, split](int a, int b){ return (GetFit(a)[split] < GetFit(b)[split]); });
+
+   //children are added to the vector, so don't hold on to references
+   left = KdBuild(lo, mid, k);
+   right = KdBuild(mid, hi, k);
+   m_KdNode[k].left = left;
+   m_KdNode[k].right = right;
+   return k;
+} /* end KdBuild() */
+
+/******************************************************************************
+KdRemove()
+
+Take the i-th member out of the k-d tree (leaving a hole) or out of the buffer.
+******************************************************************************/
+void MOPSOCD_Archive::KdRemove(int i)
+{
+   int pos, k, last;
+
+   pos = m_pKdPos[i];
+   if(pos >= 0)
+   {
+      m_KdSlot[pos] = -1;
+      for(k = m_KdLeaf[pos]; k != -1; k = m_KdNode[k].parent)
+      {
+         m_KdNode[k].live--;
+      }
+      m_KdHoles++;
+   }
+   else
+   {
+      k = -1 - pos;
+      last = m_Recent.back();
+      m_Recent[k] = last;
+      m_pKdPos[last] = -1 - k;
+      m_Recent.pop_back();
+   }
+} /* end KdRemove() */
+
+/******************************************************************************
+KdIsDominated()
+
+IsDominated() using the buffer and the k-d tree.
+******************************************************************************/
+bool MOPSOCD_Archive::KdIsDominated(double * F)
+{
+   MOPSOCD_KdNode * pNode;
+   double * lwr, * upr;
+   int i, k, p, s;
+
+   for(i = 0; i < (int)m_Recent.size(); i++)
+   {
+      if(Covers(GetFit(m_Recent[i]), F) == true) return true;
+   }
+   if(m_KdNode.empty() == true) return false;
+
+   m_Stack.clear();
+   m_Stack.push_back(0);
+   while(m_Stack.empty() == false)
+   {
+      k = m_Stack.back();
+      m_Stack.pop_back();
+      pNode = &(m_KdNode[k]);
+      if(pNode->live == 0) continue;
+
+      lwr = &(m_KdBox[2*k*m_NumFun]);
+      upr = lwr + m_NumFun;
+      //no member can be as good as F
+      if(Covers(lwr, F) == false) continue;
+      //every member is at least as good as F
+      if(Covers(upr, F) == true) return true;
+
+      if(pNode->left == -1)
+      {
+         for(p = pNode->lo; p < pNode->hi; p++)
+         {
+            s = m_KdSlot[p];
+            if((s >= 0) && (Covers(GetFit(s), F) == true)) return true;
+         }
+      }
+      else
+      {
+         m_Stack.push_back(pNode->left);
+         m_Stack.push_back(pNode->right);
+      }
+   }/* end while() */
+   return false;
+} /* end KdIsDominated() */
+
+/******************************************************************************
+KdDominated()
+
+Add the members that F is at least as good as to m_Doomed, using the buffer
+and the k-d tree.
+******************************************************************************/
+void MOPSOCD_Archive::KdDominated(double * F)
+{
+   MOPSOCD_KdNode * pNode;
+   double * lwr, * upr;
+   int i, k, p, s;
+
+   for(i = 0; i < (int)m_Recent.size(); i++)
+   {
+      if(Covers(F, GetFit(m_Recent[i])) == true) m_Doomed.push_back(m_Recent[i]);
+   }
+   if(m_KdNode.empty() == true) return;
+
+   m_Stack.clear();
+   m_Stack.push_back(0);
+   while(m_Stack.empty() == false)
+   {
+      k = m_Stack.back();
+      m_Stack.pop_back();
+      pNode = &(m_KdNode[k]);
+      if(pNode->live == 0) continue;
+
+      lwr = &(m_KdBox[2*k*m_NumFun]);
+      upr = lwr + m_NumFun;
+      //F is not as good as any member
+      if(Covers(F, upr) == false) continue;
+
+      //F is at least as good as every member, or this is a leaf
+      if((Covers(F, lwr) == true) || (pNode->left == -1))
+      {
+         for(p = pNode->lo; p < pNode->hi; p++)
+         {
+            s = m_KdSlot[p];
+            if((s >= 0) && (Covers(F, GetFit(s)) == true)) m_Doomed.push_back(s);
+         }
+      }
+      else
+      {
+         m_Stack.push_back(pNode->left);
+         m_Stack.push_back(pNode->right);
+      }
+   }/* end while() */
+} /* end KdDominated() */
@@ -0,0 +1,312 @@
+/******************************************************************************
+File      : MaximinLatinHypercube.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Encapsulates a space-filling (maximin) Latin hypercube design.
+
+Version History
+10-19-26    lsm   created
+******************************************************************************/
+#include <stdio.h>
+#include <math.h>
+
+#include "MaximinLatinHypercube.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+/******************************************************************************
+Destroy()
+******************************************************************************/
+void MaximinLatinHypercube::Destroy(void)
+{
+   delete [] m_pLevels;
+   delete [] m_pJitter;
+   delete [] m_pNnDist;
+   delete [] m_pNnIdx;
+   delete [] m_pRowA;
+   delete [] m_pRowB;
+   m_pLevels = NULL;
+   m_pJitter = NULL;
+   m_pNnDist = NULL;
+   m_pNnIdx = NULL;
+   m_pRowA = NULL;
+   m_pRowB = NULL;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+CTOR
+
+Allocate a design of num points in dim dimensions. Call Generate() to fill it.
+******************************************************************************/
+MaximinLatinHypercube::MaximinLatinHypercube(int dim, int num)
+{
+   int i;
+
+   m_Dim = dim;
+   m_Num = num;
+   m_NumAccepted = 0;
+
+   NEW_PRINT("int", dim*num);
+   m_pLevels = new int[dim*num];
+   MEM_CHECK(m_pLevels);
+
+   NEW_PRINT("double", dim*num);
+   m_pJitter = new double[dim*num];
+   MEM_CHECK(m_pJitter);
+
+   NEW_PRINT("double", num);
+   m_pNnDist = new double[num];
+   MEM_CHECK(m_pNnDist);
+
+   NEW_PRINT("int", num);
+   m_pNnIdx = new int[num];
+   MEM_CHECK(m_pNnIdx);
+
+   NEW_PRINT("double", num);
+   m_pRowA = new double[num];
+   MEM_CHECK(m_pRowA);
+
+   NEW_PRINT("double", num);
+   m_pRowB = new double[num];
+   MEM_CHECK(m_pRowB);
+
+   for(i = 0; i < dim*num; i++)
+   {
+      m_pLevels[i] = 0;
+      m_pJitter[i] = 0.50;
+   }
+   for(i = 0; i < num; i++)
+   {
+      m_pNnDist[i] = 0.00;
+      m_pNnIdx[i] = i;
+   }
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Dist2()
+
+Squared distance between two points, in units of levels.
+******************************************************************************/
+double MaximinLatinHypercube::Dist2(int a, int b)
+{
+   int k;
+   double d, sum;
+   int * pA = &(m_pLevels[a*m_Dim]);
+   int * pB = &(m_pLevels[b*m_Dim]);
+
+   sum = 0.00;
+   for(k = 0; k < m_Dim; k++)
+   {
+      d = (double)(pA[k] - pB[k]);
+      sum += d*d;
+   }
+   return sum;
+} /* end Dist2() */
+
+/******************************************************************************
+FindNearest()
+
+Rebuild the nearest-neighbor entry of point a.
+******************************************************************************/
+void MaximinLatinHypercube::FindNearest(int a)
+{
+   int j;
+   double d;
+
+   m_pNnDist[a] = NEARLY_HUGE;
+   m_pNnIdx[a] = a;
+   for(j = 0; j < m_Num; j++)
+   {
+      if(j == a) continue;
+      d = Dist2(a, j);
+      if(d < m_pNnDist[a]){ m_pNnDist[a] = d; m_pNnIdx[a] = j;}
+   }
+} /* end FindNearest() */
+
+/******************************************************************************
+FindCritical()
+
+Locate a point that belongs to the closest pair.
+******************************************************************************/
+int MaximinLatinHypercube::FindCritical(void)
+{
+   int i, crit;
+
+   crit = 0;
+   for(i = 1; i < m_Num; i++)
+   {
+      if(m_pNnDist[i] < m_pNnDist[crit]) crit = i;
+   }
+   return crit;
+} /* end FindCritical() */
+
+/******************************************************************************
+TrySwap()
+
+Swap the levels of points a and b in dimension k if doing so increases the
+smallest distance involving a or b beyond the current smallest distance of the
+design (which involves a). All other distances are unchanged by the swap, so
+the design's smallest distance can not decrease.
+******************************************************************************/
+bool MaximinLatinHypercube::TrySwap(int a, int b, int k)
+{
+   int j, la, lb, lj, tmp;
+   double curMin, dA, dB, oa, ob;
+
+   curMin = m_pNnDist[a];
+   la = m_pLevels[a*m_Dim + k];
+   lb = m_pLevels[b*m_Dim + k];
+
+   //distance between a and b is unchanged, and bounds the new minimum
+   if(Dist2(a, b) <= curMin) return false;
+
+   for(j = 0; j < m_Num; j++)
+   {
+      if((j == a) || (j == b)) continue;
+      lj = m_pLevels[j*m_Dim + k];
+      oa = (double)(la - lj);
+      ob = (double)(lb - lj);
+      dA = Dist2(a, j) + ob*ob - oa*oa;
+      if(dA <= curMin) return false;
+      dB = Dist2(b, j) + oa*oa - ob*ob;
+      if(dB <= curMin) return false;
+      m_pRowA[j] = dA;
+      m_pRowB[j] = dB;
+   }/* end for() */
+
+   //accept
+   m_pLevels[a*m_Dim + k] = lb;
+   m_pLevels[b*m_Dim + k] = la;
+   m_pRowA[a] = m_pRowB[b] = NEARLY_HUGE;
+   m_pRowA[b] = m_pRowB[a] = Dist2(a, b);
+
+   m_pNnDist[a] = m_pNnDist[b] = NEARLY_HUGE;
+   for(j = 0; j < m_Num; j++)
+   {
+      if(m_pRowA[j] < m_pNnDist[a]){ m_pNnDist[a] = m_pRowA[j]; m_pNnIdx[a] = j;}
+      if(m_pRowB[j] < m_pNnDist[b]){ m_pNnDist[b] = m_pRowB[j]; m_pNnIdx[b] = j;}
+   }
+
+   for(j = 0; j < m_Num; j++)
+   {
+      if((j == a) || (j == b)) continue;
+      if((m_pNnIdx[j] == a) || (m_pNnIdx[j] == b))
+      {
+         //old neighbor moved away, may need a full search
+         tmp = (m_pRowA[j] < m_pRowB[j]) ? a : b;
+         dA = (tmp == a) ? m_pRowA[j] : m_pRowB[j];
+         if(dA <= m_pNnDist[j]){ m_pNnDist[j] = dA; m_pNnIdx[j] = tmp;}
+         else FindNearest(j);
+      }
+      else
+      {
+         if(m_pRowA[j] < m_pNnDist[j]){ m_pNnDist[j] = m_pRowA[j]; m_pNnIdx[j] = a;}
+         if(m_pRowB[j] < m_pNnDist[j]){ m_pNnDist[j] = m_pRowB[j]; m_pNnIdx[j] = b;}
+      }
+   }/* end for() */
+
+   m_NumAccepted++;
+   return true;
+} /* end TrySwap() */
+
+/******************************************************************************
+Generate()
+
+Create a random Latin hypercube and then perform up to maxIters trial swaps.
+******************************************************************************/
+void MaximinLatinHypercube::Generate(int maxIters)
+{
+   int i, j, k, r, tmp, a, b, crit, iter;
+   double d;
+
+   //random permutation of levels in each dimension
+   for(k = 0; k < m_Dim; k++)
+   {
+      for(i = 0; i < m_Num; i++){ m_pLevels[i*m_Dim + k] = i;}
+      for(i = m_Num - 1; i > 0; i--)
+      {
+         r = MyRand() % (i + 1);
+         tmp = m_pLevels[i*m_Dim + k];
+         m_pLevels[i*m_Dim + k] = m_pLevels[r*m_Dim + k];
+         m_pLevels[r*m_Dim + k] = tmp;
+      }
+   }/* end for() */
+   for(i = 0; i < m_Dim*m_Num; i++)
+   {
+      m_pJitter[i] = (double)MyRand() / ((double)MY_RAND_MAX + 1.00);
+   }
+
+   m_NumAccepted = 0;
+   if(m_Num < 3) return;
+
+   //nearest-neighbor table, each pair visited once
+   for(i = 0; i < m_Num; i++){ m_pNnDist[i] = NEARLY_HUGE;}
+   for(i = 0; i < m_Num; i++)
+   {
+      for(j = i + 1; j < m_Num; j++)
+      {
+         d = Dist2(i, j);
+         if(d < m_pNnDist[i]){ m_pNnDist[i] = d; m_pNnIdx[i] = j;}
+         if(d < m_pNnDist[j]){ m_pNnDist[j] = d; m_pNnIdx[j] = i;}
+      }
+   }/* end for() */
+
+   for(iter = 0; iter < maxIters; iter++)
+   {
+      crit = FindCritical();
+      a = ((MyRand() & 1) == 0) ? crit : m_pNnIdx[crit];
+      b = MyRand() % (m_Num - 1);
+      if(b >= a) b++;
+      k = MyRand() % m_Dim;
+      TrySwap(a, b, k);
+   }/* end for() */
+} /* end Generate() */
+
+/******************************************************************************
+GetPoint()
+
+Point idx of the design in the unit hypercube.
+******************************************************************************/
+void MaximinLatinHypercube::GetPoint(int idx, double * pUnit)
+{
+   int k;
+
+   for(k = 0; k < m_Dim; k++)
+   {
+      pUnit[k] = ((double)m_pLevels[idx*m_Dim + k] + m_pJitter[idx*m_Dim + k]) / (double)m_Num;
+   }
+} /* end GetPoint() */
+
+/******************************************************************************
+GetScaledPoint()
+
+Point idx of the design, scaled to the given bounds.
+******************************************************************************/
+void MaximinLatinHypercube::GetScaledPoint(int idx, Ironclad1DArray pLwr, Ironclad1DArray pUpr, double * pX)
+{
+   int k;
+
+   GetPoint(idx, pX);
+   for(k = 0; k < m_Dim; k++)
+   {
+      pX[k] = pLwr[k] + pX[k]*(pUpr[k] - pLwr[k]);
+   }
+} /* end GetScaledPoint() */
+
+/******************************************************************************
+GetMinDistance()
+
+Smallest distance between level centers, in unit hypercube coordinates.
+******************************************************************************/
+double MaximinLatinHypercube::GetMinDistance(void)
+{
+   if(m_Num < 2) return 0.00;
+   if(m_Num < 3) return sqrt(Dist2(0, 1)) / (double)m_Num;
+   return sqrt(m_pNnDist[FindCritical()]) / (double)m_Num;
+} /* end GetMinDistance() */
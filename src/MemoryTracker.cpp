@@ -7,12 +7,74 @@ Track memory usage of sub-routines.
 
 Version History
 01-29-13    lsm   added copyright information and initial comments.
+10-19-26    lsm   added GetNumAllocs(), which counts calls to operator new.
+10-19-26    lsm   operator new is only replaced if OSTRICH_COUNT_ALLOCS is defined
 ******************************************************************************/
 #include "MemoryTracker.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <new>
+
+/******************************************************************************
+Counting of heap allocations (-DOSTRICH_COUNT_ALLOCS). The replacement
+operator new only increments a per-thread counter, so allocations made by
+background threads (e.g. the ModelArchiver) aren't charged to the evaluations
+of the main thread.
+******************************************************************************/
+#ifdef OSTRICH_COUNT_ALLOCS
+static thread_local long long gNumAllocs = 0;
+
+void * operator new(size_t size)
+{
+   void * p;
+
+   gNumAllocs++;
+   p = malloc((size > 0) ? size : 1);
+   if(p == NULL) throw std::bad_alloc();
+   return p;
+}
+
+void * operator new[](size_t size)
+{
+   return operator new(size);
+}
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept
+{
+   gNumAllocs++;
+   return malloc((size > 0) ? size : 1);
+}
+
+void * operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+   gNumAllocs++;
+   return malloc((size > 0) ? size : 1);
+}
+
+void operator delete(void * p) noexcept { free(p);}
+void operator delete[](void * p) noexcept { free(p);}
+void operator delete(void * p, size_t) noexcept { free(p);}
+void operator delete[](void * p, size_t) noexcept { free(p);}
+void operator delete(void * p, const std::nothrow_t &) noexcept { free(p);}
+void operator delete[](void * p, const std::nothrow_t &) noexcept { free(p);}
+#endif /* OSTRICH_COUNT_ALLOCS */
+
+/******************************************************************************
+GetNumAllocs()
+
+Number of heap allocations made by the calling thread, or -1 if allocations
+aren't counted.
+******************************************************************************/
+long long GetNumAllocs(void)
+{
+#ifdef OSTRICH_COUNT_ALLOCS
+   return gNumAllocs;
+#else
+   return -1;
+#endif
+}/* end GetNumAllocs() */
 
 #ifdef __APPLE__
 void LogMemUsage(char * file, const char * tag)
@@ -50,6 +50,28 @@ Version History
                      EndSuperMUSE
 03-20-2010   lsm   Added support for warm starting Ostrich using previously
                    generated OstModel0.txt file.
+10-19-26     lsm   Added space-filling parameter initializers, selected with
+                   'ParamInitializer sobol|halton|maximinlhs'.
+10-19-26     lsm   Added per-evaluation profiling of substitution, model execution,
+                   response extraction and objective function phases.
+10-19-26     lsm   Internal models are also supported by the multi-objective
+                   Execute(). Synthetic benchmark models are registered when
+                   compiled with OSTRICH_BENCH (see BenchModels.h).
+10-19-26     lsm   External models are run with RunModelCommand(), so that a
+                   stop request cancels a model run that is in progress.
+10-19-26     lsm   Built-in model output preservation is done by a background
+                   ModelArchiver, which stores changed files only once as
+                   content-addressed blobs (see ModelArchiver.h).
+10-19-26     lsm   Added an in-process surrogate of the objective function, selected
+                   with 'SurrogateEngine rbf|gp' (see SurrogateEngine.h). Every
+                   complex model run is added to the surrogate.
+10-19-26     lsm   Added WriteCheckpoint() and ReadCheckpoint(), which save the
+                   model counters and the surrogate engine (see Checkpoint.h).
+10-19-26     lsm   Model subdirectories are populated in-process, without a
+                   shell, by a WorkerProvisioner (see WorkerProvisioner.h).
+10-19-26     lsm   Steady-state evaluations don't allocate: CheckCache() reuses
+                   its line buffer and the obj. func. category (which re-reads
+                   the OstModel files) is only determined for preservation.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -64,6 +86,9 @@ namespace fs = std::filesystem;
 #endif
 
 #include "Model.h"
+#include "Profiler.h"
+#include "BenchModels.h"
+#include "StopSignal.h"
 #include "ObservationGroup.h"
 #include "Observation.h"
 #include "ResponseVarGroup.h"
@@ -72,6 +97,8 @@ namespace fs = std::filesystem;
 #include "ParameterABC.h"
 #include "FilePair.h"
 #include "FileList.h"
+#include "ModelArchiver.h"
+#include "WorkerProvisioner.h"
 #include "AccessConverter.h"
 #include "NetCDFConverter.h"
 #include "PumpAndTreat.h"
@@ -79,6 +106,8 @@ namespace fs = std::filesystem;
 #include "SuperMUSE.h"
 #include "ParameterCorrection.h"
 #include "ParamInitializerABC.h"
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
 #include "GenConstrainedOpt.h"
 
 #include "IsoParse.h"
@@ -152,39 +181,14 @@ void Model::PreserveModel(int rank, int trial, int counter, IroncladString ofcat
    }
 
    /* use built in preservation option
-      Saves everything that was not an input file or folder
+      Saves everything that was not an input file or folder, in
+      archive/<prefix><rank>/run_<counter-1>. Only changed files are
+      snapshotted here, the rest is done by the archiver's thread.
    */
    if(m_PreserveCmd == NULL)
    {   
-      // Get the current path to the worker
-      fs::path directory = fs::current_path();
-      
-      // Move up one directory to project directory
-      directory = directory.parent_path();
-
-      // Construct the archive folder
-      directory /= std::string("archive");
-      if (!fs::exists(directory)) {
-          fs::create_directory(directory);
-      };
-
-      // Construct the worker folder
-      directory /= m_DirPrefix + std::to_string(rank);
-      if (!fs::exists(directory)) {
-          fs::create_directory(directory);
-      }
-
-      // Construct the run folder 
-      directory /= "run_" + std::to_string(counter - 1); // This adjusts by one to align with the model output files
-      fs::create_directory(directory);
-
-      // Move the files from the worker to the archive
-      // TODO: Add an exclude operation to prevent copying unnecessary files
-      fs::copy(fs::current_path(), directory, fs::copy_options::recursive);
-
-      // Cleanup the worker
-      m_pFileCleanupList->Cleanup(directory);
-
+      std::string worker = m_DirPrefix + std::to_string(rank);
+      m_pArchiver->Archive(worker.c_str(), counter, ofcat);
    }/* end if() */
    /* run the user-supplied preservation command */
    else
@@ -229,9 +233,12 @@ Model::Model(void)
    IroncladString inFileName = GetInFileName();
    UnmoveableString pDirName = GetExeDirName();
 
+   ProfilerInit(inFileName);
+
    strcpy(m_DirPrefix, ".");
    m_pParameterCorrection = NULL;
    m_pParamInitializer = NULL;
+   m_pSurrogate = NULL;
    m_pDecision = NULL;
    m_ExecCmd = NULL;
    m_SaveCmd = NULL;
@@ -242,6 +249,8 @@ Model::Model(void)
    m_FileList = NULL;
    m_DbaseList = NULL;
    m_pFileCleanupList = NULL;
+   m_pArchiver = NULL;
+   m_pProvisioner = NULL;
    m_Counter = 0;
    m_Precision = 6;
    m_pObjFunc = NULL;
@@ -256,6 +265,8 @@ Model::Model(void)
    m_bCaching = false;
    m_bDiskless = false;
    m_NumCacheHits = 0;
+   m_pCacheLine = NULL;
+   m_CacheLineSize = 0;
    m_firstCall = true;
 
    #ifdef _WIN32
@@ -307,12 +318,14 @@ Model::Model(void)
    if(pDirName[0] != '.')
    {
       std::string dirName;
-      std::string mkdirCmd;
       MPI_Comm_rank(MPI_COMM_WORLD, &id);
       dirName = std::string(pDirName) + std::to_string(id);
       strcpy(pDirName, dirName.data());
-      mkdirCmd = "mkdir " + dirName;
-      system(mkdirCmd.data());      
+
+      //the directory is populated by Provision(), once all files are known
+      NEW_PRINT("WorkerProvisioner", 1);
+      m_pProvisioner = new WorkerProvisioner(inFileName, m_DirPrefix);
+      MEM_CHECK(m_pProvisioner);
    }/* end if() */
 
    /*
@@ -392,13 +405,7 @@ Model::Model(void)
 
    if((pDirName[0] != '.') && (m_InternalModel == false))
    {
-      std::string copyCmd;
-      #ifdef _WIN32
-         copyCmd = "copy " + std::string(tmp1) + " " + std::string(pDirName);
-      #else
-         copyCmd = "cp " + std::string(tmp1) + " " + std::string(pDirName);      
-      #endif
-      system(copyCmd.data());
+      m_pProvisioner->AddFile(tmp1);
    } /* end if() */
 
    if(m_InternalModel == false)
@@ -499,18 +506,9 @@ Model::Model(void)
          // add to cleanup list
          m_pFileCleanupList->Insert(tmp1);
 
-         // Move the file
+         // Copy the file to the worker
          if(pDirName[0] != '.') {
-             // Construct the worker path 
-             fs::path workerPath = fs::current_path() /= std::string(pDirName);
-             workerPath /= tmp1;
-
-             // Construct the path to the source file
-             fs::path sourcePath = fs::current_path() /= tmp1;
-
-            // Copy the file from the source to the worker path
-             fs::copy_file(sourcePath, workerPath);
-               
+             m_pProvisioner->AddPath(tmp1);
          }/* end if() */
 
          line = GetNxtDataLine(pInFile, inFileName);
@@ -537,22 +535,13 @@ Model::Model(void)
          //extra dir
          ExtractFileName(line, tmp1);
 
-         // Move all entries in the directory
+         // Copy all entries in the directory to the worker
          if(pDirName[0] != '.') {
-             // Construct the worker path 
-             fs::path workerPath = fs::current_path() /= std::string(pDirName);
-             workerPath /= tmp1;
-
-             if (~fs::exists(workerPath)) {
-                 fs::create_directories(workerPath);
-             }
+             m_pProvisioner->AddPath(tmp1);
 
              // Construct the path to the source source
              fs::path sourcePath = fs::current_path() /= tmp1;
 
-             // Copy the files
-             fs::copy(sourcePath, workerPath, fs::copy_options::recursive);
-
              // Get a list of files in the source directory
              std::vector<std::string> sourceFiles;
              for (const auto& entry : fs::recursive_directory_iterator(sourcePath)) {
@@ -622,13 +611,7 @@ Model::Model(void)
 
       if(pDirName[0] != '.')
       {
-         std::string copyCmd;
-         #ifdef _WIN32
-            copyCmd = "copy " + std::string(tmp1) + " " + std::string(pDirName);
-         #else
-            copyCmd = "cp " + std::string(tmp1) + " " + std::string(pDirName);
-         #endif
-         system(copyCmd.data());
+         m_pProvisioner->AddFile(tmp1);
       } /* end if() */
 
       //make sure the executable exists
@@ -792,13 +775,7 @@ Model::Model(void)
          //stage to workdir if needed
          if(pDirName[0] != '.')
          {
-            std::string copyCmd;
-            #ifdef _WIN32
-               copyCmd = "copy " + std::string(tmp1) + " " + std::string(pDirName);
-            #else
-               copyCmd = "cp " + std::string(tmp1) + " " + std::string(pDirName);
-            #endif
-            system(copyCmd.data());
+            m_pProvisioner->AddFile(tmp1);
          } /* end if() */
 
          //make sure the executable exists
@@ -824,6 +801,24 @@ Model::Model(void)
       } /* end else() */
    }/* end if() */
 
+   /*
+   --------------------------------------------------------------------
+   Populate the model subdirectory with the executables and the extra
+   files and folders.
+   --------------------------------------------------------------------
+   */
+   if(m_pProvisioner != NULL)
+   {
+      m_pProvisioner->Provision();
+   }
+
+   if((m_bPreserveModelOutput == true) && (m_PreserveCmd == NULL))
+   {
+      NEW_PRINT("ModelArchiver", 1);
+      m_pArchiver = new ModelArchiver(inFileName, m_pFileCleanupList);
+      MEM_CHECK(m_pArchiver);
+   }
+
    /*
    --------------------------------------------------------------------
    Read in warm start flag. This only applies if we want to restart
@@ -944,6 +939,34 @@ Model::Model(void)
       MyStrLwr(paramInitializer);
    }/* end if() */
 
+   /*
+   --------------------------------------------------------------------
+   Read in surrogate engine type, if any.
+   --------------------------------------------------------------------
+   */
+   char srgEngine[DEF_STR_SZ];
+   char srgMsg[2*DEF_STR_SZ];
+   strcpy(srgEngine, "");
+   rewind(pInFile);
+   //skip the optional BeginSurrogateEngine ... EndSurrogateEngine section
+   while(CheckToken(pInFile, "SurrogateEngine", inFileName) == true)
+   {  
+      line = GetCurDataLine(); 
+      sscanf(line, "%s %s", tmp1, srgEngine);
+      if(strcmp(tmp1, "SurrogateEngine") == 0) break;
+      strcpy(srgEngine, "");
+   }/* end while() */
+   if(srgEngine[0] != '\0')
+   {
+      MyStrLwr(srgEngine);
+      if((strcmp(srgEngine, "rbf") != 0) && (strcmp(srgEngine, "gp") != 0))
+      {
+         snprintf(srgMsg, 2*DEF_STR_SZ, "Unknown surrogate engine (%s), must be rbf or gp", srgEngine);
+         LogError(ERR_FILE_IO, srgMsg);
+         ExitProgram(1);
+      }
+   }/* end if() */
+
    fclose(pInFile);
 
    if(bSMUSE) CleanSuperMUSE();
@@ -1075,6 +1098,20 @@ Model::Model(void)
    {
       m_pParamInitializer = new KMeansParamInitializer(m_pParamGroup, pInFile);
    }
+   else if((strcmp(paramInitializer, "sobol") == 0) ||
+           (strcmp(paramInitializer, "halton") == 0) ||
+           (strcmp(paramInitializer, "maximinlhs") == 0))
+   {
+      m_pParamInitializer = new QuasiRandomParamInitializer(m_pParamGroup, pInFile, paramInitializer);
+   }
+
+   // check for surrogate engine
+   if((srgEngine[0] != '\0') && (m_pParamGroup != NULL))
+   {
+      NEW_PRINT("SurrogateEngine", 1);
+      m_pSurrogate = new SurrogateEngine(m_pParamGroup, pInFile, srgEngine);
+      MEM_CHECK(m_pSurrogate);
+   }
    fclose(pInFile);
 
    IncCtorCount();
@@ -1137,13 +1174,18 @@ void Model::Destroy(void)
    delete m_pParamGroup;
    delete m_pParameterCorrection;
    delete m_pParamInitializer;
+   delete m_pSurrogate;
    delete m_pObjFunc;
    delete m_FileList;
    delete m_DbaseList;
    delete [] m_ExecCmd;
    delete [] m_SaveCmd;
    delete [] m_PreserveCmd;
+   //finish archiving before the worker files are cleaned up
+   delete m_pArchiver;
+   delete m_pProvisioner;
    delete [] m_CurMultiObjF;
+   delete [] m_pCacheLine;
    m_bSave = false;
    delete m_pDecision;
 
@@ -1288,6 +1330,8 @@ void Model::Execute(double * pF, int nObj)
    FilePair * pCur;
    FilePipe * pPipe;
    int rank;
+   double tStart;
+   ProfileScope evalScope(PROF_EVAL);
 
    //initialize costs
    for(int i = 0; i < nObj; i++)
@@ -1307,6 +1351,7 @@ void Model::Execute(double * pF, int nObj)
    m_Counter++;
 
    //make substitution of parameters into model input file
+   tStart = ProfilerStart();
    pCur = m_FileList;
    while(pCur != NULL)
    {
@@ -1323,11 +1368,24 @@ void Model::Execute(double * pF, int nObj)
    {
       m_pParamGroup->SubIntoDbase(m_DbaseList);
    } /* end while() */
+   ProfilerStop(PROF_SUBST, tStart);
 
-   //invoke system command to execute the model   
-   system(m_ExecCmd);
+   //invoke system command (or internal model) to execute the model   
+   tStart = ProfilerStart();
+   if(m_InternalModel == true)
+   {
+      RunInternalModel();
+   }
+   else if(RunModelCommand(m_ExecCmd) == MODEL_CANCELLED)
+   {
+      //in-flight run was cancelled by a stop request
+      if(dirName[0] != '.') { MY_CHDIR("..");}
+      return;
+   }
+   ProfilerStop(PROF_MODEL, tStart);
 
    //extract computed reponses from model output database(s)
+   tStart = ProfilerStart();
    if(m_DbaseList != NULL)
    {
       DatabaseABC * pCur;
@@ -1345,11 +1403,17 @@ void Model::Execute(double * pF, int nObj)
       }
    }
 
+   ProfilerStop(PROF_READ, tStart);
+
    //extract computed observations from model output file(s)
+   tStart = ProfilerStart();
    if(m_pObsGroup != NULL){ m_pObsGroup->ExtractVals();}
+   ProfilerStop(PROF_EXTRACT, tStart);
 
    //compute obj. func.
+   tStart = ProfilerStart();
    m_pObjFunc->CalcMultiObjFunc(pF, nObj);
+   ProfilerStop(PROF_OBJFUNC, tStart);
 
    //categorize the obj. func.
    if (dirName[0] != '.') { MY_CHDIR(".."); }
@@ -1357,7 +1421,9 @@ void Model::Execute(double * pF, int nObj)
    if (dirName[0] != '.') { MY_CHDIR(dirName); }
 
    //preserve model output, if desired
+   tStart = ProfilerStart();
    PreserveModel(rank, GetTrialNumber(), m_Counter, pCatStr);
+   ProfilerStop(PROF_PRESERVE, tStart);
 
    //cd out of model subdirectory, if needed
    if(dirName[0] != '.') { MY_CHDIR("..");}
@@ -1373,15 +1439,42 @@ void Model::Execute(double * pF, int nObj)
       m_CurMultiObjF[i] = pF[i];
    }
 
+   tStart = ProfilerStart();
    Write(val);
+   ProfilerStop(PROF_WRITE, tStart);
 } /* end Execute() */
 
+/*****************************************************************************
+RunInternalModel()
+   Executes an internal model, i.e. a function call of the form "Name()".
+******************************************************************************/
+void Model::RunInternalModel(void)
+{
+   if(strcmp(m_ExecCmd, "Isotherm()") == 0){ Isotherm(m_bDiskless);}
+   else if(strcmp(m_ExecCmd, "Orear()") == 0){ Orear();}
+   else if(strcmp(m_ExecCmd, "McCammon()") == 0){ McCammon(m_bDiskless);}
+   else if(strcmp(m_ExecCmd, "Kinniburgh()") == 0){ Kinniburgh(m_bDiskless);}
+   else if(strcmp(m_ExecCmd, "AdvancedKinniburgh()") == 0){ AdvancedKinniburgh();}
+   else if(strcmp(m_ExecCmd, "BoxCox()") == 0){ BoxCoxModel();}
+#ifdef OSTRICH_BENCH
+   else if(strcmp(m_ExecCmd, "Rosenbrock()") == 0){ RosenbrockModel();}
+   else if(strcmp(m_ExecCmd, "Griewank()") == 0){ GriewankModel();}
+   else if(strcmp(m_ExecCmd, "ZDT()") == 0){ ZDTModel();}
+   else if(strcmp(m_ExecCmd, "DTLZ()") == 0){ DTLZModel();}
+   else if(strcmp(m_ExecCmd, "Sleep()") == 0){ SleepModel();}
+   else if(strcmp(m_ExecCmd, "BigOutput()") == 0){ BigOutputModel();}
+#endif
+   else{LogError(ERR_BAD_ARGS, "Unknown internal model"); ExitProgram(1);}
+} /* end RunInternalModel() */
+
 /*****************************************************************************
 DisklessExecute()
    Executes an inernal model without using I/O.
 ******************************************************************************/
 double Model::DisklessExecute(void)
 {   
+   ProfileScope evalScope(PROF_EVAL);
+
    //inc. number of times model has been executed
    m_Counter++;
 
@@ -1398,6 +1491,8 @@ double Model::DisklessExecute(void)
  
    m_CurObjFuncVal = val;
 
+   if(m_pSurrogate != NULL){ m_pSurrogate->AddModelRun(val);}
+
    return (val);
 }/* end DisklessExecute() */
 
@@ -1421,6 +1516,9 @@ GetObjFuncCategory()
 ******************************************************************************/
 IroncladString Model::GetObjFuncCategory(double * pF, int nObj)
 {
+   //the category is only used for preservation, and is costly to determine
+   if(m_bPreserveModelOutput == false) return ObjFuncOther;
+
    switch(GetProgramType())
    {
       /* single objective optimizers */
@@ -1548,9 +1646,10 @@ double Model::StdExecute(double viol)
    IroncladString dirName = GetExeDirName();
    FilePair * pCur;
    FilePipe * pPipe;
-   double val;
+   double val, tStart;
    int rank;
    bool isGoodTopo;
+   ProfileScope evalScope(PROF_EVAL);
 
    //exit early if the user has requested program termination
    if(IsQuit() == true){ return NEARLY_HUGE;}
@@ -1572,6 +1671,7 @@ double Model::StdExecute(double viol)
    }
 
    //make substitution of parameters into model input file
+   tStart = ProfilerStart();
    pCur = m_FileList;
    while(pCur != NULL)
    {
@@ -1588,6 +1688,7 @@ double Model::StdExecute(double viol)
    {
       m_pParamGroup->SubIntoDbase(m_DbaseList);
    } /* end while() */
+   ProfilerStop(PROF_SUBST, tStart);
 
    /* -----------------------------------------------------------
    If caching is enabled, attempt to read model evaluation
@@ -1605,23 +1706,25 @@ double Model::StdExecute(double viol)
       }
    }/* end if() */
 
+   tStart = ProfilerStart();
    if(m_InternalModel == true)
    {
-      if(strcmp(m_ExecCmd, "Isotherm()") == 0){ Isotherm(m_bDiskless);}
-      else if(strcmp(m_ExecCmd, "Orear()") == 0){ Orear();}
-      else if(strcmp(m_ExecCmd, "McCammon()") == 0){ McCammon(m_bDiskless);}
-      else if(strcmp(m_ExecCmd, "Kinniburgh()") == 0){ Kinniburgh(m_bDiskless);}
-      else if(strcmp(m_ExecCmd, "AdvancedKinniburgh()") == 0){ AdvancedKinniburgh();}
-      else if(strcmp(m_ExecCmd, "BoxCox()") == 0){ BoxCoxModel();}
-      else{LogError(ERR_BAD_ARGS, "Unknown internal model"); ExitProgram(1);}
+      RunInternalModel();
    }
    else
    {
       //invoke system command to execute the model   
-      system(m_ExecCmd);
+      if(RunModelCommand(m_ExecCmd) == MODEL_CANCELLED)
+      {
+         //in-flight run was cancelled by a stop request
+         if(dirName[0] != '.') { MY_CHDIR("..");}
+         return NEARLY_HUGE;
+      }
    }/* end else (external model) */
+   ProfilerStop(PROF_MODEL, tStart);
 
    //extract computed reponses from model output database(s)
+   tStart = ProfilerStart();
    if(m_DbaseList != NULL)
    {
       DatabaseABC * pCur;
@@ -1639,11 +1742,17 @@ double Model::StdExecute(double viol)
       }
    }
 
+   ProfilerStop(PROF_READ, tStart);
+
    //extract computed observations from model output file(s)
+   tStart = ProfilerStart();
    if(m_pObsGroup != NULL){ m_pObsGroup->ExtractVals();}
+   ProfilerStop(PROF_EXTRACT, tStart);
 
    //compute obj. func.
+   tStart = ProfilerStart();
    val = m_pObjFunc->CalcObjFunc();
+   ProfilerStop(PROF_OBJFUNC, tStart);
 
    //add in penalty for violation of parameter bounds
    val += viol*MyMax(1.00,val);
@@ -1652,16 +1761,23 @@ double Model::StdExecute(double viol)
    IroncladString pCatStr = GetObjFuncCategory(&val, 1);
 
    //preserve model output, if desired
+   tStart = ProfilerStart();
    PreserveModel(rank, GetTrialNumber(), m_Counter, pCatStr);
+   ProfilerStop(PROF_PRESERVE, tStart);
 
    //cd out of model subdirectory, if needed
    if(dirName[0] != '.') { MY_CHDIR("..");}
    
    //ouput results
+   tStart = ProfilerStart();
    Write(val);
+   ProfilerStop(PROF_WRITE, tStart);
 
    m_CurObjFuncVal = val;
 
+   //add the run to the surrogate engine, if any
+   if(m_pSurrogate != NULL){ m_pSurrogate->AddModelRun(val);}
+
    return (val);
 } /* end StdExecute() */
 
@@ -1686,13 +1802,21 @@ bool Model::CheckCache(double * val)
    if(pGroup == NULL) return false;
    int np = pGroup->GetNumParams();
 
+   //line buffer is reused by subsequent calls
    max_line_size = GetMaxLineSizeInFile((char *)"OstModel0.txt");
-   line = new char[max_line_size+1];
+   if(m_CacheLineSize < (max_line_size+1))
+   {
+      delete [] m_pCacheLine;
+      m_CacheLineSize = max_line_size+1;
+      NEW_PRINT("char", m_CacheLineSize);
+      m_pCacheLine = new char[m_CacheLineSize];
+      MEM_CHECK(m_pCacheLine);
+   }
+   line = m_pCacheLine;
    line[0] = NULLSTR;
    pIn = fopen("OstModel0.txt", "r");
    if(pIn == NULL)
    {
-      delete [] line;
       return false;
    }
    while(!feof(pIn))
@@ -1726,12 +1850,10 @@ bool Model::CheckCache(double * val)
       {
          fclose(pIn);
          *val = objFunc;
-         delete [] line;
          return true;
       }
    }/* end while() */
    fclose(pIn);
-   delete [] line;
    return false;
 }/* end CheckCache() */
 
@@ -1778,6 +1900,9 @@ void Model::Write(double objFuncVal)
    std::string name;
    int id;   
 
+   //logging may be disabled by algorithms that persist their own results
+   if(GetModelLogging() == false) return;
+
    pRespVarGroup = NULL;
    if(m_pObjFunc != NULL)
    {
@@ -1869,8 +1994,48 @@ void Model::WriteMetrics(FILE * pFile)
       if(m_pParameterCorrection != NULL)
          m_pParameterCorrection->WriteMetrics(pFile);
    }
+   if(m_pSurrogate != NULL)
+      m_pSurrogate->WriteMetrics(pFile);
+   if(m_pProvisioner != NULL)
+      m_pProvisioner->WriteMetrics(pFile);
 } /* end WriteMetrics() */
 
+/******************************************************************************
+WriteCheckpoint()
+
+Save the state of the model. The model cache is kept in OstModel0.txt, which
+is restored by the checkpoint itself.
+******************************************************************************/
+void Model::WriteCheckpoint(Checkpoint * pCkpt)
+{
+   pCkpt->WriteInt(m_Counter);
+   pCkpt->WriteInt(m_NumCacheHits);
+   pCkpt->WriteDouble(m_CurObjFuncVal);
+   pCkpt->WriteInt((m_pSurrogate != NULL) ? 1 : 0);
+   if(m_pSurrogate != NULL)
+      m_pSurrogate->WriteCheckpoint(pCkpt);
+} /* end WriteCheckpoint() */
+
+/******************************************************************************
+ReadCheckpoint()
+
+Restore the state of the model. OstModel0.txt is kept and appended to.
+******************************************************************************/
+void Model::ReadCheckpoint(Checkpoint * pCkpt)
+{
+   m_Counter = pCkpt->ReadInt();
+   m_NumCacheHits = pCkpt->ReadInt();
+   m_CurObjFuncVal = pCkpt->ReadDouble();
+   m_firstCall = false;
+   if(pCkpt->ReadInt() != ((m_pSurrogate != NULL) ? 1 : 0))
+   {
+      LogError(ERR_FILE_IO, "Checkpoint and input file disagree on the SurrogateEngine");
+      ExitProgram(1);
+   }
+   if(m_pSurrogate != NULL)
+      m_pSurrogate->ReadCheckpoint(pCkpt);
+} /* end ReadCheckpoint() */
+
 /******************************************************************************
  * ExcludeConstantParameters()
  *
@@ -0,0 +1,663 @@
+/******************************************************************************
+File     : ModelArchiver.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Background archiving of model output with content-addressed storage. See
+ModelArchiver.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   Unchanged files are also matched by inode and status change
+                  time, and files modified within a timestamp tick of their
+                  snapshot are always snapshotted again.
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <chrono>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <spawn.h>
+  #include <sys/wait.h>
+#endif
+#ifdef __linux__
+  #include <sys/ioctl.h>
+  #include <linux/fs.h>
+#endif
+
+#include "ModelArchiver.h"
+
+#include "Model.h"
+#include "FileList.h"
+#include "Exception.h"
+#include "Utility.h"
+
+#define ARCHIVE_BUF_SZ (65536)
+
+typedef unsigned long long ArchiveWord;
+
+/******************************************************************************
+ArchiveStat()
+
+Size, inode, and modification and status change times (in nanoseconds) of a 
+file.
+******************************************************************************/
+static bool ArchiveStat(const fs::path & path, ArchiveFile * pFile)
+{
+   struct stat info;
+
+   if(stat(path.string().c_str(), &info) != 0) return false;
+   pFile->size = (long long)info.st_size;
+   pFile->inode = (long long)info.st_ino;
+#ifdef __linux__
+   pFile->mtime = (long long)info.st_mtim.tv_sec*1000000000LL + (long long)info.st_mtim.tv_nsec;
+   pFile->ctime = (long long)info.st_ctim.tv_sec*1000000000LL + (long long)info.st_ctim.tv_nsec;
+#else
+   pFile->mtime = (long long)info.st_mtime*1000000000LL;
+   pFile->ctime = (long long)info.st_ctime*1000000000LL;
+#endif
+   return true;
+} /* end ArchiveStat() */
+
+/******************************************************************************
+ArchiveUnchanged()
+
+True if a file is known to hold the contents of its last snapshot: same size,
+inode and timestamps, and not modified within a timestamp tick of the 
+snapshot (otherwise it may have been rewritten without changing them).
+******************************************************************************/
+static bool ArchiveUnchanged(const ArchiveFile & known, const ArchiveFile & file)
+{
+   return((known.size == file.size) && (known.inode == file.inode) &&
+          (known.mtime == file.mtime) && (known.ctime == file.ctime) &&
+          (known.mtime < (known.taken - ARCHIVE_TICK_NS)));
+} /* end ArchiveUnchanged() */
+
+/******************************************************************************
+ArchiveClone()
+
+Snapshot a file. A reflink shares the data blocks of the source until either
+file is modified, so it is nearly free on filesystems that support it (btrfs,
+XFS, ...). Otherwise the file is copied.
+******************************************************************************/
+static void ArchiveClone(const fs::path & src, const fs::path & dst)
+{
+#if defined(__linux__) && defined(FICLONE)
+   int in, out;
+   bool bCloned = false;
+
+   in = open(src.string().c_str(), O_RDONLY);
+   if(in >= 0)
+   {
+      out = open(dst.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if(out >= 0)
+      {
+         if(ioctl(out, FICLONE, in) == 0) bCloned = true;
+         close(out);
+      }
+      close(in);
+   }
+   if(bCloned == true) return;
+#endif
+   fs::copy_file(src, dst, fs::copy_options::overwrite_existing);
+} /* end ArchiveClone() */
+
+/******************************************************************************
+ArchiveRotl()
+******************************************************************************/
+static inline ArchiveWord ArchiveRotl(ArchiveWord x, int r)
+{
+   return (x << r) | (x >> (64 - r));
+} /* end ArchiveRotl() */
+
+/******************************************************************************
+ArchiveMix()
+
+Final avalanche of a hash lane.
+******************************************************************************/
+static inline ArchiveWord ArchiveMix(ArchiveWord h)
+{
+   h ^= h >> 33;
+   h *= 0xFF51AFD7ED558CCDULL;
+   h ^= h >> 33;
+   h *= 0xC4CEB9FE1A85EC53ULL;
+   h ^= h >> 33;
+   return h;
+} /* end ArchiveMix() */
+
+/******************************************************************************
+ArchiveHash()
+
+128-bit (two 64-bit lanes) non-cryptographic hash of the contents of a file,
+processed 8 bytes at a time.
+******************************************************************************/
+static bool ArchiveHash(const std::string & path, ArchiveWord * pH1, ArchiveWord * pH2)
+{
+   std::vector<unsigned char> buf(ARCHIVE_BUF_SZ);
+   ArchiveWord h1, h2, w, total;
+   FILE * pFile;
+   size_t n, i;
+
+   pFile = fopen(path.c_str(), "rb");
+   if(pFile == NULL) return false;
+
+   h1 = 0x9E3779B97F4A7C15ULL;
+   h2 = 0xC2B2AE3D27D4EB4FULL;
+   total = 0;
+   while((n = fread(buf.data(), 1, ARCHIVE_BUF_SZ, pFile)) > 0)
+   {
+      for(i = 0; i < n; i += 8)
+      {
+         w = 0;
+         memcpy(&w, &buf[i], ((n - i) < 8) ? (n - i) : 8);
+         h1 = ArchiveRotl(h1 ^ (w*0x87C37B91114253D5ULL), 31)*0x4CF5AD432745937FULL;
+         h2 = ArchiveRotl(h2 + ArchiveRotl(w*0x4CF5AD432745937FULL, 33), 27)*5 + 0x52DCE729ULL;
+      }
+      total += n;
+   }/* end while() */
+   fclose(pFile);
+
+   h1 ^= total;
+   h2 ^= total;
+   *pH1 = ArchiveMix(h1 + h2);
+   *pH2 = ArchiveMix(h2 + *pH1);
+   return true;
+} /* end ArchiveHash() */
+
+/******************************************************************************
+ArchiveSame()
+
+Returns true if two files have the same contents.
+******************************************************************************/
+static bool ArchiveSame(const std::string & path1, const std::string & path2)
+{
+   std::vector<unsigned char> buf1(ARCHIVE_BUF_SZ);
+   std::vector<unsigned char> buf2(ARCHIVE_BUF_SZ);
+   FILE * pFile1;
+   FILE * pFile2;
+   size_t n1, n2;
+   bool bSame = true;
+
+   pFile1 = fopen(path1.c_str(), "rb");
+   pFile2 = fopen(path2.c_str(), "rb");
+   if((pFile1 == NULL) || (pFile2 == NULL)) bSame = false;
+   while(bSame == true)
+   {
+      n1 = fread(buf1.data(), 1, ARCHIVE_BUF_SZ, pFile1);
+      n2 = fread(buf2.data(), 1, ARCHIVE_BUF_SZ, pFile2);
+      if((n1 != n2) || (memcmp(buf1.data(), buf2.data(), n1) != 0)) bSame = false;
+      if(n1 == 0) break;
+   }
+   if(pFile1 != NULL) fclose(pFile1);
+   if(pFile2 != NULL) fclose(pFile2);
+   return bSame;
+} /* end ArchiveSame() */
+
+/******************************************************************************
+CTOR
+
+Read the archiving options from the main section of the input file. Files of
+the exclusion list are never archived.
+******************************************************************************/
+ModelArchiver::ModelArchiver(IroncladString pFileName, FileList * pExclude)
+{
+   FILE * pFile;
+   FileList * pCur;
+   char * line;
+   char tmp[DEF_STR_SZ];
+   char val[DEF_STR_SZ];
+   char msg[2*DEF_STR_SZ];
+   std::string name;
+   size_t i;
+
+   m_Codec = ARCHIVE_CODEC_NONE;
+   m_Ext = "";
+   m_QueueSize = ARCHIVE_DEF_QUEUE_SIZE;
+   m_bKeepAll = true;
+   m_bStarted = false;
+   m_bDone = false;
+   m_NumBusy = 0;
+   m_NumStaged = 0;
+
+   for(pCur = pExclude; pCur != NULL; pCur = pCur->GetNext())
+   {
+      //names with whitespace are wrapped in quotes
+      name = pCur->GetName();
+      for(i = name.find('"'); i != std::string::npos; i = name.find('"')) name.erase(i, 1);
+      m_Exclude.insert(fs::path(name).lexically_normal().generic_string());
+   }
+
+   pFile = fopen(pFileName, "r");
+   if(pFile != NULL)
+   {
+      if(CheckToken(pFile, "ArchiveQueueSize", pFileName) == true)
+      {
+         line = GetCurDataLine();
+         sscanf(line, "%s %d", tmp, &m_QueueSize);
+         if(m_QueueSize < 1) m_QueueSize = 1;
+      }
+      rewind(pFile);
+      if(CheckToken(pFile, "ArchiveCompression", pFileName) == true)
+      {
+         line = GetCurDataLine();
+         sscanf(line, "%s %s", tmp, val);
+         MyStrLwr(val);
+         if(strcmp(val, "gzip") == 0){ m_Codec = ARCHIVE_CODEC_GZIP; m_Ext = ".gz";}
+         else if(strcmp(val, "zstd") == 0){ m_Codec = ARCHIVE_CODEC_ZSTD; m_Ext = ".zst";}
+         else if(strcmp(val, "lz4") == 0){ m_Codec = ARCHIVE_CODEC_LZ4; m_Ext = ".lz4";}
+         else if(strcmp(val, "none") != 0)
+         {
+            snprintf(msg, 2*DEF_STR_SZ, "Unknown ArchiveCompression (%s), archive is not compressed", val);
+            LogError(ERR_FILE_IO, msg);
+         }
+      }
+      rewind(pFile);
+      if(CheckToken(pFile, "ArchiveKeep", pFileName) == true)
+      {
+         line = GetCurDataLine();
+         sscanf(line, "%s %s", tmp, val);
+         MyStrLwr(val);
+         if(strcmp(val, "best") == 0) m_bKeepAll = false;
+      }
+      fclose(pFile);
+   }/* end if() */
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Wait until all runs have been archived and stop the archiving thread.
+******************************************************************************/
+void ModelArchiver::Destroy(void)
+{
+   if(m_bStarted == true)
+   {
+      Flush();
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         m_bDone = true;
+      }
+      m_NotEmpty.notify_all();
+      m_Thread.join();
+      m_bStarted = false;
+
+      try
+      {
+         fs::remove_all(m_Staging);
+         if(fs::is_empty(m_Staging.parent_path()) == true) fs::remove(m_Staging.parent_path());
+      }
+      catch(const std::exception & e){ SetError(e.what());}
+      ReportError();
+   }
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+Archive()
+
+Archive the current (worker) directory as run number (counter - 1) of the
+given worker. Must be called from the worker directory. Changed files are
+snapshotted before returning, so the next model run may overwrite them, the
+rest of the work is done by the archiving thread. Blocks while the queue of
+runs waiting to be archived is full.
+******************************************************************************/
+void ModelArchiver::Archive(IroncladString pWorker, int counter, IroncladString ofcat)
+{
+   std::map<std::string, ArchiveFile>::iterator known;
+   ArchiveJob * pJob;
+   ArchiveFile file;
+   fs::path cwd;
+   char msg[DEF_STR_SZ];
+   long long now;
+
+   try
+   {
+      cwd = fs::current_path();
+      if(m_bStarted == false)
+      {
+         m_Root = cwd.parent_path() / "archive";
+         m_Blobs = m_Root / "blobs";
+         m_Staging = m_Root / "staging" / pWorker;
+         fs::create_directories(m_Blobs);
+         fs::create_directories(m_Staging);
+         m_Thread = std::thread(&ModelArchiver::Worker, this);
+         m_bStarted = true;
+      }
+   }
+   catch(const std::exception & e)
+   {
+      snprintf(msg, DEF_STR_SZ, "Couldn't create model archive : %s", e.what());
+      LogError(ERR_FILE_IO, msg);
+      return;
+   }
+   ReportError();
+
+   NEW_PRINT("ArchiveJob", 1);
+   pJob = new ArchiveJob;
+   MEM_CHECK(pJob);
+
+   pJob->runDir = m_Root / pWorker / ("run_" + std::to_string(counter - 1));
+   pJob->category = ofcat;
+   pJob->bFull = (m_bKeepAll == true) ||
+                 (strcmp(ofcat, ObjFuncBest) == 0) ||
+                 (strcmp(ofcat, ObjFuncBehavioral) == 0) ||
+                 (strcmp(ofcat, ObjFuncNonDominated) == 0);
+
+   now = (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+   try
+   {
+      for(fs::recursive_directory_iterator it(cwd), end; it != end; ++it)
+      {
+         if(fs::is_regular_file(it->path()) == false) continue;
+
+         file.rel = it->path().lexically_relative(cwd).generic_string();
+         if(m_Exclude.count(file.rel) > 0) continue;
+         if(ArchiveStat(it->path(), &file) == false) continue;
+         file.taken = now;
+         file.staged.clear();
+         file.blob.clear();
+
+         //other runs only get a manifest
+         if(pJob->bFull == true)
+         {
+            {
+               std::lock_guard<std::mutex> lock(m_Mutex);
+               known = m_Known.find(file.rel);
+               if((known != m_Known.end()) && (ArchiveUnchanged(known->second, file) == true))
+               {
+                  file.blob = known->second.blob;
+               }
+            }
+            if(file.blob.empty() == true)
+            {
+               file.staged = (m_Staging / std::to_string(m_NumStaged++)).string();
+               ArchiveClone(it->path(), file.staged);
+            }
+         }/* end if() */
+         pJob->files.push_back(file);
+      }/* end for() */
+   }
+   catch(const std::exception & e)
+   {
+      snprintf(msg, DEF_STR_SZ, "Couldn't snapshot model output : %s", e.what());
+      LogError(ERR_FILE_IO, msg);
+   }
+
+   {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_NotFull.wait(lock, [this]{ return ((int)m_Queue.size() < m_QueueSize);});
+      m_Queue.push_back(pJob);
+   }
+   m_NotEmpty.notify_one();
+} /* end Archive() */
+
+/******************************************************************************
+Flush()
+
+Wait until all queued runs have been archived.
+******************************************************************************/
+void ModelArchiver::Flush(void)
+{
+   if(m_bStarted == false) return;
+   {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_NotFull.wait(lock, [this]{ return (m_Queue.empty() && (m_NumBusy == 0));});
+   }
+   ReportError();
+} /* end Flush() */
+
+/******************************************************************************
+Worker()
+
+Body of the archiving thread.
+******************************************************************************/
+void ModelArchiver::Worker(void)
+{
+   ArchiveJob * pJob;
+
+   for(;;)
+   {
+      {
+         std::unique_lock<std::mutex> lock(m_Mutex);
+         m_NotEmpty.wait(lock, [this]{ return (m_bDone || !m_Queue.empty());});
+         if(m_Queue.empty() == true) return;
+         pJob = m_Queue.front();
+         m_Queue.pop_front();
+         m_NumBusy++;
+      }
+      m_NotFull.notify_all();
+
+      try{ Store(pJob);}
+      catch(const std::exception & e){ SetError(e.what());}
+      delete pJob;
+
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         m_NumBusy--;
+      }
+      m_NotFull.notify_all();
+   }/* end for() */
+} /* end Worker() */
+
+/******************************************************************************
+Store()
+
+Store the snapshots of a run as blobs and link all of the files of the run
+into its archive directory.
+******************************************************************************/
+void ModelArchiver::Store(ArchiveJob * pJob)
+{
+   fs::path link;
+   size_t i;
+
+   fs::create_directories(pJob->runDir);
+   for(i = 0; (pJob->bFull == true) && (i < pJob->files.size()); i++)
+   {
+      ArchiveFile & file = pJob->files[i];
+      if(file.blob.empty() == true) StoreBlob(&file);
+      if(file.blob.empty() == true) continue;
+
+      //compressed blobs keep the extension of the codec
+      link = pJob->runDir / file.rel;
+      link += fs::path(file.blob).extension();
+      fs::create_directories(link.parent_path());
+      if(fs::exists(link) == true) fs::remove(link);
+      try{ fs::create_hard_link(file.blob, link);}
+      catch(const std::exception &){ fs::copy_file(file.blob, link);}
+
+      file.staged.clear();
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Known[file.rel] = file;
+   }/* end for() */
+
+   WriteManifest(pJob);
+} /* end Store() */
+
+/******************************************************************************
+StoreBlob()
+
+Move a snapshot into the blob store, unless the blob store already holds the
+same contents. Blobs are named after the content hash and size of the file
+and placed in subdirectories named after the first two hex digits.
+******************************************************************************/
+void ModelArchiver::StoreBlob(ArchiveFile * pFile)
+{
+   ArchiveWord h1, h2;
+   char name[DEF_STR_SZ];
+   std::string path;
+   fs::path blob;
+
+   if(ArchiveHash(pFile->staged, &h1, &h2) == false)
+   {
+      SetError("Couldn't read snapshot of " + pFile->rel);
+      return;
+   }
+   sprintf(name, "%016llx%016llx-%lld", h1, h2, pFile->size);
+   blob = m_Blobs / std::string(name, 2);
+   fs::create_directories(blob);
+   blob /= name;
+
+   if(fs::exists(blob) == true)
+   {
+      if(ArchiveSame(pFile->staged, blob.string()) == true)
+      {
+         fs::remove(pFile->staged);
+         pFile->blob = blob.string();
+         return;
+      }
+      //hash collision, keep both
+      blob += "-" + m_Staging.filename().string() + "-" + fs::path(pFile->staged).filename().string();
+   }
+   else if((m_Codec != ARCHIVE_CODEC_NONE) && (fs::exists(blob.string() + m_Ext) == true))
+   {
+      fs::remove(pFile->staged);
+      pFile->blob = blob.string() + m_Ext;
+      return;
+   }
+
+   path = pFile->staged;
+   if(Compress(path) == true) blob += m_Ext;
+
+   //the blob store and the staging area are on the same filesystem
+   fs::rename(path, blob);
+   pFile->blob = blob.string();
+} /* end StoreBlob() */
+
+/******************************************************************************
+Compress()
+
+Compress a snapshot in place with the selected codec. On success, the codec's
+extension is appended to the path. If the codec is not available, compression
+is turned off.
+******************************************************************************/
+bool ModelArchiver::Compress(std::string & path)
+{
+   std::string out = path + m_Ext;
+   bool bOk;
+
+   if(m_Codec == ARCHIVE_CODEC_NONE) return false;
+
+#ifdef _WIN32
+   std::string cmd;
+   if(m_Codec == ARCHIVE_CODEC_GZIP) cmd = "gzip -1 -f -q \"" + path + "\"";
+   else if(m_Codec == ARCHIVE_CODEC_ZSTD) cmd = "zstd -1 -f -q --rm \"" + path + "\"";
+   else cmd = "lz4 -1 -f -q --rm \"" + path + "\" \"" + out + "\"";
+   cmd += " > NUL 2>&1";
+   bOk = (system(cmd.c_str()) == 0);
+#else
+   //spawned directly, since system() changes the signal dispositions of the
+   //whole process while the codec runs
+   const char * argv[8];
+   posix_spawn_file_actions_t actions;
+   extern char ** environ;
+   pid_t pid;
+   int status = -1;
+
+   if(m_Codec == ARCHIVE_CODEC_GZIP)
+   {
+      argv[0] = "gzip"; argv[1] = "-1"; argv[2] = "-f"; argv[3] = "-q";
+      argv[4] = path.c_str(); argv[5] = NULL;
+   }
+   else if(m_Codec == ARCHIVE_CODEC_ZSTD)
+   {
+      argv[0] = "zstd"; argv[1] = "-1"; argv[2] = "-f"; argv[3] = "-q";
+      argv[4] = "--rm"; argv[5] = path.c_str(); argv[6] = NULL;
+   }
+   else
+   {
+      argv[0] = "lz4"; argv[1] = "-1"; argv[2] = "-f"; argv[3] = "-q";
+      argv[4] = "--rm"; argv[5] = path.c_str(); argv[6] = out.c_str(); argv[7] = NULL;
+   }
+
+   posix_spawn_file_actions_init(&actions);
+   posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+   posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+   bOk = false;
+   if(posix_spawnp(&pid, argv[0], &actions, NULL, (char * const *)argv, environ) == 0)
+   {
+      while((waitpid(pid, &status, 0) < 0) && (errno == EINTR));
+      bOk = (WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+   }
+   posix_spawn_file_actions_destroy(&actions);
+#endif
+
+   if((bOk == false) || (fs::exists(out) == false))
+   {
+      SetError("Couldn't compress model archive, storing remaining files uncompressed");
+      m_Codec = ARCHIVE_CODEC_NONE;
+      if(fs::exists(out) == true) fs::remove(out);
+      return false;
+   }
+   if(fs::exists(path) == true) fs::remove(path);
+   path = out;
+   return true;
+} /* end Compress() */
+
+/******************************************************************************
+WriteManifest()
+
+List the files of a run, with their sizes and blobs (relative to the archive).
+******************************************************************************/
+void ModelArchiver::WriteManifest(ArchiveJob * pJob)
+{
+   std::string blob;
+   FILE * pFile;
+   size_t i;
+
+   pFile = fopen((pJob->runDir / ARCHIVE_MANIFEST).string().c_str(), "w");
+   if(pFile == NULL)
+   {
+      SetError("Couldn't write manifest of " + pJob->runDir.string());
+      return;
+   }
+   fprintf(pFile, "Category  %s\n", pJob->category.c_str());
+   fprintf(pFile, "Contents  %s\n", (pJob->bFull == true) ? "full" : "manifest only");
+   fprintf(pFile, "Size  Blob  File\n");
+   for(i = 0; i < pJob->files.size(); i++)
+   {
+      ArchiveFile & file = pJob->files[i];
+      blob = "-";
+      if(file.blob.empty() == false)
+      {
+         blob = fs::path(file.blob).lexically_relative(m_Root).generic_string();
+      }
+      fprintf(pFile, "%lld  %s  %s\n", file.size, blob.c_str(), file.rel.c_str());
+   }
+   fclose(pFile);
+} /* end WriteManifest() */
+
+/******************************************************************************
+SetError()
+
+Record an error of the archiving thread, it is reported by the main thread.
+******************************************************************************/
+void ModelArchiver::SetError(std::string msg)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   if(m_Error.empty() == true) m_Error = msg;
+} /* end SetError() */
+
+/******************************************************************************
+ReportError()
+
+Log the first error of the archiving thread, if any.
+******************************************************************************/
+void ModelArchiver::ReportError(void)
+{
+   char msg[DEF_STR_SZ];
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if(m_Error.empty() == true) return;
+      snprintf(msg, DEF_STR_SZ, "Model archiver : %s", m_Error.c_str());
+      m_Error.clear();
+   }
+   LogError(ERR_FILE_IO, msg);
+} /* end ReportError() */
@@ -15,6 +15,7 @@ Version History
 08-20-03    lsm   created version history field and updated comments.
 08-13-04    lsm   distinguished between semi and full restore functionality.
 01-01-07    lsm   ModelBackup now uses an abstract model base class (ModelABC).
+10-19-26    lsm   snapshots are stored in one contiguous buffer, added GetBuffer().
 ******************************************************************************/
 #include "ModelBackup.h"
 #include "ModelABC.h"
@@ -25,143 +26,90 @@ Version History
 #include "ParameterGroup.h"
 #include "ObjectiveFunction.h"
 
+#include <string.h>
+
 #include "Exception.h"
 
 /******************************************************************************
 CTOR
 
-Size the parameter and observation storage arrays using the Observation and 
-Parameter Groups of the Model and the response variable group pRV.
+Size the snapshot buffer using the Observation and Parameter Groups of the 
+Model.
 ******************************************************************************/
 ModelBackup::ModelBackup(ModelABC * pModel)
 {
-   ParameterGroup * pParamGroup;
    ObservationGroup * pObsGroup;
 
    m_pModel = pModel;
    
    pObsGroup = m_pModel->GetObsGroupPtr();     
-   m_pObs = NULL;
+   m_NumObs = 0;
    if(pObsGroup != NULL)
    { 
       m_NumObs = pObsGroup->GetNumObs();
-
-      NEW_PRINT("double", m_NumObs);
-      m_pObs  = new double[m_NumObs];
-      MEM_CHECK(m_pObs);
    }/* end if() */
 
-   pParamGroup = m_pModel->GetParamGroupPtr();
-   m_NumParams = pParamGroup->GetNumParams();
-
-   NEW_PRINT("double", m_NumParams);
-   m_pParams = new double[m_NumParams];
-   MEM_CHECK(m_pParams);
+   m_NumParams = m_pModel->GetParamGroupPtr()->GetNumParams();
 
    m_NumPred = 0;
    m_pRV = NULL;
-   m_pPred = NULL;
+   m_pVals = NULL;
+   m_Size = 0;
+   Allocate();
  
    IncCtorCount();
 } /* end CTOR */
 
+/******************************************************************************
+Allocate()
+
+(Re)allocate the snapshot buffer and set up the parameter, observation and 
+prediction views. The contents of the buffer are not preserved.
+******************************************************************************/
+void ModelBackup::Allocate(void)
+{
+   delete [] m_pVals;
+
+   m_Size = 1 + m_NumParams + m_NumObs + m_NumPred;
+   NEW_PRINT("double", m_Size);
+   m_pVals = new double[m_Size];
+   MEM_CHECK(m_pVals);
+   memset(m_pVals, 0, m_Size*sizeof(double));
+
+   m_pParams = &(m_pVals[1]);
+   m_pObs = &(m_pParams[m_NumParams]);
+   m_pPred = &(m_pObs[m_NumObs]);
+}/* end Allocate() */
+
 /******************************************************************************
 SetResponseVarGroup()
 
-Size the predictions storage arrays using the response variable group pRV. Also
+Size the predictions storage using the response variable group pRV. Also
 save the pointer to the response variable group for future reference.
 ******************************************************************************/
 void ModelBackup::SetResponseVarGroup(ResponseVarGroup * pRV)
 {
-   delete [] m_pPred;
-
    m_pRV = pRV;
+   m_NumPred = 0;
    if(m_pRV != NULL)
    {
       m_NumPred = m_pRV->GetNumRespVars();
-      NEW_PRINT("double", m_NumPred);
-      m_pPred  = new double[m_NumPred];
-      MEM_CHECK(m_pPred);
    }
+   Allocate();
 }/* SetResponseVarGroup() */
 
 /******************************************************************************
 Destroy()
 
-Free up the observation and parameter storage arrays.
+Free up the snapshot buffer.
 ******************************************************************************/
 void ModelBackup::Destroy(void)
 {  
-   delete [] m_pParams;
-   delete [] m_pObs;
-   delete [] m_pPred;
+   delete [] m_pVals;
 
    IncDtorCount();
 } /* end Destroy() */
 
-/******************************************************************************
-StoreParamVals()
-
-Copy parameter group values into the storage array.
-******************************************************************************/
-void ModelBackup::StoreParamVals(void)
-{  
-   ParameterGroup * pGroup;
-
-   pGroup = m_pModel->GetParamGroupPtr();
-   pGroup->ReadParams(m_pParams);
-} /* end StoreParamVals() */
-
-/******************************************************************************
-RestoreParamVals()
-
-Copy stored parameters into the model parameter group.
-******************************************************************************/
-void ModelBackup::RestoreParamVals(void)
-{
-   ParameterGroup * pGroup;
-
-   pGroup = m_pModel->GetParamGroupPtr();
-   pGroup->WriteParams(m_pParams);
-}/* end RestoreParamVals() */
-
-/******************************************************************************
-StoreObsVals()
-
-Copy model computed observation group values into the storage array.
-******************************************************************************/
-void ModelBackup::StoreObsVals(void)
-{ 
-   int i;
- 
-   for(i = 0; i < m_NumObs; i++)
-   {
-      m_pObs[i] = m_pModel->GetObsGroupPtr()->GetObsPtr(i)->GetComputedVal(false, false);
-   }
-}/* end StoreObsVals() */
-
-/******************************************************************************
-RestoreObsVals()
-
-Copy stored model computed observations into the model observation group.
-******************************************************************************/
-void ModelBackup::RestoreObsVals(void)
-{
-   ObservationGroup * pGroup;
-   Observation * pObs;
-   int i;
-   double val;
-
-   pGroup = m_pModel->GetObsGroupPtr();
-
-   for(i = 0; i < m_NumObs; i++)
-   {
-      pObs = pGroup->GetObsPtr(i);
-      val = m_pObs[i];
-      pObs->SetComputedVal(val);
-   }/* end for() */
-}/* end RestoreObsVals() */
-
 /******************************************************************************
 StorePredictedVals()
 
@@ -179,7 +127,7 @@ void ModelBackup::StorePredictedVals(void)
    {
       m_pPred[i] = m_pRV->GetRespVarPtr(i)->GetCurrentVal();
    }
-}/* end StoreObsVals() */
+}/* end StorePredictedVals() */
 
 /******************************************************************************
 RestorePredictedVals()
@@ -201,15 +149,15 @@ void ModelBackup::RestorePredictedVals(void)
 /******************************************************************************
 Store()
 
-Copy model parameter group and computed observation group values into the 
-storage arrays.
+Copy the objective function value, model parameter group and computed 
+observation group values into the snapshot buffer.
 ******************************************************************************/
 void ModelBackup::Store(void)
 { 
-   StoreParamVals();
-   if(m_pObs != NULL){ StoreObsVals();}
+   m_pVals[0] = m_pModel->GetObjFuncVal();
+   m_pModel->GetParamGroupPtr()->ReadParams(m_pParams);
+   if(m_NumObs > 0){ m_pModel->GetObsGroupPtr()->ReadObservations(m_pObs);}
    StorePredictedVals();
-   m_ObjFuncVal = m_pModel->GetObjFuncVal();
 }/* end Store() */
 
 /******************************************************************************
@@ -225,10 +173,10 @@ will not be properly restored).
 ******************************************************************************/
 void ModelBackup::SemiRestore(void)
 { 
-   RestoreParamVals();
-   if(m_pObs != NULL){ RestoreObsVals();}
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pParams);
+   if(m_NumObs > 0){ m_pModel->GetObsGroupPtr()->WriteObservations(m_pObs);}
    RestorePredictedVals();
-   m_pModel->SetObjFuncVal(m_ObjFuncVal);
+   m_pModel->SetObjFuncVal(m_pVals[0]);
 }/* end SemiRestore() */
 
 /******************************************************************************
@@ -240,17 +188,16 @@ parameters.
 ******************************************************************************/
 void ModelBackup::FullRestore(void)
 { 
-   RestoreParamVals();
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pParams);
    m_pModel->Execute();
    if(m_pRV != NULL){ m_pRV->ExtractVals();}
 }/* end FullRestore() */
 
 /******************************************************************************
-FullRestore()
+GetObs()
 
-Copy stored paramters into the parameter group and rerun the model. This will
-enusure that all parts of the model are consistent with the restored set of 
-parameters.
+Returns the stored value of the ith observation, weighted and/or transformed
+as requested.
 ******************************************************************************/
 double ModelBackup::GetObs(int i, bool bTransformed, bool bWeighted)
 { 
@@ -269,5 +216,3 @@ double ModelBackup::GetObs(int i, bool bTransformed, bool bWeighted)
 
    return (y);
 } /* end GetObs() */
-
-
@@ -7,22 +7,22 @@ Macros to aid in debugging.
 
 Version History
 10-16-2014 lsm   created from MyDebug.h
+10-19-2026 lsm   only compiled in if enabled by DBG_LEVEL (see MyDebug.h)
 ******************************************************************************/
 #include <stdio.h>
 
 #include "MyDebug.h"
 
+#if DBG_LEVEL >= 1
 void DBG_PRINT(const char *a)
 {
-#if DBG_LEVEL >= 1
    printf("%s\n", (char *)a);
-#endif
 }
+#endif
 
+#if DBG_LEVEL >= 2
 void NEW_PRINT(const char *a, int b)
 {
-#if DBG_LEVEL >= 2
    printf("new %s[%d]\n", (char *)a, b);
-#endif
 }
-
+#endif
@@ -17,6 +17,9 @@ Version History
 03-21-05    lsm   Added support for parameter-specific relative increments
 01-01-07    lsm   Added support for additional FD increment types. OptMathClass
                   now uses abstract model base class (ModelABC).
+10-19-26    lsm   In parallel, CalcGradient() shares the gradient and the best
+                  point found with all processors, so that they can perform
+                  line searches together.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -716,11 +719,13 @@ completion of the gradient calculation, the model is rerun at the initial
 location to ensure that the system remains in a consistent state.
 
 If a better minimum than fmin is found, fmin and pmin are replaced with the
-new minimum value and corresponding parameter values.
+new minimum value and corresponding parameter values. In parallel, every 
+processor receives the gradient along with the best minimum found by any of
+the processors.
 ******************************************************************************/
 Unchangeable1DArray OptMathClass::CalcGradient(double * fmin, double * pmin)
 {
-   int i, id, np;
+   int i, id, np, best;
    ParameterGroup * pParamGroup;
    double Finit, Fcur;
  
@@ -739,11 +744,27 @@ Unchangeable1DArray OptMathClass::CalcGradient(double * fmin, double * pmin)
    {
       double * pTmp = new double[m_NumParams];
       for(i = 0; i < m_NumParams; i++){ pTmp[i] = 0.00;}
-      MPI_Reduce(m_pGrad, pTmp, m_NumParams,MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+      MPI_Allreduce(m_pGrad, pTmp, m_NumParams,MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
       for(i = 0; i < m_NumParams; i++){ m_pGrad[i] = pTmp[i];}
       delete [] pTmp;
    }/* end if() */
 
+   //share the best minimum (lowest processor id wins ties)
+   if((np > 1) && (fmin != NULL))
+   {
+      double * pMine = new double[np];
+      double * pAll = new double[np];
+      for(i = 0; i < np; i++){ pMine[i] = 0.00;}
+      pMine[id] = *fmin;
+      MPI_Allreduce(pMine, pAll, np, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      best = 0;
+      for(i = 1; i < np; i++){ if(pAll[i] < pAll[best]){ best = i;}}
+      *fmin = pAll[best];
+      MPI_Bcast(pmin, m_NumParams, MPI_DOUBLE, best, MPI_COMM_WORLD);
+      delete [] pMine;
+      delete [] pAll;
+   }/* end if() */
+
    //restore model consistency, unless program type is Gradient_Program
    if(GetProgramType() != GRADIENT_PROGRAM)
    {
@@ -11,11 +11,15 @@ Version History
 08-18-04    lsm   Added metrics collection and reporting, memory fragmentation
                   fixes, Golden Section search modifications
 01-01-07    lsm   OptSearchClass now uses abstract model base class (ModelABC).
+10-19-26    lsm   added minimization of a function of a single variable.
+10-19-26    lsm   added parallel search.
 ******************************************************************************/
+#include <mpi.h>
 #include <math.h>
 #include <string.h>
 
 #include "ModelABC.h"
+#include "AlgorithmABC.h"
 #include "OptSearchClass.h"
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
@@ -35,10 +39,49 @@ Initializes everything using m_pModel input.
 ******************************************************************************/
 OptSearchClass::OptSearchClass(ModelABC * pModel)
 {
-   int i;
-
    m_pModel = pModel;
    m_NumParams = pModel->GetParamGroupPtr()->GetNumParams();
+   m_pFunc = NULL;
+   m_pFuncData = NULL;
+
+   Allocate();
+   InitFromFile(GetInFileName());
+
+   IncCtorCount();
+}/* end CTOR */
+
+/******************************************************************************
+CTOR
+
+Initializes everything for the minimization of the function pFunc of a single
+variable, bounded by lwr and upr. The settings of the search are given, rather
+than read from the input file.
+******************************************************************************/
+OptSearchClass::OptSearchClass(OptSearchFunc pFunc, void * pData, double lwr, 
+                               double upr, int searchType, double convVal)
+{
+   m_pModel = NULL;
+   m_NumParams = 1;
+   m_pFunc = pFunc;
+   m_pFuncData = pData;
+   m_Lwr = lwr;
+   m_Upr = upr;
+
+   Allocate();
+   m_SearchType = searchType;
+   m_SearchConvVal = convVal;
+
+   IncCtorCount();
+}/* end CTOR */
+
+/******************************************************************************
+Allocate()
+
+Allocates the data structures and sets default values.
+******************************************************************************/
+void OptSearchClass::Allocate(void)
+{
+   int i;
 
    NEW_PRINT("double", m_NumParams);
    m_pDir = new double[m_NumParams];
@@ -71,16 +114,39 @@ OptSearchClass::OptSearchClass(ModelABC * pModel)
    m_BrentCount    = 0;
    m_SearchType    = GSECT_SEARCH;
    
+   m_X = 0.00;
+   m_Fx = 0.00;
+
+   m_NumPts = 0;
+   m_MaxRounds = 2;
+   m_pBatchX = NULL;
+   m_pBatchF = NULL;
+   m_pBatchBuf = NULL;
+   m_pPtsX = NULL;
+   m_pPtsF = NULL;
+   m_MaxPts = 0;
+   m_NumEvalPts = 0;
+   m_bLocal = false;
+   m_ParaCount = 0;
+   m_ParaRounds = 0;
+   
    //init. direction
    for(i = 0; i < m_NumParams; i++)
    {
       m_pDir[i] = 0.00;
    }/* end for() */
+}/* end Allocate() */
 
-   InitFromFile(GetInFileName());
+/******************************************************************************
+WriteProgress()
 
-   IncCtorCount();
-}/* end CTOR */
+Reports on the progress of the search, unless a function of a single variable
+is being minimized.
+******************************************************************************/
+void OptSearchClass::WriteProgress(int count, int max)
+{
+   if(m_pModel != NULL){ Write1dSearch(count, max);}
+}/* end WriteProgress() */
 
 /******************************************************************************
 Destroy()
@@ -95,6 +161,11 @@ void OptSearchClass::Destroy(void)
    delete [] m_pStartPoint;
    delete m_pMinBrack;
    delete m_pMinPt;
+   delete [] m_pBatchX;
+   delete [] m_pBatchF;
+   delete [] m_pBatchBuf;
+   delete [] m_pPtsX;
+   delete [] m_pPtsF;
 
    IncDtorCount();
 }/* end Destroy() */
@@ -109,11 +180,19 @@ void OptSearchClass::WriteMetrics(FILE * pFile)
    fprintf(pFile, "\nOne Dimensional Search Metrics\n");
    fprintf(pFile, "Search Type          : ");
    if(m_SearchType == GSECT_SEARCH){ fprintf(pFile, "Golden Section\n");}   
+   else if(m_SearchType == PARA_SEARCH){ fprintf(pFile, "Parallel\n");}   
    else{ fprintf(pFile, "Brent\n");}
    fprintf(pFile, "Convergence Val      : %E\n", m_SearchConvVal);
    fprintf(pFile, "Bound Min Evals      : %d\n", m_BoundMinCount);
    fprintf(pFile, "Golden Section Evals : %d\n", m_GoldSectCount);
    fprintf(pFile, "Brent Evals          : %d\n", m_BrentCount);
+   if(m_SearchType == PARA_SEARCH)
+   {
+      fprintf(pFile, "Evals per Round      : %d\n", m_NumPts);
+      fprintf(pFile, "Max. Refine Rounds   : %d\n", m_MaxRounds);
+      fprintf(pFile, "Parallel Evals       : %d\n", m_ParaCount);
+      fprintf(pFile, "Parallel Rounds      : %d\n", m_ParaRounds);
+   }
 }/* end WriteMetrics() */
 
 /******************************************************************************
@@ -161,12 +240,25 @@ void OptSearchClass::InitFromFile(IroncladString pFileName)
             {
                m_SearchType = GSECT_SEARCH;
             }
+            else if(strstr(line, "parallel") != NULL)
+            {
+               m_SearchType = PARA_SEARCH;
+            }
             else
             {
                strcpy(tmp, "Unknown Search Method");
                LogError(ERR_FILE_IO, tmp);
             }
          }
+         else if(strstr(line, "1dSearchPoints") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumPts);
+         }/*end else if() */         
+         else if(strstr(line, "1dSearchMaxRounds") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_MaxRounds);
+            if(m_MaxRounds < 0){ m_MaxRounds = 0;}
+         }/*end else if() */         
          else
          {
             sprintf(tmp, "Unknown token: %s", line);
@@ -195,14 +287,67 @@ new minimum value and corresponding parameter values.
 double OptSearchClass::CalcF(double alpha, double * fmin, double * xmin)
 {
    ParameterGroup * pGroup;
-   double upr, lwr, Finit;
-   int i;
-   double F, old_pi;
+   double Finit;
+   double F;
+
+   //function of a single variable, nothing to back up or restore
+   if(m_pModel == NULL)
+   {
+      AlphaPoint(alpha);
+      F = m_pFunc(m_pAlphaPoint[0], m_pFuncData);
+      if(F < *fmin)
+      {
+         *fmin = F;
+         xmin[0] = m_pAlphaPoint[0];
+      }
+      return F;
+   }/* end if() */
 
    //backup initial location of design point
    pGroup = m_pModel->GetParamGroupPtr();
    pGroup->ReadParams(m_pStartPoint);
    Finit = m_pModel->GetObjFuncVal();
+   AlphaPoint(alpha);
+
+   //run model at new location
+   pGroup->WriteParams(m_pAlphaPoint);
+   F = m_pModel->Execute();
+   /* update optimal, if appropriate */
+   if(F < *fmin)
+   {
+	   *fmin = F;
+	   pGroup->ReadParams(xmin);
+   }
+
+   //semi-restore model (for next time around)
+   pGroup->WriteParams(m_pStartPoint);
+   m_pModel->SetObjFuncVal(Finit);
+
+   return F;
+}/* end CalcF() */
+
+/******************************************************************************
+AlphaPoint()
+
+Compute the design point that corresponds to a step size of <alpha> from the
+current point, and store it in m_pAlphaPoint.
+******************************************************************************/
+void OptSearchClass::AlphaPoint(double alpha)
+{
+   ParameterGroup * pGroup;
+   double upr, lwr, old_pi;
+   int i;
+
+   //function of a single variable
+   if(m_pModel == NULL)
+   {
+      m_pAlphaPoint[0] = m_X + alpha * m_pDir[0];
+      if(m_pAlphaPoint[0] > m_Upr){ m_pAlphaPoint[0] = (m_Upr+m_X)/2.00;}
+      if(m_pAlphaPoint[0] < m_Lwr){ m_pAlphaPoint[0] = (m_X+m_Lwr)/2.00;}
+      return;
+   }/* end if() */
+
+   pGroup = m_pModel->GetParamGroupPtr();
    pGroup->ReadParams(m_pAlphaPoint);
    
    /*---------------------------------------------------------
@@ -228,22 +373,7 @@ double OptSearchClass::CalcF(double alpha, double * fmin, double * xmin)
 		  m_pAlphaPoint[i] = (old_pi+lwr)/2.00;
 	  }
    }
-   //run model at new location
-   pGroup->WriteParams(m_pAlphaPoint);
-   F = m_pModel->Execute();
-   /* update optimal, if appropriate */
-   if(F < *fmin)
-   {
-	   *fmin = F;
-	   pGroup->ReadParams(xmin);
-   }
-
-   //semi-restore model (for next time around)
-   pGroup->WriteParams(m_pStartPoint);
-   m_pModel->SetObjFuncVal(Finit);
-
-   return F;
-}/* end CalcF() */
+}/* end AlphaPoint() */
 
 /******************************************************************************
 CalcStepSize()
@@ -261,8 +391,12 @@ double OptSearchClass::CalcStepSize(Unchangeable1DArray pDir, double * fmin, dou
    double Finit, Fcur;
 
    //store current setting
-   m_pModel->GetParamGroupPtr()->ReadParams(m_pStepPoint);
-   Finit = m_pModel->GetObjFuncVal();
+   Finit = 0.00;
+   if(m_pModel != NULL)
+   {
+      m_pModel->GetParamGroupPtr()->ReadParams(m_pStepPoint);
+      Finit = m_pModel->GetObjFuncVal();
+   }
 
    //store direction
    for(i = 0; i < m_NumParams; i++)
@@ -270,16 +404,24 @@ double OptSearchClass::CalcStepSize(Unchangeable1DArray pDir, double * fmin, dou
       m_pDir[i] = pDir[i];
    }/* end for() */
    
-   //bound minimum
-   pMbrak = BracketMinimum(-1.00, 1.00, fmin, xmin);
+   /* Parallel search, which brackets the minimum on its own */
+   if(m_SearchType == PARA_SEARCH){ pMin = ParaSearch(fmin, xmin);}
+   else
+   {
+      //bound minimum
+      pMbrak = BracketMinimum(-1.00, 1.00, fmin, xmin);
 
-   /* Golden Section Method */
-   if(m_SearchType == GSECT_SEARCH){ pMin = GoldSect(pMbrak, fmin, xmin);}
-   /* Brents method */
-   else{ pMin = Brent(pMbrak, fmin, xmin);}
+      /* Golden Section Method */
+      if(m_SearchType == GSECT_SEARCH){ pMin = GoldSect(pMbrak, fmin, xmin);}
+      /* Brents method */
+      else{ pMin = Brent(pMbrak, fmin, xmin);}
+   }
 
    m_Step = pMin->x;   
 
+   //function of a single variable, no model to restore
+   if(m_pModel == NULL){ return (m_Step);}
+
    //restore initial setting, ensuring that model is consistent
    m_pModel->GetParamGroupPtr()->WriteParams(m_pStepPoint);
    Fcur = m_pModel->Execute();
@@ -293,6 +435,68 @@ double OptSearchClass::CalcStepSize(Unchangeable1DArray pDir, double * fmin, dou
    return (m_Step);
 }/* CalcStepSize() */
 
+/******************************************************************************
+Minimize()
+
+Minimize the function of a single variable, starting from x0. This is the one
+dimensional equivalent of Powell's method: line minimizations are repeated from
+the best point found so far until the function value changes by no more than
+convVal for MAX_COUNT iterations in a row, or maxIter iterations are performed.
+
+Returns: the location of the minimum, with the function value stored in fx.
+******************************************************************************/
+double OptSearchClass::Minimize(double x0, double * fx, double convVal, int maxIter)
+{
+   int iter, count;
+   double dir, step, x, F, Fold, fmin, xmin;
+
+   m_X = x0;
+   m_Fx = Fold = m_pFunc(m_X, m_pFuncData);
+   dir = 1.00;
+   count = 0;
+
+   for(iter = 0; iter < maxIter; iter++)
+   {
+      //line minimization
+      fmin = m_Fx;
+      xmin = m_X;
+      step = CalcStepSize(&dir, &fmin, &xmin);
+      if(fmin < m_Fx) //found new minimum when computing step size
+      {
+         m_X = xmin;
+         m_Fx = fmin;
+      }
+
+      //if it's out of bounds, move half the distance to upr/lwr
+      x = m_X + dir*step;
+      if(x > m_Upr){ x = (m_Upr+m_X)/2.00;}
+      if(x < m_Lwr){ x = (m_X+m_Lwr)/2.00;}
+      F = m_pFunc(x, m_pFuncData);
+      if(F <= m_Fx) //keep the move and its direction
+      {
+         if(x < m_X){ dir = -1.00;}
+         else if(x > m_X){ dir = 1.00;}
+         m_X = x;
+         m_Fx = F;
+      }
+
+      //convergence termination criteria
+      if(fabs(Fold - m_Fx) <= convVal)
+      {
+         count++;
+         if(count >= MAX_COUNT){ break;}
+      }
+      else
+      {
+         count = 0;
+      }
+      Fold = m_Fx;
+   }/* end for() */
+
+   *fx = m_Fx;
+   return m_X;
+}/* end Minimize() */
+
 /******************************************************************************
 BracketMinimum()
 
@@ -310,7 +514,8 @@ MinBracketStruct * OptSearchClass::BracketMinimum(double a, double b, double * f
    double fa, fb, c, fc;
 
    //initial values
-   Fcur = m_pModel->GetObjFuncVal();
+   if(m_pModel != NULL){ Fcur = m_pModel->GetObjFuncVal();}
+   else { Fcur = m_Fx;}
 
    a = LimitStepSize(a, m_pDir);
    fa = CalcF(a, fmin, xmin);
@@ -464,25 +669,25 @@ MinPtStruct * OptSearchClass::GoldSect(MinBracketStruct * pBrack, double * minf,
    ---------------------------------------------------------------------*/
    its = (int)((log10(m_SearchConvVal/fabs(xL-xU))/log10(1.00-gCGOLD)) + 1.00);
 
-   Write1dSearch(WRITE_GSECT, its+2);
+   WriteProgress(WRITE_GSECT, its+2);
    x1 = ((1.00 - gCGOLD) * xL) + (gCGOLD * xU);
    x1 = LimitStepSize(x1, m_pDir);
    F1 = CalcF(x1, minf, minp);
    if(Fmin > F1){ Fmin = F1; xmin = x1;}
    m_GoldSectCount++;
-   Write1dSearch(1, 0);
+   WriteProgress(1, 0);
 
    x2 = ((1.00 - gCGOLD) * xU) + (gCGOLD * xL);
    x2 = LimitStepSize(x2, m_pDir);
    F2 = CalcF(x2, minf, minp);
    if(Fmin > F2){ Fmin = F2; xmin = x2;}
    m_GoldSectCount++;
-   Write1dSearch(2, 0);
+   WriteProgress(2, 0);
       
    //Golden Section iteration   
    for(i = 0; i < its; i++)
    {
-      Write1dSearch(i+3, 0);
+      WriteProgress(i+3, 0);
       if(F1 > F2)
       {
          xL = x1;
@@ -510,7 +715,7 @@ MinPtStruct * OptSearchClass::GoldSect(MinBracketStruct * pBrack, double * minf,
    m_pMinPt->x  = xmin; 
    m_pMinPt->fx = Fmin;
 
-   Write1dSearch(WRITE_ENDED, 0);   
+   WriteProgress(WRITE_ENDED, 0);   
    return m_pMinPt;
 }/* end GoldSect() */
 
@@ -543,10 +748,10 @@ MinPtStruct * OptSearchClass::Brent(MinBracketStruct * pBrack, double * minf, do
    x=w=v=bx;
    fw=fv=fx=pBrack->fb;   
 
-   Write1dSearch(WRITE_BRENT, MaxBrentIters);
+   WriteProgress(WRITE_BRENT, MaxBrentIters);
    for(iter = 1; iter <= MaxBrentIters; iter++)
    {
-      Write1dSearch(iter, 0);
+      WriteProgress(iter, 0);
       xmin = x;
       fmin = fx;
 
@@ -642,12 +847,12 @@ MinPtStruct * OptSearchClass::Brent(MinBracketStruct * pBrack, double * minf, do
    //if we exceed the max. iterations or stalled at first iteration, revert to trusty Golden Section method
    if((iter > MaxBrentIters) || (iter == 1))
    { 
-      Write1dSearch(WRITE_SWTCH, 0);
+      WriteProgress(WRITE_SWTCH, 0);
       m_pMinPt = GoldSect(pBrack, minf, minp);
    }
    else
    {
-      Write1dSearch(WRITE_ENDED, 0);
+      WriteProgress(WRITE_ENDED, 0);
       m_pMinPt->x  = xmin;
       m_pMinPt->fx = fmin;
    }
@@ -655,6 +860,244 @@ MinPtStruct * OptSearchClass::Brent(MinBracketStruct * pBrack, double * minf, do
    return m_pMinPt;
 } /* end Brent() */
 
+/******************************************************************************
+ParaSearch()
+
+Finds the minimum by evaluating batches of step sizes, which are spread over 
+the processors (see EvalBatch()). The first batch spans [-1, +1]. Until the 
+best point has evaluated points on both sides, batches are placed beyond the 
+best end point, at increasing (golden ratio) spacing. The bracket around the 
+best point is then refined by evaluating a grid of the bracket along with the
+vertex of the parabola through the best point and its neighbours, until the 
+bracket is narrower than the convergence value or m_MaxRounds rounds are done.
+If the current point (zero step size) is still the best point, the batch is 
+placed on both sides of it at geometrically decreasing distances instead, and
+up to PARA_MAX_BRACKET extra rounds are allowed to find a better point.
+
+Returns: a MinPtStruct containing the mininum point and the value of the 
+objective function at that point.
+
+If a better minimum than minf is found, minf and minp are replaced with the
+new minimum value and corresponding parameter values.
+******************************************************************************/
+MinPtStruct * OptSearchClass::ParaSearch(double * minf, double * minp)
+{
+   int i, k, ib, num, grid, round, nprocs;
+   double u, d, lo, hi, xb, fb, flo, fhi, r, q, tol1;
+
+   //size the batches to the number of processors and allocate on first use
+   if(m_pBatchX == NULL)
+   {
+      nprocs = 1;
+      if(m_pModel != NULL){ MPI_Comm_size(MPI_COMM_WORLD, &nprocs);}
+      if(m_NumPts <= 0){ m_NumPts = nprocs;}
+      if(m_NumPts < PARA_MIN_POINTS){ m_NumPts = PARA_MIN_POINTS;}
+      m_MaxPts = (2*PARA_MAX_BRACKET + 1 + m_MaxRounds)*m_NumPts + 1;
+
+      NEW_PRINT("double", m_NumPts);
+      m_pBatchX = new double[m_NumPts];
+      NEW_PRINT("double", m_NumPts);
+      m_pBatchF = new double[m_NumPts];
+      NEW_PRINT("double", m_NumPts);
+      m_pBatchBuf = new double[m_NumPts];
+      NEW_PRINT("double", m_MaxPts);
+      m_pPtsX = new double[m_MaxPts];
+      NEW_PRINT("double", m_MaxPts);
+      m_pPtsF = new double[m_MaxPts];
+      MEM_CHECK(m_pPtsF);
+   }/* end if() */
+
+   WriteProgress(WRITE_PARA, m_NumPts);
+
+   //the current point
+   m_NumEvalPts = 1;
+   m_pPtsX[0] = 0.00;
+   if(m_pModel != NULL){ m_pPtsF[0] = m_pModel->GetObjFuncVal();}
+   else { m_pPtsF[0] = m_Fx;}
+
+   //first batch spans [-1, +1]
+   num = 0;
+   for(k = 0; k < m_NumPts; k++)
+   {
+      u = LimitStepSize(-1.00 + (2.00*k)/(double)(m_NumPts - 1), m_pDir);
+      if((u != 0.00) && ((num == 0) || (u != m_pBatchX[num-1]))){ m_pBatchX[num++] = u;}
+   }
+   round = 1;
+   WriteProgress(round, 0);
+   EvalBatch(num, minf, minp);
+
+   //bracket the minimum
+   for(i = 0; i < PARA_MAX_BRACKET; i++)
+   {
+      ib = 0;
+      for(k = 1; k < m_NumEvalPts; k++){ if(m_pPtsF[k] < m_pPtsF[ib]){ ib = k;}}
+      if((ib > 0) && (ib < (m_NumEvalPts - 1))){ break;}
+      if(m_NumEvalPts < 2){ break;}
+
+      //expand beyond the best end point
+      if(ib == 0){ d = m_pPtsX[0] - m_pPtsX[1];}
+      else { d = m_pPtsX[ib] - m_pPtsX[ib-1];}
+      u = m_pPtsX[ib];
+      num = 0;
+      for(k = 0; k < m_NumPts; k++)
+      {
+         d *= gGOLD;
+         u = LimitStepSize(u + d, m_pDir);
+         if(u == m_pPtsX[ib]){ break;} //at a parameter bound
+         if((num > 0) && (u == m_pBatchX[num-1])){ break;}
+         m_pBatchX[num++] = u;
+      }/* end for() */
+      if(num == 0){ break;}
+
+      round++;
+      WriteProgress(round, 0);
+      EvalBatch(num, minf, minp);
+   }/* end for() */
+
+   //refine the bracket
+   for(i = 0; i < (m_MaxRounds + PARA_MAX_BRACKET); i++)
+   {
+      ib = 0;
+      for(k = 1; k < m_NumEvalPts; k++){ if(m_pPtsF[k] < m_pPtsF[ib]){ ib = k;}}
+      if((ib == 0) || (ib == (m_NumEvalPts - 1))){ break;} //minimum at a bound
+
+      xb = m_pPtsX[ib]; fb = m_pPtsF[ib];
+      lo = m_pPtsX[ib-1]; flo = m_pPtsF[ib-1];
+      hi = m_pPtsX[ib+1]; fhi = m_pPtsF[ib+1];
+      tol1 = m_SearchConvVal*fabs(xb) + NEARLY_ZERO;
+      if((hi - lo) <= 2.00*tol1){ break;} //converged
+      if((i >= m_MaxRounds) && (xb != 0.00)){ break;} //improved, and out of rounds
+
+      num = 0;
+      if(xb == 0.00)
+      {
+         //close in on the current point from both sides
+         for(k = 0; k < m_NumPts; k++)
+         {
+            if((k % 2) == 0){ hi *= PARA_SHRINK; u = hi;}
+            else { lo *= PARA_SHRINK; u = lo;}
+            if(fabs(u) > tol1){ m_pBatchX[num++] = u;}
+         }
+         if(num == 0){ break;}
+
+         round++;
+         WriteProgress(round, 0);
+         EvalBatch(num, minf, minp);
+         continue;
+      }/* end if() */
+
+      //vertex of the parabola through the best point and its neighbours
+      r = (xb - lo)*(fb - fhi);
+      q = (xb - hi)*(fb - flo);
+      if(fabs(q - r) > NEARLY_ZERO)
+      {
+         u = xb - ((xb - hi)*q - (xb - lo)*r)/(2.00*(q - r));
+         if((u > lo) && (u < hi) && (fabs(u - xb) > tol1)){ m_pBatchX[num++] = u;}
+      }
+
+      //grid of the bracket
+      grid = m_NumPts - num;
+      for(k = 1; k <= grid; k++)
+      {
+         u = lo + ((hi - lo)*k)/(double)(grid + 1);
+         if(fabs(u - xb) > tol1){ m_pBatchX[num++] = u;}
+      }
+
+      round++;
+      WriteProgress(round, 0);
+      EvalBatch(num, minf, minp);
+   }/* end for() */
+
+   ib = 0;
+   for(k = 1; k < m_NumEvalPts; k++){ if(m_pPtsF[k] < m_pPtsF[ib]){ ib = k;}}
+   m_pMinPt->x  = m_pPtsX[ib];
+   m_pMinPt->fx = m_pPtsF[ib];
+   m_ParaRounds += round;
+
+   WriteProgress(WRITE_ENDED, 0);
+   return m_pMinPt;
+}/* end ParaSearch() */
+
+/******************************************************************************
+EvalBatch()
+
+Evaluate the first <num> step sizes of m_pBatchX, spreading them over the 
+processors, and merge the results into the (sorted) list of evaluated points.
+A single processor, or a local search (see SetLocal()), evaluates all of the
+step sizes in turn. Since every processor receives all of the results, they all
+agree on the outcome of the search.
+
+If a better minimum than minf is found, minf and minp are replaced with the
+new minimum value and corresponding parameter values.
+******************************************************************************/
+void OptSearchClass::EvalBatch(int num, double * minf, double * minp)
+{
+   int i, k, id, nprocs, best;
+   double ftmp;
+   ParameterGroup * pGroup;
+
+   id = 0;
+   nprocs = 1;
+   if((m_pModel != NULL) && (m_bLocal == false))
+   {
+      MPI_Comm_rank(MPI_COMM_WORLD, &id);
+      MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   }
+
+   for(k = 0; k < num; k++){ m_pBatchBuf[k] = 0.00;}
+   for(k = id; k < num; k += nprocs)
+   {
+      //minimum is updated below, once all processors have the results
+      ftmp = -NEARLY_HUGE;
+      m_pBatchBuf[k] = CalcF(m_pBatchX[k], &ftmp, minp);
+   }
+   if(nprocs > 1)
+   {
+      MPI_Allreduce(m_pBatchBuf, m_pBatchF, num, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   }
+   else
+   {
+      for(k = 0; k < num; k++){ m_pBatchF[k] = m_pBatchBuf[k];}
+   }
+   m_ParaCount += num;
+
+   best = -1;
+   for(k = 0; k < num; k++)
+   {
+      //insert into list of evaluated points, which is sorted by step size
+      i = m_NumEvalPts;
+      while((i > 0) && (m_pPtsX[i-1] > m_pBatchX[k]))
+      {
+         m_pPtsX[i] = m_pPtsX[i-1];
+         m_pPtsF[i] = m_pPtsF[i-1];
+         i--;
+      }
+      m_pPtsX[i] = m_pBatchX[k];
+      m_pPtsF[i] = m_pBatchF[k];
+      m_NumEvalPts++;
+
+      if((m_pBatchF[k] < *minf) && ((best < 0) || (m_pBatchF[k] < m_pBatchF[best]))){ best = k;}
+   }/* end for() */
+
+   if(best < 0){ return;}
+
+   *minf = m_pBatchF[best];
+   if(m_pModel == NULL)
+   {
+      AlphaPoint(m_pBatchX[best]);
+      minp[0] = m_pAlphaPoint[0];
+   }
+   else
+   {
+      pGroup = m_pModel->GetParamGroupPtr();
+      pGroup->ReadParams(m_pStartPoint);
+      AlphaPoint(m_pBatchX[best]);
+      pGroup->WriteParams(m_pAlphaPoint);
+      pGroup->ReadParams(minp);
+      pGroup->WriteParams(m_pStartPoint);
+   }
+}/* end EvalBatch() */
+
 /******************************************************************************
 LimitStepSize()
 
@@ -668,6 +1111,15 @@ double OptSearchClass::LimitStepSize(double alpha, double * pDir)
    int i;
    double upr, lwr, pi, opi;
 
+   //function of a single variable
+   if(m_pModel == NULL)
+   {
+      pi = m_X + alpha * pDir[0];
+      if(pi > m_Upr){ alpha = (m_Upr - m_X)/pDir[0];}
+      if(pi < m_Lwr){ alpha = (m_Lwr - m_X)/pDir[0];}
+      return alpha;
+   }/* end if() */
+
    /*---------------------------------------------------------
    Check each design parameter to see if it can accommodate
    the given step size.
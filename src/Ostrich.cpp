@@ -13,6 +13,8 @@ Version History
 03-24-04    lsm   added PSO-LevMar hybrid, added ISOFIT_BUILD option
 11-07-05    lsm   added support for BGA, GRID, VSA and CSA programs
 03-03-07    jrc   added DDS program
+10-19-26    lsm   added benchmark report (OSTRICH_BENCH builds only)
+10-19-26    lsm   checkpoint settings are checked against the program type
 ******************************************************************************/
 #include <mpi.h>
 #include <stdio.h>
@@ -52,10 +54,12 @@ Version History
 #include "BEERS.h"
 #include "DDSAU.h"
 #include "VARS_Algorithm.h"
+#include "Checkpoint.h"
 
 #include "Exception.h"
 #include "Utility.h"
 #include "IsoParse.h"
+#include "BenchModels.h"
 
 #ifdef ISOFIT_BUILD
 int Ostrich(int argc, StringType argv[])
@@ -74,6 +78,9 @@ int main(int argc, StringType argv[])
    GetElapsedTime();
 
    double tStart = GetElapsedTics();
+#ifdef OSTRICH_BENCH
+   double tBenchMain = tStart;
+#endif
    MPI_Init(&argc,&argv);
    double tEnd = GetElapsedTics();
    int id;
@@ -92,6 +99,11 @@ int main(int argc, StringType argv[])
    
    program = ReadProgramType();
    SetProgramType(program);
+   Checkpoint::CheckSettings(program);
+
+#ifdef OSTRICH_BENCH
+   double tBenchRun = GetElapsedTics();
+#endif
 
    //execute desired operation
    switch(program)
@@ -296,6 +308,10 @@ int main(int argc, StringType argv[])
       }/* end case(QUIT_PROGRAM) */      
    }/* end switch() */   
 
+#ifdef OSTRICH_BENCH
+   BenchWriteReport(tBenchRun - tBenchMain, GetElapsedTics() - tBenchRun);
+#endif
+
    tStart = GetElapsedTics();
    MPI_Finalize();
    tEnd = GetElapsedTics();
@@ -8,6 +8,7 @@ PAES - Pareto archived evolution strategy
 
 Version History
 12-29-17    lsm   created file
+10-19-26    lsm   archive is a PAES_Archive (indexed, with a hashed adaptive grid)
 ******************************************************************************/
 #include <mpi.h>
 #include <string.h>
@@ -81,7 +82,6 @@ void PAES::Destroy(void)
 
    delete m_problem;
    delete m_archiveOfSolutions;
-   delete m_adaptiveGrid;
    delete [] m_precision;
 
    delete [] m_pbuf;
@@ -129,16 +129,7 @@ void PAES::initialize(PAES_MultiobjectiveProblem * problemToSolve, PAES_Mutation
    m_random.m_Rseed = (float)(m_random.randreal2());
    m_random.randomize();
 
-   m_archiveOfSolutions = new PAES_Population(0, m_maximumArchiveLength, &m_random, m_problem, m_cout);
-                                        
-   m_adaptiveGrid = new PAES_AdaptiveGrid(m_depth, m_problem->m_numberOfFunctions);
-
-   if (!m_adaptiveGrid)
-   {
-      fprintf(m_cout, "Paes::Paes-> Not enough memory for the adaptiveGrid object\n");
-      fclose(m_cout);
-      exit(-1);
-   } /* end if() */
+   m_archiveOfSolutions = new PAES_Archive(m_maximumArchiveLength, m_depth, &m_random, m_problem, m_cout);
 
    //allocate space for parallel communication buffers, if necessary
    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
@@ -585,7 +576,6 @@ void PAES::testAndUpdate(void)
    if (result == -1)
    {
       *m_currentSolution = *m_mutantSolution;
-      m_adaptiveGrid->updateGridLocations(m_archiveOfSolutions, m_mutantSolution);
       archiveSolution(m_mutantSolution);
    } /* end if () */
    else if (result == 0) 
@@ -594,13 +584,11 @@ void PAES::testAndUpdate(void)
       // Mutant is not dominated by the archive
       if (result != -1) 
       { 
-         m_adaptiveGrid->updateGridLocations(m_archiveOfSolutions, m_mutantSolution);
          mutantArchived = archiveSolution(m_mutantSolution);
          if (mutantArchived && (result == 0)) 
          {
-            int location1 = m_adaptiveGrid->findLocation(m_currentSolution);
-            int location2 = m_adaptiveGrid->findLocation(m_mutantSolution);
-            if (m_adaptiveGrid->m_hypercube[location2] <= m_adaptiveGrid->m_hypercube[location1])
+            if (m_archiveOfSolutions->getCrowding(m_mutantSolution) <= 
+                m_archiveOfSolutions->getCrowding(m_currentSolution))
             {
                *m_currentSolution = *m_mutantSolution;
             }
@@ -620,10 +608,15 @@ void PAES::testAndUpdate(void)
 
 /******************************************************************************
 PAES::addToArchive()
+
+The solution goes through PAES_Archive::archiveSolution(), so that it is not 
+archived (and is deleted) if it is dominated by or has the same fitness as a 
+member, or is in the most crowded hypercube of a full archive. Previously it 
+was appended to the archive unconditionally.
 ******************************************************************************/
 void PAES::addToArchive(PAES_Individual *solution)
 {
-   m_archiveOfSolutions->addIndividual(solution);
+   m_archiveOfSolutions->archiveSolution(solution);
 } /* end PAES::addToArchive() */
 
 /******************************************************************************
@@ -632,127 +625,26 @@ PAES::compareToArchive()
 Checks if the solution is dominated by any member of the archive.
 
 Returns 0 if the solution is non-dominated, -1 if it is dominated, +1 if it
-dominates all the members of the archive.
+dominates all the members of the archive. Previously +1 was returned when the
+solution dominated the last member tested. A mutant that dominates only some 
+of the members now gets 0, so testAndUpdate() compares its crowding to that 
+of the current solution (and may move to it) where it used to keep the 
+current solution.
  ******************************************************************************/
 int PAES::compareToArchive(PAES_Individual *solution) 
 {
-   int counter;
-   int result;
-  
-   counter = 0;
-   result  = 0;
-  
-   while ((counter < m_archiveOfSolutions->getPopulationSize()) && (result != -1)) 
-   {
-      result = solution->dominanceTest(m_archiveOfSolutions->getIth(counter));
-    
-      counter ++;
-   } /* end while() */
-  
-   return result;
+   return m_archiveOfSolutions->compareToArchive(solution);
 } /* end PAES::compareToArchive() */
 
 /******************************************************************************
 PAES::archiveSolution()
+
+Returns true if the solution was archived, otherwise it is deleted. See
+PAES_Archive::archiveSolution().
 ******************************************************************************/
 bool PAES::archiveSolution(PAES_Individual *solution) 
 {
-  int result;
-  bool finish;
-  int  counter;
-  bool storeNewSolution;
-  
-  finish = false;
-  storeNewSolution = true;
-  counter = 0;
-
-   /* -------------------------------------------------------------
-   CASE 1. The archive is empty
-   Action: add solution to the archive
-   ------------------------------------------------------------- */
-   if (m_archiveOfSolutions->getPopulationSize() == 0)
-   {
-      addToArchive(solution);
-      finish = true;
-   } /* end if() */
-  
-   while ((counter < m_archiveOfSolutions->getPopulationSize()) && !finish) 
-   {
-      if (solution->identicalFitness(m_archiveOfSolutions->getIth(counter))) 
-      {
-         // There is a solution with the same fitness vector
-         finish = true;
-         storeNewSolution = false;
-      } // if
-      else 
-      {
-         result = solution->dominanceTest(m_archiveOfSolutions->getIth(counter));
-         if (result == -1) 
-         {
-            finish = true; 
-            storeNewSolution = false; // The solution is not added to the archive            
-         } /* end if() */
-         else if (result == 1) 
-         {
-            m_archiveOfSolutions->deleteIth(counter);
-         } /* end else if() */
-         else  
-         {
-            /* no-op */;
-         } /* end else() */
-      } /* end else() */
-      counter ++;
-   } /* end while() */
-
-   if(storeNewSolution) 
-   {
-      // If the archive is not full, add the solution
-      if (m_archiveOfSolutions->getPopulationSize() < m_maximumArchiveLength)
-      {
-         m_archiveOfSolutions->addIndividual(solution);
-      }
-      else 
-      {
-         // The archive is full
-         int i;
-         int location;
-         // If the solution is not in the most crowded region, add it
-         location = solution->m_gridLocation;
-         if (location == m_adaptiveGrid->m_mostCrowdedHypercube) 
-         {
-            // archiveOfSolutions_->addIndividual(solution);
-            delete solution;
-            storeNewSolution = false;
-         } // if
-         else 
-         { // Find and replace an individual of the most crowded region 
-            bool finish;
-            finish = false;
-            i = 0;
-            while (!finish) 
-            {
-               location = (m_archiveOfSolutions->getIth(i))->m_gridLocation;
-               if (location == m_adaptiveGrid->m_mostCrowdedHypercube) 
-               {
-                  m_archiveOfSolutions->deleteIth(i);
-                  m_archiveOfSolutions->addIndividual(solution);
-                  finish = true;
-               } /* end if() */
-               i++;
-               if (i == m_archiveOfSolutions->getPopulationSize())
-               {
-                  finish = true;
-               }
-            } /* end while() */
-         } /* end else() */
-      } /* end else() */
-   } /* end if() */
-   else 
-   {
-      delete solution;
-   } /* end else() */
-  
-   return storeNewSolution;
+   return m_archiveOfSolutions->archiveSolution(solution);
 } /* end PAES::archiveSolution() */
 
 /******************************************************************************
@@ -1010,6 +902,8 @@ void PAES::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Algorithm               : Pareto Archived Evolution Strategy\n");
    fprintf(pFile, "Depth                   : %d\n", m_depth);
    fprintf(pFile, "Max Archive Length      : %d\n", m_maximumArchiveLength);
+   fprintf(pFile, "Archive Size            : %d\n", m_archiveOfSolutions->getPopulationSize());
+   fprintf(pFile, "Grid Rebounds           : %d\n", m_archiveOfSolutions->getNumberOfRebounds());
    fprintf(pFile, "Number of Iterations    : %d\n", m_numberOfIterations);
    fprintf(pFile, "Mutation Probability    : %f\n", m_mutationProbability);
    fprintf(pFile, "Print Frequency         : %d\n", m_printFrequency);
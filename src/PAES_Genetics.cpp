@@ -8,6 +8,7 @@ PAES - Pareto archived evolution strategy
 
 Version History
 12-29-17    lsm   created file
+10-19-26    lsm   hashed adaptive grid and indexed archive (PAES_Archive)
 ******************************************************************************/
 #include "PAES_Genetics.h"
  
@@ -1058,6 +1059,10 @@ PAES_Individual::PAES_Individual(PAES_MultiobjectiveProblem * problem, PAES_Rand
    {
       m_fitness[i] = 0.0;
    }
+
+   m_gridLocation = 0;
+   m_gridSlot     = -1;
+   m_archiveSlot  = -1;
 } /* end PAES_Individual::PAES_Individual() */
 
 /******************************************************************************
@@ -1084,6 +1089,10 @@ PAES_Individual::PAES_Individual(double * X, double * F, PAES_MultiobjectiveProb
    {
       m_fitness[i] = F[i];
    }
+
+   m_gridLocation = 0;
+   m_gridSlot     = -1;
+   m_archiveSlot  = -1;
 } /* end PAES_Individual::PAES_Individual() */
 
 /******************************************************************************
@@ -1108,6 +1117,10 @@ PAES_Individual::PAES_Individual(PAES_Individual & individual)
    {
       m_fitness[i] = individual.m_fitness[i];
    }
+
+   m_gridLocation = 0;
+   m_gridSlot     = -1;
+   m_archiveSlot  = -1;
 } /* end PAES_Individual::PAES_Individual() */
 
 /******************************************************************************
@@ -1132,6 +1145,10 @@ PAES_Individual::PAES_Individual(PAES_Individual * individual)
    {
       m_fitness[i] = individual->m_fitness[i];
    }
+
+   m_gridLocation = 0;
+   m_gridSlot     = -1;
+   m_archiveSlot  = -1;
 } /* end PAES_Individual::PAES_Individual() */
 
 /******************************************************************************
@@ -1453,7 +1470,7 @@ PAES_Population::DTOR
 ******************************************************************************/
 PAES_Population::~PAES_Population(void) 
 {
-   return;
+   delete [] m_population;
 } /* end PAES_Population::~Population() */
 
 /******************************************************************************
@@ -1627,164 +1644,644 @@ void PAES_Population::printGenotype(char *fileName)
 /******************************************************************************
 PAES_AdaptiveGrid::CTOR
 ******************************************************************************/
-PAES_AdaptiveGrid::PAES_AdaptiveGrid(void) 
-{
-   m_numberOfFunctions = 0;
-   m_depth = 0;
-   m_currentGridSize = 0;
-   m_hypercube = NULL;
-   m_divisionSize = NULL;
-   m_gridLimits = NULL;
-   m_upperBestFitness = NULL;
-   m_lowerBestFitness = NULL;
-   m_tmpDivisionSize = NULL;
-   m_increment = NULL;
-} /* end PAES_AdaptiveGrid::AdaptiveGrid() */
-
-/******************************************************************************
-PAES_AdaptiveGrid::CTOR
-******************************************************************************/
-PAES_AdaptiveGrid::PAES_AdaptiveGrid(int depth, int numberOfFunctions) 
-{                   
+PAES_AdaptiveGrid::PAES_AdaptiveGrid(int depth, int numberOfFunctions)
+{
    m_numberOfFunctions  = numberOfFunctions;
    m_depth              = depth;
-  
-   m_currentGridSize = (long) floor(pow(2.0, (double)m_depth * (double)m_numberOfFunctions));
-   m_hypercube    = new int[m_currentGridSize];
+   if (m_depth < 0)
+   {
+      m_depth = 0;
+   }
+   if (m_depth > 30)
+   {
+      m_depth = 30;
+   }
+   m_numberOfDivisions = (1 << m_depth);
+
+   /* ---------------------------------------------------------------
+   The location packs the division of every objective, if it fits.
+   Otherwise the divisions are hashed together, and the rare
+   collisions merge hypercubes.
+   --------------------------------------------------------------- */
+   m_exactLocation = ((m_depth * m_numberOfFunctions) <= 64);
+
    m_divisionSize = new double[m_numberOfFunctions];
-   m_gridLimits   = new double[m_numberOfFunctions];
-  
    m_upperBestFitness = new double[m_numberOfFunctions];
-   m_lowerBestFitness = new double[m_numberOfFunctions];  
-  
-   m_tmpDivisionSize = new double[m_numberOfFunctions];
-   m_increment       = new int[m_numberOfFunctions];
-  
-   if (!m_currentGridSize  || !m_hypercube        || !m_divisionSize    || !m_gridLimits  || 
-       !m_upperBestFitness || !m_lowerBestFitness || !m_tmpDivisionSize || !m_increment) 
+   m_lowerBestFitness = new double[m_numberOfFunctions];
+   m_division = new int[m_numberOfFunctions];
+
+   if (!m_divisionSize || !m_upperBestFitness || !m_lowerBestFitness || !m_division)
    {
       printf("AdaptiveGrid::AdaptiveGrid-> Error when asking for memory\n");
       exit(-1);
    } /* end if() */
+
+   m_bounded = false;
+   m_mostCrowdedCount = 0;
+   m_numberOfRebounds = 0;
+   m_crowding.resize(2);
 } /* end PAES_AdaptiveGrid::AdaptiveGrid() */
 
 /******************************************************************************
 PAES_AdaptiveGrid::DTOR
 ******************************************************************************/
-PAES_AdaptiveGrid::~PAES_AdaptiveGrid(void) 
+PAES_AdaptiveGrid::~PAES_AdaptiveGrid(void)
 {
-   delete [] m_hypercube;
+   clear();
    delete [] m_divisionSize;
-   delete [] m_gridLimits;
    delete [] m_upperBestFitness;
    delete [] m_lowerBestFitness;
-   delete [] m_tmpDivisionSize;
-   delete [] m_increment;
+   delete [] m_division;
 } /* end PAES_AdaptiveGrid::~AdaptiveGrid() */
 
 /******************************************************************************
-PAES_AdaptiveGrid::updateGridLocations()
+PAES_AdaptiveGrid::clear()
+
+Remove all of the hypercubes.
 ******************************************************************************/
-void PAES_AdaptiveGrid::updateGridLocations(PAES_Population * population, PAES_Individual * individual) 
+void PAES_AdaptiveGrid::clear(void)
+{
+   std::unordered_map<PAES_GridKey, PAES_GridCell *>::iterator it;
+
+   for (it = m_hypercube.begin(); it != m_hypercube.end(); it++)
+   {
+      delete it->second;
+   }
+   m_hypercube.clear();
+   m_crowding.clear();
+   m_crowding.resize(2);
+   m_mostCrowdedCount = 0;
+} /* end PAES_AdaptiveGrid::clear() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::contains()
+
+Checks if the individual is within the limits of the grid.
+******************************************************************************/
+bool PAES_AdaptiveGrid::contains(PAES_Individual * individual) const
 {
    int i;
-   int j;
-  
-   for (i = 0; i < m_numberOfFunctions; ++i) 
+
+   if (!m_bounded)
    {
-      m_upperBestFitness[i] = PAES_MIN_INT;
-      m_lowerBestFitness[i] = PAES_MAX_INT;
-   } /* end for() */
-  
-   for (i = 0; i < m_numberOfFunctions; i++) 
+      return false;
+   }
+   for (i = 0; i < m_numberOfFunctions; i++)
    {
-      if (individual->getFitness()[i] < m_lowerBestFitness[i])
+      if ((individual->m_fitness[i] < m_lowerBestFitness[i]) ||
+          (individual->m_fitness[i] > m_upperBestFitness[i]))
       {
-         m_lowerBestFitness[i] = individual->getFitness()[i];
-      }
-      if (individual->getFitness()[i] > m_upperBestFitness[i])
-      {
-         m_upperBestFitness[i] = individual->getFitness()[i];
+         return false;
       }
+   } /* end for() */
+
+   return true;
+} /* end PAES_AdaptiveGrid::contains() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::rebound()
 
-      for (j = 0; j < population->getPopulationSize(); j ++) 
+Set the limits of the grid to the range of the population and the individual,
+and relocate every member of the population. The individual itself is not
+added to the grid.
+******************************************************************************/
+void PAES_AdaptiveGrid::rebound(PAES_Population * population, PAES_Individual * individual)
+{
+   int i;
+   int j;
+   double f;
+
+   for (i = 0; i < m_numberOfFunctions; i++)
+   {
+      m_lowerBestFitness[i] = individual->m_fitness[i];
+      m_upperBestFitness[i] = individual->m_fitness[i];
+      for (j = 0; j < population->getPopulationSize(); j++)
       {
-         if (population->getIth(j)->getFitness()[i] < m_lowerBestFitness[i]) 
+         f = population->getIth(j)->m_fitness[i];
+         if (f < m_lowerBestFitness[i])
          {
-            m_lowerBestFitness[i] = population->getIth(j)->getFitness()[i];
+            m_lowerBestFitness[i] = f;
          }
-         if (population->getIth(j)->getFitness()[i] > m_upperBestFitness[i]) 
+         if (f > m_upperBestFitness[i])
          {
-            m_upperBestFitness[i] = population->getIth(j)->getFitness()[i];      
+            m_upperBestFitness[i] = f;
          }
       }/* end for() */
-    
-      m_divisionSize[i] = (m_upperBestFitness[i] - m_lowerBestFitness[i]);
+      m_divisionSize[i] = (m_upperBestFitness[i] - m_lowerBestFitness[i]) / (double)m_numberOfDivisions;
    } /* end for() */
-  
-   for (i = 0; i < (int)pow(2.0, m_numberOfFunctions * m_depth); i++)
+   m_bounded = true;
+   m_numberOfRebounds++;
+
+   clear();
+   for (j = 0; j < population->getPopulationSize(); j++)
    {
-      m_hypercube[i] = 0;
-   }
-    
-   int location;  
-   m_mostCrowdedHypercube = 0;
-   location = findLocation(individual);
-   individual->m_gridLocation = location;
-   m_hypercube[location]++;
-   for (i = 0; i < population->getPopulationSize(); i++) 
-   {
-      location = findLocation(population->getIth(i));
-      (population->getIth(i))->m_gridLocation = location;
-      m_hypercube[location]++;
-      if (m_hypercube[location] > m_hypercube[m_mostCrowdedHypercube])
+      population->getIth(j)->m_gridLocation = findLocation(population->getIth(j));
+      addMember(population->getIth(j));
+   } /* end for() */
+} /* end PAES_AdaptiveGrid::rebound() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::findDivision()
+
+Division of the i-th objective that holds the given fitness. Fitness outside
+of the limits is in the nearest division.
+******************************************************************************/
+int PAES_AdaptiveGrid::findDivision(double fitness, int i) const
+{
+   int division;
+
+   division = 0;
+   if (m_divisionSize[i] > 0.0)
+   {
+      division = (int)((fitness - m_lowerBestFitness[i]) / m_divisionSize[i]);
+      if (division < 0)
       {
-         m_mostCrowdedHypercube = location;
+         division = 0;
       }
-   } /* end for() */
-} /* end PAES_AdaptiveGrid::updateGridLocations() */
+      if (division >= m_numberOfDivisions)
+      {
+         division = m_numberOfDivisions - 1;
+      }
+   } /* end if() */
+
+   return division;
+} /* end PAES_AdaptiveGrid::findDivision() */
 
 /******************************************************************************
 PAES_AdaptiveGrid::findLocation()
 
-Find the location of the individual in the adaptive grid
+Find the location of the individual in the adaptive grid. Individuals outside
+of the limits are located in the nearest hypercube.
 ******************************************************************************/
-int PAES_AdaptiveGrid::findLocation(PAES_Individual * individual) 
+PAES_GridKey PAES_AdaptiveGrid::findLocation(PAES_Individual * individual) const
 {
    int i;
-   int j;
-   int location;
-   int counter;
-  
+   int division;
+   PAES_GridKey location;
+
    location = 0;
-   counter  = 1;
-   for (i = 0; i < m_numberOfFunctions; i++) 
+   for (i = 0; i < m_numberOfFunctions; i++)
    {
-      m_increment[i] = counter;
-      counter *= 2;
-      m_tmpDivisionSize[i] = m_divisionSize[i];
+      division = findDivision(individual->m_fitness[i], i);
+      if (m_exactLocation)
+      {
+         location |= ((PAES_GridKey)division << (i * m_depth));
+      }
+      else
+      {
+         location = (location ^ (PAES_GridKey)division) * 1099511628211ULL;
+      }
    } /* end for() */
-  
-   for (i = 1; i <= m_depth; i++) 
+
+   return location;
+} /* end PAES_AdaptiveGrid::findLocation() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::moveCell()
+
+Move the hypercube to the list of hypercubes that have the given number of
+members.
+******************************************************************************/
+void PAES_AdaptiveGrid::moveCell(PAES_GridCell * cell, int count)
+{
+   std::vector<PAES_GridCell *> * pList;
+   int from;
+
+   // remove from the current list, the last hypercube of the list takes its slot
+   from = (int)cell->m_members.size();
+   if (cell->m_slot >= 0)
    {
-      for (j = 0; j < m_numberOfFunctions; j++) 
+      pList = &(m_crowding[from]);
+      (*pList)[cell->m_slot] = pList->back();
+      (*pList)[cell->m_slot]->m_slot = cell->m_slot;
+      pList->pop_back();
+      cell->m_slot = -1;
+   } /* end if() */
+
+   if (count > 0)
+   {
+      if (count >= (int)m_crowding.size())
       {
-         if (individual->getFitness()[j] < (m_tmpDivisionSize[j]/2 + m_lowerBestFitness[j]))
+         m_crowding.resize(count + 1);
+      }
+      cell->m_slot = (int)m_crowding[count].size();
+      m_crowding[count].push_back(cell);
+   } /* end if() */
+
+   if (count > m_mostCrowdedCount)
+   {
+      m_mostCrowdedCount = count;
+   }
+   while ((m_mostCrowdedCount > 0) && m_crowding[m_mostCrowdedCount].empty())
+   {
+      m_mostCrowdedCount--;
+   }
+} /* end PAES_AdaptiveGrid::moveCell() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::addMember()
+
+Add the individual to the hypercube of its grid location (m_gridLocation).
+******************************************************************************/
+void PAES_AdaptiveGrid::addMember(PAES_Individual * individual)
+{
+   int i;
+   PAES_GridCell * cell;
+   std::unordered_map<PAES_GridKey, PAES_GridCell *>::iterator it;
+
+   it = m_hypercube.find(individual->m_gridLocation);
+   if (it == m_hypercube.end())
+   {
+      cell = new PAES_GridCell;
+      cell->m_location = individual->m_gridLocation;
+      cell->m_slot = -1;
+      cell->m_division.resize(m_numberOfFunctions);
+      for (i = 0; i < m_numberOfFunctions; i++)
+      {
+         cell->m_division[i] = findDivision(individual->m_fitness[i], i);
+      }
+      m_hypercube[cell->m_location] = cell;
+   } /* end if() */
+   else
+   {
+      cell = it->second;
+   }
+
+   moveCell(cell, (int)cell->m_members.size() + 1);
+   individual->m_gridSlot = (int)cell->m_members.size();
+   cell->m_members.push_back(individual);
+} /* end PAES_AdaptiveGrid::addMember() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::removeMember()
+
+Remove the individual from its hypercube, the last member of the hypercube
+takes its slot.
+******************************************************************************/
+void PAES_AdaptiveGrid::removeMember(PAES_Individual * individual)
+{
+   PAES_GridCell * cell;
+   int slot;
+
+   cell = m_hypercube[individual->m_gridLocation];
+   moveCell(cell, (int)cell->m_members.size() - 1);
+
+   slot = individual->m_gridSlot;
+   cell->m_members[slot] = cell->m_members.back();
+   cell->m_members[slot]->m_gridSlot = slot;
+   cell->m_members.pop_back();
+   individual->m_gridSlot = -1;
+
+   if (cell->m_members.empty())
+   {
+      m_hypercube.erase(cell->m_location);
+      delete cell;
+   }
+} /* end PAES_AdaptiveGrid::removeMember() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::findComparable()
+
+Collect the members of the hypercubes that are no better than the hypercube of
+the individual in any objective (pWorse), and of those that are no worse
+(pBetter). Divisions are monotone in fitness, so only members of the former 
+can be dominated by the individual, and only members of the latter can 
+dominate it. Other hypercubes are skipped as a whole.
+******************************************************************************/
+void PAES_AdaptiveGrid::findComparable(PAES_Individual * individual, 
+   std::vector<PAES_Individual *> * pBetter, std::vector<PAES_Individual *> * pWorse)
+{
+   int i;
+   int c;
+   int k;
+   bool better;
+   bool worse;
+   PAES_GridCell * cell;
+
+   for (i = 0; i < m_numberOfFunctions; i++)
+   {
+      m_division[i] = findDivision(individual->m_fitness[i], i);
+   }
+
+   for (c = 1; c <= m_mostCrowdedCount; c++)
+   {
+      for (k = 0; k < (int)m_crowding[c].size(); k++)
+      {
+         cell = m_crowding[c][k];
+         better = true;
+         worse = true;
+         for (i = 0; (i < m_numberOfFunctions) && (better || worse); i++)
          {
-            location = m_increment[j];
+            if (cell->m_division[i] > m_division[i])
+            {
+               better = false;
+            }
+            else if (cell->m_division[i] < m_division[i])
+            {
+               worse = false;
+            }
+         } /* end for() */
+
+         if (better)
+         {
+            pBetter->insert(pBetter->end(), cell->m_members.begin(), cell->m_members.end());
          }
-         else
+         if (worse)
          {
-            m_lowerBestFitness[j] += m_tmpDivisionSize[j] / 2.0;
+            pWorse->insert(pWorse->end(), cell->m_members.begin(), cell->m_members.end());
          }
-      }/* end for() */
-      for (j = 0; j < m_numberOfFunctions; j++) 
+      } /* end for() */
+   } /* end for() */
+} /* end PAES_AdaptiveGrid::findComparable() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::getCount()
+
+Number of members in the hypercube at the given location.
+******************************************************************************/
+int PAES_AdaptiveGrid::getCount(PAES_GridKey location) const
+{
+   std::unordered_map<PAES_GridKey, PAES_GridCell *>::const_iterator it;
+
+   it = m_hypercube.find(location);
+   if (it == m_hypercube.end())
+   {
+      return 0;
+   }
+   return (int)it->second->m_members.size();
+} /* end PAES_AdaptiveGrid::getCount() */
+
+/******************************************************************************
+PAES_AdaptiveGrid::getMostCrowdedMember()
+
+A member of the most crowded hypercube (NULL if the grid is empty).
+******************************************************************************/
+PAES_Individual * PAES_AdaptiveGrid::getMostCrowdedMember(void) const
+{
+   if (m_mostCrowdedCount == 0)
+   {
+      return NULL;
+   }
+   return m_crowding[m_mostCrowdedCount].back()->m_members.back();
+} /* end PAES_AdaptiveGrid::getMostCrowdedMember() */
+
+/******************************************************************************
+PAES_FirstObjectiveOrder::operator()
+******************************************************************************/
+bool PAES_FirstObjectiveOrder::operator()(const PAES_Individual * a, const PAES_Individual * b) const
+{
+   if (a->m_fitness[0] != b->m_fitness[0])
+   {
+      return (a->m_fitness[0] < b->m_fitness[0]);
+   }
+   return std::less<const PAES_Individual *>()(a, b);
+} /* end PAES_FirstObjectiveOrder::operator() */
+
+bool PAES_FirstObjectiveOrder::operator()(const PAES_Individual * a, double b) const
+{
+   return (a->m_fitness[0] < b);
+} /* end PAES_FirstObjectiveOrder::operator() */
+
+bool PAES_FirstObjectiveOrder::operator()(double a, const PAES_Individual * b) const
+{
+   return (a < b->m_fitness[0]);
+} /* end PAES_FirstObjectiveOrder::operator() */
+
+/******************************************************************************
+PAES_Archive::CTOR
+******************************************************************************/
+PAES_Archive::PAES_Archive(int maximumArchiveLength, int depth, PAES_Random * random,
+                           PAES_MultiobjectiveProblem * problem, FILE * pFile)
+   : PAES_Population(0, maximumArchiveLength, random, problem, pFile)
+{
+   m_bOrdered = (problem->m_numberOfFunctions == 2);
+   m_adaptiveGrid = new PAES_AdaptiveGrid(depth, problem->m_numberOfFunctions);
+   if (!m_adaptiveGrid)
+   {
+      fprintf(m_cout, "Archive::Archive-> Not enough memory for the adaptiveGrid object\n");
+      fclose(m_cout);
+      exit(-1);
+   } /* end if() */
+} /* end PAES_Archive::PAES_Archive() */
+
+/******************************************************************************
+PAES_Archive::DTOR
+******************************************************************************/
+PAES_Archive::~PAES_Archive(void)
+{
+   int i;
+
+   for (i = 0; i < m_populationSize; i++)
+   {
+      delete m_population[i];
+   }
+   delete m_adaptiveGrid;
+} /* end PAES_Archive::~PAES_Archive() */
+
+/******************************************************************************
+PAES_Archive::findComparable()
+
+Collect the members that may dominate or have the same fitness as the solution
+(m_better), and those that the solution may dominate (m_worse). With two 
+objectives the former is the best member in the first objective among those 
+that are no worse in it, and the latter are the members that follow it, up to
+the first one that is better in the second objective.
+******************************************************************************/
+void PAES_Archive::findComparable(PAES_Individual * solution)
+{
+   std::set<PAES_Individual *, PAES_FirstObjectiveOrder>::iterator it;
+
+   m_better.clear();
+   m_worse.clear();
+   if (!m_bOrdered)
+   {
+      m_adaptiveGrid->findComparable(solution, &m_better, &m_worse);
+      return;
+   }
+
+   it = m_ordered.upper_bound(solution->m_fitness[0]);
+   if (it != m_ordered.begin())
+   {
+      it--;
+      m_better.push_back(*it);
+   }
+
+   it = m_ordered.lower_bound(solution->m_fitness[0]);
+   while ((it != m_ordered.end()) && ((*it)->m_fitness[1] >= solution->m_fitness[1]))
+   {
+      m_worse.push_back(*it);
+      it++;
+   } /* end while() */
+} /* end PAES_Archive::findComparable() */
+
+/******************************************************************************
+PAES_Archive::isDominated()
+
+Checks if the solution is dominated by a member of the archive, members with
+the same fitness count as dominating if identical is true. Expects 
+findComparable() to have been called for the solution.
+******************************************************************************/
+bool PAES_Archive::isDominated(PAES_Individual * solution, bool identical)
+{
+   int i;
+
+   for (i = 0; i < (int)m_better.size(); i++)
+   {
+      if (solution->identicalFitness(m_better[i]))
+      {
+         if (identical)
+         {
+            return true;
+         }
+      }
+      else if (solution->dominanceTest(m_better[i]) == -1)
       {
-         m_increment[j] *= m_numberOfFunctions * 2;
-         m_tmpDivisionSize[j] /= 2.0;
-      } /* for() */
+         return true;
+      }
    } /* end for() */
-  
-   return location;
-} /* end PAES_AdaptiveGrid::findLocation() */
-        
+
+   return false;
+} /* end PAES_Archive::isDominated() */
+
+/******************************************************************************
+PAES_Archive::compareToArchive()
+
+Checks if the solution is dominated by any member of the archive.
+
+Returns 0 if the solution is non-dominated, -1 if it is dominated, +1 if it
+dominates all the members of the archive.
+******************************************************************************/
+int PAES_Archive::compareToArchive(PAES_Individual * solution)
+{
+   int i;
+
+   if (m_populationSize == 0)
+   {
+      return 0;
+   }
+
+   findComparable(solution);
+   if (isDominated(solution, false))
+   {
+      return -1;
+   }
+   if ((int)m_worse.size() < m_populationSize)
+   {
+      return 0;
+   }
+   for (i = 0; i < (int)m_worse.size(); i++)
+   {
+      if (solution->dominanceTest(m_worse[i]) != 1)
+      {
+         return 0;
+      }
+   } /* end for() */
+
+   return 1;
+} /* end PAES_Archive::compareToArchive() */
+
+/******************************************************************************
+PAES_Archive::insert()
+
+Add the solution to the archive, its grid location must be set.
+******************************************************************************/
+void PAES_Archive::insert(PAES_Individual * solution)
+{
+   solution->m_archiveSlot = m_populationSize;
+   addIndividual(solution);
+   if (m_bOrdered)
+   {
+      m_ordered.insert(solution);
+   }
+   m_adaptiveGrid->addMember(solution);
+} /* end PAES_Archive::insert() */
+
+/******************************************************************************
+PAES_Archive::remove()
+
+Remove the member from the archive, and delete it. The last member of the
+archive takes its slot.
+******************************************************************************/
+void PAES_Archive::remove(PAES_Individual * member)
+{
+   int slot;
+
+   m_adaptiveGrid->removeMember(member);
+   if (m_bOrdered)
+   {
+      m_ordered.erase(member);
+   }
+
+   slot = member->m_archiveSlot;
+   m_population[slot] = m_population[m_populationSize - 1];
+   m_population[slot]->m_archiveSlot = slot;
+   m_populationSize--;
+
+   delete member;
+} /* end PAES_Archive::remove() */
+
+/******************************************************************************
+PAES_Archive::archiveSolution()
+
+Add the solution to the archive, unless it is dominated by or has the same
+fitness as a member, and remove the members it dominates. If the archive is
+full, the solution replaces a member of the most crowded hypercube, unless it
+is in such a hypercube itself.
+
+Returns true if the solution was archived, otherwise it is deleted.
+******************************************************************************/
+bool PAES_Archive::archiveSolution(PAES_Individual * solution)
+{
+   int i;
+
+   findComparable(solution);
+   if (isDominated(solution, true))
+   {
+      delete solution;
+      return false;
+   }
+
+   // Remove the dominated members
+   for (i = 0; i < (int)m_worse.size(); i++)
+   {
+      if (solution->dominanceTest(m_worse[i]) == 1)
+      {
+         remove(m_worse[i]);
+      }
+   } /* end for() */
+
+   if (!m_adaptiveGrid->contains(solution))
+   {
+      m_adaptiveGrid->rebound(this, solution);
+   }
+   solution->m_gridLocation = m_adaptiveGrid->findLocation(solution);
+
+   // If the archive is not full, add the solution
+   if (m_populationSize < m_maximumPopulationSize)
+   {
+      insert(solution);
+      return true;
+   }
+
+   // If the solution is in the most crowded region, discard it
+   if (m_adaptiveGrid->getCount(solution->m_gridLocation) >= m_adaptiveGrid->getMostCrowdedCount())
+   {
+      delete solution;
+      return false;
+   }
+
+   // Otherwise it replaces an individual of the most crowded region
+   remove(m_adaptiveGrid->getMostCrowdedMember());
+   insert(solution);
+   return true;
+} /* end PAES_Archive::archiveSolution() */
+
+/******************************************************************************
+PAES_Archive::getCrowding()
+
+Number of archive members in the hypercube of the individual.
+******************************************************************************/
+int PAES_Archive::getCrowding(PAES_Individual * individual) const
+{
+   return m_adaptiveGrid->getCount(m_adaptiveGrid->findLocation(individual));
+} /* end PAES_Archive::getCrowding() */
@@ -9,6 +9,8 @@
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
 #include "StatsClass.h"
+#include "SuperMUSE.h"
+#include "SuperMuseUtility.h"
 
 #include "Utility.h"
 #include "WriteUtility.h"
@@ -19,6 +21,10 @@
 #define DDS_SEARCH_STATE (1)
 #define DDS_DONE_STATE   (2)
 
+//state of a SuperMUSE slot, otherwise the id of the task in the slot
+#define PDDS_SLOT_IDLE   (-2)
+#define PDDS_SLOT_SERIAL (-1) //to be evaluated serially
+
 /******************************************************************************
 WarmStart()
 
@@ -62,6 +68,39 @@ void PDDSAlgorithm::ResetUserSeed(int seed)
    }
 }/* end ResetUserSeed() */
 
+/**********************************************************************
+SetUserInit()
+
+Start the search from the given parameter set instead of a random one.
+**********************************************************************/
+void PDDSAlgorithm::SetUserInit(double * pInit)
+{
+   int i, num;
+
+   if(m_pInit != NULL)
+   {
+     for(i = 0; i < m_NumInit; i++)
+     {
+        delete [] m_pInit[i];
+     }
+     delete [] m_pInit;
+   }
+
+   num = m_pModel->GetParamGroupPtr()->GetNumParams();
+   m_NumInit = 1;
+   NEW_PRINT("double *", m_NumInit);
+   m_pInit = new double * [m_NumInit];
+   MEM_CHECK(m_pInit);
+   NEW_PRINT("double", num);
+   m_pInit[0] = new double[num];
+   MEM_CHECK(m_pInit[0]);
+   for(i = 0; i < num; i++)
+   {
+      m_pInit[0][i] = pInit[i];
+   }
+   m_UserSuppliedInit = true;
+}/* end SetUserInit() */
+
 /******************************************************************************
 PDDSAlgorithm CTOR
 ******************************************************************************/
@@ -363,6 +402,16 @@ void PDDSAlgorithm::Optimize(void)
    int signal;
    const int dowork=101;
    const int stopwork=102;
+
+   /* --------------------------------------------------------------
+   Serial Ostrich with a SuperMUSE task queue: a fixed number of 
+   tasks take the place of the slaves, and results are received in 
+   order of completion.
+   -------------------------------------------------------------- */
+   SuperMUSE * pSMUSE = GetSuperMusePtr();
+   bool bSMUSE = ((IsSuperMUSE() == true) && (m_nprocessors == 1) && 
+                  (pSMUSE->IsTaskQueue() == true));
+   int * slave_task = NULL;
    
    bWarmStart = m_pModel->CheckWarmStart();
    if(bWarmStart == true)
@@ -372,6 +421,12 @@ void PDDSAlgorithm::Optimize(void)
 
    // maximum number of slaves, increase if needed
    int maxslaves = m_nprocessors+1;
+   if(bSMUSE == true)
+   {
+      maxslaves = pSMUSE->GetMaxTasksInFlight()+1;
+      slave_task = new int[maxslaves];
+      for(j = 0; j < maxslaves; j++) slave_task[j] = PDDS_SLOT_IDLE;
+   }
    double ** slave_working_on_x;
    //allocate storage for slaves.
    slave_working_on_x = new double * [maxslaves];
@@ -437,6 +492,7 @@ void PDDSAlgorithm::Optimize(void)
       jct = 0;
 
       nslaves = m_nprocessors - 1;
+      if(bSMUSE == true) nslaves = maxslaves - 1;
       slaveindex = 0;
       nxtsid = 0;
 
@@ -454,26 +510,34 @@ void PDDSAlgorithm::Optimize(void)
          -----------------------------------------------------------------------*/
          if (eval > nslaves)
          {
-            if(bSynch == true)
+            if(bSMUSE == true)
             {
-               slaveindex = nxtsid + 1;
-               nxtsid = (nxtsid + 1) % nslaves;
+               //next SuperMUSE task to complete
+               slaveindex = RecvSuperMUSE(slave_working_on_x, slave_task, nslaves);
             }
             else
             {
-               slaveindex = MPI_ANY_SOURCE;
+               if(bSynch == true)
+               {
+                  slaveindex = nxtsid + 1;
+                  nxtsid = (nxtsid + 1) % nslaves;
+               }
+               else
+               {
+                  slaveindex = MPI_ANY_SOURCE;
+               }
+               /* -------------------------------------------------------------------
+               slave will have done this: call obj_func(num_dec,stest,fvalue)
+               obtain a evaluated solution from slave
+               -------------------------------------------------------------------*/            
+               MPI_Recv(&(m_stest[m_num_dec]),1+nSpecial,MPI_DOUBLE,slaveindex,tag,MPI_COMM_WORLD,&status); 
+
+               //determine source
+               slaveindex = status.MPI_SOURCE;
             }
-            /* -------------------------------------------------------------------
-            slave will have done this: call obj_func(num_dec,stest,fvalue)
-            obtain a evaluated solution from slave
-            -------------------------------------------------------------------*/            
-            MPI_Recv(&(m_stest[m_num_dec]),1+nSpecial,MPI_DOUBLE,slaveindex,tag,MPI_COMM_WORLD,&status); 
             fvalue = m_stest[m_num_dec];
             num_recv++;
 
-            //determine source
-            slaveindex = status.MPI_SOURCE;
-
             /*
             FILE * pLog = fopen("OstMessages0.txt", "a");
             fprintf(pLog, "SlaveIndex = %02d\n", slaveindex);
@@ -763,15 +827,28 @@ void PDDSAlgorithm::Optimize(void)
                }/* end for() */
             }
 
-            // send work to slave
-            signal = dowork;
-            MPI_Send(&signal,1,MPI_INT,slaveindex,tag,MPI_COMM_WORLD); 
-            m_stest[m_num_dec] = m_Fbest;
-            for(int iS = 0; iS < nSpecial; iS++)
+            if(bSMUSE == true)
+            {
+               // submit task, unless SuperMUSE has failed
+               slave_task[slaveindex] = PDDS_SLOT_SERIAL;
+               if(IsSuperMUSE() == true)
+               {
+                  pGroup->WriteParams(m_stest);
+                  slave_task[slaveindex] = pSMUSE->SubmitTask(pGroup);
+               }
+            }
+            else
             {
-               m_stest[m_num_dec+1+iS] = Cbest[iS];
+               // send work to slave
+               signal = dowork;
+               MPI_Send(&signal,1,MPI_INT,slaveindex,tag,MPI_COMM_WORLD); 
+               m_stest[m_num_dec] = m_Fbest;
+               for(int iS = 0; iS < nSpecial; iS++)
+               {
+                  m_stest[m_num_dec+1+iS] = Cbest[iS];
+               }
+               MPI_Send(m_stest,m_num_dec+1+nSpecial,MPI_DOUBLE,slaveindex,tag,MPI_COMM_WORLD);  
             }
-            MPI_Send(m_stest,m_num_dec+1+nSpecial,MPI_DOUBLE,slaveindex,tag,MPI_COMM_WORLD);  
             for(j = 0; j < m_num_dec; j++)
             {
                slave_working_on_x[slaveindex][j] = m_stest[j];
@@ -781,9 +858,15 @@ void PDDSAlgorithm::Optimize(void)
          {
             state = DDS_DONE_STATE;
             signal = stopwork;
-            MPI_Send(&signal,1,MPI_INT,slaveindex,tag,MPI_COMM_WORLD);
+            if(bSMUSE == false) MPI_Send(&signal,1,MPI_INT,slaveindex,tag,MPI_COMM_WORLD);
          }/* end else() */
       } /* end for(OUTER DDS ALGORITHM LOOP) */
+
+      //all tasks have been received, end the SuperMUSE job
+      if((bSMUSE == true) && (IsSuperMUSE() == true))
+      {
+         while(pSMUSE->WaitForNextTask() >= 0){}
+      }
    }/* end if(master) */
    else //PAWEL slave section of code
    {
@@ -852,9 +935,65 @@ void PDDSAlgorithm::Optimize(void)
 
       delete [] Cbest;
    }/* end if() */   
+   delete [] slave_task;
    return;
 }/*end Optimize() */  
 
+/******************************************************************************
+RecvSuperMUSE()
+
+Takes the place of receiving a result from a slave when candidates are 
+evaluated on SuperMUSE: waits for the next task to complete and stores its
+objective function (and special constraints) in m_stest. Returns the slot
+(i.e. slave index) of the task. If SuperMUSE fails, the candidates that were
+in flight are evaluated serially.
+******************************************************************************/
+int PDDSAlgorithm::RecvSuperMUSE(double ** pX, int * pTask, int nslaves)
+{
+   ParameterGroup * pGroup = m_pModel->GetParamGroupPtr();
+   SuperMUSE * pSMUSE = GetSuperMusePtr();
+   int taskid, slot;
+
+   if(IsSuperMUSE() == true)
+   {
+      taskid = pSMUSE->WaitForNextTask();
+      for(slot = 1; (taskid >= 0) && (slot <= nslaves); slot++)
+      {
+         if(pTask[slot] == taskid)
+         {
+            pTask[slot] = PDDS_SLOT_IDLE;
+            pGroup->WriteParams(pX[slot]);
+            m_stest[m_num_dec] = pSMUSE->GatherResult(taskid);
+            pGroup->GetSpecialConstraints(&(m_stest[m_num_dec+1]));
+            m_CurIter++;
+            return slot;
+         }
+      }/* end for() */
+
+      LogError(ERR_SMUSE, "Reverting to serial execution.");
+      DisableSuperMUSE();
+      for(slot = 1; slot <= nslaves; slot++)
+      {
+         if(pTask[slot] != PDDS_SLOT_IDLE) pTask[slot] = PDDS_SLOT_SERIAL;
+      }
+   }/* end if() */
+
+   for(slot = 1; slot <= nslaves; slot++)
+   {
+      if(pTask[slot] == PDDS_SLOT_SERIAL)
+      {
+         pTask[slot] = PDDS_SLOT_IDLE;
+         m_stest[m_num_dec] = obj_func(m_num_dec, pX[slot]);
+         pGroup->GetSpecialConstraints(&(m_stest[m_num_dec+1]));
+         return slot;
+      }
+   }/* end for() */
+
+   LogError(ERR_SMUSE, "PDDS: no candidate in flight");
+   ExitProgram(1);
+   return 0;
+}/* end RecvSuperMUSE() */
+
 /*=========================================================================================
 neigh_value()
 
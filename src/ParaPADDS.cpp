@@ -9,6 +9,7 @@ implementation of Mohammadamin Jahanpour (mjahanpo@uwaterloo.ca).
 
 Version History
 05-07-15    lsm   created file
+10-19-26    lsm   HV() sorts pointers instead of deep copies of the points
 ******************************************************************************/
 
 /*------------------------------------------------------------------- 
@@ -91,6 +92,10 @@ ParaPADDS::ParaPADDS(ModelABC * pModel)
    m_dimension = 0;
    m_dSqrtDataNumber = 0;
    m_volume = 0;
+   m_pHVPoints = NULL;
+   m_HVSize = 0;
+   m_pHVRegion = NULL;
+   m_HVRegionSize = 0;
    m_stest_flat = NULL;
 
    #if(PARA_PADDS_DEBUG == 1)
@@ -129,6 +134,8 @@ void ParaPADDS::Destroy(void)
    }
 
    delete [] m_stest_flat;
+   delete [] m_pHVPoints;
+   delete [] m_pHVRegion;
 
    #if(PARA_PADDS_DEBUG == 1)
       printf("Destroyed ParaPADDS instance\n");
@@ -173,7 +180,7 @@ void ParaPADDS::WriteMetrics(FILE * pFile)
    }
    else
    {
-      m_pModel->GetParamInitializerPtr()->Write(pFile, 0);
+      m_pModel->GetParamInitializerPtr()->Write(pFile);
    }
 
    m_pModel->WriteMetrics(pFile);
@@ -1170,64 +1177,35 @@ void ParaPADDS::Calc_Z(ArchiveStruct * archive)
             refPoint[i] = 1.00001*(pSorted[archive_size - 1]->F[i]);
          }/* end for() */
 
+         //HV() only reads the points, so pass the obj. func. values
+         //of the archive instead of copies
          double ** pointsInitial = new double *[dataNumber];
          for (int i = 0; i < dataNumber; i++)
          {
-            pointsInitial[i] = new double[dimension];
-
-            for (int j = 0; j < m_num_objs; j++)
-            {
-               pointsInitial[i][j] = pSorted[i]->F[j];
-            }
+            pointsInitial[i] = pSorted[i]->F;
          }
 
          double HyperVolume = HV(dataNumber, dimension, refPoint, pointsInitial);
 
-         //destroy pointsInitial
-         for (int j = 0; j < dataNumber; j++)
-         {
-            delete[] pointsInitial[j];
-         }
-         delete[] pointsInitial;
-
          double best_z = 0;
 
          for(int i = 0; i < dataNumber; i++) 
          {
-            int * included_points = new int[dataNumber];
+            //leave out ith point
+            int k = 0;
             for(int j = 0; j < dataNumber; j++)
             {
-               included_points[j] = j;
-               //leave out ith point
-               if(j >= i) included_points[j]++;
+               if(j != i) pointsInitial[k++] = pSorted[j]->F;
             }
 
-            double ** pointsInitial_sub = new double * [dataNumber - 1];
-            for (int j = 0; j < dataNumber - 1; j++)
-            {
-               pointsInitial_sub[j] = new double[dimension];
-
-               for (int k = 0; k < m_num_objs; k++)
-               {
-                  pointsInitial_sub[j][k] = pSorted[included_points[j]]->F[k];
-               }
-            }/* end for() */
-
-            pSorted[i]->Z = HyperVolume - HV(dataNumber - 1, dimension, refPoint, pointsInitial_sub);
+            pSorted[i]->Z = HyperVolume - HV(dataNumber - 1, dimension, refPoint, pointsInitial);
 
             if(pSorted[i]->Z > best_z)
             {
                best_z = pSorted[i]->Z; 
             }
-
-            //destroy pointsInitial_sub
-            for (int j = 0; j < dataNumber - 1; j++)
-            {
-               delete[] pointsInitial_sub[j];
-            }
-            delete[] pointsInitial_sub;
-            delete [] included_points;
          }/* end for() */
+         delete [] pointsInitial;
 
          // taking care of the edges
          for (int i = 0; i < dimension; i++)
@@ -1641,20 +1619,33 @@ double ParaPADDS::HV(int data_n, int dim_n, double * ref, double ** points)
    //set global
    m_dimension = dim_n;
 
-   double ** pointsInitial = new double *[dataNumber];
-   for (int n = 0; n < dataNumber; n++)
+   /* 
+   The points are only reordered, so sort a copy of the list of pointers
+   rather than a copy of the points. The copy and the region bounds are
+   kept in scratch buffers that are reused by subsequent calls.
+   */
+   if(m_HVSize < dataNumber)
    {
-      pointsInitial[n] = new double[dim_n];
-      for (int i = 0; i < dim_n; i++)
-      {
-         pointsInitial[n][i] = points[n][i];
-      }
+      delete [] m_pHVPoints;
+      m_HVSize = dataNumber;
+      NEW_PRINT("double *", m_HVSize);
+      m_pHVPoints = new double *[m_HVSize];
+      MEM_CHECK(m_pHVPoints);
    }
-   double* refPoint = new double[dim_n];
-   for (i = 0; i < dim_n; i++)
+   if(m_HVRegionSize < 2*dim_n)
    {
-      refPoint[i] = ref[i];
+      delete [] m_pHVRegion;
+      m_HVRegionSize = 2*dim_n;
+      NEW_PRINT("double", m_HVRegionSize);
+      m_pHVRegion = new double[m_HVRegionSize];
+      MEM_CHECK(m_pHVRegion);
    }
+   double ** pointsInitial = m_pHVPoints;
+   for (int n = 0; n < dataNumber; n++)
+   {
+      pointsInitial[n] = points[n];
+   }
+   double* refPoint = ref;
 
    // initialize volume
    m_volume = 0.0;
@@ -1662,8 +1653,8 @@ double ParaPADDS::HV(int data_n, int dim_n, double * ref, double ** points)
    m_dSqrtDataNumber = sqrt((double)dataNumber);
 
    // initialize region
-   double* regionLow = new double[dim_n - 1];
-   double* regionUp = new double[dim_n - 1];
+   double* regionLow = m_pHVRegion;
+   double* regionUp = &(m_pHVRegion[dim_n]);
    for (j = 0; j < dim_n - 1; j++) 
    {
       // determine minimal j coordinate
@@ -1685,15 +1676,6 @@ double ParaPADDS::HV(int data_n, int dim_n, double * ref, double ** points)
    // call stream initially
    stream(regionLow, regionUp, pointsInitial, dataNumber, 0, refPoint[m_dimension - 1]);
 
-   for (int n = 0; n < dataNumber; n++)
-   {
-      delete [] pointsInitial[n];
-   }
-   delete [] pointsInitial;
-   delete [] refPoint;
-   delete [] regionLow;
-   delete [] regionUp;
-
    // print hypervolume
    return m_volume;
 } /* end HV() */
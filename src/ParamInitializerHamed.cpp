@@ -406,7 +406,7 @@ Write()
 
 Writes formatted output to pFile.
 ******************************************************************************/
-void HamedParamInitializer::Write(FILE * pFile, int type)
+void HamedParamInitializer::Write(FILE * pFile)
 {
    fprintf(pFile, "****** Parameter Initialization ******\n");
    fprintf(pFile, "Name       : Hamed's Method\n");
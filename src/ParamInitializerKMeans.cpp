@@ -611,7 +611,7 @@ Write()
 
 Writes formatted output to pFile.
 ******************************************************************************/
-void KMeansParamInitializer::Write(FILE * pFile, int type)
+void KMeansParamInitializer::Write(FILE * pFile)
 {
    fprintf(pFile, "********** Parameter Initialization **********\n");
    fprintf(pFile, "Name                   : KMeans Clustering\n");
@@ -0,0 +1,195 @@
+/******************************************************************************
+File      : ParamInitializerQuasiRandom.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Encapsulates the space-filling (quasi-random) parameter initialization
+strategy. Supported designs are:
+   sobol      : scrambled Sobol sequence
+   halton     : scrambled Halton sequence
+   maximinlhs : maximin Latin hypercube
+
+Version History
+10-19-2026    lsm   created
+******************************************************************************/
+#include <string.h>
+#include "ParamInitializerABC.h"
+#include "ParameterGroup.h"
+#include "ParameterABC.h"
+#include "QuasiRandom.h"
+#include "MaximinLatinHypercube.h"
+#include "Exception.h"
+#include "Utility.h"
+#include "mpi.h"
+
+/******************************************************************************
+GetParameterSets()
+
+Scale the design to the parameter bounds and populate the "pVals" matrix.
+******************************************************************************/
+void QuasiRandomParamInitializer::GetParameterSets(double ** pVals, int start)
+{
+   int i, j;
+   double lwr, upr;
+
+   for(i = 0; i < m_NumSets; i++)
+   {
+      for(j = 0; j < m_NumParams; j++)
+      {
+         lwr = m_pParams->GetParamPtr(j)->GetLwrBnd();
+         upr = m_pParams->GetParamPtr(j)->GetUprBnd();
+         pVals[start + i][j] = lwr + (upr - lwr)*m_pDesign[i*m_NumParams + j];
+      }
+   }
+} /* end GetParameterSets() */
+
+/******************************************************************************
+CTOR
+
+Assign member variables by parsing input file and then build the design. The
+design is built by the master processor and broadcast, so that every processor
+sees the same initial parameter sets.
+******************************************************************************/
+QuasiRandomParamInitializer::QuasiRandomParamInitializer(ParameterGroup * pParamGroup, FILE * pInFile, IroncladString pType)
+{
+   int i, rank;
+   char * line;
+   char tmp[DEF_STR_SZ];
+   char tmp2[DEF_STR_SZ];
+   char pFileName[] = "ostIn.txt";
+   double start;
+   QuasiRandom * pQmc;
+   MaximinLatinHypercube * pLHS;
+
+   m_pParams = pParamGroup;
+   m_NumParams = pParamGroup->GetNumParams();
+   m_NumSets = 50;
+   m_bScramble = true;
+   m_MaximinIters = 1000;
+   m_MinDist = 0.00;
+   m_Time = 0.00;
+   m_pDesign = NULL;
+   strcpy(m_Type, pType);
+
+   //read in configuration, if any
+   if(pInFile != NULL)
+   {
+      rewind(pInFile);
+      if(CheckToken(pInFile, "BeginQuasiRandomInitializer", pFileName) == true)
+      {
+         FindToken(pInFile, "EndQuasiRandomInitializer", pFileName);
+         rewind(pInFile);
+
+         FindToken(pInFile, "BeginQuasiRandomInitializer", pFileName);
+         line = GetNxtDataLine(pInFile, pFileName);
+         while(strstr(line, "EndQuasiRandomInitializer") == NULL)
+         {
+            if(strstr(line, "NumSets") != NULL)
+            {
+               sscanf(line, "%s %d", tmp, &m_NumSets);
+            }/* end if() */
+            else if(strstr(line, "Scramble") != NULL)
+            {
+               sscanf(line, "%s %s", tmp, tmp2);
+               MyStrLwr(tmp2);
+               m_bScramble = (strcmp(tmp2, "no") != 0);
+            }/* end else if() */
+            else if(strstr(line, "MaximinIterations") != NULL)
+            {
+               sscanf(line, "%s %d", tmp, &m_MaximinIters);
+            }/* end else if() */
+            else
+            {
+               sprintf(tmp, "Unknown token: %s", line);
+               LogError(ERR_FILE_IO, tmp);
+            }/* end else() */
+            line = GetNxtDataLine(pInFile, pFileName);
+         } /* end while() */
+      }/* end if() */
+      rewind(pInFile);
+   }/* end if() */
+
+   if(m_NumSets < 1)
+   {
+      LogError(ERR_FILE_IO, "Invalid number of quasi-random parameter sets");
+      ExitProgram(1);
+   }
+
+   NEW_PRINT("double", m_NumSets*m_NumParams);
+   m_pDesign = new double[m_NumSets*m_NumParams];
+   MEM_CHECK(m_pDesign);
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   if(rank == 0)
+   {
+      start = GetElapsedTics();
+      if(strcmp(m_Type, "maximinlhs") == 0)
+      {
+         NEW_PRINT("MaximinLatinHypercube", 1);
+         pLHS = new MaximinLatinHypercube(m_NumParams, m_NumSets);
+         MEM_CHECK(pLHS);
+
+         pLHS->Generate(m_MaximinIters);
+         for(i = 0; i < m_NumSets; i++)
+         {
+            pLHS->GetPoint(i, &(m_pDesign[i*m_NumParams]));
+         }
+         m_MinDist = pLHS->GetMinDistance();
+         delete pLHS;
+      }/* end if() */
+      else
+      {
+         NEW_PRINT("QuasiRandom", 1);
+         if(strcmp(m_Type, "halton") == 0)
+            pQmc = new QuasiRandom(m_NumParams, QMC_HALTON, m_bScramble);
+         else
+            pQmc = new QuasiRandom(m_NumParams, QMC_SOBOL, m_bScramble);
+         MEM_CHECK(pQmc);
+
+         for(i = 0; i < m_NumSets; i++)
+         {
+            pQmc->GetPoint(i, &(m_pDesign[i*m_NumParams]));
+         }
+         delete pQmc;
+      }/* end else() */
+      m_Time = GetElapsedTics() - start;
+   }/* end if() */
+   MPI_Bcast(m_pDesign, m_NumSets*m_NumParams, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Free up memory of the initializer.
+******************************************************************************/
+void QuasiRandomParamInitializer::Destroy(void)
+{
+   delete [] m_pDesign;
+   m_pDesign = NULL;
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+Write()
+
+Writes formatted output to pFile.
+******************************************************************************/
+void QuasiRandomParamInitializer::Write(FILE * pFile)
+{
+   fprintf(pFile, "****** Parameter Initialization ******\n");
+   if(strcmp(m_Type, "maximinlhs") == 0)
+   {
+      fprintf(pFile, "Name       : Maximin Latin Hypercube\n");
+      fprintf(pFile, "Iterations : %d\n", m_MaximinIters);
+      fprintf(pFile, "Min. Dist. : %E\n", m_MinDist);
+   }
+   else
+   {
+      fprintf(pFile, "Name       : %s Sequence\n", (strcmp(m_Type, "halton") == 0) ? "Halton" : "Sobol");
+      fprintf(pFile, "Scramble   : %s\n", (m_bScramble == true) ? "yes" : "no");
+   }
+   fprintf(pFile, "Num Sets   : %d\n", m_NumSets);
+   fprintf(pFile, "Build Time : %.3lf sec\n", m_Time);
+} /* end Write() */
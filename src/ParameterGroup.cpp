@@ -21,6 +21,7 @@ Version History
                   parameters functionality. Added two new tied parameter types 
                   to support ratios: TiedParamSimpleRatio and TiedParamComplexRatio.
 07-18-07    lsm   Added support for SuperMUSE
+10-19-26    lsm   SubIntoFile() reuses a scratch buffer for geometry parameters
 ******************************************************************************/
 #include <string>
 #include <math.h>
@@ -320,6 +321,7 @@ void ParameterGroup::Destroy(void)
       delete m_pGeom[j];
    }
    delete [] m_pGeom;
+   delete [] m_pGeomStr;
 
    for(j = 0; j < m_NumSpecial; j++)
    {
@@ -353,6 +355,8 @@ ParameterGroup::ParameterGroup(void)
    m_NumExcl = 0;
    m_NumTied = 0;
    m_NumGeom = 0;
+   m_pGeomStr = NULL;
+   m_GeomStrSize = 0;
    m_NumSpecial = 0;
    InitFromFile(GetInFileName());
    IncCtorCount();
@@ -368,7 +372,6 @@ void ParameterGroup::SubIntoFile(FilePipe * pPipe)
    int i, size;
    char find[DEF_STR_SZ];
    char replace[DEF_STR_SZ];
-   char * pRep;
    ParameterABC * pParam;
    TiedParamABC * pTied;
    GeomParamABC * pGeom;
@@ -406,15 +409,20 @@ void ParameterGroup::SubIntoFile(FilePipe * pPipe)
    {     
       pGeom = m_pGeom[i];
       strcpy(find, pGeom->GetName());
-      size = m_pGeom[i]->GetValStrSize();
+      size = m_pGeom[i]->GetValStrSize() + 10;
 
-      NEW_PRINT("char", size);
-      pRep = new char[size+10];
-      MEM_CHECK(pRep);
+      //grow scratch buffer, if necessary
+      if(m_GeomStrSize < size)
+      {
+         delete [] m_pGeomStr;
+         m_GeomStrSize = size;
+         NEW_PRINT("char", size);
+         m_pGeomStr = new char[size];
+         MEM_CHECK(m_pGeomStr);
+      }
 
-      pGeom->GetValAsStr(pRep);
-      pPipe->FindAndReplace(find,pRep);
-      delete [] pRep;
+      pGeom->GetValAsStr(m_pGeomStr);
+      pPipe->FindAndReplace(find,m_pGeomStr);
    } /* end for() */
 
    //special parameters
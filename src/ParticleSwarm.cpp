@@ -30,6 +30,13 @@ Version History
                   input file:
                      InitPopulationMethod LHS
 07-18-07    lsm   Added support for SuperMUSE
+10-19-26    lsm   Swarm evaluation is timed by the evaluation profiler.
+10-19-26    lsm   Swarm is stored as contiguous matrices (SwarmKernel) and 
+                  the position matrix is broadcast without packing.
+10-19-26    lsm   Particle moves are pre-screened with the surrogate engine, if
+                  any, and parallel model runs are shared with all processors.
+10-19-26    lsm   The main loop can be checkpointed and resumed (see Checkpoint.h).
+10-19-26    lsm   Model runs are only kept for sharing while PSO runs.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -47,6 +54,10 @@ Version History
 #include "LatinHypercube.h"
 #include "QuadTree.h"
 #include "SuperMUSE.h"
+#include "Profiler.h"
+#include "SwarmKernel.h"
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
 
 #include "Exception.h"
 #include "WriteUtility.h"
@@ -68,8 +79,8 @@ void ParticleSwarm::WarmStart(void)
 
    for(i = 0; i < np; i++)
    {
-      m_pSwarm[0].x[i] = pbest[i];
-      m_pSwarm[0].b[i] = pbest[i];
+      m_pSwarm->GetX(0)[i] = pbest[i];
+      m_pSwarm->GetB(0)[i] = pbest[i];
    }
    ((Model *)m_pModel)->SetCounter(newcount);
    delete [] pbest;
@@ -86,20 +97,20 @@ ParticleSwarm::ParticleSwarm(ModelABC * pModel)
    m_pModel = pModel;
    m_pSwarm = NULL;
    m_pStats = NULL;
+   m_pCkpt = NULL;
+   m_BudgetFrac = 0.00;
    m_pTrees = NULL;
    m_pInit = NULL;
    m_TreeSize = 0;
    m_SwarmSize = 0;
    m_BestIdx = 0;
-   m_NumUprViols = 0;
-   m_NumLwrViols = 0;
    m_NumInit = 0;
+   m_Fmedian = NULL;
 
    //MPI-parallel communication arrays
    m_pMyBuf  = NULL;
    m_pTmpBuf = NULL;
    m_pBigBuf = NULL;
-   m_pBuf    = NULL;
 
    IncCtorCount();
 }/* end CTOR() */
@@ -112,15 +123,9 @@ Free up memory used by the PSO and it's member variables.
 void ParticleSwarm::Destroy(void)
 {
    int i;
-   for(i = 0; i < m_SwarmSize; i++)
-   {
-      delete [] m_pSwarm[i].v;
-      delete [] m_pSwarm[i].x;
-      delete [] m_pSwarm[i].b;
-      delete [] m_pSwarm[i].cb;
-      delete [] m_pSwarm[i].cx;
-   }
-   delete [] m_pSwarm;
+
+   delete m_pSwarm;
+   delete m_pCkpt;
 
    for(i = 0; i < m_NumInit; i++)
    {
@@ -137,7 +142,6 @@ void ParticleSwarm::Destroy(void)
    delete [] m_pMyBuf;
    delete [] m_pTmpBuf;
    delete [] m_pBigBuf;
-   delete [] m_pBuf;
 
    IncDtorCount();
 }/* end Destroy() */
@@ -153,7 +157,7 @@ double ParticleSwarm::CalcPSOMedian(void)
    double med;
    int i;
     
-   for(i = 0; i < m_SwarmSize; i++) { m_Fmedian[i] = m_pSwarm[i].fx; }
+   memcpy(m_Fmedian, m_pSwarm->GetObjFuncs(), sizeof(double)*m_SwarmSize);
    med = CalcMedian(m_Fmedian, m_SwarmSize);
 
    return med;
@@ -205,13 +209,15 @@ void ParticleSwarm::Optimize(void)
 {
    // char msg[DEF_STR_SZ];
    StatusStruct pStatus;
-   int num, g;
+   int num, g, gStart;
    int id, lvl, idx;
+   bool bResume;
    int i, j;
-   double upr, lwr, r, range, sgn;
-   double avg, x, pl, pg, r1, r2, v, vmin, median;
+   double upr, lwr, r, range;
+   double median;
    double rval, init; //initial inertia
    double * pVals;
+   ParameterABC * pParam;
    LatinHypercube * pLHS = NULL;
    ParameterGroup * pGroup;
    
@@ -219,7 +225,23 @@ void ParticleSwarm::Optimize(void)
 
    MPI_Comm_rank(MPI_COMM_WORLD, &id);
 
-   if(id == 0)
+   //model runs are shared with the surrogate engine of each processor
+   if(m_pModel->GetSurrogateEnginePtr() != NULL)
+   {
+      m_pModel->GetSurrogateEnginePtr()->EnableSync();
+   }
+
+   //checkpoints are only taken when PSO is the top-level algorithm
+   bResume = false;
+   if(GetProgramType() == PSO_PROGRAM)
+   {
+      NEW_PRINT("Checkpoint", 1);
+      m_pCkpt = new Checkpoint(m_pModel, "PSO");
+      MEM_CHECK(m_pCkpt);
+      bResume = m_pCkpt->Resume();
+   }
+
+   if((id == 0) && (bResume == false))
    {
       WriteSetup(m_pModel, "Particle Swarm Optimization");
       //write banner
@@ -231,282 +253,184 @@ void ParticleSwarm::Optimize(void)
    num = pGroup->GetNumParams();
    int nSpecial = pGroup->GetNumSpecialParams();
 
-   NEW_PRINT("ParticleStruct", m_SwarmSize);
-   m_pSwarm = new ParticleStruct[m_SwarmSize];
+   NEW_PRINT("SwarmKernel", 1);
+   m_pSwarm = new SwarmKernel(m_SwarmSize, num, nSpecial);
    MEM_CHECK(m_pSwarm);
 
    NEW_PRINT("double", m_SwarmSize);
    m_Fmedian = new double[m_SwarmSize];
    MEM_CHECK(m_Fmedian);
 
-   for(i = 0; i < m_SwarmSize; i++)
+   for(j = 0; j < num; j++)
    {
-      NEW_PRINT("double", num);
-      m_pSwarm[i].x = new double[num];
-
-      NEW_PRINT("double", num);
-      m_pSwarm[i].v = new double[num];
-
-      NEW_PRINT("double", num);
-      m_pSwarm[i].b = new double[num];
-
-      NEW_PRINT("double", nSpecial);
-      m_pSwarm[i].cb = new double[nSpecial];
-
-      NEW_PRINT("double", nSpecial);
-      m_pSwarm[i].cx = new double[nSpecial];
-
-      m_pSwarm[i].n = num;
+      pParam = pGroup->GetParamPtr(j);
+      m_pSwarm->SetBounds(j, pParam->GetLwrBnd(), pParam->GetUprBnd(),
+                          (strcmp(pParam->GetType(), "real") == 0));
    }/* end for() */
-   MEM_CHECK(m_pSwarm[i-1].b);
+   if(id == 0) m_pSwarm->SetScreen(m_pModel->GetSurrogateEnginePtr());
 
-   //initialize swarm
-   if(m_InitType == LHS_INIT)
+   if(bResume == true)
    {
-      NEW_PRINT("LatinHypercube", 1);
-      pLHS = new LatinHypercube(num, m_SwarmSize);
-      MEM_CHECK(pLHS);
-
-      for(j = 0; j < num; j++)
-      { 
-         lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
-         upr = pGroup->GetParamPtr(j)->GetUprBnd();
-         pLHS->InitRow(j, lwr, upr);
-      }/* end for() */
-   }/* end if() */
- 
-   lvl = idx = 0;
-   for(i = 0; i < m_SwarmSize; i++) //for each particle
+      gStart = m_pCkpt->ReadInt();
+      init = m_pCkpt->ReadDouble();
+      m_Inertia = m_pCkpt->ReadDouble();
+      m_RedRate = m_pCkpt->ReadDouble();
+      m_BestIdx = m_pCkpt->ReadInt();
+      m_Best = m_pCkpt->ReadDouble();
+      m_CurStop = m_pCkpt->ReadDouble();
+      m_BudgetFrac = m_pCkpt->ReadDouble();
+      m_pSwarm->ReadCheckpoint(m_pCkpt);
+      pGroup->EnableSpecialParams();
+      pStatus.maxIter = m_MaxGens;
+   }
+   else
    {
-      //initial velocity is 0.00
-      for(j = 0; j < num; j++){ m_pSwarm[i].v[j] = 0.00;}
-
-      if(m_InitType == RANDOM_INIT)
+      //initialize swarm
+      if(m_InitType == LHS_INIT)
       {
-         for(j = 0; j < num; j++) //for each parameter
-         {
-            //generate a random between lower and upper bound
+         NEW_PRINT("LatinHypercube", 1);
+         pLHS = new LatinHypercube(num, m_SwarmSize);
+         MEM_CHECK(pLHS);
+
+         for(j = 0; j < num; j++)
+         { 
             lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
             upr = pGroup->GetParamPtr(j)->GetUprBnd();
-            range = upr - lwr;
-            r = (double)MyRand() / (double)MY_RAND_MAX;
-            rval = (r * range) + lwr;
-            m_pSwarm[i].x[j] = rval;
-            m_pSwarm[i].b[j] = rval;         
+            pLHS->InitRow(j, lwr, upr);
          }/* end for() */
       }/* end if() */
-      else if(m_InitType == QUAD_TREE_INIT)
+ 
+      lvl = idx = 0;
+      for(i = 0; i < m_SwarmSize; i++) //for each particle
       {
-         //initialize quad trees if needed
-         if(m_pTrees == NULL)
+         //initial velocity is 0.00 (set by the swarm kernel)
+         if(m_InitType == RANDOM_INIT)
          {
-            m_TreeSize = num;
-            NEW_PRINT("QuadTree", m_TreeSize);
-            m_pTrees = new QuadTree[m_TreeSize];
-            for(j = 0; j < m_TreeSize; j++)
-            { 
+            for(j = 0; j < num; j++) //for each parameter
+            {
+               //generate a random between lower and upper bound
                lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
                upr = pGroup->GetParamPtr(j)->GetUprBnd();
-               m_pTrees[j].Init(lwr, upr);
+               range = upr - lwr;
+               r = (double)MyRand() / (double)MY_RAND_MAX;
+               rval = (r * range) + lwr;
+               m_pSwarm->GetX(i)[j] = rval;
+               m_pSwarm->GetB(i)[j] = rval;
             }/* end for() */
          }/* end if() */
-
-         pVals = GetTreeCombo(lvl, idx, m_pTrees, m_TreeSize);
-         //expand tree if needed.
-         if(pVals == NULL)
+         else if(m_InitType == QUAD_TREE_INIT)
          {
-            for(j = 0; j < m_TreeSize; j++){ m_pTrees[j].Expand();}
-            lvl++;
-            idx = 0;            
+            //initialize quad trees if needed
+            if(m_pTrees == NULL)
+            {
+               m_TreeSize = num;
+               NEW_PRINT("QuadTree", m_TreeSize);
+               m_pTrees = new QuadTree[m_TreeSize];
+               for(j = 0; j < m_TreeSize; j++)
+               { 
+                  lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
+                  upr = pGroup->GetParamPtr(j)->GetUprBnd();
+                  m_pTrees[j].Init(lwr, upr);
+               }/* end for() */
+            }/* end if() */
+
             pVals = GetTreeCombo(lvl, idx, m_pTrees, m_TreeSize);
-         }
-         idx++;
-         for(j = 0; j < num; j++)
+            //expand tree if needed.
+            if(pVals == NULL)
+            {
+               for(j = 0; j < m_TreeSize; j++){ m_pTrees[j].Expand();}
+               lvl++;
+               idx = 0;            
+               pVals = GetTreeCombo(lvl, idx, m_pTrees, m_TreeSize);
+            }
+            idx++;
+            memcpy(m_pSwarm->GetX(i), pVals, sizeof(double)*num);
+            memcpy(m_pSwarm->GetB(i), pVals, sizeof(double)*num);
+            delete [] pVals;
+         }/* end else if(QUAD_TREE_INIT) */
+         else //LHS_INIT
          {
-            m_pSwarm[i].x[j] = pVals[j];
-            m_pSwarm[i].b[j] = pVals[j];
-         }/* end for() */
-         delete [] pVals;
-      }/* end else if(QUAD_TREE_INIT) */
-      else //LHS_INIT
-      {
-         for(j = 0; j < num; j++)
-         { 
-            rval = pLHS->SampleRow(j);
-            m_pSwarm[i].x[j] = rval;
-            m_pSwarm[i].b[j] = rval;
-         }/* end for() */
-      }/* end else() */
-   }/* end for() */
+            for(j = 0; j < num; j++)
+            { 
+               rval = pLHS->SampleRow(j);
+               m_pSwarm->GetX(i)[j] = rval;
+               m_pSwarm->GetB(i)[j] = rval;
+            }/* end for() */
+         }/* end else() */
+      }/* end for() */
 
-   //seed swarm with pre-specified values
-   for(i = 0; (i < m_NumInit) && (i < m_SwarmSize); i++)
-   {
-      for(j = 0; j < num; j++)
-      {         
-         m_pSwarm[i].x[j] = m_pInit[i][j];
-         m_pSwarm[i].b[j] = m_pInit[i][j];
+      //seed swarm with pre-specified values
+      for(i = 0; (i < m_NumInit) && (i < m_SwarmSize); i++)
+      {
+         memcpy(m_pSwarm->GetX(i), m_pInit[i], sizeof(double)*num);
+         memcpy(m_pSwarm->GetB(i), m_pInit[i], sizeof(double)*num);
       }/* end for() */
-   }/* end for() */
 
-   //insert warm start solution, if desired
-   if(m_pModel->CheckWarmStart() == true)
-   {
-      WarmStart();
-   }
-   //insert extracted solution, if desired
-   if(pGroup->CheckExtraction() == true)
-   {
-      pGroup->ReadParams(m_pSwarm[0].x);
-      pGroup->ReadParams(m_pSwarm[0].b);
-   }/* end if() */
+      //insert warm start solution, if desired
+      if(m_pModel->CheckWarmStart() == true)
+      {
+         WarmStart();
+      }
+      //insert extracted solution, if desired
+      if(pGroup->CheckExtraction() == true)
+      {
+         pGroup->ReadParams(m_pSwarm->GetX(0));
+         pGroup->ReadParams(m_pSwarm->GetB(0));
+      }/* end if() */
 
-   delete pLHS;
+      delete pLHS;
 
-   //evaluate swarm, possibly in parallel
-   m_CurGen = 0;
-   EvaluateSwarm();
+      //evaluate swarm, possibly in parallel
+      m_CurGen = 0;
+      EvaluateSwarm();
 
-   //perform intermediate bookkeeping
-   m_pModel->Bookkeep(false);
+      //perform intermediate bookkeeping
+      m_pModel->Bookkeep(false);
 
-   for(i = 0; i < m_SwarmSize; i++)
-   {
-	   m_pSwarm[i].fb = m_pSwarm[i].fx;
-      for(int iSpecial = 0; iSpecial < nSpecial; iSpecial++)
-      {
-	      m_pSwarm[i].cb[iSpecial] = m_pSwarm[i].cx[iSpecial];
-      }
       //sync best with current, in case parameter corrections were made
-      for(j = 0; j < num; j++)
-      {
-         m_pSwarm[i].b[j] =  m_pSwarm[i].x[j];
-      }
-   }
-
-   /* --------------------------------------------
-   enable special parameters now that local best 
-   is initialized for each particle
-   -------------------------------------------- */
-   pGroup->EnableSpecialParams();
+      m_pSwarm->InitBest();
+
+      /* --------------------------------------------
+      enable special parameters now that local best 
+      is initialized for each particle
+      -------------------------------------------- */
+      pGroup->EnableSpecialParams();
+
+      //determine the best particle
+      m_BestIdx = 0;
+      m_Best = m_pSwarm->GetFb(0);
+      m_pSwarm->UpdateBest(&m_BestIdx, &m_Best);
+      median = CalcPSOMedian();
+      //current convergence value
+      m_CurStop = fabs((median - m_Best)/median);
 
-   //determine the best particle and average value
-   m_BestIdx = 0;
-   avg = 0.00;
-   m_Best = m_pSwarm[0].fb;
-   for(i = 0; i < m_SwarmSize; i++)
-   {
-      avg += m_pSwarm[i].fx;
-      if(m_Best > m_pSwarm[i].fx)
+      if(id == 0)
       {
-         m_Best = m_pSwarm[i].fx;
-         m_BestIdx = i;
+         //write initial config.
+         pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
+         WriteRecord(m_pModel, 0, m_Best, m_CurStop);
+         pStatus.curIter = 0;
+         pStatus.maxIter = m_MaxGens;
+         pStatus.pct = 0.00;
+         pStatus.numRuns = m_pModel->GetCounter();
+         WriteStatus(&pStatus);
       }/* end if() */
-   }/* end if() */
-   avg /= m_SwarmSize;
-   median = CalcPSOMedian();
-   //current convergence value
-   m_CurStop = fabs((median - m_Best)/median);
-
-   if(id == 0)
-   {
-      //write initial config.
-      pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
-      WriteRecord(m_pModel, 0, m_Best, m_CurStop);
-      pStatus.curIter = 0;
-      pStatus.maxIter = m_MaxGens;
-      pStatus.pct = 0.00;
-      pStatus.numRuns = m_pModel->GetCounter();
-      WriteStatus(&pStatus);
-   }/* end if() */
 
-   init = m_Inertia;
+      init = m_Inertia;
+      gStart = 0;
+   }/* end else() */
    //main optimization loop   
-   for(g = 0; g < m_MaxGens; g++)
+   for(g = gStart; g < m_MaxGens; g++)
    {
       pStatus.curIter = m_CurGen = g+1;
       if(IsQuit() == true){ break;}
       if(m_CurStop < m_StopVal){ pStatus.pct = 100.00; break;}
 
+      //update velocities and parameters
       if(id == 0)
       {
-         //update velocities, parameters and objective functions
-         for(i = 0; i < m_SwarmSize; i++) //for each particle
-         {
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               //intermediary variables
-               x = m_pSwarm[i].x[j];
-               pl = m_pSwarm[i].b[j];
-               pg = m_pSwarm[m_BestIdx].b[j];
-
-               //random weights
-               r1 = (double)MyRand() / (double)MY_RAND_MAX;
-               r2 = (double)MyRand() / (double)MY_RAND_MAX;
-
-               //revised velocity
-               v = m_pSwarm[i].v[j];
-               v = m_Constrict*((m_Inertia*v) + m_c1*r1*(pl-x) + m_c2*r2*(pg-x));
-
-   			   //assign minimum perturbation to prevent stagnation
-	   		   if(strcmp(pGroup->GetParamPtr(j)->GetType(), "real") == 0)
-		   		 vmin = (0.01*fabs(x))/(g+1); 
-			      else
-				    vmin = 0.50;
-
-               if(fabs(v) < vmin)
-               {
-                  //adjust randomized minimum velocity
-                  sgn = (double)MyRand() / (double)MY_RAND_MAX; //random direction
-                  if(sgn >= 0.50) v = +((1.00+r1)*vmin);
-                  else            v = -((1.00+r2)*vmin);
-               }
-               m_pSwarm[i].v[j] = v;
-            
-               //revised position
-               m_pSwarm[i].x[j] = x + v;
-            }/* end for() */
-
-            /*-----------------------------------------------------------
-            Constrain revised position to stay within parameter limits
-            but be sure to preserve angle (i.e. direction of movement)
-            -----------------------------------------------------------*/
-            double dx_min, dx_old, dx_new, dx_frac;
-            dx_min = 1.00;
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               lwr = pGroup->GetParamPtr(j)->GetLwrBnd();
-               upr = pGroup->GetParamPtr(j)->GetUprBnd();
-
-               v = m_pSwarm[i].v[j];
-               x = m_pSwarm[i].x[j] - v; //original position
-               //compute fractional move, store most restrictive fraction
-               if(m_pSwarm[i].x[j] > upr)
-               {
-                  dx_old = v;
-                  dx_new = 0.5*(upr-x);
-                  dx_frac = fabs(dx_new/dx_old); //relative change
-                  if(dx_frac < dx_min) dx_min = dx_frac;
-                  m_NumUprViols++;
-               }
-               if(m_pSwarm[i].x[j] < lwr)
-               {
-                  dx_old = v;
-                  dx_new = 0.5*(lwr-x);
-                  dx_frac = fabs(dx_new/dx_old); //relative change
-                  if(dx_frac < dx_min) dx_min = dx_frac;
-                  m_NumLwrViols++;
-               }
-            }/* end for() */
-            for(j = 0; j < num; j++) //for each parameter
-            {
-               v = m_pSwarm[i].v[j];
-               x = m_pSwarm[i].x[j] - v; //original position      
-               m_pSwarm[i].v[j] *= dx_min; //revised velocity
-               m_pSwarm[i].x[j] = x + (v*dx_min); //revised position
-            }
-         }/* end for() */
-      } /* end if() */
+         m_pSwarm->Move(g, m_BestIdx, m_Constrict, m_Inertia, m_c1, m_c2);
+      }
 
       //evaluate swarm, possibly in parallel
       EvaluateSwarm();
@@ -523,35 +447,13 @@ void ParticleSwarm::Optimize(void)
       //fprintf(pWgt, "Inertia = %E, Cognitive = %E, Social = %E\n", m_Inertia, m_c1, m_c2);
       //fclose(pWgt);
    
-      //revise avg, and local and global best
-      avg = 0.00;
-      for(i = 0; i < m_SwarmSize; i++)
-      {
-         avg += m_pSwarm[i].fx;
-         //revise local best
-         if(m_pSwarm[i].fx < m_pSwarm[i].fb)
-         {
-            for(j = 0; j < num; j++){ m_pSwarm[i].b[j] = m_pSwarm[i].x[j];}
-            m_pSwarm[i].fb = m_pSwarm[i].fx;
-
-            for(int iSpecial = 0; iSpecial < nSpecial; iSpecial++)
-            {
-			      m_pSwarm[i].cb[iSpecial] = m_pSwarm[i].cx[iSpecial];
-            }
-         }/* end if() */
-         //revise global best
-         if(m_Best > m_pSwarm[i].fx)
-         {
-            m_Best = m_pSwarm[i].fx;
-            m_BestIdx = i;
-         }/* end if() */
-      }/* end for() */
+      //revise local and global best
+      m_pSwarm->UpdateBest(&m_BestIdx, &m_Best);
 
-      avg /= m_SwarmSize;
       median = CalcPSOMedian();
       //current convergence value
       m_CurStop = fabs((median - m_Best)/median);
-      pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
+      pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
 
       if(id == 0){ WriteRecord(m_pModel, (g+1), m_Best, m_CurStop);}
       pStatus.pct = ((float)100.00*(float)(g+1))/(float)m_MaxGens;
@@ -560,12 +462,27 @@ void ParticleSwarm::Optimize(void)
 
       //perform intermediate bookkeeping
       m_pModel->Bookkeep(false);
+
+      if((m_pCkpt != NULL) && (m_pCkpt->IsDue() == true))
+      {
+         m_pCkpt->Begin();
+         m_pCkpt->WriteInt(g+1);
+         m_pCkpt->WriteDouble(init);
+         m_pCkpt->WriteDouble(m_Inertia);
+         m_pCkpt->WriteDouble(m_RedRate);
+         m_pCkpt->WriteInt(m_BestIdx);
+         m_pCkpt->WriteDouble(m_Best);
+         m_pCkpt->WriteDouble(m_CurStop);
+         m_pCkpt->WriteDouble(m_BudgetFrac);
+         m_pSwarm->WriteCheckpoint(m_pCkpt);
+         m_pCkpt->End();
+      }
    }/* end for() */
 
    m_Inertia = init; //reset inertia
 
    //place model at optimal prameter set
-   pGroup->WriteParams(m_pSwarm[m_BestIdx].b);
+   pGroup->WriteParams(m_pSwarm->GetB(m_BestIdx));
    m_pModel->Execute();
 
    //perform final bookkeeping
@@ -611,8 +528,12 @@ void ParticleSwarm::WriteMetrics(FILE * pFile)
    else { fprintf(pFile, "Unknown\n");}
 
    //fprintf(pFile, "Total Evals             : %d\n", m_pModel->GetCounter());      
-   fprintf(pFile, "Upper Violations        : %d\n", m_NumUprViols);
-   fprintf(pFile, "Lower Violations        : %d\n", m_NumLwrViols);
+   if(m_pSwarm != NULL)
+   {
+      fprintf(pFile, "Upper Violations        : %d\n", m_pSwarm->GetNumUprViols());
+      fprintf(pFile, "Lower Violations        : %d\n", m_pSwarm->GetNumLwrViols());
+   }
+   if(m_pCkpt != NULL) m_pCkpt->WriteMetrics(pFile);
 
    m_pModel->WriteMetrics(pFile);
    if(m_CurStop <= m_StopVal)
@@ -632,10 +553,10 @@ Evaluates the objective function of each particle in the swarm.
 ******************************************************************************/
 void ParticleSwarm::EvaluateSwarm(void)
 {
-   static double a = 0.00;
    int i, n, id;   
    ParameterGroup * pGroup;
    double val;
+   ProfileScope algScope(PROF_ALG_EVAL);
 
    MPI_Comm_size(MPI_COMM_WORLD, &n);
    MPI_Comm_rank(MPI_COMM_WORLD, &id);
@@ -649,15 +570,15 @@ void ParticleSwarm::EvaluateSwarm(void)
          for(i = 0; i < m_SwarmSize; i++) 
          { 
             WriteInnerEval(i+1, m_SwarmSize, '.');
-            MakeParameterCorrections(m_pSwarm[i].x, m_pSwarm[m_BestIdx].b, m_pModel->GetParamGroupPtr()->GetNumParams(), a);
+            MakeParameterCorrections(m_pSwarm->GetX(i), m_pSwarm->GetB(m_BestIdx), m_pModel->GetParamGroupPtr()->GetNumParams(), m_BudgetFrac);
 
 			   //let special parameters know about local best
-			   pGroup->ConfigureSpecialParams(m_pSwarm[i].fb, m_pSwarm[i].cb);
+			   pGroup->ConfigureSpecialParams(m_pSwarm->GetFb(i), m_pSwarm->GetCb(i));
 
             val = m_pModel->Execute();
-            a += 1.00/(double)(m_SwarmSize*(m_MaxGens+1));
-            m_pSwarm[i].fx = val;
-			   pGroup->GetSpecialConstraints(m_pSwarm[i].cx);
+            m_BudgetFrac += 1.00/(double)(m_SwarmSize*(m_MaxGens+1));
+            m_pSwarm->SetFx(i, val);
+			   pGroup->GetSpecialConstraints(m_pSwarm->GetCx(i));
          }
          WriteInnerEval(WRITE_ENDED, m_SwarmSize, '.');
       }
@@ -672,13 +593,19 @@ void ParticleSwarm::EvaluateSwarm(void)
       {
          for(i = 0; i < m_SwarmSize; i++) 
          { 
-            MakeParameterCorrections(m_pSwarm[i].x, m_pSwarm[m_BestIdx].b, m_pModel->GetParamGroupPtr()->GetNumParams(), a);
-            a += 1.00/(double)(m_SwarmSize*(m_MaxGens+1));
+            MakeParameterCorrections(m_pSwarm->GetX(i), m_pSwarm->GetB(m_BestIdx), m_pModel->GetParamGroupPtr()->GetNumParams(), m_BudgetFrac);
+            m_BudgetFrac += 1.00/(double)(m_SwarmSize*(m_MaxGens+1));
          }/* end for() */
       }/* end if() */
 
       BcastSwarm();
       EvalSwarmParallel();      
+
+      //share model runs with the surrogate engine of each processor
+      if(m_pModel->GetSurrogateEnginePtr() != NULL)
+      {
+         m_pModel->GetSurrogateEnginePtr()->Synchronize();
+      }
    }/* end else() */
 } /* end EvaluateSwarm() */
 
@@ -713,54 +640,16 @@ BcastSwarm()
 When in parallel, only the master computes the swarm movement. All the other 
 processors just compute the objeective functions. The BcastSwarm() routine is 
 called upon to broadcast  the current particle swarm from the master processor 
-to all of the slave processors.
+to all of the slave processors. The position matrix is contiguous, so it is 
+broadcast in place.
 ******************************************************************************/
 void ParticleSwarm::BcastSwarm(void)
 {
-   int num_vars, pop_size, buf_size;
-   int i, j, num_procs, id, idx;
-
-   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
-   MPI_Comm_rank(MPI_COMM_WORLD, &id);
-
-   //size the flattened variable matrix
-   pop_size = m_SwarmSize;
-   num_vars = m_pSwarm[0].n;
-
-   buf_size = pop_size*num_vars;
-
-   if(m_pBuf == NULL)
-   {
-      NEW_PRINT("double", buf_size);
-      m_pBuf = new double[buf_size];
-      MEM_CHECK(m_pBuf);
-   }
-
-   for(i = 0; i < buf_size; i++){ m_pBuf[i] = 999.99;}
-
-   //fill up the flattened matrix
-   for(i = 0; i < num_vars; i++)
-   {
-      for(j = 0; j < pop_size; j++)
-      {
-         idx = (num_vars)*j + i;
-         m_pBuf[idx] = m_pSwarm[j].x[i];
-      }/* end for() */
-   }/* end for() */
+   int buf_size;
 
-   //broadcast the flattened matrix
-   MPI_Bcast(m_pBuf, buf_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   buf_size = m_SwarmSize*m_pSwarm->GetNumParams();
 
-   //use the flattened matrix to fill swarm
-   for(i = 0; i < num_vars; i++)
-   {
-      for(j = 0; j < pop_size; j++)
-      {
-         
-         idx = (num_vars)*j + i;
-         m_pSwarm[j].x[i] = m_pBuf[idx];
-      }/* end for() */
-   }/* end for() */
+   MPI_Bcast(m_pSwarm->GetPositions(), buf_size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 }/* end BcastSwarm() */
 
 /******************************************************************************
@@ -801,10 +690,10 @@ void ParticleSwarm::EvalSwarmParallel(void)
    { 
       if((i % num_procs) == id)
       {          
-         pGroup->WriteParams(m_pSwarm[i].x);
+         pGroup->WriteParams(m_pSwarm->GetX(i));
 
 		   //let special parameters know about local best
-		   pGroup->ConfigureSpecialParams(m_pSwarm[i].fb, m_pSwarm[i].cb);
+		   pGroup->ConfigureSpecialParams(m_pSwarm->GetFb(i), m_pSwarm->GetCb(i));
 
          m_pMyBuf[j] = m_pModel->Execute();
          m_pTmpBuf[j] = m_pMyBuf[j];
@@ -831,10 +720,7 @@ void ParticleSwarm::EvalSwarmParallel(void)
    }/* end for() */
 
    //stuff results into swarm
-   for(i = 0; i < m_SwarmSize; i++)
-   {
-      m_pSwarm[i].fx = m_pBigBuf[i];
-   }/* end for() */
+   memcpy(m_pSwarm->GetObjFuncs(), m_pBigBuf, sizeof(double)*m_SwarmSize);
 }/* end EvalSwarmParallel() */
 
 /******************************************************************************
@@ -847,7 +733,6 @@ evaluations to SuperMUSE clients on a first-come-first-served basis.
 void ParticleSwarm::EvalSwarmSuperMUSE(void)
 {  
    double val;
-   bool bOk; 
    int i;
    ParameterGroup * pGroup;
    SuperMUSE * pSMUSE = GetSuperMusePtr();
@@ -866,7 +751,7 @@ void ParticleSwarm::EvalSwarmSuperMUSE(void)
    for(i = 0; i < m_SwarmSize; i++)
    {
       //stuff the parameter group with values
-      pGroup->WriteParams(m_pSwarm[i].x);
+      pGroup->WriteParams(m_pSwarm->GetX(i));
          
       //pass group to supermuse
       pSMUSE->WriteTask(pGroup);
@@ -875,32 +760,31 @@ void ParticleSwarm::EvalSwarmSuperMUSE(void)
    //Finish task file (this will cause RepeatTasker to begin processing the job)
    pSMUSE->FinishTaskFile();
 
-   //wait for SuperMUSE to report back (via the success or error files)
-   bOk = pSMUSE->WaitForTasker();
-
-   if(bOk == false) //SuperMUSE failed
+   /* ----------------------------------------------------------------
+   Gather each result as soon as its task completes, in order of 
+   completion, instead of waiting for the whole job.
+   ---------------------------------------------------------------- */
+   while((i = pSMUSE->WaitForNextTask()) >= 0)
+   {
+      /* -----------------------------------------------
+      Stuff the parameter group with ith swarm 
+      member. This ensures that each objective function 
+      gets associated with the correct parameter values.
+      ------------------------------------------------ */
+      pGroup->WriteParams(m_pSwarm->GetX(i));
+
+      //stuff i-th result into chromosome pool
+      val = pSMUSE->GatherResult(i);
+      m_pSwarm->SetFx(i, val);
+      pGroup->GetSpecialConstraints(m_pSwarm->GetCx(i));
+   }/* end while() */
+
+   if(i == SMUSE_JOB_FAILED) //SuperMUSE failed
    {
       LogError(ERR_SMUSE, "Reverting to serial execution.");
       DisableSuperMUSE();
       EvaluateSwarm();
    }
-   else //SuperMUSE was successful
-   {
-      for(i = 0; i < m_SwarmSize; i++)
-      {
-         /* -----------------------------------------------
-         Stuff the parameter group with ith swarm 
-         member. This ensures that each objective function 
-         gets associated with the correct parameter values.
-         ------------------------------------------------ */
-         pGroup->WriteParams(m_pSwarm[i].x);
-
-         //stuff i-th result into chromosome pool
-         val = pSMUSE->GatherResult(i);
-         m_pSwarm[i].fx = val;
-		   pGroup->GetSpecialConstraints(m_pSwarm[i].cx);
-      }/* end for() */
-   }/* end else() */
 }/* end EvalSwarmSuperMUSE() */
 
 /******************************************************************************
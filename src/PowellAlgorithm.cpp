@@ -16,6 +16,8 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel. 
+10-19-26    lsm   added concurrent line searches (ParallelDirections)
+10-19-26    lsm   processors agree on early termination (IsQuitAll())
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -28,6 +30,7 @@ Version History
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
 #include "OptSearchClass.h"
+#include "ModelBackup.h"
 #include "StatsClass.h"
 
 #include "Utility.h"
@@ -61,6 +64,7 @@ PowellAlgorithm::PowellAlgorithm(ModelABC * pModel)
    FILE * inFile;
    char * line;
    char tmp[DEF_STR_SZ];
+   char yesno[DEF_STR_SZ];
 
    RegisterAlgPtr(this);
    IroncladString pFileName = GetInFileName();
@@ -73,6 +77,16 @@ PowellAlgorithm::PowellAlgorithm(ModelABC * pModel)
    m_NumRestarts = 0;
    m_NumUprViols = 0;
    m_NumLwrViols = 0;
+   m_NumJacobi = 0;
+   m_bConcurrent = false;
+   m_pBase = NULL;
+   m_pBest = NULL;
+   m_pSteps = NULL;
+   m_pAllSteps = NULL;
+   m_pStepF = NULL;
+   m_pAllStepF = NULL;
+   m_pDir = NULL;
+   m_pTrial = NULL;
 
    m_pModel = pModel;
    pGroup = m_pModel->GetParamGroupPtr();
@@ -117,6 +131,15 @@ PowellAlgorithm::PowellAlgorithm(ModelABC * pModel)
          {
             sscanf(line, "%s %d", tmp, &m_MaxIter);
          }
+         else if(strstr(line, "ParallelDirections") != NULL)
+         {
+            sscanf(line, "%s %s", tmp, yesno);
+            MyStrLwr(yesno);
+            if(strcmp(yesno, "yes") == 0)
+            {
+               m_bConcurrent = true;
+            }
+         }
 
          line = GetNxtDataLine(inFile, pFileName);
       }/* end while() */
@@ -128,6 +151,27 @@ PowellAlgorithm::PowellAlgorithm(ModelABC * pModel)
 
    fclose(inFile);
 
+   if(m_bConcurrent == true)
+   {
+      NEW_PRINT("ModelBackup", 1);
+      m_pBase = new ModelBackup(pModel);
+      NEW_PRINT("ModelBackup", 1);
+      m_pBest = new ModelBackup(pModel);
+      NEW_PRINT("double", m_NumDirs*m_NumDirs);
+      m_pSteps = new double[m_NumDirs*m_NumDirs];
+      NEW_PRINT("double", m_NumDirs*m_NumDirs);
+      m_pAllSteps = new double[m_NumDirs*m_NumDirs];
+      NEW_PRINT("double", m_NumDirs);
+      m_pStepF = new double[m_NumDirs];
+      NEW_PRINT("double", m_NumDirs);
+      m_pAllStepF = new double[m_NumDirs];
+      NEW_PRINT("double", m_NumDirs);
+      m_pDir = new double[m_NumDirs];
+      NEW_PRINT("double", m_NumDirs);
+      m_pTrial = new double[m_NumDirs];
+      MEM_CHECK(m_pTrial);
+   }/* end if() */
+
    IncCtorCount();
 }/* end default CTOR */
 
@@ -145,10 +189,186 @@ void PowellAlgorithm::Destroy(void)
 
    delete m_pStats;
    delete m_pSearch;
+   delete m_pBase;
+   delete m_pBest;
+   delete [] m_pSteps;
+   delete [] m_pAllSteps;
+   delete [] m_pStepF;
+   delete [] m_pAllStepF;
+   delete [] m_pDir;
+   delete [] m_pTrial;
 
    IncDtorCount();
 }/* end Destroy() */
 
+/******************************************************************************
+ConcurrentSearch()
+
+Perform the line searches along all directions of the set from the same point,
+X, with objective function value Fcur. The directions are spread over the
+processors (or searched in turn by a single processor), and each processor
+works on its own copy of the model, starting every search from a snapshot of X.
+
+Each direction whose step improves on X is replaced by that step, as in the 
+sequential algorithm. The steps are then combined Jacobi-style: X moves to the
+better of the best single step and the sum of all improving steps, if either 
+improves on X. The best single step is shared by the processor that made it, 
+as a snapshot of its model.
+
+Returns the objective function value at the (updated) point X.
+******************************************************************************/
+double PowellAlgorithm::ConcurrentSearch(double * X, double Fcur, double * upr, double * lwr)
+{
+   int i, j, n, id, nprocs, best, nimp;
+   double max, tmp, x, xmin, fmin, Ftmp, Fbest, Fnew;
+   double * pmin, * Scur;
+   ParameterGroup * pGroup;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   n = m_NumDirs;
+   pGroup = m_pModel->GetParamGroupPtr();
+   Scur = m_pDir;
+   pmin = m_pTrial;
+
+   m_pBase->Store();
+   Fbest = Fcur;
+   for(i = 0; i < n*n; i++){ m_pSteps[i] = 0.00;}
+   for(i = 0; i < n; i++){ m_pStepF[i] = 0.00;}
+
+   //line searches of this processor, run without the other processors
+   m_pSearch->SetLocal(true);
+   for(i = id; i < n; i += nprocs)
+   {
+      //current direction, normalized so that largest value is 1.00
+      max = 0.00;
+      for(j = 0; j < n; j++)
+      { 
+         Scur[j] = m_pSearchDirs[i][j];
+         tmp = fabs(Scur[j]);
+         if(tmp > max) { max = tmp;}
+      }/* end for() */
+      if(max > NEARLY_ZERO)
+      {
+         for(j = 0; j < n; j++) { Scur[j] /= max;}
+      }
+      else
+      {
+         for(j = 0; j < n; j++) { Scur[j] = 0.00;}
+         Scur[i] = 1.00;
+      }
+
+      //line minimization from X
+      m_pBase->SemiRestore();
+      fmin = Fcur;
+      xmin = m_pSearch->CalcStepSize(Scur, &fmin, pmin);
+
+      for(j = 0; j < n; j++)
+      {
+         x = X[j] + Scur[j]*xmin;
+         //if it's out of bounds, move half the distance to upr/lwr
+         if(x > upr[j]){x = (upr[j]+X[j])/2.00; m_NumUprViols++;}
+         if(x < lwr[j]){x = (X[j]+lwr[j])/2.00; m_NumLwrViols++;}
+         Scur[j] = x;
+      }/* end for() */
+      pGroup->WriteParams(Scur);
+      Ftmp = m_pModel->Execute();
+      m_AlgCount++;
+
+      //found a better point when computing step size
+      if(fmin < Ftmp)
+      {
+         pGroup->WriteParams(pmin);
+         m_pModel->SetObjFuncVal(fmin);
+         for(j = 0; j < n; j++){ Scur[j] = pmin[j];}
+         Ftmp = fmin;
+      }/* end if() */
+
+      m_pStepF[i] = Ftmp;
+      if(Ftmp <= Fcur)
+      {
+         for(j = 0; j < n; j++){ m_pSteps[i*n+j] = Scur[j] - X[j];}
+      }
+      if(Ftmp < Fbest)
+      {
+         Fbest = Ftmp;
+         m_pBest->Store();
+      }
+   }/* end for() */
+   m_pSearch->SetLocal(false);
+
+   //share the steps
+   if(nprocs > 1)
+   {
+      MPI_Allreduce(m_pSteps, m_pAllSteps, n*n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(m_pStepF, m_pAllStepF, n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   }
+   else
+   {
+      for(i = 0; i < n*n; i++){ m_pAllSteps[i] = m_pSteps[i];}
+      for(i = 0; i < n; i++){ m_pAllStepF[i] = m_pStepF[i];}
+   }
+
+   //save the revised directions, and find the best step
+   best = -1;
+   nimp = 0;
+   Fnew = Fcur;
+   for(i = 0; i < n; i++)
+   {
+      if(m_pAllStepF[i] <= Fcur)
+      { 
+         for(j = 0; j < n; j++){ m_pSearchDirs[i][j] = m_pAllSteps[i*n+j];}
+         nimp++;
+      }
+      if(m_pAllStepF[i] < Fnew)
+      { 
+         Fnew = m_pAllStepF[i];
+         best = i;
+      }
+   }/* end for() */
+
+   //combined step
+   if(nimp > 1)
+   {
+      for(j = 0; j < n; j++)
+      {
+         x = X[j];
+         for(i = 0; i < n; i++){ x += m_pAllSteps[i*n+j];}
+         if(x > upr[j]){x = (upr[j]+X[j])/2.00; m_NumUprViols++;}
+         if(x < lwr[j]){x = (X[j]+lwr[j])/2.00; m_NumLwrViols++;}
+         Scur[j] = x;
+      }/* end for() */
+      pGroup->WriteParams(Scur);
+      Ftmp = m_pModel->Execute();
+      m_AlgCount++;
+      if(Ftmp < Fnew)
+      {
+         for(j = 0; j < n; j++){ X[j] = Scur[j];}
+         m_NumJacobi++;
+         return Ftmp;
+      }
+   }/* end if() */
+
+   //best single step, from the processor that made it
+   if(best >= 0)
+   {
+      if(nprocs > 1)
+      {
+         MPI_Bcast(m_pBest->GetBuffer(), m_pBest->GetBufferSize(), MPI_DOUBLE, 
+                   best % nprocs, MPI_COMM_WORLD);
+      }
+      m_pBest->SemiRestore();
+      pGroup->ReadParams(X);
+   }
+   else
+   {
+      m_pBase->SemiRestore();
+   }
+
+   return Fnew;
+}/* end ConcurrentSearch() */
+
 /******************************************************************************
 Optimize()
 
@@ -241,12 +461,18 @@ void PowellAlgorithm::Optimize(void)
    //main loop
    for(iter = 0; iter < m_MaxIter; iter++)
    {
-      if(IsQuit() == true){ break;}
+      if(IsQuitAll() == true){ break;}
 
       pStatus.curIter = m_CurIter = iter+1;
       
+      //search all directions at once
+      if(m_bConcurrent == true)
+      {
+         Fcur = ConcurrentSearch(X, Fcur, upr, lwr);
+      }
+
       //loop over all directions
-      for(i = 0; i < n; i++)
+      for(i = 0; (i < n) && (m_bConcurrent == false); i++)
       {
          //current direction
          for(j = 0; j < n; j++){ Scur[j] = S[i][j];} 
@@ -491,6 +717,11 @@ void PowellAlgorithm::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Alg. Restarts    : %d\n", m_NumRestarts);
    fprintf(pFile, "Upper Violations : %d\n", m_NumUprViols);
    fprintf(pFile, "Lower Violations : %d\n", m_NumLwrViols);   
+   if(m_bConcurrent == true)
+   {
+      fprintf(pFile, "Parallel Dirs    : yes\n");
+      fprintf(pFile, "Jacobi Moves     : %d\n", m_NumJacobi);
+   }
    m_pModel->WriteMetrics(pFile);
    m_pSearch->WriteMetrics(pFile);
 }/* end WriteMetrics() */
@@ -0,0 +1,341 @@
+/******************************************************************************
+File     : Profiler.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Lightweight timing of the phases of a model evaluation and of algorithm
+evaluation loops. See Profiler.h for configuration and output files.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added heap allocation counts of ProfileScope phases
+10-19-26    lsm   allocation counts are only reported if they were counted
+******************************************************************************/
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+#include "Profiler.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#ifdef _WIN32
+  #define MY_GETCWD _getcwd
+#else
+  #define MY_GETCWD getcwd
+#endif
+
+static const char * gProfNames[PROF_NUM_PHASES] =
+{
+   "Evaluate", "SubIntoFile", "Model", "ReadResponse", "ExtractVals",
+   "CalcObjFunc", "PreserveModel", "Write", "AlgEvaluate"
+};
+
+static bool gProfOn = false;
+static bool gProfInitialized = false;
+static int gProfRank = 0;
+static double gProfInterval = 60.00;
+static double gProfLastSummary = 0.00;
+static long gProfTraceLimit = 100000;
+static long gProfNumEvents = 0;
+static FILE * gProfTrace = NULL;
+static char gProfSummaryFile[DEF_STR_SZ];
+static std::chrono::steady_clock::time_point gProfOrigin;
+
+static long long gProfCount[PROF_NUM_PHASES];
+static double gProfTotal[PROF_NUM_PHASES];
+static double gProfMin[PROF_NUM_PHASES];
+static double gProfMax[PROF_NUM_PHASES];
+static long long gProfHist[PROF_NUM_PHASES][PROF_NUM_BINS];
+
+//heap allocations of ProfileScope phases
+static long long gProfAllocScopes[PROF_NUM_PHASES];
+static long long gProfAllocTotal[PROF_NUM_PHASES];
+static long long gProfAllocMax[PROF_NUM_PHASES];
+static long long gProfAllocZero[PROF_NUM_PHASES];
+static long long gProfAllocLast[PROF_NUM_PHASES];
+
+/******************************************************************************
+ProfilerNow()
+
+Seconds since the profiler was initialized.
+******************************************************************************/
+static double ProfilerNow(void)
+{
+   std::chrono::duration<double> t = std::chrono::steady_clock::now() - gProfOrigin;
+   return t.count();
+} /* end ProfilerNow() */
+
+/******************************************************************************
+ProfilerInit()
+
+Read the profiling configuration from the main section of the input file and,
+if profiling is enabled, open the trace file. Only the first call has any
+effect, so each model may call this function.
+******************************************************************************/
+void ProfilerInit(IroncladString pFileName)
+{
+   FILE * pFile;
+   char * line;
+   char tmp[DEF_STR_SZ];
+   char yesno[DEF_STR_SZ];
+   char cwd[DEF_STR_SZ];
+   char traceFile[DEF_STR_SZ];
+   int i, j;
+
+   if(gProfInitialized == true) return;
+   gProfInitialized = true;
+
+   pFile = fopen(pFileName, "r");
+   if(pFile == NULL) return;
+
+   if(CheckToken(pFile, "ProfileEvaluations", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      sscanf(line, "%s %s", tmp, yesno);
+      MyStrLwr(yesno);
+      if(strcmp(yesno, "yes") == 0) gProfOn = true;
+   }
+   rewind(pFile);
+   if(CheckToken(pFile, "ProfileSummaryInterval", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      sscanf(line, "%s %lf", tmp, &gProfInterval);
+   }
+   rewind(pFile);
+   if(CheckToken(pFile, "ProfileTraceLimit", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      sscanf(line, "%s %ld", tmp, &gProfTraceLimit);
+   }
+   fclose(pFile);
+
+   if(gProfOn == false) return;
+
+   for(i = 0; i < PROF_NUM_PHASES; i++)
+   {
+      gProfCount[i] = 0;
+      gProfTotal[i] = 0.00;
+      gProfMin[i] = NEARLY_HUGE;
+      gProfMax[i] = 0.00;
+      for(j = 0; j < PROF_NUM_BINS; j++) gProfHist[i][j] = 0;
+      gProfAllocScopes[i] = 0;
+      gProfAllocTotal[i] = 0;
+      gProfAllocMax[i] = 0;
+      gProfAllocZero[i] = 0;
+      gProfAllocLast[i] = 0;
+   }
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &gProfRank);
+   gProfOrigin = std::chrono::steady_clock::now();
+   gProfLastSummary = 0.00;
+   gProfNumEvents = 0;
+
+   //models are run in subdirectories, so use absolute paths
+   if(MY_GETCWD(cwd, DEF_STR_SZ - 32) == NULL) strcpy(cwd, ".");
+   snprintf(gProfSummaryFile, DEF_STR_SZ, "%s/OstProfile%d.txt", cwd, gProfRank);
+   snprintf(traceFile, DEF_STR_SZ, "%s/OstTrace%d.json", cwd, gProfRank);
+
+   gProfTrace = NULL;
+   if(gProfTraceLimit > 0)
+   {
+      gProfTrace = fopen(traceFile, "w");
+      if(gProfTrace == NULL)
+      {
+         LogError(ERR_FILE_IO, "Couldn't open profiler trace file");
+      }
+      else
+      {
+         fprintf(gProfTrace, "[\n");
+         fprintf(gProfTrace, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"rank %d\"}}",
+                 gProfRank, gProfRank);
+      }
+   }/* end if() */
+} /* end ProfilerInit() */
+
+/******************************************************************************
+ProfilerIsEnabled()
+******************************************************************************/
+bool ProfilerIsEnabled(void)
+{
+   return gProfOn;
+} /* end ProfilerIsEnabled() */
+
+/******************************************************************************
+ProfilerStart()
+
+Returns the start time of a phase, or zero if profiling is disabled.
+******************************************************************************/
+double ProfilerStart(void)
+{
+   if(gProfOn == false) return 0.00;
+   return ProfilerNow();
+} /* end ProfilerStart() */
+
+/******************************************************************************
+ProfilerStop()
+
+Record the duration of a phase that began at the given start time.
+******************************************************************************/
+void ProfilerStop(int phase, double start)
+{
+   double stop, dt, us;
+   int bin;
+
+   if(gProfOn == false) return;
+
+   stop = ProfilerNow();
+   dt = stop - start;
+
+   gProfCount[phase]++;
+   gProfTotal[phase] += dt;
+   if(dt < gProfMin[phase]) gProfMin[phase] = dt;
+   if(dt > gProfMax[phase]) gProfMax[phase] = dt;
+
+   //bin 0 holds durations below 1 us, bin k holds [2^(k-1), 2^k) us
+   us = dt * 1E6;
+   bin = 0;
+   while((us >= 1.00) && (bin < (PROF_NUM_BINS - 1)))
+   {
+      us *= 0.50;
+      bin++;
+   }
+   gProfHist[phase][bin]++;
+
+   if((gProfTrace != NULL) && (gProfNumEvents < gProfTraceLimit))
+   {
+      fprintf(gProfTrace, ",\n{\"name\":\"%s\",\"cat\":\"ostrich\",\"ph\":\"X\",\"ts\":%.3lf,\"dur\":%.3lf,\"pid\":%d,\"tid\":0}",
+              gProfNames[phase], start*1E6, dt*1E6, gProfRank);
+      gProfNumEvents++;
+   }
+
+   if((stop - gProfLastSummary) >= gProfInterval)
+   {
+      gProfLastSummary = stop;
+      ProfilerWriteSummary();
+   }
+} /* end ProfilerStop() */
+
+/******************************************************************************
+ProfilerCountAllocs()
+
+Record the number of heap allocations made by a ProfileScope.
+******************************************************************************/
+void ProfilerCountAllocs(int phase, long long numAllocs)
+{
+   if(gProfOn == false) return;
+
+   gProfAllocScopes[phase]++;
+   gProfAllocTotal[phase] += numAllocs;
+   if(numAllocs > gProfAllocMax[phase]) gProfAllocMax[phase] = numAllocs;
+   if(numAllocs == 0) gProfAllocZero[phase]++;
+   gProfAllocLast[phase] = numAllocs;
+} /* end ProfilerCountAllocs() */
+
+/******************************************************************************
+ProfilerPercentile()
+
+Approximate percentile (upper edge of the histogram bin, in seconds).
+******************************************************************************/
+static double ProfilerPercentile(int phase, double pct)
+{
+   long long cum, target;
+   int bin;
+
+   target = (long long)(pct * (double)gProfCount[phase]);
+   if(target < 1) target = 1;
+   cum = 0;
+   for(bin = 0; bin < PROF_NUM_BINS; bin++)
+   {
+      cum += gProfHist[phase][bin];
+      if(cum >= target) break;
+   }
+   if(bin >= PROF_NUM_BINS) bin = PROF_NUM_BINS - 1;
+   return ldexp(1.00, bin) * 1E-6;
+} /* end ProfilerPercentile() */
+
+/******************************************************************************
+ProfilerWriteSummary()
+
+Rewrite the per-phase summary file.
+******************************************************************************/
+void ProfilerWriteSummary(void)
+{
+   FILE * pFile;
+   int i, bin;
+   double mean, lwr;
+
+   if(gProfOn == false) return;
+
+   pFile = fopen(gProfSummaryFile, "w");
+   if(pFile == NULL) return;
+
+   fprintf(pFile, "Ostrich Evaluation Profile for Processor %d\n", gProfRank);
+   fprintf(pFile, "Elapsed Time (sec) : %.3lf\n", ProfilerNow());
+   fprintf(pFile, "Trace Events       : %ld\n\n", gProfNumEvents);
+   fprintf(pFile, "%-14s  %10s  %12s  %12s  %12s  %12s  %12s  %12s  %12s\n",
+           "Phase", "Count", "Total(s)", "Mean(s)", "Min(s)", "Max(s)", "~P50(s)", "~P90(s)", "~P99(s)");
+   for(i = 0; i < PROF_NUM_PHASES; i++)
+   {
+      if(gProfCount[i] == 0) continue;
+      mean = gProfTotal[i] / (double)gProfCount[i];
+      fprintf(pFile, "%-14s  %10lld  %12.6lf  %12.6E  %12.6E  %12.6E  %12.6E  %12.6E  %12.6E\n",
+              gProfNames[i], gProfCount[i], gProfTotal[i], mean, gProfMin[i], gProfMax[i],
+              ProfilerPercentile(i, 0.50), ProfilerPercentile(i, 0.90), ProfilerPercentile(i, 0.99));
+   }
+
+   fprintf(pFile, "\nHeap Allocations (calls to operator new)\n");
+   if(GetNumAllocs() < 0)
+   {
+      fprintf(pFile, "not counted (compile with -DOSTRICH_COUNT_ALLOCS)\n");
+   }
+   else
+   {
+      fprintf(pFile, "%-14s  %10s  %12s  %12s  %12s  %12s  %12s\n",
+              "Phase", "Count", "Total", "Mean", "Max", "Last", "Zero-Alloc");
+   }
+   for(i = 0; i < PROF_NUM_PHASES; i++)
+   {
+      if(gProfAllocScopes[i] == 0) continue;
+      mean = (double)gProfAllocTotal[i] / (double)gProfAllocScopes[i];
+      fprintf(pFile, "%-14s  %10lld  %12lld  %12.3lf  %12lld  %12lld  %12lld\n",
+              gProfNames[i], gProfAllocScopes[i], gProfAllocTotal[i], mean,
+              gProfAllocMax[i], gProfAllocLast[i], gProfAllocZero[i]);
+   }
+
+   fprintf(pFile, "\nHistograms (count of durations in [lower, upper) microseconds)\n");
+   for(i = 0; i < PROF_NUM_PHASES; i++)
+   {
+      if(gProfCount[i] == 0) continue;
+      fprintf(pFile, "%s\n", gProfNames[i]);
+      for(bin = 0; bin < PROF_NUM_BINS; bin++)
+      {
+         if(gProfHist[i][bin] == 0) continue;
+         lwr = (bin == 0) ? 0.00 : ldexp(1.00, bin - 1);
+         fprintf(pFile, "   %14.0lf  %14.0lf  %10lld\n", lwr, ldexp(1.00, bin), gProfHist[i][bin]);
+      }
+   }
+   fclose(pFile);
+} /* end ProfilerWriteSummary() */
+
+/******************************************************************************
+ProfilerFinalize()
+
+Write the final summary and close the trace file.
+******************************************************************************/
+void ProfilerFinalize(void)
+{
+   if(gProfOn == false) return;
+
+   ProfilerWriteSummary();
+   if(gProfTrace != NULL)
+   {
+      fprintf(gProfTrace, "\n]\n");
+      fclose(gProfTrace);
+      gProfTrace = NULL;
+   }
+   gProfOn = false;
+} /* end ProfilerFinalize() */
@@ -0,0 +1,339 @@
+/******************************************************************************
+File      : QuasiRandom.cpp
+Author    : L. Shawn Matott
+Copyright : 2026, L. Shawn Matott
+
+Encapsulates an index-addressable low-discrepancy (quasi-random) sequence.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added Sobol sequence with digital shift scrambling
+******************************************************************************/
+#include <mpi.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "QuasiRandom.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+/******************************************************************************
+Destroy()
+******************************************************************************/
+void QuasiRandom::Destroy(void)
+{
+   delete [] m_pBases;
+   delete [] m_pShift;
+   delete [] m_pDirs;
+   delete [] m_pXor;
+   m_pBases = NULL;
+   m_pShift = NULL;
+   m_pDirs = NULL;
+   m_pXor = NULL;
+   m_Dim = 0;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+CTOR
+
+Halton sequence. If bScramble is true, each dimension is also assigned a
+random shift.
+******************************************************************************/
+QuasiRandom::QuasiRandom(int dim, bool bScramble)
+{
+   Init(dim, QMC_HALTON, bScramble);
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+CTOR
+
+Halton (QMC_HALTON) or Sobol (QMC_SOBOL) sequence.
+******************************************************************************/
+QuasiRandom::QuasiRandom(int dim, int type, bool bScramble)
+{
+   Init(dim, type, bScramble);
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Init()
+******************************************************************************/
+void QuasiRandom::Init(int dim, int type, bool bScramble)
+{
+   m_Dim = dim;
+   m_Type = type;
+   m_bScramble = bScramble;
+   m_pBases = NULL;
+   m_pShift = NULL;
+   m_pDirs = NULL;
+   m_pXor = NULL;
+
+   if(type == QMC_SOBOL)
+   {
+      InitSobol(bScramble);
+   }
+   else
+   {
+      m_Type = QMC_HALTON;
+      InitHalton(bScramble);
+   }
+} /* end Init() */
+
+/******************************************************************************
+InitHalton()
+
+Assign one prime base to each dimension.
+******************************************************************************/
+void QuasiRandom::InitHalton(bool bScramble)
+{
+   int i, j, cand;
+   bool bPrime;
+
+   NEW_PRINT("int", m_Dim);
+   m_pBases = new int[m_Dim];
+   MEM_CHECK(m_pBases);
+
+   NEW_PRINT("double", m_Dim);
+   m_pShift = new double[m_Dim];
+   MEM_CHECK(m_pShift);
+
+   //first dim primes, by trial division
+   cand = 2;
+   for(i = 0; i < m_Dim; i++)
+   {
+      do
+      {
+         bPrime = true;
+         for(j = 0; j < i; j++)
+         {
+            if(m_pBases[j]*m_pBases[j] > cand) break;
+            if((cand % m_pBases[j]) == 0){ bPrime = false; break;}
+         }
+         if(bPrime == false) cand++;
+      }while(bPrime == false);
+      m_pBases[i] = cand;
+      cand++;
+   }/* end for() */
+
+   for(i = 0; i < m_Dim; i++)
+   {
+      m_pShift[i] = 0.00;
+      if(bScramble == true)
+      {
+         m_pShift[i] = (double)MyRand() / (double)MY_RAND_MAX;
+      }
+   }/* end for() */
+} /* end InitHalton() */
+
+/******************************************************************************
+IsPrimitive()
+
+Check whether the given polynomial over GF(2) is primitive. Bit k of poly is
+the coefficient of x^k, and the polynomial has the given degree. The
+polynomial is primitive if x has multiplicative order 2^degree - 1 modulo the
+polynomial, which is checked by stepping through the powers of x.
+******************************************************************************/
+bool QuasiRandom::IsPrimitive(unsigned int poly, int degree)
+{
+   unsigned int r, top, period, k;
+
+   if((poly & 1) == 0) return false;
+   if(degree == 1) return true;
+
+   top = 1u << degree;
+   period = top - 1;
+   r = 1;
+   for(k = 1; k <= period; k++)
+   {
+      r <<= 1;
+      if(r & top) r ^= poly;
+      if(r == 1) return (k == period);
+   }
+   return false;
+} /* end IsPrimitive() */
+
+/******************************************************************************
+InitSobol()
+
+Build the direction numbers. The first dimension is the van der Corput
+sequence. Each remaining dimension gets the next primitive polynomial, in
+order of increasing degree, and odd initial direction numbers m_k < 2^k drawn
+from a fixed linear congruential generator. The remaining direction numbers
+follow from the usual recurrence.
+******************************************************************************/
+void QuasiRandom::InitSobol(bool bScramble)
+{
+   int i, j, k, deg;
+   unsigned int poly, lcg, m, * pM, * pV;
+
+   NEW_PRINT("unsigned int", m_Dim * QMC_SOBOL_BITS);
+   m_pDirs = new unsigned int[m_Dim * QMC_SOBOL_BITS];
+   MEM_CHECK(m_pDirs);
+
+   NEW_PRINT("unsigned int", m_Dim);
+   m_pXor = new unsigned int[m_Dim];
+   MEM_CHECK(m_pXor);
+
+   NEW_PRINT("unsigned int", QMC_SOBOL_BITS);
+   pM = new unsigned int[QMC_SOBOL_BITS];
+   MEM_CHECK(pM);
+
+   //van der Corput
+   for(k = 0; k < QMC_SOBOL_BITS; k++)
+   {
+      m_pDirs[k] = 1u << (QMC_SOBOL_BITS - 1 - k);
+   }
+
+   lcg = 12345;
+   deg = 1;
+   poly = (1u << deg);
+   for(j = 1; j < m_Dim; j++)
+   {
+      //next primitive polynomial
+      do
+      {
+         poly++;
+         if(poly >= (2u << deg)){ deg++; poly = (1u << deg);}
+      }while(IsPrimitive(poly, deg) == false);
+
+      //initial direction numbers
+      for(k = 0; (k < deg) && (k < QMC_SOBOL_BITS); k++)
+      {
+         lcg = 1664525u*lcg + 1013904223u;
+         pM[k] = ((lcg >> 8) & ((1u << (k + 1)) - 1)) | 1u;
+      }
+
+      //recurrence
+      for(k = deg; k < QMC_SOBOL_BITS; k++)
+      {
+         m = pM[k - deg] ^ (pM[k - deg] << deg);
+         for(i = 1; i < deg; i++)
+         {
+            if((poly >> (deg - i)) & 1u)
+            {
+               m ^= (pM[k - i] << i);
+            }
+         }
+         pM[k] = m;
+      }
+
+      pV = &(m_pDirs[j * QMC_SOBOL_BITS]);
+      for(k = 0; k < QMC_SOBOL_BITS; k++)
+      {
+         pV[k] = pM[k] << (QMC_SOBOL_BITS - 1 - k);
+      }
+   }/* end for() */
+
+   delete [] pM;
+
+   for(j = 0; j < m_Dim; j++)
+   {
+      m_pXor[j] = 0;
+      if(bScramble == true)
+      {
+         m_pXor[j] = (MyRand() << 16) ^ MyRand();
+      }
+   }/* end for() */
+} /* end InitSobol() */
+
+/******************************************************************************
+BcastScramble()
+
+Each processor seeds its random number generator differently, so the master
+processor shares its random shifts to ensure that every processor generates
+the same sequence.
+******************************************************************************/
+void QuasiRandom::BcastScramble(void)
+{
+   if(m_Type == QMC_SOBOL)
+   {
+      MPI_Bcast(m_pXor, m_Dim, MPI_INT, 0, MPI_COMM_WORLD);
+   }
+   else
+   {
+      MPI_Bcast(m_pShift, m_Dim, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   }
+} /* end BcastScramble() */
+
+/******************************************************************************
+RadicalInverse()
+
+Reflect the base-b digits of idx about the radix point.
+******************************************************************************/
+double QuasiRandom::RadicalInverse(long long idx, int base)
+{
+   double inv, f, r;
+
+   inv = 1.00 / (double)base;
+   f = inv;
+   r = 0.00;
+   while(idx > 0)
+   {
+      r += (double)(idx % base) * f;
+      idx /= base;
+      f *= inv;
+   }
+   return r;
+} /* end RadicalInverse() */
+
+/******************************************************************************
+GetPoint()
+
+Compute point idx (0-based) of the sequence in the unit hypercube. The origin
+of the raw sequence is skipped, except for the scrambled Sobol sequence where
+it is no longer special and keeping it preserves the balance of the first 2^m
+points.
+******************************************************************************/
+void QuasiRandom::GetPoint(long long idx, double * pUnit)
+{
+   int j, k;
+   unsigned long long gray;
+   unsigned int x;
+   unsigned int * pV;
+   double u;
+
+   if(m_Type == QMC_SOBOL)
+   {
+      if(m_bScramble == false) idx++;
+      gray = (unsigned long long)idx ^ ((unsigned long long)idx >> 1);
+      for(j = 0; j < m_Dim; j++)
+      {
+         pV = &(m_pDirs[j * QMC_SOBOL_BITS]);
+         x = m_pXor[j];
+         for(k = 0; (k < QMC_SOBOL_BITS) && ((gray >> k) != 0); k++)
+         {
+            if((gray >> k) & 1) x ^= pV[k];
+         }
+         //midpoint of the finest cell, so that no coordinate is exactly 0
+         pUnit[j] = ((double)x + 0.5) / 4294967296.0;
+      }
+      return;
+   }/* end if() */
+
+   for(j = 0; j < m_Dim; j++)
+   {
+      u = RadicalInverse(idx + 1, m_pBases[j]) + m_pShift[j];
+      if(u >= 1.00) u -= 1.00;
+      pUnit[j] = u;
+   }
+} /* end GetPoint() */
+
+/******************************************************************************
+GetScaledPoint()
+
+Compute point idx (0-based) of the sequence, scaled to the given bounds.
+******************************************************************************/
+void QuasiRandom::GetScaledPoint(long long idx, Ironclad1DArray pLwr, Ironclad1DArray pUpr, double * pX)
+{
+   int j;
+
+   GetPoint(idx, pX);
+   for(j = 0; j < m_Dim; j++)
+   {
+      pX[j] = pLwr[j] + pX[j]*(pUpr[j] - pLwr[j]);
+   }
+} /* end GetScaledPoint() */
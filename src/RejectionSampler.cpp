@@ -460,7 +460,6 @@ evaluations to SuperMUSE clients on a first-come-first-served basis.
 void RejectionSampler::EvalSamplesSuperMUSE(void)
 {  
    double val;
-   bool bOk; 
    int i;
    ParameterGroup * pGroup;
    SuperMUSE * pSMUSE = GetSuperMusePtr();
@@ -488,31 +487,30 @@ void RejectionSampler::EvalSamplesSuperMUSE(void)
    //Finish task file (this will cause RepeatTasker to begin processing the job)
    pSMUSE->FinishTaskFile();
 
-   //wait for SuperMUSE to report back (via the success or error files)
-   bOk = pSMUSE->WaitForTasker();
+   /* ----------------------------------------------------------------
+   Gather each result as soon as its task completes, in order of 
+   completion, instead of waiting for the whole job.
+   ---------------------------------------------------------------- */
+   while((i = pSMUSE->WaitForNextTask()) >= 0)
+   {
+      /* -----------------------------------------------
+      Stuff the parameter group with ith sample 
+      result. This ensures that each objective function 
+      gets associated with the correct parameter values.
+      ------------------------------------------------ */
+      pGroup->WriteParams(m_pSamples[i].x);
 
-   if(bOk == false) //SuperMUSE failed
+      //stuff i-th result into result vector
+      val = pSMUSE->GatherResult(i);
+      m_pSamples[i].fx = val;
+   }/* end while() */
+
+   if(i == SMUSE_JOB_FAILED) //SuperMUSE failed
    {
       LogError(ERR_SMUSE, "Reverting to serial execution.");
       DisableSuperMUSE();
       EvaluateSamples();
    }
-   else //SuperMUSE was successful
-   {
-      for(i = 0; i < m_SamplesPerIter; i++)
-      {
-         /* -----------------------------------------------
-         Stuff the parameter group with ith sample 
-         result. This ensures that each objective function 
-         gets associated with the correct parameter values.
-         ------------------------------------------------ */
-         pGroup->WriteParams(m_pSamples[i].x);
-
-         //stuff i-th result into result vector
-         val = pSMUSE->GatherResult(i);
-         m_pSamples[i].fx = val;
-      }/* end for() */
-   }/* end else() */
 }/* end EvalSamplesSuperMUSE() */
 
 /******************************************************************************
@@ -0,0 +1,553 @@
+/******************************************************************************
+File     : ReplicaExchange.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+The ReplicaExchange class supports the parallel tempering (replica exchange)
+mode of the simulated annealing algorithms. See ReplicaExchange.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added TemperingABC, shared by SAAlgorithm and VandSA
+******************************************************************************/
+#include <mpi.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ReplicaExchange.h"
+#include "ModelABC.h"
+#include "ParameterGroup.h"
+
+#include "Utility.h"
+#include "WriteUtility.h"
+#include "Exception.h"
+
+/******************************************************************************
+CTOR
+
+Allocate storage for the replicas owned by this processor. The requested
+number of replicas is rounded up to a multiple of the number of processors.
+******************************************************************************/
+ReplicaExchange::ReplicaExchange(int numParams, int numReplicas, int auxSize)
+{
+   int i;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &m_NumProcs);
+
+   m_NumParams = numParams;
+   m_AuxSize = auxSize;
+   m_NumLocal = (numReplicas + m_NumProcs - 1) / m_NumProcs;
+   if(m_NumLocal < 1) m_NumLocal = 1;
+   m_Phase = 0;
+   m_Tcold = m_Thot = 1.00;
+   m_Fbest = NEARLY_HUGE;
+   m_NumAttempts = 0;
+   m_NumSwaps = 0;
+
+   NEW_PRINT("double", m_NumLocal);
+   m_pTemp = new double[m_NumLocal];
+   MEM_CHECK(m_pTemp);
+
+   NEW_PRINT("double", m_NumLocal);
+   m_pF = new double[m_NumLocal];
+   MEM_CHECK(m_pF);
+
+   NEW_PRINT("double *", m_NumLocal);
+   m_pParams = new double *[m_NumLocal];
+   MEM_CHECK(m_pParams);
+
+   NEW_PRINT("double *", m_NumLocal);
+   m_pAux = new double *[m_NumLocal];
+   MEM_CHECK(m_pAux);
+
+   for(i = 0; i < m_NumLocal; i++)
+   {
+      m_pTemp[i] = 1.00;
+      m_pF[i] = NEARLY_HUGE;
+
+      NEW_PRINT("double", m_NumParams);
+      m_pParams[i] = new double[m_NumParams];
+      MEM_CHECK(m_pParams[i]);
+
+      m_pAux[i] = NULL;
+      if(m_AuxSize > 0)
+      {
+         NEW_PRINT("double", m_AuxSize);
+         m_pAux[i] = new double[m_AuxSize];
+         MEM_CHECK(m_pAux[i]);
+      }
+   }/* end for() */
+
+   NEW_PRINT("double", m_NumParams);
+   m_pBest = new double[m_NumParams];
+   MEM_CHECK(m_pBest);
+
+   //message buffer: flag/obj. func., params and metrics
+   NEW_PRINT("double", m_NumParams + 3);
+   m_pMsg = new double[m_NumParams + 3];
+   MEM_CHECK(m_pMsg);
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Free up memory used by the replicas.
+******************************************************************************/
+void ReplicaExchange::Destroy(void)
+{
+   int i;
+
+   for(i = 0; i < m_NumLocal; i++)
+   {
+      delete [] m_pParams[i];
+      delete [] m_pAux[i];
+   }
+   delete [] m_pParams;
+   delete [] m_pAux;
+   delete [] m_pTemp;
+   delete [] m_pF;
+   delete [] m_pBest;
+   delete [] m_pMsg;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+LadderTemp()
+
+Temperature of the replica with global index g. Temperatures are spaced
+geometrically between the coldest and the hottest temperature.
+******************************************************************************/
+double ReplicaExchange::LadderTemp(int g)
+{
+   int R = GetNumReplicas();
+
+   if(R <= 1) return m_Tcold;
+   return m_Tcold*pow(m_Thot/m_Tcold, (double)g/(double)(R - 1));
+} /* end LadderTemp() */
+
+/******************************************************************************
+SetLadder()
+
+Assign the temperatures of the local replicas.
+******************************************************************************/
+void ReplicaExchange::SetLadder(double tcold, double thot)
+{
+   int i;
+
+   if((tcold <= 0.00) || (tcold > thot))
+   {
+      LogError(ERR_BAD_ARGS, "Invalid temperature ladder; all replicas use the initial temperature");
+      tcold = thot;
+   }
+   m_Tcold = tcold;
+   m_Thot = thot;
+
+   for(i = 0; i < m_NumLocal; i++)
+   {
+      m_pTemp[i] = LadderTemp(GetGlobalIdx(i));
+   }
+} /* end SetLadder() */
+
+/******************************************************************************
+Store()
+
+Save the state of local replica i and keep track of the best state seen by
+this processor.
+******************************************************************************/
+void ReplicaExchange::Store(int i, double * pParams, double f)
+{
+   memcpy(m_pParams[i], pParams, sizeof(double)*m_NumParams);
+   m_pF[i] = f;
+
+   if(f < m_Fbest)
+   {
+      memcpy(m_pBest, pParams, sizeof(double)*m_NumParams);
+      m_Fbest = f;
+   }
+} /* end Store() */
+
+/******************************************************************************
+GetBest()
+
+Retrieve the best state seen by this processor.
+******************************************************************************/
+double ReplicaExchange::GetBest(double * pParams)
+{
+   memcpy(pParams, m_pBest, sizeof(double)*m_NumParams);
+   return m_Fbest;
+} /* end GetBest() */
+
+/******************************************************************************
+AcceptSwap()
+
+Metropolis test for swapping the states of a colder and a hotter replica.
+******************************************************************************/
+bool ReplicaExchange::AcceptSwap(double Tcold, double Thot, double Fcold, double Fhot)
+{
+   double d, r;
+
+   m_NumAttempts++;
+
+   d = (1.00/Tcold - 1.00/Thot)*(Fcold - Fhot);
+   if(d < 0.00)
+   {
+      r = (double)MyRand() / (double)MY_RAND_MAX;
+      if(r >= exp(d)) return false;
+   }
+
+   m_NumSwaps++;
+   return true;
+} /* end AcceptSwap() */
+
+/******************************************************************************
+SwapLocal()
+
+Attempt to swap the states of local replicas i and i+1.
+******************************************************************************/
+void ReplicaExchange::SwapLocal(int i)
+{
+   double * pTmp;
+   double f;
+
+   if(AcceptSwap(m_pTemp[i], m_pTemp[i+1], m_pF[i], m_pF[i+1]) == false) return;
+
+   pTmp = m_pParams[i];
+   m_pParams[i] = m_pParams[i+1];
+   m_pParams[i+1] = pTmp;
+
+   f = m_pF[i];
+   m_pF[i] = m_pF[i+1];
+   m_pF[i+1] = f;
+} /* end SwapLocal() */
+
+/******************************************************************************
+SwapWithLower()
+
+Attempt to swap the state of the coldest local replica with the hottest
+replica of the previous processor. The previous processor makes the decision:
+   (1) send obj. func. value to the previous processor
+   (2) receive decision, along with the state of the colder replica
+   (3) if the swap was accepted, send the state of the local replica
+******************************************************************************/
+void ReplicaExchange::SwapWithLower(void)
+{
+   MPI_Status status;
+   int lower = m_Rank - 1;
+
+   m_pMsg[0] = m_pF[0];
+   MPI_Send(m_pMsg, 1, MPI_DOUBLE, lower, REPX_MPI_TAG, MPI_COMM_WORLD);
+
+   MPI_Recv(m_pMsg, m_NumParams + 2, MPI_DOUBLE, lower, REPX_MPI_TAG, MPI_COMM_WORLD, &status);
+   if(m_pMsg[0] < 0.50) return;
+
+   MPI_Send(m_pParams[0], m_NumParams, MPI_DOUBLE, lower, REPX_MPI_TAG, MPI_COMM_WORLD);
+   memcpy(m_pParams[0], &(m_pMsg[2]), sizeof(double)*m_NumParams);
+   m_pF[0] = m_pMsg[1];
+} /* end SwapWithLower() */
+
+/******************************************************************************
+SwapWithUpper()
+
+Attempt to swap the state of the hottest local replica with the coldest
+replica of the next processor. This is the counterpart of SwapWithLower().
+******************************************************************************/
+void ReplicaExchange::SwapWithUpper(void)
+{
+   MPI_Status status;
+   int upper = m_Rank + 1;
+   int i = m_NumLocal - 1;
+   double Fhot;
+   bool bAccept;
+
+   MPI_Recv(m_pMsg, 1, MPI_DOUBLE, upper, REPX_MPI_TAG, MPI_COMM_WORLD, &status);
+   Fhot = m_pMsg[0];
+
+   bAccept = AcceptSwap(m_pTemp[i], LadderTemp(GetGlobalIdx(i) + 1), m_pF[i], Fhot);
+
+   m_pMsg[0] = (bAccept ? 1.00 : 0.00);
+   m_pMsg[1] = m_pF[i];
+   memcpy(&(m_pMsg[2]), m_pParams[i], sizeof(double)*m_NumParams);
+   MPI_Send(m_pMsg, m_NumParams + 2, MPI_DOUBLE, upper, REPX_MPI_TAG, MPI_COMM_WORLD);
+   if(bAccept == false) return;
+
+   MPI_Recv(m_pParams[i], m_NumParams, MPI_DOUBLE, upper, REPX_MPI_TAG, MPI_COMM_WORLD, &status);
+   m_pF[i] = Fhot;
+} /* end SwapWithUpper() */
+
+/******************************************************************************
+Exchange()
+
+Attempt to swap the states of neighbouring replicas. Even pairs (0-1, 2-3, ...)
+and odd pairs (1-2, 3-4, ...) take turns. Must be called by all processors.
+******************************************************************************/
+void ReplicaExchange::Exchange(void)
+{
+   int i, first, phase;
+
+   phase = m_Phase;
+   m_Phase = 1 - m_Phase;
+   first = GetGlobalIdx(0);
+
+   if((m_Rank > 0) && (((first - 1) % 2) == phase))
+   {
+      SwapWithLower();
+   }
+
+   for(i = 0; i < (m_NumLocal - 1); i++)
+   {
+      if(((first + i) % 2) == phase) SwapLocal(i);
+   }
+
+   if((m_Rank < (m_NumProcs - 1)) && (((first + m_NumLocal - 1) % 2) == phase))
+   {
+      SwapWithUpper();
+   }
+} /* end Exchange() */
+
+/******************************************************************************
+GatherBest()
+
+Collect the best state seen by any processor, along with the exchange metrics.
+The result is only valid on the first processor. Must be called by all
+processors.
+******************************************************************************/
+double ReplicaExchange::GatherBest(double * pParams)
+{
+   MPI_Status status;
+   int i, n;
+
+   n = m_NumParams;
+   if(m_Rank == 0)
+   {
+      for(i = 1; i < m_NumProcs; i++)
+      {
+         MPI_Recv(m_pMsg, n + 3, MPI_DOUBLE, i, REPX_MPI_TAG, MPI_COMM_WORLD, &status);
+         if(m_pMsg[0] < m_Fbest)
+         {
+            m_Fbest = m_pMsg[0];
+            memcpy(m_pBest, &(m_pMsg[1]), sizeof(double)*n);
+         }
+         m_NumAttempts += (int)m_pMsg[n + 1];
+         m_NumSwaps += (int)m_pMsg[n + 2];
+      }/* end for() */
+   }
+   else
+   {
+      m_pMsg[0] = m_Fbest;
+      memcpy(&(m_pMsg[1]), m_pBest, sizeof(double)*n);
+      m_pMsg[n + 1] = (double)m_NumAttempts;
+      m_pMsg[n + 2] = (double)m_NumSwaps;
+      MPI_Send(m_pMsg, n + 3, MPI_DOUBLE, 0, REPX_MPI_TAG, MPI_COMM_WORLD);
+   }
+
+   return GetBest(pParams);
+} /* end GatherBest() */
+
+/******************************************************************************
+TemperingABC::CTOR
+
+Parallel tempering is disabled by default.
+******************************************************************************/
+TemperingABC::TemperingABC(void)
+{
+   m_bTempering = false;
+   m_NumReplicas = 0;
+   m_XchgInterval = 1;
+   m_pReplicas = NULL;
+} /* end CTOR */
+
+/******************************************************************************
+ReadTemperingToken()
+
+Read a parallel tempering keyword from a line of the algorithm section. Other
+lines are ignored.
+******************************************************************************/
+void TemperingABC::ReadTemperingToken(char * line)
+{
+   char tmp[DEF_STR_SZ];
+   char val[DEF_STR_SZ];
+
+   if(strstr(line, "ParallelTempering") != NULL)
+   {
+      sscanf(line, "%s %s", tmp, val);
+      MyStrLwr(val);
+      m_bTempering = (strcmp(val, "yes") == 0);
+   }
+   else if(strstr(line, "NumReplicas") != NULL)
+   {
+      sscanf(line, "%s %d", tmp, &m_NumReplicas);
+   }
+   else if(strstr(line, "ExchangeInterval") != NULL)
+   {
+      sscanf(line, "%s %d", tmp, &m_XchgInterval);
+      if(m_XchgInterval < 1) m_XchgInterval = 1;
+   }
+} /* end ReadTemperingToken() */
+
+/******************************************************************************
+OptimizeTempering()
+
+Optimize the objective function using the parallel tempering (replica 
+exchange) variant of an annealing algorithm. Each replica runs its own chain 
+at a fixed temperature, spaced geometrically between the final and the initial 
+temperature of the annealing schedule, and neighbouring replicas attempt to 
+swap states every m_XchgInterval outer iterations. The replicas are spread 
+over the available cpus, and the replicas of a given cpu are run round-robin.
+Auxiliary data of the chain (auxSize values, e.g. a step distribution matrix)
+stays with the temperature of each replica.
+******************************************************************************/
+void TemperingABC::OptimizeTempering(ModelABC * pModel, IroncladString pAlgStr, int auxSize,
+                                     int maxIters, double stopVal)
+{
+   int i, j, n, nrep, rank, nprocs;
+   StatusStruct pStatus;
+   double fcur, fbest, stop, done;
+   double ladder[2];
+   double * pX;
+   ParameterGroup * pGroup;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   pGroup = pModel->GetParamGroupPtr();
+   n = pGroup->GetNumParams();
+
+   nrep = m_NumReplicas;
+   if(nrep <= 0){ nrep = ((nprocs == 1) ? 4 : nprocs);}
+
+   NEW_PRINT("ReplicaExchange", 1);
+   m_pReplicas = new ReplicaExchange(n, nrep, auxSize);
+   MEM_CHECK(m_pReplicas);
+
+   NEW_PRINT("double", n);
+   pX = new double[n];
+   MEM_CHECK(pX);
+
+   //write setup
+   if(rank == 0)
+   {
+      WriteSetup(pModel, pAlgStr);
+   }
+
+   //read in best result from previous run, if desired
+   if(pModel->CheckWarmStart() == true)
+   {
+      WarmStart();
+   }
+
+   fcur = MeltReplica(pX, &(ladder[0]), &(ladder[1]));
+
+   //all cpus use the temperature ladder of the first cpu
+   MPI_Bcast(ladder, 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   m_pReplicas->SetLadder(ladder[0], ladder[1]);
+
+   //first replica starts from the melted state, the others a random move away
+   m_pReplicas->Store(0, pX, fcur);
+   for(j = 0; j < m_pReplicas->GetNumLocal(); j++)
+   {
+      InitReplicaAux(m_pReplicas->GetAux(j));
+      if(j == 0){ continue;}
+
+      fcur = MoveReplica(m_pReplicas->GetParams(0), pX);
+      m_pReplicas->Store(j, pX, fcur);
+   }/* end for() */
+
+   //write banner and initial result
+   if(rank == 0)
+   {
+      fbest = m_pReplicas->GetBest(pX);
+      pGroup->WriteParams(pX);
+      WriteBanner(pModel, "iter  obj. function  ", "Convergence Value");
+      WriteRecord(pModel, 0, fbest, GetConvergenceVal());
+      pStatus.curIter = 0;
+      pStatus.maxIter = maxIters;
+      pStatus.pct = 0.00;
+      pStatus.numRuns = pModel->GetCounter();
+      WriteStatus(&pStatus);
+   }
+
+   for(i = 0; i < maxIters; i++)
+   {
+      //advance each local replica at its own temperature
+      stop = GetConvergenceVal();
+      for(j = 0; j < m_pReplicas->GetNumLocal(); j++)
+      {
+         memcpy(pX, m_pReplicas->GetParams(j), sizeof(double)*n);
+         fcur = EquilibrateReplica(m_pReplicas->GetTemp(j), pX, 
+                                   m_pReplicas->GetObjFuncVal(j), m_pReplicas->GetAux(j));
+         m_pReplicas->Store(j, pX, fcur);
+         if(j == 0){ stop = GetConvergenceVal();}
+      }/* end for() */
+
+      //convergence is judged by the coldest replica
+      EndTemperingIter(i + 1, m_pReplicas->GetTemp(0), stop);
+
+      if(((i + 1) % m_XchgInterval) == 0)
+      {
+         m_pReplicas->Exchange();
+      }
+
+      done = 0.00;
+      if(rank == 0)
+      {
+         //write iteration result
+         fbest = m_pReplicas->GetBest(pX);
+         pGroup->WriteParams(pX);
+         WriteRecord(pModel, (i+1), fbest, stop);
+         pStatus.curIter = i+1;
+         pStatus.pct = ((float)100.00*(float)(i+1))/(float)maxIters;
+         if(stop <= stopVal){ pStatus.pct = 100.00;}
+         pStatus.numRuns = pModel->GetCounter();
+         WriteStatus(&pStatus);
+
+         if((pStatus.pct >= 100.00) || (IsQuit() == true)){ done = 1.00;}
+      }
+
+      //first cpu decides when to stop
+      MPI_Bcast(&done, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      if(done > 0.50){ break;}
+
+      //perform intermediate bookkeeping
+      pModel->Bookkeep(false);
+   } /* end for() */
+
+   //perform final bookkeeping
+   pModel->Bookkeep(true);
+
+   //collect the best result of all replicas
+   fbest = m_pReplicas->GatherBest(pX);
+
+   if(rank == 0)
+   {
+      RestoreReplica(pX);
+      //write optimal results 
+      WriteOptimal(pModel, fbest);
+      pStatus.numRuns = pModel->GetCounter();
+      WriteStatus(&pStatus);
+      //write algorithm metrics
+      WriteAlgMetrics(this);
+   }
+
+   delete [] pX;
+}/* end OptimizeTempering() */
+
+/******************************************************************************
+WriteTemperingMetrics()
+
+Write out the replica exchange metrics, if parallel tempering was used.
+******************************************************************************/
+void TemperingABC::WriteTemperingMetrics(FILE * pFile)
+{
+   if(m_pReplicas != NULL)
+   {
+      fprintf(pFile, "Number of Replicas      : %d\n", m_pReplicas->GetNumReplicas());
+      fprintf(pFile, "Exchange Interval       : %d\n", m_XchgInterval);
+      fprintf(pFile, "Exchange Attempts       : %d\n", m_pReplicas->GetNumAttempts());
+      fprintf(pFile, "Accepted Exchanges      : %d\n", m_pReplicas->GetNumSwaps());
+   }
+} /* end WriteTemperingMetrics() */
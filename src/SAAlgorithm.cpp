@@ -26,6 +26,8 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel. 
+10-19-26    lsm   Added parallel tempering (replica exchange) mode.
+10-19-26    lsm   Parallel tempering is shared with VandSA (TemperingABC).
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -40,6 +42,7 @@ Version History
 #include "ParameterABC.h"
 #include "TelescopingBounds.h"
 #include "StatsClass.h"
+#include "ReplicaExchange.h"
 
 #include "Utility.h"
 #include "StatUtility.h"
@@ -203,6 +206,10 @@ SAAlgorithm::SAAlgorithm(ModelABC * pModel)
          {
             sscanf(line, "%s %lf", tmp, &m_StopVal);
          }
+         else
+         {
+            ReadTemperingToken(line);
+         }
          line = GetNxtDataLine(inFile, pFileName);
       }/* end while() */
    } /* end if() */
@@ -227,6 +234,7 @@ void SAAlgorithm::Destroy(void)
    delete [] m_pMelts;
    delete m_pStats;
    delete m_pTransBackup;
+   delete m_pReplicas;
 
    delete [] m_Finner;
 
@@ -267,6 +275,7 @@ void SAAlgorithm::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Downhill Transitions    : %d\n", m_NumDownhill);
    fprintf(pFile, "Upper Violations        : %d\n", m_NumUprViols);
    fprintf(pFile, "Lower Violations        : %d\n", m_NumLwrViols);
+   WriteTemperingMetrics(pFile);
 
    m_pModel->WriteMetrics(pFile);
    if(m_CurStop <= m_StopVal)
@@ -314,7 +323,13 @@ void SAAlgorithm::Optimize(void)
    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
 
-   if(nprocs == 1)
+   if(m_bTempering == true)
+   {
+      m_NumOuter = 0;
+      OptimizeTempering(m_pModel, "Simulated Annealing for Continuous Parameters", 0,
+                        m_MaxOuter, m_StopVal);
+   }
+   else if(nprocs == 1)
    {
       OptimizeSerial();
    }
@@ -489,6 +504,89 @@ void SAAlgorithm::OptimizeParallel(int rank, int nprocs)
    }
 }/* end OptimizeParallel() */
 
+/******************************************************************************
+MeltReplica()
+
+Parallel tempering hook: execute the model at the starting point and melt.
+The melted state is returned in pX, along with the final (coldest) and initial
+(hottest) temperature of the annealing schedule.
+******************************************************************************/
+double SAAlgorithm::MeltReplica(double * pX, double * pTcold, double * pThot)
+{
+   double fcur;
+
+   fcur = m_pModel->Execute();
+   StoreBest();
+   m_MeltCount++;
+
+   fcur = Melt(fcur);
+   memcpy(pX, m_pBest, sizeof(double)*m_pModel->GetParamGroupPtr()->GetNumParams());
+
+   *pTcold = m_InitTemp*pow(m_TempFactor, (double)m_MaxOuter);
+   *pThot = m_InitTemp;
+   return fcur;
+}/* end MeltReplica() */
+
+/******************************************************************************
+MoveReplica()
+
+Parallel tempering hook: make a random move away from pX0 and store the
+result in pX.
+******************************************************************************/
+double SAAlgorithm::MoveReplica(double * pX0, double * pX)
+{
+   double fcur;
+   ParameterGroup * pGroup = m_pModel->GetParamGroupPtr();
+
+   pGroup->WriteParams(pX0);
+   GenerateRandomMove();
+   fcur = m_pModel->Execute();
+   m_MeltCount++;
+   pGroup->ReadParams(pX);
+   return fcur;
+}/* end MoveReplica() */
+
+/******************************************************************************
+EquilibrateReplica()
+
+Parallel tempering hook: advance the chain of a replica at temperature T.
+******************************************************************************/
+double SAAlgorithm::EquilibrateReplica(double T, double * pX, double f, double * pAux)
+{
+   int n = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   m_CurTemp = T;
+   memcpy(m_pBest, pX, sizeof(double)*n);
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pBest);
+   f = Equilibrate(f);
+   memcpy(pX, m_pBest, sizeof(double)*n);
+   return f;
+}/* end EquilibrateReplica() */
+
+/******************************************************************************
+EndTemperingIter()
+
+Parallel tempering hook: the coldest replica determines the temperature and
+convergence value of the algorithm.
+******************************************************************************/
+void SAAlgorithm::EndTemperingIter(int iter, double Tcold, double stop)
+{
+   m_CurStop = stop;
+   m_CurTemp = Tcold;
+   m_NumOuter = iter;
+}/* end EndTemperingIter() */
+
+/******************************************************************************
+RestoreReplica()
+
+Parallel tempering hook: make pX the final result.
+******************************************************************************/
+void SAAlgorithm::RestoreReplica(double * pX)
+{
+   memcpy(m_pBest, pX, sizeof(double)*m_pModel->GetParamGroupPtr()->GetNumParams());
+   RestoreBest();
+}/* end RestoreReplica() */
+
 /******************************************************************************
 InitMaster()
 
@@ -122,6 +122,9 @@ UPPER      double * Upper bounds of the parameters to be optimized.
 
 Version History
 10-31-09    lsm   Created
+10-19-26    lsm   Initial population can be seeded by the model's parameter
+                  initializer (e.g. 'ParamInitializer sobol').
+10-19-26    lsm   The main loop can be checkpointed and resumed (see Checkpoint.h).
 ******************************************************************************/
 #include <math.h>
 #include <string.h>
@@ -131,6 +134,8 @@ Version History
 #include "ParameterGroup.h"
 #include "ParameterABC.h"
 #include "StatsClass.h"
+#include "ParamInitializerABC.h"
+#include "Checkpoint.h"
 
 #include "Utility.h"
 #include "WriteUtility.h"
@@ -165,6 +170,8 @@ SCEUA::SCEUA(ModelABC * pModel)
    m_pLower = NULL;
    m_bUseInitPt = false;
    m_fSaved = NEARLY_HUGE;
+   m_pCkpt = NULL;
+   m_bResume = false;
 
    IncCtorCount();
 }/* end CTOR() */
@@ -177,6 +184,7 @@ void SCEUA::Destroy(void)
    delete [] m_pParams;
    delete [] m_pLower;
    delete [] m_pUpper;
+   delete m_pCkpt;
 }/* end Destroy() */
 
 /******************************************************************************
@@ -223,10 +231,23 @@ void SCEUA::Optimize(void)
 
    InitFromFile(GetInFileName());
 
-   WriteSetup(m_pModel, "Shuffled Complex Evolution - University of Arizona");
+   //checkpoints are only taken when SCE is the top-level algorithm
+   if(GetProgramType() == SCEUA_PROGRAM)
+   {
+      NEW_PRINT("Checkpoint", 1);
+      m_pCkpt = new Checkpoint(m_pModel, "SCEUA");
+      MEM_CHECK(m_pCkpt);
+      m_pCkpt->AddFile("sce.out");
+      m_bResume = m_pCkpt->Resume();
+   }
+
    m_CurIter = 0;
-   //write banner
-   WriteBanner(m_pModel, "gen   best value     ", "Pct. Complete");
+   if(m_bResume == false)
+   {
+      WriteSetup(m_pModel, "Shuffled Complex Evolution - University of Arizona");
+      //write banner
+      WriteBanner(m_pModel, "gen   best value     ", "Pct. Complete");
+   }
   
    scemain(); //main SCE implemenation, converted from FORTRAN
 
@@ -326,7 +347,8 @@ void SCEUA::scein
 
    //INITIALIZE I/O VARIABLES
    FILE * pIn  = fopen("sce.in", "r");
-   FILE * pOut = fopen("sce.out", "w");
+   //a resumed run already has the report of its input variables
+   FILE * pOut = (m_bResume == true) ? tmpfile() : fopen("sce.out", "w");
 
    int ierror = 0;
    int iwarn = 0;
@@ -670,6 +692,26 @@ void SCEUA::sceua
    }
 
 
+   //space-filling initial points, if requested
+   ParamInitializerABC * pInitializer = m_pModel->GetParamInitializerPtr();
+   double ** pInitSets = NULL;
+   int numInitSets = 0;
+   int nextInitSet = 0;
+   if(pInitializer != NULL)
+   {
+      numInitSets = pInitializer->GetNumParameterSets();
+      NEW_PRINT("double *", numInitSets);
+      pInitSets = new double * [numInitSets];
+      MEM_CHECK(pInitSets);
+      for(i = 0; i < numInitSets; i++)
+      {
+         NEW_PRINT("double", nopt);
+         pInitSets[i] = new double[nopt];
+         MEM_CHECK(pInitSets[i]);
+      }
+      pInitializer->GetParameterSets(pInitSets, 0);
+   }
+
    char **xname; 
    xname = new char*[nopt];
    for(i = 0; i < nopt; i++)
@@ -700,13 +742,6 @@ void SCEUA::sceua
    ngs1 = ngs; 
    npt1 = npt; 
 
-   fprintf(pOut, "\
-  ==================================================\n\
-  ENTER THE SHUFFLED COMPLEX EVOLUTION GLOBAL SEARCH\n\
-  ==================================================\n\n\n");
-
-   if(m_OutputMode != 2) printf(" ***  Evolution Loop Number %d\n", nloop);
-
    //COMPUTE THE BOUND FOR PARAMETERS BEING OPTIMIZED
    int j;
    for(j = 1; j <= nopt; j++)
@@ -715,6 +750,44 @@ void SCEUA::sceua
       unit[j-1] = 1.0;
    }
 
+   //RESTORE THE STATE OF THE MAIN LOOP FROM A CHECKPOINT
+   int icall, ipcnvg, nleft;
+   double bestf, worstf, gnrng, eb;
+   if(m_bResume == true)
+   {
+      for(i = 0; i < npt; i++) m_pCkpt->ReadDoubles(x[i], nopt);
+      m_pCkpt->ReadDoubles(xf, npt);
+      m_pCkpt->ReadDoubles(criter, 20);
+      m_pCkpt->ReadDoubles(bestx, nopt);
+      m_pCkpt->ReadDoubles(worstx, nopt);
+      m_pCkpt->ReadDoubles(xnstd, nopt);
+      m_pCkpt->ReadDoubles(m_pParams, nopt);
+      nloop = m_pCkpt->ReadInt();
+      loop = m_pCkpt->ReadInt();
+      igs = m_pCkpt->ReadInt();
+      icall = m_pCkpt->ReadInt();
+      ngs1 = m_pCkpt->ReadInt();
+      npt1 = m_pCkpt->ReadInt();
+      ipcnvg = m_pCkpt->ReadInt();
+      iseed1 = m_pCkpt->ReadInt();
+      nextInitSet = m_pCkpt->ReadInt();
+      m_CurIter = m_pCkpt->ReadInt();
+      bestf = m_pCkpt->ReadDouble();
+      worstf = m_pCkpt->ReadDouble();
+      gnrng = m_pCkpt->ReadDouble();
+      m_fSaved = m_pCkpt->ReadDouble();
+      m_Best = m_pCkpt->ReadDouble();
+      m_pStatus.maxIter = m_Budget;
+      goto label_1000;
+   }
+
+   fprintf(pOut, "\
+  ==================================================\n\
+  ENTER THE SHUFFLED COMPLEX EVOLUTION GLOBAL SEARCH\n\
+  ==================================================\n\n\n");
+
+   if(m_OutputMode != 2) printf(" ***  Evolution Loop Number %d\n", nloop);
+
    //COMPUTE THE FUNCTION VALUE OF THE INITIAL POINT   
    double fa;
    //handle warm start
@@ -737,9 +810,9 @@ void SCEUA::sceua
    }
 
    //write initial config.
-   int nleft = m_Budget - m_pModel->GetCounter();
+   nleft = m_Budget - m_pModel->GetCounter();
 
-   double eb = (double)(m_pModel->GetCounter())/(double)m_Budget; //elapsed budget
+   eb = (double)(m_pModel->GetCounter())/(double)m_Budget; //elapsed budget
    
    m_pStatus.curIter = 0;
    m_pStatus.maxIter = m_Budget;
@@ -777,7 +850,15 @@ void SCEUA::sceua
    // ELSE, GENERATE A POINT RANDOMLY AND SET IT EQUAL TO x(1,.)
    else
    {
-      getpnt(nopt,1,&iseed1,xx,bl,bu,unit,bl);
+      if(nextInitSet < numInitSets)
+      {
+         for(j = 0; j < nopt; j++) xx[j] = pInitSets[nextInitSet][j];
+         nextInitSet++;
+      }
+      else
+      {
+         getpnt(nopt,1,&iseed1,xx,bl,bu,unit,bl);
+      }
       eb = (double)(m_pModel->GetCounter())/(double)m_Budget;
       for(j = 0; j < nopt; j++)
       {
@@ -811,7 +892,6 @@ void SCEUA::sceua
       xf[0] = fa;
    }
 
-   int icall;
    icall = 1;
    if (icall >= maxn) goto label_9000;
 
@@ -820,7 +900,15 @@ void SCEUA::sceua
 label_restart:
    for(i = 1; i < npt1; i++)
    {
-      getpnt(nopt,1,&iseed1,xx,bl,bu,unit,bl);
+      if(nextInitSet < numInitSets)
+      {
+         for(j = 0; j < nopt; j++) xx[j] = pInitSets[nextInitSet][j];
+         nextInitSet++;
+      }
+      else
+      {
+         getpnt(nopt,1,&iseed1,xx,bl,bu,unit,bl);
+      }
       eb = (double)(m_pModel->GetCounter())/(double)m_Budget;
       for(j = 0; j < nopt; j++)
       {
@@ -858,13 +946,10 @@ label_restart:
       bestx[j] = x[0][j];
       worstx[j] = x[npt1-1][j];
    }
-   double bestf, worstf;
    bestf = xf[0];
    worstf = xf[npt1-1];
 
    // COMPUTE THE PARAMETER RANGE FOR THE INITIAL POPULATION
-   double gnrng;
-   int ipcnvg;
    parstt(npt1,nopt,x,xnstd,bound,&gnrng,&ipcnvg);
 
    // PRINT THE RESULTS FOR THE INITIAL POPULATION
@@ -1108,6 +1193,36 @@ label_132:
         comp(nopt,npt1,ngs1,ngs2,npg,x,xf,cx,cf); 
    } //end if
 
+   // SAVE THE STATE OF THE MAIN LOOP, IF A CHECKPOINT IS DUE
+   if((m_pCkpt != NULL) && (m_pCkpt->IsDue() == true))
+   {
+      fflush(pOut);
+      m_pCkpt->Begin();
+      for(i = 0; i < npt; i++) m_pCkpt->WriteDoubles(x[i], nopt);
+      m_pCkpt->WriteDoubles(xf, npt);
+      m_pCkpt->WriteDoubles(criter, 20);
+      m_pCkpt->WriteDoubles(bestx, nopt);
+      m_pCkpt->WriteDoubles(worstx, nopt);
+      m_pCkpt->WriteDoubles(xnstd, nopt);
+      m_pCkpt->WriteDoubles(m_pParams, nopt);
+      m_pCkpt->WriteInt(nloop);
+      m_pCkpt->WriteInt(loop);
+      m_pCkpt->WriteInt(igs);
+      m_pCkpt->WriteInt(icall);
+      m_pCkpt->WriteInt(ngs1);
+      m_pCkpt->WriteInt(npt1);
+      m_pCkpt->WriteInt(ipcnvg);
+      m_pCkpt->WriteInt(iseed1);
+      m_pCkpt->WriteInt(nextInitSet);
+      m_pCkpt->WriteInt(m_CurIter);
+      m_pCkpt->WriteDouble(bestf);
+      m_pCkpt->WriteDouble(worstf);
+      m_pCkpt->WriteDouble(gnrng);
+      m_pCkpt->WriteDouble(m_fSaved);
+      m_pCkpt->WriteDouble(m_Best);
+      m_pCkpt->End();
+   }
+
    // END OF MAIN LOOP -----------
    goto label_1000;
 
@@ -1137,6 +1252,7 @@ label_9100:
  *** OPTIMIZATION RESTARTED BECAUSE THE POPULATION HAS\n\
      CONVERGED INTO %5.2lf PERCENT OF THE FEASIBLE SPACE ***\n\n",
       gnrng*100.0); 
+      nextInitSet = numInitSets; //restarts are random
       goto label_restart;
 
  label_9999:
@@ -1188,6 +1304,11 @@ label_9100:
    delete [] lcs;
    delete [] cf;
    delete [] xf;
+   for(i = 0; i < numInitSets; i++)
+   {
+      delete [] pInitSets[i];
+   }
+   delete [] pInitSets;
 } /* end sceua() */
 
 /******************************************************************************
@@ -1833,6 +1954,7 @@ void SCEUA::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Points Per Sub-Complex   : %d\n", m_PtsPerSubComplex); 
    fprintf(pFile, "Num. of Evolution Steps  : %d\n", m_NumEvoSteps); 
    fprintf(pFile, "Min. Num. of Complexes   : %d\n", m_MinComplexes); 
+   if(m_pCkpt != NULL) m_pCkpt->WriteMetrics(pFile);
   
    m_pModel->WriteMetrics(pFile);
 }/* end WriteMetrics() */
@@ -8,6 +8,8 @@ An implementation of a sampling algorithm. Loosely based on Big Bang-Big Crunch
 
 Version History
 11-21-07    lsm   created 
+10-19-26    lsm   only the best parameter set is kept in memory, instead of a 
+                  sorted list of every evaluated set
 ******************************************************************************/
 #include <math.h>
 #include <time.h>
@@ -68,9 +70,9 @@ SamplingAlgorithm::SamplingAlgorithm(ModelABC * pModel)
    m_NumSamples = 10;
    m_Radius = 4.00;
 
-   m_pAll = NULL;
    m_pSamples = NULL;
    m_pBest = NULL;
+   m_pTmp = NULL;
    m_pStats = NULL;
    m_pLwr = NULL;
    m_pUpr = NULL;
@@ -153,6 +155,10 @@ SamplingAlgorithm::SamplingAlgorithm(ModelABC * pModel)
    NEW_PRINT("double", m_NumParams);
    m_pFwd = new double[m_NumParams];
    MEM_CHECK(m_pFwd);
+
+   NEW_PRINT("double", m_NumParams);
+   m_pTmp = new double[m_NumParams];
+   MEM_CHECK(m_pTmp);
    for(i = 0; i < m_NumParams; i++)
    {      
       m_pFwd[i] = 0.50;
@@ -169,24 +175,14 @@ Frees up memory used by the algorithm.
 void SamplingAlgorithm::Destroy(void)
 {
    int i;
-   ParameterList * pList, * pNext;
 
-   if(m_pAll != NULL)
+   if(m_pBest != NULL)
    {
-      pList = m_pAll;
-      while(pList->pNxt != NULL)
-      {
-         pNext = pList->pNxt; //isolate parameter
-         pList->pNxt = pNext->pNxt; //unlink paramter
-         //free up parameter
-         delete [] pNext->p.v;
-         delete pNext;
-      }
-      //free up head of list
-      delete [] m_pAll->p.v;
-      delete m_pAll;
+      delete [] m_pBest->v;
+      delete m_pBest;
    }
 
+   delete [] m_pTmp;
    delete [] m_pSD;
    delete [] m_pLwr;
    delete [] m_pUpr;
@@ -481,11 +477,12 @@ Handy for seeding or restarting the SamplingAlgorithm from previous optimal.
 void SamplingAlgorithm::UserDefinedEvaluations(void)
 {
    StatusStruct pStatus;
-   ParameterList * pList;
-   int j, k, count;
+   int i, j, k, count;
    char tmp[DEF_STR_SZ];
    const char * inFile = GetOstFileName();
    char * line, * pTok;
+   double * pUser;
+   double F;
    FILE * pFile;
 
    pFile = fopen(inFile, "r");
@@ -503,17 +500,31 @@ void SamplingAlgorithm::UserDefinedEvaluations(void)
    FindToken(pFile, "EndInitParams", inFile);
    rewind(pFile);
 
-   //read in entries
+   //count entries
    count = 0;
    FindToken(pFile, "BeginInitParams", inFile);
    line = GetNxtDataLine(pFile, inFile);
    while(strstr(line, "EndInitParams") == NULL)
+   {
+      count++;
+      line = GetNxtDataLine(pFile, inFile);
+   }
+   rewind(pFile);
+
+   NEW_PRINT("double", count*m_NumParams);
+   pUser = new double[count*m_NumParams];
+   MEM_CHECK(pUser);
+
+   //read in entries
+   i = 0;
+   FindToken(pFile, "BeginInitParams", inFile);
+   line = GetNxtDataLine(pFile, inFile);
+   while(strstr(line, "EndInitParams") == NULL)
    {
       pTok = line;
 
-      //create new entry in list
-      pList = InsertParamSet(NEARLY_HUGE);
-      count++;
+      //the first entry is the initial best, later ones reverse the direction
+      InsertParamSet(NEARLY_HUGE);
 
       //extract values, one-by-one, making any necessary conversions
       for(k = 0; k < m_NumParams; k++)
@@ -521,8 +532,13 @@ void SamplingAlgorithm::UserDefinedEvaluations(void)
          j = ExtractString(pTok, tmp);
          j = ValidateExtraction(j, k, m_NumParams, "SamplingAlgorithm::UserDefinedEvaluations()");
          pTok += j;
-         pList->p.v[k] = m_pModel->GetParamGroupPtr()->GetParamPtr(k)->ConvertInVal(atof(tmp));
+         pUser[i*m_NumParams + k] = m_pModel->GetParamGroupPtr()->GetParamPtr(k)->ConvertInVal(atof(tmp));
       }/* end for() */                  
+      if(i == 0)
+      {
+         for(k = 0; k < m_NumParams; k++){ m_pBest->v[k] = pUser[k];}
+      }
+      i++;
 
       line = GetNxtDataLine(pFile, inFile);
    }/* end while() */
@@ -530,15 +546,16 @@ void SamplingAlgorithm::UserDefinedEvaluations(void)
 
    //perform model evaluations
    WriteInnerEval(WRITE_USR, count, '.');
-   count = 0;
-   for(pList = m_pAll; pList!= NULL; pList = pList->pNxt)
+   for(i = 0; i < count; i++)
    {
-      m_pModel->GetParamGroupPtr()->WriteParams(pList->p.v);   
-      pList->p.F = m_pModel->Execute();
+      m_pModel->GetParamGroupPtr()->WriteParams(&(pUser[i*m_NumParams]));   
+      F = m_pModel->Execute();
+      if(i == 0){ m_pBest->F = F;}
       m_AlgCount++;
-      WriteInnerEval(++count, 0, '.');
+      WriteInnerEval(i+1, 0, '.');
    }
    WriteInnerEval(WRITE_ENDED, 0, '.');
+   delete [] pUser;
    
    /* -------------------------------------------------
    Deduct user-defined evaluations from overall 
@@ -567,107 +584,62 @@ void SamplingAlgorithm::UserDefinedEvaluations(void)
 /******************************************************************************
 InsertParamSet()
 
-Insert the most recently evaluated parameter set into the list, preserving 
-order of list.
+Account for the most recently evaluated parameter set. Only the best set is
+kept. A new best set points the forward weights in the direction of the 
+improvement, any other set reverses the forward weights.
 ******************************************************************************/
-ParameterList * SamplingAlgorithm::InsertParamSet(double F)
+void SamplingAlgorithm::InsertParamSet(double F)
 {
    int j;
-   ParameterList * pTmp, * pPrev;
 
-   if(m_pAll == NULL)
+   if(m_pBest == NULL)
    {
-      //allocate space for new list entry
-      NEW_PRINT("ParameterList", 1);
-      m_pAll = new ParameterList;
-      MEM_CHECK(m_pAll);
+      //allocate space for the best set
+      NEW_PRINT("MyPoint", 1);
+      m_pBest = new MyPoint;
+      MEM_CHECK(m_pBest);
 
       NEW_PRINT("double", m_NumParams);
-      m_pAll->p.v = new double[m_NumParams];
-      MEM_CHECK(m_pAll->p.v)
+      m_pBest->v = new double[m_NumParams];
+      MEM_CHECK(m_pBest->v);
 
-      m_pModel->GetParamGroupPtr()->ReadParams(m_pAll->p.v);
-      m_pAll->p.F = F;
-      m_pAll->pNxt = NULL;
-
-      m_pBest = &(m_pAll->p);
+      m_pBest->ndim = m_NumParams;
+      m_pModel->GetParamGroupPtr()->ReadParams(m_pBest->v);
+      m_pBest->F = F;
 
       for(j = 0; j < m_NumParams; j++)
       {
          m_pSD[j] = m_pBest->v[j]*((m_MaxIter - m_CurIter)/(double)m_MaxIter);
       }/* end for() */
-
-      return m_pAll;
    }/* end if(first entry) */
-   else
+   else if(F < m_pBest->F) //new best
    {
-      //locate correct position in list to preserve increasing order of F
-      pPrev = NULL;
-      for(pTmp = m_pAll; pTmp != NULL; pTmp = pTmp->pNxt)
-      {
-         if(F < pTmp->p.F)
-         {
-            break;
-         }
-         pPrev = pTmp;
-      }/* end for() */
+      m_pModel->GetParamGroupPtr()->ReadParams(m_pTmp);
 
-      if(pPrev == NULL) //insert at head of list
+      for(j = 0; j < m_NumParams; j++)
       {
-         //allocate space for new list entry
-         NEW_PRINT("ParameterList", 1);
-         m_pAll = new ParameterList;
-         MEM_CHECK(m_pAll);
-
-         NEW_PRINT("double", m_NumParams);
-         m_pAll->p.v = new double[m_NumParams];
-         MEM_CHECK(m_pAll->p.v)
-
-         m_pModel->GetParamGroupPtr()->ReadParams(m_pAll->p.v);
-         m_pAll->p.F = F;
-         m_pAll->pNxt = pTmp;
+         m_pSD[j] = m_pTmp[j]*((m_MaxIter - m_CurIter)/(double)m_MaxIter);
 
-         m_pBest = &(m_pAll->p);
-
-         for(j = 0; j < m_NumParams; j++)
+         if(m_pTmp[j] < m_pBest->v[j]) //reducing parameter improved obj
          {
-            m_pSD[j] = m_pBest->v[j]*((m_MaxIter - m_CurIter)/(double)m_MaxIter);
-
-            if(m_pBest->v[j] < pTmp->p.v[j]) //reducing parameter improved obj
-            {
-               m_pFwd[j] = 0.00;
-            }
-            else //increasing parameter improved obj
-            {
-               m_pFwd[j] = 1.00;
-            }
-         }/* end for() */
-         return m_pAll;
-      }
-      else
-      {
-         //allocate space for new list entry
-         NEW_PRINT("ParameterList", 1);
-         pPrev->pNxt = new ParameterList;
-         MEM_CHECK(pPrev->pNxt);
-         pPrev = pPrev->pNxt;
-
-         NEW_PRINT("double", m_NumParams);
-         pPrev->p.v = new double[m_NumParams];
-         MEM_CHECK(pPrev->p.v)
-
-         m_pModel->GetParamGroupPtr()->ReadParams(pPrev->p.v);
-         pPrev->p.F = F;
-         pPrev->pNxt = pTmp;
-
-         //reverse direction
-         for(j = 0; j < m_NumParams; j++)
+            m_pFwd[j] = 0.00;
+         }
+         else //increasing parameter improved obj
          {
-            m_pFwd[j] = 1.00 - m_pFwd[j];
+            m_pFwd[j] = 1.00;
          }
-         return pPrev;
-      }/* end else(not first entry) */   
-   }/* end if() */
+         m_pBest->v[j] = m_pTmp[j];
+      }/* end for() */
+      m_pBest->F = F;
+   }
+   else
+   {
+      //reverse direction
+      for(j = 0; j < m_NumParams; j++)
+      {
+         m_pFwd[j] = 1.00 - m_pFwd[j];
+      }
+   }/* end else(not the best) */
 }/* end InsertParamSet() */
 
 /******************************************************************************
@@ -10,6 +10,7 @@ Version History
 08-20-03    lsm   created version history field and updated comments.
 03-05-04    lsm   replaced magic # with NEARLY_ZERO
 01-01-07    lsm   Added Durbin-Watson and runs tests.
+10-19-26    lsm   Added a running quantile estimate (P-square algorithm).
 ******************************************************************************/
 #include <string.h>
 #include <math.h>
@@ -289,6 +290,127 @@ double CalcMedian(Unmoveable1DArray v, int size)
   return v[i];
 } /* end CalcMedian() */
 
+/******************************************************************************
+InitQuantile()
+
+Start a running estimate of the p-quantile (see QuantileStruct).
+******************************************************************************/
+void InitQuantile(QuantileStruct * pQ, double p)
+{
+   pQ->p = p;
+   pQ->count = 0;
+
+   pQ->dn[0] = 0.00;
+   pQ->dn[1] = 0.50*p;
+   pQ->dn[2] = p;
+   pQ->dn[3] = 0.50*(1.00 + p);
+   pQ->dn[4] = 1.00;
+} /* end InitQuantile() */
+
+/******************************************************************************
+UpdateQuantile()
+
+Add an observation (x) to a running quantile estimate. Once five observations 
+are in, the marker cells are shifted to make room for x and the inner markers 
+are moved towards their desired positions, adjusting their heights with a 
+piecewise-parabolic (or, failing that, linear) prediction.
+******************************************************************************/
+void UpdateQuantile(QuantileStruct * pQ, double x)
+{
+   double d, s, qp;
+   int i, k;
+
+   //first observations are stored, sorted
+   if(pQ->count < 5)
+   {
+      for(i = pQ->count; (i > 0) && (pQ->q[i-1] > x); i--)
+      {
+         pQ->q[i] = pQ->q[i-1];
+      }
+      pQ->q[i] = x;
+      pQ->count++;
+      if(pQ->count == 5)
+      {
+         for(i = 0; i < 5; i++)
+         {
+            pQ->n[i] = (double)(i + 1);
+            pQ->np[i] = 1.00 + 4.00*pQ->dn[i];
+         }
+      }
+      return;
+   }/* end if() */
+   pQ->count++;
+
+   //cell of the new observation, extending the extreme markers if needed
+   if(x < pQ->q[0])
+   {
+      pQ->q[0] = x;
+      k = 0;
+   }
+   else if(x >= pQ->q[4])
+   {
+      pQ->q[4] = x;
+      k = 3;
+   }
+   else
+   {
+      for(k = 0; x >= pQ->q[k+1]; k++);
+   }
+
+   for(i = k + 1; i < 5; i++)
+   {
+      pQ->n[i] += 1.00;
+   }
+   for(i = 0; i < 5; i++)
+   {
+      pQ->np[i] += pQ->dn[i];
+   }
+
+   //adjust the inner markers
+   for(i = 1; i < 4; i++)
+   {
+      d = pQ->np[i] - pQ->n[i];
+      if(((d >= 1.00) && ((pQ->n[i+1] - pQ->n[i]) > 1.00)) ||
+         ((d <= -1.00) && ((pQ->n[i-1] - pQ->n[i]) < -1.00)))
+      {
+         s = (d >= 0.00) ? 1.00 : -1.00;
+         qp = pQ->q[i] + s/(pQ->n[i+1] - pQ->n[i-1]) *
+              ((pQ->n[i] - pQ->n[i-1] + s)*(pQ->q[i+1] - pQ->q[i])/(pQ->n[i+1] - pQ->n[i]) +
+               (pQ->n[i+1] - pQ->n[i] - s)*(pQ->q[i] - pQ->q[i-1])/(pQ->n[i] - pQ->n[i-1]));
+         if((pQ->q[i-1] < qp) && (qp < pQ->q[i+1]))
+         {
+            pQ->q[i] = qp;
+         }
+         else
+         {
+            k = i + (int)s;
+            pQ->q[i] += s*(pQ->q[k] - pQ->q[i])/(pQ->n[k] - pQ->n[i]);
+         }
+         pQ->n[i] += s;
+      }/* end if() */
+   }/* end for() */
+} /* end UpdateQuantile() */
+
+/******************************************************************************
+GetQuantile()
+
+Current estimate of the quantile; exact (interpolated between order 
+statistics) for up to five observations.
+******************************************************************************/
+double GetQuantile(QuantileStruct * pQ)
+{
+   double h;
+   int i;
+
+   if(pQ->count == 0) return 0.00;
+   if(pQ->count > 5) return pQ->q[2];
+
+   h = pQ->p*(double)(pQ->count - 1);
+   i = (int)h;
+   if(i >= pQ->count - 1) return pQ->q[pQ->count - 1];
+   return pQ->q[i] + (h - (double)i)*(pQ->q[i+1] - pQ->q[i]);
+} /* end GetQuantile() */
+
 /******************************************************************************
 FdistPDF()
 
@@ -56,6 +56,8 @@ Version History
                      Durbin-Watson
                      MMRI
 07-18-07    lsm   Added support for SuperMUSE
+10-19-26    lsm   CalcBestBoxCox() optimizes lambda in memory rather than in a
+                  separate Ostrich run.
 ******************************************************************************/
 #include <string>
 #include <mpi.h>
@@ -74,6 +76,8 @@ Version History
 #include "ParameterABC.h"
 #include "ObjectiveFunction.h"
 #include "SuperMUSE.h"
+#include "OptSearchClass.h"
+#include "BoxCoxModel.h"
 
 #include "Utility.h"
 #include "Exception.h"
@@ -2481,15 +2485,13 @@ void StatsClass::CalcStats(void)
 CalcBestBoxCox()
 
 Determine the optimal lambda value for a BoxCox transformation that conforms
-the residuals to satisfy assumption of normality. This sets up and runs a 
-separate Ostrich optimization on the internaa BoxCoxModel() objective function.
+the residuals to satisfy assumption of normality. The BoxCoxObjFunc() objective
+function is minimized in memory, using Brent's method in the manner of Powell's 
+algorithm (lambda is bounded by -3 and +3 and starts at 1).
 ******************************************************************************/
 void StatsClass::CalcBestBoxCox(void)
 {
    int id;
-   std::string cmd;
-   char * line;
-   int max_line_size;
    m_BestBoxCoxVal = 0.00;
 
    MPI_Comm_rank(MPI_COMM_WORLD, &id);
@@ -2500,148 +2502,52 @@ void StatsClass::CalcBestBoxCox(void)
       m_BestBoxCoxFlag = false;
       return; 
    }
-   
-   //Create BoxCoxIn.tpl
-   #ifdef _WIN32
-   system("mkdir BoxCoxModel 2> NUL");
-   FILE * pTpl = fopen(".\\BoxCoxModel\\BoxCoxIn.tpl", "w");
-   #else
-   system("mkdir BoxCoxModel 2> /dev/null");
-   FILE * pTpl = fopen("./BoxCoxModel/BoxCoxIn.tpl", "w");
-   #endif
-
-   if(pTpl == NULL)
-   {
-      LogError(ERR_FILE_IO, "Unable to create BoxCoxIn.tpl! Best BoxCox lamba value not computed.");
-      return;
-   }/* end if() */
 
-   fprintf(pTpl, "LAMBDA=lambda\nNUM_DATA_POINTS=%d\n", m_NumObs);
    ObservationGroup * pG;
    Observation * pO;
+   BoxCoxDataStruct box;
    int i;
-   double x,y,w;
    pG = m_pModel->GetObsGroupPtr();
-   if(pG != NULL)
-   {
-      for(i = 0; i < m_NumObs; i++)
-      {
-        pO=pG->GetObsPtr(i);
-        if(pO != NULL)
-        {
-            w=GetObsWeight(pO);
-            x=pO->GetMeasuredVal(false,false);
-            y=pO->GetComputedVal(false,false);
-            fprintf(pTpl, "%E\t%E\t%E\n", x, y, w);
-        }
-        else
-        {
-            printf("Observation #%d is NULL!\n", i);
-        }
-      }/* end for() */
-   }
-   else
+   if(pG == NULL)
    {
       printf("Observation Group is NULL!\n");
-   }   
-   fclose(pTpl);
+      return;
+   }
 
-   //create input file
-   #ifdef _WIN32
-   FILE * pIn = fopen(".\\BoxCoxModel\\ostIn.txt", "w");
-   #else
-   FILE * pIn = fopen("./BoxCoxModel/ostIn.txt", "w");
-   #endif
+   NEW_PRINT("double", 4*m_NumObs);
+   box.x = new double[4*m_NumObs];
+   MEM_CHECK(box.x);
+   box.y = &(box.x[m_NumObs]);
+   box.w = &(box.y[m_NumObs]);
+   box.r = &(box.w[m_NumObs]);
+   box.n = 0;
 
-   if(pIn == NULL)
-   {
-      LogError(ERR_FILE_IO, "Unable to create ostIn.txt! Best BoxCox lamba value not computed.");
-      return;
-   }/* end if() */
-fprintf(pIn, "ProgramType Powell\n\
-ObjectiveFunction GCOP\n\
-\n\
-ModelSubdir    .\n\
-NumDigitsOfPrecision 16\n\
-\n\
-BeginFilePairs\n\
-BoxCoxIn.tpl ; BoxCoxIn.txt\n\
-EndFilePairs\n\
-\n\
-CheckSensitivities no\n\
-ModelExecutable BoxCox()\n\
-\n\
-BeginParams\n\
-lambda 1 -3 +3 none none none\n\
-EndParams\n\
-\n\
-BeginResponseVars\n\
-F(x)    BoxCoxOut.txt ; ObjFunc   0   2   '='\n\
-EndResponseVars\n\
-\n\
-BeginGCOP\n\
-CostFunction F(x)\n\
-PenaltyFunction APM\n\
-EndGCOP\n\
-\n\
-BeginConstraints\n\
-EndConstraints\n\
-\n\
-BeginPowellAlg\n\
-ConvergenceVal 1E-10\n\
-MaxIterations 200\n\
-EndPowellAlg\n\
-\n\
-Begin1dSearch\n\
-1dSearchConvergeVal 1.000000E-006\n\
-1dSearchMethod Brent\n\
-End1dSearch\n");
-   fclose(pIn);
- 
-   //run Ostrich
-   char OstExe[DEF_STR_SZ];
-   strcpy(OstExe, GetOstExePath());
-   MyStrRep(OstExe, "IsoFit", "Ostrich");
-   MyStrRep(OstExe, "OstrichMPI", "Ostrich");
-   MyStrRep(OstExe, "OstrichFMPI", "Ostrich");
-   #ifdef _WIN32
-      cmd = "cd BoxCoxModel & " + std::string(OstExe) + " > NUL & cd ..";
-   #else
-      cmd = "cd BoxCoxModel; " + std::string(OstExe) +" > /dev/null; cd ..";
-   #endif
-   //printf("Launching Ostrich using the following command |%s|\n", cmd);
-   system(cmd.data());
-
-   //retrieve result   
-   #ifdef _WIN32
-    char boxCoxName[] = ".\\BoxCoxModel\\OstOutput0.txt";
-    max_line_size = GetMaxLineSizeInFile(boxCoxName);
-    FILE * pOut = fopen(".\\BoxCoxModel\\OstOutput0.txt", "r");   
-   #else
-    max_line_size = GetMaxLineSizeInFile((char *)"./BoxCoxModel/OstOutput0.txt");
-    FILE * pOut = fopen("./BoxCoxModel/OstOutput0.txt", "r");
-   #endif
-   line = new char[max_line_size];
-   if(pOut == NULL)
-   {
-      LogError(ERR_FILE_IO, "Unable to open OstOutput0.txt! Best BoxCox lamba value not computed.");
-      return;
-   }/* end if() */
-   const char * pTok = "lambda             : ";
-   line[0] = NULLSTR;
-   while(!feof(pOut))
+   for(i = 0; i < m_NumObs; i++)
    {
-      fgets(line, max_line_size, pOut);
-      if(strncmp(line, pTok, strlen(pTok)) == 0)
-      {
-         sscanf(line, "lambda             :  %lf\n", &m_BestBoxCoxVal);
-         break;
-      }/* end if() */
-   }/* end while() */
-   delete [] line;
+     pO=pG->GetObsPtr(i);
+     if(pO != NULL)
+     {
+         box.w[box.n]=GetObsWeight(pO);
+         box.x[box.n]=pO->GetMeasuredVal(false,false);
+         box.y[box.n]=pO->GetComputedVal(false,false);
+         box.n++;
+     }
+     else
+     {
+         printf("Observation #%d is NULL!\n", i);
+     }
+   }/* end for() */
+
+   double fx;
+   OptSearchClass * pSearch;
+   NEW_PRINT("OptSearchClass", 1);
+   pSearch = new OptSearchClass(BoxCoxObjFunc, &box, -3.00, 3.00, BRENT_SEARCH, 1E-6);
+   MEM_CHECK(pSearch);
+
+   m_BestBoxCoxVal = pSearch->Minimize(1.00, &fx, 1E-10, 200);
 
-   //return to working dir
-   fclose(pOut);
+   delete pSearch;
+   delete [] box.x;
 }/* end CalcBestBoxCox() */
 
 /******************************************************************************
@@ -15,6 +15,7 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel. 
+10-19-26    lsm   processors agree on early termination (IsQuitAll())
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -191,7 +192,7 @@ void SteepDescAlgorithm::Optimize(void)
    //perform steepest descent iteration
    for(i = 0; i < m_MaxIter; i++)
    {
-      if(IsQuit() == true){ break;}
+      if(IsQuitAll() == true){ break;}
 
       oldVal = curVal;
       pStatus.curIter = m_CurIter = i+1;
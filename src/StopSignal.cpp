@@ -0,0 +1,310 @@
+/******************************************************************************
+File     : StopSignal.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Detection of user requests for early termination and cancellation of model
+runs that are in progress. See StopSignal.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   stop messages use their own communicator
+******************************************************************************/
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+  #include <unistd.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+#endif
+#ifdef __linux__
+  #include <sys/inotify.h>
+#endif
+
+#include "StopSignal.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+#ifdef _WIN32
+  #define MY_GETCWD _getcwd
+#else
+  #define MY_GETCWD getcwd
+#endif
+
+//written by the signal handler
+static volatile sig_atomic_t gStopSignal = 0;
+static volatile sig_atomic_t gNumSignals = 0;
+static volatile sig_atomic_t gChildPgid = 0;
+
+static bool gStopInitialized = false;
+static bool gStopFlag = false;
+static bool gStopForwarded = false;
+static int gStopRank = 0;
+static int gStopNumProcs = 1;
+static int gStopMsg = 1;
+static MPI_Comm gStopComm = MPI_COMM_WORLD;
+static int gInotifyFd = -1;
+static double gLastStat = -1.00E30;
+static char gStopName[DEF_STR_SZ];
+static char gStopPath[DEF_STR_SZ];
+static std::chrono::steady_clock::time_point gStopOrigin;
+
+/******************************************************************************
+StopSignalHandler()
+
+Records the stop request. A second signal terminates the program (and any
+model run in progress) immediately.
+******************************************************************************/
+static void StopSignalHandler(int sig)
+{
+   gNumSignals = gNumSignals + 1;
+   gStopSignal = 1;
+   if(gNumSignals > 1)
+   {
+#ifndef _WIN32
+      if(gChildPgid > 0) kill(-gChildPgid, SIGKILL);
+#endif
+      signal(sig, SIG_DFL);
+      raise(sig);
+   }
+#ifdef _WIN32
+   else
+   {
+      //handler is reset to the default after each signal
+      signal(sig, StopSignalHandler);
+   }
+#endif
+} /* end StopSignalHandler() */
+
+/******************************************************************************
+StopInstallHandler()
+******************************************************************************/
+static void StopInstallHandler(int sig)
+{
+#ifdef _WIN32
+   signal(sig, StopSignalHandler);
+#else
+   struct sigaction act;
+   memset(&act, 0, sizeof(act));
+   act.sa_handler = StopSignalHandler;
+   sigemptyset(&act.sa_mask);
+   //restart interrupted file i/o of the algorithms and models
+   act.sa_flags = SA_RESTART;
+   sigaction(sig, &act, NULL);
+#endif
+} /* end StopInstallHandler() */
+
+/******************************************************************************
+StopSignalInit()
+
+Install the signal handlers and start watching the run directory for the stop
+file. Only the first call has any effect. The first call must be made by all
+processors (InitErrors() does this right after MPI_Init()), since it creates
+the communicator of the stop messages. Stop messages therefore never match
+the receives of the master-worker loops on MPI_COMM_WORLD.
+******************************************************************************/
+void StopSignalInit(IroncladString pStopFile)
+{
+   char cwd[DEF_STR_SZ];
+
+   if(gStopInitialized == true) return;
+   gStopInitialized = true;
+
+   gStopOrigin = std::chrono::steady_clock::now();
+   MPI_Comm_rank(MPI_COMM_WORLD, &gStopRank);
+   MPI_Comm_size(MPI_COMM_WORLD, &gStopNumProcs);
+   if(gStopNumProcs > 1) MPI_Comm_dup(MPI_COMM_WORLD, &gStopComm);
+
+   //models are run in subdirectories, so use an absolute path
+   if(MY_GETCWD(cwd, DEF_STR_SZ - 64) == NULL) strcpy(cwd, ".");
+   strcpy(gStopName, pStopFile);
+   snprintf(gStopPath, DEF_STR_SZ, "%s/%s", cwd, pStopFile);
+
+   StopInstallHandler(SIGTERM);
+   StopInstallHandler(SIGINT);
+#ifndef _WIN32
+   StopInstallHandler(SIGUSR1);
+   StopInstallHandler(SIGUSR2);
+#endif
+
+#ifdef __linux__
+   gInotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   if(gInotifyFd >= 0)
+   {
+      if(inotify_add_watch(gInotifyFd, cwd, IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE) < 0)
+      {
+         close(gInotifyFd);
+         gInotifyFd = -1;
+      }
+   }
+#endif
+} /* end StopSignalInit() */
+
+/******************************************************************************
+StopCheckWatch()
+
+Drain pending inotify events, returns true if the stop file was created.
+******************************************************************************/
+static bool StopCheckWatch(void)
+{
+   bool bFound = false;
+#ifdef __linux__
+   char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+   struct inotify_event * pEvent;
+   ssize_t len;
+   char * ptr;
+
+   if(gInotifyFd < 0) return false;
+   for(;;)
+   {
+      len = read(gInotifyFd, buf, sizeof(buf));
+      if(len <= 0) break;
+      for(ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + pEvent->len)
+      {
+         pEvent = (struct inotify_event *)ptr;
+         if((pEvent->len > 0) && (strcmp(pEvent->name, gStopName) == 0)) bFound = true;
+      }
+   }/* end for() */
+#endif
+   return bFound;
+} /* end StopCheckWatch() */
+
+/******************************************************************************
+StopRequested()
+
+Returns true if a stop has been requested. The stop file is only stat()'ed
+once every STOP_POLL_SEC seconds, so this function is cheap enough to be
+called on every model evaluation and algorithm iteration.
+******************************************************************************/
+bool StopRequested(void)
+{
+   struct stat fileInfo;
+   MPI_Status status;
+   MPI_Request request;
+   std::chrono::duration<double> dt;
+   int flag, msg, i;
+
+   if(gStopFlag == true) return true;
+   if(gStopInitialized == false) return (gStopSignal != 0);
+
+   if(gStopSignal != 0) gStopFlag = true;
+   else if(StopCheckWatch() == true) gStopFlag = true;
+   else
+   {
+      dt = std::chrono::steady_clock::now() - gStopOrigin;
+      if((dt.count() - gLastStat) >= STOP_POLL_SEC)
+      {
+         gLastStat = dt.count();
+         if(stat(gStopPath, &fileInfo) == 0) gStopFlag = true;
+      }
+   }
+
+   //stop requested by another processor
+   if((gStopFlag == false) && (gStopNumProcs > 1))
+   {
+      flag = 0;
+      MPI_Iprobe(MPI_ANY_SOURCE, STOP_MPI_TAG, gStopComm, &flag, &status);
+      if(flag != 0)
+      {
+         MPI_Recv(&msg, 1, MPI_INT, status.MPI_SOURCE, STOP_MPI_TAG, gStopComm, &status);
+         gStopFlag = true;
+         gStopForwarded = true;
+      }
+   }
+
+   //forward a locally detected request to the other processors
+   if((gStopFlag == true) && (gStopForwarded == false))
+   {
+      gStopForwarded = true;
+      for(i = 0; i < gStopNumProcs; i++)
+      {
+         if(i == gStopRank) continue;
+         MPI_Isend(&gStopMsg, 1, MPI_INT, i, STOP_MPI_TAG, gStopComm, &request);
+         MPI_Request_free(&request);
+      }
+   }
+
+   return gStopFlag;
+} /* end StopRequested() */
+
+/******************************************************************************
+RunModelCommand()
+
+Execute a model command with the shell, like system(). While the model runs,
+stop requests are checked periodically, and if one arrives the model's
+process group is terminated and MODEL_CANCELLED is returned. Otherwise the
+wait status of the command is returned.
+******************************************************************************/
+int RunModelCommand(IroncladString pCmd)
+{
+#ifdef _WIN32
+   return system(pCmd);
+#else
+   pid_t pid, ret;
+   int status, delay;
+   std::chrono::steady_clock::time_point killTime;
+   std::chrono::duration<double> dt;
+
+   pid = fork();
+   if(pid < 0)
+   {
+      LogError(ERR_MODL_EXE, "Couldn't fork model process");
+      return -1;
+   }
+   if(pid == 0)
+   {
+      //own process group, so that the whole model can be cancelled
+      setpgid(0, 0);
+      execl("/bin/sh", "sh", "-c", pCmd, (char *)NULL);
+      _exit(127);
+   }
+   setpgid(pid, pid);
+   gChildPgid = pid;
+
+   //poll, starting with a short delay so that fast models are not slowed
+   status = -1;
+   delay = 50;
+   for(;;)
+   {
+      ret = waitpid(pid, &status, WNOHANG);
+      if(ret == pid) break;
+      if((ret < 0) && (errno != EINTR)){ status = -1; break;}
+
+      if(StopRequested() == true)
+      {
+         kill(-pid, SIGTERM);
+         killTime = std::chrono::steady_clock::now();
+         for(;;)
+         {
+            ret = waitpid(pid, &status, WNOHANG);
+            if((ret == pid) || ((ret < 0) && (errno != EINTR))) break;
+            dt = std::chrono::steady_clock::now() - killTime;
+            if(dt.count() >= STOP_KILL_GRACE_SEC)
+            {
+               kill(-pid, SIGKILL);
+               waitpid(pid, &status, 0);
+               break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         }/* end for() */
+         gChildPgid = 0;
+         return MODEL_CANCELLED;
+      }/* end if() */
+
+      std::this_thread::sleep_for(std::chrono::microseconds(delay));
+      if(delay < 20000) delay *= 2;
+   }/* end for() */
+
+   gChildPgid = 0;
+   return status;
+#endif
+} /* end RunModelCommand() */
@@ -11,10 +11,27 @@ presence/absence of certain files serve as a handshaking mechanism
 
 Version History
 07-13-07    lsm   added copyright information and initial comments.
+10-19-26    lsm   replaced 1-second polling for the success/error files with
+                  per-task completion markers, watched with inotify, so that
+                  results can be gathered in completion order. Added the
+                  task queue directory for asynchronous task submission.
+                  Marker scans read the server directory once, and only 
+                  with the task queue.
 ******************************************************************************/
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+#include <string>
+#ifdef GCC5X
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
 
 #include "SuperMUSE.h"
 #include "Model.h"
@@ -30,6 +47,10 @@ Version History
 #else
    #include <unistd.h> //needed for sleep() command
 #endif
+#ifdef __linux__
+   #include <poll.h>
+   #include <sys/inotify.h>
+#endif
 
 /******************************************************************************
 CTOR
@@ -55,6 +76,18 @@ SuperMUSE::SuperMUSE(FILE * pFile, ModelABC * pModel)
    strcpy(m_ServerDir, "FRAMESv2/Simulations");
    m_MaxJobTime     = 120; // 2 hours
    m_TaskID = 0;
+   strcpy(m_QueueDir, "");
+   m_MaxInFlight = 4;
+   m_pTaskState = NULL;
+   m_pDone = NULL;
+   m_TaskCapacity = 0;
+   m_DoneHead = 0;
+   m_DoneTail = 0;
+   m_NumPending = 0;
+   m_WatchFd = -1;
+   m_bFailed = false;
+   m_LastScan = 0.00;
+   m_LastProgress = GetElapsedTics();
 
    /* -----------------------------------------------
    Parse the SuperMUSE section of the input file.
@@ -122,6 +155,15 @@ SuperMUSE::SuperMUSE(FILE * pFile, ModelABC * pModel)
       {
          sscanf(line, "%s %d", tmp, &m_MaxJobTime);
       }
+      else if(strncmp(line, "TaskQueue", 9) == 0)
+      {
+         sscanf(line, "%s %s", tmp, m_QueueDir);
+      }
+      else if(strncmp(line, "MaxTasksInFlight", 16) == 0)
+      {
+         sscanf(line, "%s %d", tmp, &m_MaxInFlight);
+         if(m_MaxInFlight < 1) m_MaxInFlight = 1;
+      }
       else
       {
          sprintf(tmp, "SuperMUSE(): unknown token |%s|", line);
@@ -130,6 +172,19 @@ SuperMUSE::SuperMUSE(FILE * pFile, ModelABC * pModel)
 
       line = GetNxtDataLine(pFile, pFileName);
    }/* end while() */   
+
+   //watch for completion markers in the server directory
+#ifdef __linux__
+   m_WatchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   if(m_WatchFd >= 0)
+   {
+      if(inotify_add_watch(m_WatchFd, ".", IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE) < 0)
+      {
+         close(m_WatchFd);
+         m_WatchFd = -1;
+      }
+   }
+#endif
                       
    IncCtorCount();
 } /* end SuperMUSE::CTOR */
@@ -226,6 +281,11 @@ Destroys a SuperMUSE class.
 ******************************************************************************/
 void SuperMUSE::Destroy(void)
 {   
+   delete [] m_pTaskState;
+   delete [] m_pDone;
+#ifdef __linux__
+   if(m_WatchFd >= 0) close(m_WatchFd);
+#endif
    IncDtorCount();
 } /* end SuperMUSE::DTOR */
 
@@ -244,19 +304,329 @@ void SuperMUSE::WriteTask(ParameterGroup * pGroup)
 {
    FILE * pArgs;
    FILE * pTasks;
+   char marker[DEF_STR_SZ];
+   //task files in the queue directory (up to 1000 characters)
+   char name[1000 + DEF_STR_SZ];
+   char tmp[1000 + DEF_STR_SZ];
 
-   pTasks = fopen(m_TempFile, "a");
-   fprintf(pTasks, "%s %s %d %s %s %s \n", m_ScriptFile, m_Server, m_TaskID, 
-                                          m_ArgsFile, m_ClientDir, m_ServerDir);
-   fclose(pTasks);
-
+   //arguments must be in place before the task can be picked up
    pArgs  = fopen(m_ArgsFile, "a");
    pGroup->WriteSuperMuseArgs(pArgs);
    fclose(pArgs);
 
+   //remove stale markers of a previous job
+   sprintf(marker, "Task%d.done", m_TaskID);
+   remove(marker);
+   sprintf(marker, "Task%d.fail", m_TaskID);
+   remove(marker);
+
+   if(IsTaskQueue() == true)
+   {
+      //the rename makes the complete task visible to the tasker at once
+      snprintf(tmp, sizeof(tmp), "%s/Task%d.tmp", m_QueueDir, m_TaskID);
+      snprintf(name, sizeof(name), "%s/Task%d.task", m_QueueDir, m_TaskID);
+      pTasks = fopen(tmp, "w");
+      if(pTasks == NULL)
+      {
+         LogError(ERR_SMUSE, "Couldn't write to SuperMUSE task queue");
+         m_bFailed = true;
+      }
+      else
+      {
+         fprintf(pTasks, "%s %s %d %s %s %s \n", m_ScriptFile, m_Server, m_TaskID, 
+                                                m_ArgsFile, m_ClientDir, m_ServerDir);
+         fclose(pTasks);
+         rename(tmp, name);
+      }
+   }
+   else
+   {
+      pTasks = fopen(m_TempFile, "a");
+      fprintf(pTasks, "%s %s %d %s %s %s \n", m_ScriptFile, m_Server, m_TaskID, 
+                                             m_ArgsFile, m_ClientDir, m_ServerDir);
+      fclose(pTasks);
+   }
+
+   AddTask(m_TaskID);
    m_TaskID++;
 }/* end WriteTask() */
 
+/******************************************************************************
+SubmitTask()
+
+Submit a single task, for asynchronous algorithms. Requires the task queue.
+Returns the task id, to be matched against the return value of 
+WaitForNextTask().
+******************************************************************************/
+int SuperMUSE::SubmitTask(ParameterGroup * pGroup)
+{
+   int taskid = m_TaskID;
+   WriteTask(pGroup);
+   return taskid;
+}/* end SubmitTask() */
+
+/******************************************************************************
+AddTask()
+
+Start tracking the completion of a task.
+******************************************************************************/
+void SuperMUSE::AddTask(int taskid)
+{
+   int * pState;
+   int * pDone;
+   int i, size;
+
+   if(taskid >= m_TaskCapacity)
+   {
+      size = 2*(taskid + 1);
+      NEW_PRINT("int", size);
+      pState = new int[size];
+      MEM_CHECK(pState);
+      NEW_PRINT("int", size);
+      pDone = new int[size];
+      MEM_CHECK(pDone);
+
+      for(i = 0; i < size; i++)
+      {
+         pState[i] = (i < m_TaskCapacity) ? m_pTaskState[i] : SMUSE_TASK_NONE;
+         pDone[i] = (i < m_TaskCapacity) ? m_pDone[i] : 0;
+      }
+      delete [] m_pTaskState;
+      delete [] m_pDone;
+      m_pTaskState = pState;
+      m_pDone = pDone;
+      m_TaskCapacity = size;
+   }/* end if() */
+
+   if(m_NumPending == 0) m_LastProgress = GetElapsedTics();
+   m_pTaskState[taskid] = SMUSE_TASK_PENDING;
+   m_NumPending++;
+}/* end AddTask() */
+
+/******************************************************************************
+MarkTask()
+
+Record the completion of a task.
+******************************************************************************/
+void SuperMUSE::MarkTask(int taskid, bool bFailed)
+{
+   if((taskid < 0) || (taskid >= m_TaskCapacity)) return;
+   if(m_pTaskState[taskid] != SMUSE_TASK_PENDING) return;
+
+   if(bFailed == true)
+   {
+      m_bFailed = true;
+      return;
+   }
+   m_pTaskState[taskid] = SMUSE_TASK_DONE;
+   m_NumPending--;
+   m_pDone[m_DoneTail++] = taskid;
+   m_LastProgress = GetElapsedTics();
+}/* end MarkTask() */
+
+/******************************************************************************
+ReadWatch()
+
+Process pending inotify events of the server directory.
+******************************************************************************/
+void SuperMUSE::ReadWatch(void)
+{
+#ifdef __linux__
+   char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+   struct inotify_event * pEvent;
+   struct stat info;
+   ssize_t len;
+   char * ptr;
+   char ext[DEF_STR_SZ];
+   int taskid;
+
+   if(m_WatchFd < 0) return;
+   for(;;)
+   {
+      len = read(m_WatchFd, buf, sizeof(buf));
+      if(len <= 0) break;
+      for(ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + pEvent->len)
+      {
+         pEvent = (struct inotify_event *)ptr;
+         if(pEvent->len == 0) continue;
+         /* ----------------------------------------------------------
+         Events may be left over from a previous job, whose markers 
+         have been removed since, so only trust markers that exist.
+         ---------------------------------------------------------- */
+         if((sscanf(pEvent->name, "Task%d.%s", &taskid, ext) == 2) && 
+            (stat(pEvent->name, &info) == 0))
+         {
+            if(strcmp(ext, "done") == 0) MarkTask(taskid, false);
+            else if(strcmp(ext, "fail") == 0) MarkTask(taskid, true);
+         }
+         else if(strcmp(pEvent->name, m_ErrorFile) == 0) m_bFailed = true;
+      }
+   }/* end for() */
+#endif
+}/* end ReadWatch() */
+
+/******************************************************************************
+ScanMarkers()
+
+Check the error file and then either the success file (task file) or the 
+markers of the pending tasks (task queue). Markers are found with a single 
+read of the server directory, rather than a stat() of each pending task, to 
+spare the metadata server of network filesystems. This catches markers 
+created by other hosts, which inotify does not report.
+******************************************************************************/
+void SuperMUSE::ScanMarkers(void)
+{
+   struct stat info;
+   std::string name;
+   char marker[DEF_STR_SZ];
+   int i, taskid;
+
+   m_LastScan = GetElapsedTics();
+
+   if(stat(m_ErrorFile, &info) == 0)
+   {
+      m_bFailed = true;
+      return;
+   }
+
+   //with the task file, the success file completes the whole job
+   if(IsTaskQueue() == false)
+   {
+      if((m_NumPending > 0) && (stat(m_SuccessFile, &info) == 0))
+      {
+         for(i = 0; i < m_TaskID; i++) MarkTask(i, false);
+      }
+      return;
+   }
+
+   if(m_NumPending == 0) return;
+   try
+   {
+      for(const auto & entry : fs::directory_iterator("."))
+      {
+         name = entry.path().filename().string();
+         if(sscanf(name.c_str(), "Task%d.", &taskid) != 1) continue;
+         if((taskid < 0) || (taskid >= m_TaskID)) continue;
+         if(m_pTaskState[taskid] != SMUSE_TASK_PENDING) continue;
+         sprintf(marker, "Task%d.done", taskid);
+         if(name == marker){ MarkTask(taskid, false); continue;}
+         sprintf(marker, "Task%d.fail", taskid);
+         if(name == marker) MarkTask(taskid, true);
+      }
+   }
+   catch(const fs::filesystem_error &)
+   {
+      //retry on the next scan
+   }
+}/* end ScanMarkers() */
+
+/******************************************************************************
+WaitForEvent()
+
+Wait (at most maxWait seconds) for a change in the server directory.
+******************************************************************************/
+void SuperMUSE::WaitForEvent(double maxWait)
+{
+#ifdef __linux__
+   struct pollfd pfd;
+   if(m_WatchFd >= 0)
+   {
+      pfd.fd = m_WatchFd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      poll(&pfd, 1, (int)(1000.00*maxWait) + 1);
+      return;
+   }
+#endif
+   std::this_thread::sleep_for(std::chrono::duration<double>(maxWait));
+}/* end WaitForEvent() */
+
+/******************************************************************************
+EndJob()
+
+Prepare for next go-around by deleting the args, task and temp files and 
+resetting the TaskID.
+******************************************************************************/
+void SuperMUSE::EndJob(void)
+{
+   int i;
+
+   remove(m_ArgsFile);
+   remove(m_TempFile);
+   remove(m_TaskFile);
+   for(i = 0; i < m_TaskCapacity; i++) m_pTaskState[i] = SMUSE_TASK_NONE;
+   m_TaskID = 0;
+   m_NumPending = 0;
+   m_DoneHead = 0;
+   m_DoneTail = 0;
+   m_bFailed = false;
+}/* end EndJob() */
+
+/******************************************************************************
+WaitForNextTask()
+
+Wait for the next task to complete and return its id, tasks are returned in 
+order of completion. The result of the task can then be collected with 
+GatherResult(). Returns SMUSE_JOB_DONE if there are no more tasks, or 
+SMUSE_JOB_FAILED if a task failed, the tasker reported an error or timed out, 
+or the user requested a stop.
+******************************************************************************/
+int SuperMUSE::WaitForNextTask(void)
+{
+   char marker[DEF_STR_SZ];
+   double delay, now;
+   int taskid;
+
+   delay = 0.001;
+   for(;;)
+   {
+      ReadWatch();
+      now = GetElapsedTics();
+      if((m_WatchFd < 0) || ((now - m_LastScan) >= SMUSE_SCAN_SEC)) ScanMarkers();
+
+      if(m_bFailed == true)
+      {
+         LogError(ERR_SMUSE, "SuperMUSE Tasker failed to complete one or more tasks.");
+         EndJob();
+         return SMUSE_JOB_FAILED;
+      }
+
+      if(m_DoneHead < m_DoneTail)
+      {
+         taskid = m_pDone[m_DoneHead++];
+         m_pTaskState[taskid] = SMUSE_TASK_NONE;
+         sprintf(marker, "Task%d.done", taskid);
+         remove(marker);
+         return taskid;
+      }
+
+      if(m_NumPending == 0)
+      {
+         EndJob();
+         return SMUSE_JOB_DONE;
+      }
+
+      if((now - m_LastProgress) > (double)(m_MaxJobTime*60))
+      {
+         LogError(ERR_SMUSE, "Timed out waiting for SuperMUSE Tasker.");
+         EndJob();
+         return SMUSE_JOB_FAILED;
+      }
+
+      //check for user abort
+      if(IsQuit())
+      {
+         LogError(ERR_SMUSE, "User aborted SuperMUSE operation.");
+         EndJob();
+         return SMUSE_JOB_FAILED;
+      }
+
+      //inotify wakes up early, otherwise back off up to the scan interval
+      WaitForEvent(delay);
+      if(delay < SMUSE_SCAN_SEC) delay *= 2.00;
+   }/* end for() */
+}/* end WaitForNextTask() */
+
 /******************************************************************************
 FinishTaskFile()
 
@@ -268,6 +638,10 @@ SuperMUSE in a safe manner.
 void SuperMUSE::FinishTaskFile(void)
 {
    FILE * pFile;
+
+   //queued tasks have already been submitted
+   if(IsTaskQueue() == true) return;
+
    pFile = fopen(m_TempFile, "a");
    fprintf(pFile, "end\n");
    fclose(pFile);
@@ -280,68 +654,20 @@ void SuperMUSE::FinishTaskFile(void)
 /******************************************************************************
 WaitForTasker()
 
-Wait for SuperMUSE to report back (via the success or error files).
+Wait for SuperMUSE to complete all tasks (reported via the per-task markers or
+the success or error files).
 ******************************************************************************/
 bool SuperMUSE::WaitForTasker(void)
 {
-   FILE * pSuccess;
-   FILE * pError;
-   int nticks;
+   int taskid;
 
-   nticks = 0;
-   while(1)
+   do
    {
-#ifdef _WIN32
-      Sleep(1000); //1 second polling intervals
-#else
-      sleep(1); //1 second polling intervals
-#endif
+      taskid = WaitForNextTask();
+   }while(taskid >= 0);
 
-      nticks++;
-
-      //check for successful completion
-      pSuccess = fopen(m_SuccessFile, "r");
-      if(pSuccess != NULL)
-      {
-         fclose(pSuccess);
-
-         /* -------------------------
-         Prepare for next go-around
-         by deleting the args, task 
-         and temp files and resetting
-         the TaskID
-         ------------------------- */
-         remove(m_ArgsFile);
-         remove(m_TempFile);
-         remove(m_TaskFile);
-         m_TaskID = 0;
-
-         return true;
-      }/* end if() */
-
-      //check for failed completion
-      pError = fopen(m_ErrorFile, "r");
-      if(pError != NULL)
-      {
-         fclose(pError);
-         LogError(ERR_SMUSE, "SuperMUSE Tasker failed to complete one or more tasks.");
-         return false;            
-      }/* end if() */
-
-      if(nticks > (m_MaxJobTime*60))
-      {
-         LogError(ERR_SMUSE, "Timed out waiting for SuperMUSE Tasker.");
-         return false;
-      }/* end if() */
-
-      //check for user abort
-      if(IsQuit())
-      {
-         LogError(ERR_SMUSE, "User aborted SuperMUSE operation.");
-         return false;
-      }
-   }/* end while() */         
- }/* end WaitForTasker() */
+   return (taskid == SMUSE_JOB_DONE);
+}/* end WaitForTasker() */
 
 /******************************************************************************
 GatherResult()
@@ -397,7 +723,13 @@ void SuperMUSE::WriteSetup(FILE * pFile)
    fprintf(pFile, "Arguments File         : %s\n", m_ArgsFile);
    fprintf(pFile, "Client Working Folder  : %s\n", m_ClientDir);
    fprintf(pFile, "Server Working Folder  : %s\n", m_ServerDir);
-   fprintf(pFile, "Max job Time (minutes) : %d\n\n", m_MaxJobTime);
+   fprintf(pFile, "Max job Time (minutes) : %d\n", m_MaxJobTime);
+   if(IsTaskQueue() == true)
+   {
+      fprintf(pFile, "Task Queue Folder      : %s\n", m_QueueDir);
+      fprintf(pFile, "Max Tasks In Flight    : %d\n", m_MaxInFlight);
+   }
+   fprintf(pFile, "\n");
 }/* end WriteSetup() */
 
 /******************************************************************************
@@ -409,12 +741,10 @@ void SuperMUSE::EnvVarCleanup(void)
 {
    //replace environment vars used in temp, task, success, error files
    m_pEnvVars = NULL;
-   char iemVarsFile[1000];
    #ifdef _WIN32
+   //the environment variable file is only installed on Windows hosts
+   char iemVarsFile[1000];
    GetWindowsDirectoryA(iemVarsFile, 1000);
-   #else
-   strcpy(iemVarsFile, "");
-   #endif
    strcat(iemVarsFile, "\\iemSetCmdEnvironment.bat");
    LoadEnvVars(iemVarsFile); //create list of env vars
    ReplaceEnvVars(m_TempFile);
@@ -422,6 +752,7 @@ void SuperMUSE::EnvVarCleanup(void)
    ReplaceEnvVars(m_SuccessFile);
    ReplaceEnvVars(m_ErrorFile);
    UnloadEnvVars(); //clean up list of env vars
+   #endif
 
    //clear out files, if they exist   
    remove(m_ArgsFile);
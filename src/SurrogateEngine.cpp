@@ -0,0 +1,1009 @@
+/******************************************************************************
+File     : SurrogateEngine.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+In-process surrogate (cubic RBF or Gaussian process) of the objective function,
+used to pre-screen candidate parameter sets. See SurrogateEngine.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added WriteCheckpoint() and ReadCheckpoint()
+10-19-26    lsm   model runs are only kept for Synchronize() if EnableSync()'d
+******************************************************************************/
+#include <mpi.h>
+#include <math.h>
+#include <string.h>
+
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
+#include "ParameterGroup.h"
+#include "ParameterABC.h"
+
+#include "StatUtility.h"
+#include "Utility.h"
+#include "Exception.h"
+
+//initial capacity (number of points)
+#define SRG_INIT_PTS   (64)
+//relative variance of the noise (nugget) of the gp kernel
+#define SRG_NUGGET     (1.00E-06)
+//points closer than this (in the unit hypercube) are duplicates
+#define SRG_MIN_DIST   (1.00E-09)
+//pivots smaller than this make the surrogate ill-conditioned
+#define SRG_MIN_PIVOT  (1.00E-10)
+
+//weights of the predicted value in the rbf score, cycled between screenings
+static const double gSrgWeights[] = {0.30, 0.50, 0.80, 0.95};
+#define SRG_NUM_WEIGHTS (4)
+
+//candidate length scales of the gp kernel, relative to sqrt(n)
+static const double gSrgLengths[] = {0.05, 0.10, 0.20, 0.40, 0.80, 1.60};
+#define SRG_NUM_LENGTHS (6)
+
+/******************************************************************************
+CTOR
+
+Read the configuration of the engine, if any, and allocate storage for an
+initial number of points.
+******************************************************************************/
+SurrogateEngine::SurrogateEngine(ParameterGroup * pGroup, FILE * pInFile, IroncladString pType)
+{
+   int i, j;
+   char * line;
+   char tmp[DEF_STR_SZ];
+   IroncladString pFileName = GetInFileName();
+   ParameterABC * pParam;
+
+   m_pGroup = pGroup;
+   m_NumParams = pGroup->GetNumParams();
+   m_Type = (strcmp(pType, "gp") == 0) ? SRG_ENGINE_GP : SRG_ENGINE_RBF;
+   m_NumCands = 500;
+   m_MinPts = 2*(m_NumParams + 1);
+
+   //read in configuration, if any
+   if(pInFile != NULL)
+   {
+      rewind(pInFile);
+      if(CheckToken(pInFile, "BeginSurrogateEngine", pFileName) == true)
+      {
+         FindToken(pInFile, "EndSurrogateEngine", pFileName);
+         rewind(pInFile);
+
+         FindToken(pInFile, "BeginSurrogateEngine", pFileName);
+         line = GetNxtDataLine(pInFile, pFileName);
+         while(strstr(line, "EndSurrogateEngine") == NULL)
+         {
+            if(strstr(line, "NumCandidates") != NULL)
+            {
+               sscanf(line, "%s %d", tmp, &m_NumCands);
+            }/* end if() */
+            else if(strstr(line, "MinPoints") != NULL)
+            {
+               sscanf(line, "%s %d", tmp, &m_MinPts);
+            }/* end else if() */
+            else
+            {
+               sprintf(tmp, "Unknown token: %s", line);
+               LogError(ERR_FILE_IO, tmp);
+            }/* end else() */
+            line = GetNxtDataLine(pInFile, pFileName);
+         } /* end while() */
+      }/* end if() */
+      rewind(pInFile);
+   }/* end if() */
+
+   if(m_NumCands < 1) m_NumCands = 1;
+   //the linear tail of the rbf needs at least n+2 points
+   if(m_MinPts < (m_NumParams + 2)) m_MinPts = m_NumParams + 2;
+
+   m_MaxPts = 0;
+   m_NumPts = 0;
+   m_NumFit = 0;
+   m_LastRefit = 0;
+   m_Fmin = NEARLY_HUGE;
+   m_Length = 1.00;
+   m_Mean = 0.00;
+   m_Scale = 1.00;
+   m_MinvSize = 0;
+   m_pU = NULL;
+   m_pF = NULL;
+   m_pL = NULL;
+   m_pAlpha = NULL;
+   m_pMinv = NULL;
+   m_pCoef = NULL;
+   m_pWork = NULL;
+   m_pWork2 = NULL;
+   m_bSync = false;
+   m_pPending = NULL;
+   m_NumPending = 0;
+   m_MaxPending = 0;
+   m_NumRejected = 0;
+   m_NumRefits = 0;
+   m_NumScreens = 0;
+   m_NumScreened = 0.00;
+   m_Cycle = 0;
+
+   NEW_PRINT("double", m_NumParams);
+   m_pLwr = new double[m_NumParams];
+   MEM_CHECK(m_pLwr);
+
+   NEW_PRINT("double", m_NumParams);
+   m_pRange = new double[m_NumParams];
+   MEM_CHECK(m_pRange);
+
+   NEW_PRINT("double", m_NumParams + 1);
+   m_pX = new double[m_NumParams + 1];
+   MEM_CHECK(m_pX);
+
+   for(j = 0; j < m_NumParams; j++)
+   {
+      pParam = pGroup->GetParamPtr(j);
+      m_pLwr[j] = pParam->GetLwrBnd();
+      m_pRange[j] = pParam->GetUprBnd() - pParam->GetLwrBnd();
+      if(m_pRange[j] <= 0.00) m_pRange[j] = 1.00;
+   }
+
+   Grow();
+   for(i = 0; i < m_MaxPts; i++) m_pL[i] = NULL;
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Free up memory used by the engine.
+******************************************************************************/
+void SurrogateEngine::Destroy(void)
+{
+   int i;
+
+   for(i = 0; i < m_MaxPts; i++) delete [] m_pL[i];
+   for(i = 0; i < m_MinvSize; i++) delete [] m_pMinv[i];
+   delete [] m_pL;
+   delete [] m_pMinv;
+   delete [] m_pU;
+   delete [] m_pF;
+   delete [] m_pAlpha;
+   delete [] m_pCoef;
+   delete [] m_pWork;
+   delete [] m_pWork2;
+   delete [] m_pLwr;
+   delete [] m_pRange;
+   delete [] m_pX;
+   delete [] m_pPending;
+   m_MaxPts = 0;
+   m_MinvSize = 0;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+Grow()
+
+Double the capacity (number of points) of the engine.
+******************************************************************************/
+void SurrogateEngine::Grow(void)
+{
+   int i, n, maxPts, size;
+   double * pU, * pF, * pAlpha, * pCoef, ** pL, ** pMinv;
+
+   n = m_NumParams;
+   maxPts = (m_MaxPts == 0) ? SRG_INIT_PTS : 2*m_MaxPts;
+   size = maxPts + n + 1;
+
+   NEW_PRINT("double", maxPts*n);
+   pU = new double[maxPts*n];
+   MEM_CHECK(pU);
+   NEW_PRINT("double", maxPts);
+   pF = new double[maxPts];
+   MEM_CHECK(pF);
+   NEW_PRINT("double", maxPts);
+   pAlpha = new double[maxPts];
+   MEM_CHECK(pAlpha);
+   NEW_PRINT("double *", maxPts);
+   pL = new double *[maxPts];
+   MEM_CHECK(pL);
+   NEW_PRINT("double", size);
+   pCoef = new double[size];
+   MEM_CHECK(pCoef);
+
+   if(m_MaxPts > 0)
+   {
+      memcpy(pU, m_pU, sizeof(double)*m_NumPts*n);
+      memcpy(pF, m_pF, sizeof(double)*m_NumPts);
+      memcpy(pAlpha, m_pAlpha, sizeof(double)*m_MaxPts);
+      memcpy(pCoef, m_pCoef, sizeof(double)*m_MinvSize);
+   }
+   for(i = 0; i < maxPts; i++) pL[i] = ((i < m_MaxPts) ? m_pL[i] : NULL);
+
+   delete [] m_pU;
+   delete [] m_pF;
+   delete [] m_pAlpha;
+   delete [] m_pL;
+   delete [] m_pCoef;
+   m_pU = pU;
+   m_pF = pF;
+   m_pAlpha = pAlpha;
+   m_pL = pL;
+   m_pCoef = pCoef;
+
+   //the inverse of the rbf interpolation matrix is copied, if in use
+   if(m_Type == SRG_ENGINE_RBF)
+   {
+      NEW_PRINT("double *", size);
+      pMinv = new double *[size];
+      MEM_CHECK(pMinv);
+      for(i = 0; i < size; i++)
+      {
+         NEW_PRINT("double", size);
+         pMinv[i] = new double[size];
+         MEM_CHECK(pMinv[i]);
+         if(i < m_MinvSize)
+         {
+            memcpy(pMinv[i], m_pMinv[i], sizeof(double)*m_MinvSize);
+         }
+      }
+      for(i = 0; i < m_MinvSize; i++) delete [] m_pMinv[i];
+      delete [] m_pMinv;
+      m_pMinv = pMinv;
+      m_MinvSize = size;
+   }/* end if() */
+
+   delete [] m_pWork;
+   delete [] m_pWork2;
+   NEW_PRINT("double", size);
+   m_pWork = new double[size];
+   MEM_CHECK(m_pWork);
+   NEW_PRINT("double", size);
+   m_pWork2 = new double[size];
+   MEM_CHECK(m_pWork2);
+
+   m_MaxPts = maxPts;
+} /* end Grow() */
+
+/******************************************************************************
+Normalize()
+
+Scale a parameter set to the unit hypercube.
+******************************************************************************/
+void SurrogateEngine::Normalize(double * pX, double * pU)
+{
+   int j;
+
+   for(j = 0; j < m_NumParams; j++)
+   {
+      pU[j] = (pX[j] - m_pLwr[j]) / m_pRange[j];
+   }
+} /* end Normalize() */
+
+/******************************************************************************
+Kernel()
+
+Squared-exponential kernel (gp) or cubic radial basis function (rbf) of two
+scaled parameter sets.
+******************************************************************************/
+double SurrogateEngine::Kernel(double * pU, double * pV)
+{
+   int j;
+   double d, r2;
+
+   r2 = 0.00;
+   for(j = 0; j < m_NumParams; j++)
+   {
+      d = pU[j] - pV[j];
+      r2 += d*d;
+   }
+   if(m_Type == SRG_ENGINE_GP)
+   {
+      return exp(-0.5*r2/(m_Length*m_Length));
+   }
+   return r2*sqrt(r2);
+} /* end Kernel() */
+
+/******************************************************************************
+MinDist()
+
+Distance from a scaled parameter set to the nearest stored point.
+******************************************************************************/
+double SurrogateEngine::MinDist(double * pU)
+{
+   int i, j;
+   double d, r2, dmin;
+   double * pV;
+
+   dmin = NEARLY_HUGE;
+   for(i = 0; i < m_NumPts; i++)
+   {
+      pV = &(m_pU[i*m_NumParams]);
+      r2 = 0.00;
+      for(j = 0; j < m_NumParams; j++)
+      {
+         d = pU[j] - pV[j];
+         r2 += d*d;
+      }
+      if(r2 < dmin) dmin = r2;
+   }
+   return ((dmin < NEARLY_HUGE) ? sqrt(dmin) : dmin);
+} /* end MinDist() */
+
+/******************************************************************************
+AddModelRun()
+
+Add the result of a complex model run, at the current parameter values. In
+parallel, the run is also kept for the next Synchronize(), if the algorithm
+has called EnableSync().
+******************************************************************************/
+void SurrogateEngine::AddModelRun(double f)
+{
+   int n, nprocs;
+
+   m_pGroup->ReadParams(m_pX);
+   AddPoint(m_pX, f);
+
+   //remember the run, so that it can be shared with other processors
+   if(m_bSync == false) return;
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   if(nprocs == 1) return;
+
+   n = m_NumParams + 1;
+   if(m_NumPending == m_MaxPending)
+   {
+      double * pTmp;
+      m_MaxPending = (m_MaxPending == 0) ? SRG_INIT_PTS : 2*m_MaxPending;
+      NEW_PRINT("double", m_MaxPending*n);
+      pTmp = new double[m_MaxPending*n];
+      MEM_CHECK(pTmp);
+      if(m_NumPending > 0) memcpy(pTmp, m_pPending, sizeof(double)*m_NumPending*n);
+      delete [] m_pPending;
+      m_pPending = pTmp;
+   }
+   memcpy(&(m_pPending[m_NumPending*n]), m_pX, sizeof(double)*m_NumParams);
+   m_pPending[m_NumPending*n + m_NumParams] = f;
+   m_NumPending++;
+} /* end AddModelRun() */
+
+/******************************************************************************
+AddPoint()
+
+Add a parameter set and its objective function value. Failed runs and
+duplicate points are ignored. Once enough points are available the surrogate
+is built; afterwards it is extended by one point at a time, and rebuilt from
+scratch whenever the number of points has doubled.
+******************************************************************************/
+void SurrogateEngine::AddPoint(double * pX, double f)
+{
+   if((f != f) || (f >= NEARLY_HUGE) || (f <= -NEARLY_HUGE)) return;
+
+   if(m_NumPts == m_MaxPts) Grow();
+   Normalize(pX, &(m_pU[m_NumPts*m_NumParams]));
+   Insert(f);
+} /* end AddPoint() */
+
+/******************************************************************************
+Insert()
+
+Insert the (scaled) point stored in the next free row of m_pU.
+******************************************************************************/
+void SurrogateEngine::Insert(double f)
+{
+   double * pU;
+   bool bOk;
+
+   pU = &(m_pU[m_NumPts*m_NumParams]);
+   if(MinDist(pU) < SRG_MIN_DIST)
+   {
+      m_NumRejected++;
+      return;
+   }
+   m_pF[m_NumPts] = f;
+   m_NumPts++;
+
+   if(m_NumPts < m_MinPts) return;
+   if((m_NumFit == 0) || (m_NumPts >= 2*m_LastRefit))
+   {
+      Refit();
+      return;
+   }
+
+   if(m_Type == SRG_ENGINE_GP) bOk = AppendGP();
+   else                        bOk = AppendRBF();
+
+   //drop a point that would make the surrogate ill-conditioned
+   if(bOk == false)
+   {
+      m_NumPts--;
+      m_NumRejected++;
+      return;
+   }
+   m_NumFit++;
+   Solve();
+} /* end Insert() */
+
+/******************************************************************************
+Refit()
+
+Build the surrogate from all stored points.
+******************************************************************************/
+void SurrogateEngine::Refit(void)
+{
+   bool bOk;
+
+   if(m_Type == SRG_ENGINE_GP) bOk = RefitGP();
+   else                        bOk = RefitRBF();
+   m_NumRefits++;
+
+   m_NumFit = 0;
+   if(bOk == true)
+   {
+      m_NumFit = m_NumPts;
+      m_LastRefit = m_NumPts;
+      Solve();
+   }
+} /* end Refit() */
+
+/******************************************************************************
+LogLikelihoodGP()
+
+Log marginal likelihood (up to a constant) of the standardized objective
+function values, given the Cholesky factor of the covariance matrix.
+******************************************************************************/
+double SurrogateEngine::LogLikelihoodGP(double ** pL, int n)
+{
+   int i, k;
+   double sum, ll;
+
+   ll = 0.00;
+   for(i = 0; i < n; i++)
+   {
+      sum = (m_pF[i] - m_Mean)/m_Scale;
+      for(k = 0; k < i; k++) sum -= pL[i][k]*m_pWork[k];
+      m_pWork[i] = sum / pL[i][i];
+      ll -= 0.5*m_pWork[i]*m_pWork[i] + log(pL[i][i]);
+   }
+   return ll;
+} /* end LogLikelihoodGP() */
+
+/******************************************************************************
+RefitGP()
+
+Factor the covariance matrix of all stored points, for each candidate length
+scale, and keep the factor with the largest marginal likelihood.
+******************************************************************************/
+bool SurrogateEngine::RefitGP(void)
+{
+   int i, j, k, n;
+   double ** A, ** L, ** LT;
+   double ll, best, len;
+   bool bFound;
+
+   n = m_NumPts;
+   m_Mean = CalcMean(m_pF, n);
+   m_Scale = CalcStdDev(m_pF, n, CENTRAL_TEND_MEAN);
+   if(m_Scale <= 0.00) m_Scale = 1.00;
+
+   NEW_PRINT("double *", 3*n);
+   A = new double *[n];
+   L = new double *[n];
+   LT = new double *[n];
+   MEM_CHECK(LT);
+   for(i = 0; i < n; i++)
+   {
+      NEW_PRINT("double", 3*n);
+      A[i] = new double[n];
+      L[i] = new double[n];
+      LT[i] = new double[n];
+      MEM_CHECK(LT[i]);
+   }
+
+   bFound = false;
+   best = -NEARLY_HUGE;
+   len = m_Length;
+   for(k = 0; k < SRG_NUM_LENGTHS; k++)
+   {
+      m_Length = gSrgLengths[k]*sqrt((double)m_NumParams);
+      for(i = 0; i < n; i++)
+      {
+         for(j = 0; j <= i; j++)
+         {
+            A[i][j] = A[j][i] = Kernel(&(m_pU[i*m_NumParams]), &(m_pU[j*m_NumParams]));
+         }
+         A[i][i] += SRG_NUGGET;
+      }
+      //skip length scales for which the matrix is not positive definite
+      if(CholeskyDecomp(A, L, LT, n) >= 2) continue;
+
+      ll = LogLikelihoodGP(L, n);
+      if(ll > best)
+      {
+         best = ll;
+         len = m_Length;
+         bFound = true;
+         for(i = 0; i < n; i++)
+         {
+            if(m_pL[i] == NULL)
+            {
+               NEW_PRINT("double", i+1);
+               m_pL[i] = new double[i+1];
+               MEM_CHECK(m_pL[i]);
+            }
+            memcpy(m_pL[i], L[i], sizeof(double)*(i+1));
+         }
+      }/* end if() */
+   }/* end for() */
+   m_Length = len;
+
+   for(i = 0; i < n; i++)
+   {
+      delete [] A[i];
+      delete [] L[i];
+      delete [] LT[i];
+   }
+   delete [] A;
+   delete [] L;
+   delete [] LT;
+
+   return bFound;
+} /* end RefitGP() */
+
+/******************************************************************************
+AppendGP()
+
+Extend the Cholesky factor with the row of the newest point:
+   L*l = k,  d = sqrt(k(x,x) - l'l)
+******************************************************************************/
+bool SurrogateEngine::AppendGP(void)
+{
+   int i, j, k;
+   double sum, d2;
+   double * pU;
+
+   i = m_NumFit;
+   pU = &(m_pU[i*m_NumParams]);
+
+   d2 = 1.00 + SRG_NUGGET;
+   for(j = 0; j < i; j++)
+   {
+      sum = Kernel(pU, &(m_pU[j*m_NumParams]));
+      for(k = 0; k < j; k++) sum -= m_pL[j][k]*m_pWork[k];
+      m_pWork[j] = sum / m_pL[j][j];
+      d2 -= m_pWork[j]*m_pWork[j];
+   }
+   if(d2 <= SRG_MIN_PIVOT) return false;
+
+   if(m_pL[i] == NULL)
+   {
+      NEW_PRINT("double", i+1);
+      m_pL[i] = new double[i+1];
+      MEM_CHECK(m_pL[i]);
+   }
+   memcpy(m_pL[i], m_pWork, sizeof(double)*i);
+   m_pL[i][i] = sqrt(d2);
+   return true;
+} /* end AppendGP() */
+
+/******************************************************************************
+RefitRBF()
+
+Invert the interpolation matrix of all stored points. The matrix is ordered
+as the linear tail followed by the points:
+
+      | 0  P' |
+      | P  F  |   where P(i) = [1 x(i)] and F(i,j) = |x(i) - x(j)|^3
+******************************************************************************/
+bool SurrogateEngine::RefitRBF(void)
+{
+   int i, j, n, m, t;
+   double ** M;
+   double * pU;
+   bool bOk;
+
+   n = m_NumPts;
+   t = m_NumParams + 1;
+   m = t + n;
+
+   NEW_PRINT("double *", m);
+   M = new double *[m];
+   MEM_CHECK(M);
+   for(i = 0; i < m; i++)
+   {
+      NEW_PRINT("double", m);
+      M[i] = new double[m];
+      MEM_CHECK(M[i]);
+   }
+
+   for(i = 0; i < t; i++)
+   {
+      for(j = 0; j < t; j++) M[i][j] = 0.00;
+   }
+   for(i = 0; i < n; i++)
+   {
+      pU = &(m_pU[i*m_NumParams]);
+      M[t+i][0] = M[0][t+i] = 1.00;
+      for(j = 0; j < m_NumParams; j++) M[t+i][1+j] = M[1+j][t+i] = pU[j];
+      for(j = 0; j <= i; j++)
+      {
+         M[t+i][t+j] = M[t+j][t+i] = Kernel(pU, &(m_pU[j*m_NumParams]));
+      }
+   }
+
+   bOk = MatInv(M, m_pMinv, m);
+   //free the work space of the inversion
+   MatInv(NULL, NULL, 0);
+
+   for(i = 0; i < m; i++) delete [] M[i];
+   delete [] M;
+
+   return bOk;
+} /* end RefitRBF() */
+
+/******************************************************************************
+AppendRBF()
+
+Extend the inverse of the interpolation matrix with the newest point, using the
+bordering method. With b the new column, w = inv(M)*b and s = -b'w:
+
+   inv(M') = | inv(M) + ww'/s   -w/s |
+             |     -w'/s         1/s |
+******************************************************************************/
+bool SurrogateEngine::AppendRBF(void)
+{
+   int i, j, m, t;
+   double s;
+   double * pU, * b, * w;
+
+   t = m_NumParams + 1;
+   m = t + m_NumFit;
+   b = m_pWork;
+   w = m_pWork2;
+   pU = &(m_pU[m_NumFit*m_NumParams]);
+
+   b[0] = 1.00;
+   for(j = 0; j < m_NumParams; j++) b[1+j] = pU[j];
+   for(j = 0; j < m_NumFit; j++) b[t+j] = Kernel(pU, &(m_pU[j*m_NumParams]));
+
+   s = 0.00;
+   for(i = 0; i < m; i++)
+   {
+      w[i] = 0.00;
+      for(j = 0; j < m; j++) w[i] += m_pMinv[i][j]*b[j];
+      s -= b[i]*w[i];
+   }
+   if(fabs(s) <= SRG_MIN_PIVOT) return false;
+
+   for(i = 0; i < m; i++)
+   {
+      for(j = 0; j < m; j++) m_pMinv[i][j] += w[i]*w[j]/s;
+      m_pMinv[i][m] = m_pMinv[m][i] = -w[i]/s;
+   }
+   m_pMinv[m][m] = 1.00/s;
+   return true;
+} /* end AppendRBF() */
+
+/******************************************************************************
+Solve()
+
+Compute the weights (gp) or coefficients (rbf) of the surrogate, given the
+factored or inverted matrix.
+******************************************************************************/
+void SurrogateEngine::Solve(void)
+{
+   int i, k, n, t, m;
+   double sum;
+
+   n = m_NumFit;
+   m_Fmin = NEARLY_HUGE;
+   for(i = 0; i < n; i++)
+   {
+      if(m_pF[i] < m_Fmin) m_Fmin = m_pF[i];
+   }
+
+   if(m_Type == SRG_ENGINE_GP)
+   {
+      m_Mean = CalcMean(m_pF, n);
+      m_Scale = CalcStdDev(m_pF, n, CENTRAL_TEND_MEAN);
+      if(m_Scale <= 0.00) m_Scale = 1.00;
+
+      //forward (L*z = y) and backward (L'*alpha = z) substitution
+      for(i = 0; i < n; i++)
+      {
+         sum = (m_pF[i] - m_Mean)/m_Scale;
+         for(k = 0; k < i; k++) sum -= m_pL[i][k]*m_pWork[k];
+         m_pWork[i] = sum / m_pL[i][i];
+      }
+      for(i = n - 1; i >= 0; i--)
+      {
+         sum = m_pWork[i];
+         for(k = i + 1; k < n; k++) sum -= m_pL[k][i]*m_pAlpha[k];
+         m_pAlpha[i] = sum / m_pL[i][i];
+      }
+   }
+   else
+   {
+      t = m_NumParams + 1;
+      m = t + n;
+      for(i = 0; i < m; i++)
+      {
+         sum = 0.00;
+         for(k = 0; k < n; k++) sum += m_pMinv[i][t+k]*m_pF[k];
+         m_pCoef[i] = sum;
+      }
+   }
+} /* end Solve() */
+
+/******************************************************************************
+PredictScaled()
+
+Predict the objective function value at a scaled parameter set. For the gp, the
+standard deviation of the prediction is also computed, if requested. The rbf
+provides no such estimate (zero is returned).
+******************************************************************************/
+double SurrogateEngine::PredictScaled(double * pU, double * pSigma)
+{
+   int i, j, k, n, t;
+   double mu, sum, var;
+
+   n = m_NumFit;
+   if(pSigma != NULL) *pSigma = 0.00;
+
+   if(m_Type == SRG_ENGINE_GP)
+   {
+      mu = 0.00;
+      for(i = 0; i < n; i++)
+      {
+         m_pWork2[i] = Kernel(pU, &(m_pU[i*m_NumParams]));
+         mu += m_pWork2[i]*m_pAlpha[i];
+      }
+      if(pSigma != NULL)
+      {
+         var = 1.00;
+         for(i = 0; i < n; i++)
+         {
+            sum = m_pWork2[i];
+            for(k = 0; k < i; k++) sum -= m_pL[i][k]*m_pWork[k];
+            m_pWork[i] = sum / m_pL[i][i];
+            var -= m_pWork[i]*m_pWork[i];
+         }
+         *pSigma = m_Scale*sqrt(MyMax(var, 0.00));
+      }
+      return m_Mean + m_Scale*mu;
+   }
+
+   t = m_NumParams + 1;
+   mu = m_pCoef[0];
+   for(j = 0; j < m_NumParams; j++) mu += m_pCoef[1+j]*pU[j];
+   for(i = 0; i < n; i++) mu += m_pCoef[t+i]*Kernel(pU, &(m_pU[i*m_NumParams]));
+   return mu;
+} /* end PredictScaled() */
+
+/******************************************************************************
+Predict()
+
+Predict the objective function value of a parameter set. Only meaningful once
+the surrogate is ready (see IsReady()).
+******************************************************************************/
+double SurrogateEngine::Predict(double * pX, double * pSigma)
+{
+   if(IsReady() == false)
+   {
+      if(pSigma != NULL) *pSigma = 0.00;
+      return m_Fmin;
+   }
+   Normalize(pX, m_pX);
+   return PredictScaled(m_pX, pSigma);
+} /* end Predict() */
+
+/******************************************************************************
+Screen()
+
+Select the most promising of a set of candidate parameter sets (stored row by
+row in pCands) and return its index. Candidates that duplicate an evaluated
+point are never selected, unless all of them do.
+******************************************************************************/
+int SurrogateEngine::Screen(double * pCands, int nCands)
+{
+   int i, best;
+   double mu, sd, z, ei, dist, w, score;
+   double bestEI, bestMu, muMin, muMax, dMin, dMax;
+   double * pMu, * pDist;
+
+   if((IsReady() == false) || (nCands <= 1)) return 0;
+   m_NumScreens++;
+   m_NumScreened += (double)nCands;
+
+   best = 0;
+   if(m_Type == SRG_ENGINE_GP)
+   {
+      //largest expected improvement, ties are broken by the predicted value
+      bestEI = -1.00;
+      bestMu = NEARLY_HUGE;
+      for(i = 0; i < nCands; i++)
+      {
+         Normalize(&(pCands[i*m_NumParams]), m_pX);
+         if(MinDist(m_pX) < SRG_MIN_DIST) continue;
+         mu = PredictScaled(m_pX, &sd);
+         if(sd > 0.00)
+         {
+            z = (m_Fmin - mu)/sd;
+            ei = (m_Fmin - mu)*StdNormCDF(z) + sd*StdNormPDF(z);
+         }
+         else
+         {
+            ei = MyMax(m_Fmin - mu, 0.00);
+         }
+         if((ei > bestEI) || ((ei == bestEI) && (mu < bestMu)))
+         {
+            bestEI = ei;
+            bestMu = mu;
+            best = i;
+         }
+      }/* end for() */
+      return best;
+   }/* end if(gp) */
+
+   //weighted score of the predicted value and the distance from evaluated points
+   NEW_PRINT("double", 2*nCands);
+   pMu = new double[nCands];
+   pDist = new double[nCands];
+   MEM_CHECK(pDist);
+
+   muMin = dMin = NEARLY_HUGE;
+   muMax = dMax = -NEARLY_HUGE;
+   for(i = 0; i < nCands; i++)
+   {
+      Normalize(&(pCands[i*m_NumParams]), m_pX);
+      pDist[i] = MinDist(m_pX);
+      pMu[i] = PredictScaled(m_pX, NULL);
+      if(pDist[i] < SRG_MIN_DIST) continue;
+      muMin = MyMin(muMin, pMu[i]);
+      muMax = MyMax(muMax, pMu[i]);
+      dMin = MyMin(dMin, pDist[i]);
+      dMax = MyMax(dMax, pDist[i]);
+   }
+
+   w = gSrgWeights[m_Cycle % SRG_NUM_WEIGHTS];
+   m_Cycle++;
+   bestMu = NEARLY_HUGE;
+   for(i = 0; i < nCands; i++)
+   {
+      if(pDist[i] < SRG_MIN_DIST) continue;
+      mu = (muMax > muMin) ? (pMu[i] - muMin)/(muMax - muMin) : 1.00;
+      dist = (dMax > dMin) ? (dMax - pDist[i])/(dMax - dMin) : 1.00;
+      score = w*mu + (1.00 - w)*dist;
+      if(score < bestMu)
+      {
+         bestMu = score;
+         best = i;
+      }
+   }
+
+   delete [] pMu;
+   delete [] pDist;
+   return best;
+} /* end Screen() */
+
+/******************************************************************************
+Synchronize()
+
+Share the model runs of each processor with all other processors. Must be
+called by all processors, after EnableSync().
+******************************************************************************/
+void SurrogateEngine::Synchronize(void)
+{
+   int i, k, n, num, rank, nprocs;
+   double * pBuf;
+
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   if(nprocs == 1) return;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   n = m_NumParams + 1;
+   for(i = 0; i < nprocs; i++)
+   {
+      num = m_NumPending;
+      MPI_Bcast(&num, 1, MPI_INT, i, MPI_COMM_WORLD);
+      if(num == 0) continue;
+
+      if(i == rank)
+      {
+         MPI_Bcast(m_pPending, num*n, MPI_DOUBLE, i, MPI_COMM_WORLD);
+         continue;
+      }
+      NEW_PRINT("double", num*n);
+      pBuf = new double[num*n];
+      MEM_CHECK(pBuf);
+      MPI_Bcast(pBuf, num*n, MPI_DOUBLE, i, MPI_COMM_WORLD);
+      for(k = 0; k < num; k++)
+      {
+         AddPoint(&(pBuf[k*n]), pBuf[k*n + m_NumParams]);
+      }
+      delete [] pBuf;
+   }/* end for() */
+   m_NumPending = 0;
+} /* end Synchronize() */
+
+/******************************************************************************
+WriteCheckpoint()
+
+Save the points of the surrogate, in the order in which they were accepted.
+Runs that have not yet been shared with other processors are not saved, since
+checkpoints are only written in serial runs.
+******************************************************************************/
+void SurrogateEngine::WriteCheckpoint(Checkpoint * pCkpt)
+{
+   pCkpt->WriteInt(m_NumPts);
+   pCkpt->WriteDoubles(m_pU, m_NumPts*m_NumParams);
+   pCkpt->WriteDoubles(m_pF, m_NumPts);
+   pCkpt->WriteInt(m_NumRejected);
+   pCkpt->WriteInt(m_NumRefits);
+   pCkpt->WriteInt(m_NumScreens);
+   pCkpt->WriteDouble(m_NumScreened);
+   pCkpt->WriteInt(m_Cycle);
+} /* end WriteCheckpoint() */
+
+/******************************************************************************
+ReadCheckpoint()
+
+Rebuild the surrogate by inserting the saved points in their original order,
+which reproduces the factorizations (and refits) of the checkpointed run.
+******************************************************************************/
+void SurrogateEngine::ReadCheckpoint(Checkpoint * pCkpt)
+{
+   int i, num;
+   double * pU, * pF;
+
+   num = pCkpt->ReadInt();
+
+   NEW_PRINT("double", num*m_NumParams + 1);
+   pU = new double[num*m_NumParams + 1];
+   MEM_CHECK(pU);
+
+   NEW_PRINT("double", num + 1);
+   pF = new double[num + 1];
+   MEM_CHECK(pF);
+
+   pCkpt->ReadDoubles(pU, num*m_NumParams);
+   pCkpt->ReadDoubles(pF, num);
+
+   m_NumPts = 0;
+   m_NumFit = 0;
+   m_LastRefit = 0;
+   for(i = 0; i < num; i++)
+   {
+      if(m_NumPts == m_MaxPts) Grow();
+      memcpy(&(m_pU[m_NumPts*m_NumParams]), &(pU[i*m_NumParams]), sizeof(double)*m_NumParams);
+      Insert(pF[i]);
+   }
+   delete [] pU;
+   delete [] pF;
+
+   m_NumRejected = pCkpt->ReadInt();
+   m_NumRefits = pCkpt->ReadInt();
+   m_NumScreens = pCkpt->ReadInt();
+   m_NumScreened = pCkpt->ReadDouble();
+   m_Cycle = pCkpt->ReadInt();
+} /* end ReadCheckpoint() */
+
+/******************************************************************************
+WriteMetrics()
+
+Write out metrics of the engine.
+******************************************************************************/
+void SurrogateEngine::WriteMetrics(FILE * pFile)
+{
+   if(m_Type == SRG_ENGINE_GP)
+   {
+      fprintf(pFile, "Surrogate Engine        : Gaussian process\n");
+      fprintf(pFile, "GP Length Scale         : %lf\n", m_Length);
+   }
+   else
+   {
+      fprintf(pFile, "Surrogate Engine        : cubic RBF\n");
+   }
+   fprintf(pFile, "Surrogate Points        : %d\n", m_NumFit);
+   fprintf(pFile, "Rejected Points         : %d\n", m_NumRejected);
+   fprintf(pFile, "Surrogate Refits        : %d\n", m_NumRefits);
+   fprintf(pFile, "Candidate Screenings    : %d\n", m_NumScreens);
+   fprintf(pFile, "Candidates Screened     : %.0lf\n", m_NumScreened);
+} /* end WriteMetrics() */
@@ -9,6 +9,8 @@ are simpler versions of the standard (complex) model.
 
 Version History
 04-04-06    lsm   added copyright information and initial comments.
+10-19-26    lsm   model is run with RunModelCommand(), so that a stop request
+                  cancels a run that is in progress.
 ******************************************************************************/
 #include <string>
 #include <mpi.h>
@@ -21,6 +23,7 @@ Version History
 #include "ObjectiveFunction.h"
 #include "FilePair.h"
 
+#include "StopSignal.h"
 #include "Exception.h"
 #include "Utility.h"
 
@@ -341,7 +344,12 @@ double SurrogateModel::Execute(void)
    if(dirName[0] != '.') { MY_CHDIR(dirName);}   
 
    //invoke system command to execute the model   
-   system(m_ExecCmd);
+   if(RunModelCommand(m_ExecCmd) == MODEL_CANCELLED)
+   {
+      //in-flight run was cancelled by a stop request
+      if(dirName[0] != '.') { MY_CHDIR("..");}
+      return NEARLY_HUGE;
+   }
 
    //extract computed observations from model output file(s)
    if(m_pObsGroup != NULL){ m_pObsGroup->ExtractVals();}
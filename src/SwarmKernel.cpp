@@ -0,0 +1,388 @@
+/******************************************************************************
+File     : SwarmKernel.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+Storage and update kernel of a particle swarm. See SwarmKernel.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   added surrogate pre-screening of particle moves
+10-19-26    lsm   added WriteCheckpoint() and ReadCheckpoint()
+******************************************************************************/
+#include <math.h>
+#include <string.h>
+
+#include "SwarmKernel.h"
+#include "SurrogateEngine.h"
+#include "Checkpoint.h"
+
+#include "Utility.h"
+#include "Exception.h"
+
+/******************************************************************************
+CTOR
+
+Allocate the swarm matrices. Positions and velocities start at zero.
+******************************************************************************/
+SwarmKernel::SwarmKernel(int numParticles, int numParams, int numSpecial)
+{
+   size_t nx, nc;
+   int j;
+
+   m_NumParticles = numParticles;
+   m_NumParams = numParams;
+   m_NumSpecial = numSpecial;
+   m_NumUprViols = 0;
+   m_NumLwrViols = 0;
+   m_pSrg = NULL;
+   m_NumCands = 0;
+   m_pCandX = NULL;
+   m_pCandV = NULL;
+   m_pCandViols = NULL;
+
+   nx = (size_t)numParticles*(size_t)numParams;
+   nc = (size_t)numParticles*(size_t)numSpecial;
+
+   NEW_PRINT("double", nx);
+   m_pX = new double[nx];
+   MEM_CHECK(m_pX);
+
+   NEW_PRINT("double", nx);
+   m_pV = new double[nx];
+   MEM_CHECK(m_pV);
+
+   NEW_PRINT("double", nx);
+   m_pB = new double[nx];
+   MEM_CHECK(m_pB);
+
+   NEW_PRINT("double", numParticles);
+   m_pFx = new double[numParticles];
+   MEM_CHECK(m_pFx);
+
+   NEW_PRINT("double", numParticles);
+   m_pFb = new double[numParticles];
+   MEM_CHECK(m_pFb);
+
+   NEW_PRINT("double", nc);
+   m_pCx = new double[nc];
+   MEM_CHECK(m_pCx);
+
+   NEW_PRINT("double", nc);
+   m_pCb = new double[nc];
+   MEM_CHECK(m_pCb);
+
+   NEW_PRINT("double", numParams);
+   m_pLwr = new double[numParams];
+   MEM_CHECK(m_pLwr);
+
+   NEW_PRINT("double", numParams);
+   m_pUpr = new double[numParams];
+   MEM_CHECK(m_pUpr);
+
+   NEW_PRINT("double", numParams);
+   m_pReal = new double[numParams];
+   MEM_CHECK(m_pReal);
+
+   NEW_PRINT("double", 3*numParams);
+   m_pRand = new double[3*numParams];
+   MEM_CHECK(m_pRand);
+
+   memset(m_pX, 0, sizeof(double)*nx);
+   memset(m_pV, 0, sizeof(double)*nx);
+   memset(m_pB, 0, sizeof(double)*nx);
+   memset(m_pCx, 0, sizeof(double)*nc);
+   memset(m_pCb, 0, sizeof(double)*nc);
+   for(j = 0; j < numParticles; j++)
+   {
+      m_pFx[j] = m_pFb[j] = NEARLY_HUGE;
+   }
+   for(j = 0; j < numParams; j++)
+   {
+      m_pLwr[j] = -NEARLY_HUGE;
+      m_pUpr[j] = NEARLY_HUGE;
+      m_pReal[j] = 1.00;
+   }
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+
+Free up the swarm matrices.
+******************************************************************************/
+void SwarmKernel::Destroy(void)
+{
+   delete [] m_pX;
+   delete [] m_pV;
+   delete [] m_pB;
+   delete [] m_pFx;
+   delete [] m_pFb;
+   delete [] m_pCx;
+   delete [] m_pCb;
+   delete [] m_pLwr;
+   delete [] m_pUpr;
+   delete [] m_pReal;
+   delete [] m_pRand;
+   delete [] m_pCandX;
+   delete [] m_pCandV;
+   delete [] m_pCandViols;
+
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+SetBounds()
+
+Cache the bounds and type of the j-th parameter.
+******************************************************************************/
+void SwarmKernel::SetBounds(int j, double lwr, double upr, bool bReal)
+{
+   m_pLwr[j] = lwr;
+   m_pUpr[j] = upr;
+   m_pReal[j] = (bReal ? 1.00 : 0.00);
+} /* end SetBounds() */
+
+/******************************************************************************
+SetScreen()
+
+Attach a surrogate engine, used to pre-screen the moves of each particle.
+******************************************************************************/
+void SwarmKernel::SetScreen(SurrogateEngine * pSrg)
+{
+   size_t nx;
+
+   m_pSrg = pSrg;
+   if(pSrg == NULL) return;
+
+   m_NumCands = pSrg->GetNumCandidates();
+   nx = (size_t)m_NumCands*(size_t)m_NumParams;
+
+   NEW_PRINT("double", nx);
+   m_pCandX = new double[nx];
+   MEM_CHECK(m_pCandX);
+
+   NEW_PRINT("double", nx);
+   m_pCandV = new double[nx];
+   MEM_CHECK(m_pCandV);
+
+   NEW_PRINT("int", 2*m_NumCands);
+   m_pCandViols = new int[2*m_NumCands];
+   MEM_CHECK(m_pCandViols);
+} /* end SetScreen() */
+
+/******************************************************************************
+Move()
+
+Revise the velocities and positions of all particles, given the generation
+number (starting at 0) and the index of the globally best particle:
+
+   v = K*(w*v + c1*r1*(b - x) + c2*r2*(g - x))
+
+Velocities smaller than a minimum perturbation are replaced by a randomized
+minimum move, to prevent stagnation. The random weights of a particle are
+drawn in bulk; the direction of a minimum move is only drawn when needed. If
+the revised position of a particle violates the parameter limits, its move is
+shortened (by the same fraction in all dimensions, so that the direction of
+movement is preserved).
+
+If a ready surrogate engine is attached, each particle draws several candidate
+moves and the engine selects the one that is made.
+******************************************************************************/
+void SwarmKernel::Move(int gen, int bestIdx, double constrict, double inertia, double c1, double c2)
+{
+   int i, k, n, nupr, nlwr;
+   double * x, * v, * g, scale;
+   size_t sz;
+
+   n = m_NumParams;
+   sz = sizeof(double)*n;
+   g = GetB(bestIdx);
+   scale = 0.01/(double)(gen + 1);
+
+   for(i = 0; i < m_NumParticles; i++)
+   {
+      x = GetX(i);
+      v = GetV(i);
+      if((m_pSrg == NULL) || (m_pSrg->IsReady() == false))
+      {
+         MoveParticle(x, v, GetB(i), g, scale, constrict, inertia, c1, c2, &nupr, &nlwr);
+         m_NumUprViols += nupr;
+         m_NumLwrViols += nlwr;
+         continue;
+      }
+
+      //candidate moves, each starting from the current position and velocity
+      for(k = 0; k < m_NumCands; k++)
+      {
+         memcpy(&(m_pCandX[k*n]), x, sz);
+         memcpy(&(m_pCandV[k*n]), v, sz);
+         MoveParticle(&(m_pCandX[k*n]), &(m_pCandV[k*n]), GetB(i), g, scale,
+                      constrict, inertia, c1, c2, &(m_pCandViols[2*k]), &(m_pCandViols[2*k+1]));
+      }
+      k = m_pSrg->Screen(m_pCandX, m_NumCands);
+      memcpy(x, &(m_pCandX[k*n]), sz);
+      memcpy(v, &(m_pCandV[k*n]), sz);
+      m_NumUprViols += m_pCandViols[2*k];
+      m_NumLwrViols += m_pCandViols[2*k+1];
+   }/* end for() */
+} /* end Move() */
+
+/******************************************************************************
+MoveParticle()
+
+Revise the velocity (v) and position (x) of a particle, given its local best
+(b), the global best (g) and the scale of the minimum perturbation. The number
+of upper and lower limit violations of the move are returned.
+******************************************************************************/
+void SwarmKernel::MoveParticle(double * x, double * v, double * b, double * g, double scale,
+                               double constrict, double inertia, double c1, double c2,
+                               int * pNumUpr, int * pNumLwr)
+{
+   int j, n, nupr, nlwr;
+   double * r1, * r2, * vmin;
+   double sgn, xn, fupr, flwr, dxmin;
+
+   n = m_NumParams;
+   r1 = m_pRand;
+   r2 = &(m_pRand[n]);
+   vmin = &(m_pRand[2*n]);
+
+   //random weights of the particle
+   for(j = 0; j < 2*n; j++)
+   {
+      m_pRand[j] = (double)MyRand() / (double)MY_RAND_MAX;
+   }
+
+   //revised velocity and minimum perturbation
+   for(j = 0; j < n; j++)
+   {
+      v[j] = constrict*((inertia*v[j]) + c1*r1[j]*(b[j]-x[j]) + c2*r2[j]*(g[j]-x[j]));
+      vmin[j] = (m_pReal[j] > 0.50) ? (scale*fabs(x[j])) : 0.50;
+   }
+
+   //randomized minimum velocity (rare, so the direction is drawn on demand)
+   for(j = 0; j < n; j++)
+   {
+      if(fabs(v[j]) < vmin[j])
+      {
+         sgn = (double)MyRand() / (double)MY_RAND_MAX;
+         if(sgn >= 0.50) v[j] = +((1.00+r1[j])*vmin[j]);
+         else            v[j] = -((1.00+r2[j])*vmin[j]);
+      }
+   }
+
+   //most restrictive fraction of the move that respects the limits
+   dxmin = 1.00;
+   nupr = nlwr = 0;
+   for(j = 0; j < n; j++)
+   {
+      xn = x[j] + v[j];
+      fupr = (xn > m_pUpr[j]) ? fabs((0.5*(m_pUpr[j]-x[j]))/v[j]) : 1.00;
+      flwr = (xn < m_pLwr[j]) ? fabs((0.5*(m_pLwr[j]-x[j]))/v[j]) : 1.00;
+      nupr += (xn > m_pUpr[j]);
+      nlwr += (xn < m_pLwr[j]);
+      dxmin = (fupr < dxmin) ? fupr : dxmin;
+      dxmin = (flwr < dxmin) ? flwr : dxmin;
+   }
+   *pNumUpr = nupr;
+   *pNumLwr = nlwr;
+
+   //revised velocity and position
+   for(j = 0; j < n; j++)
+   {
+      v[j] *= dxmin;
+      x[j] += v[j];
+   }
+} /* end MoveParticle() */
+
+/******************************************************************************
+InitBest()
+
+Initialize the local best of each particle to its current position.
+******************************************************************************/
+void SwarmKernel::InitBest(void)
+{
+   size_t nx, nc;
+
+   nx = (size_t)m_NumParticles*(size_t)m_NumParams;
+   nc = (size_t)m_NumParticles*(size_t)m_NumSpecial;
+
+   memcpy(m_pB, m_pX, sizeof(double)*nx);
+   memcpy(m_pCb, m_pCx, sizeof(double)*nc);
+   memcpy(m_pFb, m_pFx, sizeof(double)*m_NumParticles);
+} /* end InitBest() */
+
+/******************************************************************************
+UpdateBest()
+
+Revise the local best of each particle and the global best (value and index).
+******************************************************************************/
+void SwarmKernel::UpdateBest(int * pBestIdx, double * pBest)
+{
+   int i;
+
+   for(i = 0; i < m_NumParticles; i++)
+   {
+      //revise local best
+      if(m_pFx[i] < m_pFb[i])
+      {
+         memcpy(GetB(i), GetX(i), sizeof(double)*m_NumParams);
+         memcpy(GetCb(i), GetCx(i), sizeof(double)*m_NumSpecial);
+         m_pFb[i] = m_pFx[i];
+      }
+      //revise global best
+      if(*pBest > m_pFx[i])
+      {
+         *pBest = m_pFx[i];
+         *pBestIdx = i;
+      }
+   }/* end for() */
+} /* end UpdateBest() */
+
+/******************************************************************************
+WriteCheckpoint()
+
+Save the swarm matrices and metrics.
+******************************************************************************/
+void SwarmKernel::WriteCheckpoint(Checkpoint * pCkpt)
+{
+   int nx, nc;
+
+   nx = m_NumParticles*m_NumParams;
+   nc = m_NumParticles*m_NumSpecial;
+
+   pCkpt->WriteDoubles(m_pX, nx);
+   pCkpt->WriteDoubles(m_pV, nx);
+   pCkpt->WriteDoubles(m_pB, nx);
+   pCkpt->WriteDoubles(m_pFx, m_NumParticles);
+   pCkpt->WriteDoubles(m_pFb, m_NumParticles);
+   pCkpt->WriteDoubles(m_pCx, nc);
+   pCkpt->WriteDoubles(m_pCb, nc);
+   pCkpt->WriteInt(m_NumUprViols);
+   pCkpt->WriteInt(m_NumLwrViols);
+} /* end WriteCheckpoint() */
+
+/******************************************************************************
+ReadCheckpoint()
+
+Restore the swarm matrices and metrics.
+******************************************************************************/
+void SwarmKernel::ReadCheckpoint(Checkpoint * pCkpt)
+{
+   int nx, nc;
+
+   nx = m_NumParticles*m_NumParams;
+   nc = m_NumParticles*m_NumSpecial;
+
+   pCkpt->ReadDoubles(m_pX, nx);
+   pCkpt->ReadDoubles(m_pV, nx);
+   pCkpt->ReadDoubles(m_pB, nx);
+   pCkpt->ReadDoubles(m_pFx, m_NumParticles);
+   pCkpt->ReadDoubles(m_pFb, m_NumParticles);
+   pCkpt->ReadDoubles(m_pCx, nc);
+   pCkpt->ReadDoubles(m_pCb, nc);
+   m_NumUprViols = pCkpt->ReadInt();
+   m_NumLwrViols = pCkpt->ReadInt();
+} /* end ReadCheckpoint() */
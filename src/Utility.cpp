@@ -23,6 +23,9 @@ Version History
                   programs.
 01-01-07    lsm   Added support for temporary input files which store
                   copies of the surrogate sections of the input file.
+10-19-26    lsm   Added GetRandomState() and SetRandomState(), which save and
+                  restore the random number generator for checkpoints.
+10-19-26    lsm   Added RecvWorkMsg() for the workers of master-worker loops.
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -69,6 +72,9 @@ unsigned int gRandomSeed = 258;
 unsigned int gRandomIndex = 0;
 int gNumRandoms = 0;
 unsigned int * gRandomNumbers = NULL;
+//whether rand() has been seeded and number of calls to rand() since then
+bool gRandSeeded = false;
+unsigned long long gRandCalls = 0;
 
 /* -----------------
 Whether or not a multi-objective algorithm has been selected
@@ -574,8 +580,74 @@ void ResetRandomSeed(unsigned int seed)
 	srand(seed);
    gSeedInitialized = true;   
    gRandomIndex = seed;
+   gRandSeeded = true;
+   gRandCalls = 0;
 }/* end ResetRandomSeed() */
 
+/******************************************************************************
+GetRandomState()
+
+Retrieve the state of the random number generator: the seed, the number of 
+calls to rand() since seeding and the index into the pre-generated random 
+numbers, if any.
+******************************************************************************/
+void GetRandomState(unsigned int * pSeed, unsigned long long * pCalls, unsigned int * pIndex)
+{
+   *pSeed = GetRandomSeed();
+   *pCalls = (gRandSeeded ? gRandCalls : 0);
+   *pIndex = (gRandSeeded ? gRandomIndex : GetRandomSeed());
+}/* end GetRandomState() */
+
+/******************************************************************************
+SetRandomState()
+
+Restore the state of the random number generator, as retrieved by 
+GetRandomState(). The state of rand() is opaque, so the generator is reseeded
+and advanced by the recorded number of calls.
+******************************************************************************/
+void SetRandomState(unsigned int seed, unsigned long long calls, unsigned int index)
+{
+   unsigned long long i;
+
+   ResetRandomSeed(seed);
+   for(i = 0; i < calls; i++){ rand();}
+   gRandCalls = calls;
+   gRandomIndex = index;
+}/* end SetRandomState() */
+
+/******************************************************************************
+RecvWorkMsg()
+
+Worker side of a master-worker loop: wait for the next message from the 
+master processor. This is either a work item (MPI_DATA_TAG) of up to count
+doubles, which is received into pBuf, or a quit message (MPI_QUIT_TAG) of a 
+single double. Returns the tag. A message with any other tag is never decoded
+as a work item, it is an error.
+******************************************************************************/
+int RecvWorkMsg(double * pBuf, int count)
+{
+   MPI_Status mpi_status;
+   double quit;
+   char msg[DEF_STR_SZ];
+
+   MPI_Probe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &mpi_status);
+   if(mpi_status.MPI_TAG == MPI_DATA_TAG)
+   {
+      MPI_Recv(pBuf, count, MPI_DOUBLE, 0, MPI_DATA_TAG, MPI_COMM_WORLD, &mpi_status);
+   }
+   else if(mpi_status.MPI_TAG == MPI_QUIT_TAG)
+   {
+      MPI_Recv(&quit, 1, MPI_DOUBLE, 0, MPI_QUIT_TAG, MPI_COMM_WORLD, &mpi_status);
+   }
+   else
+   {
+      snprintf(msg, DEF_STR_SZ, "RecvWorkMsg(): unexpected message (tag %d) from the master processor", mpi_status.MPI_TAG);
+      LogError(ERR_MISMATCH, msg);
+      ExitProgram(1);
+   }
+   return mpi_status.MPI_TAG;
+}/* end RecvWorkMsg() */
+
 /******************************************************************************
 RestoreRandomSeed()
 
@@ -2163,7 +2235,6 @@ limited to a maximum value less than 2^32-1
 ******************************************************************************/
 unsigned int MyRand(void)
 {
-   static bool set_seed = true;
    static bool check_file = true;
    static bool use_file = false;
    unsigned int r;
@@ -2174,11 +2245,12 @@ unsigned int MyRand(void)
    FILE * pFile;
 
    //on first call, set the random seed
-   if(set_seed == true)
+   if(gRandSeeded == false)
    {
-      set_seed = false;
+      gRandSeeded = true;
 	   srand(GetRandomSeed());
       gRandomIndex = GetRandomSeed();
+      gRandCalls = 0;
    }
 
    //on first call, check for presence of pre-generated random numbers file
@@ -2215,8 +2287,9 @@ unsigned int MyRand(void)
    //normal operation --- use library call
    if(use_file == false)
    {
-      if(RAND_MAX >= MY_RAND_MAX) return rand();
+      if(RAND_MAX >= MY_RAND_MAX){ gRandCalls++; return rand();}
 
+      gRandCalls += 4;
       t1 = (rand() & 0x0000007F) << 24;
       t2 = (rand() & 0x000000FF) << 16;
       t3 = (rand() & 0x000000FF) << 8;
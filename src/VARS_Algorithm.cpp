@@ -9,15 +9,19 @@ Interface class for the VARS plugin, which must be licensed separately.
  
 Version History
 06-18-18    lsm   created file
+10-19-26    lsm   Added a native STAR-VARS engine (see OptimizeNative())
 ******************************************************************************/
 #include <mpi.h>
+#include <math.h>
 #include <string.h>
+#include <algorithm>
 #include "VARS_Algorithm.h"
 #include "Utility.h"
 #include "WriteUtility.h"
 #include "Exception.h"
 #include "Model.h"
 #include "ParameterGroup.h"
+#include "ParameterABC.h"
 #include "ObjectiveFunction.h"
 
 #ifdef _WIN32
@@ -37,6 +41,41 @@ VARS::VARS(ModelABC * pModel)
    m_pModel = pModel;
    m_PluginFile = NULL;
    m_Subroutine = NULL;
+   m_CurIter = 0;
+
+   m_bNative = false;
+   m_NumParams = 0;
+   m_NumStars = 50;
+   m_DeltaH = 0.10;
+   m_NumLags = 0;
+   m_NumBoot = 100;
+   m_ConfLvl = 0.90;
+   m_pLwr = NULL;
+   m_pUpr = NULL;
+   m_pCenter = NULL;
+   m_pOrigin = NULL;
+   m_pLen = NULL;
+   m_pMid = NULL;
+   m_pLeft = NULL;
+   m_pY = NULL;
+   m_pHave = NULL;
+   m_pSum = NULL;
+   m_pCnt = NULL;
+   m_pSecN = NULL;
+   m_pSecMean = NULL;
+   m_pSecM2 = NULL;
+   m_pStarN = NULL;
+   m_pStarMean = NULL;
+   m_pStarM2 = NULL;
+   m_pIdx = NULL;
+   m_pGamma = NULL;
+   m_pBoot = NULL;
+   m_pBest = NULL;
+   m_NextStar = 0;
+   m_NextDim = -1;
+   m_NextPos = 0;
+   m_NumEvals = 0;
+   m_StarsDone = 0;
    
    IncCtorCount();
 }/* end CTOR() */
@@ -51,6 +90,28 @@ void VARS::Destroy(void)
    delete [] m_PluginFile;
    delete [] m_Subroutine;
 
+   delete [] m_pLwr;
+   delete [] m_pUpr;
+   delete [] m_pCenter;
+   delete [] m_pOrigin;
+   delete [] m_pLen;
+   delete [] m_pMid;
+   delete [] m_pLeft;
+   delete [] m_pY;
+   delete [] m_pHave;
+   delete [] m_pSum;
+   delete [] m_pCnt;
+   delete [] m_pSecN;
+   delete [] m_pSecMean;
+   delete [] m_pSecM2;
+   delete [] m_pStarN;
+   delete [] m_pStarMean;
+   delete [] m_pStarM2;
+   delete [] m_pIdx;
+   delete [] m_pGamma;
+   delete [] m_pBoot;
+   delete [] m_pBest;
+
    IncDtorCount();
 }/* end Destroy() */
 
@@ -116,7 +177,67 @@ void VARS::InitFromFile(IroncladString pFileName)
       } /* end while() */
    }/* end if() */
 
+   //native engine
+   rewind(pFile);
+   if (CheckToken(pFile, "BeginVARS", pFileName) == true)
+   {
+      FindToken(pFile, "EndVARS", pFileName);
+      rewind(pFile);
+
+      FindToken(pFile, "BeginVARS", pFileName);
+      line = GetNxtDataLine(pFile, pFileName);
+      while (strstr(line, "EndVARS") == NULL)
+      {
+         if (strstr(line, "NumStars") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumStars);
+         }
+         else if (strstr(line, "DeltaH") != NULL)
+         {
+            sscanf(line, "%s %lf", tmp, &m_DeltaH);
+         }
+         else if (strstr(line, "NumBootstrap") != NULL)
+         {
+            sscanf(line, "%s %d", tmp, &m_NumBoot);
+         }
+         else if (strstr(line, "ConfidenceLevel") != NULL)
+         {
+            sscanf(line, "%s %lf", tmp, &m_ConfLvl);
+         }
+         else
+         {
+            sprintf(tmp, "Unknown token: %s", line);
+            LogError(ERR_FILE_IO, tmp);
+         }/* end else() */
+         line = GetNxtDataLine(pFile, pFileName);
+      } /* end while() */
+   }/* end if() */
+
    fclose(pFile);
+
+   //without a plugin, use the native engine
+   m_bNative = (m_PluginFile == NULL);
+
+   if(m_NumStars < 2)
+   {
+      sprintf(tmp, "Invalid number of stars (%d), defaulting to 2", m_NumStars);
+      LogError(ERR_FILE_IO, tmp);
+      m_NumStars = 2;
+   }
+   if((m_DeltaH <= 0.00) || (m_DeltaH > 0.50))
+   {
+      sprintf(tmp, "Invalid resolution (%E), defaulting to 0.1", m_DeltaH);
+      LogError(ERR_FILE_IO, tmp);
+      m_DeltaH = 0.10;
+   }
+   if(m_NumBoot < 0) m_NumBoot = 0;
+   if((m_ConfLvl <= 0.00) || (m_ConfLvl >= 1.00))
+   {
+      sprintf(tmp, "Invalid confidence level (%E), defaulting to 0.90", m_ConfLvl);
+      LogError(ERR_FILE_IO, tmp);
+      m_ConfLvl = 0.90;
+   }
+   m_NumLags = (int)floor(1.00/m_DeltaH + 1E-9);
 } /* end InitFromFile() */
 
 /******************************************************************************
@@ -127,9 +248,23 @@ Write out algorithm metrics and setup.
 void VARS::WriteMetrics(FILE * pFile)
 {
    fprintf(pFile, "\nAlgorithm Metrics\n");
-   fprintf(pFile, "Algorithm               : Variogram Analysis of Response Surfaces\n");
-   fprintf(pFile, "VARS Library File       : %s\n", m_PluginFile);
-   fprintf(pFile, "VARS Subroutine         : %s\n", m_Subroutine);
+   if(m_bNative == true)
+   {
+      fprintf(pFile, "Algorithm               : Variogram Analysis of Response Surfaces (STAR-VARS)\n");
+      fprintf(pFile, "Number of Stars         : %d\n", m_NumStars);
+      fprintf(pFile, "Resolution (delta h)    : %.4lf\n", m_DeltaH);
+      fprintf(pFile, "Stars Completed         : %d\n", m_StarsDone);
+      fprintf(pFile, "Star Point Evals        : %d\n", m_NumEvals);
+      fprintf(pFile, "Bootstrap Replicates    : %d\n", m_NumBoot);
+      fprintf(pFile, "Confidence Level        : %.2lf\n", m_ConfLvl);
+      fprintf(pFile, "Results File            : OstVARS.txt\n");
+   }
+   else
+   {
+      fprintf(pFile, "Algorithm               : Variogram Analysis of Response Surfaces\n");
+      fprintf(pFile, "VARS Library File       : %s\n", m_PluginFile);
+      fprintf(pFile, "VARS Subroutine         : %s\n", m_Subroutine);
+   }
   
    m_pModel->WriteMetrics(pFile);
 }/* end WriteMetrics() */
@@ -156,6 +291,12 @@ void VARS::Optimize(void)
 
    InitFromFile(GetInFileName());
 
+   if(m_bNative == true)
+   {
+      OptimizeNative();
+      return;
+   }
+
    WriteSetup(m_pModel, "VARS - Variogram Analysis of Response Surfaces");
    //write banner
    WriteBanner(m_pModel, "samp  ", "Precent Complete");
@@ -241,6 +382,667 @@ void VARS::Optimize(void)
 
 } /* end Optimize() */
 
+/******************************************************************************
+VARS::OptimizeNative()
+
+STAR-VARS (Razavi and Gupta, 2016). Star centers are sampled at random, and 
+from each center a cross-section is taken along each parameter. Points of all
+stars are handed out to processors as soon as they are idle (the master 
+processor only hands out points when running in serial), and the directional 
+variograms are accumulated as results arrive. Once all stars are done, the 
+sensitivity indices are computed and bootstrapped (by resampling stars), with 
+the bootstrap replicates spread over the processors.
+******************************************************************************/
+void VARS::OptimizeNative(void)
+{
+   StatusStruct pStatus;
+   MPI_Status mpi_status;
+   int id, nprocs, n, w, j, numBusy, numPts;
+   int * pS, * pI, * pK, * pStars;
+   bool * pBusy;
+   bool bQuit;
+   double f;
+   double * pX;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   InitStars();
+   n = m_NumParams;
+
+   if(id != 0)
+   {
+      WorkNative();
+   }
+   else
+   {
+      WriteSetup(m_pModel, "VARS - Variogram Analysis of Response Surfaces");
+      //write banner
+      WriteBanner(m_pModel, "star  best value     ", "Percent Complete");
+
+      numPts = 0;
+      for(j = 0; j < m_NumStars; j++) numPts += m_pLeft[j];
+
+      NEW_PRINT("double", nprocs*n);
+      pX = new double[nprocs*n];
+      MEM_CHECK(pX);
+      NEW_PRINT("int", 3*nprocs);
+      pS = new int[3*nprocs];
+      MEM_CHECK(pS);
+      pI = &(pS[nprocs]);
+      pK = &(pS[2*nprocs]);
+      NEW_PRINT("bool", nprocs);
+      pBusy = new bool[nprocs];
+      MEM_CHECK(pBusy);
+      for(w = 0; w < nprocs; w++) pBusy[w] = false;
+
+      pStatus.maxIter = m_NumStars;
+      pStatus.curIter = 0;
+      numBusy = 0;
+      bQuit = false;
+      while(true)
+      {
+         //hand out points to idle processors
+         for(w = ((nprocs == 1) ? 0 : 1); (w < nprocs) && (bQuit == false); w++)
+         {
+            if(pBusy[w] == true) continue;
+            if(NextPoint(&(pX[w*n]), &(pS[w]), &(pI[w]), &(pK[w])) == false) break;
+            pBusy[w] = true;
+            numBusy++;
+            if(nprocs > 1)
+            {
+               MPI_Send(&(pX[w*n]), n, MPI_DOUBLE, w, MPI_DATA_TAG, MPI_COMM_WORLD);
+            }
+         }/* end for() */
+
+         if(numBusy == 0) break;
+
+         //wait for a result
+         if(nprocs == 1)
+         {
+            w = 0;
+            m_pModel->GetParamGroupPtr()->WriteParams(pX);
+            f = m_pModel->Execute();
+         }
+         else
+         {
+            MPI_Recv(&f, 1, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_RESULTS_TAG, MPI_COMM_WORLD, &mpi_status);
+            w = mpi_status.MPI_SOURCE;
+         }
+         pBusy[w] = false;
+         numBusy--;
+
+         if(f < m_pBest[n])
+         {
+            for(j = 0; j < n; j++) m_pBest[j] = pX[w*n + j];
+            m_pBest[n] = f;
+         }
+         AddResult(pS[w], pI[w], pK[w], f);
+         WriteInnerEval(m_NumEvals, numPts, '.');
+
+         //star is done
+         if(m_pLeft[pS[w]] == 0)
+         {
+            WriteInnerEval(WRITE_ENDED, numPts, '.');
+            m_CurIter = m_StarsDone;
+            m_pModel->GetParamGroupPtr()->WriteParams(m_pBest);
+            WriteRecord(m_pModel, m_CurIter, m_pBest[n], 100.00*(double)m_NumEvals/(double)numPts);
+            pStatus.curIter = m_CurIter;
+            pStatus.pct = ((float)100.00*(float)m_NumEvals)/(float)numPts;
+            pStatus.numRuns = m_NumEvals;
+            WriteStatus(&pStatus);
+            if(IsQuit() == true){ bQuit = true;}
+         }
+      }/* end while() */
+
+      //release workers
+      for(w = 1; w < nprocs; w++)
+      {
+         MPI_Send(&f, 1, MPI_DOUBLE, w, MPI_QUIT_TAG, MPI_COMM_WORLD);
+      }
+
+      delete [] pX;
+      delete [] pS;
+      delete [] pBusy;
+
+      //sensitivity indices of the whole sample
+      NEW_PRINT("int", m_NumStars);
+      pStars = new int[m_NumStars];
+      MEM_CHECK(pStars);
+      for(j = 0; j < m_NumStars; j++) pStars[j] = j;
+      ComputeIndices(pStars, m_pIdx, m_pGamma);
+      delete [] pStars;
+   }/* end else() */
+
+   Bootstrap();
+
+   //perform final bookkeeping
+   m_pModel->Bookkeep(true);
+
+   if(id == 0)
+   {
+      WriteResults();
+      pStatus.pct = (float)100.00;
+      pStatus.numRuns = m_pModel->GetCounter();
+      WriteStatus(&pStatus);
+      //write algorithm metrics
+      WriteAlgMetrics(this);
+   }
+} /* end OptimizeNative() */
+
+/******************************************************************************
+VARS::WorkNative()
+
+Evaluate star points sent by the master processor until told to quit.
+******************************************************************************/
+void VARS::WorkNative(void)
+{
+   double f;
+   double * pX;
+
+   NEW_PRINT("double", m_NumParams);
+   pX = new double[m_NumParams];
+   MEM_CHECK(pX);
+
+   while(true)
+   {
+      if(RecvWorkMsg(pX, m_NumParams) == MPI_QUIT_TAG) break;
+
+      m_pModel->GetParamGroupPtr()->WriteParams(pX);
+      f = m_pModel->Execute();
+      MPI_Send(&f, 1, MPI_DOUBLE, 0, MPI_RESULTS_TAG, MPI_COMM_WORLD);
+   }/* end while() */
+
+   delete [] pX;
+} /* end WorkNative() */
+
+/******************************************************************************
+VARS::InitStars()
+
+Sample the star centers, lay out their cross-sections and allocate the 
+accumulators.
+******************************************************************************/
+void VARS::InitStars(void)
+{
+   int s, i, m, n, size;
+   double c;
+   ParameterGroup * pGroup = m_pModel->GetParamGroupPtr();
+
+   n = m_NumParams = pGroup->GetNumParams();
+   m = m_NumStars;
+   size = m*n*(m_NumLags + 1);
+
+   NEW_PRINT("double", n);
+   m_pLwr = new double[n];
+   MEM_CHECK(m_pLwr);
+   NEW_PRINT("double", n);
+   m_pUpr = new double[n];
+   MEM_CHECK(m_pUpr);
+   for(i = 0; i < n; i++)
+   {
+      m_pLwr[i] = pGroup->GetParamPtr(i)->GetLwrBnd();
+      m_pUpr[i] = pGroup->GetParamPtr(i)->GetUprBnd();
+   }
+
+   NEW_PRINT("double", m*n);
+   m_pCenter = new double[m*n];
+   MEM_CHECK(m_pCenter);
+   NEW_PRINT("double", m*n);
+   m_pOrigin = new double[m*n];
+   MEM_CHECK(m_pOrigin);
+   NEW_PRINT("int", m*n);
+   m_pLen = new int[m*n];
+   MEM_CHECK(m_pLen);
+   NEW_PRINT("int", m*n);
+   m_pMid = new int[m*n];
+   MEM_CHECK(m_pMid);
+   NEW_PRINT("int", m);
+   m_pLeft = new int[m];
+   MEM_CHECK(m_pLeft);
+
+   NEW_PRINT("double", size);
+   m_pY = new double[size];
+   MEM_CHECK(m_pY);
+   NEW_PRINT("bool", size);
+   m_pHave = new bool[size];
+   MEM_CHECK(m_pHave);
+   NEW_PRINT("double", size);
+   m_pSum = new double[size];
+   MEM_CHECK(m_pSum);
+   NEW_PRINT("double", size);
+   m_pCnt = new double[size];
+   MEM_CHECK(m_pCnt);
+
+   NEW_PRINT("double", m*n);
+   m_pSecN = new double[m*n];
+   MEM_CHECK(m_pSecN);
+   NEW_PRINT("double", m*n);
+   m_pSecMean = new double[m*n];
+   MEM_CHECK(m_pSecMean);
+   NEW_PRINT("double", m*n);
+   m_pSecM2 = new double[m*n];
+   MEM_CHECK(m_pSecM2);
+   NEW_PRINT("double", m);
+   m_pStarN = new double[m];
+   MEM_CHECK(m_pStarN);
+   NEW_PRINT("double", m);
+   m_pStarMean = new double[m];
+   MEM_CHECK(m_pStarMean);
+   NEW_PRINT("double", m);
+   m_pStarM2 = new double[m];
+   MEM_CHECK(m_pStarM2);
+
+   NEW_PRINT("double", n*VARS_NUM_IDX);
+   m_pIdx = new double[n*VARS_NUM_IDX];
+   MEM_CHECK(m_pIdx);
+   NEW_PRINT("double", n*(m_NumLags + 1));
+   m_pGamma = new double[n*(m_NumLags + 1)];
+   MEM_CHECK(m_pGamma);
+   NEW_PRINT("double", m_NumBoot*n*VARS_NUM_IDX + 1);
+   m_pBoot = new double[m_NumBoot*n*VARS_NUM_IDX + 1];
+   MEM_CHECK(m_pBoot);
+   NEW_PRINT("double", n+1);
+   m_pBest = new double[n+1];
+   MEM_CHECK(m_pBest);
+   m_pBest[n] = NEARLY_HUGE;
+
+   for(i = 0; i < size; i++)
+   {
+      m_pY[i] = 0.00;
+      m_pHave[i] = false;
+      m_pSum[i] = 0.00;
+      m_pCnt[i] = 0.00;
+   }
+
+   //centers and cross-sections
+   for(s = 0; s < m; s++)
+   {
+      m_pLeft[s] = 1;
+      m_pStarN[s] = m_pStarMean[s] = m_pStarM2[s] = 0.00;
+      for(i = 0; i < n; i++)
+      {
+         c = UniformRandom();
+         if(c >= 1.00) c = 1.00;
+         m_pCenter[s*n + i] = c;
+         m_pOrigin[s*n + i] = fmod(c, m_DeltaH);
+         m_pMid[s*n + i] = (int)floor((c - m_pOrigin[s*n + i])/m_DeltaH + 0.50);
+         m_pLen[s*n + i] = (int)floor((1.00 - m_pOrigin[s*n + i])/m_DeltaH + 1E-9) + 1;
+         if(m_pLen[s*n + i] > (m_NumLags + 1)) m_pLen[s*n + i] = m_NumLags + 1;
+         if(m_pMid[s*n + i] >= m_pLen[s*n + i]) m_pMid[s*n + i] = m_pLen[s*n + i] - 1;
+         m_pLeft[s] += m_pLen[s*n + i] - 1;
+         m_pSecN[s*n + i] = m_pSecMean[s*n + i] = m_pSecM2[s*n + i] = 0.00;
+      }
+   }/* end for() */
+
+   m_NextStar = 0;
+   m_NextDim = -1;
+   m_NextPos = 0;
+   m_NumEvals = 0;
+   m_StarsDone = 0;
+} /* end InitStars() */
+
+/******************************************************************************
+VARS::NextPoint()
+
+Generate the next star point: star (s), dimension (i) and slot (k) of its 
+cross-section, or dimension -1 for the star center. Returns false once all
+points were handed out.
+******************************************************************************/
+bool VARS::NextPoint(double * x, int * pStar, int * pDim, int * pPos)
+{
+   int j, s, i, k, n;
+   double u;
+
+   n = m_NumParams;
+   while(m_NextStar < m_NumStars)
+   {
+      s = m_NextStar;
+      i = m_NextDim;
+      k = -1;
+      if(i == -1) //center
+      {
+         m_NextDim = 0;
+         m_NextPos = 0;
+      }
+      else if(i >= n) //star is done
+      {
+         m_NextStar++;
+         m_NextDim = -1;
+         continue;
+      }
+      else if(m_NextPos >= m_pLen[s*n + i]) //section is done
+      {
+         m_NextDim++;
+         m_NextPos = 0;
+         continue;
+      }
+      else
+      {
+         k = m_NextPos++;
+         if(k == m_pMid[s*n + i]) continue; //the center
+      }
+
+      for(j = 0; j < n; j++)
+      {
+         u = m_pCenter[s*n + j];
+         if(j == i) u = m_pOrigin[s*n + j] + (double)k*m_DeltaH;
+         if(u > 1.00) u = 1.00;
+         x[j] = m_pLwr[j] + (m_pUpr[j] - m_pLwr[j])*u;
+      }
+      *pStar = s;
+      *pDim = i;
+      *pPos = k;
+      return true;
+   }/* end while() */
+   return false;
+} /* end NextPoint() */
+
+/******************************************************************************
+VARS::AddResult()
+
+Account for the result (f) of a star point. The squared differences between
+(f) and the results already in its cross-section(s) are added to the variogram
+accumulators of the star, and the running mean and variance of the sections and
+the star are updated. A star center belongs to every section of its star.
+******************************************************************************/
+void VARS::AddResult(int s, int i, int k, double f)
+{
+   int j, q, n, lo, hi, slot, base;
+   double d;
+
+   n = m_NumParams;
+   m_NumEvals++;
+
+   //star
+   m_pStarN[s] += 1.00;
+   d = f - m_pStarMean[s];
+   m_pStarMean[s] += d/m_pStarN[s];
+   m_pStarM2[s] += d*(f - m_pStarMean[s]);
+
+   lo = hi = i;
+   if(i == -1){ lo = 0; hi = n - 1;}
+   for(j = lo; j <= hi; j++)
+   {
+      slot = (i == -1) ? m_pMid[s*n + j] : k;
+      base = (s*n + j)*(m_NumLags + 1);
+
+      //pairs with the results so far
+      for(q = 0; q < m_pLen[s*n + j]; q++)
+      {
+         if((q == slot) || (m_pHave[base + q] == false)) continue;
+         d = f - m_pY[base + q];
+         m_pSum[base + abs(q - slot)] += d*d;
+         m_pCnt[base + abs(q - slot)] += 1.00;
+      }
+      m_pY[base + slot] = f;
+      m_pHave[base + slot] = true;
+
+      //section
+      m_pSecN[s*n + j] += 1.00;
+      d = f - m_pSecMean[s*n + j];
+      m_pSecMean[s*n + j] += d/m_pSecN[s*n + j];
+      m_pSecM2[s*n + j] += d*(f - m_pSecMean[s*n + j]);
+   }/* end for() */
+
+   m_pLeft[s]--;
+   if(m_pLeft[s] == 0) m_StarsDone++;
+} /* end AddResult() */
+
+/******************************************************************************
+VARS::ComputeIndices()
+
+Sensitivity indices from the accumulators of a list of m_NumStars stars 
+(pStars, possibly with repeats, as in a bootstrap replicate). For each 
+parameter, pOut receives IVARS10, IVARS30, IVARS50 (the variogram integrated 
+up to h = 0.1, 0.3 and 0.5, by the trapezoidal rule) and VARS-TO (the mean 
+variance along the cross-sections over the variance of all star points), and 
+pGamma receives the variogram at h = 0, dh, 2dh, ...
+******************************************************************************/
+void VARS::ComputeIndices(int * pStars, double * pOut, double * pGamma)
+{
+   const double scales[3] = {0.10, 0.30, 0.50};
+   int s, i, k, t, n, K, base, top;
+   double N, mean, M2, d, nb, S, C, secVar;
+
+   n = m_NumParams;
+   K = m_NumLags;
+
+   //variance of all star points, by combining the stars
+   N = mean = M2 = 0.00;
+   for(s = 0; s < m_NumStars; s++)
+   {
+      nb = m_pStarN[pStars[s]];
+      if(nb <= 0.00) continue;
+      d = m_pStarMean[pStars[s]] - mean;
+      mean += d*nb/(N + nb);
+      M2 += m_pStarM2[pStars[s]] + d*d*N*nb/(N + nb);
+      N += nb;
+   }
+
+   for(i = 0; i < n; i++)
+   {
+      //variogram
+      pGamma[i*(K + 1)] = 0.00;
+      for(k = 1; k <= K; k++)
+      {
+         S = C = 0.00;
+         for(s = 0; s < m_NumStars; s++)
+         {
+            base = (pStars[s]*n + i)*(K + 1);
+            S += m_pSum[base + k];
+            C += m_pCnt[base + k];
+         }
+         pGamma[i*(K + 1) + k] = (C > 0.00) ? (S/(2.00*C)) : 0.00;
+      }
+
+      //IVARS
+      for(t = 0; t < 3; t++)
+      {
+         top = (int)floor(scales[t]/m_DeltaH + 1E-9);
+         if(top > K) top = K;
+         pOut[i*VARS_NUM_IDX + t] = 0.00;
+         for(k = 1; k <= top; k++)
+         {
+            pOut[i*VARS_NUM_IDX + t] += 0.50*m_DeltaH*(pGamma[i*(K + 1) + k - 1] + pGamma[i*(K + 1) + k]);
+         }
+      }
+
+      //VARS-TO
+      secVar = 0.00;
+      for(s = 0; s < m_NumStars; s++)
+      {
+         if(m_pSecN[pStars[s]*n + i] > 0.00) secVar += m_pSecM2[pStars[s]*n + i]/m_pSecN[pStars[s]*n + i];
+      }
+      secVar /= (double)m_NumStars;
+      pOut[i*VARS_NUM_IDX + 3] = (M2 > 0.00) ? (secVar/(M2/N)) : 0.00;
+   }/* end for() */
+} /* end ComputeIndices() */
+
+/******************************************************************************
+VARS::Bootstrap()
+
+Bootstrap the sensitivity indices by resampling the stars with replacement. 
+The master processor draws the replicates and broadcasts them, along with the
+accumulators; each processor computes a share of the replicates and the 
+results are summed on the master processor (m_pBoot).
+******************************************************************************/
+void VARS::Bootstrap(void)
+{
+   int id, nprocs, r, s, m, n, size, len;
+   int * pDraw;
+   double * pMine, * pGamma;
+
+   if(m_NumBoot <= 0) return;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &id);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   m = m_NumStars;
+   n = m_NumParams;
+   size = m*n*(m_NumLags + 1);
+   len = m_NumBoot*n*VARS_NUM_IDX;
+
+   NEW_PRINT("int", m_NumBoot*m);
+   pDraw = new int[m_NumBoot*m];
+   MEM_CHECK(pDraw);
+   if(id == 0)
+   {
+      for(r = 0; r < m_NumBoot*m; r++)
+      {
+         s = (int)(UniformRandom()*(double)m);
+         pDraw[r] = (s >= m) ? (m - 1) : s;
+      }
+   }
+
+   if(nprocs > 1)
+   {
+      MPI_Bcast(pDraw, m_NumBoot*m, MPI_INTEGER, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pSum, size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pCnt, size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pSecN, m*n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pSecM2, m*n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pStarN, m, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pStarMean, m, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      MPI_Bcast(m_pStarM2, m, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+   }
+
+   NEW_PRINT("double", len);
+   pMine = new double[len];
+   MEM_CHECK(pMine);
+   NEW_PRINT("double", n*(m_NumLags + 1));
+   pGamma = new double[n*(m_NumLags + 1)];
+   MEM_CHECK(pGamma);
+
+   for(r = 0; r < len; r++) pMine[r] = 0.00;
+   for(r = id; r < m_NumBoot; r += nprocs)
+   {
+      ComputeIndices(&(pDraw[r*m]), &(pMine[r*n*VARS_NUM_IDX]), pGamma);
+   }
+
+   if(nprocs > 1)
+   {
+      MPI_Reduce(pMine, m_pBoot, len, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+   }
+   else
+   {
+      for(r = 0; r < len; r++) m_pBoot[r] = pMine[r];
+   }
+
+   delete [] pDraw;
+   delete [] pMine;
+   delete [] pGamma;
+} /* end Bootstrap() */
+
+/******************************************************************************
+VARS::WriteResults()
+
+Write the variograms, sensitivity indices and bootstrap results to 
+OstVARS.txt. Parameters are ranked by IVARS50, the most sensitive first.
+******************************************************************************/
+void VARS::WriteResults(void)
+{
+   const char * names[VARS_NUM_IDX] = {"IVARS10", "IVARS30", "IVARS50", "VARS-TO"};
+   FILE * pFile;
+   int i, j, k, r, t, n, K, lo, hi, same;
+   int * pRank, * pBootRank;
+   double * pVals;
+   ParameterGroup * pGroup = m_pModel->GetParamGroupPtr();
+
+   n = m_NumParams;
+   K = m_NumLags;
+
+   pFile = fopen("OstVARS.txt", "w");
+   if(pFile == NULL)
+   {
+      LogError(ERR_FILE_IO, "Couldn't open OstVARS.txt");
+      return;
+   }
+
+   NEW_PRINT("int", 2*n);
+   pRank = new int[2*n];
+   MEM_CHECK(pRank);
+   pBootRank = &(pRank[n]);
+   NEW_PRINT("double", m_NumBoot + 1);
+   pVals = new double[m_NumBoot + 1];
+   MEM_CHECK(pVals);
+
+   fprintf(pFile, "VARS - Variogram Analysis of Response Surfaces (STAR-VARS)\n");
+   fprintf(pFile, "Stars : %d of %d\n", m_StarsDone, m_NumStars);
+   fprintf(pFile, "Delta h : %.4lf\n", m_DeltaH);
+   fprintf(pFile, "Evaluations : %d\n", m_NumEvals);
+
+   //variograms
+   fprintf(pFile, "\nDirectional Variograms (parameters scaled to [0,1], up to h = 0.5)\n");
+   fprintf(pFile, "h         ");
+   for(i = 0; i < n; i++) fprintf(pFile, "%-14s", pGroup->GetParamPtr(i)->GetName());
+   fprintf(pFile, "\n");
+   for(k = 0; (k <= K) && ((double)k*m_DeltaH <= 0.50 + 1E-9); k++)
+   {
+      fprintf(pFile, "%-10.4lf", (double)k*m_DeltaH);
+      for(i = 0; i < n; i++) fprintf(pFile, "%E  ", m_pGamma[i*(K + 1) + k]);
+      fprintf(pFile, "\n");
+   }
+
+   //ranks by IVARS50
+   for(i = 0; i < n; i++)
+   {
+      pRank[i] = 1;
+      for(j = 0; j < n; j++)
+      {
+         if(m_pIdx[j*VARS_NUM_IDX + 2] > m_pIdx[i*VARS_NUM_IDX + 2]) pRank[i]++;
+      }
+   }
+
+   fprintf(pFile, "\nSensitivity Indices\n");
+   fprintf(pFile, "Parameter     ");
+   for(t = 0; t < VARS_NUM_IDX; t++) fprintf(pFile, "%-14s", names[t]);
+   fprintf(pFile, "Rank\n");
+   for(i = 0; i < n; i++)
+   {
+      fprintf(pFile, "%-14s", pGroup->GetParamPtr(i)->GetName());
+      for(t = 0; t < VARS_NUM_IDX; t++) fprintf(pFile, "%E  ", m_pIdx[i*VARS_NUM_IDX + t]);
+      fprintf(pFile, "%d\n", pRank[i]);
+   }
+
+   //bootstrap intervals, and how often each rank is reproduced
+   if(m_NumBoot > 0)
+   {
+      fprintf(pFile, "\nBootstrap (%d replicates, %.0lf%% confidence intervals)\n", m_NumBoot, 100.00*m_ConfLvl);
+      fprintf(pFile, "Parameter     ");
+      for(t = 0; t < VARS_NUM_IDX; t++) fprintf(pFile, "%-14s%-14s", names[t], "");
+      fprintf(pFile, "Rank Reliability\n");
+
+      lo = (int)floor(0.50*(1.00 - m_ConfLvl)*(double)(m_NumBoot - 1) + 0.50);
+      hi = (int)floor(0.50*(1.00 + m_ConfLvl)*(double)(m_NumBoot - 1) + 0.50);
+      for(i = 0; i < n; i++)
+      {
+         fprintf(pFile, "%-14s", pGroup->GetParamPtr(i)->GetName());
+         for(t = 0; t < VARS_NUM_IDX; t++)
+         {
+            for(r = 0; r < m_NumBoot; r++) pVals[r] = m_pBoot[(r*n + i)*VARS_NUM_IDX + t];
+            std::sort(pVals, pVals + m_NumBoot);
+            fprintf(pFile, "%E  %E  ", pVals[lo], pVals[hi]);
+         }
+
+         same = 0;
+         for(r = 0; r < m_NumBoot; r++)
+         {
+            pBootRank[i] = 1;
+            for(j = 0; j < n; j++)
+            {
+               if(m_pBoot[(r*n + j)*VARS_NUM_IDX + 2] > m_pBoot[(r*n + i)*VARS_NUM_IDX + 2]) pBootRank[i]++;
+            }
+            if(pBootRank[i] == pRank[i]) same++;
+         }
+         fprintf(pFile, "%.3lf\n", (double)same/(double)m_NumBoot);
+      }/* end for() */
+   }/* end if() */
+
+   fclose(pFile);
+   delete [] pRank;
+   delete [] pVals;
+} /* end WriteResults() */
+
 /******************************************************************************
 VARS_Program()
 
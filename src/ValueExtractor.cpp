@@ -14,6 +14,8 @@ Version History
 08-11-04    lsm   made into a linked list to reduce file I/O
 03-09-05    lsm   added support for Fortran-style scientific number formation
                   (e.g. 1.000D-4 vs. 1.000E-04)
+10-19-26    lsm   ExtractValue() no longer allocates a message buffer per 
+                  observation, the scratch buffer is sized by FileToString().
 ******************************************************************************/
 #include <string.h>
 #include <stdlib.h>
@@ -40,6 +42,8 @@ ValueExtractor::ValueExtractor(IroncladString file, bool bQuitOnErr, double errV
 
    m_DataStr = NULL;
    m_DataSize = 0;
+   m_Msg = NULL;
+   m_MsgSize = 0;
    m_bQuitOnError = bQuitOnErr;
    m_ErrorVal = errVal;
 
@@ -58,6 +62,8 @@ void ValueExtractor::Destroy(void)
    delete [] m_FileName;
    delete [] m_DataStr;
    m_DataSize = 0;
+   delete [] m_Msg;
+   m_MsgSize = 0;
    delete m_pNxt;
 
    IncDtorCount();
@@ -127,12 +133,13 @@ ValueExtractor * ValueExtractor::GetByName(IroncladString name)
 /******************************************************************************
 FileToString()
 
-Reads a file into a string.
+Reads a file into a string, and makes sure that the scratch buffer can hold
+the longest line of the file.
 ******************************************************************************/
 void ValueExtractor::FileToString(void)
 {
    int fileSize;
-   int i;
+   int i, maxLine;
    FILE * pFile;
 
    pFile = fopen(m_FileName, "r");
@@ -173,6 +180,22 @@ void ValueExtractor::FileToString(void)
    m_DataStr[i] = 0;
 
    fclose(pFile);
+
+   //size scratch buffer, if necessary
+   maxLine = GetMaxLineSizeInString(m_DataStr);
+   // enforce a lower bound on string size
+   if(maxLine < DEF_STR_SZ)
+   {
+      maxLine = DEF_STR_SZ;
+   }
+   if(m_MsgSize < maxLine)
+   {
+      delete [] m_Msg;
+      m_MsgSize = maxLine;
+      NEW_PRINT("char", m_MsgSize);
+      m_Msg = new char[m_MsgSize];
+      MEM_CHECK(m_Msg);
+   }/* end if() */
 } /* end FileToString() */
 
 /******************************************************************************
@@ -225,13 +248,7 @@ bool ValueExtractor::ExtractValue
    char tmp;   
    int i, j;
 
-   int max_msg_size = GetMaxLineSizeInString(m_DataStr);
-   // enforce a lower bound on string size
-   if(max_msg_size < DEF_STR_SZ)
-   {
-      max_msg_size = DEF_STR_SZ;
-   }    
-   msg = new char[max_msg_size];
+   msg = m_Msg;
 
    if(strcmp(search, "OST_NULL") == 0)
    {
@@ -246,7 +263,6 @@ bool ValueExtractor::ExtractValue
          sprintf(msg, "extractValue(): strstr() failed : couldn't find |%s|", search);
          LogError(ERR_FILE_IO, msg);
 		 *val = m_ErrorVal;
-       delete [] msg;
        if(m_bQuitOnError == true)
 		    return false;
        else
@@ -266,7 +282,6 @@ bool ValueExtractor::ExtractValue
       {
          LogError(ERR_FILE_IO, "extractValue(): could not locate line");
 		   *val = m_ErrorVal;
-         delete [] msg;
          if(m_bQuitOnError == true)
 		      return false;
          else
@@ -289,7 +304,6 @@ bool ValueExtractor::ExtractValue
 	  if(j == -1)
 	  {
 		  *val = m_ErrorVal;
-        delete [] msg;
         if(m_bQuitOnError == true)
 		     return false;
         else
@@ -310,7 +324,6 @@ bool ValueExtractor::ExtractValue
    MyStrRep(msg,"D", "E");
    MyStrRep(msg,"d", "E");
    *val = atof(msg);
-   delete [] msg;
 
    return true;
 } /* end extractValue() */
@@ -23,6 +23,8 @@ Version History
 01-01-07    lsm   Algorithm now uses abstract model base class (ModelABC), added
                   model init. and bookkepping calls. Some statistics can now 
                   be calculated in parallel. 
+10-19-26    lsm   Added parallel tempering (replica exchange) mode.
+10-19-26    lsm   Parallel tempering is shared with SAAlgorithm (TemperingABC).
 ******************************************************************************/
 #include <mpi.h>
 #include <math.h>
@@ -37,6 +39,7 @@ Version History
 #include "ParameterABC.h"
 #include "TelescopingBounds.h"
 #include "StatsClass.h"
+#include "ReplicaExchange.h"
 
 #include "Utility.h"
 #include "StatUtility.h"
@@ -253,6 +256,10 @@ VandSA::VandSA(ModelABC * pModel)
                m_TransitionMethod = TRANS_GAUSS;
             }
          }
+         else
+         {
+            ReadTemperingToken(line);
+         }
          line = GetNxtDataLine(inFile, pFileName);
       }/* end while() */
    } /* end if() */
@@ -280,6 +287,7 @@ void VandSA::Destroy(void)
    delete [] m_pMelts;
    delete m_pStats;
    delete m_pTransBackup;
+   delete m_pReplicas;
 
    delete [] m_dx;
    delete [] m_u;
@@ -337,6 +345,7 @@ void VandSA::WriteMetrics(FILE * pFile)
    fprintf(pFile, "Downhill Transitions    : %d\n", m_NumDownhill);
    fprintf(pFile, "Upper Violations        : %d\n", m_NumUprViols);
    fprintf(pFile, "Lower Violations        : %d\n", m_NumLwrViols);
+   WriteTemperingMetrics(pFile);
 
    m_pModel->WriteMetrics(pFile);
    if(m_CurStop <= m_StopVal)
@@ -379,12 +388,20 @@ Optimize the objective function using the SA algorithm.
 ******************************************************************************/
 void VandSA::Optimize(void)
 {
-   int rank, nprocs;
+   int rank, nprocs, n;
 
    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
 
-   if(nprocs == 1)
+   if(m_bTempering == true)
+   {
+      //replicas keep their own step distribution matrix (Q)
+      n = m_pModel->GetParamGroupPtr()->GetNumParams();
+      m_NumOuter = 0;
+      OptimizeTempering(m_pModel, "Simulated Annealing (Vanderbilt-Louie Implementation)",
+                        n*n, m_MaxOuter, m_StopVal);
+   }
+   else if(nprocs == 1)
    {
       OptimizeSerial();
    }
@@ -559,6 +576,108 @@ void VandSA::OptimizeParallel(int rank, int nprocs)
    }
 }/* end OptimizeParallel() */
 
+/******************************************************************************
+MeltReplica()
+
+Parallel tempering hook: execute the model at the starting point and melt.
+The melted state is returned in pX, along with the final (coldest) and initial
+(hottest) temperature of the annealing schedule.
+******************************************************************************/
+double VandSA::MeltReplica(double * pX, double * pTcold, double * pThot)
+{
+   double fcur;
+
+   fcur = m_pModel->Execute();
+   StoreBest();
+   m_MeltCount++;
+
+   fcur = Melt(fcur);
+   memcpy(pX, m_pBest, sizeof(double)*m_pModel->GetParamGroupPtr()->GetNumParams());
+
+   *pTcold = m_InitTemp*pow(m_TempFactor, (double)m_MaxOuter);
+   *pThot = m_InitTemp;
+   return fcur;
+}/* end MeltReplica() */
+
+/******************************************************************************
+MoveReplica()
+
+Parallel tempering hook: make a random move away from pX0 and store the
+result in pX.
+******************************************************************************/
+double VandSA::MoveReplica(double * pX0, double * pX)
+{
+   double fcur;
+   ParameterGroup * pGroup = m_pModel->GetParamGroupPtr();
+
+   pGroup->WriteParams(pX0);
+   GenerateRandomMove();
+   fcur = m_pModel->Execute();
+   m_MeltCount++;
+   pGroup->ReadParams(pX);
+   return fcur;
+}/* end MoveReplica() */
+
+/******************************************************************************
+InitReplicaAux()
+
+Parallel tempering hook: each replica starts with the step distribution 
+matrix (Q) of the melted state. Q adapts to the temperature of the replica,
+so it stays with the replica when states are swapped.
+******************************************************************************/
+void VandSA::InitReplicaAux(double * pAux)
+{
+   int k, n = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   for(k = 0; k < n; k++){ memcpy(&(pAux[k*n]), m_Q[k], sizeof(double)*n);}
+}/* end InitReplicaAux() */
+
+/******************************************************************************
+EquilibrateReplica()
+
+Parallel tempering hook: advance the chain of a replica, using its step 
+distribution matrix (pAux), at temperature T.
+******************************************************************************/
+double VandSA::EquilibrateReplica(double T, double * pX, double f, double * pAux)
+{
+   int k, n = m_pModel->GetParamGroupPtr()->GetNumParams();
+
+   m_CurTemp = T;
+   for(k = 0; k < n; k++){ memcpy(m_Q[k], &(pAux[k*n]), sizeof(double)*n);}
+   memcpy(m_pBest, pX, sizeof(double)*n);
+   m_pModel->GetParamGroupPtr()->WriteParams(m_pBest);
+
+   f = Equilibrate(f);
+
+   memcpy(pX, m_pBest, sizeof(double)*n);
+   for(k = 0; k < n; k++){ memcpy(&(pAux[k*n]), m_Q[k], sizeof(double)*n);}
+   return f;
+}/* end EquilibrateReplica() */
+
+/******************************************************************************
+EndTemperingIter()
+
+Parallel tempering hook: the coldest replica determines the temperature and
+convergence value of the algorithm.
+******************************************************************************/
+void VandSA::EndTemperingIter(int iter, double Tcold, double stop)
+{
+   m_CurStop = stop;
+   m_CurTemp = Tcold;
+   m_NumOuter = iter;
+}/* end EndTemperingIter() */
+
+/******************************************************************************
+RestoreReplica()
+
+Parallel tempering hook: make pX the final result.
+******************************************************************************/
+void VandSA::RestoreReplica(double * pX)
+{
+   memcpy(m_pBest, pX, sizeof(double)*m_pModel->GetParamGroupPtr()->GetNumParams());
+   RestoreBest();
+}/* end RestoreReplica() */
+
 /******************************************************************************
 InitMaster()
 
@@ -0,0 +1,411 @@
+/******************************************************************************
+File     : WorkerProvisioner.cpp
+Author   : L. Shawn Matott
+Copyright: 2026, L. Shawn Matott
+
+In-process population of the model subdirectories of the processors. See
+WorkerProvisioner.h for details.
+
+Version History
+10-19-26    lsm   created
+10-19-26    lsm   processors agree on errors and exit together (CheckError())
+******************************************************************************/
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <thread>
+#include <stdexcept>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+#ifdef __linux__
+  #include <sys/ioctl.h>
+  #include <linux/fs.h>
+#endif
+
+#include "WorkerProvisioner.h"
+
+#include "Exception.h"
+#include "Utility.h"
+
+/******************************************************************************
+StripQuotes()
+
+Names with whitespace are wrapped in quotes.
+******************************************************************************/
+static fs::path StripQuotes(IroncladString pName)
+{
+   std::string name = pName;
+   size_t i;
+
+   for(i = name.find('"'); i != std::string::npos; i = name.find('"')) name.erase(i, 1);
+   return fs::path(name);
+} /* end StripQuotes() */
+
+/******************************************************************************
+CTOR
+
+Read the provisioning mode from the input file. The model subdirectory of a
+processor is named after pPrefix and the rank of the processor.
+******************************************************************************/
+WorkerProvisioner::WorkerProvisioner(IroncladString pFileName, IroncladString pPrefix)
+{
+   char tmp[DEF_STR_SZ], tmp2[DEF_STR_SZ];
+   char msg[2*DEF_STR_SZ];
+   char * line;
+   FILE * pFile;
+
+   MPI_Comm_rank(MPI_COMM_WORLD, &m_Rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &m_NumProcs);
+
+   m_Mode = PROVISION_CLONE;
+   m_WorkDir = fs::path(std::string(pPrefix) + std::to_string(m_Rank));
+   m_StageDir = fs::path(std::string(pPrefix) + "_staging");
+   m_Next = 0;
+   m_NumFiles = 0;
+   m_NumLinked = 0;
+   m_NumCloned = 0;
+   m_NumCopied = 0;
+   m_Time = 0.00;
+
+   pFile = fopen(pFileName, "r");
+   if(pFile == NULL)
+   {
+      FileOpenFailure("WorkerProvisioner::CTOR", pFileName);
+   }
+   if(CheckToken(pFile, "WorkerProvisioning", pFileName) == true)
+   {
+      line = GetCurDataLine();
+      strcpy(tmp2, "clone");
+      sscanf(line, "%s %s", tmp, tmp2);
+      MyStrLwr(tmp2);
+      if(strcmp(tmp2, "clone") == 0) m_Mode = PROVISION_CLONE;
+      else if(strcmp(tmp2, "link") == 0) m_Mode = PROVISION_LINK;
+      else if(strcmp(tmp2, "copy") == 0) m_Mode = PROVISION_COPY;
+      else
+      {
+         snprintf(msg, 2*DEF_STR_SZ, "Unknown WorkerProvisioning (%s), defaulting to clone", tmp2);
+         LogError(ERR_FILE_IO, msg);
+      }
+   }
+   fclose(pFile);
+
+   IncCtorCount();
+} /* end CTOR */
+
+/******************************************************************************
+Destroy()
+******************************************************************************/
+void WorkerProvisioner::Destroy(void)
+{
+   m_Items.clear();
+   IncDtorCount();
+} /* end Destroy() */
+
+/******************************************************************************
+AddFile()
+
+Add a file (e.g. the model executable) to be placed at the top level of the
+model subdirectory.
+******************************************************************************/
+void WorkerProvisioner::AddFile(IroncladString pName)
+{
+   ProvisionItem item;
+
+   item.src = StripQuotes(pName);
+   item.rel = item.src.filename();
+   m_Items.push_back(item);
+} /* end AddFile() */
+
+/******************************************************************************
+AddPath()
+
+Add a file or a folder (with its contents) to be placed in the model
+subdirectory under the same relative path.
+******************************************************************************/
+void WorkerProvisioner::AddPath(IroncladString pName)
+{
+   ProvisionItem item;
+
+   item.src = StripQuotes(pName);
+   if(item.src.is_absolute() == true) item.rel = item.src.filename();
+   else item.rel = item.src;
+   m_Items.push_back(item);
+} /* end AddPath() */
+
+/******************************************************************************
+Expand()
+
+Expand the registered items into the list of files to place and the list of
+folders to create, relative to the model subdirectory.
+******************************************************************************/
+void WorkerProvisioner::Expand(std::vector<ProvisionItem> * pFiles, std::vector<fs::path> * pDirs)
+{
+   ProvisionItem file;
+   std::string msg;
+   size_t i;
+
+   for(i = 0; i < m_Items.size(); i++)
+   {
+      if(fs::is_directory(m_Items[i].src) == true)
+      {
+         pDirs->push_back(m_Items[i].rel);
+         for(const auto & entry : fs::recursive_directory_iterator(m_Items[i].src))
+         {
+            file.src = entry.path();
+            file.rel = m_Items[i].rel / entry.path().lexically_relative(m_Items[i].src);
+            if(fs::is_directory(entry.path()) == true) pDirs->push_back(file.rel);
+            else pFiles->push_back(file);
+         }
+      }
+      else if(fs::exists(m_Items[i].src) == true)
+      {
+         if(m_Items[i].rel.has_parent_path() == true)
+         {
+            pDirs->push_back(m_Items[i].rel.parent_path());
+         }
+         pFiles->push_back(m_Items[i]);
+      }
+      else
+      {
+         msg = "couldn't find |" + m_Items[i].src.string() + "|";
+         throw std::runtime_error(msg);
+      }
+   }/* end for() */
+} /* end Expand() */
+
+/******************************************************************************
+Provision()
+
+Create the model subdirectory and place all of the registered files. All
+processors must call Provision().
+******************************************************************************/
+void WorkerProvisioner::Provision(void)
+{
+   std::vector<ProvisionItem> files;
+   std::vector<fs::path> dirs;
+   double start, elapsed, slowest;
+   size_t i;
+#ifdef GCC5X
+   boost::system::error_code ec;
+#else
+   std::error_code ec;
+#endif
+
+   start = GetElapsedTics();
+   try
+   {
+      Expand(&files, &dirs);
+      m_NumFiles = (int)files.size();
+
+      fs::create_directories(m_WorkDir);
+      for(i = 0; i < dirs.size(); i++) fs::create_directories(m_WorkDir / dirs[i]);
+
+      if(m_Mode != PROVISION_LINK)
+      {
+         PlaceAll(files, fs::path(), m_WorkDir, false);
+      }
+      //the first processor stages the files for all processors
+      else if(m_Rank == 0)
+      {
+         fs::remove_all(m_StageDir);
+         fs::create_directories(m_StageDir);
+         for(i = 0; i < dirs.size(); i++) fs::create_directories(m_StageDir / dirs[i]);
+         PlaceAll(files, fs::path(), m_StageDir, false);
+         m_NumCloned = 0;
+         m_NumCopied = 0;
+      }
+   }
+   catch(const std::exception & e)
+   {
+      if(m_Error.empty() == true) m_Error = e.what();
+   }
+   CheckError();
+
+   if(m_Mode == PROVISION_LINK)
+   {
+      try
+      {
+         PlaceAll(files, m_StageDir, m_WorkDir, true);
+      }
+      catch(const std::exception & e)
+      {
+         if(m_Error.empty() == true) m_Error = e.what();
+      }
+
+      //links keep the staged files alive
+      CheckError();
+      if(m_Rank == 0) fs::remove_all(m_StageDir, ec);
+   }
+
+   elapsed = GetElapsedTics() - start;
+   m_Time = elapsed;
+   if(m_NumProcs > 1)
+   {
+      MPI_Reduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+      if(m_Rank == 0) m_Time = slowest;
+   }
+
+   if(m_Rank == 0)
+   {
+      printf("Provisioned %d model subdirectories (%d files each) in %.3lf seconds\n",
+             m_NumProcs, m_NumFiles, m_Time);
+   }
+} /* end Provision() */
+
+/******************************************************************************
+PlaceAll()
+
+Place a list of files, taken from the folder 'from' (or from their source if
+'from' is empty) into the folder 'to', using a few threads.
+******************************************************************************/
+void WorkerProvisioner::PlaceAll(const std::vector<ProvisionItem> & files, const fs::path & from,
+                                 const fs::path & to, bool bLink)
+{
+   std::vector<std::thread> threads;
+   size_t numThreads, i;
+
+   numThreads = (files.size() + PROVISION_FILES_PER_THREAD - 1) / PROVISION_FILES_PER_THREAD;
+   if(numThreads > PROVISION_MAX_THREADS) numThreads = PROVISION_MAX_THREADS;
+
+   m_Next = 0;
+   for(i = 1; i < numThreads; i++)
+   {
+      threads.push_back(std::thread(&WorkerProvisioner::Worker, this, &files, &from, &to, bLink));
+   }
+   Worker(&files, &from, &to, bLink);
+   for(i = 0; i < threads.size(); i++) threads[i].join();
+} /* end PlaceAll() */
+
+/******************************************************************************
+Worker()
+
+Place files until the list is exhausted.
+******************************************************************************/
+void WorkerProvisioner::Worker(const std::vector<ProvisionItem> * pFiles, const fs::path * pFrom,
+                               const fs::path * pTo, bool bLink)
+{
+   size_t i;
+
+   for(i = m_Next++; i < pFiles->size(); i = m_Next++)
+   {
+      try
+      {
+         if(pFrom->empty() == true) Place((*pFiles)[i].src, *pTo / (*pFiles)[i].rel, bLink);
+         else Place(*pFrom / (*pFiles)[i].rel, *pTo / (*pFiles)[i].rel, bLink);
+      }
+      catch(const std::exception & e)
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         if(m_Error.empty() == true) m_Error = e.what();
+      }
+   }/* end for() */
+} /* end Worker() */
+
+/******************************************************************************
+Place()
+
+Place a file, replacing any previous version. Falls back from a hardlink to a
+clone, and from a clone to a copy.
+******************************************************************************/
+void WorkerProvisioner::Place(const fs::path & src, const fs::path & dst, bool bLink)
+{
+#ifdef GCC5X
+   boost::system::error_code ec;
+#else
+   std::error_code ec;
+#endif
+
+   fs::remove(dst);
+   if(bLink == true)
+   {
+      fs::create_hard_link(src, dst, ec);
+      if(!ec){ m_NumLinked++; return;}
+   }
+   if((m_Mode != PROVISION_COPY) && (Clone(src, dst) == true))
+   {
+      m_NumCloned++;
+      return;
+   }
+   fs::copy_file(src, dst, fs::copy_options::overwrite_existing);
+   m_NumCopied++;
+} /* end Place() */
+
+/******************************************************************************
+Clone()
+
+Reflink a file, keeping its permissions (the model executable must remain
+executable). Returns false if the filesystem doesn't support reflinks.
+******************************************************************************/
+bool WorkerProvisioner::Clone(const fs::path & src, const fs::path & dst)
+{
+#if defined(__linux__) && defined(FICLONE)
+   struct stat info;
+   int in, out;
+   bool bCloned = false;
+
+   in = open(src.string().c_str(), O_RDONLY);
+   if(in < 0) return false;
+   if(fstat(in, &info) == 0)
+   {
+      out = open(dst.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, info.st_mode & 07777);
+      if(out >= 0)
+      {
+         if(ioctl(out, FICLONE, in) == 0) bCloned = true;
+         close(out);
+         if(bCloned == false) unlink(dst.string().c_str());
+      }
+   }
+   close(in);
+   return bCloned;
+#else
+   return false;
+#endif
+} /* end Clone() */
+
+/******************************************************************************
+CheckError()
+
+Report the first error encountered so far, including those of the threads,
+which can't call LogError() themselves. The processors agree on whether any
+of them failed and, if so, all exit together; one exiting alone would leave
+the others waiting for it. This also synchronizes the processors.
+******************************************************************************/
+void WorkerProvisioner::CheckError(void)
+{
+   std::string msg;
+   int failed, anyFailed;
+
+   failed = (m_Error.empty() == true) ? 0 : 1;
+   anyFailed = failed;
+   if(m_NumProcs > 1)
+   {
+      MPI_Allreduce(&failed, &anyFailed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+   }
+   if(anyFailed == 0) return;
+
+   if(failed == 1) msg = "Couldn't provision model subdirectory : " + m_Error;
+   else msg = "Couldn't provision model subdirectory : another processor failed";
+   LogError(ERR_FILE_IO, msg.c_str());
+   ExitProgram(1);
+} /* end CheckError() */
+
+/******************************************************************************
+WriteMetrics()
+******************************************************************************/
+void WorkerProvisioner::WriteMetrics(FILE * pFile)
+{
+   fprintf(pFile, "Worker Provisioning     : ");
+   switch(m_Mode)
+   {
+      case(PROVISION_LINK): fprintf(pFile, "link\n"); break;
+      case(PROVISION_COPY): fprintf(pFile, "copy\n"); break;
+      default: fprintf(pFile, "clone\n"); break;
+   }
+   fprintf(pFile, "Provisioned Files       : %d (%d linked, %d cloned, %d copied)\n",
+           m_NumFiles, (int)m_NumLinked, (int)m_NumCloned, (int)m_NumCopied);
+   fprintf(pFile, "Provisioning Time (sec) : %.3lf\n", m_Time);
+} /* end WriteMetrics() */
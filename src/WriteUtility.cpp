@@ -700,6 +700,7 @@ Write1dSearch()
 Write out one-dimensional search information (to stdout only). If 'count' is:
    WRITE_GSECT : the Golden Section banner is output
    WRITE_BRENT : the Brent banner is output
+   WRITE_PARA  : the parallel search banner is output (max is the batch size)
    WRITE_SWTCH : indicates a switch from Brent to Golden Section
    WRITE_ENDED : end of 1d search
    >0          : treated as the search count.
@@ -718,6 +719,11 @@ void Write1dSearch(int count, int max)
       fprintf(stdout, "\nBeginning Brent Search (max of %d evals)\n", max);
       NL = true;
    }
+   else if(count == WRITE_PARA)
+   {
+      fprintf(stdout, "\nBeginning Parallel Search (%d evals per round)\n", max);
+      NL = true;
+   }
    else if(count == WRITE_SWTCH)
    {
       if(NL == false){fprintf(stdout, "\n");}